@@ -0,0 +1,781 @@
+//------------------------------------------------------------------------------------------------
+//---- 6502 Bus Decoder ... 2026 Dave Gaunt                                                   ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include "Bus6502.h"
+
+// Plain C With No SDK Calls - The Host Test Builds This File As It Is.
+
+enum mnemonics
+{
+	MN_ADC, MN_AND, MN_ASL, MN_BCC, MN_BCS, MN_BEQ, MN_BIT, MN_BMI, MN_BNE, MN_BPL, MN_BRK, MN_BVC,
+	MN_BVS, MN_CLC, MN_CLD, MN_CLI, MN_CLV, MN_CMP, MN_CPX, MN_CPY, MN_DEC, MN_DEX, MN_DEY, MN_EOR,
+	MN_INC, MN_INX, MN_INY, MN_JMP, MN_JSR, MN_LDA, MN_LDX, MN_LDY, MN_LSR, MN_NOP, MN_ORA, MN_PHA,
+	MN_PHP, MN_PLA, MN_PLP, MN_ROL, MN_ROR, MN_RTI, MN_RTS, MN_SBC, MN_SEC, MN_SED, MN_SEI, MN_STA,
+	MN_STX, MN_STY, MN_TAX, MN_TAY, MN_TSX, MN_TXA, MN_TXS, MN_TYA, MN_ILLEGAL
+};
+
+static const char s_aMnemonics[][4] =
+{
+	"ADC", "AND", "ASL", "BCC", "BCS", "BEQ", "BIT", "BMI", "BNE", "BPL", "BRK", "BVC",
+	"BVS", "CLC", "CLD", "CLI", "CLV", "CMP", "CPX", "CPY", "DEC", "DEX", "DEY", "EOR",
+	"INC", "INX", "INY", "JMP", "JSR", "LDA", "LDX", "LDY", "LSR", "NOP", "ORA", "PHA",
+	"PHP", "PLA", "PLP", "ROL", "ROR", "RTI", "RTS", "SBC", "SEC", "SED", "SEI", "STA",
+	"STX", "STY", "TAX", "TAY", "TSX", "TXA", "TXS", "TYA", "???"
+};
+
+enum addressing_modes
+{
+	MODE_IMPLIED = 0,
+	MODE_ACCUMULATOR,
+	MODE_IMMEDIATE,
+	MODE_ZERO_PAGE,
+	MODE_ZERO_PAGE_X,
+	MODE_ZERO_PAGE_Y,
+	MODE_ABSOLUTE,
+	MODE_ABSOLUTE_X,
+	MODE_ABSOLUTE_Y,
+	MODE_INDIRECT,
+	MODE_INDIRECT_X,
+	MODE_INDIRECT_Y,
+	MODE_RELATIVE
+};
+
+static const u8 s_aModeLength[] = {1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 2, 2, 2};
+
+// Where The Next Opcode Comes From - Everything But FLOW_NONE Reads It Off The Bus.
+enum flow_types
+{
+	FLOW_NONE = 0,
+	FLOW_BRANCH,
+	FLOW_JUMP,
+	FLOW_JUMP_INDIRECT,			/* Target On Cycles 4 + 5 */
+	FLOW_JSR,					/* Low Byte On Cycle 2, High Byte On Cycle 6 */
+	FLOW_RTS,					/* Pulled On Cycles 4 + 5, Plus One */
+	FLOW_RTI,					/* Pulled On Cycles 5 + 6 */
+	FLOW_BRK					/* Vector On Cycles 6 + 7 */
+};
+
+#define OPCODE_PAGE_PENALTY			(1)			/* One More Cycle When The Index Crosses A Page */
+
+typedef struct
+{
+	u8	m_uMnemonic;
+	u8	m_uMode;
+	u8	m_uCycles;				/* Without Penalties, 0 = Undocumented */
+	u8	m_uFlags;
+	u8	m_uFlow;
+} OpcodeInfo;
+
+// NMOS 6502 - The Undocumented Opcodes Are Left Out, Their Timing Varies Between Chips.
+static const OpcodeInfo s_aOpcodes[256] =
+{
+	{MN_BRK,     MODE_IMPLIED,      7, 0,                   FLOW_BRK},	/* 00 */
+	{MN_ORA,     MODE_INDIRECT_X,   6, 0,                   FLOW_NONE},	/* 01 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 02 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 03 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 04 */
+	{MN_ORA,     MODE_ZERO_PAGE,    3, 0,                   FLOW_NONE},	/* 05 */
+	{MN_ASL,     MODE_ZERO_PAGE,    5, 0,                   FLOW_NONE},	/* 06 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 07 */
+	{MN_PHP,     MODE_IMPLIED,      3, 0,                   FLOW_NONE},	/* 08 */
+	{MN_ORA,     MODE_IMMEDIATE,    2, 0,                   FLOW_NONE},	/* 09 */
+	{MN_ASL,     MODE_ACCUMULATOR,  2, 0,                   FLOW_NONE},	/* 0A */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 0B */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 0C */
+	{MN_ORA,     MODE_ABSOLUTE,     4, 0,                   FLOW_NONE},	/* 0D */
+	{MN_ASL,     MODE_ABSOLUTE,     6, 0,                   FLOW_NONE},	/* 0E */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 0F */
+	{MN_BPL,     MODE_RELATIVE,     2, 0,                   FLOW_BRANCH},	/* 10 */
+	{MN_ORA,     MODE_INDIRECT_Y,   5, OPCODE_PAGE_PENALTY, FLOW_NONE},	/* 11 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 12 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 13 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 14 */
+	{MN_ORA,     MODE_ZERO_PAGE_X,  4, 0,                   FLOW_NONE},	/* 15 */
+	{MN_ASL,     MODE_ZERO_PAGE_X,  6, 0,                   FLOW_NONE},	/* 16 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 17 */
+	{MN_CLC,     MODE_IMPLIED,      2, 0,                   FLOW_NONE},	/* 18 */
+	{MN_ORA,     MODE_ABSOLUTE_Y,   4, OPCODE_PAGE_PENALTY, FLOW_NONE},	/* 19 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 1A */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 1B */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 1C */
+	{MN_ORA,     MODE_ABSOLUTE_X,   4, OPCODE_PAGE_PENALTY, FLOW_NONE},	/* 1D */
+	{MN_ASL,     MODE_ABSOLUTE_X,   7, 0,                   FLOW_NONE},	/* 1E */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 1F */
+	{MN_JSR,     MODE_ABSOLUTE,     6, 0,                   FLOW_JSR},	/* 20 */
+	{MN_AND,     MODE_INDIRECT_X,   6, 0,                   FLOW_NONE},	/* 21 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 22 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 23 */
+	{MN_BIT,     MODE_ZERO_PAGE,    3, 0,                   FLOW_NONE},	/* 24 */
+	{MN_AND,     MODE_ZERO_PAGE,    3, 0,                   FLOW_NONE},	/* 25 */
+	{MN_ROL,     MODE_ZERO_PAGE,    5, 0,                   FLOW_NONE},	/* 26 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 27 */
+	{MN_PLP,     MODE_IMPLIED,      4, 0,                   FLOW_NONE},	/* 28 */
+	{MN_AND,     MODE_IMMEDIATE,    2, 0,                   FLOW_NONE},	/* 29 */
+	{MN_ROL,     MODE_ACCUMULATOR,  2, 0,                   FLOW_NONE},	/* 2A */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 2B */
+	{MN_BIT,     MODE_ABSOLUTE,     4, 0,                   FLOW_NONE},	/* 2C */
+	{MN_AND,     MODE_ABSOLUTE,     4, 0,                   FLOW_NONE},	/* 2D */
+	{MN_ROL,     MODE_ABSOLUTE,     6, 0,                   FLOW_NONE},	/* 2E */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 2F */
+	{MN_BMI,     MODE_RELATIVE,     2, 0,                   FLOW_BRANCH},	/* 30 */
+	{MN_AND,     MODE_INDIRECT_Y,   5, OPCODE_PAGE_PENALTY, FLOW_NONE},	/* 31 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 32 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 33 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 34 */
+	{MN_AND,     MODE_ZERO_PAGE_X,  4, 0,                   FLOW_NONE},	/* 35 */
+	{MN_ROL,     MODE_ZERO_PAGE_X,  6, 0,                   FLOW_NONE},	/* 36 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 37 */
+	{MN_SEC,     MODE_IMPLIED,      2, 0,                   FLOW_NONE},	/* 38 */
+	{MN_AND,     MODE_ABSOLUTE_Y,   4, OPCODE_PAGE_PENALTY, FLOW_NONE},	/* 39 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 3A */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 3B */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 3C */
+	{MN_AND,     MODE_ABSOLUTE_X,   4, OPCODE_PAGE_PENALTY, FLOW_NONE},	/* 3D */
+	{MN_ROL,     MODE_ABSOLUTE_X,   7, 0,                   FLOW_NONE},	/* 3E */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 3F */
+	{MN_RTI,     MODE_IMPLIED,      6, 0,                   FLOW_RTI},	/* 40 */
+	{MN_EOR,     MODE_INDIRECT_X,   6, 0,                   FLOW_NONE},	/* 41 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 42 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 43 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 44 */
+	{MN_EOR,     MODE_ZERO_PAGE,    3, 0,                   FLOW_NONE},	/* 45 */
+	{MN_LSR,     MODE_ZERO_PAGE,    5, 0,                   FLOW_NONE},	/* 46 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 47 */
+	{MN_PHA,     MODE_IMPLIED,      3, 0,                   FLOW_NONE},	/* 48 */
+	{MN_EOR,     MODE_IMMEDIATE,    2, 0,                   FLOW_NONE},	/* 49 */
+	{MN_LSR,     MODE_ACCUMULATOR,  2, 0,                   FLOW_NONE},	/* 4A */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 4B */
+	{MN_JMP,     MODE_ABSOLUTE,     3, 0,                   FLOW_JUMP},	/* 4C */
+	{MN_EOR,     MODE_ABSOLUTE,     4, 0,                   FLOW_NONE},	/* 4D */
+	{MN_LSR,     MODE_ABSOLUTE,     6, 0,                   FLOW_NONE},	/* 4E */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 4F */
+	{MN_BVC,     MODE_RELATIVE,     2, 0,                   FLOW_BRANCH},	/* 50 */
+	{MN_EOR,     MODE_INDIRECT_Y,   5, OPCODE_PAGE_PENALTY, FLOW_NONE},	/* 51 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 52 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 53 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 54 */
+	{MN_EOR,     MODE_ZERO_PAGE_X,  4, 0,                   FLOW_NONE},	/* 55 */
+	{MN_LSR,     MODE_ZERO_PAGE_X,  6, 0,                   FLOW_NONE},	/* 56 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 57 */
+	{MN_CLI,     MODE_IMPLIED,      2, 0,                   FLOW_NONE},	/* 58 */
+	{MN_EOR,     MODE_ABSOLUTE_Y,   4, OPCODE_PAGE_PENALTY, FLOW_NONE},	/* 59 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 5A */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 5B */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 5C */
+	{MN_EOR,     MODE_ABSOLUTE_X,   4, OPCODE_PAGE_PENALTY, FLOW_NONE},	/* 5D */
+	{MN_LSR,     MODE_ABSOLUTE_X,   7, 0,                   FLOW_NONE},	/* 5E */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 5F */
+	{MN_RTS,     MODE_IMPLIED,      6, 0,                   FLOW_RTS},	/* 60 */
+	{MN_ADC,     MODE_INDIRECT_X,   6, 0,                   FLOW_NONE},	/* 61 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 62 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 63 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 64 */
+	{MN_ADC,     MODE_ZERO_PAGE,    3, 0,                   FLOW_NONE},	/* 65 */
+	{MN_ROR,     MODE_ZERO_PAGE,    5, 0,                   FLOW_NONE},	/* 66 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 67 */
+	{MN_PLA,     MODE_IMPLIED,      4, 0,                   FLOW_NONE},	/* 68 */
+	{MN_ADC,     MODE_IMMEDIATE,    2, 0,                   FLOW_NONE},	/* 69 */
+	{MN_ROR,     MODE_ACCUMULATOR,  2, 0,                   FLOW_NONE},	/* 6A */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 6B */
+	{MN_JMP,     MODE_INDIRECT,     5, 0,                   FLOW_JUMP_INDIRECT},	/* 6C */
+	{MN_ADC,     MODE_ABSOLUTE,     4, 0,                   FLOW_NONE},	/* 6D */
+	{MN_ROR,     MODE_ABSOLUTE,     6, 0,                   FLOW_NONE},	/* 6E */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 6F */
+	{MN_BVS,     MODE_RELATIVE,     2, 0,                   FLOW_BRANCH},	/* 70 */
+	{MN_ADC,     MODE_INDIRECT_Y,   5, OPCODE_PAGE_PENALTY, FLOW_NONE},	/* 71 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 72 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 73 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 74 */
+	{MN_ADC,     MODE_ZERO_PAGE_X,  4, 0,                   FLOW_NONE},	/* 75 */
+	{MN_ROR,     MODE_ZERO_PAGE_X,  6, 0,                   FLOW_NONE},	/* 76 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 77 */
+	{MN_SEI,     MODE_IMPLIED,      2, 0,                   FLOW_NONE},	/* 78 */
+	{MN_ADC,     MODE_ABSOLUTE_Y,   4, OPCODE_PAGE_PENALTY, FLOW_NONE},	/* 79 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 7A */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 7B */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 7C */
+	{MN_ADC,     MODE_ABSOLUTE_X,   4, OPCODE_PAGE_PENALTY, FLOW_NONE},	/* 7D */
+	{MN_ROR,     MODE_ABSOLUTE_X,   7, 0,                   FLOW_NONE},	/* 7E */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 7F */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 80 */
+	{MN_STA,     MODE_INDIRECT_X,   6, 0,                   FLOW_NONE},	/* 81 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 82 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 83 */
+	{MN_STY,     MODE_ZERO_PAGE,    3, 0,                   FLOW_NONE},	/* 84 */
+	{MN_STA,     MODE_ZERO_PAGE,    3, 0,                   FLOW_NONE},	/* 85 */
+	{MN_STX,     MODE_ZERO_PAGE,    3, 0,                   FLOW_NONE},	/* 86 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 87 */
+	{MN_DEY,     MODE_IMPLIED,      2, 0,                   FLOW_NONE},	/* 88 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 89 */
+	{MN_TXA,     MODE_IMPLIED,      2, 0,                   FLOW_NONE},	/* 8A */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 8B */
+	{MN_STY,     MODE_ABSOLUTE,     4, 0,                   FLOW_NONE},	/* 8C */
+	{MN_STA,     MODE_ABSOLUTE,     4, 0,                   FLOW_NONE},	/* 8D */
+	{MN_STX,     MODE_ABSOLUTE,     4, 0,                   FLOW_NONE},	/* 8E */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 8F */
+	{MN_BCC,     MODE_RELATIVE,     2, 0,                   FLOW_BRANCH},	/* 90 */
+	{MN_STA,     MODE_INDIRECT_Y,   6, 0,                   FLOW_NONE},	/* 91 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 92 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 93 */
+	{MN_STY,     MODE_ZERO_PAGE_X,  4, 0,                   FLOW_NONE},	/* 94 */
+	{MN_STA,     MODE_ZERO_PAGE_X,  4, 0,                   FLOW_NONE},	/* 95 */
+	{MN_STX,     MODE_ZERO_PAGE_Y,  4, 0,                   FLOW_NONE},	/* 96 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 97 */
+	{MN_TYA,     MODE_IMPLIED,      2, 0,                   FLOW_NONE},	/* 98 */
+	{MN_STA,     MODE_ABSOLUTE_Y,   5, 0,                   FLOW_NONE},	/* 99 */
+	{MN_TXS,     MODE_IMPLIED,      2, 0,                   FLOW_NONE},	/* 9A */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 9B */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 9C */
+	{MN_STA,     MODE_ABSOLUTE_X,   5, 0,                   FLOW_NONE},	/* 9D */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 9E */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* 9F */
+	{MN_LDY,     MODE_IMMEDIATE,    2, 0,                   FLOW_NONE},	/* A0 */
+	{MN_LDA,     MODE_INDIRECT_X,   6, 0,                   FLOW_NONE},	/* A1 */
+	{MN_LDX,     MODE_IMMEDIATE,    2, 0,                   FLOW_NONE},	/* A2 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* A3 */
+	{MN_LDY,     MODE_ZERO_PAGE,    3, 0,                   FLOW_NONE},	/* A4 */
+	{MN_LDA,     MODE_ZERO_PAGE,    3, 0,                   FLOW_NONE},	/* A5 */
+	{MN_LDX,     MODE_ZERO_PAGE,    3, 0,                   FLOW_NONE},	/* A6 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* A7 */
+	{MN_TAY,     MODE_IMPLIED,      2, 0,                   FLOW_NONE},	/* A8 */
+	{MN_LDA,     MODE_IMMEDIATE,    2, 0,                   FLOW_NONE},	/* A9 */
+	{MN_TAX,     MODE_IMPLIED,      2, 0,                   FLOW_NONE},	/* AA */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* AB */
+	{MN_LDY,     MODE_ABSOLUTE,     4, 0,                   FLOW_NONE},	/* AC */
+	{MN_LDA,     MODE_ABSOLUTE,     4, 0,                   FLOW_NONE},	/* AD */
+	{MN_LDX,     MODE_ABSOLUTE,     4, 0,                   FLOW_NONE},	/* AE */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* AF */
+	{MN_BCS,     MODE_RELATIVE,     2, 0,                   FLOW_BRANCH},	/* B0 */
+	{MN_LDA,     MODE_INDIRECT_Y,   5, OPCODE_PAGE_PENALTY, FLOW_NONE},	/* B1 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* B2 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* B3 */
+	{MN_LDY,     MODE_ZERO_PAGE_X,  4, 0,                   FLOW_NONE},	/* B4 */
+	{MN_LDA,     MODE_ZERO_PAGE_X,  4, 0,                   FLOW_NONE},	/* B5 */
+	{MN_LDX,     MODE_ZERO_PAGE_Y,  4, 0,                   FLOW_NONE},	/* B6 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* B7 */
+	{MN_CLV,     MODE_IMPLIED,      2, 0,                   FLOW_NONE},	/* B8 */
+	{MN_LDA,     MODE_ABSOLUTE_Y,   4, OPCODE_PAGE_PENALTY, FLOW_NONE},	/* B9 */
+	{MN_TSX,     MODE_IMPLIED,      2, 0,                   FLOW_NONE},	/* BA */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* BB */
+	{MN_LDY,     MODE_ABSOLUTE_X,   4, OPCODE_PAGE_PENALTY, FLOW_NONE},	/* BC */
+	{MN_LDA,     MODE_ABSOLUTE_X,   4, OPCODE_PAGE_PENALTY, FLOW_NONE},	/* BD */
+	{MN_LDX,     MODE_ABSOLUTE_Y,   4, OPCODE_PAGE_PENALTY, FLOW_NONE},	/* BE */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* BF */
+	{MN_CPY,     MODE_IMMEDIATE,    2, 0,                   FLOW_NONE},	/* C0 */
+	{MN_CMP,     MODE_INDIRECT_X,   6, 0,                   FLOW_NONE},	/* C1 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* C2 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* C3 */
+	{MN_CPY,     MODE_ZERO_PAGE,    3, 0,                   FLOW_NONE},	/* C4 */
+	{MN_CMP,     MODE_ZERO_PAGE,    3, 0,                   FLOW_NONE},	/* C5 */
+	{MN_DEC,     MODE_ZERO_PAGE,    5, 0,                   FLOW_NONE},	/* C6 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* C7 */
+	{MN_INY,     MODE_IMPLIED,      2, 0,                   FLOW_NONE},	/* C8 */
+	{MN_CMP,     MODE_IMMEDIATE,    2, 0,                   FLOW_NONE},	/* C9 */
+	{MN_DEX,     MODE_IMPLIED,      2, 0,                   FLOW_NONE},	/* CA */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* CB */
+	{MN_CPY,     MODE_ABSOLUTE,     4, 0,                   FLOW_NONE},	/* CC */
+	{MN_CMP,     MODE_ABSOLUTE,     4, 0,                   FLOW_NONE},	/* CD */
+	{MN_DEC,     MODE_ABSOLUTE,     6, 0,                   FLOW_NONE},	/* CE */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* CF */
+	{MN_BNE,     MODE_RELATIVE,     2, 0,                   FLOW_BRANCH},	/* D0 */
+	{MN_CMP,     MODE_INDIRECT_Y,   5, OPCODE_PAGE_PENALTY, FLOW_NONE},	/* D1 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* D2 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* D3 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* D4 */
+	{MN_CMP,     MODE_ZERO_PAGE_X,  4, 0,                   FLOW_NONE},	/* D5 */
+	{MN_DEC,     MODE_ZERO_PAGE_X,  6, 0,                   FLOW_NONE},	/* D6 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* D7 */
+	{MN_CLD,     MODE_IMPLIED,      2, 0,                   FLOW_NONE},	/* D8 */
+	{MN_CMP,     MODE_ABSOLUTE_Y,   4, OPCODE_PAGE_PENALTY, FLOW_NONE},	/* D9 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* DA */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* DB */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* DC */
+	{MN_CMP,     MODE_ABSOLUTE_X,   4, OPCODE_PAGE_PENALTY, FLOW_NONE},	/* DD */
+	{MN_DEC,     MODE_ABSOLUTE_X,   7, 0,                   FLOW_NONE},	/* DE */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* DF */
+	{MN_CPX,     MODE_IMMEDIATE,    2, 0,                   FLOW_NONE},	/* E0 */
+	{MN_SBC,     MODE_INDIRECT_X,   6, 0,                   FLOW_NONE},	/* E1 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* E2 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* E3 */
+	{MN_CPX,     MODE_ZERO_PAGE,    3, 0,                   FLOW_NONE},	/* E4 */
+	{MN_SBC,     MODE_ZERO_PAGE,    3, 0,                   FLOW_NONE},	/* E5 */
+	{MN_INC,     MODE_ZERO_PAGE,    5, 0,                   FLOW_NONE},	/* E6 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* E7 */
+	{MN_INX,     MODE_IMPLIED,      2, 0,                   FLOW_NONE},	/* E8 */
+	{MN_SBC,     MODE_IMMEDIATE,    2, 0,                   FLOW_NONE},	/* E9 */
+	{MN_NOP,     MODE_IMPLIED,      2, 0,                   FLOW_NONE},	/* EA */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* EB */
+	{MN_CPX,     MODE_ABSOLUTE,     4, 0,                   FLOW_NONE},	/* EC */
+	{MN_SBC,     MODE_ABSOLUTE,     4, 0,                   FLOW_NONE},	/* ED */
+	{MN_INC,     MODE_ABSOLUTE,     6, 0,                   FLOW_NONE},	/* EE */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* EF */
+	{MN_BEQ,     MODE_RELATIVE,     2, 0,                   FLOW_BRANCH},	/* F0 */
+	{MN_SBC,     MODE_INDIRECT_Y,   5, OPCODE_PAGE_PENALTY, FLOW_NONE},	/* F1 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* F2 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* F3 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* F4 */
+	{MN_SBC,     MODE_ZERO_PAGE_X,  4, 0,                   FLOW_NONE},	/* F5 */
+	{MN_INC,     MODE_ZERO_PAGE_X,  6, 0,                   FLOW_NONE},	/* F6 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* F7 */
+	{MN_SED,     MODE_IMPLIED,      2, 0,                   FLOW_NONE},	/* F8 */
+	{MN_SBC,     MODE_ABSOLUTE_Y,   4, OPCODE_PAGE_PENALTY, FLOW_NONE},	/* F9 */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* FA */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* FB */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* FC */
+	{MN_SBC,     MODE_ABSOLUTE_X,   4, OPCODE_PAGE_PENALTY, FLOW_NONE},	/* FD */
+	{MN_INC,     MODE_ABSOLUTE_X,   7, 0,                   FLOW_NONE},	/* FE */
+	{MN_ILLEGAL, MODE_IMPLIED,      0, 0,                   FLOW_NONE},	/* FF */
+};
+
+enum decoder_states
+{
+	STATE_LOST = 0,					/* Watching For A Vector Fetch */
+	STATE_INTERRUPT,				/* The Opcode Fetch Was Thrown Away, Vector Fetch Due */
+	STATE_INSTRUCTION,
+	STATE_BRANCH
+};
+
+#define INTERRUPT_CYCLES			(7)
+
+#define CYCLE_ADDRESS(c)			((c) & 0xFFFF)
+#define CYCLE_DATA(c)				((u8)((c) >> BUS6502_DATA_SHIFT))
+#define CYCLE_IS_READ(c)			(0 != ((c) & BUS6502_CYCLE_READ))
+
+//------------------------------------------------------------------------------------------------
+//---- The Next Opcode Fetch Never Came - Wait For A Vector To Get Back In Step.              ----
+//------------------------------------------------------------------------------------------------
+static u32 LoseSync(Bus6502Decoder* pDecoder, Bus6502Instruction* pInstruction)
+{
+	pDecoder->m_uState = STATE_LOST;
+	pDecoder->m_uVector = 0;
+	++pDecoder->m_uSyncLosses;
+
+	pInstruction->m_uAddress = pDecoder->m_uPC;
+	pInstruction->m_uLength = 0;
+	pInstruction->m_uEvent = BUS6502_EVENT_LOST;
+	return 1;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- The Next Opcode Must Be Read From uAddress Somewhere Between Two Cycles From Now.      ----
+//------------------------------------------------------------------------------------------------
+static void ExpectFetch(Bus6502Decoder* pDecoder, const u32 uAddress, const u32 uCycle, const u32 uFetchCycle, const u32 uLateCycle)
+{
+	pDecoder->m_uState = STATE_INSTRUCTION;
+	pDecoder->m_uNextPC = (u16)uAddress;
+	pDecoder->m_uCycle = uCycle;
+	pDecoder->m_uFetchCycle = uFetchCycle;
+	pDecoder->m_uLateCycle = uLateCycle;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- An Opcode Fetch - Only Undocumented Opcodes Report Anything Straight Away.             ----
+//------------------------------------------------------------------------------------------------
+static u32 StartInstruction(Bus6502Decoder* pDecoder, const u32 uAddress, const u8 uOpcode, Bus6502Instruction* pInstruction)
+{
+	const OpcodeInfo* pInfo = &s_aOpcodes[uOpcode];
+
+	pDecoder->m_uPC = (u16)uAddress;
+	pDecoder->m_aData[1] = uOpcode;
+
+	if (0 == pInfo->m_uCycles)
+	{
+		pDecoder->m_uState = STATE_LOST;
+		pDecoder->m_uVector = 0;
+		++pDecoder->m_uSyncLosses;
+
+		pInstruction->m_uAddress = (u16)uAddress;
+		pInstruction->m_uOpcode = uOpcode;
+		pInstruction->m_uLength = 1;
+		pInstruction->m_uEvent = BUS6502_EVENT_ILLEGAL;
+		return 1;
+	}
+
+	// The Address Is Filled In On The Last Cycle, Once Every Byte It Depends On Has Been Seen.
+	ExpectFetch(pDecoder, 0, 1, pInfo->m_uCycles + 1, pInfo->m_uCycles + 1 + (pInfo->m_uFlags & OPCODE_PAGE_PENALTY));
+	return 0;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- The Last Cycle - Every Operand Is Known, So Report It And Work Out Where To Go Next.   ----
+//------------------------------------------------------------------------------------------------
+static u32 FinishInstruction(Bus6502Decoder* pDecoder, Bus6502Instruction* pInstruction)
+{
+	const u8* pData = pDecoder->m_aData;
+	const OpcodeInfo* pInfo = &s_aOpcodes[pData[1]];
+	const u32 uLength = s_aModeLength[pInfo->m_uMode];
+
+	pInstruction->m_uAddress = pDecoder->m_uPC;
+	pInstruction->m_uOpcode = pData[1];
+	pInstruction->m_aOperand[0] = pData[2];
+	pInstruction->m_aOperand[1] = (FLOW_JSR == pInfo->m_uFlow) ? pData[6] : pData[3];
+	pInstruction->m_uLength = (u8)uLength;
+	pInstruction->m_uEvent = BUS6502_EVENT_INSTRUCTION;
+	++pDecoder->m_uInstructions;
+
+	switch (pInfo->m_uFlow)
+	{
+		case FLOW_BRANCH:
+			pDecoder->m_uState = STATE_BRANCH;
+		return 1;
+
+		case FLOW_JUMP:
+			pDecoder->m_uNextPC = pData[2] | (pData[3] << 8);
+		break;
+
+		case FLOW_JUMP_INDIRECT:
+			pDecoder->m_uNextPC = pData[4] | (pData[5] << 8);
+		break;
+
+		case FLOW_JSR:
+			pDecoder->m_uNextPC = pData[2] | (pData[6] << 8);
+		break;
+
+		case FLOW_RTS:
+			pDecoder->m_uNextPC = (u16)((pData[4] | (pData[5] << 8)) + 1);
+		break;
+
+		case FLOW_RTI:
+			pDecoder->m_uNextPC = pData[5] | (pData[6] << 8);
+		break;
+
+		case FLOW_BRK:
+			pDecoder->m_uNextPC = pData[6] | (pData[7] << 8);
+		break;
+
+		default:
+			pDecoder->m_uNextPC = (u16)(pDecoder->m_uPC + uLength);
+		break;
+	}
+
+	return 1;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Inside An Instruction, Or In The Cycles Its Next Opcode Fetch Is Due In.               ----
+//------------------------------------------------------------------------------------------------
+static u32 InstructionCycle(Bus6502Decoder* pDecoder, const u32 uCycle, Bus6502Instruction* pInstruction)
+{
+	const u32 uAddress = CYCLE_ADDRESS(uCycle);
+	const bool bRead = CYCLE_IS_READ(uCycle);
+	const u32 uCycleNumber = ++pDecoder->m_uCycle;
+
+	if (uCycleNumber >= pDecoder->m_uFetchCycle)
+	{
+		if (bRead && (uAddress == pDecoder->m_uNextPC))
+			return StartInstruction(pDecoder, uAddress, CYCLE_DATA(uCycle), pInstruction);
+
+		// A Page Crossing Can Push The Fetch Back A Cycle.
+		if (uCycleNumber < pDecoder->m_uLateCycle)
+			return 0;
+
+		return LoseSync(pDecoder, pInstruction);
+	}
+
+	const OpcodeInfo* pInfo = &s_aOpcodes[pDecoder->m_aData[1]];
+	pDecoder->m_aData[uCycleNumber] = CYCLE_DATA(uCycle);
+
+	// Every Instruction Reads PC + 1 Next - Reading PC Again Means An IRQ Or NMI Took Over.
+	if (2 == uCycleNumber)
+	{
+		if (bRead && (uAddress == pDecoder->m_uPC))
+		{
+			pDecoder->m_uState = STATE_INTERRUPT;
+			pDecoder->m_uVector = 0;
+			return 0;
+		}
+
+		if (!bRead || (uAddress != (u16)(pDecoder->m_uPC + 1)))
+			return LoseSync(pDecoder, pInstruction);
+	}
+	else if ((3 == uCycleNumber) && (3 == s_aModeLength[pInfo->m_uMode]) && (FLOW_JSR != pInfo->m_uFlow))
+	{
+		if (!bRead || (uAddress != (u16)(pDecoder->m_uPC + 2)))
+			return LoseSync(pDecoder, pInstruction);
+	}
+
+	if (uCycleNumber == pInfo->m_uCycles)
+		return FinishInstruction(pDecoder, pInstruction);
+
+	return 0;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- A Taken Branch Reads The Fall Through Address First, Just Like An Opcode Fetch, So The ----
+//---- Decision Waits For Cycle 4 - The Target, The Target In The Wrong Page, Or Neither.     ----
+//------------------------------------------------------------------------------------------------
+static u32 BranchCycle(Bus6502Decoder* pDecoder, const u32 uCycle, Bus6502Instruction* pInstruction)
+{
+	const u32 uAddress = CYCLE_ADDRESS(uCycle);
+	const bool bRead = CYCLE_IS_READ(uCycle);
+	const u32 uCycleNumber = ++pDecoder->m_uCycle;
+	const u16 uFallThrough = (u16)(pDecoder->m_uPC + 2);
+	const u16 uTarget = (u16)(uFallThrough + (signed char)pDecoder->m_aData[2]);
+
+	if (3 == uCycleNumber)
+	{
+		if (!bRead || (uAddress != uFallThrough))
+			return LoseSync(pDecoder, pInstruction);
+
+		pDecoder->m_aBranchCycles[0] = uCycle;
+		return 0;
+	}
+
+	const u32 uFallThroughCycle = pDecoder->m_aBranchCycles[0];
+
+	if (4 == uCycleNumber)
+	{
+		// Branching Over One Byte Reads The Same Addresses Either Way Until Cycle 5.
+		if (bRead && (uAddress == uTarget) && (uTarget == (u16)(uFallThrough + 1)))
+		{
+			const OpcodeInfo* pSkipped = &s_aOpcodes[CYCLE_DATA(uFallThroughCycle)];
+
+			if (0 == pSkipped->m_uCycles)
+				return StartInstruction(pDecoder, uAddress, CYCLE_DATA(uCycle), pInstruction);
+
+			if (1 == s_aModeLength[pSkipped->m_uMode])
+			{
+				pDecoder->m_aBranchCycles[1] = uCycle;
+				return 0;
+			}
+		}
+		else if (bRead && (uAddress == uTarget))
+		{
+			return StartInstruction(pDecoder, uAddress, CYCLE_DATA(uCycle), pInstruction);
+		}
+		else if (bRead && ((uTarget ^ uFallThrough) & 0xFF00) && (uAddress == ((uTarget & 0xFF) | (uFallThrough & 0xFF00))))
+		{
+			ExpectFetch(pDecoder, uTarget, 4, 5, 5);
+			return 0;
+		}
+
+		// Not Taken - Cycle 3 Was The Next Opcode Fetch After All.
+		const u32 uCount = StartInstruction(pDecoder, uFallThrough, CYCLE_DATA(uFallThroughCycle), pInstruction);
+
+		return uCount ? uCount : InstructionCycle(pDecoder, uCycle, pInstruction);
+	}
+
+	// Cycle 5 Of A Skip - Taken Is Cycle 2 Of The Target, Which Always Reads Past It.
+	const u32 uTargetCycle = pDecoder->m_aBranchCycles[1];
+
+	if (bRead && (uAddress == (u16)(uTarget + 1)))
+	{
+		const u32 uCount = StartInstruction(pDecoder, uTarget, CYCLE_DATA(uTargetCycle), pInstruction);
+
+		return uCount ? uCount : InstructionCycle(pDecoder, uCycle, pInstruction);
+	}
+
+	const u32 uCount = StartInstruction(pDecoder, uFallThrough, CYCLE_DATA(uFallThroughCycle), pInstruction);
+	const u32 uSecond = InstructionCycle(pDecoder, uTargetCycle, pInstruction + uCount);
+
+	return uCount + uSecond + InstructionCycle(pDecoder, uCycle, pInstruction + uCount + uSecond);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Out Of Step - Two Reads From A Vector Give The Next Opcode Address.                    ----
+//------------------------------------------------------------------------------------------------
+static u32 VectorCycle(Bus6502Decoder* pDecoder, const u32 uCycle, Bus6502Instruction* pInstruction)
+{
+	const u32 uAddress = CYCLE_ADDRESS(uCycle);
+	const bool bRead = CYCLE_IS_READ(uCycle);
+
+	if (pDecoder->m_uVector && bRead && (uAddress == (u32)(pDecoder->m_uVector + 1)))
+	{
+		const u32 uHandler = pDecoder->m_uVectorLow | (CYCLE_DATA(uCycle) << 8);
+
+		if (0xFFFA == pDecoder->m_uVector)
+			pInstruction->m_uEvent = BUS6502_EVENT_NMI;
+		else if (0xFFFC == pDecoder->m_uVector)
+			pInstruction->m_uEvent = BUS6502_EVENT_RESET;
+		else
+			pInstruction->m_uEvent = BUS6502_EVENT_IRQ;
+
+		pInstruction->m_uAddress = (u16)uHandler;
+		pInstruction->m_uLength = 0;
+
+		ExpectFetch(pDecoder, uHandler, 0, 1, 1);
+		return 1;
+	}
+
+	pDecoder->m_uVector = (bRead && (uAddress >= 0xFFFA) && (0 == (uAddress & 1))) ? (u16)uAddress : 0;
+	pDecoder->m_uVectorLow = CYCLE_DATA(uCycle);
+
+	if ((STATE_INTERRUPT == pDecoder->m_uState) && (++pDecoder->m_uCycle > INTERRUPT_CYCLES))
+		return LoseSync(pDecoder, pInstruction);
+
+	return 0;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Starts Out Of Step - The First Reset, IRQ Or NMI Vector Fetch Lines It Up.             ----
+//------------------------------------------------------------------------------------------------
+void Bus6502_Init(Bus6502Decoder* pDecoder)
+{
+	*pDecoder = (Bus6502Decoder){0};
+	pDecoder->m_uState = STATE_LOST;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Feed Every Phase 2 Cycle In Order. Returns How Many Entries Of aInstructions Were      ----
+//---- Filled - Instructions Once Their Last Cycle Has Gone By, Plus Vectors And Sync Losses. ----
+//------------------------------------------------------------------------------------------------
+u32 Bus6502_Decode(Bus6502Decoder* pDecoder, const u32 uCycle, Bus6502Instruction aInstructions[BUS6502_MAX_PER_CYCLE])
+{
+	if (uCycle & BUS6502_CYCLE_RESET)
+	{
+		pDecoder->m_uState = STATE_LOST;
+		pDecoder->m_uVector = 0;
+		return 0;
+	}
+
+	switch (pDecoder->m_uState)
+	{
+		case STATE_INSTRUCTION:
+		return InstructionCycle(pDecoder, uCycle, aInstructions);
+
+		case STATE_BRANCH:
+		return BranchCycle(pDecoder, uCycle, aInstructions);
+
+		default:
+		return VectorCycle(pDecoder, uCycle, aInstructions);
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+static char* PutHex(char* pszText, const u32 uValue, u32 uDigits)
+{
+	static const char aHex[16] = {'0','1','2','3','4','5','6','7','8','9','A','B','C','D','E','F'};
+
+	while (uDigits--)
+		*pszText++ = aHex[(uValue >> (uDigits << 2)) & 15];
+
+	return pszText;
+}
+
+static char* PutString(char* pszText, const char* pszString)
+{
+	while (*pszString)
+		*pszText++ = *pszString++;
+
+	return pszText;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- "C000  20 D2 FF  JSR $FFD2" - pszText Needs BUS6502_MAX_TEXT. Returns The Length.      ----
+//------------------------------------------------------------------------------------------------
+u32 Bus6502_Format(const Bus6502Instruction* pInstruction, char* pszText)
+{
+	char* pszOut = pszText;
+
+	switch (pInstruction->m_uEvent)
+	{
+		case BUS6502_EVENT_NMI:
+		case BUS6502_EVENT_RESET:
+		case BUS6502_EVENT_IRQ:
+		{
+			static const char* s_aVectorNames[] = {"NMI", "RESET", "IRQ"};
+
+			pszOut = PutString(pszOut, "----  ");
+			pszOut = PutString(pszOut, s_aVectorNames[pInstruction->m_uEvent - BUS6502_EVENT_NMI]);
+			pszOut = PutString(pszOut, " -> $");
+			pszOut = PutHex(pszOut, pInstruction->m_uAddress, 4);
+			*pszOut = 0;
+		}
+		return (u32)(pszOut - pszText);
+
+		case BUS6502_EVENT_LOST:
+			pszOut = PutHex(pszOut, pInstruction->m_uAddress, 4);
+			pszOut = PutString(pszOut, "  LOST SYNC");
+			*pszOut = 0;
+		return (u32)(pszOut - pszText);
+
+		default:
+		break;
+	}
+
+	const OpcodeInfo* pInfo = &s_aOpcodes[pInstruction->m_uOpcode];
+	const u32 uOperand = pInstruction->m_aOperand[0] | (pInstruction->m_aOperand[1] << 8);
+
+	pszOut = PutHex(pszOut, pInstruction->m_uAddress, 4);
+	*pszOut++ = ' ';
+
+	for (u32 uByte=0; uByte<3; ++uByte)
+	{
+		*pszOut++ = ' ';
+
+		if (uByte >= pInstruction->m_uLength)
+			pszOut = PutString(pszOut, "  ");
+		else if (0 == uByte)
+			pszOut = PutHex(pszOut, pInstruction->m_uOpcode, 2);
+		else
+			pszOut = PutHex(pszOut, pInstruction->m_aOperand[uByte - 1], 2);
+	}
+
+	pszOut = PutString(pszOut, "  ");
+
+	if (BUS6502_EVENT_ILLEGAL == pInstruction->m_uEvent)
+	{
+		pszOut = PutString(pszOut, ".BYTE $");
+		pszOut = PutHex(pszOut, pInstruction->m_uOpcode, 2);
+		*pszOut = 0;
+		return (u32)(pszOut - pszText);
+	}
+
+	pszOut = PutString(pszOut, s_aMnemonics[pInfo->m_uMnemonic]);
+
+	switch (pInfo->m_uMode)
+	{
+		case MODE_ACCUMULATOR:	pszOut = PutString(pszOut, " A");											break;
+		case MODE_IMMEDIATE:	pszOut = PutHex(PutString(pszOut, " #$"), uOperand, 2);						break;
+		case MODE_ZERO_PAGE:	pszOut = PutHex(PutString(pszOut, " $"), uOperand, 2);						break;
+		case MODE_ZERO_PAGE_X:	pszOut = PutString(PutHex(PutString(pszOut, " $"), uOperand, 2), ",X");		break;
+		case MODE_ZERO_PAGE_Y:	pszOut = PutString(PutHex(PutString(pszOut, " $"), uOperand, 2), ",Y");		break;
+		case MODE_ABSOLUTE:		pszOut = PutHex(PutString(pszOut, " $"), uOperand, 4);						break;
+		case MODE_ABSOLUTE_X:	pszOut = PutString(PutHex(PutString(pszOut, " $"), uOperand, 4), ",X");		break;
+		case MODE_ABSOLUTE_Y:	pszOut = PutString(PutHex(PutString(pszOut, " $"), uOperand, 4), ",Y");		break;
+		case MODE_INDIRECT:		pszOut = PutString(PutHex(PutString(pszOut, " ($"), uOperand, 4), ")");		break;
+		case MODE_INDIRECT_X:	pszOut = PutString(PutHex(PutString(pszOut, " ($"), uOperand, 2), ",X)");	break;
+		case MODE_INDIRECT_Y:	pszOut = PutString(PutHex(PutString(pszOut, " ($"), uOperand, 2), "),Y");	break;
+
+		case MODE_RELATIVE:
+			pszOut = PutHex(PutString(pszOut, " $"), (u16)(pInstruction->m_uAddress + 2 + (signed char)pInstruction->m_aOperand[0]), 4);
+		break;
+
+		default:
+		break;
+	}
+
+	*pszOut = 0;
+	return (u32)(pszOut - pszText);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Straight From Memory Rather Than The Bus - aBytes Is The Opcode And Up To Two More.    ----
+//------------------------------------------------------------------------------------------------
+u32 Bus6502_Disassemble(const u16 uAddress, const u8 aBytes[3], char* pszText)
+{
+	const OpcodeInfo* pInfo = &s_aOpcodes[aBytes[0]];
+	Bus6502Instruction instruction;
+
+	instruction.m_uAddress = uAddress;
+	instruction.m_uOpcode = aBytes[0];
+	instruction.m_aOperand[0] = aBytes[1];
+	instruction.m_aOperand[1] = aBytes[2];
+	instruction.m_uLength = (0 == pInfo->m_uCycles) ? 1 : s_aModeLength[pInfo->m_uMode];
+	instruction.m_uEvent = (0 == pInfo->m_uCycles) ? BUS6502_EVENT_ILLEGAL : BUS6502_EVENT_INSTRUCTION;
+
+	return Bus6502_Format(&instruction, pszText);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Cycles Without Penalties, 0 = Undocumented - Branches Take One Or Two More When Taken. ----
+//------------------------------------------------------------------------------------------------
+u32 Bus6502_GetCycles(const u8 uOpcode, bool* pbPagePenalty)
+{
+	*pbPagePenalty = (0 != (s_aOpcodes[uOpcode].m_uFlags & OPCODE_PAGE_PENALTY));
+	return s_aOpcodes[uOpcode].m_uCycles;
+}
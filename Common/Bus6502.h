@@ -0,0 +1,69 @@
+//------------------------------------------------------------------------------------------------
+//---- 6502 Bus Decoder ... 2026 Dave Gaunt                                                   ----
+//------------------------------------------------------------------------------------------------
+//---- Turns Snooped Phase 2 Cycles Back Into Instructions - No SYNC Pin, So The Opcode Table ----
+//---- Says How Many Cycles Each Instruction Takes And Where The Next Opcode Fetch Must Be.   ----
+//------------------------------------------------------------------------------------------------
+#ifndef __Bus6502_h_included
+#define __Bus6502_h_included
+
+#include "types.h"
+
+// One Bus Cycle Packed Into A Word - Address 0-15, Data 16-23, Then The Flags.
+#define BUS6502_DATA_SHIFT			(16)
+#define BUS6502_CYCLE_READ			(1u << 24)		/* R/W High */
+#define BUS6502_CYCLE_RESET			(1u << 25)		/* #RESET Held Low */
+
+#define BUS6502_MAX_TEXT			(32)			/* "C000  20 D2 FF  JSR $FFD2" Plus Room */
+#define BUS6502_MAX_PER_CYCLE		(2)				/* A Branch Decided Late Can Finish Two At Once */
+
+enum bus6502_events
+{
+	BUS6502_EVENT_INSTRUCTION = 0,
+	BUS6502_EVENT_ILLEGAL,			/* Not A Documented Opcode - Sync Is Lost Until The Next Vector */
+	BUS6502_EVENT_NMI,				/* Vector Fetches Seen While Out Of Step, m_uAddress = Handler */
+	BUS6502_EVENT_RESET,
+	BUS6502_EVENT_IRQ,
+	BUS6502_EVENT_LOST				/* The Next Opcode Fetch Never Came */
+};
+
+typedef struct
+{
+	u16	m_uAddress;
+	u8	m_uOpcode;
+	u8	m_aOperand[2];
+	u8	m_uLength;
+	u8	m_uEvent;
+} Bus6502Instruction;
+
+typedef struct
+{
+	u32	m_uState;
+	u32	m_uCycle;						/* Cycle Within The Current Instruction, Opcode Fetch = 1 */
+	u32	m_uFetchCycle;					/* Earliest And Latest Cycle The Next Opcode Can Be Fetched On */
+	u32	m_uLateCycle;
+	u32	m_aBranchCycles[2];				/* Cycles 3 And 4 Of A Branch, Held Until It Is Known If It Was Taken */
+	u16	m_uPC;
+	u16	m_uNextPC;
+	u16	m_uVector;						/* Low Half Of A Vector Just Read, 0 = None */
+	u8	m_uVectorLow;
+	u8	m_aData[8];						/* Data Seen On Each Cycle Of The Current Instruction */
+	u32	m_uInstructions;
+	u32	m_uSyncLosses;
+} Bus6502Decoder;
+
+void Bus6502_Init(Bus6502Decoder* pDecoder);
+u32 Bus6502_Decode(Bus6502Decoder* pDecoder, const u32 uCycle, Bus6502Instruction aInstructions[BUS6502_MAX_PER_CYCLE]);
+u32 Bus6502_Format(const Bus6502Instruction* pInstruction, char* pszText);
+u32 Bus6502_Disassemble(const u16 uAddress, const u8 aBytes[3], char* pszText);
+u32 Bus6502_GetCycles(const u8 uOpcode, bool* pbPagePenalty);
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+static inline u32 Bus6502_PackCycle(const u32 uAddress, const u8 uData, const bool bRead)
+{
+	return (uAddress & 0xFFFF) | ((u32)uData << BUS6502_DATA_SHIFT) | (bRead ? BUS6502_CYCLE_READ : 0);
+}
+
+#endif /* __Bus6502_h_included */
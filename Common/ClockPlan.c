@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------------------------
+//---- Clock Plan ... 2026 Dave Gaunt                                                         ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include <assert.h>
+
+#include "ClockPlan.h"
+
+#if !CLOCK_PLAN_HOST_BUILD
+#include "pico/stdlib.h"
+
+#include "hardware/clocks.h"
+#include "hardware/vreg.h"
+#include "hardware/structs/qmi.h"
+#endif
+
+#define CLOCK_PLAN_VCO_HZ			(CLOCK_PLAN_VCO_MHZ * 1000000u)
+#define CLOCK_PLAN_FBDIV			(CLOCK_PLAN_VCO_MHZ / CLOCK_PLAN_XOSC_MHZ)
+#define CLOCK_PLAN_ACTUAL_PIXEL_HZ	(((unsigned long long)CLOCK_PLAN_SYS_HZ * 256) / ((unsigned long long)CLOCK_PLAN_RGB_DIV256 * CLOCK_PLAN_RGB_CYCLES))
+
+// PLL Limits From The RP2350 Datasheet.
+static_assert((CLOCK_PLAN_VCO_MHZ >= 750) && (CLOCK_PLAN_VCO_MHZ <= 1600), "VCO Out Of Range!");
+static_assert(0 == (CLOCK_PLAN_VCO_MHZ % CLOCK_PLAN_XOSC_MHZ), "VCO Must Be A Whole Multiple Of The Crystal!");
+static_assert((CLOCK_PLAN_FBDIV >= 16) && (CLOCK_PLAN_FBDIV <= 320), "Feedback Divider Out Of Range!");
+static_assert((CLOCK_PLAN_POSTDIV1 >= 1) && (CLOCK_PLAN_POSTDIV1 <= 7), "Post Divider 1 Out Of Range!");
+static_assert((CLOCK_PLAN_POSTDIV2 >= 1) && (CLOCK_PLAN_POSTDIV2 <= CLOCK_PLAN_POSTDIV1), "Post Divider 2 Out Of Range!");
+static_assert(CLOCK_PLAN_VCO_MHZ == CLOCK_PLAN_MHZ * CLOCK_PLAN_POSTDIV1 * CLOCK_PLAN_POSTDIV2, "PLL Does Not Give The Plan's Clock!");
+
+// PIO Dividers Are 16 Bit Integer, 8 Bit Fraction And Can Not Go Below 1.
+static_assert((CLOCK_PLAN_RGB_DIV256 >= 256) && (CLOCK_PLAN_SYNC_DIV256 < (65536u * 256)), "VGA Divider Out Of Range!");
+
+// Within 0.5% Of 25.175 MHz, Well Inside What Any Monitor Locks To.
+static_assert((CLOCK_PLAN_ACTUAL_PIXEL_HZ >= (CLOCK_PLAN_PIXEL_HZ / 200) * 199) && (CLOCK_PLAN_ACTUAL_PIXEL_HZ <= (CLOCK_PLAN_PIXEL_HZ / 200) * 201), "Pixel Clock Too Far From 25.175 MHz!");
+
+// Flash Parts On These Boards Are Happy To 133 MHz, Keep Well Under.
+static_assert((CLOCK_PLAN_MHZ / CLOCK_PLAN_FLASH_DIV) <= 100, "Flash Clock Too Fast!");
+
+#if !CLOCK_PLAN_HOST_BUILD
+#if CLOCK_PLAN_CORE_MV == 1100
+#define CLOCK_PLAN_VREG				VREG_VOLTAGE_1_10
+#elif CLOCK_PLAN_CORE_MV == 1150
+#define CLOCK_PLAN_VREG				VREG_VOLTAGE_1_15
+#elif CLOCK_PLAN_CORE_MV == 1200
+#define CLOCK_PLAN_VREG				VREG_VOLTAGE_1_20
+#elif CLOCK_PLAN_CORE_MV == 1300
+#define CLOCK_PLAN_VREG				VREG_VOLTAGE_1_30
+#else
+#error "No Regulator Setting For CLOCK_PLAN_CORE_MV"
+#endif
+
+//------------------------------------------------------------------------------------------------
+//---- Runs From SRAM - Nothing Can Be Fetched From Flash While Its Timing Changes.           ----
+//------------------------------------------------------------------------------------------------
+static void __no_inline_not_in_flash_func(SetFlashDivider)(const u32 uDivider)
+{
+	qmi_hw->m[0].timing = (qmi_hw->m[0].timing & ~QMI_M0_TIMING_CLKDIV_BITS) | (uDivider << QMI_M0_TIMING_CLKDIV_LSB);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Call First Thing In main. Flash Is Slowed And The Core Voltage Raised Before The Clock ----
+//---- Goes Up, And The Flash Divider Is Never Lowered Below What The Boot Left It At.        ----
+//------------------------------------------------------------------------------------------------
+void ClockPlan_Init(void)
+{
+	ClockPlan_StartCycleCounter();
+
+	if (CLOCK_PLAN_SYS_HZ == clock_get_hz(clk_sys))
+		return;
+
+	const u32 uBootDivider = (qmi_hw->m[0].timing & QMI_M0_TIMING_CLKDIV_BITS) >> QMI_M0_TIMING_CLKDIV_LSB;
+
+	if (CLOCK_PLAN_FLASH_DIV > uBootDivider)
+		SetFlashDivider(CLOCK_PLAN_FLASH_DIV);
+
+	vreg_set_voltage(CLOCK_PLAN_VREG);
+	busy_wait_us(1000);
+
+	set_sys_clock_pll(CLOCK_PLAN_VCO_HZ, CLOCK_PLAN_POSTDIV1, CLOCK_PLAN_POSTDIV2);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Each Core Has Its Own - delay_cycles Reads The One Belonging To The Core It Runs On.   ----
+//------------------------------------------------------------------------------------------------
+void ClockPlan_StartCycleCounter(void)
+{
+	m33_hw->demcr |= M33_DEMCR_TRCENA_BITS;
+	m33_hw->dwt_ctrl |= M33_DWT_CTRL_CYCCNTENA_BITS;
+}
+#endif
+
+//------------------------------------------------------------------------------------------------
+//---- The Plan Built In, As Numbers - For The Host Tests And Any Diagnostics Screen.         ----
+//------------------------------------------------------------------------------------------------
+void ClockPlan_GetTiming(ClockPlanTiming* pTiming)
+{
+	pTiming->m_uSysHz = CLOCK_PLAN_SYS_HZ;
+	pTiming->m_uVcoHz = CLOCK_PLAN_VCO_HZ;
+	pTiming->m_uPostDiv1 = CLOCK_PLAN_POSTDIV1;
+	pTiming->m_uPostDiv2 = CLOCK_PLAN_POSTDIV2;
+	pTiming->m_uCoreMillivolts = CLOCK_PLAN_CORE_MV;
+	pTiming->m_uFlashDivider = CLOCK_PLAN_FLASH_DIV;
+	pTiming->m_uRgbDivider256 = CLOCK_PLAN_RGB_DIV256;
+	pTiming->m_uSyncDivider256 = CLOCK_PLAN_SYNC_DIV256;
+	pTiming->m_uPixelHz = (u32)CLOCK_PLAN_ACTUAL_PIXEL_HZ;
+	pTiming->m_uDelay40Cycles = CLOCK_PLAN_NS_TO_CYCLES(40);
+	pTiming->m_uDelay120Cycles = CLOCK_PLAN_NS_TO_CYCLES(120);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- For rgb_program_init - Exact, The 16.8 Divider Fits A float Without Rounding.          ----
+//------------------------------------------------------------------------------------------------
+float ClockPlan_GetRgbDivider(void)
+{
+	return (float)CLOCK_PLAN_RGB_DIV256 / 256.0f;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- For hsync_program_init And vsync_program_init.                                         ----
+//------------------------------------------------------------------------------------------------
+float ClockPlan_GetSyncDivider(void)
+{
+	return (float)CLOCK_PLAN_SYNC_DIV256 / 256.0f;
+}
@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------------------------------
+//---- Clock Plan ... 2026 Dave Gaunt                                                         ----
+//------------------------------------------------------------------------------------------------
+//---- One System Clock From A Short List, With Everything That Depends On It Worked Out From ----
+//---- It - PLL, Core Voltage, Flash Divider, VGA PIO Dividers And The Bus Delays.            ----
+//------------------------------------------------------------------------------------------------
+#ifndef __ClockPlan_h_included
+#define __ClockPlan_h_included
+
+#include "types.h"
+
+// Host Builds Only Get The Numbers - See VIA_6522/Host/clock_plan_test.py.
+#ifndef CLOCK_PLAN_HOST_BUILD
+#define CLOCK_PLAN_HOST_BUILD		(0)
+#endif
+
+#if !CLOCK_PLAN_HOST_BUILD
+#include "hardware/structs/m33.h"
+#endif
+
+// Chosen With The CLOCK_PLAN_MHZ CMake Option.
+#ifndef CLOCK_PLAN_MHZ
+#define CLOCK_PLAN_MHZ				(150)
+#endif
+
+// PLL Runs From The 12 MHz Crystal - VCO / Post Divider 1 / Post Divider 2 = System Clock.
+#if CLOCK_PLAN_MHZ == 150
+#define CLOCK_PLAN_VCO_MHZ			(1500)
+#define CLOCK_PLAN_POSTDIV1			(5)
+#define CLOCK_PLAN_POSTDIV2			(2)
+#define CLOCK_PLAN_CORE_MV			(1100)			/* The Power On Default */
+#define CLOCK_PLAN_FLASH_DIV		(2)
+#elif CLOCK_PLAN_MHZ == 200
+#define CLOCK_PLAN_VCO_MHZ			(1200)
+#define CLOCK_PLAN_POSTDIV1			(6)
+#define CLOCK_PLAN_POSTDIV2			(1)
+#define CLOCK_PLAN_CORE_MV			(1150)
+#define CLOCK_PLAN_FLASH_DIV		(3)
+#elif CLOCK_PLAN_MHZ == 250
+#define CLOCK_PLAN_VCO_MHZ			(1500)
+#define CLOCK_PLAN_POSTDIV1			(6)
+#define CLOCK_PLAN_POSTDIV2			(1)
+#define CLOCK_PLAN_CORE_MV			(1200)
+#define CLOCK_PLAN_FLASH_DIV		(3)
+#elif CLOCK_PLAN_MHZ == 300
+#define CLOCK_PLAN_VCO_MHZ			(1500)
+#define CLOCK_PLAN_POSTDIV1			(5)
+#define CLOCK_PLAN_POSTDIV2			(1)
+#define CLOCK_PLAN_CORE_MV			(1300)			/* Highest Without Unlocking The Regulator */
+#define CLOCK_PLAN_FLASH_DIV		(4)
+#else
+#error "CLOCK_PLAN_MHZ Must Be 150, 200, 250 Or 300"
+#endif
+
+#define CLOCK_PLAN_XOSC_MHZ			(12)
+#define CLOCK_PLAN_SYS_HZ			(CLOCK_PLAN_MHZ * 1000000u)
+
+// VGA 640x480 At 60 Hz - rgb.pio Spends 5 State Machine Cycles On Each Pixel, hsync.pio And
+// vsync.pio One Cycle Per Pixel. Dividers Are 16.8 Fixed Point As The PIO Has Them, The Sync
+// Divider Is Exactly 5x The RGB One So The Two Never Drift Apart Along A Line.
+#define CLOCK_PLAN_PIXEL_HZ			(25175000u)
+#define CLOCK_PLAN_RGB_CYCLES		(5)
+#define CLOCK_PLAN_RGB_DIV256		((u32)((((unsigned long long)CLOCK_PLAN_SYS_HZ * 256) + ((CLOCK_PLAN_PIXEL_HZ * CLOCK_PLAN_RGB_CYCLES) / 2)) / (CLOCK_PLAN_PIXEL_HZ * CLOCK_PLAN_RGB_CYCLES)))
+#define CLOCK_PLAN_SYNC_DIV256		(CLOCK_PLAN_RGB_DIV256 * CLOCK_PLAN_RGB_CYCLES)
+
+// Whole Cycles Covering At Least ns Nanoseconds.
+#define CLOCK_PLAN_NS_TO_CYCLES(ns)	((((ns) * CLOCK_PLAN_MHZ) + 999) / 1000)
+
+typedef struct
+{
+	u32	m_uSysHz;
+	u32	m_uVcoHz;
+	u32	m_uPostDiv1;
+	u32	m_uPostDiv2;
+	u32	m_uCoreMillivolts;
+	u32	m_uFlashDivider;
+	u32	m_uRgbDivider256;
+	u32	m_uSyncDivider256;
+	u32	m_uPixelHz;					/* What The Dividers Actually Give */
+	u32	m_uDelay40Cycles;
+	u32	m_uDelay120Cycles;
+} ClockPlanTiming;
+
+void ClockPlan_Init(void);
+void ClockPlan_StartCycleCounter(void);
+void ClockPlan_GetTiming(ClockPlanTiming* pTiming);
+float ClockPlan_GetRgbDivider(void);
+float ClockPlan_GetSyncDivider(void);
+
+#if !CLOCK_PLAN_HOST_BUILD
+//------------------------------------------------------------------------------------------------
+//---- Spins On The Core's Own Cycle Counter, So The Delay Holds Whatever The Clock - The     ----
+//---- Calling Core Must Have Run ClockPlan_StartCycleCounter. Overshoots By A Few Cycles.    ----
+//------------------------------------------------------------------------------------------------
+static inline void delay_cycles(const u32 uCycles)
+{
+	const u32 uStart = m33_hw->dwt_cyccnt;
+
+	while ((m33_hw->dwt_cyccnt - uStart) < uCycles)
+		;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Minimum Write Pulse Width For The 6522 Bus - 40 ns.                                    ----
+//------------------------------------------------------------------------------------------------
+static inline void delay_40ns(void)
+{
+	delay_cycles(CLOCK_PLAN_NS_TO_CYCLES(40));
+}
+
+//------------------------------------------------------------------------------------------------
+//---- 120 ns.                                                                                ----
+//------------------------------------------------------------------------------------------------
+static inline void delay_120ns(void)
+{
+	delay_cycles(CLOCK_PLAN_NS_TO_CYCLES(120));
+}
+#endif
+
+#endif /* __ClockPlan_h_included */
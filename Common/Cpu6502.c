@@ -0,0 +1,484 @@
+//------------------------------------------------------------------------------------------------
+//---- 6502 Interpreter ... 2026 Dave Gaunt                                                   ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include "Cpu6502.h"
+
+// Plain C With No SDK Calls - VIA_6522/Host/system_sim_test.py Builds This File As It Is.
+
+//------------------------------------------------------------------------------------------------
+//---- Code, Zero Page And The Stack Always Come From RAM, Only Data Can Hit The I/O Page.    ----
+//------------------------------------------------------------------------------------------------
+static inline u8 Read(Cpu6502* pCpu, const u16 uAddress)
+{
+	if ((u32)(uAddress >> 8) == pCpu->m_uIoPage)
+		return pCpu->m_pReadIo(pCpu->m_pContext, uAddress);
+
+	return pCpu->m_pMemory[uAddress];
+}
+
+static inline void Write(Cpu6502* pCpu, const u16 uAddress, const u8 uData)
+{
+	if ((u32)(uAddress >> 8) == pCpu->m_uIoPage)
+		pCpu->m_pWriteIo(pCpu->m_pContext, uAddress, uData);
+	else
+		pCpu->m_pMemory[uAddress] = uData;
+}
+
+static inline u8 Fetch(Cpu6502* pCpu)
+{
+	return pCpu->m_pMemory[pCpu->m_uPC++];
+}
+
+static inline u16 Fetch16(Cpu6502* pCpu)
+{
+	const u16 uLow = Fetch(pCpu);
+	return uLow | (Fetch(pCpu) << 8);
+}
+
+static inline void Push(Cpu6502* pCpu, const u8 uData)
+{
+	pCpu->m_pMemory[0x100 | pCpu->m_uS--] = uData;
+}
+
+static inline u8 Pull(Cpu6502* pCpu)
+{
+	return pCpu->m_pMemory[0x100 | ++pCpu->m_uS];
+}
+
+static inline u16 PullWord(Cpu6502* pCpu)
+{
+	const u16 uLow = Pull(pCpu);
+	return uLow | (Pull(pCpu) << 8);
+}
+
+static inline void PullStatus(Cpu6502* pCpu)
+{
+	pCpu->m_uP = (Pull(pCpu) & ~CPU6502_FLAG_B) | CPU6502_FLAG_U;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Addressing - Indexed Reads Take A Cycle More When The Index Crosses A Page.            ----
+//------------------------------------------------------------------------------------------------
+static inline u16 Indexed(Cpu6502* pCpu, const u16 uBase, const u8 uIndex, const bool bPenalty)
+{
+	const u16 uAddress = uBase + uIndex;
+
+	if (bPenalty && ((uAddress ^ uBase) & 0xFF00))
+		++pCpu->m_uCycles;
+
+	return uAddress;
+}
+
+static inline u16 ZeroPagePointer(Cpu6502* pCpu, const u8 uZeroPage)
+{
+	return pCpu->m_pMemory[uZeroPage] | (pCpu->m_pMemory[(u8)(uZeroPage + 1)] << 8);
+}
+
+static inline u16 IndirectX(Cpu6502* pCpu)
+{
+	return ZeroPagePointer(pCpu, Fetch(pCpu) + pCpu->m_uX);
+}
+
+static inline u16 IndirectY(Cpu6502* pCpu, const bool bPenalty)
+{
+	return Indexed(pCpu, ZeroPagePointer(pCpu, Fetch(pCpu)), pCpu->m_uY, bPenalty);
+}
+
+// JMP ($xxFF) Takes The High Byte From $xx00 - The Carry Never Reaches The High Byte.
+static inline u16 ReadPointer(Cpu6502* pCpu, const u16 uPointer)
+{
+	return pCpu->m_pMemory[uPointer] | (pCpu->m_pMemory[(uPointer & 0xFF00) | ((uPointer + 1) & 0xFF)] << 8);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- ALU                                                                                    ----
+//------------------------------------------------------------------------------------------------
+static inline u8 SetNZ(Cpu6502* pCpu, const u8 uValue)
+{
+	pCpu->m_uP = (pCpu->m_uP & ~(CPU6502_FLAG_N | CPU6502_FLAG_Z)) | (uValue & CPU6502_FLAG_N) | (uValue ? 0 : CPU6502_FLAG_Z);
+	return uValue;
+}
+
+static inline void SetFlag(Cpu6502* pCpu, const u8 uFlag, const bool bSet)
+{
+	pCpu->m_uP = bSet ? (pCpu->m_uP | uFlag) : (pCpu->m_uP & ~uFlag);
+}
+
+static inline void And(Cpu6502* pCpu, const u8 uValue)	{ pCpu->m_uA = SetNZ(pCpu, pCpu->m_uA & uValue); }
+static inline void Ora(Cpu6502* pCpu, const u8 uValue)	{ pCpu->m_uA = SetNZ(pCpu, pCpu->m_uA | uValue); }
+static inline void Eor(Cpu6502* pCpu, const u8 uValue)	{ pCpu->m_uA = SetNZ(pCpu, pCpu->m_uA ^ uValue); }
+
+static inline void Compare(Cpu6502* pCpu, const u8 uRegister, const u8 uValue)
+{
+	SetNZ(pCpu, uRegister - uValue);
+	SetFlag(pCpu, CPU6502_FLAG_C, uRegister >= uValue);
+}
+
+static inline void Bit(Cpu6502* pCpu, const u8 uValue)
+{
+	pCpu->m_uP = (pCpu->m_uP & ~(CPU6502_FLAG_N | CPU6502_FLAG_V | CPU6502_FLAG_Z)) | (uValue & (CPU6502_FLAG_N | CPU6502_FLAG_V)) | ((pCpu->m_uA & uValue) ? 0 : CPU6502_FLAG_Z);
+}
+
+// NMOS Decimal Mode - Z Comes From The Binary Sum, N And V From The Half Adjusted One.
+static inline void Adc(Cpu6502* pCpu, const u8 uValue)
+{
+	const u32 uA = pCpu->m_uA;
+	const u32 uCarry = pCpu->m_uP & CPU6502_FLAG_C;
+	const u32 uBinary = uA + uValue + uCarry;
+
+	if (0 == (pCpu->m_uP & CPU6502_FLAG_D))
+	{
+		SetFlag(pCpu, CPU6502_FLAG_C, uBinary > 0xFF);
+		SetFlag(pCpu, CPU6502_FLAG_V, 0 != (~(uA ^ uValue) & (uA ^ uBinary) & 0x80));
+		pCpu->m_uA = SetNZ(pCpu, (u8)uBinary);
+		return;
+	}
+
+	u32 uLow = (uA & 0x0F) + (uValue & 0x0F) + uCarry;
+
+	if (uLow > 9)
+		uLow = ((uLow + 6) & 0x0F) | 0x10;
+
+	u32 uSum = (uA & 0xF0) + (uValue & 0xF0) + uLow;
+
+	SetNZ(pCpu, (u8)uBinary);
+	SetFlag(pCpu, CPU6502_FLAG_N, 0 != (uSum & 0x80));
+	SetFlag(pCpu, CPU6502_FLAG_V, 0 != (~(uA ^ uValue) & (uA ^ uSum) & 0x80));
+
+	if (uSum > 0x9F)
+		uSum += 0x60;
+
+	SetFlag(pCpu, CPU6502_FLAG_C, uSum > 0xFF);
+	pCpu->m_uA = (u8)uSum;
+}
+
+// NMOS Decimal Mode - Every Flag Comes From The Binary Difference.
+static inline void Sbc(Cpu6502* pCpu, const u8 uValue)
+{
+	const u32 uA = pCpu->m_uA;
+	const u32 uBorrow = (pCpu->m_uP & CPU6502_FLAG_C) ^ 1;
+	const u32 uBinary = uA - uValue - uBorrow;
+
+	SetFlag(pCpu, CPU6502_FLAG_C, uBinary < 0x100);
+	SetFlag(pCpu, CPU6502_FLAG_V, 0 != ((uA ^ uValue) & (uA ^ uBinary) & 0x80));
+	SetNZ(pCpu, (u8)uBinary);
+
+	if (0 == (pCpu->m_uP & CPU6502_FLAG_D))
+	{
+		pCpu->m_uA = (u8)uBinary;
+		return;
+	}
+
+	int iLow = (int)(uA & 0x0F) - (int)(uValue & 0x0F) - (int)uBorrow;
+	int iHigh = (int)(uA >> 4) - (int)(uValue >> 4);
+
+	if (iLow < 0)
+	{
+		iLow -= 6;
+		--iHigh;
+	}
+
+	if (iHigh < 0)
+		iHigh -= 6;
+
+	pCpu->m_uA = (u8)((iHigh << 4) | (iLow & 0x0F));
+}
+
+static inline u8 Asl(Cpu6502* pCpu, const u8 uValue)
+{
+	SetFlag(pCpu, CPU6502_FLAG_C, 0 != (uValue & 0x80));
+	return SetNZ(pCpu, uValue << 1);
+}
+
+static inline u8 Lsr(Cpu6502* pCpu, const u8 uValue)
+{
+	SetFlag(pCpu, CPU6502_FLAG_C, 0 != (uValue & 0x01));
+	return SetNZ(pCpu, uValue >> 1);
+}
+
+static inline u8 Rol(Cpu6502* pCpu, const u8 uValue)
+{
+	const u8 uCarry = pCpu->m_uP & CPU6502_FLAG_C;
+
+	SetFlag(pCpu, CPU6502_FLAG_C, 0 != (uValue & 0x80));
+	return SetNZ(pCpu, (uValue << 1) | uCarry);
+}
+
+static inline u8 Ror(Cpu6502* pCpu, const u8 uValue)
+{
+	const u8 uCarry = pCpu->m_uP & CPU6502_FLAG_C;
+
+	SetFlag(pCpu, CPU6502_FLAG_C, 0 != (uValue & 0x01));
+	return SetNZ(pCpu, (uValue >> 1) | (uCarry << 7));
+}
+
+static inline u8 Inc(Cpu6502* pCpu, const u8 uValue)	{ return SetNZ(pCpu, uValue + 1); }
+static inline u8 Dec(Cpu6502* pCpu, const u8 uValue)	{ return SetNZ(pCpu, uValue - 1); }
+
+// Read-Modify-Write - The Real Chip Also Writes The Old Value Back First, Left Out Here.
+static inline void Modify(Cpu6502* pCpu, const u16 uAddress, u8 (*pOperation)(Cpu6502*, const u8))
+{
+	Write(pCpu, uAddress, pOperation(pCpu, Read(pCpu, uAddress)));
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Flow                                                                                   ----
+//------------------------------------------------------------------------------------------------
+static inline void Branch(Cpu6502* pCpu, const bool bTaken)
+{
+	const signed char iOffset = (signed char)Fetch(pCpu);
+
+	if (!bTaken)
+		return;
+
+	const u16 uTarget = pCpu->m_uPC + iOffset;
+
+	// One More Cycle Taken, Another If It Lands In A Different Page.
+	pCpu->m_uCycles += ((uTarget ^ pCpu->m_uPC) & 0xFF00) ? 2 : 1;
+	pCpu->m_uPC = uTarget;
+}
+
+static inline void Jsr(Cpu6502* pCpu)
+{
+	const u16 uTarget = Fetch16(pCpu);
+	const u16 uReturn = pCpu->m_uPC - 1;
+
+	Push(pCpu, uReturn >> 8);
+	Push(pCpu, uReturn & 0xFF);
+	pCpu->m_uPC = uTarget;
+}
+
+static inline void Interrupt(Cpu6502* pCpu, const u16 uVector, const u16 uReturn, const u8 uBreak)
+{
+	Push(pCpu, uReturn >> 8);
+	Push(pCpu, uReturn & 0xFF);
+	Push(pCpu, pCpu->m_uP | CPU6502_FLAG_U | uBreak);
+	pCpu->m_uP |= CPU6502_FLAG_I;
+	pCpu->m_uPC = pCpu->m_pMemory[uVector] | (pCpu->m_pMemory[uVector + 1] << 8);
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void Cpu6502_Init(Cpu6502* pCpu, u8* pMemory, const u32 uIoPage, Cpu6502Read pReadIo, Cpu6502Write pWriteIo, void* pContext)
+{
+	pCpu->m_pMemory = pMemory;
+	pCpu->m_pReadIo = pReadIo;
+	pCpu->m_pWriteIo = pWriteIo;
+	pCpu->m_pContext = pContext;
+	pCpu->m_uIoPage = uIoPage;
+
+	Cpu6502_Reset(pCpu);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Seven Cycles, As The Chip Takes - The Stack Pointer Ends Up At $FD.                    ----
+//------------------------------------------------------------------------------------------------
+void Cpu6502_Reset(Cpu6502* pCpu)
+{
+	pCpu->m_uA = 0;
+	pCpu->m_uX = 0;
+	pCpu->m_uY = 0;
+	pCpu->m_uS = 0xFD;
+	pCpu->m_uP = CPU6502_FLAG_U | CPU6502_FLAG_I;
+	pCpu->m_uPC = pCpu->m_pMemory[CPU6502_VECTOR_RESET] | (pCpu->m_pMemory[CPU6502_VECTOR_RESET + 1] << 8);
+	pCpu->m_bIrq = false;
+	pCpu->m_bNmi = false;
+	pCpu->m_uEvent = CPU6502_EVENT_INSTRUCTION;
+	pCpu->m_uCycles = 7;
+	pCpu->m_uInstructions = 0;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- One Instruction, Or Taking An Interrupt - Returns The Cycles Used. Interrupts Are Only ----
+//---- Looked At Between Instructions, So #IRQ Must Be Up To Date For The Cycle Just Ended.   ----
+//------------------------------------------------------------------------------------------------
+u32 __hot_path_func(Cpu6502_Step)(Cpu6502* pCpu)
+{
+	const u32 uStart = pCpu->m_uCycles;
+
+	if (pCpu->m_bNmi)
+	{
+		pCpu->m_bNmi = false;
+		pCpu->m_uCycles += 7;
+		pCpu->m_uEvent = CPU6502_EVENT_NMI;
+		Interrupt(pCpu, CPU6502_VECTOR_NMI, pCpu->m_uPC, 0);
+		return 7;
+	}
+
+	if (pCpu->m_bIrq && (0 == (pCpu->m_uP & CPU6502_FLAG_I)))
+	{
+		pCpu->m_uCycles += 7;
+		pCpu->m_uEvent = CPU6502_EVENT_IRQ;
+		Interrupt(pCpu, CPU6502_VECTOR_IRQ, pCpu->m_uPC, 0);
+		return 7;
+	}
+
+	pCpu->m_uEvent = CPU6502_EVENT_INSTRUCTION;
+
+	// Cycles Are Added Before The Operand Is Touched, So An I/O Access Sees The Last Cycle.
+	switch (Fetch(pCpu))
+	{
+		case 0x00:	pCpu->m_uCycles += 7;	Interrupt(pCpu, CPU6502_VECTOR_IRQ, pCpu->m_uPC + 1, CPU6502_FLAG_B);			break;	/* BRK */
+		case 0x01:	pCpu->m_uCycles += 6;	Ora(pCpu, Read(pCpu, IndirectX(pCpu)));											break;	/* ORA (zp,X) */
+		case 0x05:	pCpu->m_uCycles += 3;	Ora(pCpu, Read(pCpu, Fetch(pCpu)));												break;	/* ORA zp */
+		case 0x06:	pCpu->m_uCycles += 5;	Modify(pCpu, Fetch(pCpu), Asl);													break;	/* ASL zp */
+		case 0x08:	pCpu->m_uCycles += 3;	Push(pCpu, pCpu->m_uP | CPU6502_FLAG_B | CPU6502_FLAG_U);						break;	/* PHP */
+		case 0x09:	pCpu->m_uCycles += 2;	Ora(pCpu, Fetch(pCpu));															break;	/* ORA #imm */
+		case 0x0A:	pCpu->m_uCycles += 2;	pCpu->m_uA = Asl(pCpu, pCpu->m_uA);												break;	/* ASL A */
+		case 0x0D:	pCpu->m_uCycles += 4;	Ora(pCpu, Read(pCpu, Fetch16(pCpu)));											break;	/* ORA abs */
+		case 0x0E:	pCpu->m_uCycles += 6;	Modify(pCpu, Fetch16(pCpu), Asl);												break;	/* ASL abs */
+		case 0x10:	pCpu->m_uCycles += 2;	Branch(pCpu, 0 == (pCpu->m_uP & CPU6502_FLAG_N));								break;	/* BPL */
+		case 0x11:	pCpu->m_uCycles += 5;	Ora(pCpu, Read(pCpu, IndirectY(pCpu, true)));									break;	/* ORA (zp),Y */
+		case 0x15:	pCpu->m_uCycles += 4;	Ora(pCpu, Read(pCpu, (u8)(Fetch(pCpu) + pCpu->m_uX)));							break;	/* ORA zp,X */
+		case 0x16:	pCpu->m_uCycles += 6;	Modify(pCpu, (u8)(Fetch(pCpu) + pCpu->m_uX), Asl);								break;	/* ASL zp,X */
+		case 0x18:	pCpu->m_uCycles += 2;	pCpu->m_uP &= ~CPU6502_FLAG_C;													break;	/* CLC */
+		case 0x19:	pCpu->m_uCycles += 4;	Ora(pCpu, Read(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uY, true)));			break;	/* ORA abs,Y */
+		case 0x1D:	pCpu->m_uCycles += 4;	Ora(pCpu, Read(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uX, true)));			break;	/* ORA abs,X */
+		case 0x1E:	pCpu->m_uCycles += 7;	Modify(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uX, false), Asl);				break;	/* ASL abs,X */
+		case 0x20:	pCpu->m_uCycles += 6;	Jsr(pCpu);																		break;	/* JSR */
+		case 0x21:	pCpu->m_uCycles += 6;	And(pCpu, Read(pCpu, IndirectX(pCpu)));											break;	/* AND (zp,X) */
+		case 0x24:	pCpu->m_uCycles += 3;	Bit(pCpu, Read(pCpu, Fetch(pCpu)));												break;	/* BIT zp */
+		case 0x25:	pCpu->m_uCycles += 3;	And(pCpu, Read(pCpu, Fetch(pCpu)));												break;	/* AND zp */
+		case 0x26:	pCpu->m_uCycles += 5;	Modify(pCpu, Fetch(pCpu), Rol);													break;	/* ROL zp */
+		case 0x28:	pCpu->m_uCycles += 4;	PullStatus(pCpu);																break;	/* PLP */
+		case 0x29:	pCpu->m_uCycles += 2;	And(pCpu, Fetch(pCpu));															break;	/* AND #imm */
+		case 0x2A:	pCpu->m_uCycles += 2;	pCpu->m_uA = Rol(pCpu, pCpu->m_uA);												break;	/* ROL A */
+		case 0x2C:	pCpu->m_uCycles += 4;	Bit(pCpu, Read(pCpu, Fetch16(pCpu)));											break;	/* BIT abs */
+		case 0x2D:	pCpu->m_uCycles += 4;	And(pCpu, Read(pCpu, Fetch16(pCpu)));											break;	/* AND abs */
+		case 0x2E:	pCpu->m_uCycles += 6;	Modify(pCpu, Fetch16(pCpu), Rol);												break;	/* ROL abs */
+		case 0x30:	pCpu->m_uCycles += 2;	Branch(pCpu, 0 != (pCpu->m_uP & CPU6502_FLAG_N));								break;	/* BMI */
+		case 0x31:	pCpu->m_uCycles += 5;	And(pCpu, Read(pCpu, IndirectY(pCpu, true)));									break;	/* AND (zp),Y */
+		case 0x35:	pCpu->m_uCycles += 4;	And(pCpu, Read(pCpu, (u8)(Fetch(pCpu) + pCpu->m_uX)));							break;	/* AND zp,X */
+		case 0x36:	pCpu->m_uCycles += 6;	Modify(pCpu, (u8)(Fetch(pCpu) + pCpu->m_uX), Rol);								break;	/* ROL zp,X */
+		case 0x38:	pCpu->m_uCycles += 2;	pCpu->m_uP |= CPU6502_FLAG_C;													break;	/* SEC */
+		case 0x39:	pCpu->m_uCycles += 4;	And(pCpu, Read(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uY, true)));			break;	/* AND abs,Y */
+		case 0x3D:	pCpu->m_uCycles += 4;	And(pCpu, Read(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uX, true)));			break;	/* AND abs,X */
+		case 0x3E:	pCpu->m_uCycles += 7;	Modify(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uX, false), Rol);				break;	/* ROL abs,X */
+		case 0x40:	pCpu->m_uCycles += 6;	PullStatus(pCpu); pCpu->m_uPC = PullWord(pCpu);									break;	/* RTI */
+		case 0x41:	pCpu->m_uCycles += 6;	Eor(pCpu, Read(pCpu, IndirectX(pCpu)));											break;	/* EOR (zp,X) */
+		case 0x45:	pCpu->m_uCycles += 3;	Eor(pCpu, Read(pCpu, Fetch(pCpu)));												break;	/* EOR zp */
+		case 0x46:	pCpu->m_uCycles += 5;	Modify(pCpu, Fetch(pCpu), Lsr);													break;	/* LSR zp */
+		case 0x48:	pCpu->m_uCycles += 3;	Push(pCpu, pCpu->m_uA);															break;	/* PHA */
+		case 0x49:	pCpu->m_uCycles += 2;	Eor(pCpu, Fetch(pCpu));															break;	/* EOR #imm */
+		case 0x4A:	pCpu->m_uCycles += 2;	pCpu->m_uA = Lsr(pCpu, pCpu->m_uA);												break;	/* LSR A */
+		case 0x4C:	pCpu->m_uCycles += 3;	pCpu->m_uPC = Fetch16(pCpu);													break;	/* JMP */
+		case 0x4D:	pCpu->m_uCycles += 4;	Eor(pCpu, Read(pCpu, Fetch16(pCpu)));											break;	/* EOR abs */
+		case 0x4E:	pCpu->m_uCycles += 6;	Modify(pCpu, Fetch16(pCpu), Lsr);												break;	/* LSR abs */
+		case 0x50:	pCpu->m_uCycles += 2;	Branch(pCpu, 0 == (pCpu->m_uP & CPU6502_FLAG_V));								break;	/* BVC */
+		case 0x51:	pCpu->m_uCycles += 5;	Eor(pCpu, Read(pCpu, IndirectY(pCpu, true)));									break;	/* EOR (zp),Y */
+		case 0x55:	pCpu->m_uCycles += 4;	Eor(pCpu, Read(pCpu, (u8)(Fetch(pCpu) + pCpu->m_uX)));							break;	/* EOR zp,X */
+		case 0x56:	pCpu->m_uCycles += 6;	Modify(pCpu, (u8)(Fetch(pCpu) + pCpu->m_uX), Lsr);								break;	/* LSR zp,X */
+		case 0x58:	pCpu->m_uCycles += 2;	pCpu->m_uP &= ~CPU6502_FLAG_I;													break;	/* CLI */
+		case 0x59:	pCpu->m_uCycles += 4;	Eor(pCpu, Read(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uY, true)));			break;	/* EOR abs,Y */
+		case 0x5D:	pCpu->m_uCycles += 4;	Eor(pCpu, Read(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uX, true)));			break;	/* EOR abs,X */
+		case 0x5E:	pCpu->m_uCycles += 7;	Modify(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uX, false), Lsr);				break;	/* LSR abs,X */
+		case 0x60:	pCpu->m_uCycles += 6;	pCpu->m_uPC = PullWord(pCpu) + 1;												break;	/* RTS */
+		case 0x61:	pCpu->m_uCycles += 6;	Adc(pCpu, Read(pCpu, IndirectX(pCpu)));											break;	/* ADC (zp,X) */
+		case 0x65:	pCpu->m_uCycles += 3;	Adc(pCpu, Read(pCpu, Fetch(pCpu)));												break;	/* ADC zp */
+		case 0x66:	pCpu->m_uCycles += 5;	Modify(pCpu, Fetch(pCpu), Ror);													break;	/* ROR zp */
+		case 0x68:	pCpu->m_uCycles += 4;	pCpu->m_uA = SetNZ(pCpu, Pull(pCpu));											break;	/* PLA */
+		case 0x69:	pCpu->m_uCycles += 2;	Adc(pCpu, Fetch(pCpu));															break;	/* ADC #imm */
+		case 0x6A:	pCpu->m_uCycles += 2;	pCpu->m_uA = Ror(pCpu, pCpu->m_uA);												break;	/* ROR A */
+		case 0x6C:	pCpu->m_uCycles += 5;	pCpu->m_uPC = ReadPointer(pCpu, Fetch16(pCpu));									break;	/* JMP (abs) */
+		case 0x6D:	pCpu->m_uCycles += 4;	Adc(pCpu, Read(pCpu, Fetch16(pCpu)));											break;	/* ADC abs */
+		case 0x6E:	pCpu->m_uCycles += 6;	Modify(pCpu, Fetch16(pCpu), Ror);												break;	/* ROR abs */
+		case 0x70:	pCpu->m_uCycles += 2;	Branch(pCpu, 0 != (pCpu->m_uP & CPU6502_FLAG_V));								break;	/* BVS */
+		case 0x71:	pCpu->m_uCycles += 5;	Adc(pCpu, Read(pCpu, IndirectY(pCpu, true)));									break;	/* ADC (zp),Y */
+		case 0x75:	pCpu->m_uCycles += 4;	Adc(pCpu, Read(pCpu, (u8)(Fetch(pCpu) + pCpu->m_uX)));							break;	/* ADC zp,X */
+		case 0x76:	pCpu->m_uCycles += 6;	Modify(pCpu, (u8)(Fetch(pCpu) + pCpu->m_uX), Ror);								break;	/* ROR zp,X */
+		case 0x78:	pCpu->m_uCycles += 2;	pCpu->m_uP |= CPU6502_FLAG_I;													break;	/* SEI */
+		case 0x79:	pCpu->m_uCycles += 4;	Adc(pCpu, Read(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uY, true)));			break;	/* ADC abs,Y */
+		case 0x7D:	pCpu->m_uCycles += 4;	Adc(pCpu, Read(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uX, true)));			break;	/* ADC abs,X */
+		case 0x7E:	pCpu->m_uCycles += 7;	Modify(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uX, false), Ror);				break;	/* ROR abs,X */
+		case 0x81:	pCpu->m_uCycles += 6;	Write(pCpu, IndirectX(pCpu), pCpu->m_uA);										break;	/* STA (zp,X) */
+		case 0x84:	pCpu->m_uCycles += 3;	Write(pCpu, Fetch(pCpu), pCpu->m_uY);											break;	/* STY zp */
+		case 0x85:	pCpu->m_uCycles += 3;	Write(pCpu, Fetch(pCpu), pCpu->m_uA);											break;	/* STA zp */
+		case 0x86:	pCpu->m_uCycles += 3;	Write(pCpu, Fetch(pCpu), pCpu->m_uX);											break;	/* STX zp */
+		case 0x88:	pCpu->m_uCycles += 2;	pCpu->m_uY = SetNZ(pCpu, pCpu->m_uY - 1);										break;	/* DEY */
+		case 0x8A:	pCpu->m_uCycles += 2;	pCpu->m_uA = SetNZ(pCpu, pCpu->m_uX);											break;	/* TXA */
+		case 0x8C:	pCpu->m_uCycles += 4;	Write(pCpu, Fetch16(pCpu), pCpu->m_uY);											break;	/* STY abs */
+		case 0x8D:	pCpu->m_uCycles += 4;	Write(pCpu, Fetch16(pCpu), pCpu->m_uA);											break;	/* STA abs */
+		case 0x8E:	pCpu->m_uCycles += 4;	Write(pCpu, Fetch16(pCpu), pCpu->m_uX);											break;	/* STX abs */
+		case 0x90:	pCpu->m_uCycles += 2;	Branch(pCpu, 0 == (pCpu->m_uP & CPU6502_FLAG_C));								break;	/* BCC */
+		case 0x91:	pCpu->m_uCycles += 6;	Write(pCpu, IndirectY(pCpu, false), pCpu->m_uA);								break;	/* STA (zp),Y */
+		case 0x94:	pCpu->m_uCycles += 4;	Write(pCpu, (u8)(Fetch(pCpu) + pCpu->m_uX), pCpu->m_uY);						break;	/* STY zp,X */
+		case 0x95:	pCpu->m_uCycles += 4;	Write(pCpu, (u8)(Fetch(pCpu) + pCpu->m_uX), pCpu->m_uA);						break;	/* STA zp,X */
+		case 0x96:	pCpu->m_uCycles += 4;	Write(pCpu, (u8)(Fetch(pCpu) + pCpu->m_uY), pCpu->m_uX);						break;	/* STX zp,Y */
+		case 0x98:	pCpu->m_uCycles += 2;	pCpu->m_uA = SetNZ(pCpu, pCpu->m_uY);											break;	/* TYA */
+		case 0x99:	pCpu->m_uCycles += 5;	Write(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uY, false), pCpu->m_uA);		break;	/* STA abs,Y */
+		case 0x9A:	pCpu->m_uCycles += 2;	pCpu->m_uS = pCpu->m_uX;														break;	/* TXS */
+		case 0x9D:	pCpu->m_uCycles += 5;	Write(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uX, false), pCpu->m_uA);		break;	/* STA abs,X */
+		case 0xA0:	pCpu->m_uCycles += 2;	pCpu->m_uY = SetNZ(pCpu, Fetch(pCpu));											break;	/* LDY #imm */
+		case 0xA1:	pCpu->m_uCycles += 6;	pCpu->m_uA = SetNZ(pCpu, Read(pCpu, IndirectX(pCpu)));							break;	/* LDA (zp,X) */
+		case 0xA2:	pCpu->m_uCycles += 2;	pCpu->m_uX = SetNZ(pCpu, Fetch(pCpu));											break;	/* LDX #imm */
+		case 0xA4:	pCpu->m_uCycles += 3;	pCpu->m_uY = SetNZ(pCpu, Read(pCpu, Fetch(pCpu)));								break;	/* LDY zp */
+		case 0xA5:	pCpu->m_uCycles += 3;	pCpu->m_uA = SetNZ(pCpu, Read(pCpu, Fetch(pCpu)));								break;	/* LDA zp */
+		case 0xA6:	pCpu->m_uCycles += 3;	pCpu->m_uX = SetNZ(pCpu, Read(pCpu, Fetch(pCpu)));								break;	/* LDX zp */
+		case 0xA8:	pCpu->m_uCycles += 2;	pCpu->m_uY = SetNZ(pCpu, pCpu->m_uA);											break;	/* TAY */
+		case 0xA9:	pCpu->m_uCycles += 2;	pCpu->m_uA = SetNZ(pCpu, Fetch(pCpu));											break;	/* LDA #imm */
+		case 0xAA:	pCpu->m_uCycles += 2;	pCpu->m_uX = SetNZ(pCpu, pCpu->m_uA);											break;	/* TAX */
+		case 0xAC:	pCpu->m_uCycles += 4;	pCpu->m_uY = SetNZ(pCpu, Read(pCpu, Fetch16(pCpu)));							break;	/* LDY abs */
+		case 0xAD:	pCpu->m_uCycles += 4;	pCpu->m_uA = SetNZ(pCpu, Read(pCpu, Fetch16(pCpu)));							break;	/* LDA abs */
+		case 0xAE:	pCpu->m_uCycles += 4;	pCpu->m_uX = SetNZ(pCpu, Read(pCpu, Fetch16(pCpu)));							break;	/* LDX abs */
+		case 0xB0:	pCpu->m_uCycles += 2;	Branch(pCpu, 0 != (pCpu->m_uP & CPU6502_FLAG_C));								break;	/* BCS */
+		case 0xB1:	pCpu->m_uCycles += 5;	pCpu->m_uA = SetNZ(pCpu, Read(pCpu, IndirectY(pCpu, true)));					break;	/* LDA (zp),Y */
+		case 0xB4:	pCpu->m_uCycles += 4;	pCpu->m_uY = SetNZ(pCpu, Read(pCpu, (u8)(Fetch(pCpu) + pCpu->m_uX)));			break;	/* LDY zp,X */
+		case 0xB5:	pCpu->m_uCycles += 4;	pCpu->m_uA = SetNZ(pCpu, Read(pCpu, (u8)(Fetch(pCpu) + pCpu->m_uX)));			break;	/* LDA zp,X */
+		case 0xB6:	pCpu->m_uCycles += 4;	pCpu->m_uX = SetNZ(pCpu, Read(pCpu, (u8)(Fetch(pCpu) + pCpu->m_uY)));			break;	/* LDX zp,Y */
+		case 0xB8:	pCpu->m_uCycles += 2;	pCpu->m_uP &= ~CPU6502_FLAG_V;													break;	/* CLV */
+		case 0xB9:	pCpu->m_uCycles += 4;	pCpu->m_uA = SetNZ(pCpu, Read(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uY, true)));	break;	/* LDA abs,Y */
+		case 0xBA:	pCpu->m_uCycles += 2;	pCpu->m_uX = SetNZ(pCpu, pCpu->m_uS);											break;	/* TSX */
+		case 0xBC:	pCpu->m_uCycles += 4;	pCpu->m_uY = SetNZ(pCpu, Read(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uX, true)));	break;	/* LDY abs,X */
+		case 0xBD:	pCpu->m_uCycles += 4;	pCpu->m_uA = SetNZ(pCpu, Read(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uX, true)));	break;	/* LDA abs,X */
+		case 0xBE:	pCpu->m_uCycles += 4;	pCpu->m_uX = SetNZ(pCpu, Read(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uY, true)));	break;	/* LDX abs,Y */
+		case 0xC0:	pCpu->m_uCycles += 2;	Compare(pCpu, pCpu->m_uY, Fetch(pCpu));											break;	/* CPY #imm */
+		case 0xC1:	pCpu->m_uCycles += 6;	Compare(pCpu, pCpu->m_uA, Read(pCpu, IndirectX(pCpu)));							break;	/* CMP (zp,X) */
+		case 0xC4:	pCpu->m_uCycles += 3;	Compare(pCpu, pCpu->m_uY, Read(pCpu, Fetch(pCpu)));								break;	/* CPY zp */
+		case 0xC5:	pCpu->m_uCycles += 3;	Compare(pCpu, pCpu->m_uA, Read(pCpu, Fetch(pCpu)));								break;	/* CMP zp */
+		case 0xC6:	pCpu->m_uCycles += 5;	Modify(pCpu, Fetch(pCpu), Dec);													break;	/* DEC zp */
+		case 0xC8:	pCpu->m_uCycles += 2;	pCpu->m_uY = SetNZ(pCpu, pCpu->m_uY + 1);										break;	/* INY */
+		case 0xC9:	pCpu->m_uCycles += 2;	Compare(pCpu, pCpu->m_uA, Fetch(pCpu));											break;	/* CMP #imm */
+		case 0xCA:	pCpu->m_uCycles += 2;	pCpu->m_uX = SetNZ(pCpu, pCpu->m_uX - 1);										break;	/* DEX */
+		case 0xCC:	pCpu->m_uCycles += 4;	Compare(pCpu, pCpu->m_uY, Read(pCpu, Fetch16(pCpu)));							break;	/* CPY abs */
+		case 0xCD:	pCpu->m_uCycles += 4;	Compare(pCpu, pCpu->m_uA, Read(pCpu, Fetch16(pCpu)));							break;	/* CMP abs */
+		case 0xCE:	pCpu->m_uCycles += 6;	Modify(pCpu, Fetch16(pCpu), Dec);												break;	/* DEC abs */
+		case 0xD0:	pCpu->m_uCycles += 2;	Branch(pCpu, 0 == (pCpu->m_uP & CPU6502_FLAG_Z));								break;	/* BNE */
+		case 0xD1:	pCpu->m_uCycles += 5;	Compare(pCpu, pCpu->m_uA, Read(pCpu, IndirectY(pCpu, true)));					break;	/* CMP (zp),Y */
+		case 0xD5:	pCpu->m_uCycles += 4;	Compare(pCpu, pCpu->m_uA, Read(pCpu, (u8)(Fetch(pCpu) + pCpu->m_uX)));			break;	/* CMP zp,X */
+		case 0xD6:	pCpu->m_uCycles += 6;	Modify(pCpu, (u8)(Fetch(pCpu) + pCpu->m_uX), Dec);								break;	/* DEC zp,X */
+		case 0xD8:	pCpu->m_uCycles += 2;	pCpu->m_uP &= ~CPU6502_FLAG_D;													break;	/* CLD */
+		case 0xD9:	pCpu->m_uCycles += 4;	Compare(pCpu, pCpu->m_uA, Read(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uY, true)));	break;	/* CMP abs,Y */
+		case 0xDD:	pCpu->m_uCycles += 4;	Compare(pCpu, pCpu->m_uA, Read(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uX, true)));	break;	/* CMP abs,X */
+		case 0xDE:	pCpu->m_uCycles += 7;	Modify(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uX, false), Dec);				break;	/* DEC abs,X */
+		case 0xE0:	pCpu->m_uCycles += 2;	Compare(pCpu, pCpu->m_uX, Fetch(pCpu));											break;	/* CPX #imm */
+		case 0xE1:	pCpu->m_uCycles += 6;	Sbc(pCpu, Read(pCpu, IndirectX(pCpu)));											break;	/* SBC (zp,X) */
+		case 0xE4:	pCpu->m_uCycles += 3;	Compare(pCpu, pCpu->m_uX, Read(pCpu, Fetch(pCpu)));								break;	/* CPX zp */
+		case 0xE5:	pCpu->m_uCycles += 3;	Sbc(pCpu, Read(pCpu, Fetch(pCpu)));												break;	/* SBC zp */
+		case 0xE6:	pCpu->m_uCycles += 5;	Modify(pCpu, Fetch(pCpu), Inc);													break;	/* INC zp */
+		case 0xE8:	pCpu->m_uCycles += 2;	pCpu->m_uX = SetNZ(pCpu, pCpu->m_uX + 1);										break;	/* INX */
+		case 0xE9:	pCpu->m_uCycles += 2;	Sbc(pCpu, Fetch(pCpu));															break;	/* SBC #imm */
+		case 0xEA:	pCpu->m_uCycles += 2;																					break;	/* NOP */
+		case 0xEC:	pCpu->m_uCycles += 4;	Compare(pCpu, pCpu->m_uX, Read(pCpu, Fetch16(pCpu)));							break;	/* CPX abs */
+		case 0xED:	pCpu->m_uCycles += 4;	Sbc(pCpu, Read(pCpu, Fetch16(pCpu)));											break;	/* SBC abs */
+		case 0xEE:	pCpu->m_uCycles += 6;	Modify(pCpu, Fetch16(pCpu), Inc);												break;	/* INC abs */
+		case 0xF0:	pCpu->m_uCycles += 2;	Branch(pCpu, 0 != (pCpu->m_uP & CPU6502_FLAG_Z));								break;	/* BEQ */
+		case 0xF1:	pCpu->m_uCycles += 5;	Sbc(pCpu, Read(pCpu, IndirectY(pCpu, true)));									break;	/* SBC (zp),Y */
+		case 0xF5:	pCpu->m_uCycles += 4;	Sbc(pCpu, Read(pCpu, (u8)(Fetch(pCpu) + pCpu->m_uX)));							break;	/* SBC zp,X */
+		case 0xF6:	pCpu->m_uCycles += 6;	Modify(pCpu, (u8)(Fetch(pCpu) + pCpu->m_uX), Inc);								break;	/* INC zp,X */
+		case 0xF8:	pCpu->m_uCycles += 2;	pCpu->m_uP |= CPU6502_FLAG_D;													break;	/* SED */
+		case 0xF9:	pCpu->m_uCycles += 4;	Sbc(pCpu, Read(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uY, true)));			break;	/* SBC abs,Y */
+		case 0xFD:	pCpu->m_uCycles += 4;	Sbc(pCpu, Read(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uX, true)));			break;	/* SBC abs,X */
+		case 0xFE:	pCpu->m_uCycles += 7;	Modify(pCpu, Indexed(pCpu, Fetch16(pCpu), pCpu->m_uX, false), Inc);				break;	/* INC abs,X */
+
+		default:
+			--pCpu->m_uPC;
+			pCpu->m_uEvent = CPU6502_EVENT_JAMMED;
+		return 0;
+	}
+
+	++pCpu->m_uInstructions;
+	return pCpu->m_uCycles - uStart;
+}
@@ -0,0 +1,64 @@
+//------------------------------------------------------------------------------------------------
+//---- 6502 Interpreter ... 2026 Dave Gaunt                                                   ----
+//------------------------------------------------------------------------------------------------
+//---- NMOS 6502, Documented Opcodes, Counted In Whole Cycles - One Instruction Per Step. RAM ----
+//---- Is A Flat 64K Array, One Page Goes To Callbacks For The Chip Being Tested.             ----
+//------------------------------------------------------------------------------------------------
+#ifndef __Cpu6502_h_included
+#define __Cpu6502_h_included
+
+#include "types.h"
+
+#define CPU6502_FLAG_C				(1 << 0)
+#define CPU6502_FLAG_Z				(1 << 1)
+#define CPU6502_FLAG_I				(1 << 2)
+#define CPU6502_FLAG_D				(1 << 3)
+#define CPU6502_FLAG_B				(1 << 4)		/* Only Ever On The Stack */
+#define CPU6502_FLAG_U				(1 << 5)		/* Always Reads As 1 */
+#define CPU6502_FLAG_V				(1 << 6)
+#define CPU6502_FLAG_N				(1 << 7)
+
+#define CPU6502_VECTOR_NMI			(0xFFFA)
+#define CPU6502_VECTOR_RESET		(0xFFFC)
+#define CPU6502_VECTOR_IRQ			(0xFFFE)
+
+// What The Last Step Did.
+enum cpu6502_events
+{
+	CPU6502_EVENT_INSTRUCTION = 0,
+	CPU6502_EVENT_NMI,
+	CPU6502_EVENT_IRQ,
+	CPU6502_EVENT_JAMMED			/* Undocumented Opcode - The PC Stays On It */
+};
+
+typedef u8 (*Cpu6502Read)(void* pContext, const u16 uAddress);
+typedef void (*Cpu6502Write)(void* pContext, const u16 uAddress, const u8 uData);
+
+typedef struct
+{
+	u8*				m_pMemory;			/* 64K */
+	Cpu6502Read		m_pReadIo;
+	Cpu6502Write	m_pWriteIo;
+	void*			m_pContext;
+	u32				m_uIoPage;			/* High Byte Of The Addresses Going To The Callbacks */
+
+	u16	m_uPC;
+	u8	m_uA;
+	u8	m_uX;
+	u8	m_uY;
+	u8	m_uS;
+	u8	m_uP;
+
+	bool m_bIrq;						/* #IRQ Held Low - Level, Masked By I */
+	bool m_bNmi;						/* #NMI Edge Seen - Cleared As It Is Taken */
+	u8	m_uEvent;
+
+	u32	m_uCycles;						/* Running Count - The I/O Callbacks See The Instruction's Last Cycle */
+	u32	m_uInstructions;
+} Cpu6502;
+
+void Cpu6502_Init(Cpu6502* pCpu, u8* pMemory, const u32 uIoPage, Cpu6502Read pReadIo, Cpu6502Write pWriteIo, void* pContext);
+void Cpu6502_Reset(Cpu6502* pCpu);
+u32 Cpu6502_Step(Cpu6502* pCpu);
+
+#endif /* __Cpu6502_h_included */
@@ -0,0 +1,157 @@
+//------------------------------------------------------------------------------------------------
+//---- Logic Scope ... 2026 Dave Gaunt                                                        ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include <string.h>
+
+#include "LogicScope.h"
+#include "VgaDisplay.h"
+
+static const char s_aszLaneNames[LOGIC_SCOPE_LANES][4] =
+{
+	"PA0", "PA1", "PA2", "PA3", "PA4", "PA5", "PA6", "PA7",
+	"PB0", "PB1", "PB2", "PB3", "PB4", "PB5", "PB6", "PB7",
+	"IRQ", "S02"
+};
+
+static const u8 s_aLaneColours[LOGIC_SCOPE_LANES] =
+{
+	RGB_YELLOW, RGB_YELLOW, RGB_YELLOW, RGB_YELLOW, RGB_YELLOW, RGB_YELLOW, RGB_YELLOW, RGB_YELLOW,
+	RGB_CYAN, RGB_CYAN, RGB_CYAN, RGB_CYAN, RGB_CYAN, RGB_CYAN, RGB_CYAN, RGB_CYAN,
+	RGB_RED, RGB_GREEN
+};
+
+//------------------------------------------------------------------------------------------------
+//---- Before Core1 Starts Adding - uDecimate Samples Make One Column, 0 Is Taken As 1.       ----
+//------------------------------------------------------------------------------------------------
+void LogicCapture_Init(LogicCapture* pCapture, const u32 uDecimate)
+{
+	memset((void*)pCapture, 0, sizeof(*pCapture));
+
+	pCapture->m_uDecimate = uDecimate ? uDecimate : 1;
+	pCapture->m_uCountdown = pCapture->m_uDecimate;
+	pCapture->m_uAnd = 0xFFFFFFFF;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Clears The Area And Draws The Labels. Columns Are Cut Back To Fit Inside The Border,   ----
+//---- And A Scope That Does Not Fit At All Just Keeps Up With The Capture.                   ----
+//------------------------------------------------------------------------------------------------
+void LogicScope_Init(LogicScope* pScope, const LogicCapture* pCapture, const u32 uX, const u32 uY, const u32 uColumns)
+{
+	pScope->m_uX = uX & ~1;
+	pScope->m_uY = uY;
+	pScope->m_uColumns = 0;
+	pScope->m_uTail = pCapture->m_uHead;
+	pScope->m_uLost = 0;
+	pScope->m_uStep = 0;
+	pScope->m_uLane = LOGIC_SCOPE_LANES;
+	pScope->m_uPrevious = 0;
+
+	const u32 uTraceX = pScope->m_uX + LOGIC_SCOPE_LABEL_W;
+
+	if (((uTraceX + 2) >= VGA_RESOLUTION_X) || ((uY + LOGIC_SCOPE_HEIGHT) > VGA_RESOLUTION_Y))
+		return;
+
+	const u32 uMaxColumns = (VGA_RESOLUTION_X - 1 - uTraceX) >> 1;
+	pScope->m_uColumns = (uColumns < uMaxColumns) ? uColumns : uMaxColumns;
+
+	FilledRectangle(pScope->m_uX, uY, LOGIC_SCOPE_LABEL_W + (pScope->m_uColumns << 1), LOGIC_SCOPE_HEIGHT, RGB_BLACK);
+
+	for (u32 uLane=0; uLane<LOGIC_SCOPE_LANES; ++uLane)
+	{
+		for (u32 uChar=0; uChar<3; ++uChar)
+			DrawPetsciiChar(pScope->m_uX + (uChar << 3), uY + (uLane * LOGIC_SCOPE_LANE_H), AsciiToScreenCode(s_aszLaneNames[uLane][uChar]), s_aLaneColours[uLane]);
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Once A Frame - Takes Up To LOGIC_SCOPE_MAX_STEP New Columns, Or None While The Last    ----
+//---- Batch Is Still Being Drawn. Falling Over Half The Ring Behind Skips To The Newer Half, ----
+//---- So Core1 Never Overwrites A Column Being Copied.                                       ----
+//------------------------------------------------------------------------------------------------
+u32 LogicScope_Begin(LogicScope* pScope, const LogicCapture* pCapture)
+{
+	if (pScope->m_uLane < LOGIC_SCOPE_LANES)
+		return 0;
+
+	const u32 uHead = pCapture->m_uHead;
+	u32 uTail = pScope->m_uTail;
+
+	if (0 == pScope->m_uColumns)
+	{
+		pScope->m_uTail = uHead;
+		return 0;
+	}
+
+	if ((uHead - uTail) > (LOGIC_CAPTURE_SIZE / 2))
+	{
+		pScope->m_uLost += (uHead - uTail) - (LOGIC_CAPTURE_SIZE / 2);
+		uTail = uHead - (LOGIC_CAPTURE_SIZE / 2);
+	}
+
+	u32 uStep = uHead - uTail;
+	if (uStep > LOGIC_SCOPE_MAX_STEP)
+		uStep = LOGIC_SCOPE_MAX_STEP;
+	if (uStep > pScope->m_uColumns)
+		uStep = pScope->m_uColumns;
+
+	if (0 == uStep)
+		return 0;
+
+	// The Very First Column Has Nothing Before It, So Shows No Edge.
+	if (pScope->m_uStep)
+		pScope->m_uPrevious = pScope->m_aValue[pScope->m_uStep - 1];
+	else
+		pScope->m_uPrevious = pCapture->m_aValue[uTail & (LOGIC_CAPTURE_SIZE - 1)];
+
+	for (u32 uColumn=0; uColumn<uStep; ++uColumn)
+	{
+		pScope->m_aValue[uColumn] = pCapture->m_aValue[(uTail + uColumn) & (LOGIC_CAPTURE_SIZE - 1)];
+		pScope->m_aToggled[uColumn] = pCapture->m_aToggled[(uTail + uColumn) & (LOGIC_CAPTURE_SIZE - 1)];
+	}
+
+	pScope->m_uTail = uTail + uStep;
+	pScope->m_uStep = uStep;
+	pScope->m_uLane = 0;
+	return uStep;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- One Lane Of The Batch - Its Trace Rows Move Left A Byte A Column, Then Only The New  ----
+//---- Columns Are Drawn. A Level Is A Top Or Bottom Line, A Column That Moved Is Solid.      ----
+//---- False Once Every Lane Is Done, So Each Call Is A Short Slice Of Work.                  ----
+//------------------------------------------------------------------------------------------------
+bool __hot_path_func(LogicScope_Step)(LogicScope* pScope)
+{
+	if (pScope->m_uLane >= LOGIC_SCOPE_LANES)
+		return false;
+
+	const u32 uLane = pScope->m_uLane++;
+	const u32 uStep = pScope->m_uStep;
+	const u32 uKeep = pScope->m_uColumns - uStep;
+	const u8 uPair = (u8)(s_aLaneColours[uLane] | (s_aLaneColours[uLane] << 3));
+	const u32 uFirst = ((pScope->m_uY + (uLane * LOGIC_SCOPE_LANE_H)) * VGA_BYTES_PER_LINE) + ((pScope->m_uX + LOGIC_SCOPE_LABEL_W) >> 1);
+
+	for (u32 uRow=1; uRow<(LOGIC_SCOPE_LANE_H - 1); ++uRow)
+	{
+		u8* pRow = (u8*)&aVGAScreenBuffer[uFirst + (uRow * VGA_BYTES_PER_LINE)];
+		u32 uLast = (pScope->m_uPrevious >> uLane) & 1;
+
+		memmove(pRow, pRow + uStep, uKeep);
+		pRow += uKeep;
+
+		for (u32 uColumn=0; uColumn<uStep; ++uColumn)
+		{
+			const u32 uLevel = (pScope->m_aValue[uColumn] >> uLane) & 1;
+			const bool bMoved = (0 != ((pScope->m_aToggled[uColumn] >> uLane) & 1)) || (uLevel != uLast);
+			const bool bLit = bMoved || (uRow == (uLevel ? 1 : (LOGIC_SCOPE_LANE_H - 2)));
+
+			pRow[uColumn] = bLit ? uPair : RGB_BLACK;
+			uLast = uLevel;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,80 @@
+//------------------------------------------------------------------------------------------------
+//---- Logic Scope ... 2026 Dave Gaunt                                                        ----
+//------------------------------------------------------------------------------------------------
+//---- A Rolling View Of Port A, Port B, #IRQ And Phase 2. Core1 Adds One Sample A Cycle And  ----
+//---- Every Nth Becomes A Column; Core0 Shifts The Traces Left And Draws Only The New Ones.  ----
+//------------------------------------------------------------------------------------------------
+#ifndef __LogicScope_h_included
+#define __LogicScope_h_included
+
+#include "types.h"
+
+#define LOGIC_CAPTURE_SIZE		(256)			/* Columns, Must Be A Power Of 2! */
+#define LOGIC_SCOPE_MAX_STEP	(32)			/* Most Columns Taken In One Frame */
+
+// One Sample - Port A In Bits 0-7, Port B In 8-15, Then The #IRQ Pin Level (High = Idle).
+#define LOGIC_SCOPE_IRQ			(1 << 16)
+#define LOGIC_SCOPE_S02			(1 << 17)
+#define LOGIC_SCOPE_SAMPLE(uPorts, uIrq)	(((uPorts) & 0xFFFF) | (((uIrq) & 1) << 16))
+
+// A Lane Per Sample Bit, Top To Bottom - PA0 First, Phase 2 Last.
+#define LOGIC_SCOPE_LANES		(18)
+#define LOGIC_SCOPE_LANE_H		(7)				/* Pixels, Trace In Rows 1 - 5 */
+#define LOGIC_SCOPE_LABEL_W		(32)
+#define LOGIC_SCOPE_HEIGHT		(LOGIC_SCOPE_LANES * LOGIC_SCOPE_LANE_H)
+
+// Core1 Writes Everything Here, Core0 Only Reads The Ring Up To m_uHead.
+typedef struct
+{
+	volatile u32	m_aValue[LOGIC_CAPTURE_SIZE];		/* The Last Sample Of Each Column */
+	volatile u32	m_aToggled[LOGIC_CAPTURE_SIZE];		/* Bits That Moved Inside The Column */
+	volatile u32	m_uHead;							/* Columns Ever Written, Never Wraps */
+	u32				m_uDecimate;						/* Samples Per Column */
+	u32				m_uCountdown;
+	u32				m_uAnd;
+	u32				m_uOr;
+} LogicCapture;
+
+typedef struct
+{
+	u32	m_uX;							/* Pixels - The Labels, Then The Traces */
+	u32	m_uY;
+	u32	m_uColumns;						/* Two Pixels Each, The Newest On The Right */
+	u32	m_uTail;						/* Next Capture Column To Take */
+	u32	m_uLost;						/* Columns Skipped To Catch Up */
+	u32	m_uStep;						/* Columns In The Current Batch */
+	u32	m_uLane;						/* Next Lane To Shift, LOGIC_SCOPE_LANES Once Done */
+	u32	m_uPrevious;					/* The Column Drawn Before This Batch */
+	u32	m_aValue[LOGIC_SCOPE_MAX_STEP];
+	u32	m_aToggled[LOGIC_SCOPE_MAX_STEP];
+} LogicScope;
+
+void LogicCapture_Init(LogicCapture* pCapture, const u32 uDecimate);
+
+void LogicScope_Init(LogicScope* pScope, const LogicCapture* pCapture, const u32 uX, const u32 uY, const u32 uColumns);
+u32 LogicScope_Begin(LogicScope* pScope, const LogicCapture* pCapture);
+bool LogicScope_Step(LogicScope* pScope);
+
+//------------------------------------------------------------------------------------------------
+//---- On Core1 Once A Cycle - A Few Instructions, And A Ring Write Every uDecimate Calls.    ----
+//---- Phase 2 Always Counts As Moved, As Every Column Holds At Least One Whole Cycle.        ----
+//------------------------------------------------------------------------------------------------
+static inline void LogicCapture_Add(LogicCapture* pCapture, const u32 uSample)
+{
+	pCapture->m_uAnd &= uSample;
+	pCapture->m_uOr |= uSample;
+
+	if (--pCapture->m_uCountdown)
+		return;
+
+	const u32 uHead = pCapture->m_uHead;
+	pCapture->m_aValue[uHead & (LOGIC_CAPTURE_SIZE - 1)] = uSample;
+	pCapture->m_aToggled[uHead & (LOGIC_CAPTURE_SIZE - 1)] = (pCapture->m_uAnd ^ pCapture->m_uOr) | LOGIC_SCOPE_S02;
+	pCapture->m_uHead = uHead + 1;
+
+	pCapture->m_uCountdown = pCapture->m_uDecimate;
+	pCapture->m_uAnd = 0xFFFFFFFF;
+	pCapture->m_uOr = 0;
+}
+
+#endif /* __LogicScope_h_included */
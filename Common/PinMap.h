@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------------------------
+//---- Pin Map ... 2026 Dave Gaunt                                                            ----
+//------------------------------------------------------------------------------------------------
+//---- The 6522 Bus Wiring Shared By VIA_6522 And VIA_6522_Tester. Every Shift And Mask On    ----
+//---- The Bus Paths Comes From Here, And The Layout Is Checked Against The Board It Is For.  ----
+//------------------------------------------------------------------------------------------------
+#ifndef __PinMap_h_included
+#define __PinMap_h_included
+
+#include <assert.h>
+
+#include "types.h"
+
+// Set By The PIN_MAP_SINGLE_SHIFT CMake Option - A0-A3, R/W, #IRQ And D0-D7 On 14 Pins In A Row.
+#ifndef PIN_MAP_SINGLE_SHIFT
+#define PIN_MAP_SINGLE_SHIFT	(0)
+#endif
+
+// Set By The PIN_MAP_BOARD CMake Setting - Which GPIOs Reach The Bus Connector.
+#if PIN_MAP_BOARD_RP2350B
+#define PIN_MAP_BOARD_IO		(0xFFFFFFFFFFFFull & ~0x307ull)				/* Bare RP2350B, All But VGA */
+#else
+#define PIN_MAP_BOARD_IO		((0xFFFFFFFFFFFFull & ~0x3FFull) | 0x28ull)	/* RP2350b_40GPIO - 3, 5, 10 - 47 */
+#endif
+#define PIN_MAP_BOARD_VGA		(0x307ull)									/* RGB On 0 - 2, Syncs On 8 And 9 */
+
+#if PIN_MAP_SINGLE_SHIFT
+enum device_pins {
+	PIN_RED = 0,
+	PIN_GREEN,
+	PIN_BLUE,
+	PIN_S02_READ,
+	PIN_HSYNC = 8,
+	PIN_VSYNC,
+
+	PIN_ADDRESS_BIT0,		/* Bus Word Bits 0 - 3 */
+	PIN_ADDRESS_BIT1,
+	PIN_ADDRESS_BIT2,
+	PIN_ADDRESS_BIT3,
+	PIN_READ_WRITE,			/* Bit 4 */
+	PIN_IRQ,				/* Bit 5 */
+
+	PIN_DATA_BIT0,			/* Bits 6 - 13 */
+	PIN_DATA_BIT1,
+	PIN_DATA_BIT2,
+	PIN_DATA_BIT3,
+	PIN_DATA_BIT4,
+	PIN_DATA_BIT5,
+	PIN_DATA_BIT6,
+	PIN_DATA_BIT7,
+
+	PIN_CLK,				/* S02 - GPOUT2 */
+	PIN_RESET,
+	PIN_ADDRESS_CS1,		/* ADDRESS BIT 4 OR 5 On VIC */
+	PIN_IO0,				/* CS2 ACTIVE LOW */
+
+	PIN_CIA_SP,				/* CIA Personality Only */
+	PIN_CIA_CNT,
+	PIN_CIA_FLAG,
+	PIN_CIA_TOD,
+
+	PIN_PORT_A = 32,
+	PIN_PORT_B = 40
+};
+
+#define PIN_BUS_SHIFT			(PIN_ADDRESS_BIT0)
+#else
+enum device_pins {
+	PIN_RED = 0,
+	PIN_GREEN,
+	PIN_BLUE,
+	PIN_S02_READ,
+	PIN_HSYNC = 8,
+	PIN_VSYNC,
+
+	PIN_RESET,
+	PIN_ADDRESS_CS1,		/* ADDRESS BIT 4 OR 5 On VIC */
+	PIN_IO0,				/* CS2 ACTIVE LOW */
+	PIN_READ_WRITE,
+	PIN_IRQ,
+
+	PIN_DATA_BIT0,
+	PIN_DATA_BIT1,
+	PIN_DATA_BIT2,
+	PIN_DATA_BIT3,
+	PIN_DATA_BIT4,
+	PIN_DATA_BIT5,
+	PIN_DATA_BIT6,
+	PIN_DATA_BIT7,
+
+	PIN_CLK,				/* S02 - Data Transfer Occurs Only When Phase 2 Clock Is High */
+	PIN_ADDRESS_BIT0,
+	PIN_ADDRESS_BIT1,
+	PIN_ADDRESS_BIT2,
+	PIN_ADDRESS_BIT3,
+
+	PIN_CIA_SP,				/* CIA Personality Only */
+	PIN_CIA_CNT,
+	PIN_CIA_FLAG,
+	PIN_CIA_TOD,
+
+	PIN_PORT_A = 32,
+	PIN_PORT_B = 40
+};
+
+#define PIN_BUS_SHIFT			(PIN_READ_WRITE)
+#endif
+
+// Masks On The Low 32 Pins.
+#define PIN_DATA_MASK			(0xFF << PIN_DATA_BIT0)
+#define PIN_ADDRESS_MASK		(0xF << PIN_ADDRESS_BIT0)
+
+// Shifts And Masks On The High Pins, As gpioc_hi_in_get Returns Them.
+#define PIN_PORT_A_SHIFT		(PIN_PORT_A - 32)
+#define PIN_PORT_B_SHIFT		(PIN_PORT_B - 32)
+#define PIN_PORT_A_MASK			(0xFF << PIN_PORT_A_SHIFT)
+#define PIN_PORT_B_MASK			(0xFF << PIN_PORT_B_SHIFT)
+#define PIN_PORTS_MASK			(PIN_PORT_A_MASK | PIN_PORT_B_MASK)
+
+// The Bus Word - The Low Pins Shifted Once, Then Each Field Is At A Fixed Place In It.
+#define PIN_BUS_WORD(uLow32Pins)	((uLow32Pins) >> PIN_BUS_SHIFT)
+#define PIN_BUS_REGISTER(uBus)		(((uBus) >> (PIN_ADDRESS_BIT0 - PIN_BUS_SHIFT)) & 0xF)
+#define PIN_BUS_DATA(uBus)			(((uBus) >> (PIN_DATA_BIT0 - PIN_BUS_SHIFT)) & 0xFF)
+#define PIN_BUS_READ(uBus)			(((uBus) >> (PIN_READ_WRITE - PIN_BUS_SHIFT)) & 1)
+
+//------------------------------------------------------------------------------------------------
+//---- Checked Here So A Layout That Will Not Work Never Reaches The Bench.                   ----
+//------------------------------------------------------------------------------------------------
+#define PIN_MAP_BIT(uPin)		(1ull << (uPin))
+#define PIN_MAP_RUN(uPin, uCount)	(((1ull << (uCount)) - 1) << (uPin))
+
+#define PIN_MAP_VGA				(PIN_MAP_RUN(PIN_RED, 3) | PIN_MAP_BIT(PIN_HSYNC) | PIN_MAP_BIT(PIN_VSYNC))
+#define PIN_MAP_SIGNALS			(PIN_MAP_BIT(PIN_S02_READ) | PIN_MAP_BIT(PIN_RESET) | PIN_MAP_BIT(PIN_ADDRESS_CS1) | PIN_MAP_BIT(PIN_IO0) | \
+								 PIN_MAP_BIT(PIN_READ_WRITE) | PIN_MAP_BIT(PIN_IRQ) | PIN_MAP_BIT(PIN_CLK) | \
+								 PIN_MAP_BIT(PIN_CIA_SP) | PIN_MAP_BIT(PIN_CIA_CNT) | PIN_MAP_BIT(PIN_CIA_FLAG) | PIN_MAP_BIT(PIN_CIA_TOD))
+#define PIN_MAP_BUSES			(PIN_MAP_RUN(PIN_DATA_BIT0, 8) | PIN_MAP_RUN(PIN_ADDRESS_BIT0, 4) | PIN_MAP_RUN(PIN_PORT_A, 8) | PIN_MAP_RUN(PIN_PORT_B, 8))
+
+// Added Rather Than Or'd - Any Pin Used Twice Carries Into Another Bit.
+#define PIN_MAP_SUM				(PIN_MAP_RUN(PIN_RED, 3) + PIN_MAP_BIT(PIN_HSYNC) + PIN_MAP_BIT(PIN_VSYNC) + \
+								 PIN_MAP_BIT(PIN_S02_READ) + PIN_MAP_BIT(PIN_RESET) + PIN_MAP_BIT(PIN_ADDRESS_CS1) + PIN_MAP_BIT(PIN_IO0) + \
+								 PIN_MAP_BIT(PIN_READ_WRITE) + PIN_MAP_BIT(PIN_IRQ) + PIN_MAP_BIT(PIN_CLK) + \
+								 PIN_MAP_BIT(PIN_CIA_SP) + PIN_MAP_BIT(PIN_CIA_CNT) + PIN_MAP_BIT(PIN_CIA_FLAG) + PIN_MAP_BIT(PIN_CIA_TOD) + \
+								 PIN_MAP_RUN(PIN_DATA_BIT0, 8) + PIN_MAP_RUN(PIN_ADDRESS_BIT0, 4) + PIN_MAP_RUN(PIN_PORT_A, 8) + PIN_MAP_RUN(PIN_PORT_B, 8))
+
+static_assert(PIN_MAP_SUM == (PIN_MAP_VGA | PIN_MAP_SIGNALS | PIN_MAP_BUSES), "Two Signals Share A Pin!");
+static_assert(PIN_MAP_VGA == PIN_MAP_BOARD_VGA, "The VGA Pins Are Wired On The Board!");
+static_assert(0 == ((PIN_MAP_SIGNALS | PIN_MAP_BUSES) & ~PIN_MAP_BOARD_IO), "A Bus Pin Is Not Brought Out On This Board!");
+
+static_assert((PIN_DATA_BIT7 == PIN_DATA_BIT0 + 7) && (PIN_ADDRESS_BIT3 == PIN_ADDRESS_BIT0 + 3), "Data And Address Must Each Be In Order!");
+static_assert(PIN_MAP_SIGNALS < PIN_MAP_BIT(32), "Core1 Reads The Bus With gpioc_lo_in_get Alone!");
+static_assert((PIN_DATA_BIT7 < 32) && (PIN_ADDRESS_BIT3 < 32), "Core1 Reads The Bus With gpioc_lo_in_get Alone!");
+static_assert((PIN_PORT_A >= 32) && (PIN_PORT_B == PIN_PORT_A + 8) && (PIN_PORT_B + 8 <= 48), "Both Ports In The High Pins, Port B Following Port A!");
+static_assert((PIN_CIA_CNT == PIN_CIA_SP + 1) && (PIN_CIA_FLAG == PIN_CIA_SP + 2) && (PIN_CIA_TOD == PIN_CIA_SP + 3), "The CIA Pins Are Set Up In One Loop!");
+static_assert((PIN_BUS_SHIFT <= PIN_READ_WRITE) && (PIN_BUS_SHIFT <= PIN_DATA_BIT0) && (PIN_BUS_SHIFT <= PIN_ADDRESS_BIT0), "The Bus Word Starts At Its Lowest Pin!");
+
+// The Tester Makes Phase 2 With clock_gpio_init, Which Only Drives The GPOUT Pins.
+static_assert((13 == PIN_CLK) || (15 == PIN_CLK) || (21 == PIN_CLK) || (23 == PIN_CLK) || (24 == PIN_CLK) || (25 == PIN_CLK), "Phase 2 Must Be On A GPOUT Pin!");
+
+#endif /* __PinMap_h_included */
@@ -0,0 +1,196 @@
+//------------------------------------------------------------------------------------------------
+//---- Scheduler ... 2026 Dave Gaunt                                                          ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include "Scheduler.h"
+
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+
+#include "hardware/structs/m33.h"
+
+typedef struct
+{
+	SchedulerTask	m_pTask;
+	u32				m_uEventMask;
+} SchedulerEntry;
+
+static SchedulerEntry s_aTasks[SCHEDULER_MAX_TASKS];
+static u32 s_uTaskCount = 0;
+static u32 s_uNextBackground = 0;
+static u32 s_uDoorbellMask = 0;
+static volatile u32 s_uPosted = 0;
+
+static SchedulerStats s_stats = {0};
+static u32 s_uStatsStart = 0;
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+static inline u32 CycleCount(void)
+{
+	return m33_hw->dwt_cyccnt;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Starts The M33 Cycle Counter, The Idle Time Is Measured With It.                       ----
+//------------------------------------------------------------------------------------------------
+void Scheduler_Init(void)
+{
+	m33_hw->demcr |= M33_DEMCR_TRCENA_BITS;
+	m33_hw->dwt_ctrl |= M33_DWT_CTRL_CYCCNTENA_BITS;
+
+	s_uTaskCount = 0;
+	s_uStatsStart = CycleCount();
+}
+
+//------------------------------------------------------------------------------------------------
+//---- One Doorbell Core1 Can Ring On Core0 - Returns Its Event Mask.                         ----
+//------------------------------------------------------------------------------------------------
+u32 Scheduler_ClaimEvent(void)
+{
+	const u32 uEventMask = 1u << multicore_doorbell_claim_unused(1u << 0, true);
+
+	multicore_doorbell_clear_current_core(__builtin_ctz(uEventMask));
+	s_uDoorbellMask |= uEventMask;
+
+	return uEventMask;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Event Tasks Run In The Order They Are Added, So Add The Most Urgent First.             ----
+//------------------------------------------------------------------------------------------------
+void Scheduler_AddTask(SchedulerTask pTask, const u32 uEventMask)
+{
+	if (s_uTaskCount < SCHEDULER_MAX_TASKS)
+	{
+		s_aTasks[s_uTaskCount].m_pTask = pTask;
+		s_aTasks[s_uTaskCount].m_uEventMask = uEventMask;
+		++s_uTaskCount;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Core0 Side - From A Task Or An Interrupt Handler.                                      ----
+//------------------------------------------------------------------------------------------------
+void __hot_path_func(Scheduler_Post)(const u32 uEventMask)
+{
+	const u32 uSave = save_and_disable_interrupts();
+	s_uPosted |= uEventMask;
+	restore_interrupts(uSave);
+
+	__sev();
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Pending Doorbells Are Read And Cleared In One Go - Any Rung After That Stay Pending.   ----
+//------------------------------------------------------------------------------------------------
+static u32 __hot_path_func(TakeEvents)(void)
+{
+	const u32 uDoorbells = sio_hw->doorbell_in_clr & s_uDoorbellMask;
+
+	if (uDoorbells)
+		sio_hw->doorbell_in_clr = uDoorbells;
+
+	const u32 uSave = save_and_disable_interrupts();
+	const u32 uPosted = s_uPosted;
+	s_uPosted = 0;
+	restore_interrupts(uSave);
+
+	return uDoorbells | uPosted;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Never Returns. Events Always Go First, Then One Background Slice, Then Events Again.   ----
+//---- It Only Sleeps Once Every Background Task Has Said It Has Nothing Left To Do.          ----
+//------------------------------------------------------------------------------------------------
+void __hot_path_func(Scheduler_Run)(void)
+{
+	u32 uPassStart = CycleCount();
+	u32 uBackgroundMask = 0;
+
+	for (u32 uTaskIndex=0; uTaskIndex<s_uTaskCount; ++uTaskIndex)
+	{
+		if (SCHEDULER_BACKGROUND == s_aTasks[uTaskIndex].m_uEventMask)
+			uBackgroundMask |= 1 << uTaskIndex;
+	}
+
+	// Every Background Task Gets A Look In After Each Wake Up.
+	u32 uBusyMask = uBackgroundMask;
+
+	while(true)
+	{
+		const u32 uEvents = TakeEvents();
+
+		if (uEvents)
+		{
+			for (u32 uTaskIndex=0; uTaskIndex<s_uTaskCount; ++uTaskIndex)
+			{
+				const SchedulerEntry* pEntry = &s_aTasks[uTaskIndex];
+
+				if ((pEntry->m_uEventMask & uEvents) && pEntry->m_pTask())
+					Scheduler_Post(pEntry->m_uEventMask & uEvents);
+			}
+
+			const u32 uEventCycles = CycleCount() - uPassStart;
+
+			if (uEventCycles > s_stats.m_uMaxEventCycles)
+				s_stats.m_uMaxEventCycles = uEventCycles;
+		}
+
+		// Background Tasks Take Turns, So One Busy Task Cannot Starve The Others.
+		if (uBusyMask)
+		{
+			do
+			{
+				s_uNextBackground = (s_uNextBackground + 1) % s_uTaskCount;
+			}
+			while (0 == ((uBusyMask >> s_uNextBackground) & 1));
+
+			const u32 uSliceStart = CycleCount();
+			const bool bMoreWork = s_aTasks[s_uNextBackground].m_pTask();
+			const u32 uSliceCycles = CycleCount() - uSliceStart;
+
+			if (uSliceCycles > s_stats.m_uMaxSliceCycles)
+				s_stats.m_uMaxSliceCycles = uSliceCycles;
+
+			if (!bMoreWork)
+				uBusyMask &= ~(1 << s_uNextBackground);
+		}
+
+		// A Doorbell, SEV Or Interrupt Since The Events Were Taken Makes WFE Return At Once.
+		if ((0 == uBusyMask) && (0 == s_uPosted))
+		{
+			const u32 uIdleStart = CycleCount();
+			__wfe();
+			uPassStart = CycleCount();
+
+			s_stats.m_uIdleCycles += uPassStart - uIdleStart;
+			++s_stats.m_uWakeUps;
+
+			uBusyMask = uBackgroundMask;
+		}
+		else
+		{
+			uPassStart = CycleCount();
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Totals Since The Last Call, Then Starts Counting Again - Call From A Task.             ----
+//------------------------------------------------------------------------------------------------
+void Scheduler_GetStats(SchedulerStats* pStats)
+{
+	const u32 uNow = CycleCount();
+
+	*pStats = s_stats;
+	pStats->m_uTotalCycles = uNow - s_uStatsStart;
+
+	s_stats.m_uIdleCycles = 0;
+	s_stats.m_uWakeUps = 0;
+	s_stats.m_uMaxEventCycles = 0;
+	s_stats.m_uMaxSliceCycles = 0;
+	s_uStatsStart = uNow;
+}
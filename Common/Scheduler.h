@@ -0,0 +1,46 @@
+//------------------------------------------------------------------------------------------------
+//---- Scheduler ... 2026 Dave Gaunt                                                          ----
+//------------------------------------------------------------------------------------------------
+//---- Cooperative Core0 Task Loop. Core1 Rings SIO Doorbells To Wake It, Event Tasks Run In  ----
+//---- The Order They Were Added, Then One Slice Of Background Work, Then WFE Until The Next. ----
+//------------------------------------------------------------------------------------------------
+#ifndef __Scheduler_h_included
+#define __Scheduler_h_included
+
+#include "types.h"
+
+#include "hardware/sync.h"
+#include "hardware/structs/sio.h"
+
+#define SCHEDULER_MAX_TASKS		(8)
+#define SCHEDULER_BACKGROUND	(0)				/* Event Mask For A Task That Runs Whenever Nothing Is Pending */
+
+// Return true To Be Run Again Straight Away - An Event Task Then Stays Pending.
+typedef bool (*SchedulerTask)(void);
+
+typedef struct
+{
+	u32	m_uIdleCycles;					/* Spent In WFE Since The Last Scheduler_GetStats */
+	u32	m_uTotalCycles;
+	u32	m_uWakeUps;
+	u32	m_uMaxEventCycles;				/* Longest From Noticing An Event To Its Task Finishing */
+	u32	m_uMaxSliceCycles;				/* Longest Background Slice - How Long An Event Can Wait */
+} SchedulerStats;
+
+void Scheduler_Init(void);
+u32 Scheduler_ClaimEvent(void);
+void Scheduler_AddTask(SchedulerTask pTask, const u32 uEventMask);
+void Scheduler_Post(const u32 uEventMask);
+void Scheduler_Run(void);
+void Scheduler_GetStats(SchedulerStats* pStats);
+
+//------------------------------------------------------------------------------------------------
+//---- Core1 Side - One Store And A SEV, So It Never Waits On Core0.                          ----
+//------------------------------------------------------------------------------------------------
+static inline void Scheduler_Signal(const u32 uEventMask)
+{
+	sio_hw->doorbell_out_set = uEventMask;
+	__sev();
+}
+
+#endif /* __Scheduler_h_included */
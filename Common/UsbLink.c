@@ -0,0 +1,323 @@
+//------------------------------------------------------------------------------------------------
+//---- USB Link ... 2026 Dave Gaunt                                                           ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include <string.h>
+
+#include "UsbLink.h"
+
+#if !USB_LINK_HOST_BUILD
+#include "tusb.h"
+#endif
+
+enum usb_link_rx_states
+{
+	USB_LINK_RX_SYNC0 = 0,
+	USB_LINK_RX_SYNC1,
+	USB_LINK_RX_HEADER,
+	USB_LINK_RX_PAYLOAD,
+	USB_LINK_RX_CRC
+};
+
+// Frames Are Only Ever Added To The Fill Buffer While The Other One Drains Into The CDC FIFO.
+typedef struct
+{
+	u8	m_aData[USB_LINK_TX_BUFFER_SIZE];
+	u32	m_uLength;
+	u32	m_uSent;
+} UsbLinkTxBuffer;
+
+static UsbLinkTxBuffer s_aTxBuffers[2];
+static u32 s_uFillBuffer = 0;
+
+static UsbLinkHandler s_pHandler = NULL;
+static UsbLinkFrame s_rxFrame;
+static UsbLinkFrame s_responseFrame;
+static u32 s_uRxState = USB_LINK_RX_SYNC0;
+static u32 s_uRxCount = 0;
+static u8 s_aRxHeader[4];
+static u8 s_aRxCrc[2];
+static u32 s_uCrcErrors = 0;
+
+//------------------------------------------------------------------------------------------------
+//---- CRC-16/CCITT, MSB First - Python's binascii.crc_hqx(Data, 0xFFFF) Gives The Same.      ----
+//------------------------------------------------------------------------------------------------
+u16 UsbLink_Crc16(u16 uCrc, const u8* pData, u32 uBytes)
+{
+	while (uBytes--)
+	{
+		uCrc ^= (u16)(*pData++ << 8);
+
+		for (u32 uBit=0; uBit<8; ++uBit)
+			uCrc = (uCrc & 0x8000) ? (u16)((uCrc << 1) ^ 0x1021) : (u16)(uCrc << 1);
+	}
+
+	return uCrc;
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void UsbLink_Init(UsbLinkHandler pHandler)
+{
+	s_pHandler = pHandler;
+	s_uRxState = USB_LINK_RX_SYNC0;
+	s_uFillBuffer = 0;
+	s_aTxBuffers[0].m_uLength = s_aTxBuffers[0].m_uSent = 0;
+	s_aTxBuffers[1].m_uLength = s_aTxBuffers[1].m_uSent = 0;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Room Left In The Fill Buffer, Including The Header And CRC Of Any Frame Put There.     ----
+//------------------------------------------------------------------------------------------------
+u32 UsbLink_GetTxSpace(void)
+{
+	return USB_LINK_TX_BUFFER_SIZE - s_aTxBuffers[s_uFillBuffer].m_uLength;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Never Waits - Returns false, And Sends Nothing, If The Whole Frame Will Not Fit.       ----
+//------------------------------------------------------------------------------------------------
+bool UsbLink_Send(const UsbLinkFrame* pFrame)
+{
+	UsbLinkTxBuffer* pBuffer = &s_aTxBuffers[s_uFillBuffer];
+	const u32 uFrameBytes = USB_LINK_HEADER_SIZE + pFrame->m_uLength + USB_LINK_CRC_SIZE;
+
+	if ((pFrame->m_uLength > USB_LINK_MAX_PAYLOAD) || (uFrameBytes > UsbLink_GetTxSpace()))
+		return false;
+
+	u8* pOut = &pBuffer->m_aData[pBuffer->m_uLength];
+	pOut[0] = USB_LINK_SYNC0;
+	pOut[1] = USB_LINK_SYNC1;
+	pOut[2] = pFrame->m_uCommand;
+	pOut[3] = pFrame->m_uSequence;
+	pOut[4] = pFrame->m_uLength & 0xFF;
+	pOut[5] = pFrame->m_uLength >> 8;
+	memcpy(&pOut[USB_LINK_HEADER_SIZE], pFrame->m_aPayload, pFrame->m_uLength);
+
+	const u16 uCrc = UsbLink_Crc16(0xFFFF, &pOut[2], 4 + pFrame->m_uLength);
+	pOut[USB_LINK_HEADER_SIZE + pFrame->m_uLength] = uCrc & 0xFF;
+	pOut[USB_LINK_HEADER_SIZE + pFrame->m_uLength + 1] = uCrc >> 8;
+
+	pBuffer->m_uLength += uFrameBytes;
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+static void SendError(const u8 uCommand, const u8 uSequence, const u32 uError)
+{
+	s_responseFrame.m_uCommand = USB_LINK_COMMAND_ERROR;
+	s_responseFrame.m_uSequence = uSequence;
+	s_responseFrame.m_uLength = 2;
+	s_responseFrame.m_aPayload[0] = uCommand;
+	s_responseFrame.m_aPayload[1] = (u8)uError;
+	UsbLink_Send(&s_responseFrame);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- A Whole Frame With A Good CRC - Hand It To The Handler And Send What Comes Back.       ----
+//------------------------------------------------------------------------------------------------
+static void DispatchFrame(void)
+{
+	s_responseFrame.m_uCommand = s_rxFrame.m_uCommand | USB_LINK_RESPONSE;
+	s_responseFrame.m_uSequence = s_rxFrame.m_uSequence;
+	s_responseFrame.m_uLength = 0;
+
+	const u32 uError = s_pHandler ? s_pHandler(&s_rxFrame, &s_responseFrame) : USB_LINK_ERROR_UNKNOWN_COMMAND;
+
+	if (USB_LINK_ERROR_NONE != uError)
+		SendError(s_rxFrame.m_uCommand, s_rxFrame.m_uSequence, uError);
+	else
+		UsbLink_Send(&s_responseFrame);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- One Byte At A Time - Anything That Is Not A Frame Is Skipped Until The Next Sync.      ----
+//------------------------------------------------------------------------------------------------
+static void ReceiveByte(const u8 uByte)
+{
+	switch(s_uRxState)
+	{
+		case USB_LINK_RX_SYNC0:
+			if (USB_LINK_SYNC0 == uByte)
+				s_uRxState = USB_LINK_RX_SYNC1;
+		break;
+
+		case USB_LINK_RX_SYNC1:
+			if (USB_LINK_SYNC1 == uByte)
+			{
+				s_uRxState = USB_LINK_RX_HEADER;
+				s_uRxCount = 0;
+			}
+			else if (USB_LINK_SYNC0 != uByte)
+			{
+				s_uRxState = USB_LINK_RX_SYNC0;
+			}
+		break;
+
+		case USB_LINK_RX_HEADER:
+			s_aRxHeader[s_uRxCount++] = uByte;
+
+			if (4 == s_uRxCount)
+			{
+				s_rxFrame.m_uCommand = s_aRxHeader[0];
+				s_rxFrame.m_uSequence = s_aRxHeader[1];
+				s_rxFrame.m_uLength = s_aRxHeader[2] | (s_aRxHeader[3] << 8);
+				s_uRxCount = 0;
+
+				if (s_rxFrame.m_uLength > USB_LINK_MAX_PAYLOAD)
+				{
+					SendError(s_rxFrame.m_uCommand, s_rxFrame.m_uSequence, USB_LINK_ERROR_BAD_LENGTH);
+					s_uRxState = USB_LINK_RX_SYNC0;
+				}
+				else
+				{
+					s_uRxState = s_rxFrame.m_uLength ? USB_LINK_RX_PAYLOAD : USB_LINK_RX_CRC;
+				}
+			}
+		break;
+
+		case USB_LINK_RX_PAYLOAD:
+			s_rxFrame.m_aPayload[s_uRxCount++] = uByte;
+
+			if (s_uRxCount == s_rxFrame.m_uLength)
+			{
+				s_uRxState = USB_LINK_RX_CRC;
+				s_uRxCount = 0;
+			}
+		break;
+
+		case USB_LINK_RX_CRC:
+			s_aRxCrc[s_uRxCount++] = uByte;
+
+			if (2 == s_uRxCount)
+			{
+				u16 uCrc = UsbLink_Crc16(0xFFFF, s_aRxHeader, 4);
+				uCrc = UsbLink_Crc16(uCrc, s_rxFrame.m_aPayload, s_rxFrame.m_uLength);
+
+				if (uCrc == (s_aRxCrc[0] | (s_aRxCrc[1] << 8)))
+				{
+					DispatchFrame();
+				}
+				else
+				{
+					++s_uCrcErrors;
+					SendError(s_rxFrame.m_uCommand, s_rxFrame.m_uSequence, USB_LINK_ERROR_CRC);
+				}
+
+				s_uRxState = USB_LINK_RX_SYNC0;
+			}
+		break;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//---- When The Draining Buffer Is Empty The Buffers Swap, So Sends Never Wait On USB.        ----
+//------------------------------------------------------------------------------------------------
+static UsbLinkTxBuffer* GetDrainBuffer(void)
+{
+	UsbLinkTxBuffer* pDrain = &s_aTxBuffers[s_uFillBuffer ^ 1];
+
+	if (pDrain->m_uSent == pDrain->m_uLength)
+	{
+		pDrain->m_uLength = pDrain->m_uSent = 0;
+
+		if (0 == s_aTxBuffers[s_uFillBuffer].m_uLength)
+			return NULL;
+
+		pDrain = &s_aTxBuffers[s_uFillBuffer];
+		s_uFillBuffer ^= 1;
+	}
+
+	return pDrain;
+}
+
+#if USB_LINK_HOST_BUILD
+//------------------------------------------------------------------------------------------------
+//---- Host Builds - The Test Feeds Bytes In And Takes The Replies Out Itself.                ----
+//------------------------------------------------------------------------------------------------
+u32 UsbLink_Receive(const u8* pData, u32 uBytes)
+{
+	u32 uTaken = 0;
+
+	// The Same Rule As UsbLink_Service - Stop Reading Once A Reply Might Not Fit.
+	while ((uTaken < uBytes) && (UsbLink_GetTxSpace() >= USB_LINK_MAX_FRAME))
+		ReceiveByte(pData[uTaken++]);
+
+	return uTaken;
+}
+
+u32 UsbLink_TakeOutput(u8* pData, u32 uMaxBytes)
+{
+	u32 uTaken = 0;
+	UsbLinkTxBuffer* pDrain;
+
+	while ((uTaken < uMaxBytes) && (NULL != (pDrain = GetDrainBuffer())))
+	{
+		u32 uBytes = pDrain->m_uLength - pDrain->m_uSent;
+
+		if (uBytes > (uMaxBytes - uTaken))
+			uBytes = uMaxBytes - uTaken;
+
+		memcpy(&pData[uTaken], &pDrain->m_aData[pDrain->m_uSent], uBytes);
+		pDrain->m_uSent += uBytes;
+		uTaken += uBytes;
+	}
+
+	return uTaken;
+}
+
+void UsbLink_Service(void)
+{
+}
+#else
+//------------------------------------------------------------------------------------------------
+//---- Call From The Main Loop After tud_task - Commands Are Only Read While Any Reply Fits.  ----
+//------------------------------------------------------------------------------------------------
+void UsbLink_Service(void)
+{
+	while (tud_cdc_available() && (UsbLink_GetTxSpace() >= USB_LINK_MAX_FRAME))
+	{
+		u8 uByte;
+
+		if (0 == tud_cdc_read(&uByte, 1))
+			break;
+
+		ReceiveByte(uByte);
+	}
+
+	UsbLinkTxBuffer* pDrain;
+	bool bWritten = false;
+
+	while (NULL != (pDrain = GetDrainBuffer()))
+	{
+		const u32 uSpace = tud_cdc_write_available();
+		u32 uBytes = pDrain->m_uLength - pDrain->m_uSent;
+
+		if (uBytes > uSpace)
+			uBytes = uSpace;
+
+		const u32 uWritten = uBytes ? tud_cdc_write(&pDrain->m_aData[pDrain->m_uSent], uBytes) : 0;
+
+		if (0 == uWritten)
+			break;
+
+		pDrain->m_uSent += uWritten;
+		bWritten = true;
+	}
+
+	if (bWritten)
+		tud_cdc_write_flush();
+}
+#endif
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+u32 UsbLink_GetCrcErrors(void)
+{
+	return s_uCrcErrors;
+}
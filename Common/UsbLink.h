@@ -0,0 +1,62 @@
+//------------------------------------------------------------------------------------------------
+//---- USB Link ... 2026 Dave Gaunt                                                           ----
+//------------------------------------------------------------------------------------------------
+//---- Framed Binary Commands Over USB CDC - A5 5A, Command, Sequence, Length (LE), Payload,  ----
+//---- Then CRC-16/CCITT (0x1021, Seed 0xFFFF) Over Everything After The Sync Bytes.          ----
+//------------------------------------------------------------------------------------------------
+#ifndef __UsbLink_h_included
+#define __UsbLink_h_included
+
+#include "types.h"
+
+// Host Builds Swap TinyUSB For UsbLink_Receive / UsbLink_TakeOutput - See VIA_6522/Host/usb_link_test.py.
+#ifndef USB_LINK_HOST_BUILD
+#define USB_LINK_HOST_BUILD			(0)
+#endif
+
+#define USB_LINK_SYNC0				(0xA5)
+#define USB_LINK_SYNC1				(0x5A)
+#define USB_LINK_HEADER_SIZE		(6)				/* Sync x 2, Command, Sequence, Length x 2 */
+#define USB_LINK_CRC_SIZE			(2)
+#define USB_LINK_MAX_PAYLOAD		(512)
+#define USB_LINK_MAX_FRAME			(USB_LINK_HEADER_SIZE + USB_LINK_MAX_PAYLOAD + USB_LINK_CRC_SIZE)
+#define USB_LINK_TX_BUFFER_SIZE		(2048)			/* Each Of The Two, Holds A Few Whole Frames */
+
+#define USB_LINK_RESPONSE			(0x80)			/* Or'd Into The Command Of A Reply */
+#define USB_LINK_COMMAND_ERROR		(0xFF)			/* Payload = Command, Error Code */
+
+enum usb_link_errors
+{
+	USB_LINK_ERROR_NONE = 0,
+	USB_LINK_ERROR_CRC,								/* Command Byte Is Whatever Arrived, It May Be Wrong */
+	USB_LINK_ERROR_UNKNOWN_COMMAND,
+	USB_LINK_ERROR_BAD_LENGTH,
+	USB_LINK_ERROR_BAD_ARGUMENT,
+	USB_LINK_ERROR_UNSUPPORTED,
+	USB_LINK_ERROR_BUSY								/* Still Doing The Last One - Try Again */
+};
+
+typedef struct
+{
+	u8	m_uCommand;
+	u8	m_uSequence;
+	u16	m_uLength;
+	u8	m_aPayload[USB_LINK_MAX_PAYLOAD];
+} UsbLinkFrame;
+
+// Called Once For Every Good Frame - Fill In The Response Payload, Length And Any Error.
+typedef u32 (*UsbLinkHandler)(const UsbLinkFrame* pRequest, UsbLinkFrame* pResponse);
+
+void UsbLink_Init(UsbLinkHandler pHandler);
+void UsbLink_Service(void);
+bool UsbLink_Send(const UsbLinkFrame* pFrame);
+u32 UsbLink_GetTxSpace(void);
+u32 UsbLink_GetCrcErrors(void);
+u16 UsbLink_Crc16(u16 uCrc, const u8* pData, u32 uBytes);
+
+#if USB_LINK_HOST_BUILD
+u32 UsbLink_Receive(const u8* pData, u32 uBytes);
+u32 UsbLink_TakeOutput(u8* pData, u32 uMaxBytes);
+#endif
+
+#endif /* __UsbLink_h_included */
@@ -0,0 +1,281 @@
+//------------------------------------------------------------------------------------------------
+//---- VGA Console ... 2026 Dave Gaunt                                                        ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include <string.h>
+
+#include "VgaConsole.h"
+#include "VgaDisplay.h"
+#include "VgaSprites.h"
+
+#if !VGA_HOST_BUILD
+#include "pico/stdlib.h"
+#include "pico/stdio/driver.h"
+#endif
+
+#define VGA_CONSOLE_TAB_SIZE		(4)
+
+typedef struct
+{
+	u32	m_uLeftChar;
+	u32	m_uTopChar;
+	u32	m_uCharsWide;
+	u32	m_uCharsHigh;
+	u32	m_uCursorX;						/* Window Relative */
+	u32	m_uCursorY;
+	u32	m_uScrollRow;					/* Frame Buffer Row Currently At The Top Of The Window */
+	u32	m_uCursorSprite;				/* VGA_SPRITE_NONE For No Cursor */
+	u8	m_uColour;
+} VgaConsoleState;
+
+static VgaConsoleState s_console = {.m_uCursorSprite = VGA_SPRITE_NONE};
+
+// One Solid Character Cell In The Console Colour.
+static u8 s_aCursorPixels[8 * VGA_SPRITE_BYTES_PER_ROW(8)];
+
+// Characters Waiting To Be Drawn - printf Only Ever Queues, VgaConsole_Service Draws.
+static volatile char s_aConsoleBuffer[VGA_CONSOLE_BUFFER_SIZE];
+static volatile u32 s_uConsoleHead = 0;
+static volatile u32 s_uConsoleTail = 0;
+static volatile u32 s_uDroppedChars = 0;
+
+//------------------------------------------------------------------------------------------------
+//---- Window Row To The Frame Buffer Row That Holds It.                                      ----
+//------------------------------------------------------------------------------------------------
+static inline u32 PhysicalRow(const u32 uWindowRow)
+{
+	return s_console.m_uTopChar + ((s_console.m_uScrollRow + uWindowRow) % s_console.m_uCharsHigh);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Only The Window Columns Are Cleared So Anything Either Side Is Left Alone.             ----
+//------------------------------------------------------------------------------------------------
+static void __hot_path_func(ClearPhysicalRow)(const u32 uRow)
+{
+	for (u32 uLine=0; uLine<8; ++uLine)
+	{
+		u8* pLine = (u8*)&aVGAScreenBuffer[(((uRow << 3) + uLine) * VGA_BYTES_PER_LINE) + (s_console.m_uLeftChar << 2)];
+		memset(pLine, RGB_BLACK, s_console.m_uCharsWide << 2);
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Point Every Line Of The Window At The Frame Buffer Row That Should Appear There.       ----
+//------------------------------------------------------------------------------------------------
+static void __hot_path_func(UpdateLineTable)(void)
+{
+	for (u32 uRow=0; uRow<s_console.m_uCharsHigh; ++uRow)
+	{
+		const u32 uSourceLine = PhysicalRow(uRow) << 3;
+		const u32 uDisplayLine = (s_console.m_uTopChar + uRow) << 3;
+
+		for (u32 uLine=0; uLine<8; ++uLine)
+			SetVGALineAddress(uDisplayLine + uLine, &aVGAScreenBuffer[(uSourceLine + uLine) * VGA_BYTES_PER_LINE]);
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Scroll Up One Text Row - The Old Top Row Is Cleared And Becomes The New Bottom Row.    ----
+//------------------------------------------------------------------------------------------------
+static void __hot_path_func(ScrollConsole)(void)
+{
+	ClearPhysicalRow(PhysicalRow(0));
+	s_console.m_uScrollRow = (s_console.m_uScrollRow + 1) % s_console.m_uCharsHigh;
+	UpdateLineTable();
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+static void __hot_path_func(NewLine)(void)
+{
+	s_console.m_uCursorX = 0;
+
+	if ((s_console.m_uCursorY + 1) < s_console.m_uCharsHigh)
+		++s_console.m_uCursorY;
+	else
+		ScrollConsole();
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+static void __hot_path_func(PutChar)(const char c)
+{
+	switch(c)
+	{
+		case '\n':
+			NewLine();
+		break;
+
+		case '\r':
+			s_console.m_uCursorX = 0;
+		break;
+
+		case '\t':
+			do
+			{
+				PutChar(' ');
+			} while (s_console.m_uCursorX % VGA_CONSOLE_TAB_SIZE);
+		break;
+
+		default:
+		{
+			if (s_console.m_uCursorX >= s_console.m_uCharsWide)
+				NewLine();
+
+			const u32 uCharX = s_console.m_uLeftChar + s_console.m_uCursorX;
+			DrawPetsciiChar(uCharX << 3, PhysicalRow(s_console.m_uCursorY) << 3, AsciiToScreenCode(c), s_console.m_uColour);
+			++s_console.m_uCursorX;
+		}
+		break;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//---- The Cursor Is A Sprite Over The Next Character Cell, So Blinking It Never Has To Save  ----
+//---- Or Redraw What Is Underneath. Shown On Screen Rows, Which The Scroll Does Not Move.    ----
+//------------------------------------------------------------------------------------------------
+static void __hot_path_func(UpdateCursor)(void)
+{
+	if (VGA_SPRITE_NONE == s_console.m_uCursorSprite)
+		return;
+
+	// Past The Last Column Is Still Waiting To Wrap - Keep The Cursor In The Window Until It Does.
+	u32 uColumn = s_console.m_uCursorX;
+	if (uColumn >= s_console.m_uCharsWide)
+		uColumn = s_console.m_uCharsWide - 1;
+
+	VgaSprites_Move(s_console.m_uCursorSprite, (s_console.m_uLeftChar + uColumn) << 3, (s_console.m_uTopChar + s_console.m_uCursorY) << 3);
+	VgaSprites_Show(s_console.m_uCursorSprite, 0 == (GetVGAFrameCount() & VGA_CONSOLE_CURSOR_BLINK));
+}
+
+#if !VGA_HOST_BUILD
+//------------------------------------------------------------------------------------------------
+//---- stdio Driver So printf Lands On The Screen.                                            ----
+//------------------------------------------------------------------------------------------------
+static void VgaConsoleOutChars(const char* pszBuffer, int iLength)
+{
+	VgaConsole_Write(pszBuffer, iLength);
+}
+
+static stdio_driver_t s_vgaConsoleStdio =
+{
+	.out_chars = VgaConsoleOutChars,
+#if PICO_STDIO_ENABLE_CRLF_SUPPORT
+	.crlf_enabled = false
+#endif
+};
+#endif
+
+//------------------------------------------------------------------------------------------------
+//---- Window Position And Size Are In 8x8 Characters.                                        ----
+//------------------------------------------------------------------------------------------------
+void VgaConsole_Init(const u32 uLeftChar, const u32 uTopChar, const u32 uCharsWide, const u32 uCharsHigh, const u8 uColour)
+{
+	s_console.m_uLeftChar = uLeftChar;
+	s_console.m_uTopChar = uTopChar;
+	s_console.m_uCharsWide = uCharsWide;
+	s_console.m_uCharsHigh = uCharsHigh;
+	s_console.m_uCursorX = 0;
+	s_console.m_uCursorY = 0;
+	s_console.m_uScrollRow = 0;
+
+	VgaSprites_Show(s_console.m_uCursorSprite, false);
+	s_console.m_uCursorSprite = VGA_SPRITE_NONE;
+	s_console.m_uColour = uColour;
+
+	for (u32 uRow=0; uRow<uCharsHigh; ++uRow)
+		ClearPhysicalRow(uTopChar + uRow);
+
+	UpdateLineTable();
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void VgaConsole_EnableStdio(void)
+{
+#if !VGA_HOST_BUILD
+	stdio_set_driver_enabled(&s_vgaConsoleStdio, true);
+#endif
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Blinking Block Cursor On Sprite uSprite, Moved By VgaConsole_Service. Call After Init. ----
+//------------------------------------------------------------------------------------------------
+void VgaConsole_EnableCursor(const u32 uSprite)
+{
+	if (0 == s_console.m_uCharsHigh)
+		return;
+
+	memset(s_aCursorPixels, (s_console.m_uColour << 3) | s_console.m_uColour, sizeof(s_aCursorPixels));
+
+	// Any Key But The Colour - Every Pixel Is Drawn.
+	if (VgaSprites_Set(uSprite, s_aCursorPixels, 8, 8, s_console.m_uColour ^ 7))
+	{
+		s_console.m_uCursorSprite = uSprite;
+		UpdateCursor();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Never Blocks - If The Buffer Is Full The Text Is Dropped And Counted.                  ----
+//------------------------------------------------------------------------------------------------
+void VgaConsole_Write(const char* pszText, int iLength)
+{
+	u32 uTail = s_uConsoleTail;
+
+	while (iLength-- > 0)
+	{
+		const u32 uNextTail = (uTail + 1) & (VGA_CONSOLE_BUFFER_SIZE - 1);
+
+		if (uNextTail == s_uConsoleHead)
+		{
+			s_uDroppedChars += iLength + 1;
+			break;
+		}
+
+		s_aConsoleBuffer[uTail] = *pszText++;
+		uTail = uNextTail;
+	}
+
+	s_uConsoleTail = uTail;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Draw Up To uMaxChars Queued Characters - Call From The Main Loop.                      ----
+//------------------------------------------------------------------------------------------------
+void __hot_path_func(VgaConsole_Service)(u32 uMaxChars)
+{
+	if (0 == s_console.m_uCharsHigh)
+		return;
+
+	u32 uHead = s_uConsoleHead;
+
+	while ((uHead != s_uConsoleTail) && uMaxChars--)
+	{
+		PutChar(s_aConsoleBuffer[uHead]);
+		uHead = (uHead + 1) & (VGA_CONSOLE_BUFFER_SIZE - 1);
+	}
+
+	s_uConsoleHead = uHead;
+	UpdateCursor();
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Room Left In The Queue - Lets A Caller Hold Back A Whole Line Rather Than Lose Half.   ----
+//------------------------------------------------------------------------------------------------
+u32 VgaConsole_GetSpace(void)
+{
+	return (s_uConsoleHead - s_uConsoleTail - 1) & (VGA_CONSOLE_BUFFER_SIZE - 1);
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+u32 VgaConsole_GetDroppedChars(void)
+{
+	return s_uDroppedChars;
+}
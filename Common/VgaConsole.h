@@ -0,0 +1,22 @@
+//------------------------------------------------------------------------------------------------
+//---- VGA Console ... 2026 Dave Gaunt                                                        ----
+//------------------------------------------------------------------------------------------------
+//---- Scrolling Text Window - Scrolls By Rotating The VGA Line Table, Not By Moving Pixels.  ----
+//------------------------------------------------------------------------------------------------
+#ifndef __VgaConsole_h_included
+#define __VgaConsole_h_included
+
+#include "types.h"
+
+#define VGA_CONSOLE_BUFFER_SIZE		(2048)			/* Must Be A Power Of 2! */
+#define VGA_CONSOLE_CURSOR_BLINK	(32)			/* Frames On, Then Off - Must Be A Power Of 2! */
+
+void VgaConsole_Init(const u32 uLeftChar, const u32 uTopChar, const u32 uCharsWide, const u32 uCharsHigh, const u8 uColour);
+void VgaConsole_EnableStdio(void);
+void VgaConsole_EnableCursor(const u32 uSprite);
+void VgaConsole_Write(const char* pszText, int iLength);
+void VgaConsole_Service(u32 uMaxChars);
+u32 VgaConsole_GetSpace(void);
+u32 VgaConsole_GetDroppedChars(void);
+
+#endif /* __VgaConsole_h_included */
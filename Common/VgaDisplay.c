@@ -0,0 +1,612 @@
+//------------------------------------------------------------------------------------------------
+//---- VGA Display ... 2026 Dave Gaunt                                                        ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include <string.h>
+
+#include "VgaDisplay.h"
+#include "VgaSprites.h"
+
+#if !VGA_HOST_BUILD
+#include "pico/stdlib.h"
+
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/interp.h"
+#include "hardware/structs/m33.h"
+
+#include "ClockPlan.h"
+
+#include "hsync.pio.h"
+#include "vsync.pio.h"
+#include "rgb.pio.h"
+#endif
+
+#include "VicChars.h"
+
+u8 volatile aVGAScreenBuffer[(VGA_RESOLUTION_X * VGA_RESOLUTION_Y) >> 1];
+
+#if HOT_PATH_IN_RAM
+// Every Glyph Drawn Reads The ROM, And A Miss In The XIP Cache Costs Far More Than The Draw.
+static u8 s_aCharRom[VicChars901460_03_size];
+#endif
+
+const u8* pVGACharRom = VicChars901460_03;
+
+// DMA channels - 0 sends one line of color data, 1 feeds it the next line address
+#define RGB_CHAN_0		(0)
+#define RGB_CHAN_1		(1)
+
+// Start Address Of Every Scan Line, NULL Terminated - The NULL Ends The Frame. Line Doubled, Each
+// Frame Buffer Line Has Two Entries, So The DMA Sends It Twice With No Help From The CPU.
+static const volatile u8* volatile s_apLineAddress[VGA_SCAN_Y + 1];
+static volatile u32 s_uFrameCount = 0;
+
+#if !VGA_HOST_BUILD
+// What The DMA Reads Instead While A Sprite Is Showing - Each Entry Is Filled A Line Ahead, With
+// The Frame Buffer Line Or With One Of Two Alternating Copies That Have The Sprites Drawn On.
+static const volatile u8* volatile s_apScanAddress[VGA_SCAN_Y + 1];
+static u8 s_aOverlayLine[2][VGA_BYTES_PER_LINE] __attribute__((aligned(4)));
+static u32 s_uOverlayLine = 0xFFFFFFFF;				/* Frame Buffer Line Last Composited */
+#endif
+
+#if VGA_HOST_BUILD
+//------------------------------------------------------------------------------------------------
+//---- Host Builds Only Get The Line Table - Nothing Is Ever Sent Anywhere.                   ----
+//------------------------------------------------------------------------------------------------
+void initVGA(const u32 uPinRed, const u32 uPinHSync, const u32 uPinVSync)
+{
+	memset((u8*)aVGAScreenBuffer, RGB_BLACK, sizeof(aVGAScreenBuffer));
+
+	for (u32 uLine=0; uLine<VGA_RESOLUTION_Y; ++uLine)
+		SetVGALineAddress(uLine, &aVGAScreenBuffer[uLine * VGA_BYTES_PER_LINE]);
+
+	s_apLineAddress[VGA_SCAN_Y] = NULL;
+}
+#else
+// One Font Byte Expanded To Four Pixel Pairs, Every Lit Pixel Set To 0b111 Ready To Mask With A Colour.
+static u32 s_aGlyphExpand[256];
+
+#define COLOUR_TO_PIXEL_PAIRS(c)	((u32)(c) * 0x09090909u)
+
+//------------------------------------------------------------------------------------------------
+//---- Line Doubled, The Second Scan Line Of A Pair Reuses The Copy Made For The First.       ----
+//------------------------------------------------------------------------------------------------
+static void __not_in_flash_func(PrepareScanLine)(const u32 uScan)
+{
+	const u32 uLine = uScan >> VGA_LINE_DOUBLED;
+	const volatile u8* pSource = s_apLineAddress[uScan];
+
+	if (0 == VgaSprites_GetLineMask(uLine))
+	{
+		s_apScanAddress[uScan] = pSource;
+		return;
+	}
+
+	u8* pOverlay = s_aOverlayLine[uLine & 1];
+
+	if (uLine != s_uOverlayLine)
+	{
+		VgaSprites_ComposeLine(pOverlay, pSource, uLine);
+		s_uOverlayLine = uLine;
+	}
+
+	s_apScanAddress[uScan] = pOverlay;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Channel 1 Completes As Each Line Starts, But Only Interrupts While A Sprite Is         ----
+//---- Showing, To Get The Next Line Ready While This One Is Sent. Channel 0 Interrupts Once  ----
+//---- Channel 1 Wrote The NULL At The End Of The Table - Rewind It For The Next Frame.       ----
+//------------------------------------------------------------------------------------------------
+static void __not_in_flash_func(VGADmaIrqHandler)(void)
+{
+	const u32 uStatus = dma_hw->ints0;
+
+	if (uStatus & (1u << RGB_CHAN_1))
+	{
+		dma_channel_acknowledge_irq0(RGB_CHAN_1);
+
+		// The Read Address Has Already Moved On To The Entry For The Next Line.
+		const u32 uScan = (dma_hw->ch[RGB_CHAN_1].read_addr - (u32)s_apScanAddress) / sizeof(s_apScanAddress[0]);
+		if (uScan < VGA_SCAN_Y)
+			PrepareScanLine(uScan);
+	}
+
+	if (uStatus & (1u << RGB_CHAN_0))
+	{
+		dma_channel_acknowledge_irq0(RGB_CHAN_0);
+
+		if (VgaSprites_AnyVisible())
+		{
+			s_uOverlayLine = 0xFFFFFFFF;
+			PrepareScanLine(0);
+
+			dma_channel_acknowledge_irq0(RGB_CHAN_1);
+			dma_channel_set_irq0_enabled(RGB_CHAN_1, true);
+			dma_channel_set_read_addr(RGB_CHAN_1, s_apScanAddress, true);
+		}
+		else
+		{
+			dma_channel_set_irq0_enabled(RGB_CHAN_1, false);
+			dma_channel_set_read_addr(RGB_CHAN_1, s_apLineAddress, true);
+		}
+
+		++s_uFrameCount;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//---- INTERP0 Lane 0 Steps Down The Frame Buffer A Line At A Time On Every Pop.              ----
+//---- INTERP1 Turns A Font Byte (Pre Shifted Left By 2) Into The Address Of Its Expansion,   ----
+//---- Lane 0 From Bits 2-9 And Lane 1 From Bits 10-17, So One Write Serves Two Glyph Rows.   ----
+//------------------------------------------------------------------------------------------------
+static void InitDrawInterpolators(void)
+{
+	for (u32 uByte=0; uByte<256; ++uByte)
+	{
+		u32 uPixels = 0;
+
+		for (u32 uPair=0; uPair<4; ++uPair)
+		{
+			if (uByte & (0x80 >> (uPair << 1)))
+				uPixels |= 0x07 << (uPair << 3);
+
+			if (uByte & (0x40 >> (uPair << 1)))
+				uPixels |= 0x38 << (uPair << 3);
+		}
+
+		s_aGlyphExpand[uByte] = uPixels;
+	}
+
+	interp_config cfg = interp_default_config();
+	interp_set_config(interp0, 0, &cfg);
+	interp0->base[0] = VGA_BYTES_PER_LINE;
+
+	cfg = interp_default_config();
+	interp_config_set_mask(&cfg, 2, 9);
+	interp_set_config(interp1, 0, &cfg);
+
+	cfg = interp_default_config();
+	interp_config_set_shift(&cfg, 8);
+	interp_config_set_mask(&cfg, 2, 9);
+	interp_config_set_cross_input(&cfg, true);
+	interp_set_config(interp1, 1, &cfg);
+
+	interp1->base[0] = (u32)s_aGlyphExpand;
+	interp1->base[1] = (u32)s_aGlyphExpand;
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void initVGA(const u32 uPinRed, const u32 uPinHSync, const u32 uPinVSync)
+{
+	// Choose which PIO instance to use (there are two instances, each with 4 state machines)
+	PIO pio = pio0;
+	const uint hsync_offset = pio_add_program(pio, &hsync_program);
+	const uint vsync_offset = pio_add_program(pio, &vsync_program);
+#if VGA_LINE_DOUBLED
+	const uint rgb_offset = pio_add_program(pio, &rgb_doubled_program);
+#else
+	const uint rgb_offset = pio_add_program(pio, &rgb_program);
+#endif
+
+	// Manually select a few state machines from pio instance pio0.
+	uint hsync_sm = 0;
+	uint vsync_sm = 1;
+	uint rgb_sm = 2;
+	// Dividers Come From The Clock Plan, So The Timing Holds At Any Supported System Clock.
+	hsync_program_init(pio, hsync_sm, hsync_offset, uPinHSync, ClockPlan_GetSyncDivider());
+	vsync_program_init(pio, vsync_sm, vsync_offset, uPinVSync, ClockPlan_GetSyncDivider());
+#if VGA_LINE_DOUBLED
+	rgb_doubled_program_init(pio, rgb_sm, rgb_offset, uPinRed, ClockPlan_GetRgbDivider());
+#else
+	rgb_program_init(pio, rgb_sm, rgb_offset, uPinRed, ClockPlan_GetRgbDivider());
+#endif
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////
+	// ============================== PIO DMA Channels =================================================
+	/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Every Line Starts Off Showing Its Own Row Of The Frame Buffer.
+	for (u32 uLine=0; uLine<VGA_RESOLUTION_Y; ++uLine)
+		SetVGALineAddress(uLine, &aVGAScreenBuffer[uLine * VGA_BYTES_PER_LINE]);
+
+	s_apLineAddress[VGA_SCAN_Y] = NULL;
+	s_apScanAddress[VGA_SCAN_Y] = NULL;
+
+#if HOT_PATH_IN_RAM
+	memcpy(s_aCharRom, VicChars901460_03, sizeof(s_aCharRom));
+	pVGACharRom = s_aCharRom;
+#endif
+
+	// Channel Zero (sends one line of color data to PIO VGA machine)
+	dma_channel_config c0 = dma_channel_get_default_config(RGB_CHAN_0);  	// default configs
+	channel_config_set_transfer_data_size(&c0, DMA_SIZE_8);              	// 8-bit txfers
+	channel_config_set_read_increment(&c0, true);                        	// yes read incrementing
+	channel_config_set_write_increment(&c0, false);                      	// no write incrementing
+	channel_config_set_dreq(&c0, DREQ_PIO0_TX2) ;                        	// DREQ_PIO0_TX2 pacing (FIFO)
+	channel_config_set_chain_to(&c0, RGB_CHAN_1);                        	// chain to other channel
+	channel_config_set_irq_quiet(&c0, true);                             	// only interrupt on the NULL trigger
+
+	dma_channel_configure
+	(
+		RGB_CHAN_0,                                                        	// Channel to be configured
+		&c0,                                                               	// The configuration we just created
+		&pio->txf[rgb_sm],                                                 	// write address (RGB PIO TX FIFO)
+		&aVGAScreenBuffer,                                                 	// The initial read address (pixel color array)
+		VGA_BYTES_PER_LINE,                                                	// Number of transfers; one line of 1 byte transfers.
+		false                                                              	// Don't start immediately.
+	);
+
+	// Channel One (walks the line table, each write restarts the first channel)
+	dma_channel_config c1 = dma_channel_get_default_config(RGB_CHAN_1);  	// default configs
+	channel_config_set_transfer_data_size(&c1, DMA_SIZE_32);             	// 32-bit txfers
+	channel_config_set_read_increment(&c1, true);                        	// step through the line table
+	channel_config_set_write_increment(&c1, false);                      	// no write incrementing
+	channel_config_set_chain_to(&c1, RGB_CHAN_1);                        	// chaining to itself disables chaining
+
+	dma_channel_configure
+	(
+		RGB_CHAN_1,                                 	// Channel to be configured
+		&c1,                                        	// The configuration we just created
+		&dma_hw->ch[RGB_CHAN_0].al3_read_addr_trig, 	// Write address (channel 0 read address and trigger)
+		s_apLineAddress,                            	// Read address (TABLE OF LINE ADDRESSES)
+		1,                                          	// Number of transfers, in this case each is 4 byte
+		false                                       	// Don't start immediately.
+	);
+
+	dma_channel_set_irq0_enabled(RGB_CHAN_0, true);
+	irq_set_exclusive_handler(DMA_IRQ_0, VGADmaIrqHandler);
+	irq_set_enabled(DMA_IRQ_0, true);
+
+  /////////////////////////////////////////////////////////////////////////////////////////////////////
+  /////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Initialize PIO state machine counters. This passes the information to the state machines
+	// that they retrieve in the first 'pull' instructions, before the .wrap_target directive
+	// in the assembly. Each uses these values to initialize some counting registers.
+	#define H_ACTIVE   655    // (active + frontporch - 1) - one cycle delay for mov
+	#define V_ACTIVE   479    // (active - 1)
+	#define RGB_ACTIVE (VGA_BYTES_PER_LINE - 1)    // bytes per line - 1, two pixels (four when line doubled) each
+	// #define RGB_ACTIVE 639 // change to this if 1 pixel/byte
+	pio_sm_put_blocking(pio, hsync_sm, H_ACTIVE);
+	pio_sm_put_blocking(pio, vsync_sm, V_ACTIVE);
+	pio_sm_put_blocking(pio, rgb_sm, RGB_ACTIVE);
+
+	// Start the two pio machine IN SYNC
+	// The RGB state machine waits on the vsync IRQ at the start of
+	// every line, so synchronization doesn't matter for that one.
+	// But, we'll start them all simultaneously anyway.
+	pio_enable_sm_mask_in_sync(pio, ((1u << hsync_sm) | (1u << vsync_sm) | (1u << rgb_sm)));
+
+	// Start DMA channel 1. It loads the first line address into channel 0, and from
+	// then on the lines named in the table are continously DMA'd to the PIO machines
+	// that are driving the screen. To change the contents of the screen, change the
+	// frame buffer - to move whole lines around, change the table.
+	dma_start_channel_mask((1u << RGB_CHAN_1)) ;
+
+	InitDrawInterpolators();
+}
+#endif
+
+//------------------------------------------------------------------------------------------------
+//---- Point A Visible Line At Any Line's Worth Of Pixels. The DMA Reads The Table Live, So A ----
+//---- Line It Has Not Reached Yet Changes In This Frame - Moving Many Lines, As A Console    ----
+//---- Scroll Does, Can Show Half Old And Half New For One Frame. Line Doubled, That Is Both  ----
+//---- Scan Lines It Covers.                                                                  ----
+//------------------------------------------------------------------------------------------------
+void SetVGALineAddress(const u32 uLine, const volatile u8* pAddress)
+{
+	if (uLine < VGA_RESOLUTION_Y)
+	{
+		for (u32 uRepeat=0; uRepeat<=VGA_LINE_DOUBLED; ++uRepeat)
+			s_apLineAddress[(uLine << VGA_LINE_DOUBLED) + uRepeat] = pAddress;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//---- What Is Actually On Screen - The Console Scrolls By Moving These, Not The Pixels.      ----
+//------------------------------------------------------------------------------------------------
+const volatile u8* GetVGALineAddress(const u32 uLine)
+{
+	return (uLine < VGA_RESOLUTION_Y) ? s_apLineAddress[uLine << VGA_LINE_DOUBLED] : NULL;
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+u32 GetVGAFrameCount(void)
+{
+	return s_uFrameCount;
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+static void __hot_path_func(FilledRectangleC)(const u32 uPositionX, const u32 uPositionY, u32 uWidth, const u32 uHeight, const u32 uColour)
+{
+	u32 uPixelOffset = ((uPositionY * VGA_RESOLUTION_X) + uPositionX) >> 1;
+
+	if (uPositionX & 1)
+	{
+		u32 uOffset = uPixelOffset++;
+		--uWidth;
+
+		for(u32 y=0; y<uHeight; ++y)
+		{
+			aVGAScreenBuffer[uOffset] = (aVGAScreenBuffer[uOffset] & 0b11000111) | (uColour << 3);
+			uOffset += VGA_RESOLUTION_X >> 1;
+		}
+	}
+
+	while (uWidth > 1)
+	{
+		u32 uOffset = uPixelOffset++;
+		uWidth -= 2;
+
+		for(u32 y=0; y<uHeight; ++y)
+		{
+			aVGAScreenBuffer[uOffset] = (uColour << 3) | uColour;
+			uOffset += VGA_RESOLUTION_X >> 1;
+		}
+	}
+
+	if (1 == uWidth)
+	{
+		for(u32 y=0; y<uHeight; ++y)
+		{
+			aVGAScreenBuffer[uPixelOffset] = (aVGAScreenBuffer[uPixelOffset] & 0b11111000) | uColour;
+			uPixelOffset += VGA_RESOLUTION_X >> 1;
+		}
+	}
+}
+
+#if !VGA_HOST_BUILD
+//------------------------------------------------------------------------------------------------
+//---- Same Result As FilledRectangleC, Row By Row With INTERP0 Handing Out Line Addresses.   ----
+//------------------------------------------------------------------------------------------------
+static void __hot_path_func(FilledRectangleInterp)(const u32 uPositionX, const u32 uPositionY, u32 uWidth, const u32 uHeight, const u32 uColour)
+{
+	const bool bLeftHalf = uPositionX & 1;
+	const u8 uPixelPair = (uColour << 3) | uColour;
+
+	if (bLeftHalf)
+		--uWidth;
+
+	const u32 uMiddleBytes = uWidth >> 1;
+	const bool bRightHalf = uWidth & 1;
+
+	interp0->accum[0] = (u32)&aVGAScreenBuffer[((uPositionY * VGA_RESOLUTION_X) + uPositionX) >> 1] - VGA_BYTES_PER_LINE;
+
+	for (u32 y=0; y<uHeight; ++y)
+	{
+		u8* pLine = (u8*)interp_pop_lane_result(interp0, 0);
+
+		if (bLeftHalf)
+		{
+			*pLine = (*pLine & 0b11000111) | (uColour << 3);
+			++pLine;
+		}
+
+		memset(pLine, uPixelPair, uMiddleBytes);
+
+		if (bRightHalf)
+			pLine[uMiddleBytes] = (pLine[uMiddleBytes] & 0b11111000) | uColour;
+	}
+}
+#endif
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void __hot_path_func(FilledRectangle)(u32 uPositionX, u32 uPositionY, u32 uWidth, u32 uHeight, u32 uColour)
+{
+	// Layouts Made For 640 x 480 Still Build Line Doubled, So Anything Off The Edge Is Dropped.
+	if ((uPositionX >= VGA_RESOLUTION_X) || (uPositionY >= VGA_RESOLUTION_Y))
+		return;
+
+	if (uPositionX + uWidth >= VGA_RESOLUTION_X)
+		uWidth = VGA_RESOLUTION_X - uPositionX;
+
+	if (uPositionY + uHeight >= VGA_RESOLUTION_Y)
+		uHeight = VGA_RESOLUTION_Y - uPositionY;
+
+	if ((uWidth > 0) && (uHeight > 0))
+	{
+#if VGA_USE_INTERP
+		FilledRectangleInterp(uPositionX, uPositionY, uWidth, uHeight, uColour);
+#else
+		FilledRectangleC(uPositionX, uPositionY, uWidth, uHeight, uColour);
+#endif
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+static void __hot_path_func(DrawPetsciiCharC)(const u32 uXPos, const u32 uYPos, const u8 uChar, const u8 uColour)
+{
+	for (u32 uLine=0; uLine<8; ++uLine)
+	{
+		u32 uPixelOffset = ((((uYPos + uLine) * VGA_RESOLUTION_X ) + uXPos) >> 1) + 3;
+		u32 uCharLine = pVGACharRom[2048 + (uChar << 3) + uLine];
+
+		for (u32 x=0; x<4; ++x)
+		{
+			u8 uPixelPair = 0;
+
+			if (uCharLine & 2)
+				uPixelPair = uColour;
+
+			if (uCharLine & 1)
+				uPixelPair |= (uColour << 3);
+
+			aVGAScreenBuffer[uPixelOffset--] = uPixelPair;
+			uCharLine >>= 2;
+		}
+	}
+}
+
+#if !VGA_HOST_BUILD
+//------------------------------------------------------------------------------------------------
+//---- Each Glyph Row Is One Table Lookup Masked With The Colour And Stored As A Single Word. ----
+//------------------------------------------------------------------------------------------------
+static void __hot_path_func(DrawPetsciiCharInterp)(const u32 uXPos, const u32 uYPos, const u8 uChar, const u8 uColour)
+{
+	const u32 uColourPairs = COLOUR_TO_PIXEL_PAIRS(uColour);
+	const u32 uFirstLine = (u32)&aVGAScreenBuffer[((uYPos * VGA_RESOLUTION_X) + uXPos) >> 1];
+	u32 aGlyphRows[2];
+
+	memcpy(aGlyphRows, &pVGACharRom[2048 + (uChar << 3)], sizeof(aGlyphRows));
+	interp0->accum[0] = uFirstLine - VGA_BYTES_PER_LINE;
+
+	// Lines Are VGA_BYTES_PER_LINE Apart So If The First Is Word Aligned They All Are.
+	if (0 == (uFirstLine & 3))
+	{
+		for (u32 uWord=0; uWord<2; ++uWord)
+		{
+			interp1->accum[0] = aGlyphRows[uWord] << 2;
+			*(u32*)interp_pop_lane_result(interp0, 0) = *(const u32*)interp_peek_lane_result(interp1, 0) & uColourPairs;
+			*(u32*)interp_pop_lane_result(interp0, 0) = *(const u32*)interp_peek_lane_result(interp1, 1) & uColourPairs;
+
+			interp1->accum[0] = aGlyphRows[uWord] >> 14;
+			*(u32*)interp_pop_lane_result(interp0, 0) = *(const u32*)interp_peek_lane_result(interp1, 0) & uColourPairs;
+			*(u32*)interp_pop_lane_result(interp0, 0) = *(const u32*)interp_peek_lane_result(interp1, 1) & uColourPairs;
+		}
+	}
+	else
+	{
+		for (u32 uLine=0; uLine<8; ++uLine)
+		{
+			interp1->accum[0] = (u32)((const u8*)aGlyphRows)[uLine] << 2;
+			const u32 uPixels = *(const u32*)interp_peek_lane_result(interp1, 0) & uColourPairs;
+			memcpy((void*)interp_pop_lane_result(interp0, 0), &uPixels, sizeof(uPixels));
+		}
+	}
+}
+#endif
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void __hot_path_func(DrawPetsciiChar)(const u32 uXPos, const u32 uYPos, const u8 uChar, const u8 uColour)
+{
+	if (((uXPos + 8) > VGA_RESOLUTION_X) || ((uYPos + 8) > VGA_RESOLUTION_Y))
+		return;
+
+#if VGA_USE_INTERP
+	DrawPetsciiCharInterp(uXPos, uYPos, uChar, uColour);
+#else
+	DrawPetsciiCharC(uXPos, uYPos, uChar, uColour);
+#endif
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void __hot_path_func(DrawString)(u32 uCharX, u32 uCharY, const char* pszString, const u8 uColour)
+{
+	while (*pszString)
+	{
+		if (uCharX >= (TERMINAL_CHARS_WIDE-1))
+		{
+			uCharX = 1;
+			++uCharY;
+		}
+
+		if (uCharY >= (TERMINAL_CHARS_HIGH-1))
+			return;
+
+		DrawPetsciiChar(uCharX << 3, uCharY << 3, AsciiToScreenCode(*pszString++), uColour);
+		++uCharX;
+	}
+}
+
+#if !VGA_HOST_BUILD
+//------------------------------------------------------------------------------------------------
+//---- FNV-1a Over The Whole Frame Buffer A Word At A Time - Only Compared, Never Stored.     ----
+//------------------------------------------------------------------------------------------------
+static u32 HashFrameBuffer(void)
+{
+	const volatile u32* pWord = (const volatile u32*)aVGAScreenBuffer;
+	u32 uHash = 2166136261u;
+
+	for (u32 uWord=0; uWord<(sizeof(aVGAScreenBuffer) >> 2); ++uWord)
+		uHash = (uHash ^ pWord[uWord]) * 16777619u;
+
+	return uHash;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- The Same Characters And Rectangles Through One Path Or The Other, Over The Same        ----
+//---- Background - Glyphs At Every Byte Alignment, Rectangles With Odd And Even Edges.       ----
+//------------------------------------------------------------------------------------------------
+static u32 DrawCheckPattern(const bool bInterp)
+{
+	memset((u8*)aVGAScreenBuffer, (RGB_CYAN << 3) | RGB_RED, sizeof(aVGAScreenBuffer));
+
+	for (u32 uChar=0; uChar<VGA_CHECK_CHARS; ++uChar)
+	{
+		const u32 uXPos = (uChar * 13) % (VGA_RESOLUTION_X - 8);
+		const u32 uYPos = (uChar * 7) % (VGA_RESOLUTION_Y - 8);
+
+		if (bInterp)
+			DrawPetsciiCharInterp(uXPos, uYPos, (u8)uChar, uChar & 7);
+		else
+			DrawPetsciiCharC(uXPos, uYPos, (u8)uChar, uChar & 7);
+	}
+
+	for (u32 uRect=0; uRect<VGA_CHECK_RECTS; ++uRect)
+	{
+		const u32 uPositionX = (uRect * 37) % (VGA_RESOLUTION_X - 64);
+		const u32 uPositionY = (uRect * 11) % (VGA_RESOLUTION_Y - 16);
+		const u32 uWidth = 1 + (uRect % 63);
+		const u32 uHeight = 1 + (uRect % 15);
+
+		if (bInterp)
+			FilledRectangleInterp(uPositionX, uPositionY, uWidth, uHeight, uRect & 7);
+		else
+			FilledRectangleC(uPositionX, uPositionY, uWidth, uHeight, uRect & 7);
+	}
+
+	return HashFrameBuffer();
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Time Both Drawing Paths With The M33 Cycle Counter, Then Check They Draw The Same      ----
+//---- Pixels - m_uHashC And m_uHashInterp Must Match. Scribbles On The Frame Buffer!         ----
+//------------------------------------------------------------------------------------------------
+void BenchmarkVGADrawing(VGADrawBenchmark* pResult)
+{
+	m33_hw->demcr |= M33_DEMCR_TRCENA_BITS;
+	m33_hw->dwt_ctrl |= M33_DWT_CTRL_CYCCNTENA_BITS;
+
+	u32 uStart = m33_hw->dwt_cyccnt;
+	for (u32 uChar=0; uChar<VGA_BENCHMARK_CHARS; ++uChar)
+		DrawPetsciiCharC((uChar % TERMINAL_CHARS_WIDE) << 3, ((uChar / TERMINAL_CHARS_WIDE) % TERMINAL_CHARS_HIGH) << 3, (u8)uChar, uChar & 7);
+	pResult->m_uCharCyclesC = (m33_hw->dwt_cyccnt - uStart) / VGA_BENCHMARK_CHARS;
+
+	uStart = m33_hw->dwt_cyccnt;
+	for (u32 uChar=0; uChar<VGA_BENCHMARK_CHARS; ++uChar)
+		DrawPetsciiCharInterp((uChar % TERMINAL_CHARS_WIDE) << 3, ((uChar / TERMINAL_CHARS_WIDE) % TERMINAL_CHARS_HIGH) << 3, (u8)uChar, uChar & 7);
+	pResult->m_uCharCyclesInterp = (m33_hw->dwt_cyccnt - uStart) / VGA_BENCHMARK_CHARS;
+
+	// Odd Position And Width So Both Half Byte Edges Are Exercised.
+	uStart = m33_hw->dwt_cyccnt;
+	for (u32 uRect=0; uRect<VGA_BENCHMARK_RECTS; ++uRect)
+		FilledRectangleC(1, 1, VGA_RESOLUTION_X - 2, VGA_RESOLUTION_Y - 2, uRect & 7);
+	pResult->m_uRectCyclesC = (m33_hw->dwt_cyccnt - uStart) / VGA_BENCHMARK_RECTS;
+
+	uStart = m33_hw->dwt_cyccnt;
+	for (u32 uRect=0; uRect<VGA_BENCHMARK_RECTS; ++uRect)
+		FilledRectangleInterp(1, 1, VGA_RESOLUTION_X - 2, VGA_RESOLUTION_Y - 2, uRect & 7);
+	pResult->m_uRectCyclesInterp = (m33_hw->dwt_cyccnt - uStart) / VGA_BENCHMARK_RECTS;
+
+	pResult->m_uHashC = DrawCheckPattern(false);
+	pResult->m_uHashInterp = DrawCheckPattern(true);
+}
+#endif
@@ -0,0 +1,90 @@
+//------------------------------------------------------------------------------------------------
+//---- VGA Display ... 2026 Dave Gaunt                                                        ----
+//------------------------------------------------------------------------------------------------
+//---- 640 x 480 3 Bit Colour VGA Output Through PIO + DMA, Shared By All Projects - Or A     ----
+//---- 320 x 240 Frame Buffer Shown Line Doubled, For A Quarter Of The Memory.                ----
+//------------------------------------------------------------------------------------------------
+#ifndef __VgaDisplay_h_included
+#define __VgaDisplay_h_included
+
+#include "types.h"
+
+// 1 = 320 x 240, Every Pixel Sent Twice Across And Every Line Twice Down - The Same 640 x 480 Timing.
+#ifndef VGA_LINE_DOUBLED
+#define VGA_LINE_DOUBLED		(0)
+#endif
+
+#define VGA_SCAN_X				(640)							/* What The Monitor Is Sent Either Way */
+#define VGA_SCAN_Y				(480)
+#define VGA_RESOLUTION_X    	(VGA_SCAN_X >> VGA_LINE_DOUBLED)
+#define VGA_RESOLUTION_Y  		(VGA_SCAN_Y >> VGA_LINE_DOUBLED)
+#define VGA_BYTES_PER_LINE		(VGA_RESOLUTION_X >> 1)			/* Two 3 Bit Pixels Per Byte */
+#define TERMINAL_CHARS_WIDE		(VGA_RESOLUTION_X >> 3)
+#define TERMINAL_CHARS_HIGH		(VGA_RESOLUTION_Y >> 3)
+
+// 1 = Plain C Drawing And The Line Table Only, No SDK - For The Host Render Tests.
+#ifndef VGA_HOST_BUILD
+#define VGA_HOST_BUILD			(0)
+#endif
+
+// 1 = Draw Through The SIO Interpolators, 0 = Plain C. Drawing Must Stay On The Core That Called initVGA.
+#if VGA_HOST_BUILD
+#undef VGA_USE_INTERP
+#define VGA_USE_INTERP			(0)
+#elif !defined(VGA_USE_INTERP)
+#define VGA_USE_INTERP			(1)
+#endif
+
+#define VGA_BENCHMARK_CHARS		(4096)
+#define VGA_BENCHMARK_RECTS		(16)
+#define VGA_CHECK_CHARS			(1024)						/* Drawn Both Ways At Every Byte Alignment */
+#define VGA_CHECK_RECTS			(256)
+
+enum rgbColours {RGB_BLACK, RGB_RED, RGB_GREEN, RGB_YELLOW, RGB_BLUE, RGB_MAGENTA, RGB_CYAN, RGB_WHITE};
+
+typedef struct
+{
+	u32	m_uCharCyclesC;				/* Average CPU Cycles Per Call */
+	u32	m_uCharCyclesInterp;
+	u32	m_uRectCyclesC;
+	u32	m_uRectCyclesInterp;
+	u32	m_uHashC;					/* The Frame Buffer After The Same Pattern Is Drawn Each Way */
+	u32	m_uHashInterp;
+} VGADrawBenchmark;
+
+extern u8 volatile aVGAScreenBuffer[(VGA_RESOLUTION_X * VGA_RESOLUTION_Y) >> 1];
+
+// The Character ROM For Drawing And The VIC Renderer - initVGA Moves It To SRAM With HOT_PATH_IN_RAM.
+extern const u8* pVGACharRom;
+
+void initVGA(const u32 uPinRed, const u32 uPinHSync, const u32 uPinVSync);
+void SetVGALineAddress(const u32 uLine, const volatile u8* pAddress);
+const volatile u8* GetVGALineAddress(const u32 uLine);
+u32 GetVGAFrameCount(void);
+void FilledRectangle(u32 uPositionX, u32 uPositionY, u32 uWidth, u32 uHeight, u32 uColour);
+void DrawPetsciiChar(const u32 uXPos, const u32 uYPos, const u8 uChar, const u8 uColour);
+void DrawString(u32 uCharX, u32 uCharY, const char* pszString, const u8 uColour);
+void BenchmarkVGADrawing(VGADrawBenchmark* pResult);
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+static const u8 aHexTable[16] = {'0','1','2','3','4','5','6','7','8','9','A','B','C','D','E','F'};
+
+static inline u16 byteToHex(const u8 uByte)
+{
+	return (aHexTable[(uByte >> 4) & 15] << 8) | aHexTable[uByte & 15];
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Lower Case ASCII Maps Onto The Letters Of The Second VIC Character Set.                ----
+//------------------------------------------------------------------------------------------------
+static inline u8 AsciiToScreenCode(u8 c)
+{
+	if (c >= '`')
+		c -= '`';
+
+	return c;
+}
+
+#endif /* __VgaDisplay_h_included */
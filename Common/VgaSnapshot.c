@@ -0,0 +1,154 @@
+//------------------------------------------------------------------------------------------------
+//---- VGA Snapshot ... 2026 Dave Gaunt                                                       ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include "VgaSnapshot.h"
+
+#if VGA_HOST_BUILD
+#include <stdio.h>
+#else
+#include "pico/stdlib.h"
+
+#include "hardware/dma.h"
+#include "hardware/structs/m33.h"
+#endif
+
+static u32 s_uFrameStart = 0;
+
+#if VGA_HOST_BUILD
+//------------------------------------------------------------------------------------------------
+//---- Bit At A Time Reflected CRC-32 - Slow, But It Only Has To Agree With The Sniffer.      ----
+//------------------------------------------------------------------------------------------------
+static u32 Crc32Update(u32 uCrc, const volatile u8* pData, u32 uBytes)
+{
+	while (uBytes--)
+	{
+		uCrc ^= *pData++;
+
+		for (u32 uBit=0; uBit<8; ++uBit)
+			uCrc = (uCrc >> 1) ^ (0xEDB88320 & (0 - (uCrc & 1)));
+	}
+
+	return uCrc;
+}
+
+void VgaSnapshot_Init(void)
+{
+}
+
+u32 VgaSnapshot_Crc(void)
+{
+	u32 uCrc = 0xFFFFFFFF;
+
+	for (u32 uLine=0; uLine<VGA_RESOLUTION_Y; ++uLine)
+		uCrc = Crc32Update(uCrc, GetVGALineAddress(uLine), VGA_BYTES_PER_LINE);
+
+	return ~uCrc;
+}
+
+static inline u32 CycleCount(void)
+{
+	return 0;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Binary PPM Of The Displayed Frame - Low 3 Bits Of Each Byte Are The Left Pixel.        ----
+//------------------------------------------------------------------------------------------------
+bool VgaSnapshot_WritePpm(const char* pszPath)
+{
+	FILE* pFile = fopen(pszPath, "wb");
+
+	if (NULL == pFile)
+		return false;
+
+	fprintf(pFile, "P6\n%u %u\n255\n", VGA_RESOLUTION_X, VGA_RESOLUTION_Y);
+
+	for (u32 uLine=0; uLine<VGA_RESOLUTION_Y; ++uLine)
+	{
+		const volatile u8* pLine = GetVGALineAddress(uLine);
+		u8 aRgb[VGA_RESOLUTION_X * 3];
+
+		for (u32 uPixel=0; uPixel<VGA_RESOLUTION_X; ++uPixel)
+		{
+			const u32 uColour = (pLine[uPixel >> 1] >> ((uPixel & 1) * 3)) & 7;
+
+			aRgb[(uPixel * 3) + 0] = (uColour & RGB_RED) ? 255 : 0;
+			aRgb[(uPixel * 3) + 1] = (uColour & RGB_GREEN) ? 255 : 0;
+			aRgb[(uPixel * 3) + 2] = (uColour & RGB_BLUE) ? 255 : 0;
+		}
+
+		fwrite(aRgb, 1, sizeof(aRgb), pFile);
+	}
+
+	return 0 == fclose(pFile);
+}
+#else
+static int s_iSnapshotChannel = -1;
+static u32 s_uSnapshotSink;
+
+//------------------------------------------------------------------------------------------------
+//---- Claims A DMA Channel And Starts The M33 Cycle Counter.                                 ----
+//------------------------------------------------------------------------------------------------
+void VgaSnapshot_Init(void)
+{
+	if (s_iSnapshotChannel < 0)
+		s_iSnapshotChannel = dma_claim_unused_channel(true);
+
+	m33_hw->demcr |= M33_DEMCR_TRCENA_BITS;
+	m33_hw->dwt_ctrl |= M33_DWT_CTRL_CYCCNTENA_BITS;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Each Displayed Line Is DMA'd Into One Dummy Word - The Sniffer Keeps Its CRC Running   ----
+//---- From One Transfer To The Next. Bit Reversed Data, Reversed And Inverted Out = zlib.    ----
+//------------------------------------------------------------------------------------------------
+u32 VgaSnapshot_Crc(void)
+{
+	const uint uChannel = (uint)s_iSnapshotChannel;
+
+	dma_channel_config c = dma_channel_get_default_config(uChannel);
+	channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+	channel_config_set_read_increment(&c, true);
+	channel_config_set_write_increment(&c, false);
+	channel_config_set_sniff_enable(&c, true);
+
+	dma_sniffer_set_data_accumulator(0xFFFFFFFF);
+	dma_sniffer_set_output_reverse_enabled(true);
+	dma_sniffer_set_output_invert_enabled(true);
+	dma_sniffer_enable(uChannel, DMA_SNIFF_CTRL_CALC_VALUE_CRC32R, true);
+
+	for (u32 uLine=0; uLine<VGA_RESOLUTION_Y; ++uLine)
+	{
+		dma_channel_configure(uChannel, &c, &s_uSnapshotSink, GetVGALineAddress(uLine), VGA_BYTES_PER_LINE, true);
+		dma_channel_wait_for_finish_blocking(uChannel);
+	}
+
+	const u32 uCrc = dma_sniffer_get_data_accumulator();
+	dma_sniffer_disable();
+
+	return uCrc;
+}
+
+static inline u32 CycleCount(void)
+{
+	return m33_hw->dwt_cyccnt;
+}
+#endif
+
+//------------------------------------------------------------------------------------------------
+//---- Bracket The Drawing Of One Frame - The Hash Is Taken, And Timed, Once It Is Done.      ----
+//------------------------------------------------------------------------------------------------
+void VgaSnapshot_BeginFrame(void)
+{
+	s_uFrameStart = CycleCount();
+}
+
+void VgaSnapshot_EndFrame(VgaSnapshot* pSnapshot)
+{
+	const u32 uHashStart = CycleCount();
+
+	pSnapshot->m_uRenderCycles = uHashStart - s_uFrameStart;
+	pSnapshot->m_uCrc = VgaSnapshot_Crc();
+	pSnapshot->m_uHashCycles = CycleCount() - uHashStart;
+}
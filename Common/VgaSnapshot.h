@@ -0,0 +1,29 @@
+//------------------------------------------------------------------------------------------------
+//---- VGA Snapshot ... 2026 Dave Gaunt                                                       ----
+//------------------------------------------------------------------------------------------------
+//---- Hashes The Frame As It Is Displayed (Through The Line Table) With The DMA Sniffer, So  ----
+//---- Render Changes Can Be Checked Pixel Exact Without A Monitor. Host Builds Export PPM.   ----
+//------------------------------------------------------------------------------------------------
+#ifndef __VgaSnapshot_h_included
+#define __VgaSnapshot_h_included
+
+#include "types.h"
+#include "VgaDisplay.h"
+
+typedef struct
+{
+	u32	m_uCrc;						/* CRC-32 As zlib Has It, Over All 480 Displayed Lines */
+	u32	m_uRenderCycles;			/* VgaSnapshot_BeginFrame To VgaSnapshot_EndFrame, 0 On Host Builds */
+	u32	m_uHashCycles;
+} VgaSnapshot;
+
+void VgaSnapshot_Init(void);
+u32 VgaSnapshot_Crc(void);
+void VgaSnapshot_BeginFrame(void);
+void VgaSnapshot_EndFrame(VgaSnapshot* pSnapshot);
+
+#if VGA_HOST_BUILD
+bool VgaSnapshot_WritePpm(const char* pszPath);
+#endif
+
+#endif /* __VgaSnapshot_h_included */
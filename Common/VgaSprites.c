@@ -0,0 +1,139 @@
+//------------------------------------------------------------------------------------------------
+//---- VGA Sprites ... 2026 Dave Gaunt                                                        ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include <string.h>
+
+#include "VgaSprites.h"
+#include "VgaDisplay.h"
+
+typedef struct
+{
+	const u8*	m_pPixels;
+	int			m_iX;						/* Frame Buffer Pixels, May Hang Off Any Edge */
+	int			m_iY;
+	u32			m_uWidth;
+	u32			m_uHeight;
+	u32			m_uKey;						/* This Colour Is See Through */
+} VgaSprite;
+
+static VgaSprite s_aSprites[VGA_SPRITE_COUNT];
+static volatile u32 s_uVisibleMask = 0;
+
+//------------------------------------------------------------------------------------------------
+//---- False (And Hidden) If The Size Is Out Of Range. The Pixels Are Read Every Frame, So    ----
+//---- They Must Stay Put - And Are Best In SRAM, As The Line IRQ Reads Them.                 ----
+//------------------------------------------------------------------------------------------------
+bool VgaSprites_Set(const u32 uSprite, const u8* pPixels, const u32 uWidth, const u32 uHeight, const u8 uKey)
+{
+	if (uSprite >= VGA_SPRITE_COUNT)
+		return false;
+
+	VgaSprites_Show(uSprite, false);
+
+	if ((NULL == pPixels) || (uWidth < 1) || (uWidth > VGA_SPRITE_MAX_SIZE) || (uHeight < 1) || (uHeight > VGA_SPRITE_MAX_SIZE))
+		return false;
+
+	VgaSprite* pSprite = &s_aSprites[uSprite];
+	pSprite->m_pPixels = pPixels;
+	pSprite->m_uWidth = uWidth;
+	pSprite->m_uHeight = uHeight;
+	pSprite->m_uKey = uKey & 7;
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Takes Effect From The Next Line Sent - No Pixels Are Saved Or Restored.                ----
+//------------------------------------------------------------------------------------------------
+void VgaSprites_Move(const u32 uSprite, const int iX, const int iY)
+{
+	if (uSprite < VGA_SPRITE_COUNT)
+	{
+		s_aSprites[uSprite].m_iX = iX;
+		s_aSprites[uSprite].m_iY = iY;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Only A Sprite That Has Been Set Can Be Shown.                                          ----
+//------------------------------------------------------------------------------------------------
+void VgaSprites_Show(const u32 uSprite, const bool bVisible)
+{
+	if (uSprite >= VGA_SPRITE_COUNT)
+		return;
+
+	if (bVisible && (NULL != s_aSprites[uSprite].m_pPixels))
+		s_uVisibleMask |= 1u << uSprite;
+	else
+		s_uVisibleMask &= ~(1u << uSprite);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Checked Once A Frame - With Nothing Showing There Is No Per Line Work At All.          ----
+//------------------------------------------------------------------------------------------------
+bool __hot_path_func(VgaSprites_AnyVisible)(void)
+{
+	return 0 != s_uVisibleMask;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Bit N Set If Sprite N Is Showing And Covers uLine.                                     ----
+//------------------------------------------------------------------------------------------------
+u32 __hot_path_func(VgaSprites_GetLineMask)(const u32 uLine)
+{
+	const u32 uVisible = s_uVisibleMask;
+	u32 uMask = 0;
+
+	for (u32 uSprite=0; uSprite<VGA_SPRITE_COUNT; ++uSprite)
+	{
+		if (uVisible & (1u << uSprite))
+		{
+			const VgaSprite* pSprite = &s_aSprites[uSprite];
+
+			if ((u32)((int)uLine - pSprite->m_iY) < pSprite->m_uHeight)
+				uMask |= 1u << uSprite;
+		}
+	}
+
+	return uMask;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Copy A Frame Buffer Line To pLine With Every Sprite On It Drawn Over The Top, Higher   ----
+//---- Numbers In Front. At Most 8 x 32 Pixels, So It Fits Well Inside One Line Time.         ----
+//------------------------------------------------------------------------------------------------
+void __hot_path_func(VgaSprites_ComposeLine)(u8* pLine, const volatile u8* pSource, const u32 uLine)
+{
+	memcpy(pLine, (const u8*)pSource, VGA_BYTES_PER_LINE);
+
+	const u32 uMask = VgaSprites_GetLineMask(uLine);
+
+	for (u32 uSprite=0; uSprite<VGA_SPRITE_COUNT; ++uSprite)
+	{
+		if (0 == (uMask & (1u << uSprite)))
+			continue;
+
+		const VgaSprite* pSprite = &s_aSprites[uSprite];
+		const int iX = pSprite->m_iX;
+		const u8* pRow = &pSprite->m_pPixels[((int)uLine - pSprite->m_iY) * VGA_SPRITE_BYTES_PER_ROW(pSprite->m_uWidth)];
+
+		// Clip To The Line.
+		int iFirst = (iX < 0) ? -iX : 0;
+		int iLast = (int)pSprite->m_uWidth;
+		if ((iX + iLast) > VGA_RESOLUTION_X)
+			iLast = VGA_RESOLUTION_X - iX;
+
+		for (int iPixel=iFirst; iPixel<iLast; ++iPixel)
+		{
+			const u32 uColour = (pRow[iPixel >> 1] >> ((iPixel & 1) * 3)) & 7;
+
+			if (uColour != pSprite->m_uKey)
+			{
+				const u32 uX = (u32)(iX + iPixel);
+				const u32 uShift = (uX & 1) * 3;
+				pLine[uX >> 1] = (u8)((pLine[uX >> 1] & ~(7u << uShift)) | (uColour << uShift));
+			}
+		}
+	}
+}
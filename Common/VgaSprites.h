@@ -0,0 +1,28 @@
+//------------------------------------------------------------------------------------------------
+//---- VGA Sprites ... 2026 Dave Gaunt                                                        ----
+//------------------------------------------------------------------------------------------------
+//---- Up To 8 Overlay Sprites Composited Into Each Line As The DMA Sends It, So Cursors And  ----
+//---- Markers Never Touch aVGAScreenBuffer - Moving One Only Changes Its Descriptor.         ----
+//------------------------------------------------------------------------------------------------
+#ifndef __VgaSprites_h_included
+#define __VgaSprites_h_included
+
+#include "types.h"
+
+#define VGA_SPRITE_COUNT			(8)
+#define VGA_SPRITE_MAX_SIZE			(32)
+#define VGA_SPRITE_NONE				(VGA_SPRITE_COUNT)
+
+// Sprite Pixels Are Packed Like The Frame Buffer - Two 3 Bit Pixels A Byte, The Left One Low.
+#define VGA_SPRITE_BYTES_PER_ROW(w)	(((w) + 1) >> 1)
+
+bool VgaSprites_Set(const u32 uSprite, const u8* pPixels, const u32 uWidth, const u32 uHeight, const u8 uKey);
+void VgaSprites_Move(const u32 uSprite, const int iX, const int iY);
+void VgaSprites_Show(const u32 uSprite, const bool bVisible);
+bool VgaSprites_AnyVisible(void);
+
+// For VgaDisplay.c's Line IRQ - Lines Are Frame Buffer Lines, Not Scan Lines.
+u32 VgaSprites_GetLineMask(const u32 uLine);
+void VgaSprites_ComposeLine(u8* pLine, const volatile u8* pSource, const u32 uLine);
+
+#endif /* __VgaSprites_h_included */
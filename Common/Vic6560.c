@@ -0,0 +1,213 @@
+//------------------------------------------------------------------------------------------------
+//---- VIC 6560 / 6561 ... 2026 Dave Gaunt                                                    ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include <assert.h>
+#include <string.h>
+
+#include "Vic6560.h"
+#include "VgaDisplay.h"
+#include "VicChars.h"
+
+#define VIC_DEFAULT_ORIGIN_X_PAL	(0x0C)
+#define VIC_DEFAULT_ORIGIN_Y_PAL	(0x26)
+#define VIC_DEFAULT_ORIGIN_X_NTSC	(0x05)
+#define VIC_DEFAULT_ORIGIN_Y_NTSC	(0x19)
+
+static_assert((VIC_CANVAS_WIDTH * VIC_SCALE_X) + 4 == VGA_RESOLUTION_X, "Canvas Must Fill The Line With A 2 Pixel Border Each Side!");
+static_assert((VIC_CANVAS_HEIGHT * VIC_SCALE_Y) == VGA_RESOLUTION_Y, "Canvas Must Fill The Screen Vertically!");
+static_assert(0 == (VIC_CANVAS_WIDTH & 1), "Canvas Is Packed In Pixel Pairs!");
+
+// Approximate VIC-20 Palette As 0xRRGGBB.
+static const u32 s_aVicPaletteRGB[16] =
+{
+	0x000000,	/* Black */
+	0xFFFFFF,	/* White */
+	0xB61F21,	/* Red */
+	0x4DF0FF,	/* Cyan */
+	0xB43FFF,	/* Purple */
+	0x44E237,	/* Green */
+	0x1A34FF,	/* Blue */
+	0xDCD71B,	/* Yellow */
+	0xCA5400,	/* Orange */
+	0xE9B072,	/* Light Orange */
+	0xE79293,	/* Pink */
+	0x9AF7FD,	/* Light Cyan */
+	0xE09FFF,	/* Light Purple */
+	0x8FE493,	/* Light Green */
+	0x8290FF,	/* Light Blue */
+	0xE5DE85	/* Light Yellow */
+};
+
+// VIC Colour Index To 3 Bit RGB, Filled In By Vic6560_Init.
+static u8 s_aVicToRgb[16];
+
+//------------------------------------------------------------------------------------------------
+//---- Pick The Closest Of The 8 VGA Colours Using Squared RGB Distance.                      ----
+//------------------------------------------------------------------------------------------------
+static u8 NearestRgbColour(const u32 uRGB)
+{
+	const int iRed = (uRGB >> 16) & 0xFF;
+	const int iGreen = (uRGB >> 8) & 0xFF;
+	const int iBlue = uRGB & 0xFF;
+
+	u8 uBest = RGB_BLACK;
+	int iBestDistance = 0x7FFFFFFF;
+
+	for (u32 uColour=RGB_BLACK; uColour<=RGB_WHITE; ++uColour)
+	{
+		// Bit 0 Red, Bit 1 Green, Bit 2 Blue - Matches The Order Of The RGB Pins.
+		const int iDR = iRed - ((uColour & 1) ? 255 : 0);
+		const int iDG = iGreen - ((uColour & 2) ? 255 : 0);
+		const int iDB = iBlue - ((uColour & 4) ? 255 : 0);
+		const int iDistance = (iDR * iDR) + (iDG * iDG) + (iDB * iDB);
+
+		if (iDistance < iBestDistance)
+		{
+			iBestDistance = iDistance;
+			uBest = (u8)uColour;
+		}
+	}
+
+	return uBest;
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void Vic6560_Init(Vic6560State* pVic, const bool bPal)
+{
+	memset(pVic, 0, sizeof(Vic6560State));
+
+	pVic->m_uDefaultOriginX = bPal ? VIC_DEFAULT_ORIGIN_X_PAL : VIC_DEFAULT_ORIGIN_X_NTSC;
+	pVic->m_uDefaultOriginY = bPal ? VIC_DEFAULT_ORIGIN_Y_PAL : VIC_DEFAULT_ORIGIN_Y_NTSC;
+
+	// Power On Values The KERNAL Would Write - Screen At $1E00, Characters At $8000.
+	pVic->m_aReg[VIC_REG_ORIGIN_X] = pVic->m_uDefaultOriginX;
+	pVic->m_aReg[VIC_REG_ORIGIN_Y] = pVic->m_uDefaultOriginY;
+	pVic->m_aReg[VIC_REG_COLUMNS] = 0x96;
+	pVic->m_aReg[VIC_REG_ROWS] = 0x2E;
+	pVic->m_aReg[VIC_REG_MEMORY] = 0xF0;
+	pVic->m_aReg[VIC_REG_COLOURS] = 0x1B;
+
+	for (u32 uColour=0; uColour<16; ++uColour)
+		s_aVicToRgb[uColour] = NearestRgbColour(s_aVicPaletteRGB[uColour]);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- VIC Address Bit 13 Is Inverted Onto CPU A15, So VIC $0000 Is CPU $8000 (Char ROM)      ----
+//---- And VIC $2000 Is CPU $0000 (RAM).                                                      ----
+//------------------------------------------------------------------------------------------------
+static inline u8 ReadVicMemory(const Vic6560State* pVic, const u32 uVicAddress)
+{
+	if (uVicAddress & 0x2000)
+		return pVic->m_aRam[uVicAddress & (VIC_CPU_RAM_SIZE - 1)];
+
+	if (uVicAddress < VicChars901460_03_size)
+		return pVGACharRom[uVicAddress];
+
+	return 0xFF;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Render One Canvas Line (Two VGA Lines) As Packed Pixel Pairs Ready For The RGB DMA.    ----
+//------------------------------------------------------------------------------------------------
+void __hot_path_func(Vic6560_RenderLine)(const Vic6560State* pVic, const u32 uCanvasLine, u8* pLineOut)
+{
+	u8 aPixels[VIC_CANVAS_WIDTH];
+
+	const u8 uBorder = pVic->m_aReg[VIC_REG_COLOURS] & 7;
+	const u8 uBackground = pVic->m_aReg[VIC_REG_COLOURS] >> 4;
+	const u8 uAuxiliary = pVic->m_aReg[VIC_REG_AUX_VOLUME] >> 4;
+	const bool bInverted = (0 == (pVic->m_aReg[VIC_REG_COLOURS] & 8));
+
+	const u32 uColumns = pVic->m_aReg[VIC_REG_COLUMNS] & 0x7F;
+	const u32 uRows = (pVic->m_aReg[VIC_REG_ROWS] >> 1) & 0x3F;
+	const u32 uCharHeight = (pVic->m_aReg[VIC_REG_ROWS] & 1) ? 16 : 8;
+
+	// Origin Registers Move The Text Window In 4 Pixel / 2 Line Steps Relative To The Default.
+	const int iTextX = ((int)(pVic->m_aReg[VIC_REG_ORIGIN_X] & 0x7F) - (int)pVic->m_uDefaultOriginX) * 4 + ((VIC_CANVAS_WIDTH - (22 * 8)) >> 1);
+	const int iTextY = ((int)pVic->m_aReg[VIC_REG_ORIGIN_Y] - (int)pVic->m_uDefaultOriginY) * 2 + ((VIC_CANVAS_HEIGHT - (23 * 8)) >> 1);
+	const int iTextLine = (int)uCanvasLine - iTextY;
+
+	memset(aPixels, uBorder, sizeof(aPixels));
+
+	if ((iTextLine >= 0) && ((u32)iTextLine < (uRows * uCharHeight)))
+	{
+		const u32 uRow = (u32)iTextLine / uCharHeight;
+		const u32 uCharLine = (u32)iTextLine % uCharHeight;
+		const u32 uScreenBase = ((pVic->m_aReg[VIC_REG_MEMORY] & 0xF0) << 6) | ((pVic->m_aReg[VIC_REG_COLUMNS] & 0x80) << 2);
+		const u32 uCharBase = (pVic->m_aReg[VIC_REG_MEMORY] & 0x0F) << 10;
+		const u32 uColourBase = (pVic->m_aReg[VIC_REG_COLUMNS] & 0x80) << 2;
+
+		const u8 aMultiColour[4] = {uBackground, uBorder, 0, uAuxiliary};
+
+		int iX = iTextX;
+
+		for (u32 uColumn=0; uColumn<uColumns; ++uColumn, iX+=8)
+		{
+			if (iX >= VIC_CANVAS_WIDTH)
+				break;
+
+			const u32 uCell = (uRow * uColumns) + uColumn;
+			const u8 uCode = ReadVicMemory(pVic, (uScreenBase + uCell) & 0x3FFF);
+			const u8 uColour = pVic->m_aColourRam[(uColourBase + uCell) & (VIC_COLOUR_RAM_SIZE - 1)];
+			u32 uBits = ReadVicMemory(pVic, (uCharBase + (uCode * uCharHeight) + uCharLine) & 0x3FFF);
+
+			u8 aCell[8];
+
+			if (uColour & 8)
+			{
+				// Multicolour - Each Bit Pair Is One Double Width Pixel.
+				u8 aColours[4];
+				memcpy(aColours, aMultiColour, sizeof(aColours));
+				aColours[2] = uColour & 7;
+
+				for (u32 uPair=0; uPair<4; ++uPair)
+				{
+					const u8 uPixel = aColours[(uBits >> 6) & 3];
+					aCell[uPair << 1] = uPixel;
+					aCell[(uPair << 1) + 1] = uPixel;
+					uBits <<= 2;
+				}
+			}
+			else
+			{
+				if (bInverted)
+					uBits = ~uBits;
+
+				for (u32 uPixel=0; uPixel<8; ++uPixel)
+				{
+					aCell[uPixel] = (uBits & 0x80) ? (uColour & 7) : uBackground;
+					uBits <<= 1;
+				}
+			}
+
+			// Clip The Cell Against The Canvas Edges.
+			for (u32 uPixel=0; uPixel<8; ++uPixel)
+			{
+				const int iPixelX = iX + (int)uPixel;
+
+				if ((iPixelX >= 0) && (iPixelX < VIC_CANVAS_WIDTH))
+					aPixels[iPixelX] = aCell[uPixel];
+			}
+		}
+	}
+
+	// Scale 3x Horizontally - Two VIC Pixels Become Six VGA Pixels In Three Bytes.
+	const u8 uBorderRgb = s_aVicToRgb[uBorder];
+	*pLineOut++ = (uBorderRgb << 3) | uBorderRgb;
+
+	for (u32 uPixel=0; uPixel<VIC_CANVAS_WIDTH; uPixel+=2)
+	{
+		const u8 uLeft = s_aVicToRgb[aPixels[uPixel]];
+		const u8 uRight = s_aVicToRgb[aPixels[uPixel + 1]];
+
+		*pLineOut++ = (uLeft << 3) | uLeft;
+		*pLineOut++ = (uRight << 3) | uLeft;
+		*pLineOut++ = (uRight << 3) | uRight;
+	}
+
+	*pLineOut = (uBorderRgb << 3) | uBorderRgb;
+}
@@ -0,0 +1,67 @@
+//------------------------------------------------------------------------------------------------
+//---- VIC 6560 / 6561 ... 2026 Dave Gaunt                                                    ----
+//------------------------------------------------------------------------------------------------
+//---- Emulated VIC-I Video Chip, Fed By Snooped Bus Writes And Rendered One Line At A Time.  ----
+//------------------------------------------------------------------------------------------------
+#ifndef __Vic6560_h_included
+#define __Vic6560_h_included
+
+#include "types.h"
+
+// The VIC Picture (Text Window Plus Border) Is Scaled 3 x 2 Into 640 x 480.
+#define VIC_CANVAS_WIDTH		(212)
+#define VIC_CANVAS_HEIGHT		(240)
+#define VIC_SCALE_X				(3)
+#define VIC_SCALE_Y				(2)
+
+enum vic_register_names
+{
+	VIC_REG_ORIGIN_X = 0,			/* Bit 7 Interlace, Bits 0-6 Horizontal Origin */
+	VIC_REG_ORIGIN_Y,				/* Vertical Origin */
+	VIC_REG_COLUMNS,				/* Bit 7 Screen Address Bit 9, Bits 0-6 Columns */
+	VIC_REG_ROWS,					/* Bit 7 Raster Bit 0, Bits 1-6 Rows, Bit 0 8x16 Characters */
+	VIC_REG_RASTER,
+	VIC_REG_MEMORY,					/* Bits 4-7 Screen Address, Bits 0-3 Character Address */
+	VIC_REG_LIGHTPEN_X,
+	VIC_REG_LIGHTPEN_Y,
+	VIC_REG_PADDLE_X,
+	VIC_REG_PADDLE_Y,
+	VIC_REG_OSC1,
+	VIC_REG_OSC2,
+	VIC_REG_OSC3,
+	VIC_REG_NOISE,
+	VIC_REG_AUX_VOLUME,				/* Bits 4-7 Auxiliary Colour, Bits 0-3 Volume */
+	VIC_REG_COLOURS					/* Bits 4-7 Background, Bit 3 Normal / Inverted, Bits 0-2 Border */
+};
+
+#define VIC_CPU_REGISTERS		(0x9000)
+#define VIC_CPU_COLOUR_RAM		(0x9400)
+#define VIC_CPU_RAM_SIZE		(0x2000)		/* $0000-$1FFF, Includes The 3K Expansion Block */
+#define VIC_COLOUR_RAM_SIZE		(0x400)
+
+typedef struct
+{
+	u8	m_aReg[16];
+	u8	m_aColourRam[VIC_COLOUR_RAM_SIZE];
+	u8	m_aRam[VIC_CPU_RAM_SIZE];
+	u8	m_uDefaultOriginX;
+	u8	m_uDefaultOriginY;
+} Vic6560State;
+
+void Vic6560_Init(Vic6560State* pVic, const bool bPal);
+void Vic6560_RenderLine(const Vic6560State* pVic, const u32 uCanvasLine, u8* pLineOut);
+
+//------------------------------------------------------------------------------------------------
+//---- Called From The Bus Loop For Every CPU Write - Keep It Short!                          ----
+//------------------------------------------------------------------------------------------------
+static inline void Vic6560_SnoopWrite(Vic6560State* pVic, const u32 uAddress, const u8 uData)
+{
+	if (uAddress < VIC_CPU_RAM_SIZE)
+		pVic->m_aRam[uAddress] = uData;
+	else if ((uAddress & 0xFC00) == VIC_CPU_COLOUR_RAM)
+		pVic->m_aColourRam[uAddress & (VIC_COLOUR_RAM_SIZE - 1)] = uData & 0xF;
+	else if ((uAddress & 0xFFF0) == VIC_CPU_REGISTERS)
+		pVic->m_aReg[uAddress & 0xF] = uData;
+}
+
+#endif /* __Vic6560_h_included */
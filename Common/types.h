@@ -14,32 +14,16 @@ typedef unsigned int    u32;
 
 #define __not_in_flash_func(func_name)   __not_in_flash(__STRING(func_name)) func_name
 
-//------------------------------------------------------------------------------------------------
-//----  nop = 1,000,000,000 / 125,000,000 = 8 ns       RP2040                                 ----
-//----  minumum write pulse width = 40 ns ... = 5 nop's                                       ----
-//----                                                                                        ----
-//----  nop = 1,000,000,000 / 150,000,000 = 6 ns       RP2350                                 ----
-//----  minumum write pulse width = 40 ns ... = 7 nop's                                       ----
-//------------------------------------------------------------------------------------------------
-static inline void delay_40ns(void)
-{
-    asm volatile("nop \n nop \n nop \n nop \n nop \n nop \n nop");
-    asm volatile("nop \n nop");
-}
+// Set By The HOT_PATH_IN_RAM CMake Option - Bus And Render Path Functions Run From SRAM, Not XIP.
+#ifndef HOT_PATH_IN_RAM
+#define HOT_PATH_IN_RAM		(0)
+#endif
 
-//------------------------------------------------------------------------------------------------
-//----  nop = 1,000,000,000 / 125,000,000 = 8 ns       RP2040                                 ----
-//----  minumum write pulse width = 120 ns ... = 15 nop's                                     ----
-//----                                                                                        ----
-//----  nop = 1,000,000,000 / 150,000,000 = 6 ns       RP2350                                 ----
-//----  minumum write pulse width = 120 ns ... = 20 nop's                                     ----
-//------------------------------------------------------------------------------------------------
-static inline void delay_120ns(void)
-{
-    asm volatile("nop \n nop \n nop \n nop \n nop");
-    asm volatile("nop \n nop \n nop \n nop \n nop");
-    asm volatile("nop \n nop \n nop \n nop \n nop");
-    asm volatile("nop \n nop \n nop \n nop \n nop");
-}
+#if HOT_PATH_IN_RAM
+#include "pico.h"
+#define __hot_path_func(func_name)       __not_in_flash_func(func_name)
+#else
+#define __hot_path_func(func_name)       func_name
+#endif
 
 #endif /* __types_h_included */
@@ -0,0 +1,352 @@
+#!/usr/bin/env python3
+#------------------------------------------------------------------------------------------------
+#---- RP2350 Logic V6 Host Decoder ... 2026 Dave Gaunt                                       ----
+#------------------------------------------------------------------------------------------------
+#---- Starts A Capture Over USB CDC (Or Reads A Saved One), Unpacks The Blocks And Writes A  ----
+#---- VCD File. --check-counter Verifies A SIM Capture End To End With Nothing Connected.    ----
+#---- --bench Packs A Saved Capture With The Host Built LogicPack.c, Checks It And Times It. ----
+#---- --trigger Arms The PIO Trigger Stages, See trigger_sim.py For How They Behave.          ----
+#------------------------------------------------------------------------------------------------
+import argparse
+import os
+import struct
+import sys
+import time
+
+CAPTURE_MAGIC = 0x3643474C      # "LGC6"
+BLOCK_MAGIC = 0x364B4C42        # "BLK6"
+PROTOCOL_VERSION = 3
+
+FLAG_SIMULATED = 1 << 0
+FLAG_STREAMING = 1 << 1
+FLAG_RLE = 1 << 2
+FLAG_TRIGGERED = 1 << 3
+
+TRIGGER_NOT_FOUND = 0xFFFFFFFF
+
+RLE_REPEAT = 1 << 31
+
+CAPTURE_CHANNELS = 24
+SAMPLE_BITS = 27
+
+CAPTURE_HEADER = struct.Struct("<IHHIII")
+BLOCK_HEADER = struct.Struct("<IIIII")
+
+
+def channel_bit(channel):
+    """Channels 0 - 20 are GPIO 2 - 22, channels 21 - 23 are GPIO 26 - 28."""
+    return channel if channel < 21 else channel + 3
+
+
+CHANNEL_MASK = sum(1 << channel_bit(channel) for channel in range(CAPTURE_CHANNELS))
+
+
+class Capture:
+    def __init__(self, flags, sample_rate, samples, trigger):
+        self.flags = flags
+        self.sample_rate = sample_rate
+        self.samples_wanted = samples
+        self.trigger = None if trigger == TRIGGER_NOT_FOUND else trigger
+        self.blocks = []                # (sequence, overruns, [samples])
+
+    @property
+    def simulated(self):
+        return bool(self.flags & FLAG_SIMULATED)
+
+    @property
+    def streaming(self):
+        return bool(self.flags & FLAG_STREAMING)
+
+    @property
+    def packed(self):
+        return bool(self.flags & FLAG_RLE)
+
+    @property
+    def triggered(self):
+        return bool(self.flags & FLAG_TRIGGERED)
+
+    def samples(self):
+        for _, _, block in self.blocks:
+            yield from block
+
+
+def rle_pack(samples):
+    """Same packing as Rle_PackBlock() in LogicPack.c."""
+    words = [samples[0] & CHANNEL_MASK]
+    previous = words[0]
+    run = 0
+
+    for sample in samples[1:]:
+        sample &= CHANNEL_MASK
+        if sample == previous:
+            run += 1
+            continue
+        if run:
+            words.append(RLE_REPEAT | run)
+            run = 0
+        words.append(sample)
+        previous = sample
+
+    if run:
+        words.append(RLE_REPEAT | run)
+    return words
+
+
+def rle_unpack(words, count):
+    samples = []
+    previous = 0
+
+    for word in words:
+        if word & RLE_REPEAT:
+            samples.extend([previous] * (word & ~RLE_REPEAT))
+        else:
+            samples.append(word)
+            previous = word
+
+    if len(samples) != count:
+        raise ValueError("packed block unpacks to %d samples, header says %d" % (len(samples), count))
+    return samples
+
+
+def read_exact(stream, length):
+    data = b""
+    while len(data) < length:
+        chunk = stream.read(length - len(data))
+        if not chunk:
+            raise EOFError("capture ended after %d of %d bytes" % (len(data), length))
+        data += chunk
+    return data
+
+
+def read_capture(stream):
+    magic, version, flags, sample_rate, samples, trigger = CAPTURE_HEADER.unpack(read_exact(stream, CAPTURE_HEADER.size))
+
+    if magic != CAPTURE_MAGIC:
+        raise ValueError("not a capture, magic %08X" % magic)
+    if version != PROTOCOL_VERSION:
+        raise ValueError("protocol version %d, expected %d" % (version, PROTOCOL_VERSION))
+
+    capture = Capture(flags, sample_rate, samples, trigger)
+    capture.words = 0
+
+    while True:
+        magic, sequence, count, words, overruns = BLOCK_HEADER.unpack(read_exact(stream, BLOCK_HEADER.size))
+
+        if magic != BLOCK_MAGIC:
+            raise ValueError("lost block framing at block %d" % len(capture.blocks))
+        if count == 0:
+            return capture
+
+        data = list(struct.unpack("<%dI" % words, read_exact(stream, words * 4)))
+        capture.words += words
+
+        if capture.packed:
+            data = rle_unpack(data, count)
+
+        capture.blocks.append((sequence, overruns, data))
+
+
+def bench(capture, compiler):
+    """Packs every block of a saved capture with Source/LogicPack.c built for the host, checks it
+    matches rle_pack and round trips, and reports the ratio and host speed - e.g. on a 6502 bus
+    trace saved with --raw. logic_pack_test.py does the same on generated 6502 traces."""
+    import ctypes
+    import tempfile
+    import logic_pack_test
+
+    samples_in = words_out = 0
+    pack_time = unpack_time = 0.0
+
+    with tempfile.TemporaryDirectory() as work:
+        lib = logic_pack_test.build(work, compiler)
+
+        for sequence, _, block in capture.blocks:
+            raw = (ctypes.c_uint32 * len(block))(*block)
+            out = (ctypes.c_uint32 * len(block))()
+
+            start = time.perf_counter()
+            count = lib.Rle_PackBlock(raw, len(block), out)
+            pack_time += time.perf_counter() - start
+            words = list(out[:count])
+
+            if words != rle_pack(block):
+                raise ValueError("block %d packs differently to rle_pack" % sequence)
+
+            start = time.perf_counter()
+            unpacked = rle_unpack(words, len(block))
+            unpack_time += time.perf_counter() - start
+
+            if unpacked != [sample & CHANNEL_MASK for sample in block]:
+                raise ValueError("block %d does not round trip" % sequence)
+
+            samples_in += len(block)
+            words_out += len(words)
+
+    if not samples_in:
+        print("bench: no samples")
+        return
+
+    print("bench: %d samples -> %d words, %.2f:1, %.1f%% of raw" % (
+        samples_in, words_out, samples_in / words_out, 100.0 * words_out / samples_in))
+    print("bench: host C pack %.1f Msamples/s, Python unpack %.2f Msamples/s" % (
+        samples_in / pack_time / 1e6, samples_in / unpack_time / 1e6))
+
+
+def check_counter(capture):
+    """SIM captures are a 27 bit down counter - every sample must be one less than the last,
+    except across blocks the device reports as dropped."""
+    mask = (1 << SAMPLE_BITS) - 1
+    errors = 0
+    previous = None
+    previous_sequence = None
+
+    for sequence, overruns, block in capture.blocks:
+        for index, sample in enumerate(block):
+            if previous is not None:
+                expected = (previous - 1) & mask
+                skipped = (index == 0) and (sequence != previous_sequence + 1)
+
+                if not skipped and sample != expected:
+                    errors += 1
+                    if errors <= 10:
+                        print("block %d sample %d: %07X, expected %07X" % (sequence, index, sample, expected))
+            previous = sample
+        previous_sequence = sequence
+
+    return errors
+
+
+def write_vcd(capture, path):
+    identifiers = [chr(33 + channel) for channel in range(CAPTURE_CHANNELS)]
+    timescale_ns = max(1, round(1e9 / capture.sample_rate)) if capture.sample_rate else 1
+
+    with open(path, "w") as vcd:
+        vcd.write("$timescale %dns $end\n" % timescale_ns)
+        if capture.trigger is not None:
+            vcd.write("$comment trigger at #%d $end\n" % capture.trigger)
+        vcd.write("$scope module logic $end\n")
+        for channel in range(CAPTURE_CHANNELS):
+            vcd.write("$var wire 1 %s CH%d $end\n" % (identifiers[channel], channel + 1))
+        vcd.write("$upscope $end\n$enddefinitions $end\n")
+
+        previous = None
+        for time, sample in enumerate(capture.samples()):
+            changed = (sample ^ previous) if previous is not None else ~0
+            if changed & CHANNEL_MASK:
+                vcd.write("#%d\n" % time)
+                for channel in range(CAPTURE_CHANNELS):
+                    bit = channel_bit(channel)
+                    if (changed >> bit) & 1:
+                        vcd.write("%d%s\n" % ((sample >> bit) & 1, identifiers[channel]))
+            previous = sample
+
+
+def trigger_command(rate, pre, post, stages):
+    """Stages are <mask>:<pattern>[:<count>] with channel 1 = bit 0, e.g. 1:0 1:1:1 is a
+    rising edge on channel 1 - low, then high within 1 sample."""
+    for stage in stages:
+        fields = stage.split(":")
+        if len(fields) not in (2, 3):
+            raise ValueError("trigger stage %r is not mask:pattern[:count]" % stage)
+        for field in fields[:2]:
+            int(field, 16)      # ValueError here rather than the board quietly ignoring it
+    return "T %d %d %d %s" % (rate, pre, post, " ".join(stages))
+
+
+def open_device(port, command, timeout=5):
+    import serial       # pyserial, only needed when talking to the board
+
+    device = serial.Serial(port, timeout=timeout)
+    device.reset_input_buffer()
+    device.write((command + "\n").encode("ascii"))
+    return device
+
+
+def main():
+    parser = argparse.ArgumentParser(description="RP2350 Logic V6 capture decoder")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--port", help="USB CDC device, e.g. /dev/ttyACM0")
+    source.add_argument("--file", help="decode a capture saved with --raw")
+    parser.add_argument("--rate", type=int, default=1000000, help="sample rate in Hz")
+    parser.add_argument("--samples", type=int, default=65536, help="buffered capture depth")
+    parser.add_argument("--stream", type=float, metavar="SECONDS", help="stream for this long instead of a buffered capture")
+    parser.add_argument("--sim", action="store_true", help="capture the simulated counter instead of the pins")
+    parser.add_argument("--rle", action="store_true", help="run length pack on the board, buffered depth is no longer capped")
+    parser.add_argument("--bench", action="store_true", help="measure run length packing of the capture")
+    parser.add_argument("--cc", default=os.environ.get("CC", "cc"), help="host compiler for --bench")
+    parser.add_argument("--trigger", nargs="+", metavar="STAGE", help="up to 3 trigger stages, mask:pattern[:count] in hex channel bits")
+    parser.add_argument("--pre", type=int, default=1000, help="samples kept before the trigger")
+    parser.add_argument("--post", type=int, default=9000, help="samples kept from the trigger on")
+    parser.add_argument("--raw", help="save the raw capture bytes")
+    parser.add_argument("--vcd", help="write a VCD file")
+    parser.add_argument("--check-counter", action="store_true", help="verify a SIM capture")
+    args = parser.parse_args()
+
+    if args.file:
+        stream = open(args.file, "rb")
+    else:
+        if args.trigger:
+            command = trigger_command(args.rate, args.pre, args.post, args.trigger)
+        else:
+            command = ("S %d" % args.rate) if args.stream else ("B %d %d" % (args.rate, args.samples))
+            if args.sim:
+                command += " SIM"
+            if args.rle:
+                command += " RLE"
+
+        # Nothing comes back from a triggered capture until it fires.
+        device = open_device(args.port, command, None if args.trigger else 5)
+        stream = device
+
+        if args.stream:
+            import threading
+            threading.Timer(args.stream, lambda: device.write(b"X\n")).start()
+
+    if args.raw:
+        class Tee:
+            def __init__(self, source, sink):
+                self.source, self.sink = source, sink
+
+            def read(self, length):
+                data = self.source.read(length)
+                self.sink.write(data)
+                return data
+
+        stream = Tee(stream, open(args.raw, "wb"))
+
+    start = time.perf_counter()
+    capture = read_capture(stream)
+    elapsed = time.perf_counter() - start
+    total = sum(len(block) for _, _, block in capture.blocks)
+    overruns = capture.blocks[-1][1] if capture.blocks else 0
+
+    print("%s%s%s capture, %d Hz, %d samples in %d blocks, %d blocks dropped" % (
+        "simulated " if capture.simulated else "",
+        "packed " if capture.packed else "",
+        "streaming" if capture.streaming else "buffered",
+        capture.sample_rate, total, len(capture.blocks), overruns))
+
+    if capture.triggered:
+        print("trigger at sample %d" % capture.trigger if capture.trigger is not None else "stopped before the trigger")
+
+    if capture.packed and capture.words:
+        print("packed %.2f:1 over USB" % (total / capture.words))
+    if args.port and elapsed > 0:
+        print("sustained %.0f samples/s, %.0f bytes/s" % (total / elapsed, capture.words * 4 / elapsed))
+
+    if args.bench:
+        bench(capture, args.cc)
+
+    if args.vcd:
+        write_vcd(capture, args.vcd)
+
+    if args.check_counter:
+        errors = check_counter(capture)
+        print("counter check: %s (%d bad samples)" % ("PASS" if errors == 0 else "FAIL", errors))
+        return 1 if errors else 0
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
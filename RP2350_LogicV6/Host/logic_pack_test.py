@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+#------------------------------------------------------------------------------------------------
+#---- RP2350 Logic V6 Pack Test ... 2026 Dave Gaunt                                          ----
+#------------------------------------------------------------------------------------------------
+#---- Builds Source/LogicPack.c For The Host And Checks Rle_PackBlock Word For Word Against  ----
+#---- rle_pack, And Back Through rle_unpack, On Edge Cases And On 6502 Bus Traces Sampled At ----
+#---- Several Rates, Then Reports The C Packer's Ratio And Host Samples/s For Each Trace.    ----
+#------------------------------------------------------------------------------------------------
+import argparse
+import ctypes
+import os
+import random
+import subprocess
+import sys
+import tempfile
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+COMMON = os.path.join(HERE, "..", "..", "Common")
+SOURCE = os.path.join(HERE, "..", "Source")
+sys.path.insert(0, os.path.join(HERE, "..", "..", "VIC_6560", "Host"))
+
+from logic_capture import CHANNEL_MASK, RLE_REPEAT, channel_bit, rle_pack, rle_unpack
+from bus6502_test import CYCLE_READ, Cpu, build_memory
+
+BLOCK_SAMPLES = 4096            # CAPTURE_BLOCK_SAMPLES
+BUS_HZ = 1000000                # 1MHz 6502, phase 2 high for the second half of each cycle
+ADDRESS_VALID_NS = 100          # Address settles this long after phase 1 starts
+READ_VALID_NS = 750             # Memory drives the data bus this far in
+WRITE_VALID_NS = 600            # The 6502 drives it a little earlier on writes
+TRACE_RATES = [4000000, 10000000, 25000000, 50000000]
+
+
+def build(work, compiler):
+    library = os.path.join(work, "logic_pack.so")
+    subprocess.check_call([compiler, "-std=gnu11", "-O2", "-shared", "-fPIC", "-Wall", "-Werror", "-DLOGIC_PACK_HOST_BUILD=1",
+                           "-I" + COMMON, "-I" + SOURCE, os.path.join(SOURCE, "LogicPack.c"), "-o", library])
+
+    lib = ctypes.CDLL(library)
+    lib.Rle_PackBlock.restype = ctypes.c_uint32
+    lib.Rle_PackBlock.argtypes = [ctypes.POINTER(ctypes.c_uint32), ctypes.c_uint32, ctypes.POINTER(ctypes.c_uint32)]
+    return lib
+
+
+def pack(lib, samples):
+    raw = (ctypes.c_uint32 * len(samples))(*samples)
+    out = (ctypes.c_uint32 * len(samples))()
+    words = lib.Rle_PackBlock(raw, len(samples), out)
+    return list(out[:words])
+
+
+def bus_sample(address, data):
+    """Channels 1 - 16 on A0 - A15, channels 17 - 24 on D0 - D7."""
+    sample = 0
+    for bit in range(16):
+        if (address >> bit) & 1:
+            sample |= 1 << channel_bit(bit)
+    for bit in range(8):
+        if (data >> bit) & 1:
+            sample |= 1 << channel_bit(16 + bit)
+    return sample
+
+
+def bus_trace(seed, rate, samples):
+    """What the pins see of a 6502 running the bus6502_test programs - the address moves early
+    in phase 1, the data bus holds its last value until it is driven again in phase 2. Unused
+    sample bits are noise, which the packer has to mask off."""
+    rng = random.Random(seed)
+    cpu = Cpu(build_memory())
+    cpu.reset(rng.randint(1, 20))
+
+    cycles_needed = samples * BUS_HZ // rate + 2
+    while len(cpu.cycles) < cycles_needed:
+        cpu.step(irq=rng.random() < 0.01, nmi=rng.random() < 0.001)
+
+    trace = []
+    address = data = 0
+    for index in range(samples):
+        time_ns = index * 1000000000 // rate
+        cycle = cpu.cycles[time_ns // 1000]
+        phase_ns = time_ns % 1000
+
+        if phase_ns >= ADDRESS_VALID_NS:
+            address = cycle & 0xFFFF
+        if phase_ns >= (READ_VALID_NS if cycle & CYCLE_READ else WRITE_VALID_NS):
+            data = (cycle >> 16) & 0xFF
+        trace.append(bus_sample(address, data) | (rng.getrandbits(32) & ~CHANNEL_MASK))
+    return trace
+
+
+class Checker:
+    def __init__(self):
+        self.failures = 0
+        self.checks = 0
+
+    def check(self, condition, what):
+        self.checks += 1
+        if not condition:
+            self.failures += 1
+            print("FAIL: %s" % what)
+
+
+def check_block(lib, checker, samples, what):
+    words = pack(lib, samples)
+    checker.check(words == rle_pack(samples), "%s: C and Python packers differ" % what)
+    checker.check(len(words) <= len(samples), "%s: %d words from %d samples" % (what, len(words), len(samples)))
+
+    # A value word with bit 31 set would unpack as a run of up to 2G samples.
+    if any(word & ~CHANNEL_MASK for word in words[:1]):
+        checker.check(False, "%s: first word is not a sample" % what)
+        return
+    if sum((word & ~RLE_REPEAT) if word & RLE_REPEAT else 1 for word in words) != len(samples):
+        checker.check(False, "%s: packed block is not %d samples long" % (what, len(samples)))
+        return
+    try:
+        unpacked = rle_unpack(words, len(samples))
+    except ValueError as error:
+        checker.check(False, "%s: %s" % (what, error))
+        return
+    checker.check(unpacked == [sample & CHANNEL_MASK for sample in samples], "%s: does not round trip" % what)
+
+
+def test_edges(lib, checker, rng):
+    check_block(lib, checker, [0x12345], "single sample")
+    check_block(lib, checker, [0] * BLOCK_SAMPLES, "all zero")
+    check_block(lib, checker, [CHANNEL_MASK] * BLOCK_SAMPLES, "all ones")
+    check_block(lib, checker, [0, 1] * (BLOCK_SAMPLES // 2), "every sample changes")
+    check_block(lib, checker, [0, 0, 1] * (BLOCK_SAMPLES // 3), "runs of 2")
+    check_block(lib, checker, [1 << 21, 1 << 22, 1 << 23, 1 << 31] * 4 + [5], "only unused bits change")
+    check_block(lib, checker, [0xFFFFFFFF] + [CHANNEL_MASK] * 100, "repeat flag bit set in the samples")
+
+    checker.check(pack(lib, [0, 1] * (BLOCK_SAMPLES // 2)) == list(range(2)) * (BLOCK_SAMPLES // 2),
+                  "an incompressible block is the raw samples")
+    checker.check(pack(lib, [7] * BLOCK_SAMPLES) == [7, (1 << 31) | (BLOCK_SAMPLES - 1)], "a flat block is 2 words")
+
+    for run in range(200):
+        length = rng.randint(1, BLOCK_SAMPLES)
+        sample = rng.getrandbits(32)
+        block = []
+        while len(block) < length:
+            if rng.random() < 0.3:
+                sample = rng.getrandbits(32)
+            block.extend([sample] * min(rng.choice([1, 1, 2, 3, 50, 1000]), length - len(block)))
+        check_block(lib, checker, block, "random block %d" % run)
+
+
+def bench_traces(lib, checker, seed, blocks):
+    for rate in TRACE_RATES:
+        trace = bus_trace(seed, rate, blocks * BLOCK_SAMPLES)
+        raw = [(ctypes.c_uint32 * BLOCK_SAMPLES)(*trace[i:i + BLOCK_SAMPLES]) for i in range(0, len(trace), BLOCK_SAMPLES)]
+        out = (ctypes.c_uint32 * BLOCK_SAMPLES)()
+
+        for index, block in enumerate(raw):
+            check_block(lib, checker, list(block), "6502 at %d Hz block %d" % (rate, index))
+
+        # Best of 3, ctypes call overhead is one call per 4096 samples.
+        best = None
+        for _ in range(3):
+            words = 0
+            start = time.perf_counter()
+            for block in raw:
+                words += lib.Rle_PackBlock(block, BLOCK_SAMPLES, out)
+            elapsed = time.perf_counter() - start
+            best = elapsed if best is None else min(best, elapsed)
+
+        print("6502 bus at %2d MHz sampling: %d samples -> %d words, %.2f:1, C pack %.0f Msamples/s on the host" % (
+            rate // 1000000, len(trace), words, len(trace) / words, len(trace) / best / 1e6))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Check Rle_PackBlock against the Python packer and bench it on 6502 bus traces")
+    parser.add_argument("--cc", default=os.environ.get("CC", "cc"))
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--blocks", type=int, default=16, help="4096 sample blocks per trace")
+    args = parser.parse_args()
+
+    checker = Checker()
+    rng = random.Random(args.seed)
+
+    with tempfile.TemporaryDirectory() as work:
+        lib = build(work, args.cc)
+        test_edges(lib, checker, rng)
+        bench_traces(lib, checker, args.seed, args.blocks)
+
+    print("%d checks, %d failed: %s" % (checker.checks, checker.failures, "PASS" if checker.failures == 0 else "FAIL"))
+    return 1 if checker.failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,274 @@
+#!/usr/bin/env python3
+#------------------------------------------------------------------------------------------------
+#---- RP2350 Logic V6 Trigger Simulation ... 2026 Dave Gaunt                                 ----
+#------------------------------------------------------------------------------------------------
+#---- Runs The Real Source/trigger.pio Programs Cycle By Cycle Against Random Stimulus, With  ----
+#---- The Capture State Machine Recording The Marker Pin, Then Checks The Trigger Sample The ----
+#---- Firmware Would Report Against A Plain Python Model Of What The Stages Are Meant To Do.  ----
+#------------------------------------------------------------------------------------------------
+import argparse
+import os
+import random
+import re
+import sys
+
+CYCLES_PER_SAMPLE = 10          # TRIGGER_CYCLES_PER_SAMPLE
+MARKER_BIT = 21                 # GPIO 23 in the samples
+MARKER_LATENCY = 2              # Output to input synchroniser, in PIO cycles at full speed
+MARKER_DELAY = 1                # TRIGGER_MARKER_DELAY, samples from the trigger to the marker
+FIRST_SM = 1                    # TRIGGER_FIRST_SM, the capture itself is SM 0
+ARM_FLAG = 1
+
+PIO_SOURCE = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "Source", "trigger.pio")
+
+
+def load_programs(path):
+    """Just enough of pioasm for trigger.pio."""
+    programs = {}
+    program = None
+
+    for line in open(path):
+        line = line.split(";")[0].strip()
+        if not line or line.startswith("%"):
+            if line.startswith("%"):
+                break
+            continue
+
+        if line.startswith(".program"):
+            program = {"code": [], "labels": {}, "wrap_target": 0, "wrap": None}
+            programs[line.split()[1]] = program
+        elif line == ".wrap_target":
+            program["wrap_target"] = len(program["code"])
+        elif line == ".wrap":
+            program["wrap"] = len(program["code"]) - 1
+        elif line.endswith(":"):
+            program["labels"][line[:-1].replace("public ", "")] = len(program["code"])
+        else:
+            delay = 0
+            match = re.search(r"\[(\d+)\]$", line)
+            if match:
+                delay = int(match.group(1))
+                line = line[:match.start()].strip()
+            program["code"].append((line, delay))
+
+    for program in programs.values():
+        if program["wrap"] is None:
+            program["wrap"] = len(program["code"]) - 1
+    return programs
+
+
+class StateMachine:
+    def __init__(self, number, program, pattern, reload, base, count, marker):
+        self.number = number
+        self.program = program
+        self.x = 0
+        self.y = pattern
+        self.osr = reload
+        self.isr = 0
+        self.pc = 0
+        self.delay = 0
+        self.base = base
+        self.mask = (1 << count) - 1
+        self.marker = marker
+
+    def step(self, pins, flags, set_flags, set_marker):
+        if self.delay:
+            self.delay -= 1
+            return
+
+        text, delay = self.program["code"][self.pc]
+        op = text.split()[0]
+        args = text[len(op):].replace(" ", "").split(",")
+        next_pc = self.pc + 1 if self.pc != self.program["wrap"] else self.program["wrap_target"]
+        labels = self.program["labels"]
+
+        def flag_index(arg, relative):
+            index = int(arg)
+            return ((index + self.number) & 3) if relative else index
+
+        if op == "nop":
+            pass
+        elif op == "wait":
+            flag = flag_index(text.split()[3], text.endswith("rel"))
+            if not flags[flag]:
+                return                  # Stalls, no delay
+            flags[flag] = False
+        elif op == "mov":
+            source = {"osr": self.osr, "isr": self.isr, "x": self.x, "pins": (pins >> self.base) & self.mask}[args[1]]
+            setattr(self, args[0], source)
+        elif op == "jmp":
+            args = text.split()[1:]
+            if len(args) == 1:
+                next_pc = labels[args[0]]
+            elif args[0] == "x!=y":
+                if self.x != self.y:
+                    next_pc = labels[args[1]]
+            elif args[0] == "x--":
+                taken = self.x != 0
+                self.x = (self.x - 1) & 0xFFFFFFFF
+                if taken:
+                    next_pc = labels[args[1]]
+            else:
+                raise ValueError("unsupported: " + text)
+        elif op == "set":
+            if self.marker:
+                set_marker()
+        elif op == "irq":
+            parts = text.split()
+            set_flags.append(flag_index(parts[2], text.endswith("rel")))
+        else:
+            raise ValueError("unsupported: " + text)
+
+        self.pc = next_pc
+        self.delay = delay
+
+
+def window(mask):
+    base = (mask & -mask).bit_length() - 1
+    count = mask.bit_length() - base
+    return base, count
+
+
+def simulate(programs, stages, stimulus, latency):
+    """stages = [(mask, pattern, n)], n = count for the first stage, window for the rest.
+    Returns the captured samples - the stimulus with the marker bit the PIO drove."""
+    machines = []
+    for index, (mask, pattern, n) in enumerate(stages):
+        base, count = window(mask)
+        program = programs["trigger_count" if index == 0 else "trigger_window"]
+        reload = (n - 1) & 0xFFFFFFFF if n else 0xFFFFFFFF
+        machines.append(StateMachine(FIRST_SM + index, program, (pattern >> base) & ((1 << count) - 1),
+                                     reload, base, count, index == len(stages) - 1))
+
+    # The CPU sets the arm flag before enabling the state machines in sync with the capture.
+    flags = [False] * 4
+    flags[ARM_FLAG] = True
+    marker_at = [None]
+    captured = []
+
+    for cycle in range(len(stimulus) * CYCLES_PER_SAMPLE):
+        sample = cycle // CYCLES_PER_SAMPLE
+        pins = stimulus[sample]
+
+        # The capture state machine reads once per sample, at the start of each period.
+        if cycle % CYCLES_PER_SAMPLE == 0:
+            marker = marker_at[0] is not None and cycle >= marker_at[0] + latency
+            captured.append(pins | (marker << MARKER_BIT))
+
+        set_flags = []
+
+        def set_marker(cycle=cycle):
+            if marker_at[0] is None:
+                marker_at[0] = cycle
+
+        for machine in machines:
+            machine.step(pins, flags, set_flags, set_marker)
+
+        for flag in set_flags:
+            flags[flag] = True
+
+    return captured
+
+
+def matches(sample, stage):
+    mask, pattern, _ = stage
+    return (sample & mask) == (pattern & mask)
+
+
+def reference(stages, stimulus):
+    """What the stages are meant to do, one sample at a time. The first stage lines itself
+    up with the capture during sample 0, so the trigger is live from sample 1."""
+    stage = 0
+    left = stages[0][2] - 1
+    held = False
+    deadline = None
+
+    for index, sample in enumerate(stimulus[1:], 1):
+        hit = matches(sample, stages[stage])
+
+        if stage == 0:
+            if held:
+                held = hit
+                continue
+            if not hit:
+                continue
+            if left:
+                left -= 1
+                held = True
+                continue
+        elif not hit:
+            if deadline is not None and index >= deadline:
+                stage, left, held = 0, stages[0][2] - 1, False
+            continue
+
+        if stage == len(stages) - 1:
+            return index
+
+        stage += 1
+        within = stages[stage][2]
+        deadline = index + within if within else None
+
+    return None
+
+
+def locate(captured):
+    """Trigger_Locate() - the first marked sample, less the fixed delay."""
+    first = next((index for index, sample in enumerate(captured) if sample >> MARKER_BIT & 1), None)
+    return None if first is None else first - MARKER_DELAY
+
+
+def random_stages(rng):
+    stages = []
+    for index in range(rng.randint(1, 3)):
+        base = rng.randint(0, 5)
+        count = rng.randint(1, 3)
+        mask = ((1 << count) - 1) << base
+        pattern = rng.getrandbits(8) & mask
+        n = rng.randint(1, 3) if index == 0 else rng.choice([0, 1, 2, 5, 20])
+        stages.append((mask, pattern, n))
+    return stages
+
+
+def random_stimulus(rng, length):
+    samples, value = [], 0
+    for _ in range(length):
+        if rng.random() < 0.3:
+            value = rng.getrandbits(8)
+        samples.append(value)
+    return samples
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Simulate the PIO trigger stages against random stimulus")
+    parser.add_argument("--runs", type=int, default=500)
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--latency", type=int, default=MARKER_LATENCY, help="marker output to input delay, PIO cycles")
+    args = parser.parse_args()
+
+    programs = load_programs(PIO_SOURCE)
+    rng = random.Random(args.seed)
+    failures = fired = 0
+
+    for run in range(args.runs):
+        stages = random_stages(rng)
+        stimulus = random_stimulus(rng, 200)
+        expected = reference(stages, stimulus)
+        captured = simulate(programs, stages, stimulus, args.latency)
+        found = locate(captured)
+
+        # Triggers in the last couple of samples have not had time to mark anything yet.
+        if expected is not None and expected >= len(stimulus) - 2:
+            continue
+
+        fired += expected is not None
+        if found != expected:
+            failures += 1
+            if failures <= 10:
+                print("run %d: stages %s, expected %s, found %s" % (run, [(hex(m), hex(p), n) for m, p, n in stages], expected, found))
+
+    print("%d runs, %d triggered, %d wrong: %s" % (args.runs, fired, failures, "PASS" if failures == 0 else "FAIL"))
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,302 @@
+//------------------------------------------------------------------------------------------------
+//---- Logic Capture ... 2026 Dave Gaunt                                                      ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include "LogicCapture.h"
+
+#include "pico/stdlib.h"
+
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/clocks.h"
+
+#include "capture.pio.h"
+
+// DMA channels - 0 moves samples into a block, 1 feeds it the next block address
+#define CAPTURE_DATA_CHAN		(0)
+#define CAPTURE_CTRL_CHAN		(1)
+
+static u32 s_aSampleBuffer[CAPTURE_MAX_SAMPLES];
+
+// Streaming Reads This Through A DMA Ring, So It Must Be Aligned To Its Own Size.
+static const u32* s_apBlockAddress[CAPTURE_BLOCK_COUNT] __attribute__((aligned(CAPTURE_BLOCK_COUNT * sizeof(u32*))));
+
+// Buffered Capture Reads Straight Through This Instead - The NULL Ends It.
+static const u32* s_apBufferedAddress[CAPTURE_BLOCK_COUNT + 1];
+
+static u32 s_uCaptureOffset = 0;
+static u32 s_uSimOffset = 0;
+
+static volatile u32 s_uBlocksWritten = 0;
+static volatile u32 s_uBlocksWanted = 0;
+static volatile u32 s_uCaptureMode = CAPTURE_IDLE;
+static volatile bool s_bRunning = false;
+static u32 s_uSampleRate = 0;
+static float s_fClockDivider = 1.0f;
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+static void __not_in_flash_func(StopHardware)(void)
+{
+	pio_sm_set_enabled(CAPTURE_PIO, CAPTURE_SM, false);
+	dma_channel_abort(CAPTURE_CTRL_CHAN);
+	dma_channel_abort(CAPTURE_DATA_CHAN);
+	s_bRunning = false;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- A Block Has Filled - The Next One Is Already Being Written By The Time We Get Here.    ----
+//------------------------------------------------------------------------------------------------
+static void __not_in_flash_func(CaptureDmaIrqHandler)(void)
+{
+	dma_channel_acknowledge_irq0(CAPTURE_DATA_CHAN);
+
+	// Buffered - The DMA Has Already Stopped Itself On The NULL, Just Park The State Machine.
+	// Triggered - The Trigger Has Asked For A Stop Here, The Next Block Is Not Wanted.
+	if ((++s_uBlocksWritten >= s_uBlocksWanted) && s_uBlocksWanted)
+		StopHardware();
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void Capture_Init(void)
+{
+	for (u32 uPin=CAPTURE_PIN_BASE; uPin<(CAPTURE_PIN_BASE + CAPTURE_PIN_COUNT); ++uPin)
+	{
+		gpio_init(uPin);
+		gpio_set_dir(uPin, GPIO_IN);
+
+		// Not Channels - Hold Them Still So They Do Not Break Up Runs Of Identical Samples.
+		if (0 == (CAPTURE_CHANNEL_MASK & (1u << (uPin - CAPTURE_PIN_BASE))))
+			gpio_pull_down(uPin);
+	}
+
+	for (u32 uBlock=0; uBlock<CAPTURE_BLOCK_COUNT; ++uBlock)
+		s_apBlockAddress[uBlock] = &s_aSampleBuffer[uBlock * CAPTURE_BLOCK_SAMPLES];
+
+	s_apBufferedAddress[CAPTURE_BLOCK_COUNT] = NULL;
+
+	s_uCaptureOffset = pio_add_program(CAPTURE_PIO, &capture_program);
+	s_uSimOffset = pio_add_program(CAPTURE_PIO, &capture_sim_program);
+
+	dma_channel_claim(CAPTURE_DATA_CHAN);
+	dma_channel_claim(CAPTURE_CTRL_CHAN);
+
+	dma_channel_set_irq0_enabled(CAPTURE_DATA_CHAN, true);
+	irq_set_exclusive_handler(DMA_IRQ_0, CaptureDmaIrqHandler);
+	irq_set_enabled(DMA_IRQ_0, true);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Same Chain As The VGA Line Table - The Control Channel Hands The Data Channel A Block  ----
+//---- Address, The Data Channel Fills It And Chains Back. Streaming Wraps The Table Read In  ----
+//---- Hardware, Buffered Capture Runs Into A NULL And Stops Without Any CPU Help.            ----
+//------------------------------------------------------------------------------------------------
+bool Capture_Start(const u32 uMode, const u32 uSampleRateHz, const u32 uSamples, const bool bSimulated)
+{
+	if ((CAPTURE_IDLE == uMode) || (0 == uSampleRateHz))
+		return false;
+
+	if ((CAPTURE_BUFFERED == uMode) && ((0 == uSamples) || (uSamples > CAPTURE_MAX_SAMPLES)))
+		return false;
+
+	Capture_Stop();
+
+	// The Simulated Counter Takes Two Instructions Per Sample.
+	const u32 uCyclesPerSample = bSimulated ? 2 : 1;
+	const u32 uSysHz = clock_get_hz(clk_sys);
+	float fClockDivider = (float)uSysHz / (float)(uSampleRateHz * uCyclesPerSample);
+
+	if (fClockDivider < 1.0f)
+		fClockDivider = 1.0f;
+	else if (fClockDivider > 65535.0f)
+		fClockDivider = 65535.0f;
+
+	// The Trigger Stages Run CAPTURE_TRIGGER_CLOCKS Times Faster - Keep Both Dividers Whole.
+	if (CAPTURE_TRIGGERED == uMode)
+	{
+		u32 uDivider = (u32)(fClockDivider / CAPTURE_TRIGGER_CLOCKS + 0.5f);
+
+		if (0 == uDivider)
+			uDivider = 1;
+		else if (uDivider > (65535 / CAPTURE_TRIGGER_CLOCKS))
+			uDivider = 65535 / CAPTURE_TRIGGER_CLOCKS;
+
+		fClockDivider = (float)(uDivider * CAPTURE_TRIGGER_CLOCKS);
+	}
+
+	s_fClockDivider = fClockDivider;
+	s_uSampleRate = (u32)((float)uSysHz / (fClockDivider * uCyclesPerSample));
+	s_uCaptureMode = uMode;
+	s_uBlocksWritten = 0;
+	s_uBlocksWanted = (CAPTURE_BUFFERED == uMode) ? ((uSamples + CAPTURE_BLOCK_SAMPLES - 1) / CAPTURE_BLOCK_SAMPLES) : 0;
+
+	pio_sm_set_enabled(CAPTURE_PIO, CAPTURE_SM, false);
+	capture_program_init(CAPTURE_PIO, CAPTURE_SM, bSimulated ? s_uSimOffset : s_uCaptureOffset, CAPTURE_PIN_BASE, fClockDivider, bSimulated);
+	pio_sm_clear_fifos(CAPTURE_PIO, CAPTURE_SM);
+
+	// Channel Zero (moves one block of samples from the PIO RX FIFO into SRAM)
+	dma_channel_config c0 = dma_channel_get_default_config(CAPTURE_DATA_CHAN);
+	channel_config_set_transfer_data_size(&c0, DMA_SIZE_32);
+	channel_config_set_read_increment(&c0, false);
+	channel_config_set_write_increment(&c0, true);
+	channel_config_set_dreq(&c0, pio_get_dreq(CAPTURE_PIO, CAPTURE_SM, false));
+	channel_config_set_chain_to(&c0, CAPTURE_CTRL_CHAN);
+
+	dma_channel_configure
+	(
+		CAPTURE_DATA_CHAN,
+		&c0,
+		s_aSampleBuffer,
+		&CAPTURE_PIO->rxf[CAPTURE_SM],
+		CAPTURE_BLOCK_SAMPLES,
+		false
+	);
+
+	// Channel One (walks the block table, each write restarts the first channel)
+	dma_channel_config c1 = dma_channel_get_default_config(CAPTURE_CTRL_CHAN);
+	channel_config_set_transfer_data_size(&c1, DMA_SIZE_32);
+	channel_config_set_read_increment(&c1, true);
+	channel_config_set_write_increment(&c1, false);
+	channel_config_set_chain_to(&c1, CAPTURE_CTRL_CHAN);
+
+	const u32** ppNextBlock = &s_apBlockAddress[1];
+
+	if (CAPTURE_BUFFERED != uMode)
+	{
+		channel_config_set_ring(&c1, false, __builtin_ctz(CAPTURE_BLOCK_COUNT * sizeof(u32*)));
+	}
+	else
+	{
+		for (u32 uBlock=0; uBlock<CAPTURE_BLOCK_COUNT; ++uBlock)
+			s_apBufferedAddress[uBlock] = (uBlock < s_uBlocksWanted) ? s_apBlockAddress[uBlock] : NULL;
+
+		ppNextBlock = &s_apBufferedAddress[1];
+	}
+
+	dma_channel_configure
+	(
+		CAPTURE_CTRL_CHAN,
+		&c1,
+		&dma_hw->ch[CAPTURE_DATA_CHAN].al2_write_addr_trig,
+		ppNextBlock,
+		1,
+		false
+	);
+
+	// Block 0 Goes First, The Table Then Carries On From Block 1.
+	s_bRunning = true;
+	dma_channel_start(CAPTURE_DATA_CHAN);
+
+	// Trigger_Arm Enables It Along With The Trigger Stages.
+	if (CAPTURE_TRIGGERED != uMode)
+		pio_sm_set_enabled(CAPTURE_PIO, CAPTURE_SM, true);
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void Capture_Stop(void)
+{
+	irq_set_enabled(DMA_IRQ_0, false);
+	StopHardware();
+	dma_channel_acknowledge_irq0(CAPTURE_DATA_CHAN);
+	irq_set_enabled(DMA_IRQ_0, true);
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+bool Capture_IsRunning(void)
+{
+	return s_bRunning;
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+u32 Capture_GetMode(void)
+{
+	return s_uCaptureMode;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Actual Rate After Rounding To The PIO Clock Divider.                                   ----
+//------------------------------------------------------------------------------------------------
+u32 Capture_GetSampleRate(void)
+{
+	return s_uSampleRate;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Always A Whole Multiple Of CAPTURE_TRIGGER_CLOCKS For A Triggered Capture.             ----
+//------------------------------------------------------------------------------------------------
+float Capture_GetClockDivider(void)
+{
+	return s_fClockDivider;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Blocks Completed Since Capture_Start - Keeps Counting Past The Size Of The Ring.       ----
+//------------------------------------------------------------------------------------------------
+u32 Capture_GetBlocksWritten(void)
+{
+	return s_uBlocksWritten;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Can Be A Block Behind Just As The DMA Moves On, Before The IRQ Has Counted It.         ----
+//------------------------------------------------------------------------------------------------
+u32 __not_in_flash_func(Capture_GetSamplesWritten)(void)
+{
+	u32 uBlocks;
+	u32 uLeft;
+
+	do
+	{
+		uBlocks = s_uBlocksWritten;
+		uLeft = dma_channel_hw_addr(CAPTURE_DATA_CHAN)->transfer_count;
+	}
+	while (uBlocks != s_uBlocksWritten);
+
+	return (uBlocks * CAPTURE_BLOCK_SAMPLES) + (CAPTURE_BLOCK_SAMPLES - uLeft);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Stops At The End Of Block uBlocks - 1, Or Straight Away If That Has Already Gone.      ----
+//------------------------------------------------------------------------------------------------
+void __not_in_flash_func(Capture_StopAtBlock)(const u32 uBlocks)
+{
+	const bool bEnabled = irq_is_enabled(DMA_IRQ_0);
+
+	irq_set_enabled(DMA_IRQ_0, false);
+
+	s_uBlocksWanted = uBlocks;
+
+	if (s_uBlocksWritten >= uBlocks)
+		StopHardware();
+
+	irq_set_enabled(DMA_IRQ_0, bEnabled);
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+const u32* Capture_GetBlock(const u32 uSequence)
+{
+	return s_apBlockAddress[uSequence & (CAPTURE_BLOCK_COUNT - 1)];
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Counted From Capture_Start - After A Stop, Only The Last 15 Blocks Are Still Whole.    ----
+//------------------------------------------------------------------------------------------------
+u32 Capture_GetSample(const u32 uIndex)
+{
+	return Capture_GetBlock(uIndex / CAPTURE_BLOCK_SAMPLES)[uIndex % CAPTURE_BLOCK_SAMPLES];
+}
@@ -0,0 +1,52 @@
+//------------------------------------------------------------------------------------------------
+//---- Logic Capture ... 2026 Dave Gaunt                                                      ----
+//------------------------------------------------------------------------------------------------
+//---- PIO Samples The Channel Pins, DMA Walks A Ring Of Blocks In SRAM.                      ----
+//------------------------------------------------------------------------------------------------
+#ifndef __LogicCapture_h_included
+#define __LogicCapture_h_included
+
+#include "types.h"
+
+#define CAPTURE_PIN_BASE		(2)				/* Bit 0 Of Every Sample Is GPIO 2 */
+#define CAPTURE_PIN_COUNT		(27)			/* GPIO 2 - 28, 23 - 25 Are Not Channels */
+#define CAPTURE_CHANNELS		(24)
+#define CAPTURE_CHANNEL_MASK	(0x071FFFFF)	/* Sample Bits That Are Channels */
+#define CAPTURE_BLOCK_SAMPLES	(4096)
+#define CAPTURE_BLOCK_COUNT		(16)			/* Must Be A Power Of 2! */
+#define CAPTURE_MAX_SAMPLES		(CAPTURE_BLOCK_SAMPLES * CAPTURE_BLOCK_COUNT)
+#define CAPTURE_TRIGGER_BIT		(21)			/* GPIO 23 (Red LED) - Set By The Trigger, See LogicTrigger.c */
+#define CAPTURE_TRIGGER_CLOCKS	(10)			/* Triggered Captures Take A Whole Multiple Of This Many Clocks Per Sample */
+
+// The Trigger Stages Run On The Same PIO, So They Can Start On The Same Clock.
+#define CAPTURE_PIO				(pio0)
+#define CAPTURE_SM				(0)
+
+enum capture_mode
+{
+	CAPTURE_IDLE = 0,
+	CAPTURE_BUFFERED,				/* Fill Up To CAPTURE_MAX_SAMPLES Then Stop */
+	CAPTURE_STREAMING,				/* Run Round The Ring Until Stopped */
+	CAPTURE_TRIGGERED				/* Streaming, But Trigger_Arm Starts It And The Trigger Stops It */
+};
+
+// Channel 0 - 20 Are Sample Bits 0 - 20, Channels 21 - 23 Are Sample Bits 24 - 26.
+static inline u32 CaptureChannelBit(const u32 uChannel)
+{
+	return (uChannel < 21) ? uChannel : (uChannel + 3);
+}
+
+void Capture_Init(void);
+bool Capture_Start(const u32 uMode, const u32 uSampleRateHz, const u32 uSamples, const bool bSimulated);
+void Capture_Stop(void);
+bool Capture_IsRunning(void);
+u32 Capture_GetMode(void);
+u32 Capture_GetSampleRate(void);
+float Capture_GetClockDivider(void);
+u32 Capture_GetBlocksWritten(void);
+u32 Capture_GetSamplesWritten(void);
+void Capture_StopAtBlock(const u32 uBlocks);
+const u32* Capture_GetBlock(const u32 uSequence);
+u32 Capture_GetSample(const u32 uIndex);
+
+#endif /* __LogicCapture_h_included */
@@ -0,0 +1,276 @@
+//------------------------------------------------------------------------------------------------
+//---- Logic Pack ... 2026 Dave Gaunt                                                         ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include "LogicPack.h"
+#include "LogicCapture.h"
+
+#if LOGIC_PACK_HOST_BUILD
+#define __not_in_flash(group)
+#else
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+
+#define PACK_HEADER_WORDS		(3)				/* Sequence, Samples, Words */
+#define PACK_WRAP_MARKER		(0xFFFFFFFF)	/* Rest Of The Ring Is Unused, Carry On At 0 */
+#define PACK_WORST_CASE			(PACK_HEADER_WORDS + CAPTURE_BLOCK_SAMPLES)
+
+static u32 s_aPackRing[PACK_RING_WORDS];
+
+// Core1 Owns The Write Side, Core0 The Read Side.
+static volatile u32 s_uWriteIndex = 0;
+static volatile u32 s_uReadIndex = 0;
+
+static volatile bool s_bPacking = false;
+static volatile u32 s_uCore1Passes = 0;
+static volatile u32 s_uNextRawBlock = 0;
+static volatile u32 s_uSampleLimit = 0;
+static volatile u32 s_uSamplesPacked = 0;
+static volatile u32 s_uWordsPacked = 0;
+static volatile u32 s_uDropped = 0;
+#endif
+
+//------------------------------------------------------------------------------------------------
+//---- Returns The Number Of Words Written - Never More Than uCount.                          ----
+//------------------------------------------------------------------------------------------------
+u32 __not_in_flash_func(Rle_PackBlock)(const u32* pSamples, const u32 uCount, u32* pOut)
+{
+	u32* pStart = pOut;
+	u32 uPrevious = pSamples[0] & CAPTURE_CHANNEL_MASK;
+	u32 uRun = 0;
+
+	*pOut++ = uPrevious;
+
+	for (u32 uIndex=1; uIndex<uCount; ++uIndex)
+	{
+		const u32 uSample = pSamples[uIndex] & CAPTURE_CHANNEL_MASK;
+
+		if (uSample == uPrevious)
+		{
+			++uRun;
+			continue;
+		}
+
+		if (uRun)
+		{
+			*pOut++ = RLE_REPEAT | uRun;
+			uRun = 0;
+		}
+
+		*pOut++ = uSample;
+		uPrevious = uSample;
+	}
+
+	if (uRun)
+		*pOut++ = RLE_REPEAT | uRun;
+
+	return pOut - pStart;
+}
+
+#if !LOGIC_PACK_HOST_BUILD
+//------------------------------------------------------------------------------------------------
+//---- Room For A Worst Case Block Without Catching Up With The Reader? Wraps If It Has To.   ----
+//------------------------------------------------------------------------------------------------
+static u32* __not_in_flash_func(ReserveBlock)(void)
+{
+	const u32 uRead = s_uReadIndex;
+	u32 uWrite = s_uWriteIndex;
+
+	if (uWrite >= uRead)
+	{
+		if ((PACK_RING_WORDS - uWrite) >= PACK_WORST_CASE)
+			return &s_aPackRing[uWrite];
+
+		// Not Enough Left At The End, Start Again At The Bottom If The Reader Has Moved On.
+		if (uRead <= PACK_WORST_CASE)
+			return NULL;
+
+		if (uWrite < PACK_RING_WORDS)
+			s_aPackRing[uWrite] = PACK_WRAP_MARKER;
+
+		uWrite = 0;
+		__dmb();
+		s_uWriteIndex = 0;
+	}
+
+	// One Word Gap So A Full Ring Never Looks Empty.
+	return ((uRead - uWrite) > PACK_WORST_CASE) ? &s_aPackRing[uWrite] : NULL;
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+static void __not_in_flash_func(PackNextBlock)(void)
+{
+	const u32 uBlocksWritten = Capture_GetBlocksWritten();
+	u32 uRawBlock = s_uNextRawBlock;
+
+	if (uRawBlock == uBlocksWritten)
+		return;
+
+	// Core1 Fell Behind The DMA, Jump To The Newest Finished Block.
+	if ((uBlocksWritten - uRawBlock) >= (CAPTURE_BLOCK_COUNT - 1))
+	{
+		s_uDropped += (uBlocksWritten - 1) - uRawBlock;
+		uRawBlock = uBlocksWritten - 1;
+	}
+
+	u32 uSamples = CAPTURE_BLOCK_SAMPLES;
+
+	if (s_uSampleLimit)
+	{
+		const u32 uSamplesLeft = s_uSampleLimit - s_uSamplesPacked;
+
+		if (uSamplesLeft < uSamples)
+			uSamples = uSamplesLeft;
+	}
+
+	u32* pHeader = ReserveBlock();
+
+	if (NULL == pHeader)
+	{
+		// USB Fell Behind, This Block Is Lost.
+		++s_uDropped;
+	}
+	else
+	{
+		const u32 uWords = Rle_PackBlock(Capture_GetBlock(uRawBlock), uSamples, pHeader + PACK_HEADER_WORDS);
+
+		pHeader[0] = uRawBlock;
+		pHeader[1] = uSamples;
+		pHeader[2] = uWords;
+
+		s_uSamplesPacked += uSamples;
+		s_uWordsPacked += uWords;
+
+		__dmb();
+		s_uWriteIndex = (pHeader - s_aPackRing) + PACK_HEADER_WORDS + uWords;
+	}
+
+	s_uNextRawBlock = uRawBlock + 1;
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+static void __not_in_flash_func(function_core1)(void)
+{
+	while(true)
+	{
+		++s_uCore1Passes;
+
+		if (s_bPacking && ((0 == s_uSampleLimit) || (s_uSamplesPacked < s_uSampleLimit)))
+			PackNextBlock();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void Pack_Init(void)
+{
+	multicore_launch_core1(function_core1);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Must Be Called Before Capture_Start Resets The Block Count Under Core1's Feet.         ----
+//------------------------------------------------------------------------------------------------
+void Pack_Stop(void)
+{
+	s_bPacking = false;
+
+	// Two Passes Guarantees Core1 Has Seen s_bPacking Go False And Is Not Mid Block.
+	const u32 uPasses = s_uCore1Passes;
+
+	while ((s_uCore1Passes - uPasses) < 2)
+		tight_loop_contents();
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Call After Capture_Start - A Limit Of 0 Packs Until The Capture Is Stopped.            ----
+//------------------------------------------------------------------------------------------------
+void Pack_Start(const u32 uSampleLimit)
+{
+	Pack_Stop();
+
+	s_uWriteIndex = 0;
+	s_uReadIndex = 0;
+	s_uNextRawBlock = 0;
+	s_uSampleLimit = uSampleLimit;
+	s_uSamplesPacked = 0;
+	s_uWordsPacked = 0;
+	s_uDropped = 0;
+
+	__dmb();
+	s_bPacking = true;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Everything Captured (Or Asked For) Has Been Packed And Sent.                           ----
+//------------------------------------------------------------------------------------------------
+bool Pack_IsFinished(void)
+{
+	const bool bAllPacked = (s_uSampleLimit && (s_uSamplesPacked >= s_uSampleLimit)) ||
+							(!Capture_IsRunning() && (s_uNextRawBlock == Capture_GetBlocksWritten()));
+
+	return bAllPacked && (s_uReadIndex == s_uWriteIndex);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Oldest Packed Block, Or NULL - It Stays Put Until Pack_Release.                        ----
+//------------------------------------------------------------------------------------------------
+const u32* Pack_Peek(u32* pSequence, u32* pSamples, u32* pWords)
+{
+	u32 uRead = s_uReadIndex;
+
+	if (uRead == s_uWriteIndex)
+		return NULL;
+
+	if ((uRead == PACK_RING_WORDS) || (PACK_WRAP_MARKER == s_aPackRing[uRead]))
+	{
+		uRead = 0;
+		s_uReadIndex = 0;
+
+		if (uRead == s_uWriteIndex)
+			return NULL;
+	}
+
+	__dmb();
+	*pSequence = s_aPackRing[uRead];
+	*pSamples = s_aPackRing[uRead + 1];
+	*pWords = s_aPackRing[uRead + 2];
+
+	return &s_aPackRing[uRead + PACK_HEADER_WORDS];
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void Pack_Release(void)
+{
+	const u32 uRead = s_uReadIndex;
+	s_uReadIndex = uRead + PACK_HEADER_WORDS + s_aPackRing[uRead + 2];
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Blocks Lost Because Core1 Or USB Could Not Keep Up.                                    ----
+//------------------------------------------------------------------------------------------------
+u32 Pack_GetDropped(void)
+{
+	return s_uDropped;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Samples In / Words Out Is The Compression Ratio.                                       ----
+//------------------------------------------------------------------------------------------------
+u32 Pack_GetSamplesPacked(void)
+{
+	return s_uSamplesPacked;
+}
+
+u32 Pack_GetWordsPacked(void)
+{
+	return s_uWordsPacked;
+}
+#endif
@@ -0,0 +1,34 @@
+//------------------------------------------------------------------------------------------------
+//---- Logic Pack ... 2026 Dave Gaunt                                                         ----
+//------------------------------------------------------------------------------------------------
+//---- Core1 Run Length Packs Each Captured Block As It Completes.                            ----
+//------------------------------------------------------------------------------------------------
+#ifndef __LogicPack_h_included
+#define __LogicPack_h_included
+
+#include "types.h"
+
+// Host Builds Only Get Rle_PackBlock, No Ring Or Core1 - See Host/logic_pack_test.py.
+#ifndef LOGIC_PACK_HOST_BUILD
+#define LOGIC_PACK_HOST_BUILD		(0)
+#endif
+
+// A Packed Block Is A List Of Words. Bit 31 Clear = A New Sample Value, Bit 31 Set = The
+// Previous Value Repeats Another (Word & 0x7FFFFFFF) Times. Every Block Starts With A Value,
+// So Blocks Decode On Their Own, And A Block Is Never Longer Than The Raw Samples.
+#define RLE_REPEAT				(1u << 31)
+
+#define PACK_RING_WORDS			(32768)			/* 128KB Of Packed Blocks Waiting For USB */
+
+void Pack_Init(void);
+void Pack_Start(const u32 uSampleLimit);
+void Pack_Stop(void);
+bool Pack_IsFinished(void);
+const u32* Pack_Peek(u32* pSequence, u32* pSamples, u32* pWords);
+void Pack_Release(void);
+u32 Pack_GetDropped(void);
+u32 Pack_GetSamplesPacked(void);
+u32 Pack_GetWordsPacked(void);
+u32 Rle_PackBlock(const u32* pSamples, const u32 uCount, u32* pOut);
+
+#endif /* __LogicPack_h_included */
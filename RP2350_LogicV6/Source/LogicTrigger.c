@@ -0,0 +1,192 @@
+//------------------------------------------------------------------------------------------------
+//---- Logic Trigger ... 2026 Dave Gaunt                                                      ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include "LogicTrigger.h"
+
+#include "pico/stdlib.h"
+
+#include "hardware/pio.h"
+#include "hardware/irq.h"
+
+#include "trigger.pio.h"
+
+#define TRIGGER_FIRST_SM		(CAPTURE_SM + 1)
+#define TRIGGER_ARM_FLAG		(TRIGGER_FIRST_SM)		/* "wait 1 irq 0 rel" On The First Stage */
+#define TRIGGER_FIFO_SLACK		(16)					/* Samples Still In The PIO FIFO When The IRQ Runs */
+
+static_assert(TRIGGER_CYCLES_PER_SAMPLE == CAPTURE_TRIGGER_CLOCKS, "trigger.pio and the capture clock divider disagree!");
+static_assert((CAPTURE_TRIGGER_BIT + CAPTURE_PIN_BASE) == 23, "The marker is the red LED!");
+
+static u32 s_uCountOffset = 0;
+static u32 s_uWindowOffset = 0;
+
+static u32 s_uStateMachines = 0;
+static u32 s_uFiredFlag = 0;
+static u32 s_uPostSamples = 0;
+static volatile bool s_bFired = false;
+
+//------------------------------------------------------------------------------------------------
+//---- The Last Stage Has Fired - Let The Capture Run On For The Post Trigger Samples.        ----
+//------------------------------------------------------------------------------------------------
+static void __not_in_flash_func(TriggerIrqHandler)(void)
+{
+	pio_set_irq0_source_enabled(CAPTURE_PIO, pis_interrupt0 + s_uFiredFlag, false);
+	pio_interrupt_clear(CAPTURE_PIO, s_uFiredFlag);
+
+	// The Count Can Be A Block Behind The DMA, And The Trigger Sample Can Still Be In The FIFO.
+	const u32 uLastSample = Capture_GetSamplesWritten() + CAPTURE_BLOCK_SAMPLES + TRIGGER_FIFO_SLACK + s_uPostSamples;
+
+	Capture_StopAtBlock((uLastSample / CAPTURE_BLOCK_SAMPLES) + 1);
+	s_bFired = true;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Call After Capture_Init - The Stages Share Its PIO And Its Marker Pin Pull Down.       ----
+//------------------------------------------------------------------------------------------------
+void Trigger_Init(void)
+{
+	s_uCountOffset = pio_add_program(CAPTURE_PIO, &trigger_count_program);
+	s_uWindowOffset = pio_add_program(CAPTURE_PIO, &trigger_window_program);
+
+	irq_set_exclusive_handler(PIO0_IRQ_0, TriggerIrqHandler);
+	irq_set_enabled(PIO0_IRQ_0, true);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Capture_Start(CAPTURE_TRIGGERED) First - This Starts The Capture And The Stages On The ----
+//---- Same Clock. Returns false If A Stage Cannot Be Done In PIO.                            ----
+//------------------------------------------------------------------------------------------------
+bool Trigger_Arm(const TriggerStage* pStages, const u32 uStages, const u32 uPostSamples)
+{
+	if ((0 == uStages) || (uStages > TRIGGER_MAX_STAGES) || (CAPTURE_TRIGGERED != Capture_GetMode()))
+		return false;
+
+	// PIO Has No AND - Any Channel Inside A Stage's Window Has To Be Part Of Its Mask.
+	for (u32 uStage=0; uStage<uStages; ++uStage)
+	{
+		const u32 uMask = pStages[uStage].m_uMask & CAPTURE_CHANNEL_MASK;
+
+		if (0 == uMask)
+			return false;
+
+		const u32 uBase = __builtin_ctz(uMask);
+		const u32 uWindow = (0xFFFFFFFF >> __builtin_clz(uMask)) & ~((1u << uBase) - 1);
+
+		if (uWindow & CAPTURE_CHANNEL_MASK & ~uMask)
+			return false;
+	}
+
+	Trigger_Disarm();
+
+	const float fClockDivider = Capture_GetClockDivider() / TRIGGER_CYCLES_PER_SAMPLE;
+	const u32 uLastSm = TRIGGER_FIRST_SM + uStages - 1;
+	u32 uEnableMask = 1u << CAPTURE_SM;
+
+	for (u32 uStage=0; uStage<uStages; ++uStage)
+	{
+		const TriggerStage* pStage = &pStages[uStage];
+		const u32 uMask = pStage->m_uMask & CAPTURE_CHANNEL_MASK;
+		const u32 uBase = __builtin_ctz(uMask);
+		const u32 uCount = 32 - __builtin_clz(uMask) - uBase;
+		const u32 uSm = TRIGGER_FIRST_SM + uStage;
+		const bool bFirst = (0 == uStage);
+
+		// The First Stage Counts Matches, The Others Count Samples Down To A Timeout.
+		u32 uReload;
+
+		if (bFirst)
+			uReload = pStage->m_uCount ? (pStage->m_uCount - 1) : 0;
+		else
+			uReload = pStage->m_uCount ? (pStage->m_uCount - 1) : 0xFFFFFFFF;
+
+		trigger_program_init(CAPTURE_PIO, uSm, bFirst ? s_uCountOffset : s_uWindowOffset, bFirst, CAPTURE_PIN_BASE + uBase, uCount, TRIGGER_MARKER_PIN, uSm == uLastSm, fClockDivider);
+
+		// Y = Pattern, OSR = Count - The Programs Never Touch Either Themselves.
+		pio_sm_put(CAPTURE_PIO, uSm, (pStage->m_uPattern & uMask) >> uBase);
+		pio_sm_exec(CAPTURE_PIO, uSm, pio_encode_pull(false, true));
+		pio_sm_exec(CAPTURE_PIO, uSm, pio_encode_mov(pio_y, pio_osr));
+		pio_sm_put(CAPTURE_PIO, uSm, uReload);
+		pio_sm_exec(CAPTURE_PIO, uSm, pio_encode_pull(false, true));
+
+		uEnableMask |= 1u << uSm;
+	}
+
+	// The Marker Starts Low, So The First Sample With It Set Is Right After The Trigger.
+	pio_gpio_init(CAPTURE_PIO, TRIGGER_MARKER_PIN);
+	pio_sm_set_pins_with_mask(CAPTURE_PIO, uLastSm, 0, 1u << TRIGGER_MARKER_PIN);
+	pio_sm_set_pindirs_with_mask(CAPTURE_PIO, uLastSm, 1u << TRIGGER_MARKER_PIN, 1u << TRIGGER_MARKER_PIN);
+
+	// Stage N Sets Flag (N + 1) + SM, So The Last Stage's Flag Is The IRQ.
+	for (u32 uFlag=0; uFlag<4; ++uFlag)
+		pio_interrupt_clear(CAPTURE_PIO, uFlag);
+
+	s_uStateMachines = uEnableMask & ~(1u << CAPTURE_SM);
+	s_uFiredFlag = (uLastSm + 1) & 3;
+	s_uPostSamples = uPostSamples;
+	s_bFired = false;
+
+	pio_set_irq0_source_enabled(CAPTURE_PIO, pis_interrupt0 + s_uFiredFlag, true);
+
+	// The First Stage Is Armed Before Anything Runs - Its Start Up Is Then Cycle Exact.
+	CAPTURE_PIO->irq_force = 1u << TRIGGER_ARM_FLAG;
+	pio_enable_sm_mask_in_sync(CAPTURE_PIO, uEnableMask);
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Stops The Stages And Puts The Marker (And The Red LED) Back Low.                       ----
+//------------------------------------------------------------------------------------------------
+void Trigger_Disarm(void)
+{
+	if (0 == s_uStateMachines)
+		return;
+
+	pio_set_irq0_source_enabled(CAPTURE_PIO, pis_interrupt0 + s_uFiredFlag, false);
+	pio_set_sm_mask_enabled(CAPTURE_PIO, s_uStateMachines, false);
+	pio_sm_set_pins_with_mask(CAPTURE_PIO, TRIGGER_FIRST_SM, 0, 1u << TRIGGER_MARKER_PIN);
+
+	s_uStateMachines = 0;
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+bool Trigger_HasFired(void)
+{
+	return s_bFired;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Once The Capture Has Stopped - The Sample Index (From Capture_Start) Of The Trigger.   ----
+//---- The Marker Only Ever Goes Low To High During A Capture, So A Binary Search Finds It.   ----
+//------------------------------------------------------------------------------------------------
+u32 Trigger_Locate(void)
+{
+	const u32 uBlocks = Capture_GetBlocksWritten();
+
+	if (!s_bFired || (0 == uBlocks))
+		return TRIGGER_NOT_FOUND;
+
+	// The Block After The Last One Was Partly Written Over The Oldest Before The DMA Stopped.
+	const u32 uOldestBlock = (uBlocks >= CAPTURE_BLOCK_COUNT) ? (uBlocks - (CAPTURE_BLOCK_COUNT - 1)) : 0;
+	u32 uLow = uOldestBlock * CAPTURE_BLOCK_SAMPLES;
+	u32 uHigh = (uBlocks * CAPTURE_BLOCK_SAMPLES) - 1;
+
+	if (0 == (Capture_GetSample(uHigh) & (1u << CAPTURE_TRIGGER_BIT)))
+		return TRIGGER_NOT_FOUND;
+
+	while (uLow < uHigh)
+	{
+		const u32 uMiddle = uLow + ((uHigh - uLow) / 2);
+
+		if (Capture_GetSample(uMiddle) & (1u << CAPTURE_TRIGGER_BIT))
+			uHigh = uMiddle;
+		else
+			uLow = uMiddle + 1;
+	}
+
+	return (uLow >= TRIGGER_MARKER_DELAY) ? (uLow - TRIGGER_MARKER_DELAY) : 0;
+}
@@ -0,0 +1,33 @@
+//------------------------------------------------------------------------------------------------
+//---- Logic Trigger ... 2026 Dave Gaunt                                                      ----
+//------------------------------------------------------------------------------------------------
+//---- Up To 3 PIO Trigger Stages - A Pattern N Times, Then B Within N Samples, Then C ...    ----
+//------------------------------------------------------------------------------------------------
+#ifndef __LogicTrigger_h_included
+#define __LogicTrigger_h_included
+
+#include "types.h"
+#include "LogicCapture.h"
+
+#define TRIGGER_MAX_STAGES		(3)				/* State Machines 1 - 3 Of The Capture PIO */
+#define TRIGGER_MARKER_PIN		(CAPTURE_PIN_BASE + CAPTURE_TRIGGER_BIT)
+#define TRIGGER_MARKER_DELAY	(1)				/* The Marker First Shows Up In The Sample After The Trigger */
+#define TRIGGER_NOT_FOUND		(0xFFFFFFFF)
+
+// Pre + Post Must Fit In What Is Left Of The Ring Once The Stop Has Been Rounded Up To A Block.
+#define TRIGGER_MAX_SAMPLES		((CAPTURE_BLOCK_COUNT - 4) * CAPTURE_BLOCK_SAMPLES)
+
+typedef struct
+{
+	u32	m_uMask;					/* Sample Bits To Match - One Contiguous Run Of Channels */
+	u32	m_uPattern;
+	u32	m_uCount;					/* First Stage: Fire On The Nth Match. Later: Within N Samples, 0 = Any Time */
+} TriggerStage;
+
+void Trigger_Init(void);
+bool Trigger_Arm(const TriggerStage* pStages, const u32 uStages, const u32 uPostSamples);
+void Trigger_Disarm(void);
+bool Trigger_HasFired(void);
+u32 Trigger_Locate(void);
+
+#endif /* __LogicTrigger_h_included */
@@ -0,0 +1,465 @@
+//------------------------------------------------------------------------------------------------
+//---- RP2350 Logic V6 ... 2026 Dave Gaunt                                                    ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+#include "types.h"
+
+#include "pico/stdlib.h"
+#include "tusb.h"
+
+#include "LogicCapture.h"
+#include "LogicPack.h"
+#include "LogicTrigger.h"
+
+#define CAPTURE_MAGIC			(0x3643474C)	/* "LGC6" */
+#define BLOCK_MAGIC				(0x364B4C42)	/* "BLK6" */
+#define PROTOCOL_VERSION		(3)
+
+#define FLAG_SIMULATED			(1 << 0)
+#define FLAG_STREAMING			(1 << 1)
+#define FLAG_RLE				(1 << 2)		/* Block Data Is Run Length Packed, See LogicPack.h */
+#define FLAG_TRIGGERED			(1 << 3)
+
+#define COMMAND_LENGTH			(64)
+
+//------------------------------------------------------------------------------------------------
+//---- Everything Sent To The Host Is Little Endian.                                          ----
+//------------------------------------------------------------------------------------------------
+typedef struct
+{
+	u32	m_uMagic;
+	u16	m_uVersion;
+	u16	m_uFlags;
+	u32	m_uSampleRate;
+	u32	m_uSamples;					/* 0 When Streaming */
+	u32	m_uTrigger;					/* Index Of The Trigger Sample, TRIGGER_NOT_FOUND If There Was None */
+} CaptureHeader;
+
+typedef struct
+{
+	u32	m_uMagic;
+	u32	m_uSequence;
+	u32	m_uSamples;					/* 0 Marks The End Of The Capture */
+	u32	m_uWords;					/* Data Words That Follow, Fewer Than m_uSamples When Packed */
+	u32	m_uOverruns;				/* Blocks Lost So Far Because Core1 Or USB Fell Behind */
+} BlockHeader;
+
+static_assert(20 == sizeof(CaptureHeader), "Capture header is part of the host protocol!");
+static_assert(20 == sizeof(BlockHeader), "Block header is part of the host protocol!");
+
+// What Is Being Sent To The Host Right Now.
+static bool s_bCaptureActive = false;
+static bool s_bPacked = false;
+static u32 s_uNextBlock = 0;
+static u32 s_uBlockOffset = 0;
+static u32 s_uSamplesLeft = 0;
+static u32 s_uOverruns = 0;
+
+// A Triggered Capture Runs Quietly Until The Trigger, Then Sends Like A Buffered One.
+static bool s_bWaitingForTrigger = false;
+static u32 s_uPreSamples = 0;
+static u32 s_uPostSamples = 0;
+
+static BlockHeader s_blockHeader;
+static const u8* s_pBlockData = NULL;
+static u32 s_uHeaderSent = 0;
+static u32 s_uDataBytes = 0;
+static u32 s_uDataSent = 0;
+static bool s_bBlockActive = false;
+
+static char s_szCommand[COMMAND_LENGTH];
+static u32 s_uCommandLength = 0;
+
+//------------------------------------------------------------------------------------------------
+//---- Never Waits - Writes As Much As The CDC FIFO Will Take And Says How Much That Was.     ----
+//------------------------------------------------------------------------------------------------
+static u32 UsbWrite(const void* pData, u32 uBytes)
+{
+	const u32 uSpace = tud_cdc_write_available();
+
+	if (uBytes > uSpace)
+		uBytes = uSpace;
+
+	return uBytes ? tud_cdc_write(pData, uBytes) : 0;
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+static void StartBlock(const u32 uSequence, const u32 uSamples, const u32 uWords, const u32* pData)
+{
+	s_blockHeader.m_uMagic = BLOCK_MAGIC;
+	s_blockHeader.m_uSequence = uSequence;
+	s_blockHeader.m_uSamples = uSamples;
+	s_blockHeader.m_uWords = uWords;
+	s_blockHeader.m_uOverruns = s_bPacked ? Pack_GetDropped() : s_uOverruns;
+
+	s_pBlockData = (const u8*)pData;
+	s_uDataBytes = uWords * sizeof(u32);
+	s_uHeaderSent = 0;
+	s_uDataSent = 0;
+	s_bBlockActive = true;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Pick The Next Finished Block, Or The End Marker Once There Is Nothing Left To Send.    ----
+//------------------------------------------------------------------------------------------------
+static void QueueNextBlock(void)
+{
+	const u32 uBlocksWritten = Capture_GetBlocksWritten();
+
+	if (s_bPacked)
+	{
+		u32 uSequence, uSamples, uWords;
+		const u32* pWords = Pack_Peek(&uSequence, &uSamples, &uWords);
+
+		// Buffered Packed Captures Run The DMA Free, Stop It Once Core1 Has Enough.
+		if (s_uSamplesLeft && (Pack_GetSamplesPacked() >= s_uSamplesLeft))
+			Capture_Stop();
+
+		if (pWords)
+			StartBlock(uSequence, uSamples, uWords, pWords);
+		else if (Pack_IsFinished())
+			StartBlock(uBlocksWritten, 0, 0, NULL);
+	}
+	else if (CAPTURE_STREAMING == Capture_GetMode())
+	{
+		// Leave A Block Of Slack So The One Being Sent Is Not Also Being Overwritten.
+		if ((uBlocksWritten - s_uNextBlock) >= (CAPTURE_BLOCK_COUNT - 1))
+		{
+			s_uOverruns += (uBlocksWritten - 1) - s_uNextBlock;
+			s_uNextBlock = uBlocksWritten - 1;
+		}
+
+		if (s_uNextBlock != uBlocksWritten)
+			StartBlock(s_uNextBlock, CAPTURE_BLOCK_SAMPLES, CAPTURE_BLOCK_SAMPLES, Capture_GetBlock(s_uNextBlock));
+		else if (!Capture_IsRunning())
+			StartBlock(s_uNextBlock, 0, 0, NULL);
+	}
+	else
+	{
+		if (0 == s_uSamplesLeft)
+		{
+			StartBlock(s_uNextBlock, 0, 0, NULL);
+		}
+		else if (s_uNextBlock != uBlocksWritten)
+		{
+			// Triggered Captures Start Part Way Into A Block.
+			const u32 uAvailable = CAPTURE_BLOCK_SAMPLES - s_uBlockOffset;
+			const u32 uSamples = (s_uSamplesLeft < uAvailable) ? s_uSamplesLeft : uAvailable;
+			s_uSamplesLeft -= uSamples;
+			StartBlock(s_uNextBlock, uSamples, uSamples, Capture_GetBlock(s_uNextBlock) + s_uBlockOffset);
+			s_uBlockOffset = 0;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+static void SendCapture(void)
+{
+	if (!s_bCaptureActive)
+		return;
+
+	if (!s_bBlockActive)
+		QueueNextBlock();
+
+	if (!s_bBlockActive)
+		return;
+
+	if (s_uHeaderSent < sizeof(BlockHeader))
+		s_uHeaderSent += UsbWrite((const u8*)&s_blockHeader + s_uHeaderSent, sizeof(BlockHeader) - s_uHeaderSent);
+
+	if ((s_uHeaderSent == sizeof(BlockHeader)) && (s_uDataSent < s_uDataBytes))
+		s_uDataSent += UsbWrite(s_pBlockData + s_uDataSent, s_uDataBytes - s_uDataSent);
+
+	if ((s_uHeaderSent == sizeof(BlockHeader)) && (s_uDataSent == s_uDataBytes))
+	{
+		s_bBlockActive = false;
+		++s_uNextBlock;
+
+		if (s_bPacked && s_blockHeader.m_uSamples)
+			Pack_Release();
+
+		// The End Marker Has Gone, Nothing More For This Capture.
+		if (0 == s_blockHeader.m_uSamples)
+			s_bCaptureActive = false;
+	}
+
+	tud_cdc_write_flush();
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Blocking Here Is Fine - It Only Happens Once, Before Any Samples Need Sending.         ----
+//------------------------------------------------------------------------------------------------
+static void SendCaptureHeader(const u32 uFlags, const u32 uSamples, const u32 uTrigger)
+{
+	const CaptureHeader header =
+	{
+		.m_uMagic = CAPTURE_MAGIC,
+		.m_uVersion = PROTOCOL_VERSION,
+		.m_uFlags = uFlags,
+		.m_uSampleRate = Capture_GetSampleRate(),
+		.m_uSamples = uSamples,
+		.m_uTrigger = uTrigger
+	};
+
+	u32 uSent = 0;
+
+	while (uSent < sizeof(header))
+	{
+		uSent += UsbWrite((const u8*)&header + uSent, sizeof(header) - uSent);
+		tud_task();
+	}
+
+	tud_cdc_write_flush();
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+static void BeginCapture(const u32 uMode, const u32 uSampleRate, const u32 uSamples, const bool bSimulated, const bool bPacked)
+{
+	// One Capture At A Time, Or The Host Would Lose Track Of The Blocks.
+	if (s_bCaptureActive || s_bWaitingForTrigger)
+		return;
+
+	Pack_Stop();
+
+	// Packed Captures Always Run Round The Ring - Depth Is Only Limited By How Well They Pack.
+	if (Capture_Start(bPacked ? CAPTURE_STREAMING : uMode, uSampleRate, uSamples, bSimulated))
+	{
+		s_bCaptureActive = true;
+		s_bPacked = bPacked;
+		s_bBlockActive = false;
+		s_uNextBlock = 0;
+		s_uSamplesLeft = uSamples;
+		s_uOverruns = 0;
+
+		u32 uFlags = bSimulated ? FLAG_SIMULATED : 0;
+
+		if (CAPTURE_STREAMING == uMode)
+			uFlags |= FLAG_STREAMING;
+
+		if (bPacked)
+		{
+			uFlags |= FLAG_RLE;
+			Pack_Start(uSamples);
+		}
+
+		SendCaptureHeader(uFlags, uSamples, TRIGGER_NOT_FOUND);
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Nothing Goes To The Host Until The Trigger - The Header Has To Say Where It Was.       ----
+//------------------------------------------------------------------------------------------------
+static void BeginTrigger(const u32 uSampleRate, const u32 uPreSamples, const u32 uPostSamples, const TriggerStage* pStages, const u32 uStages)
+{
+	if (s_bCaptureActive || s_bWaitingForTrigger || ((uPreSamples + uPostSamples) > TRIGGER_MAX_SAMPLES))
+		return;
+
+	Pack_Stop();
+
+	if (!Capture_Start(CAPTURE_TRIGGERED, uSampleRate, 0, false))
+		return;
+
+	if (!Trigger_Arm(pStages, uStages, uPostSamples))
+	{
+		Capture_Stop();
+		return;
+	}
+
+	s_bWaitingForTrigger = true;
+	s_uPreSamples = uPreSamples;
+	s_uPostSamples = uPostSamples;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Once The Capture Has Stopped, Send Pre + Post Samples Around The Trigger. Stopped By X ----
+//---- Before It Fired, The Most Recent Pre + Post Samples Go Instead.                        ----
+//------------------------------------------------------------------------------------------------
+static void ServiceTrigger(void)
+{
+	if (!s_bWaitingForTrigger || Capture_IsRunning())
+		return;
+
+	const u32 uTrigger = Trigger_Locate();
+	const u32 uBlocks = Capture_GetBlocksWritten();
+	const u32 uOldest = (uBlocks >= CAPTURE_BLOCK_COUNT) ? ((uBlocks - (CAPTURE_BLOCK_COUNT - 1)) * CAPTURE_BLOCK_SAMPLES) : 0;
+	const u32 uEnd = uBlocks * CAPTURE_BLOCK_SAMPLES;
+	u32 uFirst;
+	u32 uLast;
+
+	Trigger_Disarm();
+	s_bWaitingForTrigger = false;
+
+	if (TRIGGER_NOT_FOUND == uTrigger)
+	{
+		uLast = uEnd;
+		uFirst = ((uEnd - uOldest) > (s_uPreSamples + s_uPostSamples)) ? (uEnd - (s_uPreSamples + s_uPostSamples)) : uOldest;
+	}
+	else
+	{
+		uFirst = ((uTrigger - uOldest) > s_uPreSamples) ? (uTrigger - s_uPreSamples) : uOldest;
+		uLast = ((uEnd - uTrigger) > s_uPostSamples) ? (uTrigger + s_uPostSamples) : uEnd;
+	}
+
+	s_bCaptureActive = true;
+	s_bPacked = false;
+	s_bBlockActive = false;
+	s_uNextBlock = uFirst / CAPTURE_BLOCK_SAMPLES;
+	s_uBlockOffset = uFirst % CAPTURE_BLOCK_SAMPLES;
+	s_uSamplesLeft = uLast - uFirst;
+	s_uOverruns = 0;
+
+	SendCaptureHeader(FLAG_TRIGGERED, uLast - uFirst, (TRIGGER_NOT_FOUND == uTrigger) ? TRIGGER_NOT_FOUND : (uTrigger - uFirst));
+}
+
+//------------------------------------------------------------------------------------------------
+//---- <mask>:<pattern>[:<count>] In Hex Channel Bits (Count In Decimal), Into Sample Bits.   ----
+//------------------------------------------------------------------------------------------------
+static u32 ParseStages(const char* pszStages, TriggerStage* pStages)
+{
+	u32 uStages = 0;
+
+	while (uStages < TRIGGER_MAX_STAGES)
+	{
+		u32 uChannelMask = 0;
+		u32 uChannelPattern = 0;
+		u32 uCount = (0 == uStages) ? 1 : 0;
+		int iUsed = 0;
+
+		while (' ' == *pszStages)
+			++pszStages;
+
+		if (sscanf(pszStages, "%x:%x%n", &uChannelMask, &uChannelPattern, &iUsed) < 2)
+			break;
+
+		pszStages += iUsed;
+
+		if (':' == *pszStages)
+		{
+			if (1 == sscanf(pszStages + 1, "%u%n", &uCount, &iUsed))
+				pszStages += 1 + iUsed;
+		}
+
+		TriggerStage* pStage = &pStages[uStages++];
+		pStage->m_uMask = 0;
+		pStage->m_uPattern = 0;
+		pStage->m_uCount = uCount;
+
+		for (u32 uChannel=0; uChannel<CAPTURE_CHANNELS; ++uChannel)
+		{
+			const u32 uBit = 1u << CaptureChannelBit(uChannel);
+
+			if (uChannelMask & (1u << uChannel))
+				pStage->m_uMask |= uBit;
+
+			if (uChannelPattern & (1u << uChannel))
+				pStage->m_uPattern |= uBit;
+		}
+	}
+
+	return uStages;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- One ASCII Command Per Line:                                                            ----
+//----   B <rate> <samples> [SIM] [RLE]    Buffered Capture                                   ----
+//----   S <rate> [SIM] [RLE]              Stream Until X                                     ----
+//----   T <rate> <pre> <post> <stage>...  Triggered Capture, See ParseStages                 ----
+//----   X                                 Stop                                               ----
+//------------------------------------------------------------------------------------------------
+static void RunCommand(const char* pszCommand)
+{
+	const bool bSimulated = (NULL != strstr(pszCommand, "SIM"));
+	const bool bPacked = (NULL != strstr(pszCommand, "RLE"));
+	u32 uSampleRate = 0;
+	u32 uSamples = 0;
+	u32 uPreSamples = 0;
+	u32 uPostSamples = 0;
+	int iUsed = 0;
+	TriggerStage aStages[TRIGGER_MAX_STAGES];
+
+	switch(pszCommand[0])
+	{
+		case 'B':
+			if (2 == sscanf(pszCommand + 1, "%u %u", &uSampleRate, &uSamples))
+				BeginCapture(CAPTURE_BUFFERED, uSampleRate, uSamples, bSimulated, bPacked);
+		break;
+
+		case 'S':
+			if (1 == sscanf(pszCommand + 1, "%u", &uSampleRate))
+				BeginCapture(CAPTURE_STREAMING, uSampleRate, 0, bSimulated, bPacked);
+		break;
+
+		case 'T':
+			if (3 == sscanf(pszCommand + 1, "%u %u %u%n", &uSampleRate, &uPreSamples, &uPostSamples, &iUsed))
+			{
+				const u32 uStages = ParseStages(pszCommand + 1 + iUsed, aStages);
+
+				if (uStages)
+					BeginTrigger(uSampleRate, uPreSamples, uPostSamples, aStages, uStages);
+			}
+		break;
+
+		case 'X':
+			// Whatever Has Already Been Captured Still Goes Out, Then The End Marker.
+			Capture_Stop();
+		break;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+static void ReadCommands(void)
+{
+	while (tud_cdc_available())
+	{
+		char c;
+
+		if (0 == tud_cdc_read(&c, 1))
+			break;
+
+		if (('\n' == c) || ('\r' == c))
+		{
+			s_szCommand[s_uCommandLength] = 0;
+
+			if (s_uCommandLength)
+				RunCommand(s_szCommand);
+
+			s_uCommandLength = 0;
+		}
+		else if (s_uCommandLength < (COMMAND_LENGTH - 1))
+		{
+			s_szCommand[s_uCommandLength++] = c;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+int main()
+{
+	// USB Is Only Serviced From The Loop Below, Never From A Background IRQ (See CMakeLists.txt).
+	stdio_init_all();
+
+	Capture_Init();
+	Trigger_Init();
+	Pack_Init();
+
+	while(true)
+	{
+		tud_task();
+		ReadCommands();
+		ServiceTrigger();
+		SendCapture();
+	}
+}
@@ -0,0 +1,744 @@
+#!/usr/bin/env python3
+#------------------------------------------------------------------------------------------------
+#---- CIA 6526 Test ... 2026 Dave Gaunt                                                       ----
+#------------------------------------------------------------------------------------------------
+#---- Builds Source/Cia6526.c For The Host And Ticks It A Phase 2 Cycle At A Time. Timers,    ----
+#---- Cascade, Force Load, TOD Rollover And Alarm, The Serial Port And The ICR Are Checked    ----
+#---- Against Periods Worked Out Here, Then Random Writes, Reads And Pin Edges Go Through It ----
+#---- And A Per Cycle Python Reference Side By Side - Every Register, #IRQ, SP And CNT.       ----
+#------------------------------------------------------------------------------------------------
+import argparse
+import ctypes
+import os
+import random
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+COMMON = os.path.join(HERE, "..", "..", "Common")
+SOURCE = os.path.join(HERE, "..", "Source")
+
+# Registers, as cia_register_names in Cia6526.h.
+PRA, PRB, DDRA, DDRB, TAL, TAH, TBL, TBH, TOD_10TH, TOD_SEC, TOD_MIN, TOD_HR, SDR, ICR, CRA, CRB = range(16)
+
+# ICR bits (cia_irq_flags).
+IRQ_TA, IRQ_TB, IRQ_ALARM, IRQ_SERIAL, IRQ_FLAG = (1 << b for b in range(5))
+
+# Control register bits.
+CR_START, CR_PB_ON, CR_TOGGLE, CR_ONE_SHOT, CR_FORCE_LOAD = (1 << b for b in range(5))
+CRA_COUNT_CNT, CRA_SERIAL_OUT, CRA_TOD_50HZ = 1 << 5, 1 << 6, 1 << 7
+CRB_WRITE_ALARM = 1 << 7
+TB_PHI2, TB_CNT, TB_TIMERA, TB_TIMERA_CNT = (m << 5 for m in range(4))
+
+# Pins into Cia6526_Tick.
+IN_CNT, IN_SP, IN_TOD, IN_FLAG = (1 << b for b in range(4))
+
+# The outputs are only in the state, so a shim reads them.
+SHIM = r"""
+#include "Cia6526.h"
+
+u32 Shim_Size(void) { return sizeof(Cia6526State); }
+u32 Shim_Irq(const Cia6526State* pCia) { return pCia->m_bIrq; }
+u32 Shim_Sp(const Cia6526State* pCia) { return pCia->m_bSpOut; }
+u32 Shim_Cnt(const Cia6526State* pCia) { return pCia->m_bCntOut; }
+"""
+
+
+class Checker:
+    def __init__(self):
+        self.failures = 0
+        self.checks = 0
+
+    def check(self, condition, what):
+        self.checks += 1
+        if not condition:
+            self.failures += 1
+            print("FAIL: %s" % what)
+
+
+def build(work, compiler):
+    shim = os.path.join(work, "shim.c")
+    with open(shim, "w") as f:
+        f.write(SHIM)
+
+    library = os.path.join(work, "cia6526.so")
+    subprocess.check_call([compiler, "-std=gnu11", "-O2", "-shared", "-fPIC", "-Wall", "-Werror", "-I" + COMMON, "-I" + SOURCE,
+                           os.path.join(SOURCE, "Cia6526.c"), shim, "-o", library])
+
+    lib = ctypes.CDLL(library)
+    lib.Shim_Size.restype = ctypes.c_uint32
+    lib.Cia6526_Reset.argtypes = [ctypes.c_void_p]
+    lib.Cia6526_Tick.argtypes = [ctypes.c_void_p, ctypes.c_uint32]
+    lib.Cia6526_Read.argtypes = [ctypes.c_void_p, ctypes.c_uint32, ctypes.c_uint8, ctypes.c_uint8]
+    lib.Cia6526_Read.restype = ctypes.c_uint8
+    lib.Cia6526_Peek.argtypes = [ctypes.c_void_p, ctypes.c_uint32]
+    lib.Cia6526_Peek.restype = ctypes.c_uint8
+    lib.Cia6526_Write.argtypes = [ctypes.c_void_p, ctypes.c_uint32, ctypes.c_uint8]
+    for getter in ("Shim_Irq", "Shim_Sp", "Shim_Cnt"):
+        getattr(lib, getter).argtypes = [ctypes.c_void_p]
+    return lib
+
+
+class Chip:
+    """One Cia6526State, driven the way VIA_6522.c's core1 loop drives it."""
+
+    def __init__(self, lib):
+        self.lib = lib
+        self.state = ctypes.create_string_buffer(lib.Shim_Size())
+        lib.Cia6526_Reset(self.state)
+        self.inputs = 0
+
+    def tick(self, cycles=1):
+        for _ in range(cycles):
+            self.lib.Cia6526_Tick(self.state, self.inputs)
+
+    def write(self, register, data):
+        self.lib.Cia6526_Write(self.state, register, data)
+
+    def read(self, register, pins_a=0xFF, pins_b=0xFF):
+        return self.lib.Cia6526_Read(self.state, register, pins_a, pins_b)
+
+    def peek(self, register):
+        return self.lib.Cia6526_Peek(self.state, register)
+
+    def irq(self):
+        return bool(self.lib.Shim_Irq(self.state))
+
+    def sp(self):
+        return bool(self.lib.Shim_Sp(self.state))
+
+    def cnt(self):
+        return bool(self.lib.Shim_Cnt(self.state))
+
+    def timer(self, low):
+        return self.peek(low) | (self.peek(low + 1) << 8)
+
+    def start_timer_a(self, latch, control=0):
+        self.write(TAL, latch & 0xFF)
+        self.write(TAH, latch >> 8)
+        self.write(CRA, CR_START | CR_FORCE_LOAD | control)
+
+
+#------------------------------------------------------------------------------------------------
+# The reference - the same programming model, kept as plain numbers. The clock is tenths,
+# seconds, minutes and a 24 hour count, turned into BCD and 12 hour AM/PM only when read.
+#------------------------------------------------------------------------------------------------
+def bcd(value):
+    return ((value // 10) << 4) | (value % 10)
+
+
+def from_bcd(value):
+    return (value >> 4) * 10 + (value & 15)
+
+
+def clock_bytes(tenths, seconds, minutes, hours24):
+    hour12 = hours24 % 12 or 12
+    return [tenths, bcd(seconds), bcd(minutes), bcd(hour12) | (0x80 if hours24 >= 12 else 0)]
+
+
+class Timer:
+    def __init__(self):
+        self.counter = self.latch = 0xFFFF
+        self.control = 0
+
+    def count(self):
+        """One count, True on underflow. Zero is shown for a whole count before the reload."""
+        if self.counter:
+            self.counter -= 1
+            return False
+        self.counter = self.latch
+        if self.control & CR_ONE_SHOT:
+            self.control &= ~CR_START
+        return True
+
+
+class Reference:
+    def __init__(self):
+        self.port = [0, 0]
+        self.ddr = [0, 0]
+        self.a, self.b = Timer(), Timer()
+        self.time = [0, 0, 0, 1]        # Tenths, seconds, minutes, hours 0 - 23 - reset is 1 AM
+        self.latched = None
+        self.alarm = [0, 0, 0, 0]
+        self.running = True
+        self.tod_pulses = 0
+        self.sdr = 0
+        self.in_bits = []               # Serial input, oldest first
+        self.out_bits = []              # Serial output still to go, next first
+        self.out_pending = None
+        self.half = False               # In the CNT low half of an output bit
+        self.sp_out = False
+        self.flags = 0
+        self.mask = 0
+        self.irq = False
+        self.pb_timer = 0
+        self.pb_mask = 0
+        self.last = 0
+
+    def raise_flag(self, flag):
+        self.flags |= flag
+        self.irq = bool(self.flags & self.mask)
+
+    def tod_bytes(self):
+        return clock_bytes(*self.time)
+
+    def tick(self, inputs):
+        rising, falling = inputs & ~self.last, ~inputs & self.last
+        self.last = inputs
+
+        under_a = False
+        if self.a.control & CR_START and (not self.a.control & CRA_COUNT_CNT or rising & IN_CNT):
+            under_a = self.a.count()
+            if under_a:
+                self.raise_flag(IRQ_TA)
+                if self.a.control & CRA_SERIAL_OUT:
+                    self.clock_out()
+        self.port_output(self.a.control, 0x40, under_a)
+
+        under_b = False
+        if self.b.control & CR_START:
+            source = self.b.control & (3 << 5)
+            if {TB_PHI2: True, TB_CNT: bool(rising & IN_CNT), TB_TIMERA: under_a,
+                    TB_TIMERA_CNT: under_a and bool(inputs & IN_CNT)}[source]:
+                under_b = self.b.count()
+                if under_b:
+                    self.raise_flag(IRQ_TB)
+        self.port_output(self.b.control, 0x80, under_b)
+
+        if not self.a.control & CRA_SERIAL_OUT and rising & IN_CNT:
+            self.in_bits.append(1 if inputs & IN_SP else 0)
+            if len(self.in_bits) == 8:
+                self.sdr = int("".join(map(str, self.in_bits)), 2)
+                self.in_bits = []
+                self.raise_flag(IRQ_SERIAL)
+
+        if rising & IN_TOD:
+            self.tod_pulses += 1
+            if self.tod_pulses >= (5 if self.a.control & CRA_TOD_50HZ else 6):
+                self.tod_pulses = 0
+                if self.running:
+                    self.advance_clock()
+
+        if falling & IN_FLAG:
+            self.raise_flag(IRQ_FLAG)
+
+    def advance_clock(self):
+        tenths, seconds, minutes, hours = self.time
+        total = ((hours * 60 + minutes) * 60 + seconds) * 10 + tenths + 1
+        self.time = [total % 10, total // 10 % 60, total // 600 % 60, total // 36000 % 24]
+        if self.tod_bytes() == self.alarm:
+            self.raise_flag(IRQ_ALARM)
+
+    def port_output(self, control, bit, underflow):
+        if not control & CR_PB_ON:
+            return
+        if control & CR_TOGGLE:
+            if underflow:
+                self.pb_timer ^= bit
+        else:
+            self.pb_timer = (self.pb_timer | bit) if underflow else (self.pb_timer & ~bit)
+
+    def clock_out(self):
+        """Each timer A underflow is half a CNT cycle - a bit is put out as CNT falls, and is
+        gone once CNT rises again for the receiver to take it."""
+        if not self.out_bits:
+            return
+        self.half = not self.half
+        if self.half:
+            self.sp_out = bool(self.out_bits[0])
+            return
+        self.out_bits.pop(0)
+        if not self.out_bits:
+            self.raise_flag(IRQ_SERIAL)
+            if self.out_pending is not None:
+                self.out_bits = [(self.out_pending >> (7 - b)) & 1 for b in range(8)]
+                self.out_pending = None
+
+    @property
+    def cnt_out(self):
+        return not self.half
+
+    def peek(self, register):
+        if register in (PRA, DDRA, DDRB):
+            return {PRA: self.port[0], DDRA: self.ddr[0], DDRB: self.ddr[1]}[register]
+        if register == PRB:
+            return (self.port[1] & ~self.pb_mask | self.pb_timer & self.pb_mask) & 0xFF
+        if TAL <= register <= TBH:
+            timer = self.a if register < TBL else self.b
+            return timer.counter >> 8 if register & 1 else timer.counter & 0xFF
+        if TOD_10TH <= register <= TOD_HR:
+            return (self.latched or self.tod_bytes())[register - TOD_10TH]
+        if register == SDR:
+            return self.sdr
+        if register == ICR:
+            return self.flags | (0x80 if self.irq else 0)
+        return (self.a if register == CRA else self.b).control
+
+    def read(self, register, pins_a, pins_b):
+        if register == PRA:
+            return pins_a & ~self.ddr[0] | self.port[0] & self.ddr[0]
+        if register == PRB:
+            port = pins_b & ~self.ddr[1] | self.port[1] & self.ddr[1]
+            return (port & ~self.pb_mask | self.pb_timer & self.pb_mask) & 0xFF
+        if register == TOD_HR and self.latched is None:
+            self.latched = self.tod_bytes()
+        value = self.peek(register)
+        if register == TOD_10TH:
+            self.latched = None
+        if register == ICR:
+            self.flags, self.irq = 0, False
+        return value
+
+    def write(self, register, data):
+        if register in (PRA, PRB):
+            self.port[register - PRA] = data
+        elif register in (DDRA, DDRB):
+            self.ddr[register - DDRA] = data
+        elif TAL <= register <= TBH:
+            timer = self.a if register < TBL else self.b
+            if register & 1:
+                timer.latch = timer.latch & 0xFF | data << 8
+                if not timer.control & CR_START:
+                    timer.counter = timer.latch
+            else:
+                timer.latch = timer.latch & 0xFF00 | data
+        elif TOD_10TH <= register <= TOD_HR:
+            self.write_clock(register - TOD_10TH, data)
+        elif register == SDR:
+            self.sdr = data
+            if self.a.control & CRA_SERIAL_OUT:
+                if self.out_bits:
+                    self.out_pending = data
+                else:
+                    self.out_bits = [(data >> (7 - b)) & 1 for b in range(8)]
+        elif register == ICR:
+            self.mask = (self.mask | data & 0x1F) if data & 0x80 else (self.mask & ~data)
+            self.irq = bool(self.flags & self.mask)
+        else:
+            timer, bit = (self.a, 0x40) if register == CRA else (self.b, 0x80)
+            if data & CR_START and not timer.control & CR_START:
+                self.pb_timer |= bit
+            if data & CR_FORCE_LOAD:
+                timer.counter = timer.latch
+            if register == CRA and (data ^ timer.control) & CRA_SERIAL_OUT:
+                self.in_bits, self.out_bits, self.out_pending, self.half = [], [], None, False
+            timer.control = data & ~CR_FORCE_LOAD
+            self.pb_mask = self.pb_mask & ~bit | (bit if data & CR_PB_ON else 0)
+
+    def write_clock(self, index, data):
+        """Only valid BCD is written by the tests, so the fields can be kept as numbers."""
+        data &= (0x0F, 0x7F, 0x7F, 0x9F)[index]
+        if self.b.control & CRB_WRITE_ALARM:
+            self.alarm[index] = data
+            return
+        if index == 3:
+            hour12 = from_bcd(data & 0x1F)
+            self.time[3] = hour12 % 12 + (12 if data & 0x80 else 0)
+            self.running = False
+        else:
+            self.time[index] = from_bcd(data) if index else data
+            if index == 0:
+                self.running = True
+                self.tod_pulses = 0
+
+
+#------------------------------------------------------------------------------------------------
+# Directed checks - expected cycles worked out from the periods, not from the reference.
+#------------------------------------------------------------------------------------------------
+def underflows(chip, flag, cycles):
+    """Cycles (from 1) after which flag was newly set, acknowledging it each time."""
+    seen = []
+    for cycle in range(1, cycles + 1):
+        chip.tick()
+        if chip.peek(ICR) & flag:
+            seen.append(cycle)
+            chip.read(ICR)
+    return seen
+
+
+def test_timer_a(check, lib):
+    for latch in (0, 1, 2, 5, 100, 1000):
+        chip = Chip(lib)
+        chip.start_timer_a(latch)
+        cycles = (latch + 1) * 6
+        counts = []
+        seen = []
+        for cycle in range(1, cycles + 1):
+            chip.tick()
+            counts.append(chip.timer(TAL))
+            if chip.peek(ICR) & IRQ_TA:
+                seen.append(cycle)
+                chip.read(ICR)
+        check.check(seen == [(latch + 1) * k for k in range(1, 7)], "timer A $%04X continuous: underflows %s" % (latch, seen[:4]))
+        check.check(counts == [(latch - c) % (latch + 1) for c in range(1, cycles + 1)], "timer A $%04X counts down and reloads" % latch)
+
+        chip = Chip(lib)
+        chip.start_timer_a(latch, CR_ONE_SHOT)
+        seen = underflows(chip, IRQ_TA, (latch + 1) * 4)
+        check.check(seen == [latch + 1], "timer A $%04X one shot: underflows %s" % (latch, seen))
+        check.check(not chip.peek(CRA) & CR_START and chip.timer(TAL) == latch, "timer A $%04X one shot stops reloaded" % latch)
+
+
+def test_timer_b(check, lib):
+    for latch in (0, 3, 77):
+        chip = Chip(lib)
+        chip.write(TBL, latch)
+        chip.write(TBH, 0)
+        chip.write(CRB, CR_START | CR_FORCE_LOAD)
+        seen = underflows(chip, IRQ_TB, (latch + 1) * 5)
+        check.check(seen == [(latch + 1) * k for k in range(1, 6)], "timer B $%04X on phase 2: underflows %s" % (latch, seen))
+
+    for latch_a, latch_b in ((0, 0), (4, 2), (9, 6), (1, 30)):
+        chip = Chip(lib)
+        chip.write(TBL, latch_b)
+        chip.write(TBH, 0)
+        chip.write(CRB, CR_START | CR_FORCE_LOAD | TB_TIMERA)
+        chip.start_timer_a(latch_a)
+        period = (latch_a + 1) * (latch_b + 1)
+        seen = underflows(chip, IRQ_TB, period * 4)
+        check.check(seen == [period * k for k in range(1, 5)], "timer B $%02X counting A $%02X underflows: %s" % (latch_b, latch_a, seen))
+
+    # Counting A underflows only while CNT is high - held low, B never moves.
+    for level, expected in ((IN_CNT, [12, 24]), (0, [])):
+        chip = Chip(lib)
+        chip.inputs = level
+        chip.write(TBL, 2)
+        chip.write(TBH, 0)
+        chip.write(CRB, CR_START | CR_FORCE_LOAD | TB_TIMERA_CNT)
+        chip.start_timer_a(3)
+        seen = underflows(chip, IRQ_TB, 24)
+        check.check(seen == expected, "timer B on A with CNT %s: underflows %s" % ("high" if level else "low", seen))
+
+    # Counting CNT rising edges, one every 4 cycles.
+    chip = Chip(lib)
+    chip.write(TBL, 2)
+    chip.write(TBH, 0)
+    chip.write(CRB, CR_START | CR_FORCE_LOAD | TB_CNT)
+    seen = []
+    for cycle in range(1, 49):
+        chip.inputs = IN_CNT if cycle % 4 == 0 else 0
+        chip.tick()
+        if chip.read(ICR) & IRQ_TB:
+            seen.append(cycle)
+    check.check(seen == [12, 24, 36, 48], "timer B on CNT edges: underflows %s" % seen)
+
+
+def test_force_load(check, lib):
+    chip = Chip(lib)
+    chip.start_timer_a(1000)
+    chip.tick(10)
+    check.check(chip.timer(TAL) == 990, "timer A runs from the latch")
+
+    # A running timer is not reloaded by the latch writes...
+    chip.write(TAL, 50)
+    chip.write(TAH, 0)
+    chip.tick()
+    check.check(chip.timer(TAL) == 989, "latch writes leave a running timer alone")
+
+    # ...until force load, which takes effect at once and sets the period from there.
+    chip.write(CRA, CR_START | CR_FORCE_LOAD)
+    check.check(chip.timer(TAL) == 50 and not chip.peek(CRA) & CR_FORCE_LOAD, "force load copies the latch, and reads back as 0")
+    seen = underflows(chip, IRQ_TA, 51 * 2)
+    check.check(seen == [51, 102], "after force load: underflows %s" % seen)
+
+    # A stopped timer loads as its high byte is written.
+    chip = Chip(lib)
+    chip.write(TAL, 0x34)
+    check.check(chip.timer(TAL) == 0xFFFF, "low byte alone only sets the latch")
+    chip.write(TAH, 0x12)
+    check.check(chip.timer(TAL) == 0x1234, "high byte loads a stopped timer")
+    chip.write(CRA, CR_START)
+    chip.tick(0x1234 + 1)
+    check.check(chip.peek(ICR) & IRQ_TA and chip.timer(TAL) == 0x1234, "started without force load: underflow after $1235")
+
+
+def set_clock(chip, hours, minutes, seconds, tenths, alarm=False):
+    chip.write(CRB, CRB_WRITE_ALARM if alarm else 0)
+    for register, value in ((TOD_HR, hours), (TOD_MIN, minutes), (TOD_SEC, seconds), (TOD_10TH, tenths)):
+        chip.write(register, value)
+    chip.write(CRB, 0)
+
+
+def tod_pulse(chip, count):
+    for _ in range(count):
+        chip.inputs |= IN_TOD
+        chip.tick()
+        chip.inputs &= ~IN_TOD
+        chip.tick()
+
+
+def read_clock(chip):
+    return [chip.read(r) for r in (TOD_HR, TOD_MIN, TOD_SEC, TOD_10TH)]
+
+
+def test_tod(check, lib):
+    # Each start, a tenth at a time, against the time worked out from a tenths count.
+    for start, hz, label in (((0x11, 0x59, 0x59, 8), 60, "11 AM to 12 PM"), ((0x92, 0x59, 0x59, 8), 50, "12 PM to 1 PM"),
+                             ((0x91, 0x59, 0x58, 0), 60, "11 PM to 12 AM"), ((0x12, 0x09, 0x59, 9), 50, "12:09 AM")):
+        chip = Chip(lib)
+        chip.write(CRA, CRA_TOD_50HZ if hz == 50 else 0)
+        set_clock(chip, *start)
+
+        hours24 = from_bcd(start[0] & 0x1F) % 12 + (12 if start[0] & 0x80 else 0)
+        total = ((hours24 * 60 + from_bcd(start[1])) * 60 + from_bcd(start[2])) * 10 + start[3]
+        pulses = 5 if hz == 50 else 6
+        wrong = 0
+        for step in range(1, 25):
+            tod_pulse(chip, pulses - 1)
+            early = read_clock(chip)
+            tod_pulse(chip, 1)
+            t = total + step
+            expected = clock_bytes(t % 10, t // 10 % 60, t // 600 % 60, t // 36000 % 24)
+            got = read_clock(chip)
+            wrong += got != [expected[3], expected[2], expected[1], expected[0]]
+            t -= 1
+            before = clock_bytes(t % 10, t // 10 % 60, t // 600 % 60, t // 36000 % 24)
+            wrong += early != [before[3], before[2], before[1], before[0]]
+        check.check(wrong == 0, "TOD %s at %d Hz: %d tenths wrong" % (label, hz, wrong))
+
+    # Writing hours stops the clock, writing tenths starts it again.
+    chip = Chip(lib)
+    set_clock(chip, 0x03, 0x00, 0x00, 0)
+    chip.write(TOD_HR, 0x04)
+    tod_pulse(chip, 60)
+    check.check(read_clock(chip) == [0x04, 0x00, 0x00, 0], "TOD stopped from the hours write")
+    chip.write(TOD_10TH, 0)
+    tod_pulse(chip, 60)
+    check.check(read_clock(chip) == [0x04, 0x00, 0x01, 0], "TOD running again from the tenths write")
+
+    # Reading hours freezes what is read until tenths, while the clock itself runs on.
+    chip = Chip(lib)
+    set_clock(chip, 0x05, 0x00, 0x59, 9)
+    check.check(chip.read(TOD_HR) == 0x05, "hours read")
+    tod_pulse(chip, 6 * 3)
+    frozen = [chip.read(TOD_MIN), chip.read(TOD_SEC), chip.read(TOD_10TH)]
+    check.check(frozen == [0x00, 0x59, 9], "minutes, seconds and tenths held from the hours read: %s" % frozen)
+    check.check(read_clock(chip) == [0x05, 0x01, 0x00, 2], "released by the tenths read")
+
+    # Alarm - the flag rises on the tenth it matches, AM/PM included, and not before.
+    chip = Chip(lib)
+    chip.write(ICR, 0x80 | IRQ_ALARM)
+    set_clock(chip, 0x11, 0x59, 0x59, 9)
+    set_clock(chip, 0x92, 0x00, 0x00, 1, alarm=True)
+    check.check(read_clock(chip) == [0x11, 0x59, 0x59, 9], "alarm writes leave the clock alone")
+    seen = []
+    for tenth in range(1, 5):
+        tod_pulse(chip, 6)
+        if chip.peek(ICR) & IRQ_ALARM:
+            seen.append(tenth)
+            check.check(chip.irq(), "alarm asserts #IRQ when enabled")
+            chip.read(ICR)
+    check.check(seen == [2], "alarm at 12:00:00.1 PM: tenths %s" % seen)
+
+    chip = Chip(lib)
+    set_clock(chip, 0x11, 0x59, 0x59, 9)
+    set_clock(chip, 0x12, 0x00, 0x00, 1, alarm=True)
+    tod_pulse(chip, 6 * 4)
+    check.check(not chip.peek(ICR) & IRQ_ALARM, "alarm for 12:00:00.1 AM not matched at PM")
+
+
+def test_serial(check, lib):
+    # Out - timer A at latch 3 underflows every 4 cycles, so CNT spends 4 each side and a bit
+    # goes every 8 cycles, MSB first. Taken as CNT rises, the flag with the last of them.
+    for data, second in ((0xA5, None), (0x3C, 0xC1)):
+        chip = Chip(lib)
+        chip.start_timer_a(3, CRA_SERIAL_OUT)
+        chip.write(SDR, data)
+        if second is not None:
+            chip.tick(5)
+            chip.write(SDR, second)
+        sent, flags, cnt = [], [], chip.cnt()
+        for cycle in range(1, 8 * 8 * 3):
+            chip.tick()
+            if chip.cnt() != cnt:
+                cnt = chip.cnt()
+                if cnt:
+                    sent.append(int(chip.sp()))
+            if chip.read(ICR) & IRQ_SERIAL:
+                flags.append(len(sent))
+        expected = [(data >> (7 - b)) & 1 for b in range(8)]
+        if second is not None:
+            expected += [(second >> (7 - b)) & 1 for b in range(8)]
+        check.check(sent == expected, "SDR out $%02X%s: bits %s" % (data, " then $%02X" % second if second else "", sent))
+        check.check(flags == list(range(8, len(expected) + 1, 8)), "SDR out flags after bits %s" % flags)
+        check.check(chip.cnt(), "CNT left high once idle")
+
+    # CNT toggles exactly on timer A underflows while shifting.
+    chip = Chip(lib)
+    chip.start_timer_a(6, CRA_SERIAL_OUT)
+    chip.write(SDR, 0xFF)
+    edges, cnt = [], chip.cnt()
+    for cycle in range(1, 7 * 16 + 1):
+        chip.tick()
+        if chip.cnt() != cnt:
+            cnt = chip.cnt()
+            edges.append(cycle)
+    check.check(edges == [7 * k for k in range(1, 17)], "CNT edges on every underflow: %s" % edges[:4])
+
+    # In - a bit on each CNT rising edge, MSB first, SDR and the flag on the eighth.
+    for data in (0x00, 0xFF, 0x5A, 0x81):
+        chip = Chip(lib)
+        chip.write(ICR, 0x80 | IRQ_SERIAL)
+        flagged = []
+        for bit in range(8):
+            level = IN_SP if (data >> (7 - bit)) & 1 else 0
+            chip.inputs = level
+            chip.tick(3)
+            chip.inputs = level | IN_CNT
+            chip.tick()
+            if chip.irq():
+                flagged.append(bit)
+        check.check(chip.peek(SDR) == data and flagged == [7], "SDR in $%02X: read $%02X, #IRQ after bits %s" % (data, chip.peek(SDR), flagged))
+
+    # One CIA's SP and CNT wired to another's - what goes out comes in.
+    sender, receiver = Chip(lib), Chip(lib)
+    sender.start_timer_a(2, CRA_SERIAL_OUT)
+    receiver.inputs = IN_CNT
+    receiver.tick()
+    receiver.write(CRA, CRA_SERIAL_OUT)         # CNT came up from reset as an edge - start afresh
+    receiver.write(CRA, 0)
+    received = []
+    for data in (0x00, 0xFF, 0x96, 0x01, 0x80):
+        sender.write(SDR, data)
+        for _ in range(3 * 16 + 2):
+            sender.tick()
+            receiver.inputs = (IN_CNT if sender.cnt() else 0) | (IN_SP if sender.sp() else 0)
+            receiver.tick()
+            if receiver.read(ICR) & IRQ_SERIAL:
+                received.append(receiver.peek(SDR))
+    check.check(received == [0x00, 0xFF, 0x96, 0x01, 0x80], "SDR out to SDR in: %s" % ["$%02X" % b for b in received])
+
+
+def test_icr(check, lib):
+    chip = Chip(lib)
+    chip.start_timer_a(9)
+
+    # Masked - the flag sets on the underflow cycle, #IRQ stays high (idle).
+    chip.tick(9)
+    check.check(chip.peek(ICR) == 0 and not chip.irq(), "nothing before the underflow")
+    chip.tick()
+    check.check(chip.peek(ICR) == IRQ_TA and not chip.irq(), "flag set but masked, no #IRQ")
+
+    # Enabling the source asserts #IRQ at once, with bit 7 set in the ICR.
+    chip.write(ICR, 0x80 | IRQ_TA | IRQ_TB)
+    check.check(chip.irq() and chip.peek(ICR) == 0x80 | IRQ_TA, "enabling a pending source asserts #IRQ")
+
+    # A read returns it all and clears it all; a second read sees nothing.
+    check.check(chip.read(ICR) == 0x81 and not chip.irq(), "read returns $81 and releases #IRQ")
+    check.check(chip.read(ICR) == 0, "read to clear")
+
+    # Enabled - #IRQ goes low on the very cycle of the next underflow.
+    chip.tick(9)
+    check.check(not chip.irq(), "#IRQ idle the cycle before the underflow")
+    chip.tick()
+    check.check(chip.irq() and chip.peek(ICR) == 0x81, "#IRQ on the underflow cycle")
+
+    # Clearing the mask releases #IRQ but keeps the flag to be read.
+    chip.write(ICR, IRQ_TA)
+    check.check(not chip.irq() and chip.peek(ICR) == IRQ_TA, "clearing the mask releases #IRQ, flag kept")
+    chip.write(ICR, 0x80 | 0x7F)
+    check.check(chip.irq(), "set with every bit only enables the five sources")
+
+    # FLAG interrupts on a falling edge only.
+    chip = Chip(lib)
+    chip.write(ICR, 0x80 | IRQ_FLAG)
+    chip.inputs = IN_FLAG
+    chip.tick(3)
+    check.check(not chip.irq(), "FLAG rising does nothing")
+    chip.inputs = 0
+    chip.tick()
+    check.check(chip.irq() and chip.read(ICR) == 0x80 | IRQ_FLAG, "FLAG falling edge sets the flag")
+    chip.tick(3)
+    check.check(chip.read(ICR) == 0, "FLAG held low sets it once")
+
+
+#------------------------------------------------------------------------------------------------
+# Random programs against the reference, compared after every cycle.
+#------------------------------------------------------------------------------------------------
+def random_write(rng):
+    register = rng.choice((PRA, PRB, DDRA, DDRB, TAL, TAH, TBL, TBH, TOD_10TH, TOD_SEC, TOD_MIN, TOD_HR, SDR, ICR, ICR, CRA, CRA, CRB, CRB))
+    if register in (TAH, TBH):
+        return register, rng.choice((0, 0, 0, rng.randrange(256)))
+    if register in (TAL, TBL):
+        return register, rng.randrange(32)
+    if register == TOD_10TH:
+        return register, rng.randrange(10)
+    if register in (TOD_SEC, TOD_MIN):
+        return register, bcd(rng.choice((rng.randrange(60), 59, 0)))
+    if register == TOD_HR:
+        return register, bcd(rng.randint(1, 12)) | rng.choice((0, 0x80))
+    if register == CRB:
+        return register, rng.randrange(256) & ~(CRB_WRITE_ALARM if rng.random() < 0.8 else 0)
+    return register, rng.randrange(256)
+
+
+def test_random(check, lib, rng, runs, cycles):
+    wrong = 0
+    for run in range(runs):
+        chip, reference = Chip(lib), Reference()
+        inputs, first = 0, None
+        for cycle in range(cycles):
+            roll = rng.random()
+            if roll < 0.05:
+                register, data = random_write(rng)
+                chip.write(register, data)
+                reference.write(register, data)
+                what = "write $%02X to %d" % (data, register)
+            elif roll < 0.10:
+                register = rng.randrange(16)
+                pins_a, pins_b = rng.randrange(256), rng.randrange(256)
+                got, want = chip.read(register, pins_a, pins_b), reference.read(register, pins_a, pins_b)
+                what = "read %d" % register
+                if got != want and first is None:
+                    first = "cycle %d: read %d gave $%02X, reference $%02X" % (cycle, register, got, want)
+            else:
+                what = "tick"
+            if rng.random() < 0.15:
+                inputs ^= 1 << rng.randrange(4)
+            chip.inputs = inputs
+            chip.tick()
+            reference.tick(inputs)
+
+            state = [chip.peek(r) for r in range(16)] + [chip.irq(), chip.sp(), chip.cnt()]
+            model = [reference.peek(r) for r in range(16)] + [reference.irq, reference.sp_out, reference.cnt_out]
+            if state != model and first is None:
+                diff = [i for i in range(len(state)) if state[i] != model[i]]
+                first = "cycle %d after %s: differs at %s - chip %s, reference %s" % (
+                    cycle, what, diff, [state[i] for i in diff], [model[i] for i in diff])
+            if first:
+                break
+        if first:
+            wrong += 1
+            if wrong <= 3:
+                print("run %d: %s" % (run, first))
+    check.check(wrong == 0, "random programs: %d of %d runs differ from the reference" % (wrong, runs))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Cycle by cycle checks of the 6526 CIA personality")
+    parser.add_argument("--cc", default=os.environ.get("CC", "cc"))
+    parser.add_argument("--seed", type=int, default=6526)
+    parser.add_argument("--runs", type=int, default=200, help="random programs against the reference")
+    parser.add_argument("--cycles", type=int, default=3000, help="cycles in each random program")
+    args = parser.parse_args()
+
+    check = Checker()
+    rng = random.Random(args.seed)
+
+    with tempfile.TemporaryDirectory() as work:
+        lib = build(work, args.cc)
+        test_timer_a(check, lib)
+        test_timer_b(check, lib)
+        test_force_load(check, lib)
+        test_tod(check, lib)
+        test_serial(check, lib)
+        test_icr(check, lib)
+        test_random(check, lib, rng, args.runs, args.cycles)
+
+    print("%d checks, %d failed: %s" % (check.checks, check.failures, "PASS" if check.failures == 0 else "FAIL"))
+    return 1 if check.failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+#------------------------------------------------------------------------------------------------
+#---- Clock Plan Test ... 2026 Dave Gaunt                                                     ----
+#------------------------------------------------------------------------------------------------
+#---- Builds Common/ClockPlan.c With CLOCK_PLAN_HOST_BUILD Once For Every Supported Clock And ----
+#---- Checks Its Numbers From First Principles - PLL Limits, VGA Timing, Flash Speed And The  ----
+#---- Bus Delays. An Unsupported Clock Must Not Build.                                        ----
+#------------------------------------------------------------------------------------------------
+import argparse
+import ctypes
+import os
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+COMMON = os.path.join(HERE, "..", "..", "Common")
+
+PLANS_MHZ = (150, 200, 250, 300)
+
+XOSC_HZ = 12000000
+PIXEL_HZ = 25175000
+RGB_CYCLES = 5                  # rgb.pio - pull, out [4], out [2], jmp is 10 cycles a pixel pair
+LINE_PIXELS = 800               # hsync.pio - 640 active, 16 front porch, 96 sync, 48 back porch
+FRAME_LINES = 524               # vsync.pio - 480 active, 10 front porch, 2 sync, 32 back porch
+TOLERANCE = 0.005
+FLASH_MAX_HZ = 100000000
+CORE_MILLIVOLTS = (1100, 1150, 1200, 1250, 1300)    # What the regulator gives without unlocking
+
+
+class ClockPlanTiming(ctypes.Structure):
+    _fields_ = [(name, ctypes.c_uint32) for name in (
+        "sys_hz", "vco_hz", "postdiv1", "postdiv2", "core_millivolts", "flash_divider",
+        "rgb_divider256", "sync_divider256", "pixel_hz", "delay40_cycles", "delay120_cycles")]
+
+
+def compile_plan(work, compiler, mhz):
+    library = os.path.join(work, "clock_plan_%d.so" % mhz)
+    command = [compiler, "-std=gnu11", "-O2", "-shared", "-fPIC", "-Wall", "-Werror", "-DCLOCK_PLAN_HOST_BUILD=1",
+               "-DCLOCK_PLAN_MHZ=%d" % mhz, "-I" + COMMON, os.path.join(COMMON, "ClockPlan.c"), "-o", library]
+    result = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    return library if result.returncode == 0 else None, result.stdout
+
+
+def load_plan(library):
+    lib = ctypes.CDLL(library)
+    lib.ClockPlan_GetRgbDivider.restype = ctypes.c_float
+    lib.ClockPlan_GetSyncDivider.restype = ctypes.c_float
+    timing = ClockPlanTiming()
+    lib.ClockPlan_GetTiming(ctypes.byref(timing))
+    return lib, timing
+
+
+def within(value, target):
+    return abs(value - target) <= target * TOLERANCE
+
+
+class Checker:
+    def __init__(self):
+        self.failures = 0
+        self.checks = 0
+
+    def check(self, condition, what):
+        self.checks += 1
+        if not condition:
+            self.failures += 1
+            print("FAIL: %s" % what)
+
+
+def check_plan(check, mhz, lib, timing):
+    name = "%d MHz" % mhz
+    sys_hz = mhz * 1000000
+
+    # PLL - the RP2350 datasheet limits.
+    check.check(timing.sys_hz == sys_hz, "%s system clock" % name)
+    check.check(750000000 <= timing.vco_hz <= 1600000000, "%s VCO range" % name)
+    check.check(timing.vco_hz % XOSC_HZ == 0 and 16 <= timing.vco_hz // XOSC_HZ <= 320, "%s feedback divider" % name)
+    check.check(1 <= timing.postdiv2 <= timing.postdiv1 <= 7, "%s post dividers" % name)
+    check.check(timing.vco_hz == sys_hz * timing.postdiv1 * timing.postdiv2, "%s PLL output" % name)
+    check.check(timing.core_millivolts in CORE_MILLIVOLTS, "%s core voltage" % name)
+
+    # Flash - slowed down with the clock.
+    check.check(sys_hz / timing.flash_divider <= FLASH_MAX_HZ, "%s flash clock" % name)
+
+    # VGA - both dividers from the same clock, in the PIO's 16.8 format.
+    check.check(256 <= timing.rgb_divider256 and timing.sync_divider256 < 65536 * 256, "%s divider range" % name)
+    check.check(timing.sync_divider256 == timing.rgb_divider256 * RGB_CYCLES, "%s sync divider is 5x rgb" % name)
+    check.check(lib.ClockPlan_GetRgbDivider() * 256 == timing.rgb_divider256, "%s rgb divider as float" % name)
+    check.check(lib.ClockPlan_GetSyncDivider() * 256 == timing.sync_divider256, "%s sync divider as float" % name)
+
+    pixel_hz = sys_hz * 256 / (timing.rgb_divider256 * RGB_CYCLES)
+    check.check(abs(timing.pixel_hz - pixel_hz) < 1, "%s reported pixel clock" % name)
+    check.check(within(pixel_hz, PIXEL_HZ), "%s pixel clock %.0f Hz" % (name, pixel_hz))
+    check.check(within(pixel_hz / LINE_PIXELS, 31469), "%s line rate" % name)
+    check.check(within(pixel_hz / (LINE_PIXELS * FRAME_LINES), 59.94), "%s frame rate" % name)
+
+    # Closest the 16.8 divider can get - one step either way is further off.
+    error = [abs(sys_hz * 256 / (d * RGB_CYCLES) - PIXEL_HZ) for d in (timing.rgb_divider256 + step for step in (-1, 0, 1))]
+    check.check(error[1] <= error[0] and error[1] <= error[2], "%s rgb divider is the closest" % name)
+
+    # Bus delays - at least the time asked for, and not a whole cycle more.
+    for ns, cycles in ((40, timing.delay40_cycles), (120, timing.delay120_cycles)):
+        check.check(cycles * 1e9 / sys_hz >= ns and (cycles - 1) * 1e9 / sys_hz < ns, "%s %d ns delay" % (name, ns))
+
+    return pixel_hz
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Check every clock plan's timing numbers")
+    parser.add_argument("--cc", default=os.environ.get("CC", "cc"))
+    args = parser.parse_args()
+
+    work = tempfile.mkdtemp(prefix="clock_plan_")
+    check = Checker()
+    last_millivolts = 0
+
+    print("  MHz     VCO  PD  mV  FLASH  RGB DIV   SYNC DIV   PIXEL HZ  40NS  120NS")
+    for mhz in PLANS_MHZ:
+        library, output = compile_plan(work, args.cc, mhz)
+        check.check(library is not None, "%d MHz builds" % mhz)
+        if library is None:
+            print(output)
+            continue
+
+        lib, timing = load_plan(library)
+        pixel_hz = check_plan(check, mhz, lib, timing)
+
+        check.check(timing.core_millivolts >= last_millivolts, "%d MHz core voltage never drops as the clock rises" % mhz)
+        last_millivolts = timing.core_millivolts
+
+        print("%5d %7d %2d/%d %4d %5d %8.4f %10.4f %10.0f %5d %6d" % (
+            mhz, timing.vco_hz // 1000000, timing.postdiv1, timing.postdiv2, timing.core_millivolts, timing.flash_divider,
+            timing.rgb_divider256 / 256, timing.sync_divider256 / 256, pixel_hz, timing.delay40_cycles, timing.delay120_cycles))
+
+    # Anything off the list stops the build rather than running with the wrong timing.
+    for mhz in (133, 175, 400):
+        library, output = compile_plan(work, args.cc, mhz)
+        check.check(library is None and "CLOCK_PLAN_MHZ Must Be" in output, "%d MHz refused" % mhz)
+
+    print("%d checks, %d failed: %s" % (check.checks, check.failures, "PASS" if check.failures == 0 else "FAIL"))
+    return 1 if check.failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,260 @@
+#!/usr/bin/env python3
+#------------------------------------------------------------------------------------------------
+#---- Logic Scope Test ... 2026 Dave Gaunt                                                    ----
+#------------------------------------------------------------------------------------------------
+#---- Builds Common/LogicScope.c With The Shared VGA Code For The Host, Feeds The Decimating  ----
+#---- Capture Random Port And #IRQ Samples As Core1 Would, And Checks Each Column Against A   ----
+#---- Python Reference. Then Rolls The Scope Batch By Batch, Lane By Lane, Comparing The      ----
+#---- Whole Frame Buffer With A Model Of The Traces - At Both The Full And Doubled Sizes.     ----
+#------------------------------------------------------------------------------------------------
+import argparse
+import ctypes
+import os
+import random
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+COMMON = os.path.join(HERE, "..", "..", "Common")
+
+SOURCES = ["VgaDisplay.c", "VgaSprites.c", "VicChars.c", "LogicScope.c"]
+BUILDS = [("full", [], (640, 480)), ("doubled", ["-DVGA_LINE_DOUBLED=1"], (320, 240))]
+
+CAPTURE_SIZE = 256  # LOGIC_CAPTURE_SIZE
+MAX_STEP = 32       # LOGIC_SCOPE_MAX_STEP
+LANES = 18          # LOGIC_SCOPE_LANES
+LANE_H = 7          # LOGIC_SCOPE_LANE_H
+LABEL_W = 32        # LOGIC_SCOPE_LABEL_W
+HEIGHT = LANES * LANE_H  # LOGIC_SCOPE_HEIGHT
+S02 = 1 << 17       # LOGIC_SCOPE_S02
+COLOURS = [3] * 8 + [6] * 8 + [1, 2]
+
+# LogicCapture_Add is inline for core1's loop, and the structures are easier reached through C.
+SHIM = r"""
+#include "LogicScope.h"
+
+void Shim_Add(LogicCapture* pCapture, const u32 uSample) { LogicCapture_Add(pCapture, uSample); }
+u32 Shim_Sample(const u32 uPorts, const u32 uIrq) { return LOGIC_SCOPE_SAMPLE(uPorts, uIrq); }
+u32 Shim_CaptureSize(void) { return sizeof(LogicCapture); }
+u32 Shim_ScopeSize(void) { return sizeof(LogicScope); }
+u32 Shim_Head(const LogicCapture* pCapture) { return pCapture->m_uHead; }
+u32 Shim_Value(const LogicCapture* pCapture, const u32 uColumn) { return pCapture->m_aValue[uColumn & (LOGIC_CAPTURE_SIZE - 1)]; }
+u32 Shim_Toggled(const LogicCapture* pCapture, const u32 uColumn) { return pCapture->m_aToggled[uColumn & (LOGIC_CAPTURE_SIZE - 1)]; }
+u32 Shim_Columns(const LogicScope* pScope) { return pScope->m_uColumns; }
+u32 Shim_Lost(const LogicScope* pScope) { return pScope->m_uLost; }
+u8* Shim_Screen(void) { return (u8*)aVGAScreenBuffer; }
+"""
+
+
+class Checker:
+    def __init__(self):
+        self.failures = 0
+        self.checks = 0
+
+    def check(self, condition, what):
+        self.checks += 1
+        if not condition:
+            self.failures += 1
+            print("FAIL: %s" % what)
+
+
+def build(work, name, defines, compiler):
+    shim = os.path.join(work, "shim.c")
+    with open(shim, "w") as f:
+        f.write(SHIM.replace('"LogicScope.h"', '"LogicScope.h"\n#include "VgaDisplay.h"'))
+
+    library = os.path.join(work, "scope_%s.so" % name)
+    subprocess.check_call([compiler, "-std=gnu11", "-O2", "-shared", "-fPIC", "-Wall", "-Werror", "-DVGA_HOST_BUILD=1", "-I" + COMMON]
+                          + defines + [os.path.join(COMMON, s) for s in SOURCES] + [shim, "-o", library])
+
+    lib = ctypes.CDLL(library)
+    lib.initVGA.argtypes = [ctypes.c_uint32] * 3
+    lib.LogicCapture_Init.argtypes = [ctypes.c_void_p, ctypes.c_uint32]
+    lib.LogicScope_Init.argtypes = [ctypes.c_void_p, ctypes.c_void_p] + [ctypes.c_uint32] * 3
+    lib.LogicScope_Begin.argtypes = [ctypes.c_void_p, ctypes.c_void_p]
+    lib.LogicScope_Begin.restype = ctypes.c_uint32
+    lib.LogicScope_Step.argtypes = [ctypes.c_void_p]
+    lib.LogicScope_Step.restype = ctypes.c_bool
+    lib.Shim_Add.argtypes = [ctypes.c_void_p, ctypes.c_uint32]
+    lib.Shim_Sample.argtypes = [ctypes.c_uint32] * 2
+    for getter in ("Shim_Head", "Shim_Columns", "Shim_Lost"):
+        getattr(lib, getter).argtypes = [ctypes.c_void_p]
+    for getter in ("Shim_Value", "Shim_Toggled"):
+        getattr(lib, getter).argtypes = [ctypes.c_void_p, ctypes.c_uint32]
+    lib.Shim_Screen.restype = ctypes.c_void_p
+    return lib
+
+
+def random_sample(rng, previous):
+    """Mostly steady pins with the odd one moving, as a real port looks cycle to cycle."""
+    sample = previous
+    for _ in range(rng.choice((0, 0, 0, 1, 2))):
+        sample ^= 1 << rng.randrange(17)
+    return sample
+
+
+def test_capture(check, lib, name, rng):
+    for decimate in (0, 1, 2, 7, 64):
+        capture = ctypes.create_string_buffer(lib.Shim_CaptureSize())
+        lib.LogicCapture_Init(capture, decimate)
+        every = max(decimate, 1)
+
+        samples = []
+        sample = rng.getrandbits(17)
+        for _ in range(every * 40 + every // 2):
+            sample = random_sample(rng, sample)
+            samples.append(sample)
+            lib.Shim_Add(capture, sample)
+
+        columns = len(samples) // every
+        check.check(lib.Shim_Head(capture) == columns, "%s decimate %d: %d columns" % (name, decimate, columns))
+
+        wrong = 0
+        for column in range(columns):
+            window = samples[column * every:(column + 1) * every]
+            anded, ored = 0xFFFFFFFF, 0
+            for value in window:
+                anded &= value
+                ored |= value
+            if lib.Shim_Value(capture, column) != window[-1] or lib.Shim_Toggled(capture, column) != ((anded ^ ored) | S02):
+                wrong += 1
+        check.check(wrong == 0, "%s decimate %d: %d columns wrong" % (name, decimate, wrong))
+
+    check.check(lib.Shim_Sample(0x1ABCD, 0) == 0xABCD and lib.Shim_Sample(0x12, 3) == 0x10012, "%s: sample packing" % name)
+
+
+class Model:
+    """The traces as they should be - one entry per column, oldest first, None for never drawn."""
+    def __init__(self, columns):
+        self.columns = [None] * columns
+        self.previous = None
+
+    def add(self, value, toggled):
+        if self.previous is None:
+            self.previous = value
+        self.columns = self.columns[1:] + [(value, toggled, self.previous)]
+        self.previous = value
+
+    def row_byte(self, column, lane, row):
+        if self.columns[column] is None or row in (0, LANE_H - 1):
+            return 0
+        value, toggled, previous = self.columns[column]
+        level = (value >> lane) & 1
+        moved = ((toggled >> lane) & 1) or level != ((previous >> lane) & 1)
+        lit = moved or row == (1 if level else LANE_H - 2)
+        return COLOURS[lane] * 9 if lit else 0
+
+
+def expected_screen(before, model, x, y, size):
+    width, _ = size
+    screen = bytearray(before)
+    trace = (x + LABEL_W) // 2
+    for lane in range(LANES):
+        for row in range(LANE_H):
+            start = (y + lane * LANE_H + row) * (width // 2) + trace
+            for column in range(len(model.columns)):
+                screen[start + column] = model.row_byte(column, lane, row)
+    return bytes(screen)
+
+
+def test_scope(check, lib, name, size, rng, batches):
+    width, height = size
+    screen_bytes = width * height // 2
+    lib.initVGA(0, 8, 9)
+    ctypes.memmove(lib.Shim_Screen(), bytes(rng.getrandbits(8) for _ in range(screen_bytes)), screen_bytes)
+
+    capture = ctypes.create_string_buffer(lib.Shim_CaptureSize())
+    scope = ctypes.create_string_buffer(lib.Shim_ScopeSize())
+    lib.LogicCapture_Init(capture, 1)
+
+    # Too near the edge to fit - nothing is drawn, and the capture is still kept up with.
+    before = ctypes.string_at(lib.Shim_Screen(), screen_bytes)
+    lib.LogicScope_Init(scope, capture, width - LABEL_W - 2, 0, 100)
+    for _ in range(CAPTURE_SIZE):
+        lib.Shim_Add(capture, 0)
+    check.check(lib.Shim_Columns(scope) == 0 and lib.LogicScope_Begin(scope, capture) == 0 and not lib.LogicScope_Step(scope)
+                and lib.Shim_Lost(scope) == 0 and ctypes.string_at(lib.Shim_Screen(), screen_bytes) == before,
+                "%s: a scope that does not fit draws nothing" % name)
+
+    lib.LogicScope_Init(scope, capture, 0, height - HEIGHT + 1, 100)
+    check.check(lib.Shim_Columns(scope) == 0, "%s: nor one that runs off the bottom" % name)
+
+    # An odd x is taken back to the byte, and the columns are cut to stay inside the border.
+    x, y = 9, 11
+    lib.LogicScope_Init(scope, capture, x, y, 10000)
+    x &= ~1
+    columns = lib.Shim_Columns(scope)
+    check.check(columns == (width - 1 - x - LABEL_W) // 2, "%s: %d columns fit" % (name, columns))
+
+    after_init = ctypes.string_at(lib.Shim_Screen(), screen_bytes)
+    model = Model(columns)
+    check.check(after_init == expected_screen(after_init, model, x, y, size), "%s: init clears the traces" % name)
+    check.check(not lib.LogicScope_Step(scope) and lib.LogicScope_Begin(scope, capture) == 0, "%s: nothing to draw yet" % name)
+
+    sample = rng.getrandbits(17)
+    tail = lib.Shim_Head(capture)
+    lost = 0
+    wrong = 0
+    for batch in range(batches):
+        count = rng.choice((0, 1, 2, 5, MAX_STEP, MAX_STEP + 9, CAPTURE_SIZE // 2 + 40))
+        for _ in range(count):
+            sample = random_sample(rng, sample)
+            lib.Shim_Add(capture, sample)
+
+        # What the scope should take - falling over half the ring behind skips ahead.
+        head = lib.Shim_Head(capture)
+        if head - tail > CAPTURE_SIZE // 2:
+            lost += head - tail - CAPTURE_SIZE // 2
+            tail = head - CAPTURE_SIZE // 2
+        expect = min(head - tail, MAX_STEP, columns)
+
+        before = ctypes.string_at(lib.Shim_Screen(), screen_bytes)
+        step = lib.LogicScope_Begin(scope, capture)
+        if step != expect or lib.Shim_Lost(scope) != lost:
+            print("%s batch %d: took %d of %d, lost %d of %d" % (name, batch, step, expect, lib.Shim_Lost(scope), lost))
+            wrong += 1
+            break
+
+        # A second begin is refused until every lane is drawn, and each lane is one call.
+        lanes = 0
+        while lib.LogicScope_Step(scope):
+            lanes += 1
+            if lanes == 1 and lib.LogicScope_Begin(scope, capture) != 0:
+                wrong += 1
+        if lanes != (LANES if step else 0):
+            wrong += 1
+
+        for column in range(tail, tail + step):
+            model.add(lib.Shim_Value(capture, column), lib.Shim_Toggled(capture, column))
+        tail += step
+
+        if ctypes.string_at(lib.Shim_Screen(), screen_bytes) != expected_screen(before, model, x, y, size):
+            wrong += 1
+
+    check.check(wrong == 0, "%s: %d of %d batches drawn wrongly" % (name, wrong, batches))
+    check.check(lost > 0, "%s: some batches fell behind" % name)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Logic scope capture and drawing against a Python reference")
+    parser.add_argument("--cc", default=os.environ.get("CC", "cc"))
+    parser.add_argument("--seed", type=int, default=6522)
+    parser.add_argument("--batches", type=int, default=60)
+    args = parser.parse_args()
+
+    check = Checker()
+    rng = random.Random(args.seed)
+
+    with tempfile.TemporaryDirectory() as work:
+        for name, defines, size in BUILDS:
+            lib = build(work, name, defines, args.cc)
+            test_capture(check, lib, name, rng)
+            test_scope(check, lib, name, size, rng, args.batches)
+
+    print("%d checks, %d failed: %s" % (check.checks, check.failures, "PASS" if check.failures == 0 else "FAIL"))
+    return 1 if check.failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
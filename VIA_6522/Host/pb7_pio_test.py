@@ -0,0 +1,442 @@
+#!/usr/bin/env python3
+#------------------------------------------------------------------------------------------------
+#---- Timer 1 PB7 PIO Test ... 2026 Dave Gaunt                                                ----
+#------------------------------------------------------------------------------------------------
+#---- Runs Source/via_pb7.pio Through A Model Of One PIO State Machine - Two Cycle Input      ----
+#---- Synchroniser, Delays, Stalls - With Core1 Restarting It As ViaPb7_Write Does, And       ----
+#---- Checks Each PB7 Edge Against The 6522 Datasheet At Every Clock Plan: Low From T1C-H's   ----
+#---- Write, Then N + 1.5 Cycles To The First Edge And N + 2 Between Edges, On Phase 2 High.  ----
+#---- Via6522_Tick Must Raise Timer 1's Flag At The Same Rate, Just Ahead Of Each Edge.       ----
+#------------------------------------------------------------------------------------------------
+import argparse
+import ctypes
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+COMMON = os.path.join(HERE, "..", "..", "Common")
+SOURCE = os.path.join(HERE, "..", "Source")
+PROGRAM = os.path.join(SOURCE, "via_pb7.pio")
+
+PLANS_MHZ = (150, 200, 250, 300)
+BUS_HZ = 1022727                # VIC-20 NTSC
+CORE1_DELAY = 40                # System clocks from phase 2 rising to core1 restarting the state machine
+MAX_LATE = 8                    # System clocks an edge may trail the phase 2 edge it was counted on
+WRITE_EDGES = ((-0.5, 0),)      # PB7 going low as core1 sees the write to T1C-H
+
+
+def load_program(path):
+    """The instructions and public labels of the first .program, in the subset via_pb7.pio uses."""
+    with open(path) as f:
+        text = f.read().split("% c-sdk")[0]
+    labels, public, lines = {}, {}, []
+    for line in text.splitlines():
+        line = line.split(";")[0].strip()
+        if not line or line.startswith(".program"):
+            continue
+        match = re.match(r"^(public\s+)?(\w+):$", line)
+        if match:
+            labels[match.group(2)] = len(lines)
+            if match.group(1):
+                public[match.group(2)] = len(lines)
+            continue
+        if line.startswith("."):
+            raise ValueError("directive not modelled: %s" % line)
+        delay = 0
+        match = re.match(r"^(.*?)\s*\[(\d+)\]$", line)
+        if match:
+            line, delay = match.group(1), int(match.group(2))
+        op, _, operands = line.partition(" ")
+        lines.append((op, re.split(r"[,\s]+", operands.strip()) if operands else [], delay))
+    if len(lines) > 32:
+        raise ValueError("%d instructions will not fit" % len(lines))
+    return [(op, operands, delay, labels) for op, operands, delay in lines], public
+
+
+class Bus:
+    """Phase 2 at BUS_HZ against the system clock - cycle c runs from the falling edge at the
+    start of its low half to the next one, so half cycle 2c is low and 2c + 1 is high."""
+
+    def __init__(self, sys_hz, bus_hz=BUS_HZ):
+        self.sys_hz = sys_hz
+        self.bus_hz = bus_hz
+
+    def half(self, clock):
+        return (clock * 2 * self.bus_hz) // self.sys_hz
+
+    def s02(self, clock):
+        return self.half(clock) & 1
+
+    def start_of_half(self, half):
+        return -((-half * self.sys_hz) // (2 * self.bus_hz))
+
+
+class StateMachine:
+    """Executes one instruction a clock. IN pin 0 is S02, seen two clocks late through the
+    synchroniser; the OUT and SET pins are PB7. Stalled waits and pulls skip straight to the
+    clock they can finish on, so an N of $FFFF costs no more than an N of 2."""
+
+    SYNC = 2
+
+    def __init__(self, program, bus):
+        self.program = program
+        self.bus = bus
+        self.enabled = False
+        self.pc = 0
+        self.x = self.y = self.osr = 0
+        self.fifo = []
+        self.pin = 1
+        self.edges = []
+        self.clock = 0
+
+    # What core1's register writes do, in the order ViaPb7_Write makes them.
+    def set_enabled(self, enabled):
+        self.enabled = enabled
+
+    def clear_fifos(self):
+        self.fifo = []
+
+    def put(self, value):
+        if len(self.fifo) < 4:
+            self.fifo.append(value & 0xFFFFFFFF)
+
+    def exec_jmp(self, target):
+        self.pc = target
+
+    def drive(self, level):
+        if level != self.pin:
+            self.pin = level
+            self.edges.append((self.clock, level))
+
+    def wait_clock(self, level):
+        """First clock, from now, on which the synchronised S02 reads level."""
+        seen = self.clock - self.SYNC
+        if self.bus.s02(seen) == level:
+            return self.clock
+        return self.bus.start_of_half(self.bus.half(seen) + 1) + self.SYNC
+
+    def step(self, until):
+        """Runs one instruction - returns False if stalled with nothing to do before until."""
+        op, operands, delay, labels = self.program[self.pc]
+        next_pc = (self.pc + 1) % len(self.program)
+
+        if op == "wait":
+            level, source, index = int(operands[0]), operands[1], int(operands[2])
+            assert (source, index) == ("pin", 0)
+            ready = self.wait_clock(level)
+            if ready >= until:
+                self.clock = until
+                return False
+            self.clock = ready
+        elif op == "pull":
+            if self.fifo:
+                self.osr = self.fifo.pop(0)
+            elif operands[0] == "block":
+                self.clock = until
+                return False
+            else:
+                self.osr = self.x
+        elif op == "set":
+            value = int(operands[1])
+            if operands[0] == "pins":
+                self.drive(value & 1)
+            else:
+                setattr(self, operands[0], value)
+        elif op == "mov":
+            destination, source = operands
+            value = getattr(self, source.lstrip("~!"))
+            if source[0] in "~!":
+                value = ~value & 0xFFFFFFFF
+            if destination == "pins":
+                self.drive(value & 1)
+            else:
+                setattr(self, destination, value)
+        elif op == "jmp":
+            condition, target = (operands[0], operands[1]) if len(operands) == 2 else (None, operands[0])
+            if condition is None and labels[target] == self.pc:
+                self.clock = until          # Parked on itself
+                return False
+            if condition == "x--":
+                taken = self.x != 0
+                self.x = (self.x - 1) & 0xFFFFFFFF
+            elif condition is None:
+                taken = True
+            else:
+                raise ValueError("jmp %s not modelled" % condition)
+            if taken:
+                next_pc = labels[target]
+        else:
+            raise ValueError("%s not modelled" % op)
+
+        self.pc = next_pc
+        self.clock += 1 + delay
+        return True
+
+    def run(self, until):
+        while self.clock < until:
+            if not self.enabled or not self.step(until):
+                self.clock = until
+
+
+class Pb7:
+    """ViaPb7_Write, with the state machine above standing in for the PIO."""
+
+    def __init__(self, program, public, bus):
+        self.sm = StateMachine(program, bus)
+        self.one_shot = public["one_shot"]
+        self.free_run = public["free_run"]
+        self.latch_low = 0
+        self.latch_high = 0
+        self.acr = 0
+        self.free_running = False
+        self.sm.exec_jmp(self.one_shot)
+        self.sm.set_enabled(True)
+
+    def reload(self):
+        if self.free_running:
+            self.sm.clear_fifos()
+            self.sm.put(((self.latch_high << 8) | self.latch_low) + 1)
+
+    def write(self, register, data):
+        if register in (4, 6):
+            self.latch_low = data
+            self.reload()
+        elif register == 5:
+            self.latch_high = data
+            self.free_running = bool(self.acr & 0x40)
+            self.sm.set_enabled(False)
+            self.sm.clear_fifos()
+            self.sm.put(((data << 8) | self.latch_low) + 1)
+            self.sm.exec_jmp(self.free_run if self.free_running else self.one_shot)
+            self.sm.set_enabled(True)
+        elif register == 7:
+            self.latch_high = data
+            self.reload()
+        elif register == 11:
+            self.acr = data
+
+
+class Run:
+    def __init__(self, program, public, sys_hz):
+        self.bus = Bus(sys_hz)
+        self.pb7 = Pb7(program, public, self.bus)
+
+    def to_cycle(self, cycle):
+        """Up to the falling edge that starts bus cycle."""
+        self.pb7.sm.run(self.bus.start_of_half(2 * cycle))
+
+    def write(self, cycle, register, data):
+        """A CPU write in bus cycle - core1 acts on it CORE1_DELAY clocks into phase 2."""
+        self.pb7.sm.run(self.bus.start_of_half(2 * cycle + 1) + CORE1_DELAY)
+        self.pb7.write(register, data)
+
+    def edges(self, since=0):
+        """(bus cycles from the falling edge at since, system clocks late, level) per PB7 edge."""
+        result = []
+        for clock, level in self.pb7.sm.edges:
+            half = self.bus.half(clock)
+            late = clock - self.bus.start_of_half(half)
+            result.append(((half - 2 * since) / 2, late, level))
+        return result
+
+    def clear_edges(self):
+        self.pb7.sm.edges = []
+
+
+class Checker:
+    def __init__(self):
+        self.failures = 0
+        self.checks = 0
+
+    def check(self, condition, what):
+        self.checks += 1
+        if not condition:
+            self.failures += 1
+            print("FAIL: %s" % what)
+
+
+def expect(check, what, edges, wanted):
+    """edges against [(cycles after the write's phase 2 ends, level)] - each on time. A low at -0.5
+    is core1 restarting the state machine during the write, so it has core1's slack rather than
+    the PIO's; every other edge is counted by the PIO and must land within MAX_LATE clocks."""
+    positions = [(cycles, level) for cycles, _, level in edges]
+    counted = [late for cycles, late, level in edges if (cycles, level) not in WRITE_EDGES]
+    written = [late for cycles, late, level in edges if (cycles, level) in WRITE_EDGES]
+    good = positions == wanted and all(late <= MAX_LATE for late in counted) and all(late <= CORE1_DELAY + MAX_LATE for late in written)
+    if not good:
+        print("  wanted %s" % wanted[:6])
+        print("  got    %s" % [(c, l, late) for c, late, l in edges][:6])
+    check.check(good, what)
+    return max(counted) if counted else 0
+
+
+def test_one_shot(check, program, public, mhz):
+    worst = 0
+    for latch in (0, 1, 2, 3, 10, 0xFF, 0x100, 0x4289, 0xFFFF):
+        run = Run(program, public, mhz * 1000000)
+        run.write(10, 11, 0x80)
+        run.write(12, 4, latch & 0xFF)
+        run.write(20, 5, latch >> 8)
+
+        # Low as core1 sees the write, high N + 1.5 cycles after the write's phase 2 ends - and no more.
+        run.to_cycle(21 + latch + 2 + 500)
+        edges = run.edges(since=21)
+        worst = max(worst, expect(check, edges=edges, wanted=[(-0.5, 0), (latch + 1.5, 1)],
+                                  what="%d MHz one shot N=$%04X" % (mhz, latch)))
+
+        # A second write to T1C-H starts it again.
+        run.clear_edges()
+        start = 21 + latch + 600
+        run.write(start, 5, latch >> 8)
+        run.to_cycle(start + latch + 600)
+        worst = max(worst, expect(check, edges=run.edges(since=start + 1), wanted=[(-0.5, 0), (latch + 1.5, 1)],
+                                  what="%d MHz one shot N=$%04X retriggered" % (mhz, latch)))
+    return worst
+
+
+def test_free_run(check, program, public, mhz):
+    worst = 0
+    for latch in (0, 1, 2, 7, 0xFF, 0x4289):
+        run = Run(program, public, mhz * 1000000)
+        run.write(5, 11, 0xC0)
+        run.write(7, 4, latch & 0xFF)
+        run.write(9, 5, latch >> 8)
+        run.to_cycle(10 + (latch + 2) * 8)
+        edges = run.edges(since=10)[:8]
+        wanted = [(-0.5, 0)] + [(latch + 1.5 + k * (latch + 2), (k + 1) & 1) for k in range(7)]
+        worst = max(worst, expect(check, edges=edges, wanted=wanted, what="%d MHz free running N=$%04X" % (mhz, latch)))
+
+    # A new latch written mid period - the period already counting is unchanged, the next one
+    # reloads from the new latch, and the square wave keeps its phase.
+    run = Run(program, public, mhz * 1000000)
+    run.write(5, 11, 0xC0)
+    run.write(7, 4, 100)
+    run.write(9, 5, 0)
+    run.write(10 + 150, 6, 40)
+    run.write(10 + 152, 7, 0)
+    run.to_cycle(10 + 800)
+    edges = run.edges(since=10)[:6]
+    first = 101.5 + 102
+    wanted = [(-0.5, 0), (101.5, 1), (first, 0), (first + 42, 1), (first + 84, 0), (first + 126, 1)]
+    worst = max(worst, expect(check, edges=edges, wanted=wanted, what="%d MHz free running latch change" % mhz))
+
+    # Five new latches in the first period, more than the FIFO holds - the next period reloads
+    # from the last one written.
+    run = Run(program, public, mhz * 1000000)
+    run.write(5, 11, 0xC0)
+    run.write(7, 4, 100)
+    run.write(9, 5, 0)
+    for index, latch in enumerate((40, 60, 80, 30, 20)):
+        run.write(10 + 50 + index * 8, 6, latch)
+        run.write(10 + 52 + index * 8, 7, 0)
+    run.to_cycle(10 + 800)
+    edges = run.edges(since=10)[:6]
+    wanted = [(-0.5, 0), (101.5, 1), (101.5 + 22, 0), (101.5 + 44, 1), (101.5 + 66, 0), (101.5 + 88, 1)]
+    worst = max(worst, expect(check, edges=edges, wanted=wanted, what="%d MHz free running several latch changes" % mhz))
+
+    # Only T1L-L written - the next period reloads with the new low byte under the old high byte.
+    run = Run(program, public, mhz * 1000000)
+    run.write(5, 11, 0xC0)
+    run.write(7, 4, 0x64)
+    run.write(9, 5, 0x01)
+    run.write(10 + 150, 6, 0x20)
+    run.to_cycle(10 + 2000)
+    edges = run.edges(since=10)[:5]
+    first = 0x164 + 1.5
+    wanted = [(-0.5, 0), (first, 1), (first + 0x122, 0), (first + 0x244, 1), (first + 0x366, 0)]
+    worst = max(worst, expect(check, edges=edges, wanted=wanted, what="%d MHz free running low latch byte change" % mhz))
+
+    # T1C-H mid period restarts the count and takes PB7 low again.
+    run = Run(program, public, mhz * 1000000)
+    run.write(5, 11, 0xC0)
+    run.write(7, 4, 50)
+    run.write(9, 5, 0)
+    run.to_cycle(10 + 60)
+    worst = max(worst, expect(check, edges=run.edges(since=10), wanted=[(-0.5, 0), (51.5, 1)],
+                              what="%d MHz free running before the restart" % mhz))
+    run.clear_edges()
+    run.write(10 + 60, 5, 0)
+    run.to_cycle(10 + 300)
+    wanted = [(-0.5, 0), (51.5, 1), (51.5 + 52, 0), (51.5 + 104, 1)]
+    worst = max(worst, expect(check, edges=run.edges(since=71)[:4], wanted=wanted, what="%d MHz free running restarted" % mhz))
+    return worst
+
+
+# Via6522_Tick As Core1 Calls It, Once Per S02 Falling Edge.
+TICK_C = r"""
+#include "Via6522.h"
+
+static ViaRegisters s_via;
+
+void Tick_Start(const u32 uLatch)
+{
+	Via6522_Reset(&s_via);
+	Via6522_Write(&s_via, VIA_REG_TIMER1_L, uLatch & 0xFF);
+	Via6522_Write(&s_via, VIA_REG_TIMER1_H, uLatch >> 8);
+}
+
+bool Tick_Tick(void) { return Via6522_Tick(&s_via); }
+"""
+
+
+def build_tick(work, compiler):
+    source = os.path.join(work, "tick.c")
+    with open(source, "w") as f:
+        f.write(TICK_C)
+    library = os.path.join(work, "tick.so")
+    subprocess.check_call([compiler, "-std=gnu11", "-O2", "-shared", "-fPIC", "-Wall", "-Werror", "-I" + COMMON, "-I" + SOURCE,
+                           os.path.join(SOURCE, "Via6522.c"), source, "-o", library])
+    lib = ctypes.CDLL(library)
+    lib.Tick_Start.argtypes = [ctypes.c_uint32]
+    lib.Tick_Tick.restype = ctypes.c_bool
+    return lib
+
+
+def test_irq_agrees(check, program, public, lib):
+    """Timer 1's flag from Via6522_Tick against the PIO's PB7 edges, free running - the same
+    period, and each flag within 2 cycles before its edge. Latches of $FFFE and $FFFF are left
+    out, the register model's counter runs them short (see Via6522_Timer1Period)."""
+    for latch in (0, 1, 2, 7, 0xFF, 0x4289, 0xFFFD):
+        run = Run(program, public, PLANS_MHZ[0] * 1000000)
+        run.write(5, 11, 0xC0)
+        run.write(7, 4, latch & 0xFF)
+        run.write(9, 5, latch >> 8)
+        run.to_cycle(10 + (latch + 2) * 4 + 4)
+        edges = [cycles for cycles, _, _ in run.edges(since=10) if cycles > 0][:4]
+
+        # Tick n is the falling edge n cycles after the write's phase 2 ends.
+        lib.Tick_Start(latch)
+        fires = [tick for tick in range(1, 10 + (latch + 2) * 4) if lib.Tick_Tick()][:4]
+
+        leads = [edge - fire for edge, fire in zip(edges, fires)]
+        check.check(len(fires) == 4 and len(edges) == 4 and len(set(leads)) == 1 and 0 < leads[0] <= 2,
+                    "N=$%04X timer 1 flags at %s, PB7 edges at %s" % (latch, fires, edges))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Timer 1 PB7 PIO program against the 6522 datasheet")
+    parser.add_argument("--program", default=PROGRAM)
+    parser.add_argument("--cc", default=os.environ.get("CC", "cc"))
+    args = parser.parse_args()
+
+    program, public = load_program(args.program)
+    check = Checker()
+
+    print("via_pb7.pio: %d instructions, one_shot at %d, free_run at %d" % (len(program), public["one_shot"], public["free_run"]))
+    for mhz in PLANS_MHZ:
+        worst = max(test_one_shot(check, program, public, mhz), test_free_run(check, program, public, mhz))
+        print("%d MHz: every edge on its phase 2 rising edge, at most %d system clocks (%.1f ns) after it"
+              % (mhz, worst, worst * 1000.0 / mhz))
+
+    with tempfile.TemporaryDirectory() as work:
+        test_irq_agrees(check, program, public, build_tick(work, args.cc))
+
+    print("%d checks, %d failed: %s" % (check.checks, check.failures, "PASS" if check.failures == 0 else "FAIL"))
+    return 1 if check.failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,401 @@
+#!/usr/bin/env python3
+#------------------------------------------------------------------------------------------------
+#---- Render Golden Image Test ... 2026 Dave Gaunt                                            ----
+#------------------------------------------------------------------------------------------------
+#---- Builds The Shared VGA Drawing Code With VGA_HOST_BUILD, Draws A Few Fixed Scenes Into   ----
+#---- The Frame Buffer And Compares What Would Be Displayed (Through The Line Table) Against  ----
+#---- The PNGs In golden/. Any Render Change Has To Stay Pixel Exact, Or Update The Goldens.  ----
+#---- Then Times Vic6560_RenderLine On The Busy VIC Screen In Scanlines Per Second.           ----
+#------------------------------------------------------------------------------------------------
+import argparse
+import ctypes
+import os
+import struct
+import subprocess
+import sys
+import tempfile
+import zlib
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+COMMON = os.path.join(HERE, "..", "..", "Common")
+SOURCE = os.path.join(HERE, "..", "Source")
+GOLDEN = os.path.join(HERE, "golden")
+
+# Frame buffer size as VgaDisplay.h has it - half each way with VGA_LINE_DOUBLED.
+FULL_SIZE = (640, 480)
+DOUBLED_SIZE = (320, 240)
+
+# The VGA line budget each rendered VIC line has to beat, as VIC_6560.c has it.
+VGA_LINE_RATE_HZ = 31469
+VIC_SCALE_Y = 2                 # Vic6560.h - each rendered line feeds two VGA lines
+BENCH_LINES = 240 * 64          # VIC_CANVAS_HEIGHT lines, 64 times over
+
+# Colour index bits as VgaDisplay.h has them - bit 0 red, bit 1 green, bit 2 blue.
+PALETTE = [((c & 1) * 255, (c >> 1 & 1) * 255, (c >> 2 & 1) * 255) for c in range(8)]
+
+SOURCES = ["VgaDisplay.c", "VgaSprites.c", "VgaConsole.c", "VicChars.c", "VgaSnapshot.c", "Vic6560.c"]
+
+# The scenes are C so they use the same CONSOLE_* and REGISTER_* macros as the firmware.
+SCENES_C = r"""
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "VgaDisplay.h"
+#include "VgaConsole.h"
+#include "VgaSnapshot.h"
+#include "RegisterPage.h"
+#include "Vic6560.h"
+
+void Scene_RegisterPage(void)
+{
+	initVGA(0, 8, 9);
+	RegisterPage_Draw();
+	VgaConsole_Init(CONSOLE_LEFT, CONSOLE_TOP, CONSOLE_WIDE, CONSOLE_HIGH, RGB_GREEN);
+
+	for (u32 uRegister=0; uRegister<16; ++uRegister)
+		RegisterPage_Update(uRegister, (u8)(uRegister * 0x11));
+
+#if REGISTER_PAGE_STATS
+	// One Register Left Untouched, The Rest Spread Over Every Heat Colour.
+	for (u32 uRegister=1; uRegister<16; ++uRegister)
+	{
+		u32 uRate = 1;
+		for (u32 uPower=0; uPower<(uRegister >> 1); ++uPower)
+			uRate *= 7;
+
+		RegisterPage_UpdateStats(uRegister, uRate, uRate / 3, uRegister * 12345);
+	}
+#endif
+}
+
+void Scene_Console(void)
+{
+	Scene_RegisterPage();
+
+	char szLine[128];
+	for (u32 uLine=0; uLine<(CONSOLE_HIGH + 7); ++uLine)
+	{
+		const int iLength = sprintf(szLine, "%-15s <- %02X\tLine %u\n", RegisterPage_GetName(uLine), uLine * 7, uLine);
+		VgaConsole_Write(szLine, iLength);
+	}
+
+	// Long Enough To Wrap, And Left Without A Newline.
+	for (u32 uChar=0; uChar<(CONSOLE_WIDE + 10); ++uChar)
+		szLine[uChar] = 'A' + (uChar % 26);
+
+	VgaConsole_Write(szLine, CONSOLE_WIDE + 10);
+	VgaConsole_Service(0xFFFFFFFF);
+}
+
+void Scene_Primitives(void)
+{
+	initVGA(0, 8, 9);
+
+	// Every Character In Every Colour, 64 To A Row.
+	for (u32 uColour=0; uColour<8; ++uColour)
+	{
+		for (u32 uChar=0; uChar<256; ++uChar)
+			DrawPetsciiChar((8 + (uChar & 63)) << 3, ((uColour * 4) + (uChar >> 6) + 1) << 3, (u8)uChar, (u8)(uColour ? uColour : RGB_WHITE));
+	}
+
+	// Odd And Even Edges, Single Pixel Widths And Heights.
+	u32 uColour = 1;
+	for (u32 uRect=0; uRect<24; ++uRect)
+	{
+		const u32 uX = 3 + (uRect * 26) + (uRect & 1);
+		const u32 uY = 280 + ((uRect * 7) % 41);
+		const u32 uWidth = 1 + ((uRect * 5) % 23);
+		const u32 uHeight = 1 + ((uRect * 11) % 37);
+
+		FilledRectangle(uX, uY, uWidth, uHeight, uColour);
+		uColour = (uColour % 7) + 1;
+	}
+
+	DrawString(1, 58, "THE QUICK BROWN FOX 0123456789 !\"#$%&'()*+,-./:;<=>?@[]", RGB_CYAN);
+}
+
+#if !VGA_LINE_DOUBLED
+void Scene_VicFrame(void)
+{
+	static Vic6560State s_vicState;
+
+	initVGA(0, 8, 9);
+	Vic6560_Init(&s_vicState, true);
+
+	// The Same Screen As The VIC_6560 Power On Benchmark.
+	for (u32 uCell=0; uCell<(22 * 23); ++uCell)
+	{
+		Vic6560_SnoopWrite(&s_vicState, 0x1E00 + uCell, (u8)uCell);
+		Vic6560_SnoopWrite(&s_vicState, VIC_CPU_COLOUR_RAM + 0x200 + uCell, (u8)uCell);
+	}
+
+	for (u32 uLine=0; uLine<VIC_CANVAS_HEIGHT; ++uLine)
+	{
+		u8* pLine = (u8*)&aVGAScreenBuffer[uLine * VIC_SCALE_Y * VGA_BYTES_PER_LINE];
+		Vic6560_RenderLine(&s_vicState, uLine, pLine);
+		memcpy(pLine + VGA_BYTES_PER_LINE, pLine, VGA_BYTES_PER_LINE);
+	}
+}
+
+// RunRenderBenchmark From VIC_6560.c - The Same Busy Screen, Rendered Off Screen. Nanoseconds.
+unsigned long long Bench_VicLines(const u32 uLines)
+{
+	static Vic6560State s_vicState;
+	static u8 aLine[VGA_BYTES_PER_LINE];
+	struct timespec start, end;
+
+	Vic6560_Init(&s_vicState, true);
+
+	for (u32 uCell=0; uCell<(22 * 23); ++uCell)
+	{
+		Vic6560_SnoopWrite(&s_vicState, 0x1E00 + uCell, (u8)uCell);
+		Vic6560_SnoopWrite(&s_vicState, VIC_CPU_COLOUR_RAM + 0x200 + uCell, (u8)uCell);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (u32 uLine=0; uLine<uLines; ++uLine)
+		Vic6560_RenderLine(&s_vicState, uLine % VIC_CANVAS_HEIGHT, aLine);
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	return ((end.tv_sec - start.tv_sec) * 1000000000ull) + end.tv_nsec - start.tv_nsec;
+}
+#endif
+
+void Scene_Doubled(void)
+{
+	initVGA(0, 8, 9);
+
+	// Every Character, 32 To A Row, Cycling Through The Colours.
+	for (u32 uChar=0; uChar<256; ++uChar)
+		DrawPetsciiChar((4 + (uChar & 31)) << 3, (1 + (uChar >> 5)) << 3, (u8)uChar, (u8)((uChar & 7) ? (uChar & 7) : RGB_WHITE));
+
+	// Odd And Even Edges, The Last Few Clipped At The Right.
+	u32 uColour = 1;
+	for (u32 uRect=0; uRect<16; ++uRect)
+	{
+		const u32 uX = 3 + (uRect * 21) + (uRect & 1);
+		const u32 uY = 84 + ((uRect * 7) % 41);
+		const u32 uWidth = 1 + ((uRect * 5) % 23);
+		const u32 uHeight = 1 + ((uRect * 11) % 37);
+
+		FilledRectangle(uX, uY, uWidth, uHeight, uColour);
+		uColour = (uColour % 7) + 1;
+	}
+
+	// Positions Laid Out For 640 x 480 - Dropped, Or Clipped At The Bottom Right.
+	FilledRectangle(400, 10, 20, 20, RGB_RED);
+	FilledRectangle(10, 300, 20, 20, RGB_RED);
+	FilledRectangle(300, 228, 40, 40, RGB_BLUE);
+	DrawPetsciiChar(600, 8, 1, RGB_RED);
+	DrawPetsciiChar(8, 400, 1, RGB_RED);
+	DrawPetsciiChar(316, 8, 1, RGB_RED);
+
+	// The Console Scrolls Through The Line Table, Which Now Has Two Scan Lines Per Entry.
+	VgaConsole_Init(2, 17, 36, 6, RGB_GREEN);
+
+	char szLine[64];
+	for (u32 uLine=0; uLine<9; ++uLine)
+	{
+		const int iLength = sprintf(szLine, "Line %u\t%02X\n", uLine, uLine * 7);
+		VgaConsole_Write(szLine, iLength);
+	}
+	VgaConsole_Service(0xFFFFFFFF);
+
+	DrawString(1, 24, "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 0123456789 !\"#$%&'()*+,-./:;<=>?@[]", RGB_CYAN);
+}
+"""
+
+# (golden name, extra defines, scene function)
+SCENES = [
+    ("via_register_page", [], "Scene_RegisterPage"),
+    ("cia_register_page", ["-DPERSONALITY_CIA_6526=1"], "Scene_RegisterPage"),
+    ("via_console_scrolled", [], "Scene_Console"),
+    ("primitives", [], "Scene_Primitives"),
+    ("vic_frame", [], "Scene_VicFrame"),
+    ("doubled", ["-DVGA_LINE_DOUBLED=1"], "Scene_Doubled"),
+]
+
+
+def build(work, defines, compiler):
+    scenes = os.path.join(work, "scenes.c")
+    with open(scenes, "w") as f:
+        f.write(SCENES_C)
+
+    library = os.path.join(work, "render%s.so" % "".join(d.replace("-D", "_").replace("=", "") for d in defines))
+    # The VIC canvas is scaled to exactly 640 pixels across, so it has no line doubled build.
+    names = [s for s in SOURCES if not (s == "Vic6560.c" and "-DVGA_LINE_DOUBLED=1" in defines)]
+    sources = [os.path.join(COMMON, s) for s in names] + [os.path.join(SOURCE, "RegisterPage.c"), scenes]
+    command = [compiler, "-std=gnu11", "-O2", "-shared", "-fPIC", "-Wall", "-Werror", "-Wno-unused-but-set-variable",
+               "-DVGA_HOST_BUILD=1", "-I" + COMMON, "-I" + SOURCE] + defines + sources + ["-o", library]
+    subprocess.check_call(command)
+
+    lib = ctypes.CDLL(library)
+    lib.VgaSnapshot_Crc.restype = ctypes.c_uint32
+    lib.VgaSnapshot_WritePpm.argtypes = [ctypes.c_char_p]
+    lib.VgaSnapshot_WritePpm.restype = ctypes.c_bool
+    lib.GetVGALineAddress.argtypes = [ctypes.c_uint32]
+    lib.GetVGALineAddress.restype = ctypes.c_void_p
+    if "-DVGA_LINE_DOUBLED=1" not in defines:
+        lib.Bench_VicLines.argtypes = [ctypes.c_uint32]
+        lib.Bench_VicLines.restype = ctypes.c_ulonglong
+    return lib
+
+
+def bench_vic(lib, lines):
+    """Best of three, so a busy host does not make the renderer look slow."""
+    elapsed = min(lib.Bench_VicLines(lines) for _ in range(3))
+    per_second = lines * 1e9 / max(elapsed, 1)
+    budget = VGA_LINE_RATE_HZ / VIC_SCALE_Y
+    print("vic render bench       %d lines, %.0f scanlines/s, %.0f ns a line, %.1fx the budget (%d Hz VGA / %d)"
+          % (lines, per_second, elapsed / lines, per_second / budget, VGA_LINE_RATE_HZ, VIC_SCALE_Y))
+
+
+def displayed_frame(lib, size):
+    """What the scan out would send - one colour index per frame buffer pixel, following the line table."""
+    width, height = size
+    pixels = bytearray(width * height)
+    for y in range(height):
+        line = ctypes.string_at(lib.GetVGALineAddress(y), width // 2)
+        row = pixels[y * width:(y + 1) * width]
+        row[0::2] = bytes(b & 7 for b in line)
+        row[1::2] = bytes(b >> 3 & 7 for b in line)
+        pixels[y * width:(y + 1) * width] = row
+    return pixels, b"".join(ctypes.string_at(lib.GetVGALineAddress(y), width // 2) for y in range(height))
+
+
+def png_chunk(kind, data):
+    return struct.pack(">I", len(data)) + kind + data + struct.pack(">I", zlib.crc32(kind + data))
+
+
+def write_png(path, pixels, size):
+    """8 bit palette PNG, filter 0 on every row."""
+    WIDTH, HEIGHT = size
+    raw = b"".join(b"\0" + bytes(pixels[y * WIDTH:(y + 1) * WIDTH]) for y in range(HEIGHT))
+    with open(path, "wb") as f:
+        f.write(b"\x89PNG\r\n\x1a\n")
+        f.write(png_chunk(b"IHDR", struct.pack(">IIBBBBB", WIDTH, HEIGHT, 8, 3, 0, 0, 0)))
+        f.write(png_chunk(b"PLTE", b"".join(bytes(c) for c in PALETTE)))
+        f.write(png_chunk(b"IDAT", zlib.compress(raw, 9)))
+        f.write(png_chunk(b"IEND", b""))
+
+
+def read_png(path, size):
+    """Reads back what write_png writes - 8 bit palette, any filter."""
+    WIDTH, HEIGHT = size
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("%s: not a PNG" % path)
+
+    offset, idat, header = 8, b"", None
+    while offset < len(data):
+        length, kind = struct.unpack(">I4s", data[offset:offset + 8])
+        body = data[offset + 8:offset + 8 + length]
+        if kind == b"IHDR":
+            header = struct.unpack(">IIBBBBB", body)
+        elif kind == b"IDAT":
+            idat += body
+        offset += 12 + length
+
+    if header[:4] != (WIDTH, HEIGHT, 8, 3) or header[6] != 0:
+        raise ValueError("%s: expected %dx%d 8 bit palette" % (path, WIDTH, HEIGHT))
+
+    raw = zlib.decompress(idat)
+    pixels = bytearray(WIDTH * HEIGHT)
+    previous = bytearray(WIDTH)
+    for y in range(HEIGHT):
+        kind = raw[y * (WIDTH + 1)]
+        row = bytearray(raw[y * (WIDTH + 1) + 1:(y + 1) * (WIDTH + 1)])
+        for x in range(WIDTH):
+            a = row[x - 1] if x else 0
+            b = previous[x]
+            c = previous[x - 1] if x else 0
+            if kind == 1:
+                row[x] = (row[x] + a) & 255
+            elif kind == 2:
+                row[x] = (row[x] + b) & 255
+            elif kind == 3:
+                row[x] = (row[x] + ((a + b) >> 1)) & 255
+            elif kind == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                row[x] = (row[x] + (a if pa <= pb and pa <= pc else b if pb <= pc else c)) & 255
+        pixels[y * WIDTH:(y + 1) * WIDTH] = row
+        previous = row
+    return pixels
+
+
+def diff_image(expected, actual):
+    """Matching pixels dimmed to blue where lit, differences in white."""
+    return bytearray(7 if e != a else (4 if a else 0) for e, a in zip(expected, actual))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare the VGA drawing code against golden images")
+    parser.add_argument("--update", action="store_true", help="rewrite the golden images from the current code")
+    parser.add_argument("--out", default=None, help="where to write actual/diff images on failure (default: a temp dir)")
+    parser.add_argument("--cc", default=os.environ.get("CC", "cc"))
+    parser.add_argument("--bench-lines", type=int, default=BENCH_LINES, help="VIC lines to render per timing run (0 = skip)")
+    args = parser.parse_args()
+
+    work = tempfile.mkdtemp(prefix="render_golden_")
+    out = args.out or work
+    os.makedirs(out, exist_ok=True)
+    os.makedirs(GOLDEN, exist_ok=True)
+
+    libraries = {}
+    failures = 0
+
+    for name, defines, scene in SCENES:
+        key = tuple(defines)
+        if key not in libraries:
+            libraries[key] = build(work, defines, args.cc)
+        lib = libraries[key]
+
+        size = DOUBLED_SIZE if "-DVGA_LINE_DOUBLED=1" in defines else FULL_SIZE
+        getattr(lib, scene)()
+        pixels, displayed = displayed_frame(lib, size)
+
+        # The firmware's frame hash has to be plain zlib CRC-32 over the displayed lines.
+        crc = lib.VgaSnapshot_Crc()
+        if crc != zlib.crc32(displayed):
+            print("%-22s CRC %08X, zlib says %08X: FAIL" % (name, crc, zlib.crc32(displayed)))
+            failures += 1
+            continue
+
+        # And the host PPM export has to show the same picture.
+        ppm = os.path.join(work, name + ".ppm")
+        lib.VgaSnapshot_WritePpm(ppm.encode())
+        with open(ppm, "rb") as f:
+            if f.read() != b"P6\n%d %d\n255\n" % size + b"".join(bytes(PALETTE[p]) for p in pixels):
+                print("%-22s PPM export does not match the frame: FAIL" % name)
+                failures += 1
+                continue
+
+        golden = os.path.join(GOLDEN, name + ".png")
+        if args.update or not os.path.exists(golden):
+            write_png(golden, pixels, size)
+            print("%-22s CRC %08X written" % (name, crc))
+            continue
+
+        expected = read_png(golden, size)
+        wrong = sum(e != a for e, a in zip(expected, pixels))
+        if wrong:
+            failures += 1
+            write_png(os.path.join(out, name + "_actual.png"), pixels, size)
+            write_png(os.path.join(out, name + "_diff.png"), diff_image(expected, pixels), size)
+            print("%-22s CRC %08X, %d pixels differ: FAIL (see %s)" % (name, crc, wrong, out))
+        else:
+            print("%-22s CRC %08X: PASS" % (name, crc))
+
+    if args.bench_lines > 0:
+        bench_vic(libraries[()], args.bench_lines)
+
+    print("%d scenes, %d failed: %s" % (len(SCENES), failures, "PASS" if failures == 0 else "FAIL"))
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,284 @@
+#!/usr/bin/env python3
+#------------------------------------------------------------------------------------------------
+#---- Sprite Overlay Test ... 2026 Dave Gaunt                                                 ----
+#------------------------------------------------------------------------------------------------
+#---- Builds Common/VgaSprites.c With The Shared VGA Code For The Host, Scatters Random       ----
+#---- Sprites Over A Random Frame Buffer And Compares Every Composited Line Against A Python  ----
+#---- Reference - Clipping At Every Edge, Odd And Even X, Keys, Overlap Order - At Both The   ----
+#---- Full And Line Doubled Resolutions. Then Checks The Console's Sprite Cursor.             ----
+#------------------------------------------------------------------------------------------------
+import argparse
+import ctypes
+import os
+import random
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+COMMON = os.path.join(HERE, "..", "..", "Common")
+
+SOURCES = ["VgaDisplay.c", "VgaSprites.c", "VgaConsole.c", "VicChars.c"]
+BUILDS = [("full", [], (640, 480)), ("doubled", ["-DVGA_LINE_DOUBLED=1"], (320, 240))]
+
+SPRITES = 8         # VGA_SPRITE_COUNT
+MAX_SIZE = 32       # VGA_SPRITE_MAX_SIZE
+
+
+class Checker:
+    def __init__(self):
+        self.failures = 0
+        self.checks = 0
+
+    def check(self, condition, what):
+        self.checks += 1
+        if not condition:
+            self.failures += 1
+            print("FAIL: %s" % what)
+
+
+def build(work, name, defines, compiler):
+    library = os.path.join(work, "sprites_%s.so" % name)
+    subprocess.check_call([compiler, "-std=gnu11", "-O2", "-shared", "-fPIC", "-Wall", "-Werror", "-DVGA_HOST_BUILD=1", "-I" + COMMON]
+                          + defines + [os.path.join(COMMON, s) for s in SOURCES] + ["-o", library])
+
+    lib = ctypes.CDLL(library)
+    lib.initVGA.argtypes = [ctypes.c_uint32] * 3
+    lib.GetVGALineAddress.argtypes = [ctypes.c_uint32]
+    lib.GetVGALineAddress.restype = ctypes.c_void_p
+    lib.SetVGALineAddress.argtypes = [ctypes.c_uint32, ctypes.c_void_p]
+    lib.VgaSprites_Set.argtypes = [ctypes.c_uint32, ctypes.c_void_p, ctypes.c_uint32, ctypes.c_uint32, ctypes.c_uint8]
+    lib.VgaSprites_Set.restype = ctypes.c_bool
+    lib.VgaSprites_Move.argtypes = [ctypes.c_uint32, ctypes.c_int, ctypes.c_int]
+    lib.VgaSprites_Show.argtypes = [ctypes.c_uint32, ctypes.c_bool]
+    lib.VgaSprites_AnyVisible.restype = ctypes.c_bool
+    lib.VgaSprites_GetLineMask.argtypes = [ctypes.c_uint32]
+    lib.VgaSprites_GetLineMask.restype = ctypes.c_uint32
+    lib.VgaSprites_ComposeLine.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_uint32]
+    lib.VgaConsole_Init.argtypes = [ctypes.c_uint32] * 4 + [ctypes.c_uint8]
+    lib.VgaConsole_EnableCursor.argtypes = [ctypes.c_uint32]
+    lib.VgaConsole_Write.argtypes = [ctypes.c_char_p, ctypes.c_int]
+    lib.VgaConsole_Service.argtypes = [ctypes.c_uint32]
+    return lib
+
+
+class Sprite:
+    def __init__(self, rng, size):
+        width, height = size
+        self.width = rng.randint(1, MAX_SIZE)
+        self.height = rng.randint(1, MAX_SIZE)
+        self.key = rng.randint(0, 7)
+        self.x = rng.randint(-MAX_SIZE - 8, width + 8)
+        self.y = rng.randint(-MAX_SIZE - 8, height + 8)
+        self.visible = rng.random() < 0.8
+
+        # Mostly the key so the frame buffer shows through, and the top two bits set to be ignored.
+        pixels = bytearray()
+        for _ in range(((self.width + 1) // 2) * self.height):
+            pair = [self.key if rng.random() < 0.4 else rng.randint(0, 7) for _ in range(2)]
+            pixels.append(pair[0] | (pair[1] << 3) | (rng.randint(0, 3) << 6))
+        self.pixels = bytes(pixels)
+        self.buffer = ctypes.create_string_buffer(self.pixels, len(self.pixels))
+
+    def covers(self, line):
+        return self.visible and 0 <= line - self.y < self.height
+
+    def pixel(self, line, column):
+        row = (line - self.y) * ((self.width + 1) // 2)
+        return (self.pixels[row + (column >> 1)] >> ((column & 1) * 3)) & 7
+
+
+def reference_line(source, line, sprites, width):
+    """What VgaSprites_ComposeLine should make of one frame buffer line."""
+    out = bytearray(source)
+    for sprite in sprites:
+        if not sprite.covers(line):
+            continue
+        for column in range(sprite.width):
+            x = sprite.x + column
+            colour = sprite.pixel(line, column)
+            if 0 <= x < width and colour != sprite.key:
+                shift = (x & 1) * 3
+                out[x >> 1] = (out[x >> 1] & ~(7 << shift) & 0xFF) | (colour << shift)
+    return bytes(out)
+
+
+def frame_buffer(lib, size):
+    width, height = size
+    return b"".join(ctypes.string_at(lib.GetVGALineAddress(y), width // 2) for y in range(height))
+
+
+def hide_all(lib):
+    for index in range(SPRITES):
+        lib.VgaSprites_Show(index, False)
+
+
+def test_api(check, lib, name):
+    hide_all(lib)
+    pixels = ctypes.create_string_buffer(b"\x3F" * 16 * 32)
+
+    check.check(not lib.VgaSprites_AnyVisible(), "%s: nothing showing" % name)
+    check.check(not lib.VgaSprites_Set(SPRITES, pixels, 8, 8, 0), "%s: sprite %d is out of range" % (name, SPRITES))
+    for width, height in ((0, 8), (8, 0), (MAX_SIZE + 1, 8), (8, MAX_SIZE + 1)):
+        check.check(not lib.VgaSprites_Set(0, pixels, width, height, 0), "%s: %dx%d is refused" % (name, width, height))
+    check.check(not lib.VgaSprites_Set(0, None, 8, 8, 0), "%s: no pixels is refused" % name)
+
+    check.check(lib.VgaSprites_Set(1, pixels, MAX_SIZE, MAX_SIZE, 0), "%s: %dx%d is accepted" % (name, MAX_SIZE, MAX_SIZE))
+    lib.VgaSprites_Move(1, 10, 20)
+    check.check(not lib.VgaSprites_AnyVisible(), "%s: set does not show" % name)
+    lib.VgaSprites_Show(1, True)
+    check.check(lib.VgaSprites_AnyVisible(), "%s: shown" % name)
+    check.check(lib.VgaSprites_GetLineMask(19) == 0 and lib.VgaSprites_GetLineMask(20) == 2 and lib.VgaSprites_GetLineMask(51) == 2
+                and lib.VgaSprites_GetLineMask(52) == 0, "%s: covers lines 20 - 51" % name)
+
+    # Setting a showing sprite hides it until it is shown again with the new pixels in place.
+    check.check(lib.VgaSprites_Set(1, pixels, 4, 4, 0) and not lib.VgaSprites_AnyVisible(), "%s: set hides" % name)
+    lib.VgaSprites_Show(SPRITES, True)
+    lib.VgaSprites_Move(SPRITES, 0, 0)
+    check.check(not lib.VgaSprites_AnyVisible(), "%s: out of range show and move are ignored" % name)
+
+
+def test_edges(check, lib, name, size):
+    """One sprite at every position where clipping starts or stops, odd and even widths."""
+    width, height = size
+    bytes_per_line = width // 2
+    guard = b"\xA5" * 8
+    line = ctypes.create_string_buffer(guard + bytes(bytes_per_line) + guard, bytes_per_line + 2 * len(guard))
+    inside = ctypes.addressof(line) + len(guard)
+
+    lib.initVGA(0, 8, 9)
+    hide_all(lib)
+    ctypes.memmove(lib.GetVGALineAddress(0), bytes((y * 37) & 0x3F for y in range(bytes_per_line * height)), bytes_per_line * height)
+
+    wrong = 0
+    for sprite_width in (1, 5, 6, MAX_SIZE):
+        sprite = Sprite(random.Random(sprite_width), size)
+        sprite.width, sprite.height, sprite.key, sprite.visible = sprite_width, 3, 0, True
+        sprite.pixels = bytes([0x3F]) * (((sprite_width + 1) // 2) * 3)
+        sprite.buffer = ctypes.create_string_buffer(sprite.pixels, len(sprite.pixels))
+        check.check(lib.VgaSprites_Set(0, sprite.buffer, sprite.width, sprite.height, sprite.key), "%s: set %d wide" % (name, sprite_width))
+        lib.VgaSprites_Show(0, True)
+
+        for x in sorted({-sprite_width, -sprite_width + 1, -1, 0, 1, width - sprite_width - 1, width - sprite_width,
+                         width - sprite_width + 1, width - 1, width}):
+            for y in (-3, -2, 0, 1, height - 3, height - 1, height):
+                sprite.x, sprite.y = x, y
+                lib.VgaSprites_Move(0, x, y)
+                for row in range(max(0, y - 1), min(height, y + 4)):
+                    ctypes.memset(inside, 0x40, bytes_per_line)
+                    lib.VgaSprites_ComposeLine(inside, lib.GetVGALineAddress(row), row)
+                    source = ctypes.string_at(lib.GetVGALineAddress(row), bytes_per_line)
+                    if line.raw != guard + reference_line(source, row, [sprite], width) + guard:
+                        wrong += 1
+
+    check.check(wrong == 0, "%s: %d edge lines wrong or written outside the line" % (name, wrong))
+
+
+def test_compose(check, lib, name, size, rng, frames):
+    width, height = size
+    bytes_per_line = width // 2
+    line = ctypes.create_string_buffer(bytes_per_line)
+    lines_checked = 0
+
+    for frame in range(frames):
+        lib.initVGA(0, 8, 9)
+        hide_all(lib)
+        ctypes.memmove(lib.GetVGALineAddress(0), bytes(rng.getrandbits(8) for _ in range(bytes_per_line * height)), bytes_per_line * height)
+
+        # Some lines pointed elsewhere, as the console scroll leaves them - the sprites follow the screen, not the buffer.
+        for _ in range(8):
+            lib.SetVGALineAddress(rng.randrange(height), lib.GetVGALineAddress(rng.randrange(height)))
+        sources = [ctypes.string_at(lib.GetVGALineAddress(y), bytes_per_line) for y in range(height)]
+
+        sprites = [Sprite(rng, size) for _ in range(SPRITES)]
+        # A few stacked on one spot, so the overlap order is tested every frame.
+        for sprite in sprites[5:]:
+            sprite.x, sprite.y = sprites[4].x + rng.randint(-4, 4), sprites[4].y + rng.randint(-4, 4)
+
+        for index, sprite in enumerate(sprites):
+            check.check(lib.VgaSprites_Set(index, sprite.buffer, sprite.width, sprite.height, sprite.key), "%s: set sprite %d" % (name, index))
+            lib.VgaSprites_Move(index, sprite.x, sprite.y)
+            lib.VgaSprites_Show(index, sprite.visible)
+
+        before = frame_buffer(lib, size)
+        wrong = 0
+        for y in range(height):
+            mask = sum(1 << i for i, sprite in enumerate(sprites) if sprite.covers(y))
+            if lib.VgaSprites_GetLineMask(y) != mask:
+                wrong += 1
+                continue
+
+            lib.VgaSprites_ComposeLine(line, lib.GetVGALineAddress(y), y)
+            if line.raw != reference_line(sources[y], y, sprites, width):
+                wrong += 1
+            lines_checked += 1
+
+        check.check(wrong == 0, "%s frame %d: %d lines composited wrongly" % (name, frame, wrong))
+        check.check(frame_buffer(lib, size) == before, "%s frame %d: the frame buffer is never touched" % (name, frame))
+        check.check(lib.VgaSprites_AnyVisible() == any(s.visible for s in sprites), "%s frame %d: any visible" % (name, frame))
+
+    return lines_checked
+
+
+def test_cursor(check, lib, name, size):
+    width, height = size
+    left, top, wide, high, colour = 2, 3, 10, 4, 2
+    line = ctypes.create_string_buffer(width // 2)
+
+    lib.initVGA(0, 8, 9)
+    hide_all(lib)
+    lib.VgaConsole_Init(left, top, wide, high, colour)
+    check.check(not lib.VgaSprites_AnyVisible(), "%s: no cursor until enabled" % name)
+    lib.VgaConsole_EnableCursor(6)
+
+    def cursor_at(column, row, what):
+        first = (top + row) * 8
+        check.check(all(lib.VgaSprites_GetLineMask(y) == (1 << 6) for y in range(first, first + 8))
+                    and lib.VgaSprites_GetLineMask(first - 1) == 0 and lib.VgaSprites_GetLineMask(first + 8) == 0,
+                    "%s: cursor on row %d %s" % (name, row, what))
+
+        lib.VgaSprites_ComposeLine(line, lib.GetVGALineAddress(first), first)
+        x = (left + column) * 4
+        check.check(line.raw[x:x + 4] == bytes([colour | colour << 3]) * 4 and line.raw[:x] == ctypes.string_at(lib.GetVGALineAddress(first), x),
+                    "%s: cursor in column %d %s" % (name, column, what))
+
+    cursor_at(0, 0, "when enabled")
+    for text, column, row, what in (("ABC", 3, 0, "after three characters"),
+                                    ("\nDE", 2, 1, "after a newline"),
+                                    ("FGHIJKLM", 9, 1, "held in the window waiting to wrap"),
+                                    ("R", 1, 2, "after the wrap"),
+                                    ("\n\n\nS", 1, 3, "on the bottom row after a scroll")):
+        lib.VgaConsole_Write(text.encode(), len(text))
+        lib.VgaConsole_Service(0xFFFFFFFF)
+        cursor_at(column, row, what)
+
+    # Re-initialising takes the cursor away again.
+    lib.VgaConsole_Init(left, top, wide, high, colour)
+    check.check(not lib.VgaSprites_AnyVisible(), "%s: init hides the cursor" % name)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Sprite overlay compositing against a Python reference")
+    parser.add_argument("--cc", default=os.environ.get("CC", "cc"))
+    parser.add_argument("--seed", type=int, default=6560)
+    parser.add_argument("--frames", type=int, default=12)
+    args = parser.parse_args()
+
+    check = Checker()
+    rng = random.Random(args.seed)
+
+    with tempfile.TemporaryDirectory() as work:
+        for name, defines, size in BUILDS:
+            lib = build(work, name, defines, args.cc)
+            test_api(check, lib, name)
+            test_edges(check, lib, name, size)
+            lines = test_compose(check, lib, name, size, rng, args.frames)
+            test_cursor(check, lib, name, size)
+            print("%s %dx%d: %d composited lines compared" % (name, size[0], size[1], lines))
+
+    print("%d checks, %d failed: %s" % (check.checks, check.failures, "PASS" if check.failures == 0 else "FAIL"))
+    return 1 if check.failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,842 @@
+#!/usr/bin/env python3
+#------------------------------------------------------------------------------------------------
+#---- 6502 + VIA System Simulator ... 2026 Dave Gaunt                                         ----
+#------------------------------------------------------------------------------------------------
+#---- Builds Common/Cpu6502.c And Source/Via6522.c Into A Little VIC-20 Shaped System - RAM,  ----
+#---- The VIA At $9120 With Its Writes Going Through Core0 As On The Board - And Runs Small   ----
+#---- ROMs Through It. Checks Opcode Timing, The IRQ Handler, The Jiffy Clock And Snapshots,  ----
+#---- Then Times How Fast It All Runs. --restore Replays A Snapshot Saved By usb_link.py.     ----
+#------------------------------------------------------------------------------------------------
+import argparse
+import ctypes
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+import usb_link
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+COMMON = os.path.join(HERE, "..", "..", "Common")
+SOURCE = os.path.join(HERE, "..", "Source")
+
+BUS_HZ = 1022727                # VIC-20 NTSC
+JIFFY_LATCH = 0x4289            # What the VIC-20 KERNAL loads for 60 Hz
+EVENT_NAMES = {1: "NMI", 2: "IRQ", 3: "JAMMED"}
+
+# The firmware's split, in miniature - core1 handles the ports and the timer on every S02
+# edge, everything else goes round the firmware's own ring (Source/ViaWriteRing.h) to core0,
+# which also drives #IRQ. Core0 is modelled as answering uLag bus cycles after core1 rings it.
+SYSTEM_C = r"""
+#include "Cpu6502.h"
+#include "ViaSnapshot.h"
+#include "ViaWriteRing.h"
+
+#define SIM_VIA_BASE		(0x9120)
+#define SIM_LOG_SIZE		(4096)
+
+typedef struct
+{
+	u32	m_uCycle;
+	u16	m_uPC;
+	u8	m_aBytes[3];
+	u8	m_uA;
+	u8	m_uX;
+	u8	m_uY;
+	u8	m_uP;
+	u8	m_uS;
+	u8	m_uEvent;
+	u8	m_uCycles;
+} SimTrace;
+
+static u8 s_aMemory[65536];
+static Cpu6502 s_cpu;
+static ViaRegisters s_via;
+static u32 s_uViaCycle;
+static u32 s_uLag;
+static u8 s_uPortAPins = 0xFF;
+
+// The Firmware's Ring, Plus When Core0 Gets To Each Slot.
+static ViaWriteRing s_ring;
+static u32 s_aRingDue[VIA_WRITE_RING_SIZE];
+static bool s_bIrqDue;
+static u32 s_uIrqDue;
+static bool s_bIrqPin;
+
+static u32 s_aLog[2][SIM_LOG_SIZE];
+static u32 s_aLogCount[2];
+
+static bool s_bSnapshotArmed;
+static bool s_bSnapshotTaken;
+static u32 s_uSnapshotMatch;
+static u32 s_uSnapshotMask;
+static ViaSnapshot s_snapshot;
+
+static inline void Log(const u32 uLog, const u32 uCycle)
+{
+	if (s_aLogCount[uLog] < SIM_LOG_SIZE)
+		s_aLog[uLog][s_aLogCount[uLog]] = uCycle;
+
+	++s_aLogCount[uLog];
+}
+
+// When Core0 Gets To The Oldest Queued Write - False With Nothing Queued.
+static inline bool OldestDue(u32* pDue)
+{
+	u32 uFirst;
+
+	if (0 == ViaWriteRing_GetQueued(&s_ring, &uFirst))
+		return false;
+
+	*pDue = s_aRingDue[uFirst];
+	return true;
+}
+
+// Core0 - ViaTask Empties The Ring, ProcessVIA Setting #IRQ After Each Write.
+static inline void Core0(void)
+{
+	bool bProcess = false;
+	ViaQueuedWrite write;
+	u32 uDue;
+
+	while (OldestDue(&uDue) && ((int)(s_uViaCycle - uDue) >= 0) && ViaWriteRing_Pop(&s_ring, &write))
+	{
+		Via6522_Write(&s_via, write.m_uOffset & 15, write.m_uData);
+		bProcess = true;
+	}
+
+	if (s_bIrqDue && ((int)(s_uViaCycle - s_uIrqDue) >= 0))
+	{
+		s_bIrqDue = false;
+		bProcess = true;
+	}
+
+	if (bProcess)
+		s_bIrqPin = Via6522_UpdateIrq(&s_via);
+}
+
+static inline void RingCore0(void)
+{
+	if (!s_bIrqDue)
+	{
+		s_bIrqDue = true;
+		s_uIrqDue = s_uViaCycle + s_uLag;
+	}
+
+	Core0();
+}
+
+// Core1 - Every S02 Falling Edge Up To uCycle, Jumping Straight To The Next Time Timer 1 Fires
+// Or Core0 Has Something Due - via_fuzz.py Checks Via6522_Advance Against Via6522_Tick.
+static inline void CatchUp(const u32 uCycle)
+{
+	while ((int)(uCycle - s_uViaCycle) > 0)
+	{
+		u32 uStep = uCycle - s_uViaCycle;
+		const u32 uFire = Via6522_CyclesToFire(&s_via);
+		u32 uDue;
+
+		if ((0 != uFire) && (uFire < uStep))
+			uStep = uFire;
+
+		if (OldestDue(&uDue) && ((int)(uDue - s_uViaCycle) > 0) && (uDue - s_uViaCycle < uStep))
+			uStep = uDue - s_uViaCycle;
+
+		if (s_bIrqDue && ((int)(s_uIrqDue - s_uViaCycle) > 0) && (s_uIrqDue - s_uViaCycle < uStep))
+			uStep = s_uIrqDue - s_uViaCycle;
+
+		s_uViaCycle += uStep;
+
+		if (Via6522_Advance(&s_via, uStep))
+		{
+			Log(0, s_uViaCycle);
+			RingCore0();
+		}
+		else if (s_bIrqDue || !ViaWriteRing_IsEmpty(&s_ring))
+			Core0();
+
+		s_via.m_u8PortA = s_uPortAPins;
+		s_via.m_u8PortA_NoHandshake = s_uPortAPins;
+	}
+}
+
+static inline void TakeSnapshot(ViaSnapshot* pSnapshot, const u32 uTrigger)
+{
+	u32 uFirstWrite;
+	const u32 uWrites = ViaWriteRing_GetQueued(&s_ring, &uFirstWrite);
+
+	ViaSnapshot_Take(pSnapshot, &s_via, s_ring.m_aSlot, uFirstWrite, uWrites, s_uViaCycle, uTrigger, s_bIrqPin ? VIA_SNAPSHOT_IRQ_LOW : 0);
+}
+
+// Straight After The Access, As Core1 Takes It - The Trigger Is Matched Against Its Trace Entry.
+static inline void CheckTrigger(const u32 uRegister, const u8 uData, const bool bWrite)
+{
+	const u32 uTraceEntry = uRegister | (bWrite ? (1 << 4) : 0) | (uData << 8) | (s_uViaCycle << 16);
+
+	if (!s_bSnapshotArmed || (0 != ((uTraceEntry ^ s_uSnapshotMatch) & s_uSnapshotMask)))
+		return;
+
+	TakeSnapshot(&s_snapshot, uTraceEntry);
+	s_bSnapshotArmed = false;
+	s_bSnapshotTaken = true;
+}
+
+static u8 ReadIo(void* pContext, const u16 uAddress)
+{
+	if ((uAddress & 0xFFF0) != SIM_VIA_BASE)
+		return 0xFF;
+
+	CatchUp(s_cpu.m_uCycles - 1);
+
+	const u32 uRegister = uAddress & 15;
+	const u8 uData = s_via.m_aReg[uRegister];
+
+	if (Via6522_ReadDone(&s_via, uRegister))
+		RingCore0();
+
+	CheckTrigger(uRegister, uData, false);
+	return uData;
+}
+
+static void WriteIo(void* pContext, const u16 uAddress, const u8 uData)
+{
+	if ((uAddress & 0xFFF0) != SIM_VIA_BASE)
+		return;
+
+	CatchUp(s_cpu.m_uCycles - 1);
+
+	const u32 uRegister = uAddress & 15;
+
+	switch (uRegister)
+	{
+		case VIA_REG_PORTB:		s_via.m_u8PortB ^= (s_via.m_u8PortB ^ uData) & s_via.m_uDataDirB;	break;
+		case VIA_REG_PORTA:		s_via.m_u8PortA ^= (s_via.m_u8PortA ^ uData) & s_via.m_uDataDirA;	break;
+		case VIA_REG_DATA_DIRB:	s_via.m_uDataDirB = uData;											break;
+		case VIA_REG_DATA_DIRA:	s_via.m_uDataDirA = uData;											break;
+
+		default:
+			s_aRingDue[ViaWriteRing_Push(&s_ring, (ViaQueuedWrite){ (u8)uRegister, uData })] = s_uViaCycle + s_uLag;
+			Core0();
+		break;
+	}
+
+	CheckTrigger(uRegister, uData, true);
+}
+
+u8* Sim_GetMemory(void) { return s_aMemory; }
+const Cpu6502* Sim_GetCpu(void) { return &s_cpu; }
+
+void Sim_Reset(const u32 uLag)
+{
+	Via6522_Reset(&s_via);
+	Cpu6502_Init(&s_cpu, s_aMemory, SIM_VIA_BASE >> 8, ReadIo, WriteIo, 0);
+	s_uViaCycle = s_cpu.m_uCycles;
+	s_uLag = uLag;
+	ViaWriteRing_Init(&s_ring);
+	s_bIrqDue = false;
+	s_bIrqPin = false;
+	s_aLogCount[0] = s_aLogCount[1] = 0;
+	s_bSnapshotArmed = s_bSnapshotTaken = false;
+}
+
+void Sim_ArmSnapshot(const u32 uMatch, const u32 uMask)
+{
+	s_bSnapshotArmed = true;
+	s_bSnapshotTaken = false;
+	s_uSnapshotMatch = uMatch;
+	s_uSnapshotMask = uMask;
+}
+
+bool Sim_GetSnapshot(ViaSnapshot* pSnapshot)
+{
+	if (s_bSnapshotTaken)
+		*pSnapshot = s_snapshot;
+
+	return s_bSnapshotTaken;
+}
+
+// Between Instructions, With Nothing To Say Which Access It Followed.
+void Sim_TakeSnapshot(ViaSnapshot* pSnapshot)
+{
+	TakeSnapshot(pSnapshot, 0);
+}
+
+// As RestoreSnapshot In VIA_6522.c - Core1 Takes The Registers, Requeues The Writes And Rings
+// Core0. The CPU, And So The Bus Cycle, Carry On From Wherever They Are.
+bool Sim_Restore(const ViaSnapshot* pSnapshot)
+{
+	if (!ViaSnapshot_IsValid(pSnapshot))
+		return false;
+
+	s_uViaCycle = s_cpu.m_uCycles;
+	s_via = pSnapshot->m_viaRegs;
+	ViaWriteRing_Init(&s_ring);
+
+	for (u32 uWrite=0; uWrite<pSnapshot->m_uWrites; ++uWrite)
+		s_aRingDue[ViaWriteRing_Push(&s_ring, ViaSnapshot_GetWrite(pSnapshot, uWrite))] = s_uViaCycle + s_uLag;
+
+	s_bIrqPin = (0 != (pSnapshot->m_uFlags & VIA_SNAPSHOT_IRQ_LOW));
+	s_bIrqDue = false;
+	RingCore0();
+	return true;
+}
+
+static inline u32 Step(void)
+{
+	const u32 uCycles = Cpu6502_Step(&s_cpu);
+
+	CatchUp(s_cpu.m_uCycles);
+	s_cpu.m_bIrq = s_bIrqPin;
+
+	if (CPU6502_EVENT_IRQ == s_cpu.m_uEvent)
+		Log(1, s_cpu.m_uCycles - uCycles);
+
+	return uCycles;
+}
+
+u32 Sim_Step(void) { return Step(); }
+
+// Runs For At Least uCycles Or Until An Undocumented Opcode - Returns Trace Entries Filled.
+u32 Sim_Run(const u32 uCycles, SimTrace* pTrace, const u32 uTraceMax)
+{
+	const u32 uEnd = s_cpu.m_uCycles + uCycles;
+	u32 uTraced = 0;
+
+	while ((int)(uEnd - s_cpu.m_uCycles) > 0)
+	{
+		if (uTraced < uTraceMax)
+		{
+			SimTrace* pEntry = &pTrace[uTraced++];
+			const u16 uPC = s_cpu.m_uPC;
+
+			pEntry->m_uCycle = s_cpu.m_uCycles;
+			pEntry->m_uPC = uPC;
+			pEntry->m_aBytes[0] = s_aMemory[uPC];
+			pEntry->m_aBytes[1] = s_aMemory[(u16)(uPC + 1)];
+			pEntry->m_aBytes[2] = s_aMemory[(u16)(uPC + 2)];
+			pEntry->m_uA = s_cpu.m_uA;
+			pEntry->m_uX = s_cpu.m_uX;
+			pEntry->m_uY = s_cpu.m_uY;
+			pEntry->m_uP = s_cpu.m_uP;
+			pEntry->m_uS = s_cpu.m_uS;
+			pEntry->m_uCycles = (u8)Step();
+			pEntry->m_uEvent = s_cpu.m_uEvent;
+		}
+		else if (0 == Step())
+			break;
+
+		if (CPU6502_EVENT_JAMMED == s_cpu.m_uEvent)
+			break;
+	}
+
+	return uTraced;
+}
+
+// Log 0 = Cycle Timer 1 Fired On, Log 1 = Cycle The CPU Started Taking The IRQ.
+u32 Sim_GetLog(const u32 uLog, u32* pCycles, const u32 uMax)
+{
+	const u32 uCount = (s_aLogCount[uLog] < SIM_LOG_SIZE) ? s_aLogCount[uLog] : SIM_LOG_SIZE;
+
+	for (u32 uEntry=0; (uEntry<uCount) && (uEntry<uMax); ++uEntry)
+		pCycles[uEntry] = s_aLog[uLog][uEntry];
+
+	return s_aLogCount[uLog];
+}
+"""
+
+
+class SimTrace(ctypes.Structure):
+    _fields_ = [("cycle", ctypes.c_uint32), ("pc", ctypes.c_uint16), ("bytes", ctypes.c_uint8 * 3),
+                ("a", ctypes.c_uint8), ("x", ctypes.c_uint8), ("y", ctypes.c_uint8), ("p", ctypes.c_uint8),
+                ("s", ctypes.c_uint8), ("event", ctypes.c_uint8), ("cycles", ctypes.c_uint8)]
+
+
+class Cpu6502(ctypes.Structure):
+    _fields_ = [("memory", ctypes.c_void_p), ("read_io", ctypes.c_void_p), ("write_io", ctypes.c_void_p),
+                ("context", ctypes.c_void_p), ("io_page", ctypes.c_uint32), ("pc", ctypes.c_uint16),
+                ("a", ctypes.c_uint8), ("x", ctypes.c_uint8), ("y", ctypes.c_uint8), ("s", ctypes.c_uint8),
+                ("p", ctypes.c_uint8), ("irq", ctypes.c_bool), ("nmi", ctypes.c_bool), ("event", ctypes.c_uint8),
+                ("cycles", ctypes.c_uint32), ("instructions", ctypes.c_uint32)]
+
+
+def build(work, compiler):
+    glue = os.path.join(work, "system_sim.c")
+    with open(glue, "w") as f:
+        f.write(SYSTEM_C)
+
+    library = os.path.join(work, "system_sim.so")
+    subprocess.check_call([compiler, "-std=gnu11", "-O2", "-shared", "-fPIC", "-Wall", "-Werror", "-Wno-unused-parameter",
+                           "-I" + COMMON, "-I" + SOURCE, os.path.join(COMMON, "Cpu6502.c"), os.path.join(COMMON, "Bus6502.c"),
+                           os.path.join(SOURCE, "Via6522.c"), glue, "-o", library])
+
+    lib = ctypes.CDLL(library)
+    lib.Sim_GetMemory.restype = ctypes.POINTER(ctypes.c_uint8 * 65536)
+    lib.Sim_GetCpu.restype = ctypes.POINTER(Cpu6502)
+    lib.Sim_Reset.argtypes = [ctypes.c_uint32]
+    lib.Sim_Step.restype = ctypes.c_uint32
+    lib.Sim_Run.restype = ctypes.c_uint32
+    lib.Sim_Run.argtypes = [ctypes.c_uint32, ctypes.POINTER(SimTrace), ctypes.c_uint32]
+    lib.Sim_GetLog.restype = ctypes.c_uint32
+    lib.Sim_GetLog.argtypes = [ctypes.c_uint32, ctypes.POINTER(ctypes.c_uint32), ctypes.c_uint32]
+    lib.Sim_ArmSnapshot.argtypes = [ctypes.c_uint32, ctypes.c_uint32]
+    lib.Sim_GetSnapshot.argtypes = [ctypes.c_char_p]
+    lib.Sim_GetSnapshot.restype = ctypes.c_bool
+    lib.Sim_TakeSnapshot.argtypes = [ctypes.c_char_p]
+    lib.Sim_Restore.argtypes = [ctypes.c_char_p]
+    lib.Sim_Restore.restype = ctypes.c_bool
+    lib.Bus6502_Disassemble.restype = ctypes.c_uint32
+    lib.Bus6502_Disassemble.argtypes = [ctypes.c_uint16, ctypes.c_char_p, ctypes.c_char_p]
+    lib.Bus6502_GetCycles.restype = ctypes.c_uint32
+    lib.Bus6502_GetCycles.argtypes = [ctypes.c_uint8, ctypes.POINTER(ctypes.c_bool)]
+    return lib
+
+
+def disassemble(lib, address, data):
+    text = ctypes.create_string_buffer(32)
+    lib.Bus6502_Disassemble(address, bytes(data), text)
+    return text.value.decode()
+
+
+class Assembler:
+    """Just enough to write the test ROMs - the opcode map is read back out of Bus6502.c's own
+    table, so the assembler, disassembler and decoder can not disagree. Operands are $hex,
+    #$hex or labels, which are always absolute."""
+
+    BRANCHES = ("BPL", "BMI", "BVC", "BVS", "BCC", "BCS", "BNE", "BEQ")
+
+    def __init__(self, lib):
+        self.opcodes = {}
+        for opcode in range(256):
+            text = disassemble(lib, 0x1000, (opcode, 0x12, 0x34))[16:]
+            if text.startswith(".BYTE"):
+                continue
+            mnemonic, _, operand = text.partition(" ")
+            if mnemonic in self.BRANCHES:
+                operand = "R"
+            operand = operand.replace("$3412", "W").replace("$12", "B")
+            self.opcodes.setdefault((mnemonic, operand), opcode)
+
+    def assemble(self, source, origin):
+        self.labels = {}
+        for final in (False, True):
+            image = {}
+            address = origin
+            for line in source.strip().splitlines():
+                line = line.split(";")[0].strip()
+                if not line:
+                    continue
+                if line.endswith(":"):
+                    self.labels[line[:-1]] = address
+                    continue
+                mnemonic, _, operand = line.partition(" ")
+                operand = operand.strip()
+                data = self._instruction(mnemonic.upper(), operand, address, final)
+                for offset, byte in enumerate(data):
+                    image[address + offset] = byte
+                address += len(data)
+        return image
+
+    def _value(self, text, final):
+        if text.startswith("$"):
+            return int(text[1:], 16)
+        return self.labels[text] if final else 0
+
+    def _instruction(self, mnemonic, operand, address, final):
+        if mnemonic in self.BRANCHES:
+            offset = self._value(operand, final) - (address + 2) if final else 0
+            if not -128 <= offset <= 127:
+                raise ValueError("branch out of range at $%04X" % address)
+            return [self.opcodes[(mnemonic, "R")], offset & 0xFF]
+
+        if operand in ("", "A"):
+            return [self.opcodes[(mnemonic, operand)]]
+
+        prefix, value, suffix = re.match(r"^(#|\()?(\$[0-9A-Fa-f]+|\w+)(.*)$", operand).groups("")
+        number = self._value(value, final)
+        wide = (prefix != "#") and (not value.startswith("$") or len(value) > 3)
+        data = [self.opcodes[(mnemonic, "%s%s%s" % (prefix, "W" if wide else "B", suffix))]]
+        return data + ([number & 0xFF, number >> 8] if wide else [number & 0xFF])
+
+
+class Checker:
+    def __init__(self):
+        self.failures = 0
+        self.checks = 0
+
+    def check(self, condition, what):
+        self.checks += 1
+        if not condition:
+            self.failures += 1
+            print("FAIL: %s" % what)
+
+
+def load(lib, image, reset, irq=None):
+    memory = lib.Sim_GetMemory().contents
+    ctypes.memset(memory, 0, 65536)
+    for address, byte in image.items():
+        memory[address] = byte
+    memory[0xFFFC], memory[0xFFFD] = reset & 0xFF, reset >> 8
+    if irq is not None:
+        memory[0xFFFE], memory[0xFFFF] = irq & 0xFF, irq >> 8
+    return memory
+
+
+def get_log(lib, log):
+    cycles = (ctypes.c_uint32 * 4096)()
+    count = lib.Sim_GetLog(log, cycles, 4096)
+    return list(cycles[:min(count, 4096)]), count
+
+
+#------------------------------------------------------------------------------------------------
+# Every documented opcode against Bus6502.c's table, which the bus decoder already relies on.
+#------------------------------------------------------------------------------------------------
+def test_opcode_timing(check, lib):
+    cpu = lib.Sim_GetCpu().contents
+    mismatches = 0
+    for opcode in range(256):
+        penalty = ctypes.c_bool()
+        expected = lib.Bus6502_GetCycles(opcode, ctypes.byref(penalty))
+        for cross in ((False, True) if penalty.value else (False,)):
+            # Operand $2010 / zero page $10 -> $2000 indexed by 0, or $20F0 / $F0 -> $20F0 indexed by $20.
+            low = 0xF0 if cross else 0x10
+            load(lib, {0x0400: opcode, 0x0401: low, 0x0402: 0x20, low: low & 0xF0, low + 1: 0x20}, 0x0400)
+            lib.Sim_Reset(0)
+            cpu.x = cpu.y = 0x20 if cross else 0x00
+            # Flags set so none of BPL, BVC, BCC Or BNE is taken, all clear for the other four.
+            cpu.p = 0xE3 if opcode in (0x10, 0x50, 0x90, 0xD0) else 0x20
+            cycles = lib.Sim_Step()
+            wanted = expected + (1 if cross else 0)
+            if cycles != wanted:
+                mismatches += 1
+                print("  $%02X%s: %d cycles, table says %d" % (opcode, " crossing" if cross else "", cycles, wanted))
+    check.check(mismatches == 0, "opcode cycles match Bus6502.c")
+
+    # Branches - one more taken, two more taken into another page.
+    for target, wanted in ((0x0410, 3), (0x03F0, 4)):
+        load(lib, {0x0400: 0xD0, 0x0401: (target - 0x0402) & 0xFF}, 0x0400)
+        lib.Sim_Reset(0)
+        cpu.p = 0x20
+        check.check(lib.Sim_Step() == wanted and cpu.pc == target, "BNE to $%04X takes %d" % (target, wanted))
+
+
+def run_program(lib, assembler, source, cycles=2000):
+    image = assembler.assemble(source, 0x0400)
+    load(lib, image, 0x0400)
+    lib.Sim_Reset(0)
+    lib.Sim_Run(cycles, None, 0)
+    return lib.Sim_GetMemory().contents, lib.Sim_GetCpu().contents
+
+
+def test_alu(check, lib, assembler):
+    # (A, operand, carry in, decimal, ADC or SBC, (A, C)) - NMOS results.
+    cases = [
+        (0x58, 0x46, 1, True, "ADC", (0x05, 1)), (0x12, 0x34, 0, True, "ADC", (0x46, 0)),
+        (0x99, 0x01, 0, True, "ADC", (0x00, 1)), (0x46, 0x12, 1, True, "SBC", (0x34, 1)),
+        (0x40, 0x13, 1, True, "SBC", (0x27, 1)), (0x00, 0x01, 1, True, "SBC", (0x99, 0)),
+        (0x50, 0x50, 0, False, "ADC", (0xA0, 0)), (0xFF, 0x01, 0, False, "ADC", (0x00, 1)),
+        (0x50, 0xB0, 1, False, "SBC", (0xA0, 0)), (0x00, 0x01, 1, False, "SBC", (0xFF, 0)),
+    ]
+    for a, operand, carry, decimal, op, (result, carry_out) in cases:
+        source = """
+            %s
+            %s
+            LDA #$%02X
+            %s #$%02X
+            STA $80
+            PHP
+            PLA
+            STA $81
+        stop:
+            JMP stop
+        """ % ("SED" if decimal else "CLD", "SEC" if carry else "CLC", a, op, operand)
+        memory, _ = run_program(lib, assembler, source, 200)
+        check.check((memory[0x80], memory[0x81] & 1) == (result, carry_out),
+                    "%s%s $%02X, $%02X = $%02X C=%d (got $%02X C=%d)" % (op, " decimal" if decimal else "", a, operand,
+                                                                       result, carry_out, memory[0x80], memory[0x81] & 1))
+
+
+#------------------------------------------------------------------------------------------------
+# A KERNAL style system - jiffy clock on timer 1, the handler reading IFR then T1L.
+#------------------------------------------------------------------------------------------------
+JIFFY_ROM = """
+reset:
+    SEI
+    LDX #$FF
+    TXS
+    LDA #$7F
+    STA $912E               ; IER - everything off
+    LDA #<latch
+    STA $9124               ; Timer 1 low latch
+    LDA #>latch
+    STA $9125               ; Timer 1 high - loads the counter and starts it
+    LDA #$C0
+    STA $912E               ; IER - timer 1 on
+    CLI
+main:
+    LDA $10                 ; Something to interrupt
+    CLC
+    ADC #$01
+    STA $10
+    INC $11
+    JMP main
+
+irq:
+    PHA
+    TXA
+    PHA
+    TYA
+    PHA
+    LDA $912D               ; IFR
+    STA $20
+    AND #$40
+    BNE timer
+    INC $23                 ; Entered without timer 1 flagged
+    JMP done
+timer:
+    INC $A2                 ; Jiffy clock, as the KERNAL keeps it
+    BNE ack
+    INC $A1
+    BNE ack
+    INC $A0
+ack:
+    LDA $9124               ; Reading T1L acknowledges timer 1
+done:
+    PLA
+    TAY
+    PLA
+    TAX
+    PLA
+    RTI
+"""
+
+
+def jiffy_image(assembler, latch):
+    source = JIFFY_ROM.replace("#<latch", "#$%02X" % (latch & 0xFF)).replace("#>latch", "#$%02X" % (latch >> 8))
+    image = assembler.assemble(source, 0xE000)
+    return image, assembler.labels["reset"], assembler.labels["irq"], assembler.labels
+
+
+def run_jiffy(lib, assembler, latch, lag, cycles):
+    image, reset, irq, labels = jiffy_image(assembler, latch)
+    load(lib, image, reset, irq)
+    lib.Sim_Reset(lag)
+    lib.Sim_Run(cycles, None, 0)
+    memory = lib.Sim_GetMemory().contents
+    jiffies = memory[0xA0] << 16 | memory[0xA1] << 8 | memory[0xA2]
+    fires, fire_count = get_log(lib, 0)
+    entries, entry_count = get_log(lib, 1)
+    return memory, jiffies, fires, fire_count, entries, entry_count, labels
+
+
+def print_trace(lib, trace, count):
+    print("     CYCLE  +CY  %-26s A  X  Y  P  SP" % "INSTRUCTION")
+    for entry in trace[:count]:
+        if entry.event in (1, 2):
+            text = "----  %s" % EVENT_NAMES[entry.event]
+        else:
+            text = disassemble(lib, entry.pc, entry.bytes)
+        print("%10d  %3d  %-26s %02X %02X %02X %02X %02X" % (entry.cycle, entry.cycles, text, entry.a, entry.x, entry.y,
+                                                             entry.p, entry.s))
+
+
+def test_jiffy(check, lib, assembler, show_trace):
+    seconds = 10
+    cycles = BUS_HZ * seconds
+    memory, jiffies, fires, fire_count, entries, entry_count, labels = run_jiffy(lib, assembler, JIFFY_LATCH, 0, cycles)
+
+    check.check(fire_count > 0, "timer 1 fires")
+    check.check(jiffies == fire_count or jiffies == fire_count - 1, "one jiffy per timer 1 interrupt (%d jiffies, %d fires)" % (jiffies, fire_count))
+    check.check(entry_count == jiffies or entry_count == jiffies + 1, "one IRQ per jiffy (%d taken)" % entry_count)
+    check.check(memory[0x23] == 0, "no IRQ without timer 1 flagged")
+
+    periods = set(b - a for a, b in zip(fires, fires[1:]))
+    check.check(len(periods) == 1, "timer 1 period steady")
+    period = periods.pop() if len(periods) == 1 else 0
+
+    # N + 2 cycles between interrupts, as on a real 6522 and as PB7 toggles.
+    check.check(period == JIFFY_LATCH + 2, "free running period is the latch + 2 (%d)" % period)
+    ppm = (JIFFY_LATCH + 2 - period) * 1e6 / (JIFFY_LATCH + 2)
+    print("jiffy: latch $%04X, period %d cycles, %.4f Hz, a real 6522 gives %d cycles, %.4f Hz - %+.0f ppm, %+.1f s/day"
+          % (JIFFY_LATCH, period, BUS_HZ / period, JIFFY_LATCH + 2, BUS_HZ / (JIFFY_LATCH + 2), ppm, ppm * 86400 / 1e6))
+
+    # IRQ latency - #IRQ is seen between instructions, the longest in the main loop is 6 cycles.
+    latencies = []
+    for fire in fires:
+        taken = [entry for entry in entries if entry >= fire]
+        if taken:
+            latencies.append(taken[0] - fire)
+    check.check(latencies and max(latencies) <= 6, "IRQ taken within one instruction of timer 1 (max %d)" % max(latencies or [0]))
+    print("irq latency: %d-%d cycles after timer 1, %d interrupts over %d s" % (min(latencies), max(latencies), len(latencies), seconds))
+
+    # Trace the first interrupt from the instruction it arrived in through RTI.
+    trace = (SimTrace * 400)()
+    image, reset, irq, labels = jiffy_image(assembler, 0x0100)
+    load(lib, image, reset, irq)
+    lib.Sim_Reset(0)
+    filled = lib.Sim_Run(0x0180, trace, 400)
+    first = next((i for i in range(filled) if trace[i].event == 2), None)
+    check.check(first is not None, "trace shows the IRQ")
+    if first is not None:
+        rti = next(i for i in range(first, filled) if trace[i].bytes[0] == 0x40)
+        check.check(trace[rti + 1].cycle - trace[first].cycle == sum(trace[i].cycles for i in range(first, rti + 1)),
+                    "trace cycles add up")
+        check.check(trace[rti + 1].pc == trace[first].pc, "RTI returns to the interrupted instruction")
+        if show_trace:
+            print_trace(lib, trace[first - 2:], rti - first + 4)
+
+
+#------------------------------------------------------------------------------------------------
+# Core0 answering late - the T1L read clears the flag on core1 straight away, but #IRQ only goes
+# back up once core0 runs. Too late and the CPU is back in the handler before it has.
+#------------------------------------------------------------------------------------------------
+def test_core0_lag(check, lib, assembler):
+    cycles = BUS_HZ // 2
+    print("core0 lag  spurious IRQs  jiffies")
+    results = {}
+    for lag in (0, 1, 2, 4, 8, 16, 24, 32, 64):
+        memory, jiffies, _, fire_count, _, _, _ = run_jiffy(lib, assembler, JIFFY_LATCH, lag, cycles)
+        results[lag] = memory[0x23]
+        print("%9d  %13d  %7d" % (lag, memory[0x23], jiffies))
+        check.check(abs(jiffies - fire_count) <= 1, "lag %d keeps the jiffy count" % lag)
+    check.check(results[0] == 0 and results[1] == 0 and results[2] == 0, "no spurious IRQs while core0 keeps up")
+    check.check(results[64] > 0, "a slow core0 shows up as spurious IRQs")
+
+
+#------------------------------------------------------------------------------------------------
+# Snapshots - the sim takes them with the firmware's ViaSnapshot_Take, in usb_link.py's format.
+#------------------------------------------------------------------------------------------------
+def take_snapshot(lib):
+    data = ctypes.create_string_buffer(usb_link.Snapshot.LAYOUT.size)
+    lib.Sim_TakeSnapshot(data)
+    return data.raw
+
+
+def save_machine(lib):
+    """The CPU and RAM - not in a snapshot, the board has no way to see them."""
+    return bytes(lib.Sim_GetCpu().contents), bytes(lib.Sim_GetMemory().contents)
+
+
+def load_machine(lib, machine):
+    cpu, memory = machine
+    ctypes.memmove(lib.Sim_GetCpu(), cpu, len(cpu))
+    ctypes.memmove(lib.Sim_GetMemory(), memory, len(memory))
+
+
+def test_snapshot(check, lib, assembler):
+    # Stop mid run, snapshot, carry on - then go somewhere else entirely, put the CPU, RAM and
+    # snapshot back, and the rest of the run has to come out the same to the cycle.
+    image, reset, irq, _ = jiffy_image(assembler, 0x0421)
+    mismatches = 0
+    for stop in (5000, 17777, 123456, 250001):
+        load(lib, image, reset, irq)
+        lib.Sim_Reset(0)
+        lib.Sim_Run(stop, None, 0)
+        machine = save_machine(lib)
+        snapshot = take_snapshot(lib)
+        start = lib.Sim_GetCpu().contents.cycles
+        lib.Sim_Run(200000, None, 0)
+        wanted = [cycle for cycle in get_log(lib, 0)[0] if cycle > start], bytes(lib.Sim_GetMemory().contents)
+
+        lib.Sim_Reset(0)
+        lib.Sim_Run(stop // 3 + 999, None, 0)
+        load_machine(lib, machine)
+        check.check(lib.Sim_Restore(snapshot), "snapshot at cycle %d accepted" % stop)
+        lib.Sim_Run(200000, None, 0)
+        got = [cycle for cycle in get_log(lib, 0)[0] if cycle > start], bytes(lib.Sim_GetMemory().contents)
+        mismatches += wanted != got
+    check.check(mismatches == 0, "runs resumed from a snapshot match the uninterrupted ones")
+
+    # Triggered on the write that starts timer 1 with core0 behind, so it is still queued.
+    load(lib, image, reset, irq)
+    lib.Sim_Reset(16)
+    lib.Sim_ArmSnapshot(*usb_link.trigger(register=5, write=True))
+    lib.Sim_Run(100, None, 0)
+    data = ctypes.create_string_buffer(usb_link.Snapshot.LAYOUT.size)
+    check.check(lib.Sim_GetSnapshot(data), "write to timer 1 high triggers a snapshot")
+    taken = usb_link.Snapshot.unpack(data.raw)
+    check.check(usb_link.decode_trace(taken.trigger)[:3] == (5, True, 0x04), "trigger entry is the timer 1 high write")
+    check.check(taken.writes == [(14, 0x7F), (4, 0x21), (5, 0x04)], "the ROM's writes are still queued for core0")
+    check.check(taken.registers[5] == 0 and not taken.irq_low, "timer not started yet")
+
+    # Restored into an idle system, core0 catches up with the queued write and the timer runs.
+    load(lib, assembler.assemble(IDLE_ROM, 0x0400), 0x0400)
+    lib.Sim_Reset(16)
+    lib.Sim_Run(50, None, 0)
+    restored = lib.Sim_GetCpu().contents.cycles
+    check.check(lib.Sim_Restore(data.raw), "snapshot restored")
+    lib.Sim_Run(0x0421 * 5, None, 0)
+    fires, count = get_log(lib, 0)
+    check.check(count >= 4 and fires[0] == restored + 16 + 0x0421, "timer 1 starts once core0 has the queued writes")
+    check.check(set(b - a for a, b in zip(fires, fires[1:])) == {0x0421 + 2}, "and runs at the restored latch")
+    check.check(not lib.Sim_Restore(b"\0" * usb_link.Snapshot.LAYOUT.size), "junk snapshot refused")
+
+
+# Interrupts off and nothing touching the VIA, so a restored snapshot runs on by itself.
+IDLE_ROM = """
+    SEI
+idle:
+    JMP idle
+"""
+
+
+def replay(lib, assembler, path, cycles):
+    with open(path, "rb") as f:
+        snapshot = usb_link.Snapshot.unpack(f.read())
+    print(snapshot.describe())
+
+    load(lib, assembler.assemble(IDLE_ROM, 0x0400), 0x0400)
+    lib.Sim_Reset(0)
+    lib.Sim_Restore(snapshot.pack())
+    start = lib.Sim_GetCpu().contents.cycles
+    lib.Sim_Run(cycles, None, 0)
+    fires, count = get_log(lib, 0)
+    print("replayed %d cycles: timer 1 fired %d times%s" % (cycles, count, (", first %d cycles in" % (fires[0] - start)) if fires else ""))
+    end = usb_link.Snapshot.unpack(take_snapshot(lib))
+    print("\n".join(end.describe().splitlines()[1:]))
+
+
+def benchmark(check, lib, assembler, cycles):
+    image, reset, irq, _ = jiffy_image(assembler, JIFFY_LATCH)
+    load(lib, image, reset, irq)
+    lib.Sim_Reset(0)
+    start = time.perf_counter()
+    lib.Sim_Run(cycles, None, 0)
+    seconds = time.perf_counter() - start
+    cpu = lib.Sim_GetCpu().contents
+    mhz = cycles / seconds / 1e6
+    print("benchmark: %d cycles, %d instructions in %.3f s - %.1f M cycles/s, %.0fx a 1.02 MHz VIC-20"
+          % (cycles, cpu.instructions, seconds, mhz, mhz * 1e6 / BUS_HZ))
+    check.check(mhz * 1e6 > BUS_HZ, "faster than real time")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="6502 + VIA system simulation of the emulated VIA")
+    parser.add_argument("--cc", default=os.environ.get("CC", "cc"))
+    parser.add_argument("--cycles", type=int, default=100000000, help="benchmark length")
+    parser.add_argument("--trace", action="store_true", help="print the first interrupt cycle by cycle")
+    parser.add_argument("--restore", metavar="FILE", help="replay a snapshot from usb_link.py for --cycles instead of testing")
+    args = parser.parse_args()
+
+    lib = build(tempfile.mkdtemp(prefix="system_sim_"), args.cc)
+    assembler = Assembler(lib)
+    check = Checker()
+
+    if args.restore:
+        replay(lib, assembler, args.restore, min(args.cycles, BUS_HZ))
+        return 0
+
+    test_opcode_timing(check, lib)
+    test_alu(check, lib, assembler)
+    test_jiffy(check, lib, assembler, args.trace)
+    test_core0_lag(check, lib, assembler)
+    test_snapshot(check, lib, assembler)
+    benchmark(check, lib, assembler, args.cycles)
+
+    print("%d checks, %d failed: %s" % (check.checks, check.failures, "PASS" if check.failures == 0 else "FAIL"))
+    return 1 if check.failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,403 @@
+#!/usr/bin/env python3
+#------------------------------------------------------------------------------------------------
+#---- VIA 6522 USB Link ... 2026 Dave Gaunt                                                   ----
+#------------------------------------------------------------------------------------------------
+#---- Client For The Framed Commands In Source/RemoteLink.c - Import It, Or Run It As A CLI.  ----
+#---- Frames Are A5 5A, Command, Sequence, Length, Payload, CRC-16/CCITT - See UsbLink.h.     ----
+#------------------------------------------------------------------------------------------------
+import argparse
+import binascii
+import os
+import select
+import struct
+import sys
+import termios
+import time
+import tty
+
+SYNC = b"\xA5\x5A"
+HEADER = struct.Struct("<2sBBH")
+MAX_PAYLOAD = 512
+
+RESPONSE = 0x80
+COMMAND_ERROR = 0xFF
+
+PING = 0x01
+PEEK = 0x02
+POKE = 0x03
+PINS = 0x04
+STATS = 0x05
+CAPTURE = 0x06
+TRACE = 0x07
+SNAPSHOT = 0x08
+RESTORE = 0x09
+TRACE_DATA = 0x40
+
+TRACE_PER_FRAME = (MAX_PAYLOAD - 8) // 4
+PINS_PER_FRAME = MAX_PAYLOAD // 8
+TRACE_WRITE = 1 << 4
+
+ERRORS = {1: "CRC", 2: "unknown command", 3: "bad length", 4: "bad argument", 5: "unsupported", 6: "busy"}
+
+VIA_REGISTER_NAMES = ["Port B", "Port A", "Dir B", "Dir A", "Timer 1 L", "Timer 1 H", "T1 Latch L", "T1 Latch H",
+                      "Timer 2 L", "Timer 2 H", "Shift Reg", "Aux Ctrl", "Periph Ctrl", "Int Flags", "Int Enable",
+                      "PA No HShake"]
+
+
+class LinkError(Exception):
+    def __init__(self, command, code):
+        Exception.__init__(self, "command 0x%02X failed: %s" % (command, ERRORS.get(code, "error %d" % code)))
+        self.command = command
+        self.code = code
+
+
+def crc16(data):
+    return binascii.crc_hqx(data, 0xFFFF)
+
+
+def encode(command, sequence, payload=b""):
+    body = struct.pack("<BBH", command, sequence, len(payload)) + payload
+    return SYNC + body + struct.pack("<H", crc16(body))
+
+
+class FrameReader:
+    """Pulls whole frames out of a byte stream, skipping anything that does not check out."""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.crc_errors = 0
+
+    def feed(self, data):
+        self.buffer += data
+        frames = []
+        while True:
+            start = self.buffer.find(SYNC)
+            if start < 0:
+                del self.buffer[:-1]
+                return frames
+            del self.buffer[:start]
+            if len(self.buffer) < HEADER.size:
+                return frames
+            _, command, sequence, length = HEADER.unpack_from(self.buffer)
+            if length > MAX_PAYLOAD:
+                del self.buffer[:1]
+                continue
+            end = HEADER.size + length + 2
+            if len(self.buffer) < end:
+                return frames
+            body = bytes(self.buffer[2:HEADER.size + length])
+            crc, = struct.unpack_from("<H", self.buffer, HEADER.size + length)
+            if crc != crc16(body):
+                self.crc_errors += 1
+                del self.buffer[:1]
+                continue
+            frames.append((command, sequence, body[4:]))
+            del self.buffer[:end]
+
+
+class SerialPort:
+    """Raw Linux tty - the CDC ACM port shows up as /dev/ttyACM*."""
+
+    def __init__(self, path):
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        tty.setraw(self.fd)
+        attributes = termios.tcgetattr(self.fd)
+        attributes[6][termios.VMIN] = 0
+        attributes[6][termios.VTIME] = 0
+        termios.tcsetattr(self.fd, termios.TCSANOW, attributes)
+        termios.tcflush(self.fd, termios.TCIOFLUSH)
+
+    def write(self, data):
+        view = memoryview(data)
+        while view:
+            view = view[os.write(self.fd, view):]
+
+    def read(self, size, timeout):
+        ready, _, _ = select.select([self.fd], [], [], timeout)
+        return os.read(self.fd, size) if ready else b""
+
+    def close(self):
+        os.close(self.fd)
+
+
+class TraceFrame:
+    def __init__(self, payload):
+        self.dropped, self.first = struct.unpack_from("<II", payload)
+        self.entries = list(struct.unpack_from("<%dI" % ((len(payload) - 8) // 4), payload, 8))
+
+
+def decode_trace(entry):
+    """(register, is write, data, low 16 bits of the bus cycle)"""
+    return entry & 15, bool(entry & TRACE_WRITE), (entry >> 8) & 0xFF, entry >> 16
+
+
+def trigger(register=None, write=None, data=None):
+    """(match, mask) for a snapshot taken on the first access that fits - None matches anything."""
+    match = mask = 0
+    if register is not None:
+        match, mask = match | register, mask | 15
+    if write is not None:
+        match, mask = match | (TRACE_WRITE if write else 0), mask | TRACE_WRITE
+    if data is not None:
+        match, mask = match | (data << 8), mask | 0xFF00
+    return match, mask
+
+
+class Snapshot:
+    """ViaSnapshot from Source/ViaSnapshot.h - the 16 registers, the writes still queued for
+    core0 (oldest first), the bus cycle and the trace entry it was taken on."""
+
+    LAYOUT = struct.Struct("<IBBBBII16s32s")
+    MAGIC = 0x50414E53
+    VERSION = 1
+    IRQ_LOW = 1 << 0
+
+    def __init__(self, registers, writes=(), bus_cycle=0, trigger=0, irq_low=False):
+        self.registers = bytes(registers)
+        self.writes = list(writes)
+        self.bus_cycle = bus_cycle
+        self.trigger = trigger
+        self.irq_low = irq_low
+
+    @classmethod
+    def unpack(cls, data):
+        if len(data) != cls.LAYOUT.size:
+            raise ValueError("a snapshot is %d bytes, not %d" % (cls.LAYOUT.size, len(data)))
+        magic, version, flags, first, count, bus_cycle, trigger, registers, ring = cls.LAYOUT.unpack(data)
+        if magic != cls.MAGIC or version != cls.VERSION:
+            raise ValueError("not a version %d snapshot" % cls.VERSION)
+        writes = [(ring[((first + i) & 15) * 2], ring[((first + i) & 15) * 2 + 1]) for i in range(count)]
+        return cls(registers, writes, bus_cycle, trigger, bool(flags & cls.IRQ_LOW))
+
+    def pack(self):
+        if len(self.writes) > 15:
+            raise ValueError("the ring holds 15 writes at most")
+        ring = b"".join(bytes(write) for write in self.writes).ljust(32, b"\0")
+        return self.LAYOUT.pack(self.MAGIC, self.VERSION, self.IRQ_LOW if self.irq_low else 0, 0, len(self.writes),
+                                self.bus_cycle, self.trigger, self.registers, ring)
+
+    def describe(self):
+        register, write, data, _ = decode_trace(self.trigger)
+        lines = ["bus cycle %d, taken on %s %s %02X, #IRQ %s" % (self.bus_cycle, VIA_REGISTER_NAMES[register],
+                 "<-" if write else "->", data, "low" if self.irq_low else "high")]
+        lines += ["%2d  %-12s %02X" % (index, VIA_REGISTER_NAMES[index], value) for index, value in enumerate(self.registers)]
+        lines += ["queued  %-12s <- %02X" % (VIA_REGISTER_NAMES[register & 15], value) for register, value in self.writes]
+        return "\n".join(lines)
+
+
+class UsbLink:
+    def __init__(self, transport, timeout=1.0):
+        self.transport = transport
+        self.timeout = timeout
+        self.reader = FrameReader()
+        self.sequence = 0
+        self.pending = []
+        self.trace_frames = []
+
+    def _receive(self, deadline):
+        while not self.pending:
+            left = deadline - time.monotonic()
+            if left <= 0:
+                return False
+            for frame in self.reader.feed(self.transport.read(4096, min(left, 0.05))):
+                if frame[0] == TRACE_DATA:
+                    self.trace_frames.append(TraceFrame(frame[2]))
+                else:
+                    self.pending.append(frame)
+        return True
+
+    def send(self, command, payload=b""):
+        """Queue a request without waiting - collect the reply with wait()."""
+        sequence = self.sequence
+        self.sequence = (self.sequence + 1) & 0xFF
+        self.transport.write(encode(command, sequence, bytes(payload)))
+        return command, sequence
+
+    def wait(self, request):
+        command, sequence = request
+        deadline = time.monotonic() + self.timeout
+        while True:
+            if not self._receive(deadline):
+                raise TimeoutError("no reply to command 0x%02X" % command)
+            reply_command, reply_sequence, payload = self.pending.pop(0)
+            if reply_sequence != sequence:
+                continue
+            if reply_command == COMMAND_ERROR:
+                raise LinkError(payload[0], payload[1])
+            if reply_command != command | RESPONSE:
+                raise LinkError(command, 0)
+            return payload
+
+    def request(self, command, payload=b""):
+        return self.wait(self.send(command, payload))
+
+    def ping(self, payload=b""):
+        return self.request(PING, payload)
+
+    def peek(self, registers):
+        """Any number of registers - the requests all go out before the first reply is read."""
+        registers = bytes(registers)
+        requests = [self.send(PEEK, registers[i:i + MAX_PAYLOAD]) for i in range(0, len(registers), MAX_PAYLOAD)]
+        return b"".join(self.wait(request) for request in requests)
+
+    def poke(self, pairs):
+        data = b"".join(bytes((register, value)) for register, value in pairs)
+        requests = [self.send(POKE, data[i:i + MAX_PAYLOAD]) for i in range(0, len(data), MAX_PAYLOAD)]
+        for request in requests:
+            self.wait(request)
+
+    def pins(self, count=1):
+        """[(GPIO 0-31, GPIO 32-47)] sampled back to back on the device, up to 64 at a time."""
+        samples = []
+        while count > 0:
+            batch = min(count, PINS_PER_FRAME)
+            payload = self.request(PINS, struct.pack("<H", batch))
+            samples += [struct.unpack_from("<II", payload, i * 8) for i in range(batch)]
+            count -= batch
+        return samples
+
+    def stats(self):
+        """(bus cycle, [(reads, writes, last access cycle)] for the 16 registers)"""
+        words = struct.unpack("<49I", self.request(STATS))
+        return words[0], [tuple(words[1 + i * 3:4 + i * 3]) for i in range(16)]
+
+    def capture(self, count=TRACE_PER_FRAME):
+        """The latest trace entries, oldest first, with the trace head they end at."""
+        payload = self.request(CAPTURE, struct.pack("<H", count))
+        head, = struct.unpack_from("<I", payload)
+        return head, list(struct.unpack_from("<%dI" % ((len(payload) - 4) // 4), payload, 4))
+
+    def trace(self, enable):
+        head, = struct.unpack("<I", self.request(TRACE, bytes((1 if enable else 0,))))
+        if enable:
+            self.trace_frames = []
+        return head
+
+    def arm_snapshot(self, match=0, mask=0):
+        """Core1 snapshots the VIA on the next access whose trace entry matches - see trigger()."""
+        self.request(SNAPSHOT, struct.pack("<II", match, mask))
+
+    def get_snapshot(self):
+        """The Snapshot once the trigger has been hit, else None."""
+        payload = self.request(SNAPSHOT)
+        return Snapshot.unpack(payload) if payload else None
+
+    def restore(self, snapshot):
+        """True once core1 has it, False if it is waiting for the bus clock."""
+        return self.request(RESTORE, snapshot.pack())[0] == 1
+
+    def read_trace(self, seconds):
+        """TraceFrames streamed over the next few seconds."""
+        deadline = time.monotonic() + seconds
+        while True:
+            for frame in self.reader.feed(self.transport.read(4096, min(seconds, 0.05))):
+                if frame[0] == TRACE_DATA:
+                    self.trace_frames.append(TraceFrame(frame[2]))
+                else:
+                    self.pending.append(frame)
+            if time.monotonic() >= deadline:
+                break
+        frames, self.trace_frames = self.trace_frames, []
+        return frames
+
+
+def number(text):
+    return int(text, 0)
+
+
+def print_trace(entries, first):
+    for index, entry in enumerate(entries, first):
+        register, write, data, cycle = decode_trace(entry)
+        print("%10d  %04X  %-12s %s %02X" % (index, cycle, VIA_REGISTER_NAMES[register], "<-" if write else "->", data))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Talk to the VIA 6522 over its USB link")
+    parser.add_argument("--port", default="/dev/ttyACM0")
+    parser.add_argument("--timeout", type=float, default=1.0)
+    commands = parser.add_subparsers(dest="command", required=True)
+    commands.add_parser("ping")
+    peek = commands.add_parser("peek", help="read registers, e.g. peek 4 5 13")
+    peek.add_argument("registers", type=number, nargs="*", default=list(range(16)))
+    poke = commands.add_parser("poke", help="write registers in order, e.g. poke 3=0xFF 1=0x55")
+    poke.add_argument("writes", nargs="+")
+    pins = commands.add_parser("pins", help="sample every GPIO")
+    pins.add_argument("-n", "--count", type=int, default=1)
+    commands.add_parser("stats", help="read and write counts for each register")
+    capture = commands.add_parser("capture", help="download the latest bus trace")
+    capture.add_argument("-n", "--count", type=int, default=TRACE_PER_FRAME)
+    trace = commands.add_parser("trace", help="stream the bus trace")
+    trace.add_argument("--seconds", type=float, default=5.0)
+    snapshot = commands.add_parser("snapshot", help="save the VIA as the next matching access leaves it")
+    snapshot.add_argument("file")
+    snapshot.add_argument("--register", type=number)
+    snapshot.add_argument("--write", action="store_const", const=True, dest="write")
+    snapshot.add_argument("--read", action="store_const", const=False, dest="write")
+    snapshot.add_argument("--data", type=number)
+    snapshot.add_argument("--seconds", type=float, default=10.0, help="how long to wait for the trigger")
+    restore = commands.add_parser("restore", help="put a saved snapshot back")
+    restore.add_argument("file")
+    args = parser.parse_args()
+
+    port = SerialPort(args.port)
+    link = UsbLink(port, args.timeout)
+
+    try:
+        if args.command == "ping":
+            start = time.monotonic()
+            link.ping(b"VIA")
+            print("reply in %.2f ms" % ((time.monotonic() - start) * 1000))
+        elif args.command == "peek":
+            for register, value in zip(args.registers, link.peek(args.registers)):
+                print("%2d  %-12s %02X" % (register, VIA_REGISTER_NAMES[register & 15], value))
+        elif args.command == "poke":
+            link.poke([tuple(number(part) for part in write.split("=")) for write in args.writes])
+        elif args.command == "pins":
+            for low, high in link.pins(args.count):
+                print("%08X %04X" % (low, high & 0xFFFF))
+        elif args.command == "stats":
+            cycle, registers = link.stats()
+            print("bus cycle %d" % cycle)
+            for index, (reads, writes, last) in enumerate(registers):
+                idle = "-" if reads + writes == 0 else "%d" % ((cycle - last) & 0xFFFFFFFF)
+                print("%2d  %-12s %10d %10d %12s" % (index, VIA_REGISTER_NAMES[index], reads, writes, idle))
+        elif args.command == "capture":
+            head, entries = link.capture(args.count)
+            print_trace(entries, head - len(entries))
+        elif args.command == "trace":
+            link.trace(True)
+            try:
+                frames = link.read_trace(args.seconds)
+            finally:
+                link.trace(False)
+            for frame in frames:
+                print_trace(frame.entries, frame.first)
+            if frames:
+                print("%d entries, %d dropped" % (sum(len(f.entries) for f in frames), frames[-1].dropped))
+        elif args.command == "snapshot":
+            link.arm_snapshot(*trigger(args.register, args.write, args.data))
+            deadline = time.monotonic() + args.seconds
+            taken = link.get_snapshot()
+            while taken is None and time.monotonic() < deadline:
+                time.sleep(0.05)
+                taken = link.get_snapshot()
+            if taken is None:
+                print("no matching access in %.1f s" % args.seconds)
+                return 1
+            with open(args.file, "wb") as f:
+                f.write(taken.pack())
+            print(taken.describe())
+        elif args.command == "restore":
+            with open(args.file, "rb") as f:
+                saved = Snapshot.unpack(f.read())
+            print("restored" if link.restore(saved) else "waiting for the bus clock")
+    except LinkError as error:
+        print(error)
+        return 1
+    finally:
+        port.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,410 @@
+#!/usr/bin/env python3
+#------------------------------------------------------------------------------------------------
+#---- USB Link Loopback Test ... 2026 Dave Gaunt                                              ----
+#------------------------------------------------------------------------------------------------
+#---- Builds Common/UsbLink.c And Source/RemoteLink.c With USB_LINK_HOST_BUILD Against A Fake ----
+#---- VIA, Then Drives Them Through usb_link.py - Every Command, Batching, Bad Frames, Trace  ----
+#---- Streaming Both Keeping Up And Falling Behind, And Snapshots Out And Back.               ----
+#------------------------------------------------------------------------------------------------
+import argparse
+import ctypes
+import os
+import random
+import subprocess
+import sys
+import tempfile
+
+import usb_link
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+COMMON = os.path.join(HERE, "..", "..", "Common")
+SOURCE = os.path.join(HERE, "..", "Source")
+
+TRACE_SIZE = 4096
+
+# The HAL RemoteLink.c expects from VIA_6522.c - sixteen plain registers, one read only.
+FAKE_HAL_C = r"""
+#include "RemoteLink.h"
+
+static u8 s_aRegisters[16];
+static u32 s_uPinSamples = 0;
+static u32 s_aTrace[REMOTE_TRACE_SIZE];
+static u32 s_uTraceHead = 0;
+
+static bool s_bSnapshotArmed = false;
+static bool s_bSnapshotTaken = false;
+static u32 s_uSnapshotMatch = 0;
+static u32 s_uSnapshotMask = 0;
+static ViaSnapshot s_snapshot;
+static ViaQueuedWrite s_aRing[VIA_SNAPSHOT_RING_SIZE];
+static bool s_bBusClock = true;
+static bool s_bRestorePending = false;
+
+u8 RemoteHal_Peek(const u32 uRegister) { return s_aRegisters[uRegister]; }
+
+bool RemoteHal_Poke(const u32 uRegister, const u8 uData)
+{
+	if (15 == uRegister)
+		return false;
+
+	s_aRegisters[uRegister] = uData;
+	return true;
+}
+
+void RemoteHal_SamplePins(u32 aPins[2])
+{
+	aPins[0] = 0x80000000 | s_uPinSamples;
+	aPins[1] = 0xA5A50000 | s_uPinSamples++;
+}
+
+void RemoteHal_GetStats(u32 aStats[REMOTE_STATS_WORDS])
+{
+	for (u32 uWord=0; uWord<REMOTE_STATS_WORDS; ++uWord)
+		aStats[uWord] = uWord * 1001;
+}
+
+u32 RemoteHal_GetTraceHead(void) { return s_uTraceHead; }
+u32 RemoteHal_GetTraceEntry(const u32 uIndex) { return s_aTrace[uIndex]; }
+
+bool RemoteHal_ArmSnapshot(const u32 uMatch, const u32 uMask)
+{
+	s_bSnapshotTaken = false;
+	s_uSnapshotMatch = uMatch;
+	s_uSnapshotMask = uMask;
+	s_bSnapshotArmed = true;
+	return true;
+}
+
+bool RemoteHal_GetSnapshot(ViaSnapshot* pSnapshot)
+{
+	if (s_bSnapshotTaken)
+		*pSnapshot = s_snapshot;
+
+	return s_bSnapshotTaken;
+}
+
+// With The Bus Clock Stopped It Stays Pending, As On The Board.
+u32 RemoteHal_Restore(const ViaSnapshot* pSnapshot, bool* pbApplied)
+{
+	if (s_bRestorePending)
+		return USB_LINK_ERROR_BUSY;
+
+	if (!s_bBusClock)
+	{
+		s_bRestorePending = true;
+		*pbApplied = false;
+		return USB_LINK_ERROR_NONE;
+	}
+
+	for (u32 uRegister=0; uRegister<16; ++uRegister)
+		s_aRegisters[uRegister] = pSnapshot->m_viaRegs.m_aReg[uRegister];
+
+	// Queued Writes Land Last, As Core0 Would Apply Them.
+	for (u32 uWrite=0; uWrite<pSnapshot->m_uWrites; ++uWrite)
+		s_aRegisters[ViaSnapshot_GetWrite(pSnapshot, uWrite).m_uOffset & 15] = ViaSnapshot_GetWrite(pSnapshot, uWrite).m_uData;
+
+	*pbApplied = true;
+	return USB_LINK_ERROR_NONE;
+}
+
+void Test_SetBusClock(const bool bRunning)
+{
+	s_bBusClock = bRunning;
+	s_bRestorePending = false;
+}
+
+// Three Writes Sit In The Ring Starting At Slot 14, So Reading Them Back Has To Wrap.
+static void TakeSnapshot(const u32 uTrigger)
+{
+	for (u32 uWrite=0; uWrite<3; ++uWrite)
+	{
+		s_aRing[(14 + uWrite) & 15].m_uOffset = (u8)(4 + uWrite);
+		s_aRing[(14 + uWrite) & 15].m_uData = (u8)(0x10 + uWrite);
+	}
+
+	ViaRegisters regs;
+	for (u32 uRegister=0; uRegister<16; ++uRegister)
+		regs.m_aReg[uRegister] = s_aRegisters[uRegister];
+
+	ViaSnapshot_Take(&s_snapshot, &regs, s_aRing, 14, 3, s_uTraceHead, uTrigger, VIA_SNAPSHOT_IRQ_LOW);
+	s_bSnapshotArmed = false;
+	s_bSnapshotTaken = true;
+}
+
+// What Core1 Does On Every Access.
+void Test_PushTrace(const u32 uCount)
+{
+	for (u32 uEntry=0; uEntry<uCount; ++uEntry)
+	{
+		const u32 uIndex = s_uTraceHead;
+		const u32 uTraceEntry = RemoteLink_TraceEntry(uIndex & 15, (uIndex * 7) & 0xFF, (uIndex & 1) ? REMOTE_TRACE_WRITE : 0, uIndex);
+		s_aTrace[uIndex & (REMOTE_TRACE_SIZE - 1)] = uTraceEntry;
+		s_uTraceHead = uIndex + 1;
+
+		if (s_bSnapshotArmed && (0 == ((uTraceEntry ^ s_uSnapshotMatch) & s_uSnapshotMask)))
+			TakeSnapshot(uTraceEntry);
+	}
+}
+"""
+
+
+def expected_entry(index):
+    return (index & 15) | (usb_link.TRACE_WRITE if index & 1 else 0) | (((index * 7) & 0xFF) << 8) | ((index & 0xFFFF) << 16)
+
+
+def build(work, compiler):
+    hal = os.path.join(work, "fake_hal.c")
+    with open(hal, "w") as f:
+        f.write(FAKE_HAL_C)
+
+    library = os.path.join(work, "usb_link.so")
+    subprocess.check_call([compiler, "-std=gnu11", "-O2", "-shared", "-fPIC", "-Wall", "-Werror", "-DUSB_LINK_HOST_BUILD=1",
+                           "-I" + COMMON, "-I" + SOURCE, os.path.join(COMMON, "UsbLink.c"),
+                           os.path.join(SOURCE, "RemoteLink.c"), hal, "-o", library])
+
+    lib = ctypes.CDLL(library)
+    lib.UsbLink_Receive.restype = ctypes.c_uint32
+    lib.UsbLink_Receive.argtypes = [ctypes.c_char_p, ctypes.c_uint32]
+    lib.UsbLink_TakeOutput.restype = ctypes.c_uint32
+    lib.UsbLink_TakeOutput.argtypes = [ctypes.c_char_p, ctypes.c_uint32]
+    lib.UsbLink_GetCrcErrors.restype = ctypes.c_uint32
+    lib.RemoteLink_GetTraceDropped.restype = ctypes.c_uint32
+    lib.Test_PushTrace.argtypes = [ctypes.c_uint32]
+    lib.Test_SetBusClock.argtypes = [ctypes.c_bool]
+    lib.RemoteHal_GetTraceHead.restype = ctypes.c_uint32
+    lib.RemoteLink_Init()
+    return lib
+
+
+class Loopback:
+    """Stands in for SerialPort - bytes go straight into the C receiver, and every read runs
+    one pass of the firmware's main loop. Bytes the device will not take yet stay queued, just
+    as they would sit in the CDC FIFO. usb_packet limits how much comes back per read."""
+
+    def __init__(self, lib, usb_packet=64, rng=None):
+        self.lib = lib
+        self.queued = b""
+        self.usb_packet = usb_packet
+        self.rng = rng
+        self.written = 0
+
+    def write(self, data):
+        self.queued += data
+        self.written += len(data)
+
+    def read(self, size, timeout):
+        if self.queued:
+            taken = self.lib.UsbLink_Receive(self.queued, len(self.queued))
+            self.queued = self.queued[taken:]
+        self.lib.RemoteLink_Service()
+        size = min(size, self.usb_packet if self.rng is None else self.rng.randint(1, self.usb_packet))
+        buffer = ctypes.create_string_buffer(size)
+        got = self.lib.UsbLink_TakeOutput(buffer, size)
+        return buffer.raw[:got]
+
+
+class Checker:
+    def __init__(self):
+        self.failures = 0
+        self.checks = 0
+
+    def check(self, condition, what):
+        self.checks += 1
+        if not condition:
+            self.failures += 1
+            print("FAIL: %s" % what)
+
+
+def expect_error(link, code, command, payload=b"", request=None):
+    try:
+        link.wait(request) if request else link.request(command, payload)
+    except usb_link.LinkError as error:
+        return error.code == code
+    return False
+
+
+def test_commands(check, lib, rng):
+    link = usb_link.UsbLink(Loopback(lib, rng=rng))
+
+    for size in (0, 1, 100, usb_link.MAX_PAYLOAD):
+        payload = bytes(rng.getrandbits(8) for _ in range(size))
+        check.check(link.ping(payload) == payload, "ping of %d bytes" % size)
+
+    # More pokes than fit in one frame, and peeks likewise - all sent before any reply is read.
+    pairs = [(rng.randint(0, 14), rng.getrandbits(8)) for _ in range(700)]
+    link.poke(pairs)
+    final = {}
+    for register, value in pairs:
+        final[register] = value
+    registers = [rng.randint(0, 14) for _ in range(1500)]
+    values = link.peek(registers)
+    check.check(len(values) == len(registers), "batched peek length")
+    check.check(all(values[i] == final.get(r, 0) for i, r in enumerate(registers)), "batched peek values")
+
+    check.check(expect_error(link, 4, usb_link.PEEK, b"\x00\x10"), "peek of register 16 refused")
+    check.check(expect_error(link, 5, usb_link.POKE, b"\x0F\x00"), "unsupported poke reported")
+    check.check(expect_error(link, 3, usb_link.POKE, b"\x01"), "odd poke length refused")
+    check.check(expect_error(link, 2, 0x33), "unknown command refused")
+
+    samples = link.pins(150)
+    check.check(len(samples) == 150, "pin sample count")
+    check.check(all(low == 0x80000000 | i and high == 0xA5A50000 | i for i, (low, high) in enumerate(samples)), "pin sample order")
+    check.check(expect_error(link, 4, usb_link.PINS, b"\x00\x00"), "zero pin samples refused")
+
+    cycle, registers = link.stats()
+    check.check(cycle == 0 and registers[15] == (46 * 1001, 47 * 1001, 48 * 1001), "stats layout")
+
+    lib.Test_PushTrace(300)
+    head, entries = link.capture(100)
+    check.check(head == 300 and entries == [expected_entry(i) for i in range(200, 300)], "capture of the latest entries")
+    register, write, data, cycle = usb_link.decode_trace(entries[-1])
+    check.check((register, write, data, cycle) == (299 & 15, True, (299 * 7) & 0xFF, 299), "trace entry decode")
+    check.check(expect_error(link, 4, usb_link.CAPTURE, b"\xFF\x00"), "oversized capture refused")
+
+
+def test_bad_frames(check, lib, rng):
+    transport = Loopback(lib)
+    link = usb_link.UsbLink(transport)
+    errors_before = lib.UsbLink_GetCrcErrors()
+
+    # A corrupted frame gets a CRC error back, and the next good one still works.
+    frame = bytearray(usb_link.encode(usb_link.PING, 0x42, b"hello"))
+    frame[8] ^= 0x10
+    transport.write(bytes(frame))
+    check.check(expect_error(link, 1, usb_link.PING, request=(usb_link.PING, 0x42)), "CRC error reported")
+    check.check(link.ping(b"after") == b"after", "good frame after a bad one")
+    check.check(lib.UsbLink_GetCrcErrors() == errors_before + 1, "CRC error counted")
+
+    # Noise, including stray sync bytes, is skipped.
+    transport.write(bytes(rng.getrandbits(8) for _ in range(200)).replace(usb_link.SYNC, b"\x00\x00") + b"\xA5\xA5")
+    check.check(link.ping(b"resync") == b"resync", "resync after noise")
+
+    # A length over the limit is refused without waiting for a payload that size.
+    transport.write(usb_link.SYNC + bytes((usb_link.PING, 9)) + (usb_link.MAX_PAYLOAD + 1).to_bytes(2, "little"))
+    check.check(link.ping(b"after length") == b"after length", "recovers from a bad length")
+
+    # 200 requests written in one go - the device only reads while a reply fits, so none is lost.
+    requests = [link.send(usb_link.PING, bytes([i]) * 200) for i in range(200)]
+    check.check(all(link.wait(request) == bytes([i]) * 200 for i, request in enumerate(requests)), "back pressure keeps every reply")
+
+
+def test_trace(check, lib, rng):
+    transport = Loopback(lib, usb_packet=4096, rng=rng)
+    link = usb_link.UsbLink(transport)
+    first = link.trace(True)
+
+    # Keeping up - every entry arrives once, in order, with nothing dropped.
+    seen = []
+    dropped = 0
+    for _ in range(200):
+        lib.Test_PushTrace(rng.randint(0, 300))
+        for frame in link.read_trace(0):
+            check.check(frame.first == first + len(seen) + frame.dropped - dropped, "trace frame index")
+            dropped = frame.dropped
+            seen += frame.entries
+    while True:
+        frames = link.read_trace(0) + link.read_trace(0)
+        if not frames:
+            break
+        for frame in frames:
+            seen += frame.entries
+    check.check(seen == [expected_entry(first + i) for i in range(len(seen))], "streamed trace in order")
+    check.check(dropped == 0 and lib.RemoteLink_GetTraceDropped() == 0, "nothing dropped while keeping up")
+
+    # A command still gets through while the stream is busy.
+    lib.Test_PushTrace(3000)
+    check.check(link.ping(b"busy") == b"busy", "command answered mid stream")
+
+    # Falling behind - core1 never waits, the oldest entries are dropped and counted.
+    while link.read_trace(0) or link.read_trace(0):
+        pass
+    start = lib.RemoteHal_GetTraceHead()
+    lib.Test_PushTrace(TRACE_SIZE * 3)
+    frames = []
+    for _ in range(400):
+        frames += link.read_trace(0)
+    head = lib.RemoteHal_GetTraceHead()
+    total = sum(len(frame.entries) for frame in frames)
+    check.check(frames[-1].dropped >= TRACE_SIZE * 2, "overrun counted")
+    check.check(frames[-1].first + len(frames[-1].entries) == head, "stream reaches the head")
+    check.check(total + frames[-1].dropped == head - start, "every entry either sent or counted as dropped")
+    for frame in frames:
+        check.check(all(entry == expected_entry(frame.first + i) for i, entry in enumerate(frame.entries)), "entries after overrun")
+
+    link.trace(False)
+    lib.Test_PushTrace(100)
+    check.check(link.read_trace(0) == [], "stream stops")
+
+
+def test_snapshot(check, lib, rng):
+    link = usb_link.UsbLink(Loopback(lib, rng=rng))
+    registers = bytes(rng.getrandbits(8) for _ in range(15))
+    link.poke(enumerate(registers))
+
+    # Armed for the write to Int Flags the fake makes at entry index - the data repeats every 256.
+    index = lib.RemoteHal_GetTraceHead() + 20
+    index += (13 - index) & 15
+    data = (index * 7) & 0xFF
+    match, mask = usb_link.trigger(register=13, write=True, data=data)
+    check.check((match, mask) == (0x1D | data << 8, 0xFF1F), "trigger match and mask")
+    link.arm_snapshot(match, mask)
+    check.check(link.get_snapshot() is None, "nothing until the trigger is hit")
+    lib.Test_PushTrace(index - lib.RemoteHal_GetTraceHead())
+    check.check(link.get_snapshot() is None, "not taken on the accesses before it")
+    lib.Test_PushTrace(10)
+    taken = link.get_snapshot()
+    check.check(taken is not None, "taken on the matching access")
+    if taken is not None:
+        check.check(taken.trigger == expected_entry(index), "trigger entry recorded")
+        check.check(taken.bus_cycle == index + 1 and taken.irq_low, "bus cycle and #IRQ recorded")
+        check.check(taken.registers[:15] == registers, "registers captured")
+        check.check(taken.writes == [(4, 0x10), (5, 0x11), (6, 0x12)], "queued writes oldest first across the wrap")
+        check.check(usb_link.Snapshot.unpack(taken.pack()).pack() == taken.pack(), "snapshot packs back the same")
+
+    # A zero mask takes the very next access.
+    link.arm_snapshot()
+    lib.Test_PushTrace(1)
+    taken = link.get_snapshot()
+    check.check(taken is not None and taken.trigger == expected_entry(lib.RemoteHal_GetTraceHead() - 1), "zero mask takes the next access")
+
+    # Back the other way - the queued writes land on top of the registers.
+    saved = usb_link.Snapshot(bytes(range(0x80, 0x90)), [(4, 0x44), (14, 0x7F)], 99)
+    check.check(link.restore(saved), "restore applied")
+    expected = bytearray(range(0x80, 0x8F))
+    expected[4], expected[14] = 0x44, 0x7F
+    check.check(link.peek(range(15)) == bytes(expected), "registers restored with queued writes applied")
+
+    lib.Test_SetBusClock(False)
+    check.check(not link.restore(saved), "restore waits while the bus clock is stopped")
+    check.check(expect_error(link, 6, usb_link.RESTORE, saved.pack()), "second restore while one waits is busy")
+    lib.Test_SetBusClock(True)
+
+    check.check(expect_error(link, 3, usb_link.RESTORE, saved.pack()[:-1]), "short snapshot refused")
+    check.check(expect_error(link, 4, usb_link.RESTORE, b"JUNK" + saved.pack()[4:]), "bad magic refused")
+    wrong_version = bytearray(saved.pack())
+    wrong_version[4] = 2
+    check.check(expect_error(link, 4, usb_link.RESTORE, bytes(wrong_version)), "other version refused")
+    check.check(expect_error(link, 3, usb_link.SNAPSHOT, b"\x00"), "odd snapshot arm length refused")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Loopback test of the USB link against the host build")
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--cc", default=os.environ.get("CC", "cc"))
+    args = parser.parse_args()
+
+    rng = random.Random(args.seed)
+    lib = build(tempfile.mkdtemp(prefix="usb_link_"), args.cc)
+    check = Checker()
+
+    test_commands(check, lib, rng)
+    test_bad_frames(check, lib, rng)
+    test_trace(check, lib, rng)
+    test_snapshot(check, lib, rng)
+
+    print("%d checks, %d failed: %s" % (check.checks, check.failures, "PASS" if check.failures == 0 else "FAIL"))
+    return 1 if check.failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,565 @@
+#!/usr/bin/env python3
+#------------------------------------------------------------------------------------------------
+#---- VIA Differential Fuzzer ... 2026 Dave Gaunt                                             ----
+#------------------------------------------------------------------------------------------------
+#---- Random Interleavings Of Register Reads, Writes And Idle Cycles Run Through Three VIAs - ----
+#---- A Naive Per Cycle Reference Written Here, Source/Via6522.c Ticked Every Cycle As Core1  ----
+#---- Does, And Via6522.c Jumping Ahead With Via6522_Advance. Every Read, Every #IRQ Edge And ----
+#---- The Registers After Each Step Must Agree.                                               ----
+#------------------------------------------------------------------------------------------------
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+COMMON = os.path.join(HERE, "..", "..", "Common")
+SOURCE = os.path.join(HERE, "..", "Source")
+
+# One input is the Port A pin levels, then a stream of steps:
+#   00nnnnnn            idle n + 1 cycles
+#   01nnnnnn nnnnnnnn   idle n + 1 cycles, up to 16384
+#   10xxrrrr dddddddd   write d to register r, one cycle
+#   11xxrrrr            read register r, one cycle
+FUZZ_C = r"""
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Via6522.h"
+#include "ViaWriteRing.h"
+
+// Built With libFuzzer's Own main, Or The Standalone One At The Bottom.
+#ifndef VIA_FUZZ_LIBFUZZER
+#define VIA_FUZZ_LIBFUZZER			(0)
+#endif
+
+// via_fuzz.py Plants This To Check A One Cycle Slip Gets Caught.
+#ifndef VIA_FUZZ_PLANTED_BUG
+#define VIA_FUZZ_PLANTED_BUG		(0)
+#endif
+
+typedef struct
+{
+	bool m_bLevel;
+	u32	m_uEdges;
+	u32	m_uLastEdge;
+} IrqPin;
+
+static void SetIrq(IrqPin* pPin, const bool bLevel, const u32 uCycle)
+{
+	if (bLevel == pPin->m_bLevel)
+		return;
+
+	pPin->m_bLevel = bLevel;
+	pPin->m_uLastEdge = uCycle;
+	++pPin->m_uEdges;
+}
+
+// Reference - Straight From How The Board Behaves, Not From Via6522.c. One Cycle At A Time.
+typedef struct
+{
+	u8	m_aReg[16];						/* All But Timer 1's Counter And Latch */
+	u16	m_uCounter;
+	u16	m_uLatch;
+	u8	m_uPins;
+	IrqPin m_irq;
+} RefVia;
+
+static void RefProcess(RefVia* pRef, const u32 uCycle)
+{
+	const u8 uActive = pRef->m_aReg[13] & pRef->m_aReg[14] & 0x7F;
+
+	pRef->m_aReg[13] = uActive ? (0x80 | uActive) : 0;
+	SetIrq(&pRef->m_irq, 0 != uActive, uCycle);
+}
+
+static void RefRegisters(const RefVia* pRef, u8 aRegisters[16])
+{
+	memcpy(aRegisters, pRef->m_aReg, 16);
+	aRegisters[4] = pRef->m_uCounter & 0xFF;
+	aRegisters[5] = pRef->m_uCounter >> 8;
+	aRegisters[6] = pRef->m_uLatch & 0xFF;
+	aRegisters[7] = pRef->m_uLatch >> 8;
+}
+
+static void RefCycle(RefVia* pRef, const u32 uCycle)
+{
+	if (pRef->m_uCounter > 1)
+		--pRef->m_uCounter;
+	else if (1 == pRef->m_uCounter)
+	{
+		// Through 0 And $FFFF Before The Latch Goes Back - N + 2, As PB7 Toggles.
+		pRef->m_uCounter = (pRef->m_uLatch < 0xFFFE) ? (pRef->m_uLatch + 2) : 0xFFFF;
+		pRef->m_aReg[13] |= 0x40;
+		RefProcess(pRef, uCycle);
+	}
+
+	pRef->m_aReg[1] = pRef->m_uPins;
+	pRef->m_aReg[15] = pRef->m_uPins;
+}
+
+static u8 RefRead(RefVia* pRef, const u32 uRegister, const u32 uCycle)
+{
+	u8 aRegisters[16];
+
+	RefRegisters(pRef, aRegisters);
+
+	if (4 == uRegister)
+	{
+		pRef->m_aReg[13] &= ~0x40;
+		RefProcess(pRef, uCycle);
+	}
+
+	return aRegisters[uRegister];
+}
+
+static void RefWrite(RefVia* pRef, const u32 uRegister, const u8 uData, const u32 uCycle)
+{
+	u8* pReg = pRef->m_aReg;
+
+	switch (uRegister)
+	{
+		// Ports Are Core1's, Nothing Goes To Core0.
+		case 0:	pReg[0] = (pReg[0] & ~pReg[2]) | (uData & pReg[2]);	return;
+		case 1:	pReg[1] = (pReg[1] & ~pReg[3]) | (uData & pReg[3]);	return;
+		case 2:	pReg[2] = uData;									return;
+		case 3:	pReg[3] = uData;									return;
+
+		case 4:	pRef->m_uLatch = (pRef->m_uLatch & 0xFF00) | uData;	break;
+		case 6:	pRef->m_uLatch = (pRef->m_uLatch & 0xFF00) | uData;	break;
+
+		case 5:
+			pRef->m_uLatch = (pRef->m_uLatch & 0x00FF) | (uData << 8);
+			pRef->m_uCounter = pRef->m_uLatch ? pRef->m_uLatch : 1;
+			pReg[13] &= ~0x40;
+		break;
+
+		case 7:
+			pRef->m_uLatch = (pRef->m_uLatch & 0x00FF) | (uData << 8);
+			pReg[13] &= ~0x40;
+		break;
+
+		case 13:
+			pReg[13] = (uData & 0x80) ? (pReg[13] | (uData & 0x7F)) : (pReg[13] & ~uData & 0x7F);
+			if (pReg[13])
+				pReg[13] |= 0x80;
+		break;
+
+		case 14:
+			pReg[14] = (uData & 0x80) ? (pReg[14] | (uData & 0x7F)) : (pReg[14] & ~uData & 0x7F);
+		break;
+
+		default:
+			pReg[uRegister] = uData;
+		break;
+	}
+
+	RefProcess(pRef, uCycle);
+}
+
+// Via6522.c, Wired As VIA_6522.c Wires It - Ports On Core1, The Rest Round The Firmware's Ring
+// To ProcessVIA, Which Empties It Straight Away Here.
+typedef struct
+{
+	ViaRegisters m_via;
+	ViaWriteRing m_ring;
+	bool m_bLazy;
+	u8	m_uPins;
+	IrqPin m_irq;
+} Model;
+
+static void ModelProcess(Model* pModel, const u32 uCycle)
+{
+	SetIrq(&pModel->m_irq, Via6522_UpdateIrq(&pModel->m_via), uCycle);
+}
+
+static void ModelRun(Model* pModel, const u32 uStart, const u32 uCycles)
+{
+	ViaRegisters* pVia = &pModel->m_via;
+
+	if (pModel->m_bLazy)
+	{
+		const u32 uFire = Via6522_CyclesToFire(pVia);
+
+#if VIA_FUZZ_PLANTED_BUG
+		if ((0 != uFire) && (uFire < uCycles))
+#else
+		if ((0 != uFire) && (uFire <= uCycles))
+#endif
+		{
+			// Only The First Firing Can Move #IRQ, The Rest Just Keep The Flag Up.
+			Via6522_Advance(pVia, uFire);
+			ModelProcess(pModel, uStart + uFire);
+
+			if (Via6522_Advance(pVia, uCycles - uFire))
+				ModelProcess(pModel, uStart + uCycles);
+		}
+		else
+			Via6522_Advance(pVia, uCycles);
+	}
+	else
+	{
+		for (u32 uCycle=1; uCycle<=uCycles; ++uCycle)
+		{
+			if (Via6522_Tick(pVia))
+				ModelProcess(pModel, uStart + uCycle);
+		}
+	}
+
+	pVia->m_u8PortA = pModel->m_uPins;
+	pVia->m_u8PortA_NoHandshake = pModel->m_uPins;
+}
+
+static u8 ModelRead(Model* pModel, const u32 uRegister, const u32 uCycle)
+{
+	const u8 uData = pModel->m_via.m_aReg[uRegister];
+
+	if (Via6522_ReadDone(&pModel->m_via, uRegister))
+		ModelProcess(pModel, uCycle);
+
+	return uData;
+}
+
+static void ModelWrite(Model* pModel, const u32 uRegister, const u8 uData, const u32 uCycle)
+{
+	ViaRegisters* pVia = &pModel->m_via;
+
+	switch (uRegister)
+	{
+		case VIA_REG_PORTB:		pVia->m_u8PortB ^= (pVia->m_u8PortB ^ uData) & pVia->m_uDataDirB;	break;
+		case VIA_REG_PORTA:		pVia->m_u8PortA ^= (pVia->m_u8PortA ^ uData) & pVia->m_uDataDirA;	break;
+		case VIA_REG_DATA_DIRB:	pVia->m_uDataDirB = uData;											break;
+		case VIA_REG_DATA_DIRA:	pVia->m_uDataDirA = uData;											break;
+
+		default:
+		{
+			ViaQueuedWrite write;
+
+			ViaWriteRing_Push(&pModel->m_ring, (ViaQueuedWrite){ (u8)uRegister, uData });
+
+			while (ViaWriteRing_Pop(&pModel->m_ring, &write))
+			{
+				Via6522_Write(pVia, write.m_uOffset & 15, write.m_uData);
+				ModelProcess(pModel, uCycle);
+			}
+		}
+		break;
+	}
+}
+
+static const uint8_t* s_pInput;
+static size_t s_uInputSize;
+
+static void Fail(const char* pszWhat, const u32 uStep, const u32 uCycle)
+{
+	fprintf(stderr, "MISMATCH: %s at step %u, cycle %u\n", pszWhat, uStep, uCycle);
+
+#if !VIA_FUZZ_LIBFUZZER
+	FILE* pFile = fopen("crash-standalone", "wb");
+	if (pFile)
+	{
+		fwrite(s_pInput, 1, s_uInputSize, pFile);
+		fclose(pFile);
+	}
+#endif
+	abort();
+}
+
+static void CheckPin(const IrqPin* pExpected, const IrqPin* pPin, const char* pszWho, const u32 uStep, const u32 uCycle)
+{
+	if ((pExpected->m_bLevel != pPin->m_bLevel) || (pExpected->m_uEdges != pPin->m_uEdges) || (pExpected->m_uLastEdge != pPin->m_uLastEdge))
+		Fail(pszWho, uStep, uCycle);
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t* pData, size_t uSize)
+{
+	if (uSize < 1)
+		return 0;
+
+	s_pInput = pData;
+	s_uInputSize = uSize;
+
+	RefVia ref;
+	Model ticked;
+	Model lazy;
+
+	memset(&ref, 0, sizeof(ref));
+	memset(&ticked, 0, sizeof(ticked));
+	memset(&lazy, 0, sizeof(lazy));
+	Via6522_Reset(&ticked.m_via);
+	Via6522_Reset(&lazy.m_via);
+	ViaWriteRing_Init(&ticked.m_ring);
+	ViaWriteRing_Init(&lazy.m_ring);
+	ref.m_uPins = ticked.m_uPins = lazy.m_uPins = pData[0];
+	lazy.m_bLazy = true;
+
+	u32 uCycle = 0;
+	u32 uStep = 0;
+
+	for (size_t uIndex=1; uIndex<uSize; ++uStep)
+	{
+		const u8 uOp = pData[uIndex++];
+		const u8 uNext = (uIndex < uSize) ? pData[uIndex] : 0;
+		const u32 uRegister = uOp & 15;
+		u32 uIdle = 1;
+
+		switch (uOp >> 6)
+		{
+			case 0:
+				uIdle = (uOp & 0x3F) + 1;
+			break;
+
+			case 1:
+				uIdle = (((uOp & 0x3F) << 8) | uNext) + 1;
+				++uIndex;
+			break;
+
+			case 2:
+				RefWrite(&ref, uRegister, uNext, uCycle);
+				ModelWrite(&ticked, uRegister, uNext, uCycle);
+				ModelWrite(&lazy, uRegister, uNext, uCycle);
+				++uIndex;
+			break;
+
+			case 3:
+			{
+				const u8 uExpected = RefRead(&ref, uRegister, uCycle);
+
+				if (ModelRead(&ticked, uRegister, uCycle) != uExpected)
+					Fail("ticked read", uStep, uCycle);
+
+				if (ModelRead(&lazy, uRegister, uCycle) != uExpected)
+					Fail("lazy read", uStep, uCycle);
+			}
+			break;
+		}
+
+		for (u32 uTick=1; uTick<=uIdle; ++uTick)
+			RefCycle(&ref, uCycle + uTick);
+
+		ModelRun(&ticked, uCycle, uIdle);
+		ModelRun(&lazy, uCycle, uIdle);
+		uCycle += uIdle;
+
+		u8 aExpected[16];
+		RefRegisters(&ref, aExpected);
+
+		if (memcmp(aExpected, ticked.m_via.m_aReg, 16))
+			Fail("ticked registers", uStep, uCycle);
+
+		if (memcmp(aExpected, lazy.m_via.m_aReg, 16))
+			Fail("lazy registers", uStep, uCycle);
+
+		CheckPin(&ref.m_irq, &ticked.m_irq, "ticked #IRQ", uStep, uCycle);
+		CheckPin(&ref.m_irq, &lazy.m_irq, "lazy #IRQ", uStep, uCycle);
+	}
+
+	return 0;
+}
+
+#if !VIA_FUZZ_LIBFUZZER
+// No libFuzzer - Replay The Files Given, Or Make Up Inputs From A Seed. Timer Values Are Kept
+// Small Half The Time So It Fires Within The Idle Steps.
+static u32 s_uRandom;
+
+static u32 Random(void)
+{
+	s_uRandom ^= s_uRandom << 13;
+	s_uRandom ^= s_uRandom >> 17;
+	s_uRandom ^= s_uRandom << 5;
+	return s_uRandom;
+}
+
+static void Replay(const char* pszPath)
+{
+	FILE* pFile = fopen(pszPath, "rb");
+	static uint8_t s_aBuffer[1 << 16];
+
+	if (!pFile)
+	{
+		fprintf(stderr, "Can Not Open %s\n", pszPath);
+		exit(2);
+	}
+
+	const size_t uSize = fread(s_aBuffer, 1, sizeof(s_aBuffer), pFile);
+	fclose(pFile);
+	LLVMFuzzerTestOneInput(s_aBuffer, uSize);
+}
+
+int main(int argc, char** argv)
+{
+	u32 uRuns = 10000;
+	u32 uReplayed = 0;
+
+	s_uRandom = 1;
+
+	for (int iArg=1; iArg<argc; ++iArg)
+	{
+		if (0 == strncmp(argv[iArg], "-runs=", 6))
+			uRuns = (u32)strtoul(argv[iArg] + 6, 0, 0);
+		else if (0 == strncmp(argv[iArg], "-seed=", 6))
+			s_uRandom = (u32)strtoul(argv[iArg] + 6, 0, 0) | 1;
+		else
+		{
+			Replay(argv[iArg]);
+			++uReplayed;
+		}
+	}
+
+	if (uReplayed)
+	{
+		printf("%u Inputs Replayed\n", uReplayed);
+		return 0;
+	}
+
+	static uint8_t s_aInput[1024];
+
+	for (u32 uRun=0; uRun<uRuns; ++uRun)
+	{
+		const u32 uSteps = 1 + (Random() % 200);
+		size_t uSize = 0;
+
+		s_aInput[uSize++] = (u8)Random();
+
+		for (u32 uStep=0; (uStep<uSteps) && (uSize + 2 <= sizeof(s_aInput)); ++uStep)
+		{
+			const u32 uKind = Random() % 8;
+			const u32 uRegister = (Random() & 1) ? (4 + (Random() % 4)) : (Random() % 16);
+
+			if (uKind < 2)
+				s_aInput[uSize++] = (u8)(Random() & 0x3F);
+			else if (uKind < 3)
+			{
+				s_aInput[uSize++] = (u8)(0x40 | (Random() & 0x3F));
+				s_aInput[uSize++] = (u8)Random();
+			}
+			else if (uKind < 6)
+			{
+				s_aInput[uSize++] = (u8)(0x80 | uRegister);
+				s_aInput[uSize++] = (u8)((Random() & 1) ? (Random() & 0x1F) : Random());
+			}
+			else
+				s_aInput[uSize++] = (u8)(0xC0 | uRegister);
+		}
+
+		LLVMFuzzerTestOneInput(s_aInput, uSize);
+	}
+
+	printf("%u Runs Clean\n", uRuns);
+	return 0;
+}
+#endif
+"""
+
+
+def compile_target(work, compiler, name, defines, sanitize):
+    source = os.path.join(work, "via_fuzz.c")
+    with open(source, "w") as f:
+        f.write(FUZZ_C)
+
+    binary = os.path.join(work, name)
+    command = [compiler, "-std=gnu11", "-O1", "-g", "-Wall", "-Werror", "-I" + COMMON, "-I" + SOURCE]
+    command += ["-D%s=1" % define for define in defines]
+    command += ["-fsanitize=%s" % sanitize] if sanitize else []
+    command += [os.path.join(SOURCE, "Via6522.c"), source, "-o", binary]
+    result = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    if result.returncode != 0:
+        print(result.stdout)
+        return None
+    return binary
+
+
+def run(binary, arguments, cwd):
+    result = subprocess.run([binary] + arguments, cwd=cwd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    return result.returncode, result.stdout
+
+
+def libfuzzer(args, work):
+    binary = compile_target(work, args.cc, "via_fuzz_libfuzzer", ["VIA_FUZZ_LIBFUZZER"], "fuzzer,address,undefined")
+    if binary is None:
+        print("libFuzzer build failed - it needs clang, e.g. --cc clang")
+        return 1
+
+    corpus = os.path.abspath(args.corpus)
+    os.makedirs(corpus, exist_ok=True)
+
+    if args.minimise:
+        # -merge=1 Keeps The Smallest Set Of Inputs That Still Reaches Everything The Corpus Does.
+        minimised = os.path.abspath(args.minimise)
+        os.makedirs(minimised, exist_ok=True)
+        code = subprocess.call([binary, "-merge=1", minimised, corpus])
+        print("minimised %d inputs to %d in %s" % (len(os.listdir(corpus)), len(os.listdir(minimised)), minimised))
+        return code
+
+    return subprocess.call([binary, corpus, "-max_total_time=%d" % args.seconds, "-runs=%d" % args.runs if args.runs else "-runs=-1"])
+
+
+def standalone(args, work):
+    failures = 0
+    sanitize = "address,undefined"
+    binary = compile_target(work, args.cc, "via_fuzz", [], sanitize)
+    if binary is None:
+        sanitize = None
+        binary = compile_target(work, args.cc, "via_fuzz", [], sanitize)
+
+    if args.corpus and os.path.isdir(args.corpus):
+        files = [os.path.abspath(os.path.join(args.corpus, name)) for name in sorted(os.listdir(args.corpus))]
+        if files:
+            code, output = run(binary, files, work)
+            print(output.strip())
+            failures += code != 0
+
+    code, output = run(binary, ["-runs=%d" % args.runs, "-seed=%d" % args.seed], work)
+    print(output.strip())
+    if code != 0:
+        failures += 1
+        crash = os.path.join(work, "crash-standalone")
+        if os.path.exists(crash):
+            shutil.copy(crash, os.path.join(os.getcwd(), "crash-standalone"))
+            print("failing input saved to crash-standalone - replay with: via_fuzz.py --replay crash-standalone")
+
+    # The Fuzzer Has To Find A Fire One Cycle Late, Or It Is Not Looking Hard Enough.
+    planted = compile_target(work, args.cc, "via_fuzz_planted", ["VIA_FUZZ_PLANTED_BUG"], sanitize)
+    code, output = run(planted, ["-runs=%d" % args.runs, "-seed=%d" % args.seed], work)
+    found = code != 0 and "MISMATCH" in output
+    print("planted one cycle slip: %s" % ("found - " + output.strip().splitlines()[0] if found else "MISSED"))
+    failures += not found
+
+    print("%s" % ("PASS" if failures == 0 else "FAIL"))
+    return 1 if failures else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Differential fuzzer - reference VIA against Via6522.c ticked and lazy")
+    parser.add_argument("--cc", default=os.environ.get("CC", "cc"))
+    parser.add_argument("--runs", type=int, default=10000)
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--libfuzzer", action="store_true", help="build for libFuzzer (clang) and fuzz the corpus")
+    parser.add_argument("--corpus", default=None, help="corpus directory - libFuzzer grows it, standalone replays it")
+    parser.add_argument("--minimise", default=None, help="with --libfuzzer, merge the corpus down into this directory")
+    parser.add_argument("--seconds", type=int, default=60, help="with --libfuzzer, how long to run")
+    parser.add_argument("--replay", nargs="+", help="run just these inputs")
+    args = parser.parse_args()
+
+    work = tempfile.mkdtemp(prefix="via_fuzz_")
+
+    if args.replay:
+        binary = compile_target(work, args.cc, "via_fuzz", [], "address,undefined")
+        code, output = run(binary, [os.path.abspath(path) for path in args.replay], work)
+        print(output.strip())
+        return code
+
+    if args.libfuzzer:
+        if not args.corpus:
+            args.corpus = os.path.join(os.getcwd(), "via_fuzz_corpus")
+        return libfuzzer(args, work)
+
+    return standalone(args, work)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,456 @@
+//------------------------------------------------------------------------------------------------
+//---- CIA 6526 ... 2026 Dave Gaunt                                                           ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include <string.h>
+
+#include "Cia6526.h"
+
+#define CIA_PB6		(1 << 6)
+#define CIA_PB7		(1 << 7)
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+static inline void UpdateIrq(Cia6526State* pCia)
+{
+	pCia->m_bIrq = (0 != (pCia->m_uInterruptFlags & pCia->m_uInterruptMask));
+}
+
+static inline void RaiseIrq(Cia6526State* pCia, const u32 uFlag)
+{
+	pCia->m_uInterruptFlags |= (1 << uFlag);
+	UpdateIrq(pCia);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- BCD Increment With Wrap, Returns True On Carry.                                        ----
+//------------------------------------------------------------------------------------------------
+static inline bool IncrementBCD(u8* pValue, const u8 uWrap)
+{
+	u8 uValue = *pValue + 1;
+
+	if ((uValue & 0xF) > 9)
+		uValue = (uValue & 0xF0) + 0x10;
+
+	if (uValue >= uWrap)
+	{
+		*pValue = 0;
+		return true;
+	}
+
+	*pValue = uValue;
+	return false;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Hours Run 1-12 With The AM/PM Flag In Bit 7, Flipping As 11 Rolls Over To 12.          ----
+//------------------------------------------------------------------------------------------------
+static void IncrementHours(u8* pHours)
+{
+	const u8 uPM = *pHours & 0x80;
+	u8 uHours = *pHours & 0x1F;
+
+	if (0x12 == uHours)
+		uHours = 0x01;
+	else if (0x11 == uHours)
+	{
+		*pHours = 0x12 | (uPM ^ 0x80);
+		return;
+	}
+	else
+		IncrementBCD(&uHours, 0x13);
+
+	*pHours = uHours | uPM;
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+static void TickTimeOfDay(Cia6526State* pCia)
+{
+	if (pCia->m_bTodStopped)
+		return;
+
+	if (IncrementBCD(&pCia->m_aTod[0], 0x0A))
+		if (IncrementBCD(&pCia->m_aTod[1], 0x60))
+			if (IncrementBCD(&pCia->m_aTod[2], 0x60))
+				IncrementHours(&pCia->m_aTod[3]);
+
+	if (0 == memcmp(pCia->m_aTod, pCia->m_aAlarm, sizeof(pCia->m_aTod)))
+		RaiseIrq(pCia, CIA_IRQ_ALARM);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Timer Output On PB6 / PB7 - Toggle Or A One Cycle Pulse On Each Underflow.             ----
+//------------------------------------------------------------------------------------------------
+static inline void TimerPortOutput(Cia6526State* pCia, const u8 uControl, const u8 uBit, const bool bUnderflow)
+{
+	if (0 == (uControl & CIA_CR_PB_ON))
+		return;
+
+	if (uControl & CIA_CR_TOGGLE)
+	{
+		if (bUnderflow)
+			pCia->m_uTimerPortB ^= uBit;
+	}
+	else if (bUnderflow)
+		pCia->m_uTimerPortB |= uBit;
+	else
+		pCia->m_uTimerPortB &= ~uBit;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Serial Output Is Clocked By Timer A - CNT Toggles Each Underflow, A Bit Per CNT Cycle. ----
+//---- Each Bit Goes Out As CNT Falls And Is Taken As It Rises; CNT Idles High When Done.     ----
+//------------------------------------------------------------------------------------------------
+static inline void SerialOutUnderflow(Cia6526State* pCia)
+{
+	if (0 == pCia->m_uShiftBits)
+		return;
+
+	pCia->m_bCntOut = !pCia->m_bCntOut;
+
+	// Falling Edge Of CNT Presents The Next Bit, MSB First.
+	if (!pCia->m_bCntOut)
+	{
+		pCia->m_bSpOut = (pCia->m_uShiftReg >> 7) & 1;
+		pCia->m_uShiftReg <<= 1;
+		return;
+	}
+
+	// The Receiver Clocks It In On The Rising Edge - The Byte Is Done With The Eighth.
+	if (0 == --pCia->m_uShiftBits)
+	{
+		RaiseIrq(pCia, CIA_IRQ_SERIAL);
+
+		if (pCia->m_bSerialPending)
+		{
+			pCia->m_bSerialPending = false;
+			pCia->m_uShiftReg = pCia->m_uSerialData;
+			pCia->m_uShiftBits = 8;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void Cia6526_Reset(Cia6526State* pCia)
+{
+	memset(pCia, 0, sizeof(Cia6526State));
+
+	pCia->m_uTimerA = 0xFFFF;
+	pCia->m_uTimerA_Latch = 0xFFFF;
+	pCia->m_uTimerB = 0xFFFF;
+	pCia->m_uTimerB_Latch = 0xFFFF;
+	pCia->m_aTod[3] = 0x01;
+	pCia->m_bCntOut = true;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Called Once Per Phase 2 Clock From The Core1 Bus Loop.                                 ----
+//------------------------------------------------------------------------------------------------
+void __hot_path_func(Cia6526_Tick)(Cia6526State* pCia, const u32 uInputs)
+{
+	const u32 uRising = uInputs & ~pCia->m_uLastInputs;
+	const u32 uFalling = ~uInputs & pCia->m_uLastInputs;
+	pCia->m_uLastInputs = (u8)uInputs;
+
+	// Timer A
+	bool bUnderflowA = false;
+
+	if (pCia->m_uControlA & CIA_CR_START)
+	{
+		if ((0 == (pCia->m_uControlA & CIA_CRA_COUNT_CNT)) || (uRising & CIA_INPUT_CNT))
+		{
+			if (0 == pCia->m_uTimerA)
+			{
+				bUnderflowA = true;
+				pCia->m_uTimerA = pCia->m_uTimerA_Latch;
+
+				if (pCia->m_uControlA & CIA_CR_ONE_SHOT)
+					pCia->m_uControlA &= ~CIA_CR_START;
+
+				RaiseIrq(pCia, CIA_IRQ_TIMERA);
+
+				if (pCia->m_uControlA & CIA_CRA_SERIAL_OUT)
+					SerialOutUnderflow(pCia);
+			}
+			else
+			{
+				pCia->m_uTimerA--;
+			}
+		}
+	}
+
+	TimerPortOutput(pCia, pCia->m_uControlA, CIA_PB6, bUnderflowA);
+
+	// Timer B - Counts Phase 2, CNT Or Cascades From Timer A.
+	bool bUnderflowB = false;
+
+	if (pCia->m_uControlB & CIA_CR_START)
+	{
+		bool bCount = false;
+
+		switch ((pCia->m_uControlB & CIA_CRB_INMODE_MASK) >> CIA_CRB_INMODE_SHIFT)
+		{
+			case CIA_TB_COUNT_PHI2:			bCount = true;												break;
+			case CIA_TB_COUNT_CNT:			bCount = (0 != (uRising & CIA_INPUT_CNT));					break;
+			case CIA_TB_COUNT_TIMERA:		bCount = bUnderflowA;										break;
+			case CIA_TB_COUNT_TIMERA_CNT:	bCount = bUnderflowA && (0 != (uInputs & CIA_INPUT_CNT));	break;
+		}
+
+		if (bCount)
+		{
+			if (0 == pCia->m_uTimerB)
+			{
+				bUnderflowB = true;
+				pCia->m_uTimerB = pCia->m_uTimerB_Latch;
+
+				if (pCia->m_uControlB & CIA_CR_ONE_SHOT)
+					pCia->m_uControlB &= ~CIA_CR_START;
+
+				RaiseIrq(pCia, CIA_IRQ_TIMERB);
+			}
+			else
+			{
+				pCia->m_uTimerB--;
+			}
+		}
+	}
+
+	TimerPortOutput(pCia, pCia->m_uControlB, CIA_PB7, bUnderflowB);
+
+	// Serial Input Shifts On Each Rising Edge Of An External CNT.
+	if ((0 == (pCia->m_uControlA & CIA_CRA_SERIAL_OUT)) && (uRising & CIA_INPUT_CNT))
+	{
+		pCia->m_uShiftReg = (pCia->m_uShiftReg << 1) | ((uInputs & CIA_INPUT_SP) ? 1 : 0);
+
+		if (8 == ++pCia->m_uShiftBits)
+		{
+			pCia->m_uShiftBits = 0;
+			pCia->m_uSerialData = pCia->m_uShiftReg;
+			RaiseIrq(pCia, CIA_IRQ_SERIAL);
+		}
+	}
+
+	// Time Of Day Advances A Tenth Every 5 (50 Hz) Or 6 (60 Hz) TOD Pin Cycles.
+	if (uRising & CIA_INPUT_TOD)
+	{
+		if (++pCia->m_uTodTicks >= ((pCia->m_uControlA & CIA_CRA_TOD_50HZ) ? 5 : 6))
+		{
+			pCia->m_uTodTicks = 0;
+			TickTimeOfDay(pCia);
+		}
+	}
+
+	if (uFalling & CIA_INPUT_FLAG)
+		RaiseIrq(pCia, CIA_IRQ_FLAG);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Register Value As The CPU Would See It, Without Any Read Side Effects.                 ----
+//------------------------------------------------------------------------------------------------
+u8 __hot_path_func(Cia6526_Peek)(const Cia6526State* pCia, const u32 uRegister)
+{
+	switch(uRegister & 15)
+	{
+		case CIA_REG_PORTA:				return pCia->m_uPortA;
+		case CIA_REG_PORTB:				return (pCia->m_uPortB & ~pCia->m_uTimerPortBMask) | (pCia->m_uTimerPortB & pCia->m_uTimerPortBMask);
+		case CIA_REG_DATA_DIRA:			return pCia->m_uDataDirA;
+		case CIA_REG_DATA_DIRB:			return pCia->m_uDataDirB;
+		case CIA_REG_TIMERA_L:			return pCia->m_uTimerA & 0xFF;
+		case CIA_REG_TIMERA_H:			return pCia->m_uTimerA >> 8;
+		case CIA_REG_TIMERB_L:			return pCia->m_uTimerB & 0xFF;
+		case CIA_REG_TIMERB_H:			return pCia->m_uTimerB >> 8;
+		case CIA_REG_TOD_TENTHS:
+		case CIA_REG_TOD_SECONDS:
+		case CIA_REG_TOD_MINUTES:
+		case CIA_REG_TOD_HOURS:
+		{
+			const u32 uIndex = uRegister - CIA_REG_TOD_TENTHS;
+			return pCia->m_bTodLatched ? pCia->m_aTodLatch[uIndex] : pCia->m_aTod[uIndex];
+		}
+		case CIA_REG_SERIAL_DATA:		return pCia->m_uSerialData;
+		case CIA_REG_INTERRUPT_CONTROL:	return pCia->m_uInterruptFlags | (pCia->m_bIrq ? (1 << CIA_IRQ_SET_CLR) : 0);
+		case CIA_REG_CONTROL_A:			return pCia->m_uControlA & ~CIA_CR_FORCE_LOAD;
+		case CIA_REG_CONTROL_B:			return pCia->m_uControlB & ~CIA_CR_FORCE_LOAD;
+	}
+
+	return 0xFF;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- CPU Read - Ports Come From The Pins, ICR Clears On Read, TOD Latches On Hours.         ----
+//------------------------------------------------------------------------------------------------
+u8 __hot_path_func(Cia6526_Read)(Cia6526State* pCia, const u32 uRegister, const u8 uPinsA, const u8 uPinsB)
+{
+	switch(uRegister & 15)
+	{
+		case CIA_REG_PORTA:
+			return (uPinsA & ~pCia->m_uDataDirA) | (pCia->m_uPortA & pCia->m_uDataDirA);
+
+		case CIA_REG_PORTB:
+		{
+			const u8 uPortB = (uPinsB & ~pCia->m_uDataDirB) | (pCia->m_uPortB & pCia->m_uDataDirB);
+			return (uPortB & ~pCia->m_uTimerPortBMask) | (pCia->m_uTimerPortB & pCia->m_uTimerPortBMask);
+		}
+
+		case CIA_REG_TOD_HOURS:
+		{
+			// Freeze The Whole Clock Until Tenths Are Read.
+			if (!pCia->m_bTodLatched)
+			{
+				memcpy(pCia->m_aTodLatch, pCia->m_aTod, sizeof(pCia->m_aTodLatch));
+				pCia->m_bTodLatched = true;
+			}
+			return pCia->m_aTodLatch[3];
+		}
+
+		case CIA_REG_TOD_TENTHS:
+		{
+			const u8 uTenths = Cia6526_Peek(pCia, uRegister);
+			pCia->m_bTodLatched = false;
+			return uTenths;
+		}
+
+		case CIA_REG_INTERRUPT_CONTROL:
+		{
+			// Reading The ICR Acknowledges Every Flag.
+			const u8 uFlags = Cia6526_Peek(pCia, uRegister);
+			pCia->m_uInterruptFlags = 0;
+			pCia->m_bIrq = false;
+			return uFlags;
+		}
+	}
+
+	return Cia6526_Peek(pCia, uRegister);
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void __hot_path_func(Cia6526_Write)(Cia6526State* pCia, const u32 uRegister, const u8 uData)
+{
+	switch(uRegister & 15)
+	{
+		case CIA_REG_PORTA:			pCia->m_uPortA = uData;			break;
+		case CIA_REG_PORTB:			pCia->m_uPortB = uData;			break;
+		case CIA_REG_DATA_DIRA:		pCia->m_uDataDirA = uData;		break;
+		case CIA_REG_DATA_DIRB:		pCia->m_uDataDirB = uData;		break;
+
+		// Timer Writes Go To The Latch, The High Byte Also Loads A Stopped Timer.
+		case CIA_REG_TIMERA_L:
+			pCia->m_uTimerA_Latch = (pCia->m_uTimerA_Latch & 0xFF00) | uData;
+		break;
+
+		case CIA_REG_TIMERA_H:
+			pCia->m_uTimerA_Latch = (pCia->m_uTimerA_Latch & 0x00FF) | (uData << 8);
+			if (0 == (pCia->m_uControlA & CIA_CR_START))
+				pCia->m_uTimerA = pCia->m_uTimerA_Latch;
+		break;
+
+		case CIA_REG_TIMERB_L:
+			pCia->m_uTimerB_Latch = (pCia->m_uTimerB_Latch & 0xFF00) | uData;
+		break;
+
+		case CIA_REG_TIMERB_H:
+			pCia->m_uTimerB_Latch = (pCia->m_uTimerB_Latch & 0x00FF) | (uData << 8);
+			if (0 == (pCia->m_uControlB & CIA_CR_START))
+				pCia->m_uTimerB = pCia->m_uTimerB_Latch;
+		break;
+
+		// TOD Writes Set The Alarm When CRB Bit 7 Is High. Hours Stops The Clock, Tenths Restarts It.
+		case CIA_REG_TOD_TENTHS:
+		case CIA_REG_TOD_SECONDS:
+		case CIA_REG_TOD_MINUTES:
+		case CIA_REG_TOD_HOURS:
+		{
+			const u32 uIndex = uRegister - CIA_REG_TOD_TENTHS;
+			const u8 uMask = (3 == uIndex) ? 0x9F : (0 == uIndex) ? 0x0F : 0x7F;
+
+			if (pCia->m_uControlB & CIA_CRB_WRITE_ALARM)
+			{
+				pCia->m_aAlarm[uIndex] = uData & uMask;
+			}
+			else
+			{
+				pCia->m_aTod[uIndex] = uData & uMask;
+
+				if (3 == uIndex)
+					pCia->m_bTodStopped = true;
+				else if (0 == uIndex)
+				{
+					pCia->m_bTodStopped = false;
+					pCia->m_uTodTicks = 0;
+				}
+			}
+		}
+		break;
+
+		case CIA_REG_SERIAL_DATA:
+		{
+			pCia->m_uSerialData = uData;
+
+			if (pCia->m_uControlA & CIA_CRA_SERIAL_OUT)
+			{
+				if (pCia->m_uShiftBits)
+					pCia->m_bSerialPending = true;
+				else
+				{
+					pCia->m_uShiftReg = uData;
+					pCia->m_uShiftBits = 8;
+				}
+			}
+		}
+		break;
+
+		case CIA_REG_INTERRUPT_CONTROL:
+		{
+			if (uData & 0x80)
+				pCia->m_uInterruptMask |= (uData & 0x1F);		// Bit 7 Is High So Enable Any Specified Interrupts.
+			else
+				pCia->m_uInterruptMask &= ~uData;				// Bit 7 Is Low So Disable Any Specified Interrupts.
+
+			UpdateIrq(pCia);
+		}
+		break;
+
+		case CIA_REG_CONTROL_A:
+		{
+			// Starting The Timer With PB6 Toggle Output Begins High.
+			if ((uData & CIA_CR_START) && (0 == (pCia->m_uControlA & CIA_CR_START)))
+				pCia->m_uTimerPortB |= CIA_PB6;
+
+			if (uData & CIA_CR_FORCE_LOAD)
+				pCia->m_uTimerA = pCia->m_uTimerA_Latch;
+
+			// Changing Serial Direction Abandons Any Byte In Progress.
+			if ((uData ^ pCia->m_uControlA) & CIA_CRA_SERIAL_OUT)
+			{
+				pCia->m_uShiftBits = 0;
+				pCia->m_bSerialPending = false;
+				pCia->m_bCntOut = true;
+			}
+
+			pCia->m_uControlA = uData & ~CIA_CR_FORCE_LOAD;
+			pCia->m_uTimerPortBMask = (pCia->m_uTimerPortBMask & ~CIA_PB6) | ((uData & CIA_CR_PB_ON) ? CIA_PB6 : 0);
+		}
+		break;
+
+		case CIA_REG_CONTROL_B:
+		{
+			if ((uData & CIA_CR_START) && (0 == (pCia->m_uControlB & CIA_CR_START)))
+				pCia->m_uTimerPortB |= CIA_PB7;
+
+			if (uData & CIA_CR_FORCE_LOAD)
+				pCia->m_uTimerB = pCia->m_uTimerB_Latch;
+
+			pCia->m_uControlB = uData & ~CIA_CR_FORCE_LOAD;
+			pCia->m_uTimerPortBMask = (pCia->m_uTimerPortBMask & ~CIA_PB7) | ((uData & CIA_CR_PB_ON) ? CIA_PB7 : 0);
+		}
+		break;
+	}
+}
@@ -0,0 +1,112 @@
+//------------------------------------------------------------------------------------------------
+//---- CIA 6526 ... 2026 Dave Gaunt                                                           ----
+//------------------------------------------------------------------------------------------------
+//---- 6526 CIA Personality For The VIA Bus Front End - Selected With PERSONALITY_CIA_6526.   ----
+//------------------------------------------------------------------------------------------------
+#ifndef __Cia6526_h_included
+#define __Cia6526_h_included
+
+#include "types.h"
+
+enum cia_register_names
+{
+	CIA_REG_PORTA = 0,
+	CIA_REG_PORTB,
+	CIA_REG_DATA_DIRA,
+	CIA_REG_DATA_DIRB,
+	CIA_REG_TIMERA_L,
+	CIA_REG_TIMERA_H,
+	CIA_REG_TIMERB_L,
+	CIA_REG_TIMERB_H,
+	CIA_REG_TOD_TENTHS,
+	CIA_REG_TOD_SECONDS,
+	CIA_REG_TOD_MINUTES,
+	CIA_REG_TOD_HOURS,
+	CIA_REG_SERIAL_DATA,
+	CIA_REG_INTERRUPT_CONTROL,
+	CIA_REG_CONTROL_A,
+	CIA_REG_CONTROL_B
+};
+
+enum cia_irq_flags
+{
+	CIA_IRQ_TIMERA = 0,
+	CIA_IRQ_TIMERB,
+	CIA_IRQ_ALARM,
+	CIA_IRQ_SERIAL,
+	CIA_IRQ_FLAG,
+	CIA_IRQ_SET_CLR = 7
+};
+
+// Control Register A / B Bits
+#define CIA_CR_START			(1 << 0)
+#define CIA_CR_PB_ON			(1 << 1)
+#define CIA_CR_TOGGLE			(1 << 2)		/* 1 = Toggle PB6/PB7, 0 = One Cycle Pulse */
+#define CIA_CR_ONE_SHOT			(1 << 3)
+#define CIA_CR_FORCE_LOAD		(1 << 4)		/* Strobe, Always Reads Back As 0 */
+#define CIA_CRA_COUNT_CNT		(1 << 5)
+#define CIA_CRA_SERIAL_OUT		(1 << 6)
+#define CIA_CRA_TOD_50HZ		(1 << 7)
+#define CIA_CRB_INMODE_SHIFT	(5)
+#define CIA_CRB_INMODE_MASK		(3 << CIA_CRB_INMODE_SHIFT)
+#define CIA_CRB_WRITE_ALARM		(1 << 7)
+
+enum cia_timerb_inmode
+{
+	CIA_TB_COUNT_PHI2 = 0,
+	CIA_TB_COUNT_CNT,
+	CIA_TB_COUNT_TIMERA,
+	CIA_TB_COUNT_TIMERA_CNT
+};
+
+// Input Pin Bits Passed To Cia6526_Tick
+#define CIA_INPUT_CNT			(1 << 0)
+#define CIA_INPUT_SP			(1 << 1)
+#define CIA_INPUT_TOD			(1 << 2)
+#define CIA_INPUT_FLAG			(1 << 3)
+
+typedef struct
+{
+	u8	m_uPortA;
+	u8	m_uPortB;
+	u8	m_uDataDirA;
+	u8	m_uDataDirB;
+
+	u16	m_uTimerA;
+	u16	m_uTimerA_Latch;
+	u16	m_uTimerB;
+	u16	m_uTimerB_Latch;
+
+	u8	m_aTod[4];					/* Tenths, Seconds, Minutes, Hours - All BCD */
+	u8	m_aTodLatch[4];
+	u8	m_aAlarm[4];
+	u8	m_uTodTicks;
+	bool m_bTodLatched;
+	bool m_bTodStopped;
+
+	u8	m_uSerialData;
+	u8	m_uShiftReg;
+	u8	m_uShiftBits;				/* Bits Still To Shift, 0 = Idle */
+	bool m_bSerialPending;			/* SDR Written While Shifting Out */
+	bool m_bCntOut;
+	bool m_bSpOut;
+
+	u8	m_uInterruptFlags;
+	u8	m_uInterruptMask;
+	bool m_bIrq;
+
+	u8	m_uControlA;
+	u8	m_uControlB;
+
+	u8	m_uTimerPortB;				/* PB6 / PB7 Timer Output Levels */
+	u8	m_uTimerPortBMask;			/* Which Of PB6 / PB7 The Timers Own */
+	u8	m_uLastInputs;
+} Cia6526State;
+
+void Cia6526_Reset(Cia6526State* pCia);
+void Cia6526_Tick(Cia6526State* pCia, const u32 uInputs);
+u8 Cia6526_Read(Cia6526State* pCia, const u32 uRegister, const u8 uPinsA, const u8 uPinsB);
+u8 Cia6526_Peek(const Cia6526State* pCia, const u32 uRegister);
+void Cia6526_Write(Cia6526State* pCia, const u32 uRegister, const u8 uData);
+
+#endif /* __Cia6526_h_included */
@@ -0,0 +1,161 @@
+//------------------------------------------------------------------------------------------------
+//---- Register Page ... 2026 Dave Gaunt                                                      ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include <stdio.h>
+
+#include "RegisterPage.h"
+
+// Register Name Strings For Debug View.
+#if PERSONALITY_CIA_6526
+static const char s_aszRegisterNames[16][16] =
+{
+/*  "123456789ABCDEF"	*/
+	"Port A",
+	"Port B",
+	"Dir A",
+	"Dir B",
+	"Timer A L",
+	"Timer A H",
+	"Timer B L",
+	"Timer B H",
+	"TOD 10ths",
+	"TOD Secs",
+	"TOD Mins",
+	"TOD Hours",
+	"Serial Data",
+	"Int Control",
+	"Ctrl A",
+	"Ctrl B"
+/*  "123456789ABCDEF"	*/
+};
+#else
+static const char s_aszRegisterNames[16][16] =
+{
+/*  "123456789ABCDEF"	*/
+	"Port B",
+	"Port A",
+	"Dir B",
+	"Dir A",
+	"Timer 1 L",
+	"Timer 1 H",
+	"T1 Latch L",
+	"T1 Latch H",
+	"Timer 2 L",
+	"Timer 2 H",
+	"Shift Reg",
+	"Aux Ctrl",
+	"Periph Ctrl",
+	"Int Flags",
+	"Int Enable",
+	"PA No HShake"
+/*  "123456789ABCDEF"	*/
+};
+#endif
+
+//------------------------------------------------------------------------------------------------
+//---- Border, Title, Addresses And Names - Everything That Never Changes.                    ----
+//------------------------------------------------------------------------------------------------
+void RegisterPage_Draw(void)
+{
+	FilledRectangle(0, 0, VGA_RESOLUTION_X, VGA_RESOLUTION_Y, RGB_GREEN);
+	FilledRectangle(1, 1, VGA_RESOLUTION_X-2, VGA_RESOLUTION_Y-2, RGB_BLACK);
+
+	// Draw All The Constant Text To The Screen
+	char szTempString[128];
+	DrawString(20, 18, REGISTER_PAGE_TITLE, RGB_CYAN);
+
+	for (u32 uRegisterIndex=0; uRegisterIndex<16; ++uRegisterIndex)
+	{
+		sprintf(szTempString, "0x%04X", REGISTER_BASE_ADDRESS + uRegisterIndex);
+		DrawString(13, REGISTER_PAGE_TOP + uRegisterIndex, szTempString, RGB_BLUE);
+		DrawString(20, REGISTER_PAGE_TOP + uRegisterIndex, "0x", RGB_YELLOW);
+		DrawString(25, REGISTER_PAGE_TOP + uRegisterIndex, s_aszRegisterNames[uRegisterIndex], RGB_CYAN);
+	}
+
+#if REGISTER_PAGE_STATS
+	DrawString(REGISTER_STATS_COLUMN, REGISTER_PAGE_TOP - 1, " READ/S WRITE/S  IDLE CYC", RGB_BLUE);
+
+	for (u32 uRegisterIndex=0; uRegisterIndex<16; ++uRegisterIndex)
+		RegisterPage_UpdateStats(uRegisterIndex, 0, 0, REGISTER_NEVER_ACCESSED);
+#endif
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Write The Register Value To The Appropriate Screen Position.                           ----
+//------------------------------------------------------------------------------------------------
+void __hot_path_func(RegisterPage_Update)(const u32 uRegister, const u8 uValue)
+{
+	const u16 uHexPair = byteToHex(uValue);
+	DrawPetsciiChar(22 << 3, (REGISTER_PAGE_TOP + uRegister) << 3, uHexPair >> 8, RGB_YELLOW);
+	DrawPetsciiChar(23 << 3, (REGISTER_PAGE_TOP + uRegister) << 3, uHexPair & 255, RGB_YELLOW);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Unused Is Black, Then Blue, Cyan, Green, Yellow And Red From 1, 100, 1K, 10K And 100K  ----
+//---- Accesses A Second.                                                                     ----
+//------------------------------------------------------------------------------------------------
+static u8 HeatColour(const u32 uAccessesPerSecond)
+{
+	static const u32 s_aHeatThresholds[] = { 1, 100, 1000, 10000, 100000 };
+	static const u8 s_aHeatColours[] = { RGB_BLACK, RGB_BLUE, RGB_CYAN, RGB_GREEN, RGB_YELLOW, RGB_RED };
+	u32 uHeat = 0;
+
+	while ((uHeat < 5) && (uAccessesPerSecond >= s_aHeatThresholds[uHeat]))
+		++uHeat;
+
+	return s_aHeatColours[uHeat];
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Heat Block, Reads And Writes A Second, And Bus Cycles Since The Last Access.           ----
+//------------------------------------------------------------------------------------------------
+void RegisterPage_UpdateStats(const u32 uRegister, const u32 uReadsPerSecond, const u32 uWritesPerSecond, const u32 uIdleCycles)
+{
+	const u32 uRow = REGISTER_PAGE_TOP + uRegister;
+	char szTempString[32];
+
+	FilledRectangle((REGISTER_HEAT_COLUMN << 3) + 1, (uRow << 3) + 1, 14, 6, HeatColour(uReadsPerSecond + uWritesPerSecond));
+
+	if (REGISTER_NEVER_ACCESSED == uIdleCycles)
+		sprintf(szTempString, "%7u %7u         -", uReadsPerSecond, uWritesPerSecond);
+	else
+		sprintf(szTempString, "%7u %7u %9u", uReadsPerSecond, uWritesPerSecond, (uIdleCycles > 999999999) ? 999999999 : uIdleCycles);
+
+	DrawString(REGISTER_STATS_COLUMN, uRow, szTempString, RGB_WHITE);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Flash Reads In The Last Second And How Many The XIP Cache Missed - Near Zero Misses    ----
+//---- Once Running Means Nothing On The Hot Paths Is Left In Flash.                          ----
+//------------------------------------------------------------------------------------------------
+void RegisterPage_UpdateXip(const u32 uAccesses, const u32 uHits)
+{
+	char szTempString[80];
+
+	const u32 uMisses = uAccesses - uHits;
+	const u32 uHitTenths = uAccesses ? (u32)(((float)uHits * 1000.0f) / uAccesses) : 1000;
+
+	sprintf(szTempString, "XIP ACC/S %9u  MISS/S %9u  HIT %3u.%u%%", uAccesses, uMisses, uHitTenths / 10, uHitTenths % 10);
+	DrawString(13, REGISTER_XIP_ROW, szTempString, RGB_BLUE);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Core0 Time Asleep, Wake Ups A Second, And The Longest Background Slice And Event Task. ----
+//------------------------------------------------------------------------------------------------
+void RegisterPage_UpdateScheduler(const u32 uIdlePercent, const u32 uWakeUps, const u32 uMaxSliceCycles, const u32 uMaxEventCycles)
+{
+	char szTempString[80];
+
+	sprintf(szTempString, "IDLE %3u%%  WAKE/S %6u  SLICE %7u  EVENT %7u CYC", uIdlePercent, uWakeUps, uMaxSliceCycles, uMaxEventCycles);
+	DrawString(13, REGISTER_SCHEDULER_ROW, szTempString, RGB_BLUE);
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+const char* RegisterPage_GetName(const u32 uRegister)
+{
+	return s_aszRegisterNames[uRegister & 15];
+}
@@ -0,0 +1,46 @@
+//------------------------------------------------------------------------------------------------
+//---- Register Page ... 2026 Dave Gaunt                                                      ----
+//------------------------------------------------------------------------------------------------
+//---- The Debug View - 16 Registers With The Console Underneath. Only Draws, So The Host     ----
+//---- Render Tests Build It Exactly As The Firmware Does.                                    ----
+//------------------------------------------------------------------------------------------------
+#ifndef __RegisterPage_h_included
+#define __RegisterPage_h_included
+
+#include "types.h"
+#include "VgaDisplay.h"
+
+#if PERSONALITY_CIA_6526
+#define REGISTER_PAGE_TITLE		"CIA 6526"
+#define REGISTER_BASE_ADDRESS	(0xDC00)
+#else
+#define REGISTER_PAGE_TITLE		"VIA 6522"
+#define REGISTER_BASE_ADDRESS	(0x9110)
+#endif
+
+// Access Counts For Each Register To The Right Of Its Name.
+#define REGISTER_PAGE_STATS		(1)
+#define REGISTER_NEVER_ACCESSED	(0xFFFFFFFF)	/* Idle Cycles For A Register Not Touched Yet */
+
+// Page Layout In 8x8 Characters - Laid Out For The 80 x 60 Text Grid.
+#define REGISTER_PAGE_TOP		(20)			/* Text Row Of The First Register */
+#define REGISTER_HEAT_COLUMN	(41)			/* Two Characters Wide */
+#define REGISTER_STATS_COLUMN	(44)
+#define REGISTER_XIP_ROW		(REGISTER_PAGE_TOP + 16)
+#define REGISTER_SCHEDULER_ROW	(REGISTER_PAGE_TOP + 17)
+#define REGISTER_PAGE_RIGHT		(71)			/* Column After The Scheduler Row, The Widest */
+
+// VGA Console Window Below The Register Page, In 8x8 Characters.
+#define CONSOLE_LEFT			(1)
+#define CONSOLE_TOP				(38)
+#define CONSOLE_WIDE			(TERMINAL_CHARS_WIDE - 2)
+#define CONSOLE_HIGH			(21)
+
+void RegisterPage_Draw(void);
+void RegisterPage_Update(const u32 uRegister, const u8 uValue);
+void RegisterPage_UpdateStats(const u32 uRegister, const u32 uReadsPerSecond, const u32 uWritesPerSecond, const u32 uIdleCycles);
+void RegisterPage_UpdateXip(const u32 uAccesses, const u32 uHits);
+void RegisterPage_UpdateScheduler(const u32 uIdlePercent, const u32 uWakeUps, const u32 uMaxSliceCycles, const u32 uMaxEventCycles);
+const char* RegisterPage_GetName(const u32 uRegister);
+
+#endif /* __RegisterPage_h_included */
@@ -0,0 +1,288 @@
+//------------------------------------------------------------------------------------------------
+//---- Remote Link ... 2026 Dave Gaunt                                                        ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include <string.h>
+
+#include "RemoteLink.h"
+
+#define REMOTE_TRACE_PER_FRAME		((USB_LINK_MAX_PAYLOAD - 8) / 4)
+#define REMOTE_TRACE_MARGIN			(64)			/* Entries Core1 May Be About To Write Over */
+#define REMOTE_PINS_PER_FRAME		(USB_LINK_MAX_PAYLOAD / 8)
+
+static bool s_bTraceStreaming = false;
+static u32 s_uTraceTail = 0;
+static u32 s_uTraceDropped = 0;
+static u8 s_uTraceSequence = 0;
+static UsbLinkFrame s_traceFrame;
+
+//------------------------------------------------------------------------------------------------
+//---- Everything On The Wire Is Little Endian.                                               ----
+//------------------------------------------------------------------------------------------------
+static inline void PutU32(u8* pOut, const u32 uValue)
+{
+	pOut[0] = uValue & 0xFF;
+	pOut[1] = (uValue >> 8) & 0xFF;
+	pOut[2] = (uValue >> 16) & 0xFF;
+	pOut[3] = uValue >> 24;
+}
+
+static inline u32 GetU16(const u8* pIn)
+{
+	return pIn[0] | (pIn[1] << 8);
+}
+
+static inline u32 GetU32(const u8* pIn)
+{
+	return pIn[0] | (pIn[1] << 8) | (pIn[2] << 16) | ((u32)pIn[3] << 24);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- uCount Entries Starting At uFirst, Oldest First.                                       ----
+//------------------------------------------------------------------------------------------------
+static u32 CopyTrace(u8* pOut, const u32 uFirst, const u32 uCount)
+{
+	for (u32 uEntry=0; uEntry<uCount; ++uEntry)
+		PutU32(&pOut[uEntry * 4], RemoteHal_GetTraceEntry((uFirst + uEntry) & (REMOTE_TRACE_SIZE - 1)));
+
+	return uCount * 4;
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+static u32 HandleCommand(const UsbLinkFrame* pRequest, UsbLinkFrame* pResponse)
+{
+	const u8* pIn = pRequest->m_aPayload;
+	u8* pOut = pResponse->m_aPayload;
+
+	switch(pRequest->m_uCommand)
+	{
+		case REMOTE_PING:
+		{
+			for (u32 uByte=0; uByte<pRequest->m_uLength; ++uByte)
+				pOut[uByte] = pIn[uByte];
+
+			pResponse->m_uLength = pRequest->m_uLength;
+		}
+		break;
+
+		case REMOTE_PEEK:
+		{
+			for (u32 uByte=0; uByte<pRequest->m_uLength; ++uByte)
+			{
+				if (pIn[uByte] > 15)
+					return USB_LINK_ERROR_BAD_ARGUMENT;
+
+				pOut[uByte] = RemoteHal_Peek(pIn[uByte]);
+			}
+
+			pResponse->m_uLength = pRequest->m_uLength;
+		}
+		break;
+
+		case REMOTE_POKE:
+		{
+			if (pRequest->m_uLength & 1)
+				return USB_LINK_ERROR_BAD_LENGTH;
+
+			for (u32 uByte=0; uByte<pRequest->m_uLength; uByte+=2)
+			{
+				if (pIn[uByte] > 15)
+					return USB_LINK_ERROR_BAD_ARGUMENT;
+
+				if (!RemoteHal_Poke(pIn[uByte], pIn[uByte + 1]))
+					return USB_LINK_ERROR_UNSUPPORTED;
+			}
+		}
+		break;
+
+		case REMOTE_PINS:
+		{
+			if (2 != pRequest->m_uLength)
+				return USB_LINK_ERROR_BAD_LENGTH;
+
+			const u32 uCount = GetU16(pIn);
+
+			if ((0 == uCount) || (uCount > REMOTE_PINS_PER_FRAME))
+				return USB_LINK_ERROR_BAD_ARGUMENT;
+
+			// Sampled Back To Back First, So The Packing Does Not Slow The Sampling.
+			u32 aPins[REMOTE_PINS_PER_FRAME][2];
+
+			for (u32 uSample=0; uSample<uCount; ++uSample)
+				RemoteHal_SamplePins(aPins[uSample]);
+
+			for (u32 uSample=0; uSample<uCount; ++uSample)
+			{
+				PutU32(&pOut[uSample * 8], aPins[uSample][0]);
+				PutU32(&pOut[(uSample * 8) + 4], aPins[uSample][1]);
+			}
+
+			pResponse->m_uLength = uCount * 8;
+		}
+		break;
+
+		case REMOTE_STATS:
+		{
+			u32 aStats[REMOTE_STATS_WORDS];
+			RemoteHal_GetStats(aStats);
+
+			for (u32 uWord=0; uWord<REMOTE_STATS_WORDS; ++uWord)
+				PutU32(&pOut[uWord * 4], aStats[uWord]);
+
+			pResponse->m_uLength = REMOTE_STATS_WORDS * 4;
+		}
+		break;
+
+		case REMOTE_CAPTURE:
+		{
+			if (2 != pRequest->m_uLength)
+				return USB_LINK_ERROR_BAD_LENGTH;
+
+			const u32 uHead = RemoteHal_GetTraceHead();
+			u32 uCount = GetU16(pIn);
+
+			if (uCount > REMOTE_TRACE_PER_FRAME)
+				return USB_LINK_ERROR_BAD_ARGUMENT;
+
+			if (uCount > uHead)
+				uCount = uHead;
+
+			PutU32(pOut, uHead);
+			pResponse->m_uLength = 4 + CopyTrace(&pOut[4], uHead - uCount, uCount);
+		}
+		break;
+
+		case REMOTE_TRACE:
+		{
+			if (1 != pRequest->m_uLength)
+				return USB_LINK_ERROR_BAD_LENGTH;
+
+			const u32 uHead = RemoteHal_GetTraceHead();
+
+			s_bTraceStreaming = (0 != pIn[0]);
+			s_uTraceTail = uHead;
+			s_uTraceDropped = 0;
+
+			PutU32(pOut, uHead);
+			pResponse->m_uLength = 4;
+		}
+		break;
+
+		case REMOTE_SNAPSHOT:
+		{
+			if (8 == pRequest->m_uLength)
+			{
+				if (!RemoteHal_ArmSnapshot(GetU32(pIn), GetU32(&pIn[4])))
+					return USB_LINK_ERROR_UNSUPPORTED;
+			}
+			else if (0 == pRequest->m_uLength)
+			{
+				ViaSnapshot snapshot;
+
+				if (RemoteHal_GetSnapshot(&snapshot))
+				{
+					memcpy(pOut, &snapshot, sizeof(snapshot));
+					pResponse->m_uLength = sizeof(snapshot);
+				}
+			}
+			else
+				return USB_LINK_ERROR_BAD_LENGTH;
+		}
+		break;
+
+		case REMOTE_RESTORE:
+		{
+			if (sizeof(ViaSnapshot) != pRequest->m_uLength)
+				return USB_LINK_ERROR_BAD_LENGTH;
+
+			// The Payload Has No Particular Alignment.
+			ViaSnapshot snapshot;
+			memcpy(&snapshot, pIn, sizeof(snapshot));
+
+			if (!ViaSnapshot_IsValid(&snapshot))
+				return USB_LINK_ERROR_BAD_ARGUMENT;
+
+			bool bApplied = false;
+			const u32 uError = RemoteHal_Restore(&snapshot, &bApplied);
+
+			if (USB_LINK_ERROR_NONE != uError)
+				return uError;
+
+			pOut[0] = bApplied ? 1 : 0;
+			pResponse->m_uLength = 1;
+		}
+		break;
+
+		default:
+			return USB_LINK_ERROR_UNKNOWN_COMMAND;
+	}
+
+	return USB_LINK_ERROR_NONE;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Core1 Never Waits For This - Anything The Link Falls Too Far Behind On Is Counted.     ----
+//------------------------------------------------------------------------------------------------
+static void StreamTrace(void)
+{
+	const u32 uHead = RemoteHal_GetTraceHead();
+
+	if ((uHead - s_uTraceTail) > (REMOTE_TRACE_SIZE - REMOTE_TRACE_MARGIN))
+	{
+		const u32 uNewTail = uHead - (REMOTE_TRACE_SIZE - REMOTE_TRACE_MARGIN);
+		s_uTraceDropped += uNewTail - s_uTraceTail;
+		s_uTraceTail = uNewTail;
+	}
+
+	while (s_uTraceTail != uHead)
+	{
+		u32 uCount = uHead - s_uTraceTail;
+
+		if (uCount > REMOTE_TRACE_PER_FRAME)
+			uCount = REMOTE_TRACE_PER_FRAME;
+
+		// Always Leave Room For A Reply, Or Commands Would Stop Being Read Mid Stream.
+		if (UsbLink_GetTxSpace() < (USB_LINK_HEADER_SIZE + 8 + (uCount * 4) + USB_LINK_CRC_SIZE + USB_LINK_MAX_FRAME))
+			break;
+
+		s_traceFrame.m_uCommand = REMOTE_TRACE_DATA;
+		s_traceFrame.m_uSequence = s_uTraceSequence++;
+		PutU32(&s_traceFrame.m_aPayload[0], s_uTraceDropped);
+		PutU32(&s_traceFrame.m_aPayload[4], s_uTraceTail);
+		s_traceFrame.m_uLength = 8 + CopyTrace(&s_traceFrame.m_aPayload[8], s_uTraceTail, uCount);
+
+		UsbLink_Send(&s_traceFrame);
+		s_uTraceTail += uCount;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void RemoteLink_Init(void)
+{
+	UsbLink_Init(HandleCommand);
+	s_bTraceStreaming = false;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Call From The Main Loop After tud_task.                                                ----
+//------------------------------------------------------------------------------------------------
+void RemoteLink_Service(void)
+{
+	if (s_bTraceStreaming)
+		StreamTrace();
+
+	UsbLink_Service();
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+u32 RemoteLink_GetTraceDropped(void)
+{
+	return s_uTraceDropped;
+}
@@ -0,0 +1,55 @@
+//------------------------------------------------------------------------------------------------
+//---- Remote Link ... 2026 Dave Gaunt                                                        ----
+//------------------------------------------------------------------------------------------------
+//---- The Commands Host/usb_link.py Sends Over The USB Link - Batched Peek And Poke, Pin     ----
+//---- Samples, The Access Counters, The Bus Trace Downloaded Or Streamed, And Snapshots.     ----
+//------------------------------------------------------------------------------------------------
+#ifndef __RemoteLink_h_included
+#define __RemoteLink_h_included
+
+#include "types.h"
+#include "UsbLink.h"
+#include "ViaSnapshot.h"
+
+#define REMOTE_TRACE_SIZE			(4096)			/* Entries, Must Be A Power Of 2! */
+#define REMOTE_TRACE_WRITE			(1u << 4)
+#define REMOTE_STATS_WORDS			(1 + (16 * 3))	/* Bus Cycle, Then Reads, Writes, Last Cycle Each */
+
+enum remote_commands
+{
+	REMOTE_PING = 0x01,				/* Payload Echoed */
+	REMOTE_PEEK,					/* Register Numbers In, Values Out */
+	REMOTE_POKE,					/* Register, Value Pairs - Written In Order */
+	REMOTE_PINS,					/* Count In, That Many GPIO 0-31, 32-47 Word Pairs Out */
+	REMOTE_STATS,					/* REMOTE_STATS_WORDS Out */
+	REMOTE_CAPTURE,					/* Count In, Trace Head Then The Latest Entries Out */
+	REMOTE_TRACE,					/* 1 = Start Streaming, 0 = Stop, Trace Head Out */
+	REMOTE_SNAPSHOT,				/* Match, Mask In = Arm, Nothing In = The Snapshot Out If Taken */
+	REMOTE_RESTORE,					/* Snapshot In, 1 = Applied, 0 = Waiting For S02 Out */
+	REMOTE_TRACE_DATA = 0x40		/* Sent Unasked - Dropped Count, First Index, Entries */
+};
+
+//------------------------------------------------------------------------------------------------
+//---- Bits 0-3 Register, Bit 4 Write, Bits 8-15 Data, Bits 16-31 Low Half Of The Bus Cycle.  ----
+//------------------------------------------------------------------------------------------------
+static inline u32 RemoteLink_TraceEntry(const u32 uRegister, const u32 uData, const u32 uWrite, const u32 uBusCycle)
+{
+	return uRegister | uWrite | (uData << 8) | (uBusCycle << 16);
+}
+
+// Supplied By The Firmware - Or By The Host Test, Which Builds This Without The SDK.
+u8 RemoteHal_Peek(const u32 uRegister);
+bool RemoteHal_Poke(const u32 uRegister, const u8 uData);
+void RemoteHal_SamplePins(u32 aPins[2]);
+void RemoteHal_GetStats(u32 aStats[REMOTE_STATS_WORDS]);
+u32 RemoteHal_GetTraceHead(void);
+u32 RemoteHal_GetTraceEntry(const u32 uIndex);
+bool RemoteHal_ArmSnapshot(const u32 uMatch, const u32 uMask);
+bool RemoteHal_GetSnapshot(ViaSnapshot* pSnapshot);
+u32 RemoteHal_Restore(const ViaSnapshot* pSnapshot, bool* pbApplied);	/* A usb_link_errors Code */
+
+void RemoteLink_Init(void);
+void RemoteLink_Service(void);
+u32 RemoteLink_GetTraceDropped(void);
+
+#endif /* __RemoteLink_h_included */
@@ -7,381 +7,217 @@
 #include "types.h"
 
 #include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
 #include "pico/multicore.h"
 
 #include "hardware/pio.h"
 #include "hardware/dma.h"
+#include "hardware/sync.h"
+#include "hardware/structs/xip_ctrl.h"
 
-#include "hsync.pio.h"
-#include "vsync.pio.h"
-#include "rgb.pio.h"
+#include "tusb.h"
 
-#include "VicChars.h"
+#include "ClockPlan.h"
+#include "PinMap.h"
+#include "VgaDisplay.h"
+#include "VgaConsole.h"
+#include "VgaSnapshot.h"
+#include "RegisterPage.h"
+#include "RemoteLink.h"
+#include "Scheduler.h"
+#include "LogicScope.h"
 
-#define VGA_RESOLUTION_X    	(640)
-#define VGA_RESOLUTION_Y  		(480)
-#define TERMINAL_CHARS_WIDE		(VGA_RESOLUTION_X >> 3)
-#define TERMINAL_CHARS_HIGH		(VGA_RESOLUTION_Y >> 3)
+// Echo Every Register Write Processed On Core0 To The VGA Console.
+#define LOG_REGISTER_WRITES		(0)
 
-enum device_pins {
-	PIN_RED = 0,
-	PIN_GREEN,
-	PIN_BLUE,
-	PIN_S02_READ,
-	PIN_HSYNC = 8,
-	PIN_VSYNC,
+// Print The CRC Of The Freshly Drawn Register Page - Host/render_golden_test.py Prints The Same.
+#define LOG_PAGE_CRC			(0)
 
-	PIN_RESET,
-	PIN_ADDRESS_CS1,		/* ADDRESS BIT 4 OR 5 On VIC */
-	PIN_IO0,				/* CS2 ACTIVE LOW */
-	PIN_READ_WRITE,
-	PIN_IRQ,
+#define CONSOLE_CHARS_PER_PASS	(32)
 
-	PIN_DATA_BIT0,
-	PIN_DATA_BIT1,
-	PIN_DATA_BIT2,
-	PIN_DATA_BIT3,
-	PIN_DATA_BIT4,
-	PIN_DATA_BIT5,
-	PIN_DATA_BIT6,
-	PIN_DATA_BIT7,
+// Core1 Rings Core0 Each Time The Trace Crosses Into The Other Half.
+#define TRACE_SIGNAL_MASK		((REMOTE_TRACE_SIZE / 2) - 1)
 
-	PIN_CLK,				/* S02 - Data Transfer Occurs Only When Phase 2 Clock Is High */
-	PIN_ADDRESS_BIT0,
-	PIN_ADDRESS_BIT1,
-	PIN_ADDRESS_BIT2,
-	PIN_ADDRESS_BIT3,
+// Binary Commands And The Bus Trace Over USB CDC - See Host/usb_link.py.
+#define REMOTE_LINK				(1)
 
-	PIN_PORT_A = 32,
-	PIN_PORT_B = 40
-};
+// Core1 Copies The VIA Out When A Bus Access Matches A Trigger, And Puts One Back - Over The Link.
+#define VIA_SNAPSHOT			(REMOTE_LINK && !PERSONALITY_CIA_6526)
 
-static_assert(23 == PIN_CLK, "Clock must be on PIN 23!");
+// How Long A Restore Waits For Core1 To Pick It Up Before Replying That It Is Still Waiting.
+#define RESTORE_WAIT_US			(1000)
 
-enum rgbColours {RGB_BLACK, RGB_RED, RGB_GREEN, RGB_YELLOW, RGB_BLUE, RGB_MAGENTA, RGB_CYAN, RGB_WHITE};
+// Port A, Port B And #IRQ Rolling Across The Top Of The Page, A Column Every N Phase 2 Cycles.
+#define LOGIC_SCOPE				(1)
+#define LOGIC_SCOPE_DECIMATE	(1024)			/* About 18 Columns A Frame At The VIC's Clock */
+#define LOGIC_SCOPE_X			(8)
+#define LOGIC_SCOPE_Y			(12)
 
-u8 volatile aVGAScreenBuffer[(VGA_RESOLUTION_X * VGA_RESOLUTION_Y) >> 1];
-volatile u8* address_pointer = aVGAScreenBuffer;
+#include "Via6522.h"
+#include "ViaSnapshot.h"
+#include "ViaWriteRing.h"
+#if PERSONALITY_CIA_6526
+#include "Cia6526.h"
+#else
+#include "ViaPb7.h"
+#endif
 
-//------------------------------------------------------------------------------------------------
-//----                                                                                        ----
-//------------------------------------------------------------------------------------------------
-enum via_register_names
-{
-	VIA_REG_PORTB = 0,
-	VIA_REG_PORTA,
-	VIA_REG_DATA_DIRB,
-	VIA_REG_DATA_DIRA,
-	VIA_REG_TIMER1_L,
-	VIA_REG_TIMER1_H,
-	VIA_REG_TIMER1_LATCH_L,
-	VIA_REG_TIMER1_LATCH_H,
-	VIA_REG_TIMER2_L,
-	VIA_REG_TIMER2_H,
-	VIA_REG_SHIFT,
-	VIA_REG_AUXILIARY_CONTROL,
-	VIA_REG_PERIPHERAL_CONTROL,
-	VIA_REG_INTERRUPT_FLAGS,
-	VIA_REG_INTERRUPT_ENABLE,
-	VIA_REG_PORTA_NO_HANDSHAKE
-};
-
-// Register Name Strings For Debug View.
-static const char s_aszRegisterNames[16][16] =
-{
-/*  "123456789ABCDEF"	*/
-	"Port B",
-	"Port A",
-	"Dir B",
-	"Dir A",
-	"Timer 1 L",
-	"Timer 1 H",
-	"T1 Latch L",
-	"T1 Latch H",
-	"Timer 2 L",
-	"Timer 2 H",
-	"Shift Reg",
-	"Aux Ctrl",
-	"Periph Ctrl",
-	"Int Flags",
-	"Int Enable",
-	"PA No HShake"
-/*  "123456789ABCDEF"	*/
-};
-
-enum via_irq_flags
-{
-	VIA_IRQ_CA2 = 0,
-	VIA_IRQ_CA1,
-	VIA_IRQ_SHIFT,
-	VIA_IRQ_CB2,
-	VIA_IRQ_CB1,
-	VIA_IRQ_TIMER2,
-	VIA_IRQ_TIMER1,
-	VIA_IRQ_SET_CLR
-};
-
-typedef struct
-{
-	union
-	{
-		u8 m_aReg[16];
-		struct
-		{
-			u8 m_u8PortB;					/* 0 */
-			u8 m_u8PortA;					/* 1 */
-			u8 m_uDataDirB;					/* 2 */
-			u8 m_uDataDirA;					/* 3 */
-			union
-			{
-				u16	m_uTimer1;
-				struct
-				{
-					u8 m_uTimer1_L;			/* 4 */
-					u8 m_uTimer1_H;			/* 5 */
-				};
-			};
-			union
-			{
-				u16	m_uTimer1_Latch;
-				struct
-				{
-					u8 m_uTimer1_Latch_L;	/* 6 */
-					u8 m_uTimer1_Latch_H;	/* 7 */
-				};
-			};
-			union
-			{
-				u16	m_uTimer2;
-				struct
-				{
-					u8 m_uTimer2_L;			/* 8 */
-					u8 m_uTimer2_H;			/* 9 */
-				};
-			};
-			u8 m_uShiftReg;					/* A */
-			u8 m_uAuxiliaryCtrl;			/* B */
-			u8 m_uPeripheralCtrl;			/* C */
-			u8 m_uInterruptFlags;			/* D */
-			u8 m_uInterruptEnable;			/* E */
-			u8 m_u8PortA_NoHandshake;		/* F */
-		};
-	};
-} ViaRegisters;
-static_assert(sizeof(ViaRegisters) == 16);
+static_assert((REGISTER_PAGE_RIGHT <= TERMINAL_CHARS_WIDE) && (REGISTER_SCHEDULER_ROW < CONSOLE_TOP) && (CONSOLE_TOP + CONSOLE_HIGH < TERMINAL_CHARS_HIGH),
+			  "The register page is laid out for 80 x 60 text - VIA_6522 has no line doubled build!");
 
 static volatile ViaRegisters s_viaRegs = {0};
 
+#if LOGIC_SCOPE
+// Core1 Adds A Sample Every S02 Falling Edge, The Display Task Draws Them.
+static LogicCapture s_logicCapture;
+static LogicScope s_logicScope;
+#endif
+
+static volatile ViaWriteRing s_writeRing = { .m_uHead = VIA_WRITE_RING_SIZE - 1, .m_uTail = VIA_WRITE_RING_SIZE - 1 };
+
+#if REGISTER_PAGE_STATS
+// Only Core1 Writes These, So Each Access Is A Plain Increment. One 16 Byte Slot Per Register,
+// Kept In Scratch X So The Bus Loop Never Waits Behind Core0 Drawing Into Main SRAM.
 typedef struct
 {
-	u8	m_uOffset;
-	u8	m_uData;
-} RegisterBuffer;
-
-static volatile RegisterBuffer s_aRegBuffer[16];
-static volatile u8 s_uRegHead = 15;
-static volatile u8 s_uRegTail = 15;
+	u32	m_uReads;
+	u32	m_uWrites;
+	u32	m_uLastCycle;					/* s_uBusCycle Of The Last Access */
+	u32	m_uUnused;
+} RegisterStats;
+static_assert(sizeof(RegisterStats) == 16);
+
+static volatile RegisterStats __scratch_x("register_stats") s_aRegisterStats[16] __attribute__((aligned(256)));
+static volatile u32 __scratch_x("register_stats") s_uBusCycle = 0;
+#endif
+
+#if REMOTE_LINK
+// Every Register Access, Written By Core1 Only - s_uTraceHead Counts Entries And Never Wraps.
+static volatile u32 s_aTrace[REMOTE_TRACE_SIZE];
+static volatile u32 s_uTraceHead = 0;
+#endif
+
+// Doorbells Core1 Rings To Wake Core0 - Claimed Before Core1 Is Started.
+#if !PERSONALITY_CIA_6526
+static u32 s_uWriteEvent = 0;
+static u32 s_uIrqEvent = 0;
+#endif
+#if REMOTE_LINK
+static u32 s_uTraceEvent = 0;
+#endif
+
+#if !PERSONALITY_CIA_6526
+// Timer 1's PB7 Output Runs On PIO1 - Core1 Passes It The Timer 1 And ACR Writes.
+static ViaPb7 s_pb7;
+#endif
+
+#if VIA_SNAPSHOT
+// Armed By Core0, Taken And Disarmed By Core1. A Restore Goes The Other Way.
+static volatile bool s_bSnapshotArmed = false;
+static volatile bool s_bSnapshotTaken = false;
+static volatile u32 s_uSnapshotMatch = 0;
+static volatile u32 s_uSnapshotMask = 0;
+static ViaSnapshot s_snapshot;
+
+static volatile bool s_bRestorePending = false;
+static ViaSnapshot s_restore;
 
 //------------------------------------------------------------------------------------------------
-//----                                                                                        ----
+//---- On Core1 Once The Access Is Done - A Few Dozen Cycles, Well Inside One Phase 2 Cycle.  ----
 //------------------------------------------------------------------------------------------------
-void initVGA()
+static inline void TakeSnapshot(const u32 uTrigger, const u32 uBusCycle)
 {
-	// Choose which PIO instance to use (there are two instances, each with 4 state machines)
-	PIO pio = pio0;
-	const uint hsync_offset = pio_add_program(pio, &hsync_program);
-	const uint vsync_offset = pio_add_program(pio, &vsync_program);
-	const uint rgb_offset = pio_add_program(pio, &rgb_program);
-
-	// Manually select a few state machines from pio instance pio0.
-	uint hsync_sm = 0;
-	uint vsync_sm = 1;
-	uint rgb_sm = 2;
-	hsync_program_init(pio, hsync_sm, hsync_offset, PIN_HSYNC);
-	vsync_program_init(pio, vsync_sm, vsync_offset, PIN_VSYNC);
-	rgb_program_init(pio, rgb_sm, rgb_offset, PIN_RED);
-
-	/////////////////////////////////////////////////////////////////////////////////////////////////////
-	// ============================== PIO DMA Channels =================================================
-	/////////////////////////////////////////////////////////////////////////////////////////////////////
-
-	// DMA channels - 0 sends color data, 1 reconfigures and restarts 0
-	int rgb_chan_0 = 0;
-	int rgb_chan_1 = 1;
-
-	// Channel Zero (sends color data to PIO VGA machine)
-	dma_channel_config c0 = dma_channel_get_default_config(rgb_chan_0);  	// default configs
-	channel_config_set_transfer_data_size(&c0, DMA_SIZE_8);              	// 8-bit txfers
-	channel_config_set_read_increment(&c0, true);                        	// yes read incrementing
-	channel_config_set_write_increment(&c0, false);                      	// no write incrementing
-	channel_config_set_dreq(&c0, DREQ_PIO0_TX2) ;                        	// DREQ_PIO0_TX2 pacing (FIFO)
-	channel_config_set_chain_to(&c0, rgb_chan_1);                        	// chain to other channel
-
-	dma_channel_configure
-	(
-		rgb_chan_0,                                                        	// Channel to be configured
-		&c0,                                                               	// The configuration we just created
-		&pio->txf[rgb_sm],                                                 	// write address (RGB PIO TX FIFO)
-		&aVGAScreenBuffer,                                                 	// The initial read address (pixel color array)
-		(VGA_RESOLUTION_X * VGA_RESOLUTION_Y) >> 1,                        	// Number of transfers; in this case each is 1 byte.
-		false                                                              	// Don't start immediately.
-	);
-
-	// Channel One (reconfigures the first channel)
-	dma_channel_config c1 = dma_channel_get_default_config(rgb_chan_1);  	// default configs
-	channel_config_set_transfer_data_size(&c1, DMA_SIZE_32);             	// 32-bit txfers
-	channel_config_set_read_increment(&c1, false);                       	// no read incrementing
-	channel_config_set_write_increment(&c1, false);                      	// no write incrementing
-	channel_config_set_chain_to(&c1, rgb_chan_0);                        	// chain to other channel
-
-	dma_channel_configure
-	(
-		rgb_chan_1,                         	// Channel to be configured
-		&c1,                                	// The configuration we just created
-		&dma_hw->ch[rgb_chan_0].read_addr,  	// Write address (channel 0 read address)
-		&address_pointer,                   	// Read address (POINTER TO AN ADDRESS)
-		1,                                 	 	// Number of transfers, in this case each is 4 byte
-		false                               	// Don't start immediately.
-	);
-
-  /////////////////////////////////////////////////////////////////////////////////////////////////////
-  /////////////////////////////////////////////////////////////////////////////////////////////////////
-
-	// Initialize PIO state machine counters. This passes the information to the state machines
-	// that they retrieve in the first 'pull' instructions, before the .wrap_target directive
-	// in the assembly. Each uses these values to initialize some counting registers.
-	#define H_ACTIVE   655    // (active + frontporch - 1) - one cycle delay for mov
-	#define V_ACTIVE   479    // (active - 1)
-	#define RGB_ACTIVE 319    // (horizontal active)/2 - 1
-	// #define RGB_ACTIVE 639 // change to this if 1 pixel/byte
-	pio_sm_put_blocking(pio, hsync_sm, H_ACTIVE);
-	pio_sm_put_blocking(pio, vsync_sm, V_ACTIVE);
-	pio_sm_put_blocking(pio, rgb_sm, RGB_ACTIVE);
-
-	// Start the two pio machine IN SYNC
-	// Note that the RGB state machine is running at full speed,
-	// so synchronization doesn't matter for that one. But, we'll
-	// start them all simultaneously anyway.
-	pio_enable_sm_mask_in_sync(pio, ((1u << hsync_sm) | (1u << vsync_sm) | (1u << rgb_sm)));
-
-	// Start DMA channel 0. Once started, the contents of the pixel color array
-	// will be continously DMA's to the PIO machines that are driving the screen.
-	// To change the contents of the screen, we need only change the contents
-	// of that array.
-	dma_start_channel_mask((1u << rgb_chan_0)) ;
+	const u32 uFlags = ((gpioc_lo_out_get() >> PIN_IRQ) & 1) ? 0 : VIA_SNAPSHOT_IRQ_LOW;
+	u32 uFirstWrite;
+	const u32 uWrites = ViaWriteRing_GetQueued(&s_writeRing, &uFirstWrite);
+
+	ViaSnapshot_Take(&s_snapshot, &s_viaRegs, s_writeRing.m_aSlot, uFirstWrite, uWrites, uBusCycle, uTrigger, uFlags);
+
+	s_bSnapshotArmed = false;
+	__dmb();
+	s_bSnapshotTaken = true;
 }
 
 //------------------------------------------------------------------------------------------------
-//----                                                                                        ----
+//---- On Core1 At An S02 Falling Edge - The Registers And Port Pins Go Back, And The Queued  ----
+//---- Writes Go Round The Ring Again As If Just Made. Returns The Bus Cycle To Resume From.  ----
 //------------------------------------------------------------------------------------------------
-void FilledRectangle(u32 uPositionX, u32 uPositionY, u32 uWidth, u32 uHeight, u32 uColour)
+static inline u32 RestoreSnapshot(const u32 uWriteEvent)
 {
-	if (uPositionX + uWidth >= VGA_RESOLUTION_X)
-		uWidth = VGA_RESOLUTION_X - uPositionX;
+	__dmb();
 
-	if (uPositionY + uHeight >= VGA_RESOLUTION_Y)
-		uHeight = VGA_RESOLUTION_Y - uPositionY;
+	for (u32 uRegister=0; uRegister<16; ++uRegister)
+		s_viaRegs.m_aReg[uRegister] = s_restore.m_viaRegs.m_aReg[uRegister];
 
-	if ((uWidth > 0) && (uHeight > 0))
-	{
-		u32 uPixelOffset = ((uPositionY * VGA_RESOLUTION_X) + uPositionX) >> 1;
+	const u32 uPortMask = PIN_PORTS_MASK;
+	const u32 uOut = (s_viaRegs.m_u8PortA << PIN_PORT_A_SHIFT) | (s_viaRegs.m_u8PortB << PIN_PORT_B_SHIFT);
+	const u32 uDir = (s_viaRegs.m_uDataDirA << PIN_PORT_A_SHIFT) | (s_viaRegs.m_uDataDirB << PIN_PORT_B_SHIFT);
 
-		if (uPositionX & 1)
-		{
-			u32 uOffset = uPixelOffset++;
-			--uWidth;
+	gpioc_hi_out_xor((gpioc_hi_out_get() ^ uOut) & uPortMask);
+	gpioc_hi_oe_xor((gpioc_hi_oe_get() ^ uDir) & uPortMask);
 
-			for(u32 y=0; y<uHeight; ++y)
-			{
-				aVGAScreenBuffer[uOffset] = (aVGAScreenBuffer[uOffset] & 0b11000111) | (uColour << 3);
-				uOffset += VGA_RESOLUTION_X >> 1;
-			}
-		}
+	// PB7 Follows The Restored ACR And Latch, Counting Again As If T1C-H Were Just Written.
+	ViaPb7_Write(&s_pb7, VIA_REG_AUXILIARY_CONTROL, s_viaRegs.m_uAuxiliaryCtrl);
+	ViaPb7_Write(&s_pb7, VIA_REG_TIMER1_LATCH_L, s_viaRegs.m_uTimer1_Latch_L);
+	ViaPb7_Write(&s_pb7, VIA_REG_TIMER1_LATCH_H, s_viaRegs.m_uTimer1_Latch_H);
+	if (s_viaRegs.m_uTimer1)
+		ViaPb7_Write(&s_pb7, VIA_REG_TIMER1_H, s_viaRegs.m_uTimer1_Latch_H);
 
-		while (uWidth > 1)
-		{
-		u32 uOffset = uPixelOffset++;
-		uWidth -= 2;
-
-		for(u32 y=0; y<uHeight; ++y)
-		{
-			aVGAScreenBuffer[uOffset] = (uColour << 3) | uColour;
-			uOffset += VGA_RESOLUTION_X >> 1;
-		}
-		}
-
-		if (1 == uWidth)
-		{
-			for(u32 y=0; y<uHeight; ++y)
-			{
-				aVGAScreenBuffer[uPixelOffset] = (aVGAScreenBuffer[uPixelOffset] & 0b11111000) | uColour;
-				uPixelOffset += VGA_RESOLUTION_X >> 1;
-			}
-		}
-	}
-}
-
-//------------------------------------------------------------------------------------------------
-//----                                                                                        ----
-//------------------------------------------------------------------------------------------------
-void DrawPetsciiChar(const u32 uXPos, const u32 uYPos, const u8 uChar, const u8 uColour)
-{
-	for (u32 uLine=0; uLine<8; ++uLine)
+	for (u32 uWrite=0; uWrite<s_restore.m_uWrites; ++uWrite)
 	{
-		u32 uPixelOffset = ((((uYPos + uLine) * VGA_RESOLUTION_X ) + uXPos) >> 1) + 3;
-		u32 uCharLine = VicChars901460_03[2048 + (uChar << 3) + uLine];
+		const ViaQueuedWrite write = ViaSnapshot_GetWrite(&s_restore, uWrite);
 
-		for (u32 x=0; x<4; ++x)
-		{
-			u8 uPixelPair = 0;
-
-			if (uCharLine & 2)
-				uPixelPair = uColour;
+		ViaWriteRing_Push(&s_writeRing, write);
+		ViaPb7_Write(&s_pb7, write.m_uOffset, write.m_uData);
+	}
 
-			if (uCharLine & 1)
-				uPixelPair |= (uColour << 3);
+	// ProcessVIA Puts #IRQ Back From The Restored Flags, Even With Nothing Queued.
+	Scheduler_Signal(uWriteEvent);
 
-			aVGAScreenBuffer[uPixelOffset--] = uPixelPair;
-			uCharLine >>= 2;
-		}
-	}
+	s_bRestorePending = false;
+	return s_restore.m_uBusCycle;
 }
+#endif
+
+#if PERSONALITY_CIA_6526
+static Cia6526State s_cia;
 
 //------------------------------------------------------------------------------------------------
-//----                                                                                        ----
+//---- Reflect The CIA Port, Serial And IRQ Outputs On The Pins.                              ----
 //------------------------------------------------------------------------------------------------
-void DrawString(uint32_t uCharX, uint32_t uCharY, const char* pszString, const uint8_t uColour)
+static inline void CiaUpdatePins(void)
 {
-	while (*pszString)
-	{
-		if (uCharX >= (TERMINAL_CHARS_WIDE-1))
-		{
-			uCharX = 1;
-			++uCharY;
-		}
-
-		if (uCharY >= (TERMINAL_CHARS_HIGH-1))
-			return;
+	const u32 uPortMask = PIN_PORTS_MASK;
+	const u32 uOut = (s_cia.m_uPortA << PIN_PORT_A_SHIFT) | (Cia6526_Peek(&s_cia, CIA_REG_PORTB) << PIN_PORT_B_SHIFT);
+	const u32 uDir = (s_cia.m_uDataDirA << PIN_PORT_A_SHIFT) | ((s_cia.m_uDataDirB | s_cia.m_uTimerPortBMask) << PIN_PORT_B_SHIFT);
 
-		uint8_t c = *pszString++;
+	gpioc_hi_out_xor((gpioc_hi_out_get() ^ uOut) & uPortMask);
+	gpioc_hi_oe_xor((gpioc_hi_oe_get() ^ uDir) & uPortMask);
 
-		if (c >= '`')
-			c -= '`';
+	// SP And CNT Are Only Driven While The Serial Port Is Shifting Out.
+	const bool bSerialOut = (0 != (s_cia.m_uControlA & CIA_CRA_SERIAL_OUT));
+	gpio_put(PIN_CIA_SP, s_cia.m_bSpOut);
+	gpio_put(PIN_CIA_CNT, s_cia.m_bCntOut);
+	gpio_set_dir_masked((1 << PIN_CIA_SP) | (1 << PIN_CIA_CNT), bSerialOut ? ((1 << PIN_CIA_SP) | (1 << PIN_CIA_CNT)) : 0);
 
-		DrawPetsciiChar(uCharX << 3, uCharY << 3, c, uColour);
-		++uCharX;
-	}
+	// IRQ Active Low
+	gpio_put(PIN_IRQ, !s_cia.m_bIrq);
 }
 
 //------------------------------------------------------------------------------------------------
-//----                                                                                        ----
+//---- One Phase 2 Cycle Of The CIA - Timers, Serial Port, TOD And FLAG.                      ----
 //------------------------------------------------------------------------------------------------
-static const uint8_t aHexTable[16] = {'0','1','2','3','4','5','6','7','8','9','A','B','C','D','E','F'};
-
-static inline uint16_t byteToHex(const uint8_t uByte)
+static inline void CiaCycle(const u32 uLow32Pins)
 {
-	return (aHexTable[(uByte >> 4) & 15] << 8) | aHexTable[uByte & 15];
+	const u32 uInputs =	(((uLow32Pins >> PIN_CIA_CNT) & 1) ? CIA_INPUT_CNT : 0) |
+						(((uLow32Pins >> PIN_CIA_SP) & 1) ? CIA_INPUT_SP : 0) |
+						(((uLow32Pins >> PIN_CIA_TOD) & 1) ? CIA_INPUT_TOD : 0) |
+						(((uLow32Pins >> PIN_CIA_FLAG) & 1) ? CIA_INPUT_FLAG : 0);
+
+	Cia6526_Tick(&s_cia, uInputs);
+	CiaUpdatePins();
 }
+#endif
 
 //------------------------------------------------------------------------------------------------
 //----                                                                                        ----
@@ -390,8 +226,22 @@ static void __not_in_flash_func(function_core1)(void)
 {
 	save_and_disable_interrupts();
 
+	// delay_40ns Counts This Core's Own Cycles.
+	ClockPlan_StartCycleCounter();
+
 	u32 uS02 = 1;
  	u32 uLow32Pins = gpioc_lo_in_get();
+#if REGISTER_PAGE_STATS || REMOTE_LINK
+	u32 uBusCycle = 0;
+#endif
+#if REMOTE_LINK
+	u32 uTraceHead = 0;
+	const u32 uTraceEvent = s_uTraceEvent;
+#endif
+#if !PERSONALITY_CIA_6526
+	const u32 uWriteEvent = s_uWriteEvent;
+	const u32 uIrqEvent = s_uIrqEvent;
+#endif
 
 	// Wait for IO0 To Return Hi AND S02 To Assert Low
 	while ( (0 == ((uLow32Pins >> PIN_IO0) & 1)) || (1 == ((uLow32Pins >> PIN_CLK) & 1)) )
@@ -420,24 +270,34 @@ static void __not_in_flash_func(function_core1)(void)
 			{
 				if (1 == uS02)
 				{
-					// S02 Has Transitioned From Hi To Low - Check If The Timer Is Non-Zero
-					if (0 != s_viaRegs.m_uTimer1)
-					{
-						// If the Timer Will Go To Zero
-						if (1 == s_viaRegs.m_uTimer1)
-						{
-							s_viaRegs.m_uTimer1 = s_viaRegs.m_uTimer1_Latch;
-							s_viaRegs.m_uInterruptFlags |= (1 << VIA_IRQ_TIMER1);
-						}
-						else
-						{
-							s_viaRegs.m_uTimer1--;
-						}
-					}
-
-					u32 uHiPins = gpioc_hi_in_get();
-					s_viaRegs.m_u8PortA = (uHiPins >> (PIN_PORT_A - 32)) & 0xFF;
-					s_viaRegs.m_u8PortA_NoHandshake = (uHiPins >> (PIN_PORT_A - 32)) & 0xFF;
+#if VIA_SNAPSHOT
+					if (s_bRestorePending)
+						uBusCycle = RestoreSnapshot(uWriteEvent);
+#endif
+#if REGISTER_PAGE_STATS || REMOTE_LINK
+					++uBusCycle;
+#endif
+#if REGISTER_PAGE_STATS
+					s_uBusCycle = uBusCycle;
+#endif
+#if PERSONALITY_CIA_6526
+					CiaCycle(uLow32Pins);
+#if LOGIC_SCOPE
+					// The CIA Keeps Its Ports In s_cia, So Only The Scope Reads The Pins.
+					const u32 uHiPins = gpioc_hi_in_get();
+#endif
+#else
+					// S02 Has Transitioned From Hi To Low - Step Timer 1
+					if (Via6522_Tick(&s_viaRegs))
+						Scheduler_Signal(uIrqEvent);
+
+					const u32 uHiPins = gpioc_hi_in_get();
+					s_viaRegs.m_u8PortA = (uHiPins >> PIN_PORT_A_SHIFT) & 0xFF;
+					s_viaRegs.m_u8PortA_NoHandshake = (uHiPins >> PIN_PORT_A_SHIFT) & 0xFF;
+#endif
+#if LOGIC_SCOPE
+					LogicCapture_Add(&s_logicCapture, LOGIC_SCOPE_SAMPLE(uHiPins >> PIN_PORT_A_SHIFT, uLow32Pins >> PIN_IRQ));
+#endif
 				}
 
 				// S02 Has Transitioned From Hi To Low
@@ -445,44 +305,67 @@ static void __not_in_flash_func(function_core1)(void)
 			}
 		}
 
-		if ( 0 == ((uLow32Pins >> PIN_READ_WRITE) & 1) )
+		if (0 == PIN_BUS_READ(PIN_BUS_WORD(uLow32Pins)))
 		{
 			delay_40ns();
 			uLow32Pins = gpioc_lo_in_get();
-			const u32 uRegister = (uLow32Pins >> PIN_ADDRESS_BIT0) & 0xF;
-			const u32 uData = (uLow32Pins >> PIN_DATA_BIT0) & 0xFF;
-
+			const u32 uBus = PIN_BUS_WORD(uLow32Pins);
+			const u32 uRegister = PIN_BUS_REGISTER(uBus);
+			const u32 uData = PIN_BUS_DATA(uBus);
+
+#if PERSONALITY_CIA_6526
+			// The CIA Is Handled Entirely On Core1 So Timer Writes Take Effect This Cycle.
+			Cia6526_Write(&s_cia, uRegister, uData);
+			CiaUpdatePins();
+#else
 			switch(uRegister)
 			{
 				case VIA_REG_PORTB:
-					gpioc_hi_out_xor((gpioc_hi_out_get() ^ (uData << (PIN_PORT_B - 32))) & (0xFF << (PIN_PORT_B - 32)));
+					gpioc_hi_out_xor((gpioc_hi_out_get() ^ (uData << PIN_PORT_B_SHIFT)) & PIN_PORT_B_MASK);
 					s_viaRegs.m_u8PortB ^= (s_viaRegs.m_u8PortB ^ uData) & s_viaRegs.m_uDataDirB;
 				break;
 
 				case VIA_REG_PORTA:
-					gpioc_hi_out_xor((gpioc_hi_out_get() ^ (uData << (PIN_PORT_A - 32))) & (0xFF << (PIN_PORT_A - 32)));
+					gpioc_hi_out_xor((gpioc_hi_out_get() ^ (uData << PIN_PORT_A_SHIFT)) & PIN_PORT_A_MASK);
 					s_viaRegs.m_u8PortA ^= (s_viaRegs.m_u8PortA ^ uData) & s_viaRegs.m_uDataDirA;
 				break;
 
 				case VIA_REG_DATA_DIRB:
-					gpioc_hi_oe_xor((gpioc_hi_oe_get() ^ (uData << (PIN_PORT_B - 32))) & (0xFF << (PIN_PORT_B - 32)));
+					gpioc_hi_oe_xor((gpioc_hi_oe_get() ^ (uData << PIN_PORT_B_SHIFT)) & PIN_PORT_B_MASK);
 					s_viaRegs.m_uDataDirB = uData;
 				break;
 
 				case VIA_REG_DATA_DIRA:
-					gpioc_hi_oe_xor((gpioc_hi_oe_get() ^ (uData << (PIN_PORT_A - 32))) & (0xFF << (PIN_PORT_A - 32)));
+					gpioc_hi_oe_xor((gpioc_hi_oe_get() ^ (uData << PIN_PORT_A_SHIFT)) & PIN_PORT_A_MASK);
 					s_viaRegs.m_uDataDirA = uData;
 				break;
 
 				default:
 					// Push Register Set Onto Ring Buffer.
-					const u8 uRegTail = (s_uRegTail + 1) & 15;
-					assert(uRegTail != s_uRegHead);		// Ring Buffer Is Full !!!
-					s_aRegBuffer[uRegTail].m_uOffset = (u8)uRegister;
-					s_aRegBuffer[uRegTail].m_uData = (u8)uData;
-					s_uRegTail = uRegTail;
+					ViaWriteRing_Push(&s_writeRing, (ViaQueuedWrite){ (u8)uRegister, (u8)uData });
+					Scheduler_Signal(uWriteEvent);
+
+					ViaPb7_Write(&s_pb7, uRegister, uData);
 				break;
 			}
+#endif
+
+#if REGISTER_PAGE_STATS
+			++s_aRegisterStats[uRegister].m_uWrites;
+			s_aRegisterStats[uRegister].m_uLastCycle = uBusCycle;
+#endif
+#if REMOTE_LINK
+			const u32 uTraceEntry = RemoteLink_TraceEntry(uRegister, uData, REMOTE_TRACE_WRITE, uBusCycle);
+			s_aTrace[uTraceHead & (REMOTE_TRACE_SIZE - 1)] = uTraceEntry;
+			s_uTraceHead = ++uTraceHead;
+
+			if (0 == (uTraceHead & TRACE_SIGNAL_MASK))
+				Scheduler_Signal(uTraceEvent);
+#endif
+#if VIA_SNAPSHOT
+			if (s_bSnapshotArmed && (0 == ((uTraceEntry ^ s_uSnapshotMatch) & s_uSnapshotMask)))
+				TakeSnapshot(uTraceEntry, uBusCycle);
+#endif
 
 			// Wait for IO0 To Return Hi OR S02 To Assert Low
 			// while ( (0 == ((uLow32Pins >> PIN_IO0) & 1)) && (1 == ((uLow32Pins >> PIN_CLK) & 1)) )
@@ -490,115 +373,390 @@ static void __not_in_flash_func(function_core1)(void)
 		}
 		else
 		{
-			const u32 uRegister = (uLow32Pins >> PIN_ADDRESS_BIT0) & 0xF;
+			const u32 uRegister = PIN_BUS_REGISTER(PIN_BUS_WORD(uLow32Pins));
+#if PERSONALITY_CIA_6526
+			const u32 uHiPins = gpioc_hi_in_get();
+			const u8 uData = Cia6526_Read(&s_cia, uRegister, (uHiPins >> PIN_PORT_A_SHIFT) & 0xFF, (uHiPins >> PIN_PORT_B_SHIFT) & 0xFF);
+#else
 			const u8 uData = s_viaRegs.m_aReg[uRegister];
-			gpio_put_masked((0xFF << PIN_DATA_BIT0), (uData << PIN_DATA_BIT0));
+#endif
+			gpio_put_masked(PIN_DATA_MASK, (uData << PIN_DATA_BIT0));
 
 			// Set All Data Bits To Output
-			gpio_set_dir_masked((0xFF << PIN_DATA_BIT0), (0xFF << PIN_DATA_BIT0));
+			gpio_set_dir_masked(PIN_DATA_MASK, PIN_DATA_MASK);
+
+#if REGISTER_PAGE_STATS
+			// The Data Is Already On The Bus, So Counting Costs Nothing Here.
+			++s_aRegisterStats[uRegister].m_uReads;
+			s_aRegisterStats[uRegister].m_uLastCycle = uBusCycle;
+#endif
+#if REMOTE_LINK
+			const u32 uTraceEntry = RemoteLink_TraceEntry(uRegister, uData, 0, uBusCycle);
+			s_aTrace[uTraceHead & (REMOTE_TRACE_SIZE - 1)] = uTraceEntry;
+			s_uTraceHead = ++uTraceHead;
+
+			if (0 == (uTraceHead & TRACE_SIGNAL_MASK))
+				Scheduler_Signal(uTraceEvent);
+#endif
 
 			// Wait for IO0 To Return Hi OR S02 To Assert Low
 			while ( (0 == ((uLow32Pins >> PIN_IO0) & 1)) && (1 == ((uLow32Pins >> PIN_CLK) & 1)) )
 				uLow32Pins = gpioc_lo_in_get();
 
 			// Get Off The Bus
-			gpio_set_dir_masked((0xFF << PIN_DATA_BIT0), 0);
-
-			// If We Read Timer1 Low Byte Clear The IRQ Flag.
-			if (VIA_REG_TIMER1_L == uRegister)
-				s_viaRegs.m_uInterruptFlags &= ~(1 << VIA_IRQ_TIMER1);
+			gpio_set_dir_masked(PIN_DATA_MASK, 0);
+
+#if PERSONALITY_CIA_6526
+			// Reading The ICR May Have Released IRQ.
+			CiaUpdatePins();
+#else
+			// Reading Timer1 Low Byte Clears Its IRQ Flag.
+			if (Via6522_ReadDone(&s_viaRegs, uRegister))
+				Scheduler_Signal(uIrqEvent);
+#endif
+#if VIA_SNAPSHOT
+			// Off The Bus By Now, So The Copy Can Not Hold The Data Lines Past Phase 2.
+			if (s_bSnapshotArmed && (0 == ((uTraceEntry ^ s_uSnapshotMatch) & s_uSnapshotMask)))
+				TakeSnapshot(uTraceEntry, uBusCycle);
+#endif
 		}
 	}
 }
 
+#if !PERSONALITY_CIA_6526
 //------------------------------------------------------------------------------------------------
 //----                                                                                        ----
 //------------------------------------------------------------------------------------------------
-void ProcessVIA(void)
+void __hot_path_func(ProcessVIA)(void)
 {
 	// Are There Any Register Writes On The Ring Buffer?
-	if (s_uRegHead != s_uRegTail)
+	ViaQueuedWrite write;
+
+	if (ViaWriteRing_Pop(&s_writeRing, &write))
 	{
-		const u8 uRegister = s_aRegBuffer[s_uRegHead].m_uOffset & 15;
-		const u8 uData = s_aRegBuffer[s_uRegHead].m_uData;
+		const u8 uRegister = write.m_uOffset & 15;
+		const u8 uData = write.m_uData;
 
-		switch(uRegister)
-		{
-			case VIA_REG_TIMER1_L:
-			{
-				// Write Data Into The Low Order Latch... Not The Counter!!!
-				s_viaRegs.m_uTimer1_Latch_L = uData;
-			}
-			break;
+#if LOG_REGISTER_WRITES
+		printf("%-15s <- %02X\n", RegisterPage_GetName(uRegister), uData);
+#endif
 
-			case VIA_REG_TIMER1_H:
-			{
-				s_viaRegs.m_uTimer1_Latch_H = uData;
-				s_viaRegs.m_uTimer1 = s_viaRegs.m_uTimer1_Latch;
-				s_viaRegs.m_uInterruptFlags &= ~(1 << VIA_IRQ_TIMER1);
-			}
-			break;
+		Via6522_Write(&s_viaRegs, uRegister, uData);
+	}
 
-			case VIA_REG_TIMER1_LATCH_L:
-			{
-				s_viaRegs.m_uTimer1_Latch_L = uData;
-			}
-			break;
+	// Reflect The IRQ Bit On The IO Pin.
+	gpio_put(PIN_IRQ, !Via6522_UpdateIrq(&s_viaRegs));
+}
+#endif
 
-			case VIA_REG_TIMER1_LATCH_H:
-			{
-				s_viaRegs.m_uTimer1_Latch_H = uData;
-				s_viaRegs.m_uInterruptFlags &= ~(1 << VIA_IRQ_TIMER1);
-			}
-			break;
+//------------------------------------------------------------------------------------------------
+//---- Register Value For The Debug View.                                                     ----
+//------------------------------------------------------------------------------------------------
+static inline u8 PeekRegister(const u32 uRegisterIndex)
+{
+#if PERSONALITY_CIA_6526
+	return Cia6526_Peek(&s_cia, uRegisterIndex);
+#else
+	return s_viaRegs.m_aReg[uRegisterIndex];
+#endif
+}
 
-			case VIA_REG_INTERRUPT_FLAGS:
-			{
-				if (uData & 0x80)
-				{
-					// Bit 7 Is High So Enable Any Specified Interrupts.
-					s_viaRegs.m_uInterruptFlags |= (uData & 0x7F);
-				}
-				else
-				{
-					// Bit 7 Is Low So Disable Any Specified Interrupts.
-					s_viaRegs.m_uInterruptFlags &= (~uData & 0x7F);
-				}
+#if REMOTE_LINK
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+u8 RemoteHal_Peek(const u32 uRegister)
+{
+	return PeekRegister(uRegister);
+}
 
-				if (s_viaRegs.m_uInterruptFlags)
-					s_viaRegs.m_uInterruptFlags |= (1 << VIA_IRQ_SET_CLR);
-			}
-			break;
+//------------------------------------------------------------------------------------------------
+//---- Ports, Directions And PB7 Are Core1's, So A Poke Can Race A Bus Write To The Same      ----
+//---- Register. The CIA Lives Entirely On Core1 And Cannot Be Poked From Here.               ----
+//------------------------------------------------------------------------------------------------
+bool RemoteHal_Poke(const u32 uRegister, const u8 uData)
+{
+#if PERSONALITY_CIA_6526
+	return false;
+#else
+	switch(uRegister)
+	{
+		case VIA_REG_PORTB:
+			gpioc_hi_out_xor((gpioc_hi_out_get() ^ (uData << PIN_PORT_B_SHIFT)) & PIN_PORT_B_MASK);
+			s_viaRegs.m_u8PortB ^= (s_viaRegs.m_u8PortB ^ uData) & s_viaRegs.m_uDataDirB;
+		break;
+
+		case VIA_REG_PORTA:
+			gpioc_hi_out_xor((gpioc_hi_out_get() ^ (uData << PIN_PORT_A_SHIFT)) & PIN_PORT_A_MASK);
+			s_viaRegs.m_u8PortA ^= (s_viaRegs.m_u8PortA ^ uData) & s_viaRegs.m_uDataDirA;
+		break;
+
+		case VIA_REG_DATA_DIRB:
+			gpioc_hi_oe_xor((gpioc_hi_oe_get() ^ (uData << PIN_PORT_B_SHIFT)) & PIN_PORT_B_MASK);
+			s_viaRegs.m_uDataDirB = uData;
+		break;
+
+		case VIA_REG_DATA_DIRA:
+			gpioc_hi_oe_xor((gpioc_hi_oe_get() ^ (uData << PIN_PORT_A_SHIFT)) & PIN_PORT_A_MASK);
+			s_viaRegs.m_uDataDirA = uData;
+		break;
+
+		default:
+			Via6522_Write(&s_viaRegs, uRegister, uData);
+			ViaPb7_Write(&s_pb7, uRegister, uData);
+		break;
+	}
 
-			case VIA_REG_INTERRUPT_ENABLE:
-			{
-				if (uData & 0x80)
-				{
-					// Bit 7 Is High So Enable Any Specified Interrupts.
-					s_viaRegs.m_uInterruptEnable |= (uData & 0x7F);
-				}
-				else
-				{
-					// Bit 7 Is Low So Disable Any Specified Interrupts.
-					s_viaRegs.m_uInterruptEnable &= (~uData & 0x7F);
-				}
-			}
-			break;
+	return true;
+#endif
+}
 
-			default:
-			s_viaRegs.m_aReg[uRegister] = uData;
-		}
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void RemoteHal_SamplePins(u32 aPins[2])
+{
+	aPins[0] = gpioc_lo_in_get();
+	aPins[1] = gpioc_hi_in_get();
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void RemoteHal_GetStats(u32 aStats[REMOTE_STATS_WORDS])
+{
+#if REGISTER_PAGE_STATS
+	aStats[0] = s_uBusCycle;
 
-		s_uRegHead = (s_uRegHead + 1) & 15;
+	for (u32 uRegisterIndex=0; uRegisterIndex<16; ++uRegisterIndex)
+	{
+		aStats[1 + (uRegisterIndex * 3)] = s_aRegisterStats[uRegisterIndex].m_uReads;
+		aStats[2 + (uRegisterIndex * 3)] = s_aRegisterStats[uRegisterIndex].m_uWrites;
+		aStats[3 + (uRegisterIndex * 3)] = s_aRegisterStats[uRegisterIndex].m_uLastCycle;
 	}
+#else
+	for (u32 uWord=0; uWord<REMOTE_STATS_WORDS; ++uWord)
+		aStats[uWord] = 0;
+#endif
+}
 
-	const u8 uInterrupFlags = s_viaRegs.m_uInterruptFlags & s_viaRegs.m_uInterruptEnable;
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+u32 RemoteHal_GetTraceHead(void)
+{
+	return s_uTraceHead;
+}
 
-	// If Any Enabled Interrupt Is Flagged The Set The Hi Bit
-	s_viaRegs.m_uInterruptFlags = (uInterrupFlags) ? (1 << VIA_IRQ_SET_CLR) | uInterrupFlags : 0;
+u32 RemoteHal_GetTraceEntry(const u32 uIndex)
+{
+	return s_aTrace[uIndex];
+}
 
-	// Reflect The IRQ Bit On The IO Pin.
-	gpio_put(PIN_IRQ, ((~s_viaRegs.m_uInterruptFlags >> VIA_IRQ_SET_CLR) & 1));
+//------------------------------------------------------------------------------------------------
+//---- Matched Against The Trace Entry Of Each Access - A Zero Mask Takes The Very Next One.  ----
+//------------------------------------------------------------------------------------------------
+bool RemoteHal_ArmSnapshot(const u32 uMatch, const u32 uMask)
+{
+#if VIA_SNAPSHOT
+	s_bSnapshotArmed = false;
+	s_bSnapshotTaken = false;
+	s_uSnapshotMatch = uMatch;
+	s_uSnapshotMask = uMask;
+	__dmb();
+	s_bSnapshotArmed = true;
+	return true;
+#else
+	return false;
+#endif
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+bool RemoteHal_GetSnapshot(ViaSnapshot* pSnapshot)
+{
+#if VIA_SNAPSHOT
+	if (!s_bSnapshotTaken)
+		return false;
+
+	__dmb();
+	*pSnapshot = s_snapshot;
+	return true;
+#else
+	return false;
+#endif
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Core1 Picks It Up On The Next S02 Falling Edge - With The Bus Clock Stopped It Waits   ----
+//---- There, And The Reply Says So.                                                          ----
+//------------------------------------------------------------------------------------------------
+u32 RemoteHal_Restore(const ViaSnapshot* pSnapshot, bool* pbApplied)
+{
+#if VIA_SNAPSHOT
+	if (s_bRestorePending)
+		return USB_LINK_ERROR_BUSY;
+
+	// Writes Still Queued Belong To The State Being Replaced, And Would Leave No Room.
+	while (!ViaWriteRing_IsEmpty(&s_writeRing))
+		ProcessVIA();
+
+	s_restore = *pSnapshot;
+	__dmb();
+	s_bRestorePending = true;
+
+	const u32 uStart = time_us_32();
+
+	while (s_bRestorePending && ((time_us_32() - uStart) < RESTORE_WAIT_US))
+		tight_loop_contents();
+
+	*pbApplied = !s_bRestorePending;
+	return USB_LINK_ERROR_NONE;
+#else
+	return USB_LINK_ERROR_UNSUPPORTED;
+#endif
+}
+#endif
+
+#if REGISTER_PAGE_STATS
+//------------------------------------------------------------------------------------------------
+//---- Once A Second Turn Core1's Running Counts Into Rates - The Counters Only Ever Go Up,   ----
+//---- So Unsigned Differences Are Right Even Across A Wrap.                                  ----
+//------------------------------------------------------------------------------------------------
+static void UpdateRegisterStats(void)
+{
+	static u32 s_uLastTime = 0;
+	static u32 s_aLastReads[16] = {0};
+	static u32 s_aLastWrites[16] = {0};
+
+	const u32 uNow = time_us_32();
+	const u32 uElapsed = uNow - s_uLastTime;
+
+	if (uElapsed < 1000000)
+		return;
+
+	const u32 uBusCycle = s_uBusCycle;
+
+	for (u32 uRegisterIndex=0; uRegisterIndex<16; ++uRegisterIndex)
+	{
+		const u32 uReads = s_aRegisterStats[uRegisterIndex].m_uReads;
+		const u32 uWrites = s_aRegisterStats[uRegisterIndex].m_uWrites;
+		const u32 uReadsPerSecond = (u32)(((uint64_t)(uReads - s_aLastReads[uRegisterIndex]) * 1000000) / uElapsed);
+		const u32 uWritesPerSecond = (u32)(((uint64_t)(uWrites - s_aLastWrites[uRegisterIndex]) * 1000000) / uElapsed);
+		const u32 uIdleCycles = (uReads | uWrites) ? (uBusCycle - s_aRegisterStats[uRegisterIndex].m_uLastCycle) : REGISTER_NEVER_ACCESSED;
+
+		RegisterPage_UpdateStats(uRegisterIndex, uReadsPerSecond, uWritesPerSecond, uIdleCycles);
+
+		s_aLastReads[uRegisterIndex] = uReads;
+		s_aLastWrites[uRegisterIndex] = uWrites;
+	}
+
+	s_uLastTime = uNow;
+}
+#endif
+
+//------------------------------------------------------------------------------------------------
+//---- Once A Second Show How Much Of Core0 Is Spent Asleep, How Long Work Waits And How      ----
+//---- Often Anything Went Out To Flash. The XIP Counters Saturate, So They Are Cleared Too.  ----
+//------------------------------------------------------------------------------------------------
+static void UpdateDiagnostics(void)
+{
+	static u32 s_uLastTime = 0;
+
+	const u32 uNow = time_us_32();
+
+	if ((uNow - s_uLastTime) < 1000000)
+		return;
+
+	SchedulerStats stats;
+	Scheduler_GetStats(&stats);
+
+	const u32 uIdlePercent = (u32)(((uint64_t)stats.m_uIdleCycles * 100) / (stats.m_uTotalCycles ? stats.m_uTotalCycles : 1));
+	RegisterPage_UpdateScheduler(uIdlePercent, stats.m_uWakeUps, stats.m_uMaxSliceCycles, stats.m_uMaxEventCycles);
+
+	const u32 uXipHits = xip_ctrl_hw->ctr_hit;
+	const u32 uXipAccesses = xip_ctrl_hw->ctr_acc;
+	xip_ctrl_hw->ctr_hit = 0;
+	xip_ctrl_hw->ctr_acc = 0;
+
+	RegisterPage_UpdateXip(uXipAccesses, uXipHits);
+
+	s_uLastTime = uNow;
+}
+
+#if !PERSONALITY_CIA_6526
+//------------------------------------------------------------------------------------------------
+//---- Highest Priority - Bus Writes And IRQ Flag Changes From Core1. Drains The Ring Buffer. ----
+//------------------------------------------------------------------------------------------------
+static bool __hot_path_func(ViaTask)(void)
+{
+	do
+	{
+		ProcessVIA();
+	}
+	while (!ViaWriteRing_IsEmpty(&s_writeRing));
+
+	return false;
+}
+#endif
+
+#if REMOTE_LINK
+//------------------------------------------------------------------------------------------------
+//---- USB Interrupts Wake Core0, As Does Core1 When The Trace Is Half Way Round.             ----
+//------------------------------------------------------------------------------------------------
+static bool UsbTask(void)
+{
+	tud_task();
+	RemoteLink_Service();
+
+	return tud_task_event_ready();
+}
+#endif
+
+//------------------------------------------------------------------------------------------------
+//---- Lowest Priority And Paced By The VGA Frame Interrupt. The Registers Are Redrawn One    ----
+//---- Per Slice, So A Bus Write Never Waits Behind The Whole Page.                           ----
+//------------------------------------------------------------------------------------------------
+static bool __hot_path_func(DisplayTask)(void)
+{
+	static u32 s_uLastFrame = 0;
+	static u32 s_uNextRegister = 16;
+
+	if (s_uNextRegister < 16)
+	{
+		RegisterPage_Update(s_uNextRegister, PeekRegister(s_uNextRegister));
+		++s_uNextRegister;
+		return true;
+	}
+
+#if LOGIC_SCOPE
+	// One Lane A Slice - The Whole Scope Moves Once A Frame.
+	if (LogicScope_Step(&s_logicScope))
+		return true;
+#endif
+
+	const u32 uFrame = GetVGAFrameCount();
+
+	if (uFrame != s_uLastFrame)
+	{
+		s_uLastFrame = uFrame;
+		s_uNextRegister = 0;
+
+#if LOGIC_SCOPE
+		LogicScope_Begin(&s_logicScope, &s_logicCapture);
+#endif
+
+#if REGISTER_PAGE_STATS
+		UpdateRegisterStats();
+#endif
+		UpdateDiagnostics();
+		return true;
+	}
+
+	VgaConsole_Service(CONSOLE_CHARS_PER_PASS);
+
+	return ((VGA_CONSOLE_BUFFER_SIZE - 1) != VgaConsole_GetSpace());
 }
 
 //------------------------------------------------------------------------------------------------
@@ -606,7 +764,11 @@ void ProcessVIA(void)
 //------------------------------------------------------------------------------------------------
 int main()
 {
+	ClockPlan_Init();
+
+	// USB Is Only Serviced From The Loop Below (See CMakeLists.txt), printf Stays On The VGA.
 	stdio_init_all();
+	stdio_set_driver_enabled(&stdio_usb, false);
 
 	gpio_init(PIN_CLK);
 	gpio_set_dir(PIN_CLK, GPIO_IN);
@@ -659,36 +821,77 @@ int main()
 		gpio_pull_up(PIN_PORT_B + uPinIndex);
 	}
 
+#if PERSONALITY_CIA_6526
+	// SP And CNT Are Open Collector On The Real Part, Inputs Until The Serial Port Shifts Out.
+	for(u32 uPin=PIN_CIA_SP; uPin<=PIN_CIA_TOD; ++uPin)
+	{
+		gpio_init(uPin);
+		gpio_set_dir(uPin, GPIO_IN);
+		gpio_pull_up(uPin);
+	}
+
+	Cia6526_Reset(&s_cia);
+#else
+	ViaPb7_Init(&s_pb7, pio1, PIN_CLK, PIN_PORT_B + 7);
+#endif
+
+	Scheduler_Init();
+
+#if !PERSONALITY_CIA_6526
+	s_uWriteEvent = Scheduler_ClaimEvent();
+	s_uIrqEvent = Scheduler_ClaimEvent();
+#endif
+#if REMOTE_LINK
+	s_uTraceEvent = Scheduler_ClaimEvent();
+#endif
+
+#if LOGIC_SCOPE
+	LogicCapture_Init(&s_logicCapture, LOGIC_SCOPE_DECIMATE);
+#endif
+
 	multicore_launch_core1(function_core1);
 
-	initVGA();
-	FilledRectangle(0, 0, VGA_RESOLUTION_X, VGA_RESOLUTION_Y, RGB_GREEN);
-	FilledRectangle(1, 1, VGA_RESOLUTION_X-2, VGA_RESOLUTION_Y-2, RGB_BLACK);
+	initVGA(PIN_RED, PIN_HSYNC, PIN_VSYNC);
 
-	// Draw All The Constant Text To The Screen
-	char szTempString[128];
-	DrawString(20, 18, "VIA 6522", RGB_CYAN);
+#if LOG_PAGE_CRC
+	VgaSnapshot_Init();
+	VgaSnapshot_BeginFrame();
+#endif
 
-	for (u32 uRegisterIndex=0; uRegisterIndex<16; ++uRegisterIndex)
-	{ 
-		sprintf(szTempString, "0x%04X", 0x9110 + uRegisterIndex);
-		DrawString(13, 20 + uRegisterIndex, szTempString, RGB_BLUE);
-		DrawString(20, 20 + uRegisterIndex, "0x", RGB_YELLOW);
-		DrawString(25, 20 + uRegisterIndex, s_aszRegisterNames[uRegisterIndex], RGB_CYAN);
-	}
+	RegisterPage_Draw();
 
-	while(true)
-	{
-		// Loop For All 16 Registers
-		for (u32 uRegisterIndex=0; uRegisterIndex<16; ++uRegisterIndex)
-		{ 
-			// Write The Register Values To The Appropriate Screen Position
-			const uint16_t uHexPair = byteToHex(s_viaRegs.m_aReg[uRegisterIndex]);
-			DrawPetsciiChar(22 << 3, (20 + uRegisterIndex) << 3, uHexPair >> 8, RGB_YELLOW);
-			DrawPetsciiChar(23 << 3, (20 + uRegisterIndex) << 3, uHexPair & 255, RGB_YELLOW);
-
-			// Call This Often Or The Input Buffer Will Overflow!!!
-			ProcessVIA();
-		}
-	}
+	// printf Only Queues Text, It Is Drawn A Few Characters At A Time From The Loop Below.
+	VgaConsole_Init(CONSOLE_LEFT, CONSOLE_TOP, CONSOLE_WIDE, CONSOLE_HIGH, RGB_GREEN);
+	VgaConsole_EnableStdio();
+
+#if LOG_PAGE_CRC
+	VgaSnapshot pageSnapshot;
+	VgaSnapshot_EndFrame(&pageSnapshot);
+#endif
+
+#if LOGIC_SCOPE
+	LogicScope_Init(&s_logicScope, &s_logicCapture, LOGIC_SCOPE_X, LOGIC_SCOPE_Y, VGA_RESOLUTION_X);
+#endif
+
+#if REMOTE_LINK
+	RemoteLink_Init();
+#endif
+
+	printf("%s Ready\n", REGISTER_PAGE_TITLE);
+
+#if LOG_PAGE_CRC
+	printf("Page CRC %08X, Drawn In %u Cycles, Hashed In %u\n", pageSnapshot.m_uCrc, pageSnapshot.m_uRenderCycles, pageSnapshot.m_uHashCycles);
+#endif
+
+	// Event Tasks In Priority Order, Then The Background Ones.
+#if !PERSONALITY_CIA_6526
+	Scheduler_AddTask(ViaTask, s_uWriteEvent | s_uIrqEvent);
+#endif
+#if REMOTE_LINK
+	Scheduler_AddTask(UsbTask, s_uTraceEvent);
+	Scheduler_AddTask(UsbTask, SCHEDULER_BACKGROUND);
+#endif
+	Scheduler_AddTask(DisplayTask, SCHEDULER_BACKGROUND);
+
+	Scheduler_Run();
 }
@@ -0,0 +1,116 @@
+//------------------------------------------------------------------------------------------------
+//---- VIA 6522 ... 2026 Dave Gaunt                                                           ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include "Via6522.h"
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void Via6522_Reset(volatile ViaRegisters* pVia)
+{
+	for (u32 uRegister=0; uRegister<16; ++uRegister)
+		pVia->m_aReg[uRegister] = 0;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Core0 Side Of A Register Write, Taken Off The Ring Buffer.                             ----
+//------------------------------------------------------------------------------------------------
+void __hot_path_func(Via6522_Write)(volatile ViaRegisters* pVia, const u32 uRegister, const u8 uData)
+{
+	switch(uRegister)
+	{
+		case VIA_REG_TIMER1_L:
+		{
+			// Write Data Into The Low Order Latch... Not The Counter!!!
+			pVia->m_uTimer1_Latch_L = uData;
+		}
+		break;
+
+		case VIA_REG_TIMER1_H:
+		{
+			// A Zero Latch Still Starts It - The Chip Fires 1.5 Cycles Later.
+			pVia->m_uTimer1_Latch_H = uData;
+			pVia->m_uTimer1 = pVia->m_uTimer1_Latch ? pVia->m_uTimer1_Latch : 1;
+			pVia->m_uInterruptFlags &= ~(1 << VIA_IRQ_TIMER1);
+		}
+		break;
+
+		case VIA_REG_TIMER1_LATCH_L:
+		{
+			pVia->m_uTimer1_Latch_L = uData;
+		}
+		break;
+
+		case VIA_REG_TIMER1_LATCH_H:
+		{
+			pVia->m_uTimer1_Latch_H = uData;
+			pVia->m_uInterruptFlags &= ~(1 << VIA_IRQ_TIMER1);
+		}
+		break;
+
+		case VIA_REG_INTERRUPT_FLAGS:
+		{
+			if (uData & 0x80)
+			{
+				// Bit 7 Is High So Enable Any Specified Interrupts.
+				pVia->m_uInterruptFlags |= (uData & 0x7F);
+			}
+			else
+			{
+				// Bit 7 Is Low So Disable Any Specified Interrupts.
+				pVia->m_uInterruptFlags &= (~uData & 0x7F);
+			}
+
+			if (pVia->m_uInterruptFlags)
+				pVia->m_uInterruptFlags |= (1 << VIA_IRQ_SET_CLR);
+		}
+		break;
+
+		case VIA_REG_INTERRUPT_ENABLE:
+		{
+			if (uData & 0x80)
+			{
+				// Bit 7 Is High So Enable Any Specified Interrupts.
+				pVia->m_uInterruptEnable |= (uData & 0x7F);
+			}
+			else
+			{
+				// Bit 7 Is Low So Disable Any Specified Interrupts.
+				pVia->m_uInterruptEnable &= (~uData & 0x7F);
+			}
+		}
+		break;
+
+		default:
+		pVia->m_aReg[uRegister] = uData;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//---- uCycles Calls To Via6522_Tick Worked Out In One Go - Returns How Many Times Timer 1    ----
+//---- Fired. Host/via_fuzz.py Holds It To The Cycle By Cycle Version.                        ----
+//------------------------------------------------------------------------------------------------
+u32 Via6522_Advance(volatile ViaRegisters* pVia, const u32 uCycles)
+{
+	const u32 uTimer = pVia->m_uTimer1;
+
+	if (0 == uTimer)
+		return 0;
+
+	if (uCycles < uTimer)
+	{
+		pVia->m_uTimer1 = (u16)(uTimer - uCycles);
+		return 0;
+	}
+
+	// Fires Once As The Count Reaches 1, Then Every Period - Never Less Than 2 Cycles.
+	const u32 uPeriod = Via6522_Timer1Period(pVia);
+	const u32 uAfter = uCycles - uTimer;
+
+	pVia->m_uInterruptFlags |= (1 << VIA_IRQ_TIMER1);
+
+	pVia->m_uTimer1 = (u16)(uPeriod - (uAfter % uPeriod));
+	return 1 + (uAfter / uPeriod);
+}
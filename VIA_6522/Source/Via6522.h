@@ -0,0 +1,165 @@
+//------------------------------------------------------------------------------------------------
+//---- VIA 6522 ... 2026 Dave Gaunt                                                           ----
+//------------------------------------------------------------------------------------------------
+//---- The 6522 Register Model Without The Pins - VIA_6522.c Drives It From The Bus, And      ----
+//---- Host/system_sim_test.py Drives It From A 6502 Interpreter.                             ----
+//------------------------------------------------------------------------------------------------
+#ifndef __Via6522_h_included
+#define __Via6522_h_included
+
+#include <assert.h>
+
+#include "types.h"
+
+enum via_register_names
+{
+	VIA_REG_PORTB = 0,
+	VIA_REG_PORTA,
+	VIA_REG_DATA_DIRB,
+	VIA_REG_DATA_DIRA,
+	VIA_REG_TIMER1_L,
+	VIA_REG_TIMER1_H,
+	VIA_REG_TIMER1_LATCH_L,
+	VIA_REG_TIMER1_LATCH_H,
+	VIA_REG_TIMER2_L,
+	VIA_REG_TIMER2_H,
+	VIA_REG_SHIFT,
+	VIA_REG_AUXILIARY_CONTROL,
+	VIA_REG_PERIPHERAL_CONTROL,
+	VIA_REG_INTERRUPT_FLAGS,
+	VIA_REG_INTERRUPT_ENABLE,
+	VIA_REG_PORTA_NO_HANDSHAKE
+};
+
+enum via_irq_flags
+{
+	VIA_IRQ_CA2 = 0,
+	VIA_IRQ_CA1,
+	VIA_IRQ_SHIFT,
+	VIA_IRQ_CB2,
+	VIA_IRQ_CB1,
+	VIA_IRQ_TIMER2,
+	VIA_IRQ_TIMER1,
+	VIA_IRQ_SET_CLR
+};
+
+typedef struct
+{
+	union
+	{
+		u8 m_aReg[16];
+		struct
+		{
+			u8 m_u8PortB;					/* 0 */
+			u8 m_u8PortA;					/* 1 */
+			u8 m_uDataDirB;					/* 2 */
+			u8 m_uDataDirA;					/* 3 */
+			union
+			{
+				u16	m_uTimer1;
+				struct
+				{
+					u8 m_uTimer1_L;			/* 4 */
+					u8 m_uTimer1_H;			/* 5 */
+				};
+			};
+			union
+			{
+				u16	m_uTimer1_Latch;
+				struct
+				{
+					u8 m_uTimer1_Latch_L;	/* 6 */
+					u8 m_uTimer1_Latch_H;	/* 7 */
+				};
+			};
+			union
+			{
+				u16	m_uTimer2;
+				struct
+				{
+					u8 m_uTimer2_L;			/* 8 */
+					u8 m_uTimer2_H;			/* 9 */
+				};
+			};
+			u8 m_uShiftReg;					/* A */
+			u8 m_uAuxiliaryCtrl;			/* B */
+			u8 m_uPeripheralCtrl;			/* C */
+			u8 m_uInterruptFlags;			/* D */
+			u8 m_uInterruptEnable;			/* E */
+			u8 m_u8PortA_NoHandshake;		/* F */
+		};
+	};
+} ViaRegisters;
+static_assert(sizeof(ViaRegisters) == 16);
+
+void Via6522_Reset(volatile ViaRegisters* pVia);
+void Via6522_Write(volatile ViaRegisters* pVia, const u32 uRegister, const u8 uData);
+u32 Via6522_Advance(volatile ViaRegisters* pVia, const u32 uCycles);
+
+//------------------------------------------------------------------------------------------------
+//---- Cycles Between Timer 1 Firings - The Chip Counts Through 0 And $FFFF Before The Latch  ----
+//---- Goes Back In, So N + 2, As PB7 Toggles. m_uTimer1 Holds Cycles To The Next Firing, So  ----
+//---- Latches Of $FFFE And $FFFF Run One Or Two Cycles Short.                                ----
+//------------------------------------------------------------------------------------------------
+static inline u16 Via6522_Timer1Period(const volatile ViaRegisters* pVia)
+{
+	const u32 uLatch = pVia->m_uTimer1_Latch;
+
+	return (uLatch < 0xFFFE) ? (u16)(uLatch + 2) : 0xFFFF;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Once Per S02 Falling Edge - Returns True As Timer 1 Reloads And Raises Its Flag.       ----
+//------------------------------------------------------------------------------------------------
+static inline bool Via6522_Tick(volatile ViaRegisters* pVia)
+{
+	if (0 == pVia->m_uTimer1)
+		return false;
+
+	// If the Timer Will Go To Zero
+	if (1 == pVia->m_uTimer1)
+	{
+		pVia->m_uTimer1 = Via6522_Timer1Period(pVia);
+		pVia->m_uInterruptFlags |= (1 << VIA_IRQ_TIMER1);
+		return true;
+	}
+
+	pVia->m_uTimer1--;
+	return false;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- S02 Edges Until Timer 1 Next Fires, 0 = Stopped - How Far Via6522_Advance Can Jump.    ----
+//------------------------------------------------------------------------------------------------
+static inline u32 Via6522_CyclesToFire(const volatile ViaRegisters* pVia)
+{
+	return pVia->m_uTimer1;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- After The Data Has Left The Bus - Returns True If The Read Cleared A Flag.             ----
+//------------------------------------------------------------------------------------------------
+static inline bool Via6522_ReadDone(volatile ViaRegisters* pVia, const u32 uRegister)
+{
+	// If We Read Timer1 Low Byte Clear The IRQ Flag.
+	if (VIA_REG_TIMER1_L != uRegister)
+		return false;
+
+	pVia->m_uInterruptFlags &= ~(1 << VIA_IRQ_TIMER1);
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Recomputes IFR Bit 7 From The Enabled Flags - Returns True While #IRQ Should Be Low.   ----
+//------------------------------------------------------------------------------------------------
+static inline bool Via6522_UpdateIrq(volatile ViaRegisters* pVia)
+{
+	const u8 uInterrupFlags = pVia->m_uInterruptFlags & pVia->m_uInterruptEnable;
+
+	// If Any Enabled Interrupt Is Flagged The Set The Hi Bit
+	pVia->m_uInterruptFlags = (uInterrupFlags) ? (1 << VIA_IRQ_SET_CLR) | uInterrupFlags : 0;
+
+	return (0 != uInterrupFlags);
+}
+
+#endif /* __Via6522_h_included */
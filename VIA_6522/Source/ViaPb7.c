@@ -0,0 +1,36 @@
+//------------------------------------------------------------------------------------------------
+//---- VIA PB7 ... 2026 Dave Gaunt                                                            ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include "ViaPb7.h"
+
+#include "via_pb7.pio.h"
+
+//------------------------------------------------------------------------------------------------
+//---- PB7 Is Above GPIO 31, So The Whole PIO Block Is Moved Up To GPIO 16 - S02 Stays In     ----
+//---- Reach. The Pin Stays On Port B Until ACR Bit 7 Is Set.                                 ----
+//------------------------------------------------------------------------------------------------
+void ViaPb7_Init(ViaPb7* pPb7, PIO pio, const u32 uS02Pin, const u32 uPb7Pin)
+{
+	pio_set_gpio_base(pio, 16);
+
+	const u32 uOffset = pio_add_program(pio, &via_pb7_program);
+	const u32 uSm = (u32)pio_claim_unused_sm(pio, true);
+
+	pPb7->m_pio = pio;
+	pPb7->m_uSm = uSm;
+	pPb7->m_uOneShotPc = uOffset + via_pb7_offset_one_shot;
+	pPb7->m_uFreeRunPc = uOffset + via_pb7_offset_free_run;
+	pPb7->m_uPin = uPb7Pin;
+	pPb7->m_uFuncSel = pio_get_funcsel(pio);
+	pPb7->m_uLatchL = 0;
+	pPb7->m_uLatchH = 0;
+	pPb7->m_uAcr = 0;
+	pPb7->m_bFreeRunning = false;
+
+	via_pb7_program_init(pio, uSm, uOffset, uS02Pin, uPb7Pin);
+
+	// Waits On Its First Pull Until The First Write To T1C-H.
+	pio_sm_set_enabled(pio, uSm, true);
+}
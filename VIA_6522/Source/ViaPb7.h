@@ -0,0 +1,98 @@
+//------------------------------------------------------------------------------------------------
+//---- VIA PB7 ... 2026 Dave Gaunt                                                            ----
+//------------------------------------------------------------------------------------------------
+//---- Timer 1 On PB7 (ACR Bit 7) From A PIO State Machine Counting Phase 2 - Core1 Only      ----
+//---- Hands On The Timer 1 And ACR Writes - Every Edge Is The State Machine's.               ----
+//------------------------------------------------------------------------------------------------
+#ifndef __ViaPb7_h_included
+#define __ViaPb7_h_included
+
+#include "types.h"
+
+#include "hardware/pio.h"
+#include "hardware/structs/io_bank0.h"
+
+#include "Via6522.h"
+
+#define VIA_ACR_T1_FREE_RUN			(1 << 6)
+#define VIA_ACR_T1_PB7				(1 << 7)
+
+typedef struct
+{
+	PIO	m_pio;
+	u32	m_uSm;
+	u32	m_uOneShotPc;
+	u32	m_uFreeRunPc;
+	u32	m_uPin;
+	u32	m_uFuncSel;						/* GPIO_FUNC_PIOx For m_pio */
+	u8	m_uLatchL;
+	u8	m_uLatchH;
+	u8	m_uAcr;
+	bool	m_bFreeRunning;					/* Started Free Running By The Last T1C-H Write */
+} ViaPb7;
+
+void ViaPb7_Init(ViaPb7* pPb7, PIO pio, const u32 uS02Pin, const u32 uPb7Pin);
+
+//------------------------------------------------------------------------------------------------
+//---- Free Running, Each Reload Pulls One Entry - So The FIFO Only Ever Holds The Newest     ----
+//---- Latch, Whichever Byte Changed. A Reload In The Few Clocks Between The Clear And The    ----
+//---- Put Takes The Old Latch Once. A One Shot Never Reloads, And One Not Yet Started Would  ----
+//---- Take The Put As Its T1C-H Write, So Both Are Left Alone.                               ----
+//------------------------------------------------------------------------------------------------
+static inline void ViaPb7_Reload(ViaPb7* pPb7)
+{
+	if (pPb7->m_bFreeRunning)
+	{
+		pio_sm_clear_fifos(pPb7->m_pio, pPb7->m_uSm);
+		pio_sm_put(pPb7->m_pio, pPb7->m_uSm, ((pPb7->m_uLatchH << 8) | pPb7->m_uLatchL) + 1);
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//---- On Core1 As The Write Is Seen - Register Writes Only, Nothing From Flash.              ----
+//------------------------------------------------------------------------------------------------
+static inline void ViaPb7_Write(ViaPb7* pPb7, const u32 uRegister, const u8 uData)
+{
+	switch(uRegister)
+	{
+		case VIA_REG_TIMER1_L:
+		case VIA_REG_TIMER1_LATCH_L:
+			pPb7->m_uLatchL = uData;
+			ViaPb7_Reload(pPb7);
+		break;
+
+		case VIA_REG_TIMER1_H:
+		{
+			// Start Again From The Write - Whatever It Was Counting, And Any Latch Still Queued, Goes.
+			const PIO pio = pPb7->m_pio;
+			const u32 uSm = pPb7->m_uSm;
+
+			pPb7->m_uLatchH = uData;
+			pPb7->m_bFreeRunning = (0 != (pPb7->m_uAcr & VIA_ACR_T1_FREE_RUN));
+			pio_sm_set_enabled(pio, uSm, false);
+			pio_sm_clear_fifos(pio, uSm);
+			pio_sm_put(pio, uSm, ((uData << 8) | pPb7->m_uLatchL) + 1);
+			pio_sm_exec(pio, uSm, pio_encode_jmp(pPb7->m_bFreeRunning ? pPb7->m_uFreeRunPc : pPb7->m_uOneShotPc));
+			pio_sm_set_enabled(pio, uSm, true);
+		}
+		break;
+
+		case VIA_REG_TIMER1_LATCH_H:
+			// Pulled As The Count Next Reloads.
+			pPb7->m_uLatchH = uData;
+			ViaPb7_Reload(pPb7);
+		break;
+
+		case VIA_REG_AUXILIARY_CONTROL:
+			// Bit 7 Hands The Pin Between Port B And The State Machine, Which Keeps Counting Either Way.
+			if ((pPb7->m_uAcr ^ uData) & VIA_ACR_T1_PB7)
+				hw_write_masked(&io_bank0_hw->io[pPb7->m_uPin].ctrl, ((uData & VIA_ACR_T1_PB7) ? pPb7->m_uFuncSel : GPIO_FUNC_SIO) << IO_BANK0_GPIO0_CTRL_FUNCSEL_LSB,
+								IO_BANK0_GPIO0_CTRL_FUNCSEL_BITS);
+
+			// Bit 6 Is Only Looked At On The Next Write To T1C-H.
+			pPb7->m_uAcr = uData;
+		break;
+	}
+}
+
+#endif /* __ViaPb7_h_included */
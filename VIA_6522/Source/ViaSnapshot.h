@@ -0,0 +1,73 @@
+//------------------------------------------------------------------------------------------------
+//---- VIA Snapshot ... 2026 Dave Gaunt                                                       ----
+//------------------------------------------------------------------------------------------------
+//---- Everything Needed To Put The VIA Back As It Was Just After One Bus Access - Taken By   ----
+//---- Core1 When An Access Matches The Trigger, Read And Restored Over The USB Link, And     ----
+//---- Loaded Into Host/system_sim_test.py To Replay It On The PC.                            ----
+//------------------------------------------------------------------------------------------------
+#ifndef __ViaSnapshot_h_included
+#define __ViaSnapshot_h_included
+
+#include "Via6522.h"
+#include "ViaWriteRing.h"
+
+#define VIA_SNAPSHOT_MAGIC			(0x50414E53)	/* "SNAP" */
+#define VIA_SNAPSHOT_VERSION		(1)
+#define VIA_SNAPSHOT_RING_SIZE		(VIA_WRITE_RING_SIZE)
+
+#define VIA_SNAPSHOT_IRQ_LOW		(1 << 0)		/* #IRQ Was Asserted */
+
+// Sent As It Sits In Memory, Little Endian - usb_link.py's Snapshot Class Reads The Same Layout.
+typedef struct
+{
+	u32				m_uMagic;
+	u8				m_uVersion;
+	u8				m_uFlags;
+	u8				m_uFirstWrite;						/* Ring Index Of The Oldest Queued Write */
+	u8				m_uWrites;							/* How Many Follow It, Wrapping At 16 */
+	u32				m_uBusCycle;						/* Counted From Core1 Starting */
+	u32				m_uTrigger;							/* Trace Entry Of The Access It Was Taken On */
+	ViaRegisters	m_viaRegs;
+	ViaQueuedWrite	m_aRing[VIA_SNAPSHOT_RING_SIZE];
+} ViaSnapshot;
+static_assert(sizeof(ViaSnapshot) == 64);
+
+//------------------------------------------------------------------------------------------------
+//---- Straight Copies, Whatever Is Queued - The Same Few Dozen Cycles On Core1 Every Time.   ----
+//------------------------------------------------------------------------------------------------
+static inline void ViaSnapshot_Take(ViaSnapshot* pSnapshot, const volatile ViaRegisters* pVia, const volatile ViaQueuedWrite* pRing,
+									const u32 uFirstWrite, const u32 uWrites, const u32 uBusCycle, const u32 uTrigger, const u32 uFlags)
+{
+	pSnapshot->m_uMagic = VIA_SNAPSHOT_MAGIC;
+	pSnapshot->m_uVersion = VIA_SNAPSHOT_VERSION;
+	pSnapshot->m_uFlags = (u8)uFlags;
+	pSnapshot->m_uFirstWrite = (u8)uFirstWrite;
+	pSnapshot->m_uWrites = (u8)uWrites;
+	pSnapshot->m_uBusCycle = uBusCycle;
+	pSnapshot->m_uTrigger = uTrigger;
+	pSnapshot->m_viaRegs = *pVia;
+
+	for (u32 uSlot=0; uSlot<VIA_SNAPSHOT_RING_SIZE; ++uSlot)
+		pSnapshot->m_aRing[uSlot] = pRing[uSlot];
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Anything Coming In Over The Link Is Checked Before It Goes Near The Registers.         ----
+//------------------------------------------------------------------------------------------------
+static inline bool ViaSnapshot_IsValid(const ViaSnapshot* pSnapshot)
+{
+	return	(VIA_SNAPSHOT_MAGIC == pSnapshot->m_uMagic) &&
+			(VIA_SNAPSHOT_VERSION == pSnapshot->m_uVersion) &&
+			(pSnapshot->m_uFirstWrite < VIA_SNAPSHOT_RING_SIZE) &&
+			(pSnapshot->m_uWrites < VIA_SNAPSHOT_RING_SIZE);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Queued Writes Oldest First, uIndex From 0 To m_uWrites - 1.                            ----
+//------------------------------------------------------------------------------------------------
+static inline ViaQueuedWrite ViaSnapshot_GetWrite(const ViaSnapshot* pSnapshot, const u32 uIndex)
+{
+	return pSnapshot->m_aRing[(pSnapshot->m_uFirstWrite + uIndex) & (VIA_SNAPSHOT_RING_SIZE - 1)];
+}
+
+#endif /* __ViaSnapshot_h_included */
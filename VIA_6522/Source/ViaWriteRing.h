@@ -0,0 +1,77 @@
+//------------------------------------------------------------------------------------------------
+//---- VIA Write Ring ... 2026 Dave Gaunt                                                     ----
+//------------------------------------------------------------------------------------------------
+//---- Register Writes Core1 Hands To Core0 - Core1 Pushes Into The Slot After m_uTail, Core0 ----
+//---- Pops The Slot After m_uHead. Host/via_fuzz.py And Host/system_sim_test.py Build This   ----
+//---- Same Header, So The Firmware's Ring Is What They Check.                                ----
+//------------------------------------------------------------------------------------------------
+#ifndef __ViaWriteRing_h_included
+#define __ViaWriteRing_h_included
+
+#include <assert.h>
+
+#include "types.h"
+
+#define VIA_WRITE_RING_SIZE			(16)			/* Must Be A Power Of 2! */
+
+// One Bus Write Waiting For Core0.
+typedef struct
+{
+	u8	m_uOffset;
+	u8	m_uData;
+} ViaQueuedWrite;
+
+typedef struct
+{
+	ViaQueuedWrite	m_aSlot[VIA_WRITE_RING_SIZE];
+	u8				m_uHead;							/* Last Slot Core0 Took */
+	u8				m_uTail;							/* Last Slot Core1 Filled */
+} ViaWriteRing;
+
+static inline void ViaWriteRing_Init(volatile ViaWriteRing* pRing)
+{
+	pRing->m_uHead = VIA_WRITE_RING_SIZE - 1;
+	pRing->m_uTail = VIA_WRITE_RING_SIZE - 1;
+}
+
+static inline bool ViaWriteRing_IsEmpty(const volatile ViaWriteRing* pRing)
+{
+	return pRing->m_uHead == pRing->m_uTail;
+}
+
+// How Many Writes Are Queued, And The Ring Index Of The Oldest - From One Read Of m_uHead.
+static inline u32 ViaWriteRing_GetQueued(const volatile ViaWriteRing* pRing, u32* pFirst)
+{
+	const u32 uHead = pRing->m_uHead;
+
+	*pFirst = (uHead + 1) & (VIA_WRITE_RING_SIZE - 1);
+	return (pRing->m_uTail - uHead) & (VIA_WRITE_RING_SIZE - 1);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Core1 Only. Returns The Slot Used.                                                     ----
+//------------------------------------------------------------------------------------------------
+static inline u32 ViaWriteRing_Push(volatile ViaWriteRing* pRing, const ViaQueuedWrite write)
+{
+	const u8 uTail = (pRing->m_uTail + 1) & (VIA_WRITE_RING_SIZE - 1);
+	assert(uTail != pRing->m_uHead);		// Ring Buffer Is Full !!!
+	pRing->m_aSlot[uTail] = write;
+	pRing->m_uTail = uTail;
+	return uTail;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Core0 Only. False If Nothing Is Queued.                                                ----
+//------------------------------------------------------------------------------------------------
+static inline bool ViaWriteRing_Pop(volatile ViaWriteRing* pRing, ViaQueuedWrite* pWrite)
+{
+	if (ViaWriteRing_IsEmpty(pRing))
+		return false;
+
+	const u8 uHead = (pRing->m_uHead + 1) & (VIA_WRITE_RING_SIZE - 1);
+	*pWrite = pRing->m_aSlot[uHead];
+	pRing->m_uHead = uHead;
+	return true;
+}
+
+#endif /* __ViaWriteRing_h_included */
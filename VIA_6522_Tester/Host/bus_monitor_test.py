@@ -0,0 +1,437 @@
+#!/usr/bin/env python3
+#------------------------------------------------------------------------------------------------
+#---- Bus Monitor Test ... 2026 Dave Gaunt                                                    ----
+#------------------------------------------------------------------------------------------------
+#---- Replays Synthetic Bus Waveforms Through Both Programs In Source/bus_monitor.pio On A    ----
+#---- Model Of The PIO, Then Through Source/BusViolations.c Built With gcc. Checks Every Bus  ----
+#---- Change Inside The Setup And Hold Windows Is Caught, None Outside Them Is, And The Log,  ----
+#---- Its Seen At Times And The Window Arithmetic, At Every Clock Plan.                       ----
+#------------------------------------------------------------------------------------------------
+import argparse
+import bisect
+import ctypes
+import os
+import random
+import re
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+COMMON = os.path.join(HERE, "..", "..", "Common")
+SOURCE = os.path.join(HERE, "..", "Source")
+PROGRAM = os.path.join(SOURCE, "bus_monitor.pio")
+
+PLANS_MHZ = (150, 200, 250, 300)
+VIC_CPU_CLOCK = 4433618 >> 2    # Phase 2 on the tester, PAL
+SYNC = 2                        # Input synchroniser, in system clocks
+SETUP_NS = 50                   # BUS_MONITOR_SETUP_NS in VIA_6522_Tester.c
+HOLD_NS = 30                    # BUS_MONITOR_HOLD_NS
+PIO2_INSTRUCTIONS = 32          # Shared with irq_latency.pio
+SETUP, HOLD = 0, 1
+RW, IRQ, DATA_SHIFT = 1, 2, 2   # BUS_SAMPLE_*
+RING = 32                       # VIOLATION_RING_SIZE
+
+GLUE_C = r"""
+#include "BusViolations.h"
+
+unsigned Glue_LogSize(void)
+{
+	return sizeof(ViolationLog);
+}
+"""
+
+
+class BusWindow(ctypes.Structure):
+    _fields_ = [(name, ctypes.c_uint32) for name in ("setup_delay", "hold_turns", "setup_clocks", "hold_clocks")]
+
+
+class Violation(ctypes.Structure):
+    _fields_ = [("seen_us", ctypes.c_uint32), ("before", ctypes.c_uint16), ("after", ctypes.c_uint16), ("kind", ctypes.c_uint32)]
+
+
+def build(work, compiler):
+    glue = os.path.join(work, "bus_violations_glue.c")
+    with open(glue, "w") as f:
+        f.write(GLUE_C)
+
+    library = os.path.join(work, "bus_violations.so")
+    subprocess.check_call([compiler, "-std=gnu11", "-O2", "-shared", "-fPIC", "-Wall", "-Werror", "-I" + COMMON, "-I" + SOURCE,
+                           os.path.join(SOURCE, "BusViolations.c"), glue, "-o", library])
+
+    lib = ctypes.CDLL(library)
+    lib.Glue_LogSize.restype = ctypes.c_uint32
+    lib.BusViolations_GetWindow.argtypes = [ctypes.POINTER(BusWindow)] + [ctypes.c_uint32] * 4
+    lib.ViolationLog_Reset.argtypes = [ctypes.c_void_p]
+    lib.ViolationLog_Add.argtypes = [ctypes.c_void_p] + [ctypes.c_uint32] * 3
+    lib.ViolationLog_Add.restype = ctypes.c_bool
+    lib.ViolationLog_GetRecent.argtypes = [ctypes.c_void_p, ctypes.c_uint32]
+    lib.ViolationLog_GetRecent.restype = ctypes.POINTER(Violation)
+    return lib
+
+
+def window(lib, mhz, setup_ns=SETUP_NS, hold_ns=HOLD_NS):
+    result = BusWindow()
+    lib.BusViolations_GetWindow(ctypes.byref(result), mhz * 1000000, VIC_CPU_CLOCK, setup_ns, hold_ns)
+    return result
+
+
+def load_programs(path):
+    """Just enough of pioasm for bus_monitor.pio - every program in the file, by name."""
+    with open(path) as f:
+        text = re.sub(r"% c-sdk \{.*?%\}", "", f.read(), flags=re.S)
+    programs, program = {}, None
+    for line in text.splitlines():
+        line = line.split(";")[0].strip()
+        if not line:
+            continue
+        if line.startswith(".program"):
+            program = {"code": [], "labels": {}, "defines": {}, "wrap_target": 0, "wrap": None}
+            programs[line.split()[1]] = program
+        elif line.startswith(".define"):
+            words = line.split()
+            program["defines"][words[-2]] = int(words[-1], 0)
+        elif line == ".wrap_target":
+            program["wrap_target"] = len(program["code"])
+        elif line == ".wrap":
+            program["wrap"] = len(program["code"]) - 1
+        elif line.endswith(":"):
+            program["labels"][line[:-1].replace("public ", "")] = len(program["code"])
+        else:
+            if re.search(r"\[\d+\]$", line):
+                raise ValueError("delays not modelled: %s" % line)
+            op, _, operands = line.partition(" ")
+            operands = [program["defines"].get(o, o) for o in re.split(r"[,\s]+", operands.strip())] if operands else []
+            program["code"].append((op, operands))
+    for program in programs.values():
+        if program["wrap"] is None:
+            program["wrap"] = len(program["code"]) - 1
+    return programs
+
+
+def count_instructions(path):
+    with open(path) as f:
+        text = re.sub(r"% c-sdk \{.*?%\}", "", f.read(), flags=re.S)
+    count = 0
+    for line in text.splitlines():
+        line = line.split(";")[0].strip()
+        if line and not line.startswith(".") and not line.endswith(":"):
+            count += 1
+    return count
+
+
+class Signal:
+    """A value that changes at each (clock, value) - the value holds from that clock on."""
+
+    def __init__(self, start, changes):
+        self.start = start
+        self.clocks = [c for c, _ in changes]
+        self.values = [v for _, v in changes]
+
+    def at(self, clock):
+        index = bisect.bisect_right(self.clocks, clock)
+        return self.values[index - 1] if index else self.start
+
+    def next_change(self, clock):
+        index = bisect.bisect_right(self.clocks, clock)
+        return self.clocks[index] if index < len(self.clocks) else None
+
+
+class StateMachine:
+    """One instruction a clock, every pin seen through the synchroniser. MOV PINS reads the
+    10 bit bus, WAIT GPIO and JMP PIN read phase 2. Waits jump straight to the edge, and the
+    setup delay's one instruction loop is taken in one go."""
+
+    def __init__(self, program, s02, bus, tx=(), out_threshold=32):
+        self.code, self.labels = program["code"], program["labels"]
+        self.wrap_target, self.wrap = program["wrap_target"], program["wrap"]
+        self.s02, self.bus = s02, bus
+        self.tx = list(tx)
+        self.out_threshold = out_threshold
+        self.pc = program["labels"].get("top", 0)
+        self.x = self.y = self.osr = self.isr = 0
+        self.isr_count = self.osr_count = 0
+        self.clock = 0
+        self.words = []
+
+    def step(self):
+        op, operands = self.code[self.pc]
+        next_pc = self.wrap_target if self.pc == self.wrap else self.pc + 1
+
+        if op == "pull":
+            self.osr, self.osr_count = self.tx.pop(0), 0
+        elif op == "mov":
+            destination, source = operands
+            if source == "pins":
+                value = self.bus.at(self.clock - SYNC)
+            else:
+                value = {"null": 0}.get(source)
+                if value is None:
+                    value = getattr(self, source)
+            setattr(self, destination, value)
+            if destination == "osr":
+                self.osr_count = 0
+        elif op == "wait":
+            level, source, _ = int(operands[0]), operands[1], operands[2]
+            assert source == "gpio"
+            if self.s02.at(self.clock - SYNC) != level:
+                change = self.s02.next_change(self.clock - SYNC)
+                if change is None:
+                    self.clock = None
+                    return
+                self.clock = change + SYNC
+                return
+        elif op == "jmp":
+            condition, target = (None, operands[0]) if len(operands) == 1 else operands
+            if condition is None:
+                taken = True
+            elif condition == "x--":
+                if self.x and self.code[self.labels[target]] == (op, operands):
+                    self.clock += self.x
+                    self.x = 0
+                taken = self.x != 0
+                self.x = (self.x - 1) & 0xFFFFFFFF
+            elif condition == "x!=y":
+                taken = self.x != self.y
+            elif condition == "pin":
+                taken = self.s02.at(self.clock - SYNC) == 1
+            elif condition == "!osre":
+                taken = self.osr_count < self.out_threshold
+            else:
+                raise ValueError("jmp %s not modelled" % condition)
+            if taken:
+                next_pc = self.labels[target]
+        elif op == "out":
+            assert operands == ["null", "1"]
+            self.osr_count += 1
+        elif op == "in":
+            bits = int(operands[1])
+            self.isr = ((self.isr << bits) | (getattr(self, operands[0]) & ((1 << bits) - 1))) & 0xFFFFFFFF
+            self.isr_count += bits
+            if self.isr_count >= 32:
+                self.words.append((self.clock, self.isr))
+                self.isr, self.isr_count = 0, 0
+        else:
+            raise ValueError("%s not modelled" % op)
+
+        self.pc = next_pc
+        self.clock += 1
+
+    def run(self, until):
+        while self.clock is not None and self.clock < until:
+            self.step()
+        return self.words
+
+
+def phase2(mhz, cycles):
+    """clock_gpio_init's fractional divider - rising at k x divider, falling half a cycle on."""
+    divider = mhz * 1000000 / VIC_CPU_CLOCK
+    rises = [200 + int(round(k * divider)) for k in range(cycles)]
+    falls = [200 + int(round((k + 0.5) * divider)) for k in range(cycles)]
+    changes = []
+    for rise, fall in zip(rises, falls):
+        changes += [(rise, 1), (fall, 0)]
+    return Signal(0, changes), rises, falls
+
+
+def monitor(programs, lib, mhz, bus, cycles, setup_ns=SETUP_NS, hold_ns=HOLD_NS):
+    """Both state machines over the same bus - the words each pushed, with the clock of the push."""
+    s02, rises, falls = phase2(mhz, cycles)
+    w = window(lib, mhz, setup_ns, hold_ns)
+    setup = StateMachine(programs["bus_setup"], s02, bus, tx=[w.setup_delay]).run(falls[-1])
+    hold = StateMachine(programs["bus_hold"], s02, bus, out_threshold=w.hold_turns).run(falls[-1])
+    return setup, hold, rises, falls, w
+
+
+def nearest(falls, clock):
+    """The cycle a word belongs to - both programs push within a few clocks of what they saw,
+    and both windows sit close to the fall."""
+    index = bisect.bisect_left(falls, clock)
+    if index and (index == len(falls) or clock - falls[index - 1] < falls[index] - clock):
+        index -= 1
+    return index
+
+
+class Checker:
+    def __init__(self):
+        self.failures = 0
+        self.checks = 0
+
+    def check(self, condition, what):
+        self.checks += 1
+        if not condition:
+            self.failures += 1
+            print("FAIL: %s" % what)
+
+
+def test_programs(check, programs):
+    for name in ("bus_setup", "bus_hold"):
+        check.check(programs[name]["defines"].get("S02_PIN") == 3, "%s waits on PIN_S02_READ" % name)
+    used = count_instructions(PROGRAM) + count_instructions(os.path.join(SOURCE, "irq_latency.pio"))
+    check.check(used <= PIO2_INSTRUCTIONS, "bus_setup, bus_hold and irq_latency share PIO2: %d of %d instructions" % (used, PIO2_INSTRUCTIONS))
+    return used
+
+
+def sweep(check, programs, lib, mhz):
+    """One data bit moving at every clock from well before to well after the fall, once a
+    cycle, and moving back in the middle of the low phase. Returns the earliest and latest
+    offsets from the fall that were caught."""
+    s02, rises, falls = phase2(mhz, 260)
+    offsets = list(range(-60, 61))
+    changes, expected = [], {}
+    value = 0x155 << 0
+    for k, offset in enumerate(offsets):
+        cycle = 4 + 2 * k
+        clock = falls[cycle] + offset
+        changes.append((clock, value ^ (1 << DATA_SHIFT + (k & 7))))
+        changes.append(((falls[cycle + 1] + rises[cycle + 2]) // 2, value))
+        expected[cycle] = offset
+    bus = Signal(value, changes)
+    setup, hold, _, _, w = monitor(programs, lib, mhz, bus, 260)
+
+    caught = {}
+    for kind, words in ((SETUP, setup), (HOLD, hold)):
+        for clock, word in words:
+            caught.setdefault(nearest(falls, clock), set()).add(kind)
+            before, after = word >> 16 & 0x3FF, word & 0x3FF
+            check.check(before == value and bin(before ^ after).count("1") == 1,
+                        "%d MHz: word %08X is the bus before and after one bit moved" % (mhz, word))
+
+    seen = sorted(expected[c] for c in caught if c in expected)
+    stray = [c for c in caught if c not in expected]
+    check.check(not stray, "%d MHz: nothing caught in the cycles with no change (%s)" % (mhz, stray))
+
+    kinds = {expected[c]: caught[c] for c in caught if c in expected}
+    early, late = (min(seen), max(seen)) if seen else (0, 0)
+    missed = [o for o in offsets if early <= o <= late and o not in kinds]
+    check.check(not missed, "%d MHz: every change between %d and %+d clocks of the fall is caught (missed %s)" % (mhz, early, late, missed))
+    check.check(all(kinds[o] == {SETUP} for o in kinds if o < -2) and all(kinds[o] == {HOLD} for o in kinds if o > 1),
+                "%d MHz: before the fall is setup, after it hold" % mhz)
+
+    # The windows cover what was asked, and not much more than BusViolations_GetWindow says.
+    sys_hz = mhz * 1000000
+    want_setup = -((SETUP_NS * sys_hz + 999999999) // 1000000000)
+    want_hold = (HOLD_NS * sys_hz + 999999999) // 1000000000
+    check.check(early <= want_setup and early >= -int(w.setup_clocks) - 2,
+                "%d MHz: setup window from %d clocks, asked %d, reported %d" % (mhz, early, want_setup, -w.setup_clocks))
+    check.check(late >= want_hold and late <= w.hold_clocks + 2,
+                "%d MHz: hold window to %+d clocks, asked %d, reported %d" % (mhz, late, want_hold, w.hold_clocks))
+    return early, late, w
+
+
+def test_glitch(check, programs, lib, mhz, rng):
+    """A short pulse on one bit, moving and moving back inside a window - caught if it is at
+    least as long as the sampling step, 3 clocks for setup and 4 for hold."""
+    s02, rises, falls = phase2(mhz, 140)
+    value = 0x2AA
+    changes, cases = [], {}
+    w = window(lib, mhz)
+    for k in range(60):
+        cycle = 4 + 2 * k
+        if k & 1:
+            start = falls[cycle] + rng.randint(1, max(1, w.hold_clocks - 5))
+            width = 4
+        else:
+            start = falls[cycle] - rng.randint(5, max(5, w.setup_clocks - 2))
+            width = 3
+        bit = 1 << (DATA_SHIFT + rng.randint(0, 7))
+        changes += [(start, value ^ bit), (start + width, value)]
+        cases[cycle] = HOLD if k & 1 else SETUP
+    setup, hold, _, _, _ = monitor(programs, lib, mhz, Signal(value, changes), 140)
+    caught = {}
+    for kind, words in ((SETUP, setup), (HOLD, hold)):
+        for clock, _ in words:
+            caught.setdefault(nearest(falls, clock), set()).add(kind)
+    right = [c for c in cases if cases[c] in caught.get(c, ())]
+    check.check(len(right) == len(cases) and len(caught) == len(cases),
+                "%d MHz: every glitch caught by the right state machine (%d of %d)" % (mhz, len(right), len(cases)))
+
+
+def test_tester_bus(check, programs, lib, mhz):
+    """The tester reading the VIA - data driven a while after phase 2 rises and let go after
+    it falls. Released 10 ns after the fall breaks a 30 ns hold window; held for 60 ns does not;
+    data turning up 40 ns before the fall breaks the 50 ns setup window."""
+    sys_hz = mhz * 1000000
+    ns = lambda n: int(round(n * sys_hz / 1e9))
+    s02, rises, falls = phase2(mhz, 40)
+    results = {}
+    for name, valid_ns, release_ns in (("clean", 200, 60), ("early release", 200, 10), ("late data", (1e9 / VIC_CPU_CLOCK) / 2 - 40, 60)):
+        changes = []
+        for k in range(4, 36):
+            data = (0x40 + k) & 0xFF
+            changes += [(rises[k] + ns(valid_ns), data << DATA_SHIFT | RW), (falls[k] + ns(release_ns), RW)]
+        setup, hold, _, _, _ = monitor(programs, lib, mhz, Signal(RW, changes), 40)
+        results[name] = (len(setup), len(hold))
+    check.check(results["clean"] == (0, 0), "%d MHz: a well timed read is clean %s" % (mhz, results["clean"]))
+    check.check(results["early release"][0] == 0 and results["early release"][1] >= 30,
+                "%d MHz: data let go 10 ns after the fall breaks hold %s" % (mhz, results["early release"]))
+    check.check(results["late data"][0] >= 30 and results["late data"][1] == 0,
+                "%d MHz: data 40 ns before the fall breaks setup %s" % (mhz, results["late data"]))
+
+
+def test_log(check, lib):
+    log = ctypes.create_string_buffer(lib.Glue_LogSize())
+    lib.ViolationLog_Reset(log)
+    check.check(not lib.ViolationLog_GetRecent(log, 0), "an empty log has nothing recent")
+
+    word = lambda before, after: (before << 16) | after
+    check.check(not lib.ViolationLog_Add(log, HOLD, word(0x155, 0x155 ^ IRQ), 5), "only #IRQ moving is not logged")
+    check.check(not lib.ViolationLog_GetRecent(log, 0), "and leaves nothing in the ring")
+
+    for k in range(RING + 5):
+        logged = lib.ViolationLog_Add(log, k & 1, word(0x100 + k, (0x100 + k) ^ (RW if k % 3 else 1 << DATA_SHIFT)), 1000 + k)
+        check.check(logged, "change %d logged" % k) if k < 2 else None
+    newest = lib.ViolationLog_GetRecent(log, 0).contents
+    oldest = lib.ViolationLog_GetRecent(log, RING - 1).contents
+    check.check(newest.seen_us == 1000 + RING + 4 and newest.before == 0x100 + RING + 4 and newest.kind == (RING + 4) & 1,
+                "the newest is the last added (%d, %03X)" % (newest.seen_us, newest.before))
+    check.check(oldest.seen_us == 1005, "the ring keeps the last %d (oldest %d)" % (RING, oldest.seen_us))
+    check.check(not lib.ViolationLog_GetRecent(log, RING), "nothing older than the ring")
+
+    logged, setups, holds, irq_only, stalls = (ctypes.c_uint32 * 5).from_buffer(log, ctypes.sizeof(Violation) * RING)
+    check.check((logged, setups, holds, irq_only, stalls) == (RING + 5, (RING + 6) // 2, (RING + 5) // 2, 1, 0),
+                "totals, per kind and #IRQ only (%d, %d, %d, %d)" % (logged, setups, holds, irq_only))
+
+
+def test_windows(check, lib):
+    """Asking for more than phase 2 is high starts the setup window as early as it can; hold
+    windows go up in turns of 4 clocks and stop at 32 turns."""
+    for mhz in PLANS_MHZ:
+        high = mhz * 1000000 // (2 * VIC_CPU_CLOCK)
+        w = window(lib, mhz, 100000, 100000)
+        check.check(w.setup_delay == 0 and w.setup_clocks == high - 4, "%d MHz: whole high phase (%d)" % (mhz, w.setup_clocks))
+        check.check(w.hold_turns == 32 and w.hold_clocks == 126, "%d MHz: 32 hold turns at most" % mhz)
+        w = window(lib, mhz, 0, 0)
+        check.check(w.setup_clocks == 0 and w.hold_turns == 1, "%d MHz: zero windows (%d, %d)" % (mhz, w.setup_clocks, w.hold_turns))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="PIO bus setup and hold monitor against synthetic waveforms")
+    parser.add_argument("--compiler", default="gcc")
+    parser.add_argument("--seed", type=int, default=6522)
+    args = parser.parse_args()
+
+    programs = load_programs(PROGRAM)
+    check = Checker()
+    rng = random.Random(args.seed)
+
+    with tempfile.TemporaryDirectory() as work:
+        lib = build(work, args.compiler)
+
+        used = test_programs(check, programs)
+        print("PIO2: %d of %d instructions with irq_latency.pio" % (used, PIO2_INSTRUCTIONS))
+        for mhz in PLANS_MHZ:
+            early, late, w = sweep(check, programs, lib, mhz)
+            print("%d MHz: setup %d ns from %d clocks before the fall, hold %d ns to %d after (delay %d, %d turns)"
+                  % (mhz, SETUP_NS, -early, HOLD_NS, late, w.setup_delay, w.hold_turns))
+            test_glitch(check, programs, lib, mhz, rng)
+            test_tester_bus(check, programs, lib, mhz)
+        test_log(check, lib)
+        test_windows(check, lib)
+
+    print("%d checks, %d failed: %s" % (check.checks, check.failures, "PASS" if check.failures == 0 else "FAIL"))
+    return 1 if check.failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
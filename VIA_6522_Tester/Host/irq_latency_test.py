@@ -0,0 +1,444 @@
+#!/usr/bin/env python3
+#------------------------------------------------------------------------------------------------
+#---- IRQ Latency Test ... 2026 Dave Gaunt                                                    ----
+#------------------------------------------------------------------------------------------------
+#---- Runs Source/irq_latency.pio On A Model Of One PIO State Machine Against Simulated Bus   ----
+#---- Timing - Phase 2 From The Fractional Clock Divider, The Tester's Write And #IRQ Falling ----
+#---- At A Known Clock - Then Feeds What It Measures To Source/LatencyStats.c Built With gcc. ----
+#---- The Same Timer Sequence Is Run On VIA_6522's Emulated VIA, Side By Side With The Chip.  ----
+#------------------------------------------------------------------------------------------------
+import argparse
+import bisect
+import ctypes
+import math
+import os
+import random
+import re
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+COMMON = os.path.join(HERE, "..", "..", "Common")
+SOURCE = os.path.join(HERE, "..", "Source")
+VIA_SOURCE = os.path.join(HERE, "..", "..", "VIA_6522", "Source")
+PROGRAM = os.path.join(SOURCE, "irq_latency.pio")
+
+PLANS_MHZ = (150, 200, 250, 300)
+VIC_CPU_CLOCK = 4433618 >> 2    # Phase 2 on the tester, PAL
+SYNC = 2                        # Input synchroniser, in system clocks
+SLACK = 2                       # How far the decoded latency may be from the truth, in system clocks
+LATENCY_LATCH = 0x0040          # LATENCY_LATCH in VIA_6522_Tester.c
+PIN_S02_READ = 3                # Common/PinMap.h, the default layout
+PIN_READ_WRITE = 13
+TIMERS = (("T1", 4), ("T2", 8)) # Name and low register
+
+GLUE_C = r"""
+#include "LatencyStats.h"
+#include "Via6522.h"
+
+unsigned Glue_StatsSize(void)
+{
+	return sizeof(LatencyStats);
+}
+
+void Glue_AddArray(LatencyStats* pStats, const u32* pClocks, const u32 uCount)
+{
+	for (u32 uIndex=0; uIndex<uCount; ++uIndex)
+		LatencyStats_Add(pStats, pClocks[uIndex]);
+}
+
+u32 Glue_ToCycles100(const u32 uClocks100, const u32 uSysHz, const u32 uBusHz)
+{
+	return LatencyStats_ToCycles100(uClocks100, uSysHz, uBusHz);
+}
+
+// The Tester's Sequence On The Emulated VIA - Edge 0 Latches The High Byte Write, Core0 Applies
+// It uLag Edges Later, And Sets #IRQ uLag Edges After Core1's Tick Raises The Flag. 0 = No #IRQ.
+u32 Glue_EmulatedLatency(const u32 uLowRegister, const u32 uLatch, const u32 uLag, const u32 uLimit)
+{
+	ViaRegisters via;
+	Via6522_Reset(&via);
+	Via6522_Write(&via, VIA_REG_INTERRUPT_ENABLE, 0x7F);
+	Via6522_Write(&via, VIA_REG_AUXILIARY_CONTROL, 0x00);
+	Via6522_Write(&via, VIA_REG_INTERRUPT_ENABLE, 0x80 | (1 << VIA_IRQ_TIMER1) | (1 << VIA_IRQ_TIMER2));
+	Via6522_Write(&via, uLowRegister, uLatch & 0xFF);
+	Via6522_UpdateIrq(&via);
+
+	u32 uIrqDue = 0xFFFFFFFF;
+
+	for (u32 uEdge=0; uEdge<=uLimit; ++uEdge)
+	{
+		if (uEdge == uLag)
+		{
+			Via6522_Write(&via, uLowRegister + 1, uLatch >> 8);
+			Via6522_UpdateIrq(&via);
+		}
+		else if ((uEdge > uLag) && Via6522_Tick(&via) && (0xFFFFFFFF == uIrqDue))
+			uIrqDue = uEdge + uLag;
+
+		if ((uEdge >= uIrqDue) && Via6522_UpdateIrq(&via))
+			return uEdge;
+	}
+
+	return 0;
+}
+"""
+
+
+def build(work, compiler):
+    glue = os.path.join(work, "irq_latency_glue.c")
+    with open(glue, "w") as f:
+        f.write(GLUE_C)
+
+    library = os.path.join(work, "irq_latency.so")
+    subprocess.check_call([compiler, "-std=gnu11", "-O2", "-shared", "-fPIC", "-Wall", "-Werror", "-Wno-unused-parameter",
+                           "-I" + COMMON, "-I" + SOURCE, "-I" + VIA_SOURCE,
+                           os.path.join(SOURCE, "LatencyStats.c"), os.path.join(VIA_SOURCE, "Via6522.c"), glue, "-o", library])
+
+    lib = ctypes.CDLL(library)
+    lib.Glue_StatsSize.restype = ctypes.c_uint32
+    lib.Glue_AddArray.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_uint32), ctypes.c_uint32]
+    lib.Glue_ToCycles100.argtypes = [ctypes.c_uint32] * 3
+    lib.Glue_ToCycles100.restype = ctypes.c_uint32
+    lib.Glue_EmulatedLatency.argtypes = [ctypes.c_uint32] * 4
+    lib.Glue_EmulatedLatency.restype = ctypes.c_uint32
+    lib.LatencyStats_Reset.argtypes = [ctypes.c_void_p]
+    lib.LatencyStats_Timeout.argtypes = [ctypes.c_void_p]
+    lib.LatencyStats_GetMeanClocks100.argtypes = [ctypes.c_void_p]
+    lib.LatencyStats_GetMeanClocks100.restype = ctypes.c_uint32
+    lib.LatencyStats_GetJitterClocks100.argtypes = [ctypes.c_void_p]
+    lib.LatencyStats_GetJitterClocks100.restype = ctypes.c_uint32
+    return lib
+
+
+class LatencyStats(ctypes.Structure):
+    _fields_ = [("samples", ctypes.c_uint32), ("timeouts", ctypes.c_uint32), ("min_clocks", ctypes.c_uint32),
+                ("max_clocks", ctypes.c_uint32), ("sum_clocks", ctypes.c_uint64), ("sum_squares", ctypes.c_uint64),
+                ("origin", ctypes.c_uint32)]
+
+
+def load_decoder(path):
+    """IRQ_LATENCY_CLOCKS from IrqLatency.h, as Python."""
+    with open(path) as f:
+        text = f.read()
+    body = re.search(r"#define IRQ_LATENCY_CLOCKS\(w\)\s+(.*)", text).group(1).strip()
+    body = re.sub(r"(0x[0-9A-Fa-f]+)u", r"\1", body)
+    return eval("lambda w: (%s) & 0xFFFFFFFF" % body)
+
+
+def load_program(path):
+    """Just enough of pioasm for irq_latency.pio, .define included."""
+    with open(path) as f:
+        text = f.read().split("% c-sdk")[0]
+    code, labels, defines, wrap_target, wrap = [], {}, {}, 0, None
+    for line in text.splitlines():
+        line = line.split(";")[0].strip()
+        if not line or line.startswith(".program"):
+            continue
+        if line.startswith(".define"):
+            words = line.split()
+            defines[words[-2]] = int(words[-1], 0)
+        elif line == ".wrap_target":
+            wrap_target = len(code)
+        elif line == ".wrap":
+            wrap = len(code) - 1
+        elif line.endswith(":"):
+            labels[line[:-1].replace("public ", "")] = len(code)
+        else:
+            if re.search(r"\[\d+\]$", line):
+                raise ValueError("delays not modelled: %s" % line)
+            op, _, operands = line.partition(" ")
+            operands = [defines.get(o, o) for o in re.split(r"[,\s]+", operands.strip())] if operands else []
+            code.append((op, operands))
+    return code, labels, defines, wrap_target, len(code) - 1 if wrap is None else wrap
+
+
+class Pin:
+    """A pin with a starting level that toggles at each clock in edges."""
+
+    def __init__(self, edges, start=0):
+        self.edges = edges
+        self.start = start
+
+    def level(self, clock):
+        return self.start ^ (bisect.bisect_right(self.edges, clock) & 1)
+
+    def next_change(self, clock):
+        index = bisect.bisect_right(self.edges, clock)
+        return self.edges[index] if index < len(self.edges) else None
+
+
+class StateMachine:
+    """One instruction a clock, every pin seen through the synchroniser. WAIT GPIO reads the
+    named GPIO, WAIT PIN counts from the IN base (R/W), JMP PIN reads #IRQ. The counting loop is skipped through while #IRQ cannot
+    fall under it, so thousands of clocks of latency cost a handful of steps."""
+
+    def __init__(self, program, gpios, irq, in_base=PIN_READ_WRITE):
+        self.code, self.labels, self.defines, self.wrap_target, self.wrap = program
+        self.gpios = gpios
+        self.in_base = in_base
+        self.irq = irq
+        self.pc = self.wrap_target
+        self.x = self.osr = 0
+        self.fifo = []
+        self.clock = 0
+        self.words = []
+
+    def seen(self, pin, clock):
+        return pin.level(clock - SYNC)
+
+    def loop_turns(self):
+        op, operands = self.code[self.pc]
+        if op != "jmp" or operands[0] != "pin" or self.labels[operands[1]] != self.pc - 1:
+            return 0
+        if not self.seen(self.irq, self.clock):
+            return 0
+        change = self.irq.next_change(self.clock - SYNC)
+        if change is None:
+            return 0
+        turns = (change + SYNC - self.clock) // 2 - 1
+        return max(0, min(turns, self.x))
+
+    def step(self, arms):
+        turns = self.loop_turns()
+        if turns:
+            self.x -= turns
+            self.clock += 2 * turns
+            return
+
+        op, operands = self.code[self.pc]
+        next_pc = self.wrap_target if self.pc == self.wrap else self.pc + 1
+
+        if op == "pull":
+            while arms and arms[0] <= self.clock:
+                self.fifo.append(0)
+                arms.pop(0)
+            if not self.fifo:
+                if not arms:
+                    self.clock = None
+                    return
+                self.clock = arms[0]
+                return
+            self.osr = self.fifo.pop(0)
+        elif op == "mov":
+            destination, source = operands
+            setattr(self, destination, {"~null": 0xFFFFFFFF, "null": 0}[source])
+        elif op == "wait":
+            level, source, index = int(operands[0]), operands[1], operands[2]
+            assert source in ("gpio", "pin")
+            pin = self.gpios[int(index) + (self.in_base if source == "pin" else 0)]
+            if self.seen(pin, self.clock) != level:
+                change = pin.next_change(self.clock - SYNC)
+                if change is None:
+                    self.clock = None
+                    return
+                self.clock = change + SYNC
+                return
+        elif op == "jmp":
+            if len(operands) == 1:
+                next_pc = self.labels[operands[0]]
+            elif operands[0] == "x--":
+                if self.x:
+                    next_pc = self.labels[operands[1]]
+                self.x = (self.x - 1) & 0xFFFFFFFF
+            elif operands[0] == "pin":
+                if self.seen(self.irq, self.clock):
+                    next_pc = self.labels[operands[1]]
+            else:
+                raise ValueError("jmp %s not modelled" % operands[0])
+        elif op == "in":
+            assert operands == ["x", "32"]
+            self.words.append(self.x)
+        else:
+            raise ValueError("%s not modelled" % op)
+
+        self.pc = next_pc
+        self.clock += 1
+
+    def run(self, arms, until):
+        arms = list(arms)
+        while self.clock is not None and self.clock < until:
+            self.step(arms)
+        return self.words
+
+
+def bus(mhz, latencies, rng, rw_setup=None):
+    """Phase 2 from clock_gpio_init's fractional divider, with the tester's starting write every
+    few hundred cycles: armed and R/W low in the phase 2 low before it, R/W back high a little
+    after the falling edge that latches it, and #IRQ falling the given clocks after that edge.
+    Returns the pins, the arm clocks and the latching edges."""
+    divider = mhz * 1000000 / VIC_CPU_CLOCK
+    write_cycles = [40 + k * 400 for k in range(len(latencies))]
+    cycles = write_cycles[-1] + 400
+    s02 = []
+    for k in range(cycles):
+        s02 += [int(round(k * divider)), int(round((k + 0.5) * divider))]
+    rw, irq, arms, zeros = [], [], [], []
+    for cycle, latency in zip(write_cycles, latencies):
+        rise, fall = s02[2 * cycle], s02[2 * cycle + 1]
+        previous_fall = s02[2 * cycle - 1]
+        setup = rw_setup if rw_setup is not None else rng.randint(8, int(divider / 2) - 4)
+        arms.append(previous_fall + rng.randint(1, setup - 1) if setup > 1 else previous_fall)
+        rw += [previous_fall + setup, fall + rng.randint(4, 12)]
+        zeros.append(fall)
+        if latency is not None:
+            irq += [fall + latency, fall + latency + int(40 * divider)]
+        assert rise > previous_fall + setup
+    pins = {PIN_S02_READ: Pin(s02), PIN_READ_WRITE: Pin(rw, start=1)}
+    return pins, Pin(irq, start=1), arms, zeros, s02[-1]
+
+
+class Checker:
+    def __init__(self):
+        self.failures = 0
+        self.checks = 0
+
+    def check(self, condition, what):
+        self.checks += 1
+        if not condition:
+            self.failures += 1
+            print("FAIL: %s" % what)
+
+
+def test_program(check, program):
+    code, labels, defines, wrap_target, wrap = program
+    check.check(defines.get("S02_PIN") == PIN_S02_READ, "waits on PIN_S02_READ")
+    check.check("RW_PIN" not in defines and ("wait", ["0", "pin", "0"]) in code,
+                "waits on R/W through the IN base, so it follows the pin map")
+    check.check(code[wrap_target][0] == "pull", "a restart at the wrap target waits for the next arm")
+
+
+def test_words(check, program, decode, mhz, rng):
+    """Every latency decoded against the truth - from the latching edge to #IRQ low."""
+    divider = mhz * 1000000 / VIC_CPU_CLOCK
+    latencies = [int((LATENCY_LATCH + 1.5) * divider) + rng.randint(-300, 300) for _ in range(60)]
+    latencies += [rng.randint(5, 40) for _ in range(10)]
+    pins, irq, arms, zeros, end = bus(mhz, latencies, rng)
+    words = StateMachine(program, pins, irq).run(arms, end)
+
+    check.check(len(words) == len(latencies), "%d MHz: one word per arm (%d of %d)" % (mhz, len(words), len(latencies)))
+    errors = [decode(w) - t for w, t in zip(words, latencies)]
+    check.check(errors and min(errors) >= 0 and max(errors) <= SLACK,
+                "%d MHz: every latency within %d clocks (%s - %s)" % (mhz, SLACK, min(errors), max(errors)))
+    return errors
+
+
+def test_setup(check, program, decode, rng):
+    """R/W going low at any point in the phase 2 low before the write changes nothing."""
+    mhz = 150
+    divider = mhz * 1000000 / VIC_CPU_CLOCK
+    for setup in (2, 10, int(divider / 2) - 4):
+        latencies = [1000 + k for k in range(5)]
+        pins, irq, arms, zeros, end = bus(mhz, latencies, rng, rw_setup=setup)
+        words = StateMachine(program, pins, irq).run(arms, end)
+        errors = [decode(w) - t for w, t in zip(words, latencies)]
+        check.check(len(words) == 5 and min(errors) >= 0 and max(errors) <= SLACK,
+                    "R/W low %d clocks after phase 2 falls: %d words, errors %s" % (setup, len(words), errors))
+
+
+def test_timeout(check, program, decode, rng):
+    """No #IRQ, no word - and the state machine stays in the loop for core1 to restart."""
+    pins, irq, arms, zeros, end = bus(150, [None, None], rng)
+    machine = StateMachine(program, pins, irq)
+    words = machine.run(arms, end)
+    check.check(not words, "no word without #IRQ (%d)" % len(words))
+    check.check(machine.code[machine.pc][0] == "jmp", "left counting, waiting for IrqLatency_Wait's restart")
+
+
+def stats_for(lib, samples, timeouts=0):
+    stats = LatencyStats()
+    lib.LatencyStats_Reset(ctypes.byref(stats))
+    array = (ctypes.c_uint32 * max(1, len(samples)))(*samples)
+    lib.Glue_AddArray(ctypes.byref(stats), array, len(samples))
+    for _ in range(timeouts):
+        lib.LatencyStats_Timeout(ctypes.byref(stats))
+    return stats
+
+
+def test_stats(check, lib, rng):
+    for what, samples in (("one sample", [9000]),
+                          ("constant", [9000] * 500),
+                          ("two values", [9000, 9003] * 300),
+                          ("gaussian", [int(rng.gauss(8860, 6)) for _ in range(20000)]),
+                          ("spread", [rng.randint(5, 60000) for _ in range(5000)])):
+        stats = stats_for(lib, samples, timeouts=3)
+        n = len(samples)
+        mean = sum(samples) / n
+        sigma = math.sqrt(sum((s - mean) ** 2 for s in samples) / n) if n > 1 else 0.0
+        mean100 = lib.LatencyStats_GetMeanClocks100(ctypes.byref(stats))
+        jitter100 = lib.LatencyStats_GetJitterClocks100(ctypes.byref(stats))
+
+        check.check(stats.samples == n and stats.timeouts == 3, "%s: %d samples, 3 timeouts" % (what, stats.samples))
+        check.check(stats.min_clocks == min(samples) and stats.max_clocks == max(samples), "%s: extremes" % what)
+        check.check(abs(mean100 - mean * 100) <= 0.5, "%s: mean %d, wanted %.2f" % (what, mean100, mean * 100))
+        check.check(abs(jitter100 - sigma * 100) <= 1, "%s: jitter %d, wanted %.2f" % (what, jitter100, sigma * 100))
+
+    stats = stats_for(lib, [], timeouts=2)
+    check.check(lib.LatencyStats_GetMeanClocks100(ctypes.byref(stats)) == 0 and lib.LatencyStats_GetJitterClocks100(ctypes.byref(stats)) == 0,
+                "nothing but timeouts reads as zero")
+
+
+def test_chip(check, lib, program, decode, mhz, rng):
+    """A chip with the datasheet's N + 1.5 cycles, measured end to end and shown in cycles."""
+    sys_hz = mhz * 1000000
+    divider = sys_hz / VIC_CPU_CLOCK
+    want = (LATENCY_LATCH + 1.5) * divider
+    latencies = [int(round(want)) + rng.randint(-2, 2) for _ in range(50)]
+    pins, irq, arms, zeros, end = bus(mhz, latencies, rng)
+    words = StateMachine(program, pins, irq).run(arms, end)
+    stats = stats_for(lib, [decode(w) for w in words])
+    mean = lib.Glue_ToCycles100(lib.LatencyStats_GetMeanClocks100(ctypes.byref(stats)), sys_hz, VIC_CPU_CLOCK)
+    low = lib.Glue_ToCycles100(stats.min_clocks * 100, sys_hz, VIC_CPU_CLOCK)
+    high = lib.Glue_ToCycles100(stats.max_clocks * 100, sys_hz, VIC_CPU_CLOCK)
+    wanted = (LATENCY_LATCH + 1.5) * 100
+    check.check(abs(mean - wanted) <= 3, "%d MHz: mean %d.%02d cycles, wanted %.2f" % (mhz, mean // 100, mean % 100, wanted / 100))
+    check.check(low <= mean <= high and high - low <= 6, "%d MHz: min %d max %d" % (mhz, low, high))
+    return mean
+
+
+def test_emulation(check, lib, chip_means):
+    """The tester's sequence on VIA_6522's emulated VIA: each timer against the datasheet."""
+    print("timer  latch  datasheet  chip model  emulated (core0 lag 0, 1, 2, 4)")
+    for name, low_register in TIMERS:
+        for latch in (2, LATENCY_LATCH, 0x1000):
+            emulated = [lib.Glue_EmulatedLatency(low_register, latch, lag, latch + 100) for lag in (0, 1, 2, 4)]
+            if name == "T1":
+                check.check(emulated == [latch + 2 * lag for lag in (0, 1, 2, 4)],
+                            "T1 latch $%04X: emulated at N + 2 x lag, %s" % (latch, emulated))
+            chip = "%d.%02d" % (chip_means[0] // 100, chip_means[0] % 100) if latch == LATENCY_LATCH else "-"
+            shown = ", ".join(str(e) if e else "none" for e in emulated)
+            print("%-6s $%04X  %9.1f  %10s  %s" % (name, latch, latch + 1.5, chip, shown))
+    print("T2 has no timing in the emulation yet, so the tester times out on it against VIA_6522.")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="PIO IRQ latency capture against simulated bus timing")
+    parser.add_argument("--compiler", default="gcc")
+    parser.add_argument("--seed", type=int, default=6522)
+    args = parser.parse_args()
+
+    program = load_program(PROGRAM)
+    decode = load_decoder(os.path.join(SOURCE, "IrqLatency.h"))
+    check = Checker()
+    rng = random.Random(args.seed)
+
+    with tempfile.TemporaryDirectory() as work:
+        lib = build(work, args.compiler)
+
+        test_program(check, program)
+        for mhz in PLANS_MHZ:
+            errors = test_words(check, program, decode, mhz, rng)
+            print("%d MHz: %d latencies decoded, %d - %d clocks late" % (mhz, len(errors), min(errors or [0]), max(errors or [0])))
+        test_setup(check, program, decode, rng)
+        test_timeout(check, program, decode, rng)
+        test_stats(check, lib, rng)
+        chip_means = [test_chip(check, lib, program, decode, mhz, rng) for mhz in PLANS_MHZ]
+        test_emulation(check, lib, chip_means)
+
+    print("%d checks, %d failed: %s" % (check.checks, check.failures, "PASS" if check.failures == 0 else "FAIL"))
+    return 1 if check.failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
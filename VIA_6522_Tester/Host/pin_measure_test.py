@@ -0,0 +1,388 @@
+#!/usr/bin/env python3
+#------------------------------------------------------------------------------------------------
+#---- Pin Measurement Test ... 2026 Dave Gaunt                                                ----
+#------------------------------------------------------------------------------------------------
+#---- Drives Simulated Pins Through Source/pin_measure.pio On A Model Of One PIO State        ----
+#---- Machine, Then Feeds The Words It Pushes To Source/PinStats.c Built With gcc, And Checks ----
+#---- Frequency, Period, Duty Cycle, Pulse Widths, Histograms And Lost Word Detection Against ----
+#---- What The Simulated Pin Really Did - Including PB7 From Timer 1 At Every Clock Plan.     ----
+#------------------------------------------------------------------------------------------------
+import argparse
+import bisect
+import ctypes
+import os
+import random
+import re
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+COMMON = os.path.join(HERE, "..", "..", "Common")
+SOURCE = os.path.join(HERE, "..", "Source")
+PROGRAM = os.path.join(SOURCE, "pin_measure.pio")
+
+PLANS_MHZ = (150, 200, 250, 300)
+VIC_CPU_CLOCK = 4433618 >> 2    # Phase 2 on the tester, PAL
+LOW_START = 0x7FFFFFFF          # PIN_MEASURE_LOW_START, pushed to Y
+BINS = 32                       # PIN_STATS_BINS
+SYNC = 2                        # Input synchroniser, in system clocks
+SLACK = 2                       # One turn of either loop - how far any one edge may be misplaced
+
+GLUE_C = r"""
+#include "PinStats.h"
+
+unsigned PinStats_Size(void)
+{
+	return sizeof(PinStats);
+}
+"""
+
+
+class PinResult(ctypes.Structure):
+    _fields_ = [(name, ctypes.c_uint32) for name in
+                ("periods", "frequency_mhz", "period_ns", "duty", "min_period", "max_period", "min_high", "max_high",
+                 "min_low", "max_low", "lost", "bin_base", "bin_clocks")] + \
+               [("high_histogram", ctypes.c_uint32 * BINS), ("low_histogram", ctypes.c_uint32 * BINS)]
+
+
+def build(work, compiler):
+    glue = os.path.join(work, "pin_stats_glue.c")
+    with open(glue, "w") as f:
+        f.write(GLUE_C)
+
+    library = os.path.join(work, "pin_stats.so")
+    subprocess.check_call([compiler, "-std=gnu11", "-O2", "-shared", "-fPIC", "-Wall", "-Werror", "-I" + COMMON, "-I" + SOURCE,
+                           os.path.join(SOURCE, "PinStats.c"), glue, "-o", library])
+
+    lib = ctypes.CDLL(library)
+    lib.PinStats_Size.restype = ctypes.c_uint32
+    lib.PinStats_Reset.argtypes = [ctypes.c_void_p, ctypes.c_uint32]
+    lib.PinStats_Add.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_uint32), ctypes.c_uint32]
+    lib.PinStats_Gate.argtypes = [ctypes.c_void_p, ctypes.POINTER(PinResult)]
+    return lib
+
+
+def load_decoders(path):
+    """PIN_STATS_HIGH_CLOCKS and PIN_STATS_LOW_CLOCKS from PinStats.h, as Python."""
+    with open(path) as f:
+        text = f.read()
+    decoders = {}
+    for level in ("HIGH", "LOW"):
+        body = re.search(r"#define PIN_STATS_%s_CLOCKS\(w\)\s+(.*)" % level, text).group(1).strip()
+        body = re.sub(r"(0x[0-9A-Fa-f]+)u", r"\1", body)
+        decoders[level] = eval("lambda w: (%s) & 0xFFFFFFFF" % body)
+    return decoders["HIGH"], decoders["LOW"]
+
+
+def load_program(path):
+    """Just enough of pioasm for pin_measure.pio."""
+    with open(path) as f:
+        text = f.read().split("% c-sdk")[0]
+    code, labels, wrap_target, wrap = [], {}, 0, None
+    for line in text.splitlines():
+        line = line.split(";")[0].strip()
+        if not line or line.startswith(".program"):
+            continue
+        if line == ".wrap_target":
+            wrap_target = len(code)
+        elif line == ".wrap":
+            wrap = len(code) - 1
+        elif line.endswith(":"):
+            labels[line[:-1].replace("public ", "")] = len(code)
+        else:
+            if re.search(r"\[\d+\]$", line):
+                raise ValueError("delays not modelled: %s" % line)
+            op, _, operands = line.partition(" ")
+            code.append((op, re.split(r"[,\s]+", operands.strip()) if operands else []))
+    return code, labels, wrap_target, len(code) - 1 if wrap is None else wrap
+
+
+class Pin:
+    """A pin that starts low and toggles at each clock in edges."""
+
+    def __init__(self, edges):
+        self.edges = edges
+
+    def level(self, clock):
+        return bisect.bisect_right(self.edges, clock) & 1
+
+    def next_change(self, clock):
+        index = bisect.bisect_right(self.edges, clock)
+        return self.edges[index] if index < len(self.edges) else None
+
+
+class StateMachine:
+    """One instruction a clock, IN and JMP PIN both the measured pin seen through the
+    synchroniser. The two-instruction counting loops are skipped through in one go while the
+    pin cannot change under them, so a 30 ms period costs no more than a 3 us one."""
+
+    def __init__(self, program, pin):
+        self.code, self.labels, self.wrap_target, self.wrap = program
+        self.pin = pin
+        self.pc = 0
+        self.x = self.y = self.osr = 0
+        self.fifo = [LOW_START]
+        self.clock = 0
+        self.words = []
+
+    def seen(self, clock):
+        return self.pin.level(clock - SYNC)
+
+    def loop_turns(self):
+        """Whole turns of a counting loop that can be taken without reading an edge."""
+        op, operands = self.code[self.pc]
+        if self.pc + 1 >= len(self.code) or op != "jmp":
+            return 0
+        next_op, next_operands = self.code[self.pc + 1]
+        if next_op != "jmp":
+            return 0
+        if operands[0] == "x--" and self.labels[operands[1]] == self.pc + 1 and next_operands == ["pin", self.code_label(self.pc)]:
+            first_read, stays = self.clock + 1, 1
+        elif operands[0] == "pin" and next_operands == ["x--", self.code_label(self.pc)]:
+            first_read, stays = self.clock, 0
+        else:
+            return 0
+        if self.seen(first_read) != stays:
+            return 0
+        change = self.pin.next_change(first_read - SYNC)
+        if change is None:
+            return 0
+        turns = (change + SYNC - first_read) // 2 - 1
+        return max(0, min(turns, self.x))
+
+    def code_label(self, pc):
+        for name, address in self.labels.items():
+            if address == pc:
+                return name
+        return None
+
+    def step(self):
+        turns = self.loop_turns()
+        if turns:
+            self.x -= turns
+            self.clock += 2 * turns
+            return
+
+        op, operands = self.code[self.pc]
+        next_pc = self.wrap_target if self.pc == self.wrap else self.pc + 1
+
+        if op == "pull":
+            self.osr = self.fifo.pop(0)
+        elif op == "mov":
+            destination, source = operands
+            value = {"~null": 0xFFFFFFFF, "null": 0}.get(source)
+            if value is None:
+                value = getattr(self, source)
+            setattr(self, destination, value)
+        elif op == "wait":
+            level, source, index = int(operands[0]), operands[1], int(operands[2])
+            assert (source, index) == ("pin", 0)
+            if self.seen(self.clock) != level:
+                change = self.pin.next_change(self.clock - SYNC)
+                if change is None:
+                    self.clock = None
+                    return
+                self.clock = change + SYNC
+                return
+        elif op == "jmp":
+            if len(operands) == 1:
+                next_pc = self.labels[operands[0]]
+            elif operands[0] == "x--":
+                if self.x:
+                    next_pc = self.labels[operands[1]]
+                self.x = (self.x - 1) & 0xFFFFFFFF
+            elif operands[0] == "pin":
+                if self.seen(self.clock):
+                    next_pc = self.labels[operands[1]]
+            else:
+                raise ValueError("jmp %s not modelled" % operands[0])
+        elif op == "in":
+            assert operands == ["x", "32"]
+            self.words.append(self.x)
+        else:
+            raise ValueError("%s not modelled" % op)
+
+        self.pc = next_pc
+        self.clock += 1
+
+    def run(self, until):
+        while self.clock is not None and self.clock < until:
+            self.step()
+        return self.words
+
+
+def waveform(pieces, start=100):
+    """Edge clocks for [(high clocks, low clocks), ...], rising first at start."""
+    edges, clock = [], start
+    for high, low in pieces:
+        edges += [clock, clock + high]
+        clock += high + low
+    return edges, clock
+
+
+def measure(lib, program, edges, until, sys_hz, gates=1, drop=None):
+    words = StateMachine(program, Pin(edges)).run(until)
+    if drop is not None:
+        words = words[:drop] + words[drop + 1:]
+    stats = ctypes.create_string_buffer(lib.PinStats_Size())
+    lib.PinStats_Reset(stats, sys_hz)
+    results = []
+    chunks = [words[i * len(words) // gates:(i + 1) * len(words) // gates] for i in range(gates)]
+    for chunk in chunks:
+        array = (ctypes.c_uint32 * max(1, len(chunk)))(*chunk)
+        lib.PinStats_Add(stats, array, len(chunk))
+        result = PinResult()
+        lib.PinStats_Gate(stats, ctypes.byref(result))
+        results.append(result)
+    return words, results
+
+
+class Checker:
+    def __init__(self):
+        self.failures = 0
+        self.checks = 0
+
+    def check(self, condition, what):
+        self.checks += 1
+        if not condition:
+            self.failures += 1
+            print("FAIL: %s" % what)
+
+
+def test_words(check, program, decoders, rng):
+    """Every word against the pulse it timed - each within a loop turn, and no drift."""
+    decode_high, decode_low = decoders
+    pieces = [(rng.randint(6, 400), rng.randint(6, 400)) for _ in range(300)]
+    edges, end = waveform(pieces)
+    words = StateMachine(program, Pin(edges)).run(end + 1000)
+
+    check.check(len(words) == 2 * len(pieces) - 1, "one word per level, %d words for %d pulses" % (len(words), len(pieces)))
+    check.check(all(w & 0x80000000 for w in words[0::2]) and not any(w & 0x80000000 for w in words[1::2]),
+                "bit 31 marks the highs")
+
+    # Word 0 is the first high, timed from the WAIT - PinStats throws it away, so skip it here too.
+    truth = [level for high, low in pieces for level in (high, low)][1:len(words)]
+    measured = [(decode_high if w & 0x80000000 else decode_low)(w) for w in words[1:]]
+    worst = max(abs(m - t) for m, t in zip(measured, truth))
+    check.check(worst <= SLACK, "every pulse within %d clocks (worst %d)" % (SLACK, worst))
+    drift, running = 0, 0
+    for m, t in zip(measured, truth):
+        running += m - t
+        drift = max(drift, abs(running))
+    check.check(drift <= SLACK, "no drift from pulse to pulse (worst %d)" % drift)
+    print("words: %d pulses each within %d clocks, running total within %d" % (len(measured), worst, drift))
+
+
+def test_timer1(check, lib, program, mhz, latch):
+    """PB7 from a free running timer 1 - 2 x (N + 2) phase 2 cycles, edges on the phase 2 clock,
+    which clock_gpio_init makes with a fractional divider."""
+    sys_hz = mhz * 1000000
+    divider = sys_hz / VIC_CPU_CLOCK
+    half = (latch + 2) * divider
+    periods = max(20, int(2000000 / (2 * half)))
+    edges = [100 + int(round(k * half)) for k in range(2 * periods + 1)]        # Rising at the end, so the last low is pushed
+    _, (result,) = measure(lib, program, edges, edges[-1] + 100, sys_hz)
+
+    want_mhz = VIC_CPU_CLOCK * 1000.0 / (2 * (latch + 2))
+    error = abs(result.frequency_mhz - want_mhz) / want_mhz
+    what = "%d MHz T1 latch $%04X" % (mhz, latch)
+    check.check(result.periods == periods - 1, "%s: %d periods, wanted %d" % (what, result.periods, periods - 1))
+    check.check(error < 0.0001, "%s: %.3f Hz, wanted %.3f" % (what, result.frequency_mhz / 1000.0, want_mhz / 1000.0))
+    check.check(abs(result.duty - 5000) <= 2, "%s: duty %d.%02d%%" % (what, result.duty // 100, result.duty % 100))
+    check.check(result.min_high >= int(half) - SLACK and result.max_high <= int(half) + 1 + SLACK,
+                "%s: highs %d - %d clocks, wanted %.1f" % (what, result.min_high, result.max_high, half))
+    check.check(result.lost == 0, "%s: nothing lost" % what)
+    period_ns = 2 * half * 1e9 / sys_hz
+    check.check(abs(result.period_ns - period_ns) <= 2, "%s: period %d ns, wanted %.1f" % (what, result.period_ns, period_ns))
+    return result
+
+
+def test_duty(check, lib, program):
+    sys_hz = 150000000
+    for duty in (10, 25, 50, 75, 90):
+        pieces = [(duty * 20, (100 - duty) * 20)] * 200
+        edges, end = waveform(pieces)
+        _, (result,) = measure(lib, program, edges, end + 100, sys_hz)
+        check.check(abs(result.duty - duty * 100) <= 2, "duty %d%%: measured %d.%02d%%" % (duty, result.duty // 100, result.duty % 100))
+        check.check(result.frequency_mhz == 75000000, "duty %d%%: 75 kHz, measured %d mHz" % (duty, result.frequency_mhz))
+
+
+def test_histogram(check, lib, program):
+    """Highs of 300 and 700 clocks taking turns - the first gate sets the range, the second
+    puts every pulse in a bin, the highs in two clusters and the lows in one."""
+    sys_hz = 150000000
+    pieces = [(300 if k & 1 else 700, 500) for k in range(400)]
+    edges, end = waveform(pieces)
+    words, (first, second) = measure(lib, program, edges, end + 100, sys_hz, gates=2)
+
+    check.check(first.bin_clocks == 0, "no histogram before the range is known")
+    check.check(second.bin_base <= 300 and second.bin_base >= 300 - SLACK, "range starts at the shortest pulse (%d)" % second.bin_base)
+    check.check(second.bin_base + second.bin_clocks * BINS > 700, "range covers the longest pulse")
+
+    highs_in_second = sum(1 for w in words[len(words) // 2:] if w & 0x80000000)
+    check.check(sum(second.high_histogram) == highs_in_second, "every high counted once (%d of %d)" % (sum(second.high_histogram), highs_in_second))
+    check.check(sum(second.low_histogram) == len(words) - len(words) // 2 - highs_in_second, "every low counted once")
+
+    def bin_of(clocks):
+        return min(BINS - 1, (clocks - second.bin_base) // second.bin_clocks)
+
+    used_high = [b for b in range(BINS) if second.high_histogram[b]]
+    used_low = [b for b in range(BINS) if second.low_histogram[b]]
+    near = lambda bins, clocks: all(abs(b - bin_of(clocks)) <= 1 for b in bins)
+    check.check(near([b for b in used_high if b < BINS // 2], 300) and near([b for b in used_high if b >= BINS // 2], 700),
+                "highs in two clusters, at 300 and 700 clocks (bins %s)" % used_high)
+    check.check(near(used_low, 500), "lows in one cluster at 500 clocks (bins %s)" % used_low)
+
+
+def test_lost(check, lib, program):
+    sys_hz = 150000000
+    pieces = [(400, 600)] * 100
+    edges, end = waveform(pieces)
+    _, (whole,) = measure(lib, program, edges, end + 100, sys_hz)
+    _, (gap,) = measure(lib, program, edges, end + 100, sys_hz, drop=101)
+    check.check(whole.lost == 0 and gap.lost == 1, "a missing word is counted (%d, %d)" % (whole.lost, gap.lost))
+    check.check(gap.periods == whole.periods - 1, "and the period across the gap is not (%d, %d)" % (gap.periods, whole.periods))
+    check.check(gap.min_period >= 1000 - SLACK and gap.max_period <= 1000 + SLACK, "no false period made across the gap")
+
+
+def test_stuck(check, lib, program):
+    sys_hz = 150000000
+    for edges, what in (([], "stuck low"), ([100], "stuck high"), ([100, 500], "one pulse")):
+        words, (result,) = measure(lib, program, edges, 100000, sys_hz)
+        check.check(result.periods == 0 and result.frequency_mhz == 0 and result.min_period == 0,
+                    "%s: no periods from %d words" % (what, len(words)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="PIO pin measurement against simulated pins")
+    parser.add_argument("--compiler", default="gcc")
+    parser.add_argument("--seed", type=int, default=6522)
+    args = parser.parse_args()
+
+    program = load_program(PROGRAM)
+    decoders = load_decoders(os.path.join(SOURCE, "PinStats.h"))
+    check = Checker()
+    rng = random.Random(args.seed)
+
+    with tempfile.TemporaryDirectory() as work:
+        lib = build(work, args.compiler)
+
+        test_words(check, program, decoders, rng)
+        for mhz in PLANS_MHZ:
+            for latch in (0, 2, 0x0100, 0x4289):
+                result = test_timer1(check, lib, program, mhz, latch)
+                if latch == 0x0100:
+                    print("%d MHz PB7 T1 $%04X: %d.%03d Hz, %d ns, duty %d.%02d%%" % (mhz, latch, result.frequency_mhz // 1000,
+                          result.frequency_mhz % 1000, result.period_ns, result.duty // 100, result.duty % 100))
+        test_duty(check, lib, program)
+        test_histogram(check, lib, program)
+        test_lost(check, lib, program)
+        test_stuck(check, lib, program)
+
+    print("%d checks, %d failed: %s" % (check.checks, check.failures, "PASS" if check.failures == 0 else "FAIL"))
+    return 1 if check.failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,70 @@
+//------------------------------------------------------------------------------------------------
+//---- Bus Monitor ... 2026 Dave Gaunt                                                        ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include "BusMonitor.h"
+
+#include "pico/stdlib.h"
+
+#include "hardware/pio.h"
+#include "hardware/clocks.h"
+
+#include "bus_monitor.pio.h"
+
+static u32 s_aSm[VIOLATION_KINDS];
+static BusWindow s_window;
+
+//------------------------------------------------------------------------------------------------
+//---- The Bus Pins Are Only Read, So They Stay With Whatever Already Drives Them.            ----
+//------------------------------------------------------------------------------------------------
+void BusMonitor_Init(const u32 uBusPin, const u32 uS02Pin, const u32 uBusHz, const u32 uSetupNs, const u32 uHoldNs)
+{
+	BusViolations_GetWindow(&s_window, clock_get_hz(clk_sys), uBusHz, uSetupNs, uHoldNs);
+
+	const u32 uSetupOffset = pio_add_program(BUS_MONITOR_PIO, &bus_setup_program);
+	const u32 uHoldOffset = pio_add_program(BUS_MONITOR_PIO, &bus_hold_program);
+	s_aSm[VIOLATION_SETUP] = (u32)pio_claim_unused_sm(BUS_MONITOR_PIO, true);
+	s_aSm[VIOLATION_HOLD] = (u32)pio_claim_unused_sm(BUS_MONITOR_PIO, true);
+
+	bus_setup_program_init(BUS_MONITOR_PIO, s_aSm[VIOLATION_SETUP], uSetupOffset, uBusPin, uS02Pin);
+	bus_hold_program_init(BUS_MONITOR_PIO, s_aSm[VIOLATION_HOLD], uHoldOffset, uBusPin, uS02Pin, s_window.m_uHoldTurns);
+
+	// bus_setup Pulls Its Delay Once, Before Its First Cycle.
+	pio_sm_put(BUS_MONITOR_PIO, s_aSm[VIOLATION_SETUP], s_window.m_uSetupDelay);
+
+	pio_set_sm_mask_enabled(BUS_MONITOR_PIO, (1u << s_aSm[VIOLATION_SETUP]) | (1u << s_aSm[VIOLATION_HOLD]), true);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Each Violation Is Marked As Seen When Core0 Got Here - Up To A Whole Main Loop After   ----
+//---- The Bus Cycle, Which The Word From The PIO Has No Room To Say. A Full FIFO Holds Its   ----
+//---- State Machine At The Push, Which Shows As A Stall.                                     ----
+//------------------------------------------------------------------------------------------------
+void BusMonitor_Poll(ViolationLog* pLog)
+{
+	const u32 uSeenUs = time_us_32();
+
+	for (u32 uKind=0; uKind<VIOLATION_KINDS; ++uKind)
+	{
+		const u32 uSm = s_aSm[uKind];
+		const u32 uStall = 1u << (PIO_FDEBUG_RXSTALL_LSB + uSm);
+
+		if (BUS_MONITOR_PIO->fdebug & uStall)
+		{
+			BUS_MONITOR_PIO->fdebug = uStall;
+			++pLog->m_uStalls;
+		}
+
+		while (!pio_sm_is_rx_fifo_empty(BUS_MONITOR_PIO, uSm))
+			ViolationLog_Add(pLog, uKind, pio_sm_get(BUS_MONITOR_PIO, uSm), uSeenUs);
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+const BusWindow* BusMonitor_GetWindow(void)
+{
+	return &s_window;
+}
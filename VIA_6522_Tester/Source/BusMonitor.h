@@ -0,0 +1,20 @@
+//------------------------------------------------------------------------------------------------
+//---- Bus Monitor ... 2026 Dave Gaunt                                                        ----
+//------------------------------------------------------------------------------------------------
+//---- Two PIO2 State Machines Watch R/W, #IRQ And D0-D7 Either Side Of Each Phase 2 Fall,    ----
+//---- Pushing A Word Only When Something Changes Inside The Setup Or Hold Window. Core0      ----
+//---- Empties Them Into A ViolationLog With BusMonitor_Poll. See bus_monitor.pio.            ----
+//------------------------------------------------------------------------------------------------
+#ifndef __BusMonitor_h_included
+#define __BusMonitor_h_included
+
+#include "types.h"
+#include "BusViolations.h"
+
+#define BUS_MONITOR_PIO				(pio2)			/* PIO0 Has The VGA, PIO1 The Pin Instruments At GPIO Base 16 */
+
+void BusMonitor_Init(const u32 uBusPin, const u32 uS02Pin, const u32 uBusHz, const u32 uSetupNs, const u32 uHoldNs);
+void BusMonitor_Poll(ViolationLog* pLog);
+const BusWindow* BusMonitor_GetWindow(void);
+
+#endif /* __BusMonitor_h_included */
@@ -0,0 +1,87 @@
+//------------------------------------------------------------------------------------------------
+//---- Bus Violations ... 2026 Dave Gaunt                                                     ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include "BusViolations.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------------------------
+//---- Both Windows Are Rounded Out To Whole Clocks, Then Out Again To What The Programs Can  ----
+//---- Do - bus_setup Starts Its Window After A Delay From The Rise, Assuming Phase 2 Is High ----
+//---- For Half The Cycle; bus_hold Can Only Look In Turns Of 4 Clocks.                       ----
+//------------------------------------------------------------------------------------------------
+void BusViolations_GetWindow(BusWindow* pWindow, const u32 uSysHz, const u32 uBusHz, const u32 uSetupNs, const u32 uHoldNs)
+{
+	const u32 uHighClocks = uSysHz / (2 * uBusHz);
+	const u32 uSetupClocks = (u32)((((uint64_t)uSetupNs * uSysHz) + 999999999) / 1000000000);
+	const u32 uHoldClocks = (u32)((((uint64_t)uHoldNs * uSysHz) + 999999999) / 1000000000);
+
+	// As Early As The Program Can Start If The Whole High Phase Is Asked For.
+	pWindow->m_uSetupDelay = 0;
+	if (uHighClocks > (BUS_SETUP_LEAD_CLOCKS + uSetupClocks))
+		pWindow->m_uSetupDelay = uHighClocks - BUS_SETUP_LEAD_CLOCKS - uSetupClocks;
+
+	pWindow->m_uSetupClocks = uHighClocks - BUS_SETUP_LEAD_CLOCKS - pWindow->m_uSetupDelay;
+
+	u32 uTurns = (uHoldClocks + BUS_HOLD_SHORT_CLOCKS + BUS_HOLD_TURN_CLOCKS - 1) / BUS_HOLD_TURN_CLOCKS;
+	if (uTurns < 1)
+		uTurns = 1;
+	if (uTurns > BUS_HOLD_MAX_TURNS)
+		uTurns = BUS_HOLD_MAX_TURNS;
+
+	pWindow->m_uHoldTurns = uTurns;
+	pWindow->m_uHoldClocks = (uTurns * BUS_HOLD_TURN_CLOCKS) - BUS_HOLD_SHORT_CLOCKS;
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void ViolationLog_Reset(ViolationLog* pLog)
+{
+	pLog->m_uLogged = 0;
+	pLog->m_uIrqOnly = 0;
+	pLog->m_uStalls = 0;
+
+	for (u32 uKind=0; uKind<VIOLATION_KINDS; ++uKind)
+		pLog->m_aCount[uKind] = 0;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- One Word From Either State Machine - False If Only #IRQ Moved, Which Is Counted But    ----
+//---- Not Logged: It Falls With Phase 2 When A Timer Fires, And Is Not Data.                 ----
+//------------------------------------------------------------------------------------------------
+bool ViolationLog_Add(ViolationLog* pLog, const u32 uKind, const u32 uWord, const u32 uSeenUs)
+{
+	const u32 uBefore = BUS_SAMPLE_BEFORE(uWord);
+	const u32 uAfter = BUS_SAMPLE_AFTER(uWord);
+
+	if (0 == ((uBefore ^ uAfter) & ~BUS_SAMPLE_IRQ))
+	{
+		++pLog->m_uIrqOnly;
+		return false;
+	}
+
+	Violation* pViolation = &pLog->m_aRing[pLog->m_uLogged & (VIOLATION_RING_SIZE - 1)];
+	pViolation->m_uSeenUs = uSeenUs;
+	pViolation->m_uBefore = (u16)uBefore;
+	pViolation->m_uAfter = (u16)uAfter;
+	pViolation->m_uKind = uKind;
+
+	++pLog->m_uLogged;
+	++pLog->m_aCount[uKind];
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- 0 Is The Newest - NULL Once uAge Goes Past What The Ring Still Holds.                  ----
+//------------------------------------------------------------------------------------------------
+const Violation* ViolationLog_GetRecent(const ViolationLog* pLog, const u32 uAge)
+{
+	if ((uAge >= pLog->m_uLogged) || (uAge >= VIOLATION_RING_SIZE))
+		return NULL;
+
+	return &pLog->m_aRing[(pLog->m_uLogged - 1 - uAge) & (VIOLATION_RING_SIZE - 1)];
+}
@@ -0,0 +1,66 @@
+//------------------------------------------------------------------------------------------------
+//---- Bus Violations ... 2026 Dave Gaunt                                                     ----
+//------------------------------------------------------------------------------------------------
+//---- The Setup And Hold Windows For bus_monitor.pio In System Clocks, And A Ring Of What It ----
+//---- Catches Changing Inside Them, Each With When Core0 Saw It. Plain C -                   ----
+//---- Host/bus_monitor_test.py Builds It.                                                    ----
+//------------------------------------------------------------------------------------------------
+#ifndef __BusViolations_h_included
+#define __BusViolations_h_included
+
+#include "types.h"
+
+// One Bus Sample As bus_monitor.pio Reads It - IN_BASE Is R/W, Then #IRQ, Then D0-D7.
+#define BUS_SAMPLE_RW				(1 << 0)
+#define BUS_SAMPLE_IRQ				(1 << 1)
+#define BUS_SAMPLE_DATA_SHIFT		(2)
+#define BUS_SAMPLE_BEFORE(w)		(((w) >> 16) & 0x3FF)
+#define BUS_SAMPLE_AFTER(w)			((w) & 0x3FF)
+
+// Must Match bus_monitor.pio.
+#define BUS_SETUP_LEAD_CLOCKS		(4)			/* Phase 2 Rising To The First Clock bus_setup Can See */
+#define BUS_HOLD_TURN_CLOCKS		(4)
+#define BUS_HOLD_SHORT_CLOCKS		(2)			/* The Reference Lags, So The Last Turn Sees This Far Short */
+#define BUS_HOLD_MAX_TURNS			(32)
+
+#define VIOLATION_RING_SIZE			(32)		/* Must Be A Power Of 2! */
+
+typedef enum
+{
+	VIOLATION_SETUP = 0,
+	VIOLATION_HOLD,
+	VIOLATION_KINDS
+} ViolationKind;
+
+typedef struct
+{
+	u32		m_uSetupDelay;				/* For bus_setup's OSR - Clocks After The Rise Before The Window */
+	u32		m_uHoldTurns;				/* For bus_hold's OUT Threshold */
+	u32		m_uSetupClocks;				/* What The Windows Really Cover */
+	u32		m_uHoldClocks;
+} BusWindow;
+
+typedef struct
+{
+	u32		m_uSeenUs;					/* When Core0 Emptied The FIFO - Not When The Bus Cycle Was */
+	u16		m_uBefore;
+	u16		m_uAfter;
+	u32		m_uKind;
+} Violation;
+
+typedef struct
+{
+	Violation	m_aRing[VIOLATION_RING_SIZE];
+	u32			m_uLogged;						/* Total - The Newest Is At (m_uLogged - 1) */
+	u32			m_aCount[VIOLATION_KINDS];
+	u32			m_uIrqOnly;						/* Only #IRQ Moved - Not Logged, But That Cycle Went Unchecked */
+	u32			m_uStalls;						/* Times The RX FIFO Filled And Cycles Went Unwatched */
+} ViolationLog;
+
+void BusViolations_GetWindow(BusWindow* pWindow, const u32 uSysHz, const u32 uBusHz, const u32 uSetupNs, const u32 uHoldNs);
+
+void ViolationLog_Reset(ViolationLog* pLog);
+bool ViolationLog_Add(ViolationLog* pLog, const u32 uKind, const u32 uWord, const u32 uSeenUs);
+const Violation* ViolationLog_GetRecent(const ViolationLog* pLog, const u32 uAge);
+
+#endif /* __BusViolations_h_included */
@@ -0,0 +1,59 @@
+//------------------------------------------------------------------------------------------------
+//---- IRQ Latency ... 2026 Dave Gaunt                                                        ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include "IrqLatency.h"
+
+#include "pico/stdlib.h"
+
+#include "hardware/pio.h"
+
+#include "irq_latency.pio.h"
+
+static u32 s_uSm = 0;
+static u32 s_uOffset = 0;
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void IrqLatency_Init(const u32 uIrqPin, const u32 uReadWritePin)
+{
+	s_uOffset = pio_add_program(IRQ_LATENCY_PIO, &irq_latency_program);
+	s_uSm = (u32)pio_claim_unused_sm(IRQ_LATENCY_PIO, true);
+
+	irq_latency_program_init(IRQ_LATENCY_PIO, s_uSm, s_uOffset, uIrqPin, uReadWritePin);
+	pio_sm_set_enabled(IRQ_LATENCY_PIO, s_uSm, true);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Called Between The Write Of The Low Byte And The Write That Starts The Timer.          ----
+//------------------------------------------------------------------------------------------------
+void __not_in_flash_func(IrqLatency_Arm)(void)
+{
+	pio_sm_put(IRQ_LATENCY_PIO, s_uSm, 0);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- False If #IRQ Never Came - The State Machine Is Put Back To Waiting For Its Next Arm.  ----
+//------------------------------------------------------------------------------------------------
+bool __not_in_flash_func(IrqLatency_Wait)(u32* puClocks, const u32 uTimeoutUs)
+{
+	const u32 uStart = time_us_32();
+
+	while (pio_sm_is_rx_fifo_empty(IRQ_LATENCY_PIO, s_uSm))
+	{
+		if ((time_us_32() - uStart) > uTimeoutUs)
+		{
+			pio_sm_set_enabled(IRQ_LATENCY_PIO, s_uSm, false);
+			pio_sm_clear_fifos(IRQ_LATENCY_PIO, s_uSm);
+			pio_sm_restart(IRQ_LATENCY_PIO, s_uSm);
+			pio_sm_exec(IRQ_LATENCY_PIO, s_uSm, pio_encode_jmp(s_uOffset + irq_latency_wrap_target));
+			pio_sm_set_enabled(IRQ_LATENCY_PIO, s_uSm, true);
+			return false;
+		}
+	}
+
+	*puClocks = IRQ_LATENCY_CLOCKS(pio_sm_get(IRQ_LATENCY_PIO, s_uSm));
+	return true;
+}
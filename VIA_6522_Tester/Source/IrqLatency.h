@@ -0,0 +1,21 @@
+//------------------------------------------------------------------------------------------------
+//---- IRQ Latency ... 2026 Dave Gaunt                                                        ----
+//------------------------------------------------------------------------------------------------
+//---- A PIO2 State Machine Times #IRQ Against The Phase 2 Edge That Started A Timer - Core1  ----
+//---- Arms It, Makes The Write, Then Waits For The Word. See irq_latency.pio.                ----
+//------------------------------------------------------------------------------------------------
+#ifndef __IrqLatency_h_included
+#define __IrqLatency_h_included
+
+#include "types.h"
+
+#define IRQ_LATENCY_PIO				(pio2)			/* PIO0 Has The VGA, PIO1 The Pin Instruments At GPIO Base 16 */
+
+// Loop Turns To Clocks From The Latching Phase 2 Edge - Must Match irq_latency.pio.
+#define IRQ_LATENCY_CLOCKS(w)		(((0xFFFFFFFFu - (w)) << 1) + 3)
+
+void IrqLatency_Init(const u32 uIrqPin, const u32 uReadWritePin);
+void IrqLatency_Arm(void);
+bool IrqLatency_Wait(u32* puClocks, const u32 uTimeoutUs);
+
+#endif /* __IrqLatency_h_included */
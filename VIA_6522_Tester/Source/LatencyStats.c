@@ -0,0 +1,91 @@
+//------------------------------------------------------------------------------------------------
+//---- Latency Statistics ... 2026 Dave Gaunt                                                 ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include "LatencyStats.h"
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void LatencyStats_Reset(LatencyStats* pStats)
+{
+	pStats->m_uSamples = 0;
+	pStats->m_uTimeouts = 0;
+	pStats->m_uMinClocks = 0xFFFFFFFF;
+	pStats->m_uMaxClocks = 0;
+	pStats->m_uSumClocks = 0;
+	pStats->m_uSumSquares = 0;
+	pStats->m_uOrigin = 0;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Squares Are Taken About The First Sample, Not Zero - Latencies Sit Within A Few Dozen  ----
+//---- Clocks Of Each Other, So Millions Of Them Still Fit In 64 Bits.                        ----
+//------------------------------------------------------------------------------------------------
+void LatencyStats_Add(LatencyStats* pStats, const u32 uClocks)
+{
+	if (0 == pStats->m_uSamples)
+		pStats->m_uOrigin = uClocks;
+
+	const int64_t iOffset = (int64_t)uClocks - pStats->m_uOrigin;
+
+	++pStats->m_uSamples;
+	pStats->m_uSumClocks += uClocks;
+	pStats->m_uSumSquares += (uint64_t)(iOffset * iOffset);
+
+	if (uClocks < pStats->m_uMinClocks)
+		pStats->m_uMinClocks = uClocks;
+	if (uClocks > pStats->m_uMaxClocks)
+		pStats->m_uMaxClocks = uClocks;
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void LatencyStats_Timeout(LatencyStats* pStats)
+{
+	++pStats->m_uTimeouts;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Rounded To The Nearest Hundredth.                                                      ----
+//------------------------------------------------------------------------------------------------
+u32 LatencyStats_GetMeanClocks100(const LatencyStats* pStats)
+{
+	if (0 == pStats->m_uSamples)
+		return 0;
+
+	return (u32)(((pStats->m_uSumClocks * 100) + (pStats->m_uSamples / 2)) / pStats->m_uSamples);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Population Standard Deviation - Square Root By Bisection, No Floats.                   ----
+//------------------------------------------------------------------------------------------------
+u32 LatencyStats_GetJitterClocks100(const LatencyStats* pStats)
+{
+	const uint64_t uSamples = pStats->m_uSamples;
+
+	if (uSamples < 2)
+		return 0;
+
+	// Variance x 10000 = (Sum Of Squares - Sum^2 / n) x 10000 / n, All About The Origin.
+	const int64_t iSum = (int64_t)pStats->m_uSumClocks - (int64_t)(pStats->m_uOrigin * uSamples);
+	const uint64_t uSquares = pStats->m_uSumSquares - (uint64_t)((iSum * iSum) / (int64_t)uSamples);
+	const uint64_t uVariance = (uSquares * 10000) / uSamples;
+
+	uint64_t uLow = 0;
+	uint64_t uHigh = 0xFFFFFFFF;
+
+	while (uLow < uHigh)
+	{
+		const uint64_t uMid = (uLow + uHigh + 1) >> 1;
+
+		if ((uMid * uMid) <= uVariance)
+			uLow = uMid;
+		else
+			uHigh = uMid - 1;
+	}
+
+	return (u32)uLow;
+}
@@ -0,0 +1,40 @@
+//------------------------------------------------------------------------------------------------
+//---- Latency Statistics ... 2026 Dave Gaunt                                                 ----
+//------------------------------------------------------------------------------------------------
+//---- Running Count, Extremes, Mean And Jitter (Standard Deviation) Of Interrupt Latencies   ----
+//---- In System Clocks, With Conversions To Phase 2 Cycles For The Display. Plain C -        ----
+//---- Host/irq_latency_test.py Builds It Alongside The Emulated VIA.                         ----
+//------------------------------------------------------------------------------------------------
+#ifndef __LatencyStats_h_included
+#define __LatencyStats_h_included
+
+#include <stdint.h>
+
+#include "types.h"
+
+typedef struct
+{
+	u32			m_uSamples;
+	u32			m_uTimeouts;						/* Armed, But #IRQ Never Came */
+	u32			m_uMinClocks;
+	u32			m_uMaxClocks;
+	uint64_t	m_uSumClocks;
+	uint64_t	m_uSumSquares;						/* Of The Distance From m_uOrigin - Keeps The Sum Small */
+	u32			m_uOrigin;							/* The First Sample */
+} LatencyStats;
+
+void LatencyStats_Reset(LatencyStats* pStats);
+void LatencyStats_Add(LatencyStats* pStats, const u32 uClocks);
+void LatencyStats_Timeout(LatencyStats* pStats);
+u32 LatencyStats_GetMeanClocks100(const LatencyStats* pStats);
+u32 LatencyStats_GetJitterClocks100(const LatencyStats* pStats);
+
+//------------------------------------------------------------------------------------------------
+//---- Hundredths Of A System Clock To Hundredths Of A Phase 2 Cycle.                         ----
+//------------------------------------------------------------------------------------------------
+static inline u32 LatencyStats_ToCycles100(const u32 uClocks100, const u32 uSysHz, const u32 uBusHz)
+{
+	return (u32)((((uint64_t)uClocks100 * uBusHz) + (uSysHz / 2)) / uSysHz);
+}
+
+#endif /* __LatencyStats_h_included */
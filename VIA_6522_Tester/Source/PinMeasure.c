@@ -0,0 +1,140 @@
+//------------------------------------------------------------------------------------------------
+//---- Pin Measurement ... 2026 Dave Gaunt                                                    ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include "PinMeasure.h"
+
+#include "pico/stdlib.h"
+
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/clocks.h"
+
+#include "pin_measure.pio.h"
+
+#define PIN_MEASURE_LOW_START		(0x7FFFFFFF)	/* Y - Where The Low Loop Counts Down From */
+
+typedef struct
+{
+	bool		m_bRunning;
+	u32			m_uPin;
+	u32			m_uSm;
+	u32			m_uDma;
+	u32			m_uReadIndex;
+	PinStats	m_stats;
+} MeasureChannel;
+
+// Each Ring Is Written Through A DMA Write Ring, So Must Be Aligned To Its Own Size.
+static volatile u32 s_aaRing[PIN_MEASURE_MAX_CHANNELS][PIN_MEASURE_RING_WORDS] __attribute__((aligned(PIN_MEASURE_RING_WORDS * sizeof(u32))));
+
+static MeasureChannel s_aChannel[PIN_MEASURE_MAX_CHANNELS];
+static u32 s_uOffset = 0;
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void PinMeasure_Init(void)
+{
+	pio_set_gpio_base(PIN_MEASURE_PIO, PIN_MEASURE_GPIO_BASE);
+	s_uOffset = pio_add_program(PIN_MEASURE_PIO, &pin_measure_program);
+
+	for (u32 uChannel=0; uChannel<PIN_MEASURE_MAX_CHANNELS; ++uChannel)
+		s_aChannel[uChannel].m_bRunning = false;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- The Pin Becomes An Input Here - It Stops Being Driven As Part Of The Port Pattern.     ----
+//---- The DMA Never Stops: Endless Transfers Round A Write Ring, PinMeasure_Poll Chases It.  ----
+//------------------------------------------------------------------------------------------------
+bool PinMeasure_Start(const u32 uChannel, const u32 uPin)
+{
+	if ((uChannel >= PIN_MEASURE_MAX_CHANNELS) || s_aChannel[uChannel].m_bRunning)
+		return false;
+
+	if ((uPin < PIN_MEASURE_GPIO_BASE) || (uPin >= (PIN_MEASURE_GPIO_BASE + 32)))
+		return false;
+
+	const int iSm = pio_claim_unused_sm(PIN_MEASURE_PIO, false);
+	if (iSm < 0)
+		return false;
+
+	MeasureChannel* pChannel = &s_aChannel[uChannel];
+	pChannel->m_uPin = uPin;
+	pChannel->m_uSm = (u32)iSm;
+	pChannel->m_uDma = (u32)dma_claim_unused_channel(true);
+	pChannel->m_uReadIndex = 0;
+	PinStats_Reset(&pChannel->m_stats, clock_get_hz(clk_sys));
+
+	pin_measure_program_init(PIN_MEASURE_PIO, pChannel->m_uSm, s_uOffset, uPin);
+	pio_sm_put(PIN_MEASURE_PIO, pChannel->m_uSm, PIN_MEASURE_LOW_START);
+
+	dma_channel_config c = dma_channel_get_default_config(pChannel->m_uDma);
+	channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+	channel_config_set_read_increment(&c, false);
+	channel_config_set_write_increment(&c, true);
+	channel_config_set_ring(&c, true, __builtin_ctz(PIN_MEASURE_RING_WORDS * sizeof(u32)));
+	channel_config_set_dreq(&c, pio_get_dreq(PIN_MEASURE_PIO, pChannel->m_uSm, false));
+
+	dma_channel_configure
+	(
+		pChannel->m_uDma,
+		&c,
+		s_aaRing[uChannel],
+		&PIN_MEASURE_PIO->rxf[pChannel->m_uSm],
+		dma_encode_endless_transfer_count(),
+		true
+	);
+
+	pChannel->m_bRunning = true;
+	pio_sm_set_enabled(PIN_MEASURE_PIO, pChannel->m_uSm, true);
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Everything The DMA Has Written Since Last Time, In Up To Two Pieces Round The Ring.    ----
+//------------------------------------------------------------------------------------------------
+void PinMeasure_Poll(void)
+{
+	for (u32 uChannel=0; uChannel<PIN_MEASURE_MAX_CHANNELS; ++uChannel)
+	{
+		MeasureChannel* pChannel = &s_aChannel[uChannel];
+
+		if (!pChannel->m_bRunning)
+			continue;
+
+		const volatile u32* pRing = s_aaRing[uChannel];
+		const u32 uWriteIndex = ((dma_hw->ch[pChannel->m_uDma].write_addr - (u32)pRing) / sizeof(u32)) & (PIN_MEASURE_RING_WORDS - 1);
+		const u32 uReadIndex = pChannel->m_uReadIndex;
+
+		if (uWriteIndex >= uReadIndex)
+		{
+			PinStats_Add(&pChannel->m_stats, &pRing[uReadIndex], uWriteIndex - uReadIndex);
+		}
+		else
+		{
+			PinStats_Add(&pChannel->m_stats, &pRing[uReadIndex], PIN_MEASURE_RING_WORDS - uReadIndex);
+			PinStats_Add(&pChannel->m_stats, pRing, uWriteIndex);
+		}
+
+		pChannel->m_uReadIndex = uWriteIndex;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+void PinMeasure_Gate(const u32 uChannel, PinResult* pResult)
+{
+	PinMeasure_Poll();
+	PinStats_Gate(&s_aChannel[uChannel].m_stats, pResult);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- For A Pin With No Edges - Which Way It Is Stuck.                                       ----
+//------------------------------------------------------------------------------------------------
+bool PinMeasure_GetLevel(const u32 uChannel)
+{
+	return gpio_get(s_aChannel[uChannel].m_uPin);
+}
@@ -0,0 +1,25 @@
+//------------------------------------------------------------------------------------------------
+//---- Pin Measurement ... 2026 Dave Gaunt                                                    ----
+//------------------------------------------------------------------------------------------------
+//---- Frequency, Period, Duty Cycle And Pulse Width Instruments On Any Port A Or Port B Pin  ----
+//---- - One PIO1 State Machine Per Pin Times Every Edge, DMA Rings The Results Into SRAM.    ----
+//------------------------------------------------------------------------------------------------
+#ifndef __PinMeasure_h_included
+#define __PinMeasure_h_included
+
+#include "types.h"
+
+#include "PinStats.h"
+
+#define PIN_MEASURE_PIO				(pio1)			/* The VGA Has PIO0 */
+#define PIN_MEASURE_GPIO_BASE		(16)			/* PIO1 Sees GPIO 16 - 47, So Both Ports */
+#define PIN_MEASURE_MAX_CHANNELS	(4)				/* One State Machine Each */
+#define PIN_MEASURE_RING_WORDS		(1024)			/* Must Be A Power Of 2! - 1 ms Of Edges From A Phase 2 / 2 Square Wave */
+
+void PinMeasure_Init(void);
+bool PinMeasure_Start(const u32 uChannel, const u32 uPin);
+void PinMeasure_Poll(void);
+void PinMeasure_Gate(const u32 uChannel, PinResult* pResult);
+bool PinMeasure_GetLevel(const u32 uChannel);
+
+#endif /* __PinMeasure_h_included */
@@ -0,0 +1,166 @@
+//------------------------------------------------------------------------------------------------
+//---- Pin Statistics ... 2026 Dave Gaunt                                                     ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include "PinStats.h"
+
+#include <string.h>
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+static void ClearResult(PinStats* pStats)
+{
+	PinResult* pResult = &pStats->m_result;
+
+	memset(pResult, 0, sizeof(*pResult));
+	pResult->m_uMinPeriodClocks = 0xFFFFFFFF;
+	pResult->m_uMinHighClocks = 0xFFFFFFFF;
+	pResult->m_uMinLowClocks = 0xFFFFFFFF;
+	pResult->m_uBinBaseClocks = pStats->m_uNextBinBase;
+	pResult->m_uBinClocks = pStats->m_uNextBinClocks;
+
+	pStats->m_uPeriodClocks = 0;
+	pStats->m_uPeriodHighClocks = 0;
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Out Of Range Widths Land In The End Bins, So Every Pulse Is Counted Somewhere.         ----
+//------------------------------------------------------------------------------------------------
+static inline void AddToHistogram(const PinResult* pResult, u32* pHistogram, const u32 uClocks)
+{
+	if (0 == pResult->m_uBinClocks)
+		return;
+
+	u32 uBin = (uClocks > pResult->m_uBinBaseClocks) ? ((uClocks - pResult->m_uBinBaseClocks) / pResult->m_uBinClocks) : 0;
+
+	if (uBin >= PIN_STATS_BINS)
+		uBin = PIN_STATS_BINS - 1;
+
+	++pHistogram[uBin];
+}
+
+//------------------------------------------------------------------------------------------------
+//---- The First Word Was Timed From The WAIT, Not An Edge Read By The Loop, So It Goes.      ----
+//------------------------------------------------------------------------------------------------
+void PinStats_Reset(PinStats* pStats, const u32 uSysHz)
+{
+	pStats->m_uSysHz = uSysHz;
+	pStats->m_uSkip = 1;
+	pStats->m_bLastHigh = false;
+	pStats->m_bPendingHigh = false;
+	pStats->m_uPendingHighClocks = 0;
+	pStats->m_uNextBinBase = 0;
+	pStats->m_uNextBinClocks = 0;
+
+	ClearResult(pStats);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Highs And Lows Strictly Take Turns - Two Of A Kind In A Row Means The Ring Overflowed  ----
+//---- In Between, So The Half Period Either Side Of The Gap Is Not Trusted.                  ----
+//------------------------------------------------------------------------------------------------
+void PinStats_Add(PinStats* pStats, const volatile u32* pWords, const u32 uCount)
+{
+	PinResult* pResult = &pStats->m_result;
+
+	for (u32 uWord=0; uWord<uCount; ++uWord)
+	{
+		const u32 uData = pWords[uWord];
+		const bool bHigh = (0 != (uData & PIN_STATS_HIGH_BIT));
+
+		if (pStats->m_uSkip)
+		{
+			--pStats->m_uSkip;
+			pStats->m_bLastHigh = bHigh;
+			continue;
+		}
+
+		if (bHigh == pStats->m_bLastHigh)
+			++pResult->m_uLost;
+
+		pStats->m_bLastHigh = bHigh;
+
+		if (bHigh)
+		{
+			const u32 uClocks = PIN_STATS_HIGH_CLOCKS(uData);
+
+			if (uClocks < pResult->m_uMinHighClocks)
+				pResult->m_uMinHighClocks = uClocks;
+			if (uClocks > pResult->m_uMaxHighClocks)
+				pResult->m_uMaxHighClocks = uClocks;
+
+			AddToHistogram(pResult, pResult->m_aHighHistogram, uClocks);
+
+			pStats->m_uPendingHighClocks = uClocks;
+			pStats->m_bPendingHigh = true;
+		}
+		else
+		{
+			const u32 uClocks = PIN_STATS_LOW_CLOCKS(uData);
+
+			if (uClocks < pResult->m_uMinLowClocks)
+				pResult->m_uMinLowClocks = uClocks;
+			if (uClocks > pResult->m_uMaxLowClocks)
+				pResult->m_uMaxLowClocks = uClocks;
+
+			AddToHistogram(pResult, pResult->m_aLowHistogram, uClocks);
+
+			// A High Then This Low Is One Whole Period.
+			if (pStats->m_bPendingHigh)
+			{
+				const u32 uPeriod = pStats->m_uPendingHighClocks + uClocks;
+
+				if (uPeriod < pResult->m_uMinPeriodClocks)
+					pResult->m_uMinPeriodClocks = uPeriod;
+				if (uPeriod > pResult->m_uMaxPeriodClocks)
+					pResult->m_uMaxPeriodClocks = uPeriod;
+
+				++pResult->m_uPeriods;
+				pStats->m_uPeriodClocks += uPeriod;
+				pStats->m_uPeriodHighClocks += pStats->m_uPendingHighClocks;
+				pStats->m_bPendingHigh = false;
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Hands Back Everything Since The Last Gate And Starts Again. The Histogram Range For    ----
+//---- The Next Gate Is Stretched Over The Shortest To Longest Pulse Seen In This One.        ----
+//------------------------------------------------------------------------------------------------
+void PinStats_Gate(PinStats* pStats, PinResult* pResult)
+{
+	PinResult* pGate = &pStats->m_result;
+
+	if (pGate->m_uPeriods)
+	{
+		pGate->m_uFrequencyMilliHz = (u32)(((uint64_t)pGate->m_uPeriods * pStats->m_uSysHz * 1000) / pStats->m_uPeriodClocks);
+		pGate->m_uPeriodNs = (u32)((pStats->m_uPeriodClocks * 1000000000u) / ((uint64_t)pGate->m_uPeriods * pStats->m_uSysHz));
+		pGate->m_uDutyHundredths = (u32)((pStats->m_uPeriodHighClocks * 10000) / pStats->m_uPeriodClocks);
+	}
+	else
+	{
+		pGate->m_uMinPeriodClocks = 0;
+	}
+
+	if (pGate->m_uMinHighClocks > pGate->m_uMaxHighClocks)
+		pGate->m_uMinHighClocks = 0;
+	if (pGate->m_uMinLowClocks > pGate->m_uMaxLowClocks)
+		pGate->m_uMinLowClocks = 0;
+
+	*pResult = *pGate;
+
+	// Only Re-Range When There Was Something Of Both Levels To Range Over.
+	if (pGate->m_uMaxHighClocks && pGate->m_uMaxLowClocks)
+	{
+		const u32 uShortest = (pGate->m_uMinHighClocks < pGate->m_uMinLowClocks) ? pGate->m_uMinHighClocks : pGate->m_uMinLowClocks;
+		const u32 uLongest = (pGate->m_uMaxHighClocks > pGate->m_uMaxLowClocks) ? pGate->m_uMaxHighClocks : pGate->m_uMaxLowClocks;
+
+		pStats->m_uNextBinBase = uShortest;
+		pStats->m_uNextBinClocks = ((uLongest - uShortest) / PIN_STATS_BINS) + 1;
+	}
+
+	ClearResult(pStats);
+}
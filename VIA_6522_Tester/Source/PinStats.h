@@ -0,0 +1,67 @@
+//------------------------------------------------------------------------------------------------
+//---- Pin Statistics ... 2026 Dave Gaunt                                                     ----
+//------------------------------------------------------------------------------------------------
+//---- Turns The High And Low Words From pin_measure.pio Into Frequency, Period, Duty Cycle   ----
+//---- And Pulse Width Histograms, One Gate At A Time. Plain C - Host/pin_measure_test.py     ----
+//---- Builds It Against Simulated Pins.                                                      ----
+//------------------------------------------------------------------------------------------------
+#ifndef __PinStats_h_included
+#define __PinStats_h_included
+
+#include <stdint.h>
+
+#include "types.h"
+
+#define PIN_STATS_BINS				(32)
+#define PIN_STATS_HIGH_BIT			(1u << 31)		/* Set In Every High Word */
+
+// Loop Turns To Clocks - Must Match pin_measure.pio.
+#define PIN_STATS_HIGH_CLOCKS(w)	(((0xFFFFFFFFu - (w)) << 1) + 2)
+#define PIN_STATS_LOW_CLOCKS(w)		(((0x7FFFFFFFu - (w)) << 1) + 3)
+
+typedef struct
+{
+	u32			m_uPeriods;							/* Complete High + Low Pairs */
+	u32			m_uFrequencyMilliHz;				/* Periods Over The Time They Took */
+	u32			m_uPeriodNs;						/* Average */
+	u32			m_uDutyHundredths;					/* High Share Of Those Periods, 0 - 10000 */
+	u32			m_uMinPeriodClocks;
+	u32			m_uMaxPeriodClocks;
+	u32			m_uMinHighClocks;
+	u32			m_uMaxHighClocks;
+	u32			m_uMinLowClocks;
+	u32			m_uMaxLowClocks;
+	u32			m_uLost;							/* Words Missing From The Stream */
+	u32			m_uBinBaseClocks;					/* Bin 0 Starts Here... */
+	u32			m_uBinClocks;						/* ...And Each Is This Wide - 0 Until The First Gate Has Set The Range */
+	u32			m_aHighHistogram[PIN_STATS_BINS];
+	u32			m_aLowHistogram[PIN_STATS_BINS];
+} PinResult;
+
+typedef struct
+{
+	u32			m_uSysHz;
+	u32			m_uSkip;							/* Words Still To Throw Away */
+	bool		m_bLastHigh;
+	bool		m_bPendingHigh;
+	u32			m_uPendingHighClocks;
+	uint64_t	m_uPeriodClocks;					/* Sum Over The Complete Periods */
+	uint64_t	m_uPeriodHighClocks;
+	PinResult	m_result;							/* Built Up Through The Gate */
+	u32			m_uNextBinBase;
+	u32			m_uNextBinClocks;
+} PinStats;
+
+void PinStats_Reset(PinStats* pStats, const u32 uSysHz);
+void PinStats_Add(PinStats* pStats, const volatile u32* pWords, const u32 uCount);
+void PinStats_Gate(PinStats* pStats, PinResult* pResult);
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+static inline u32 PinStats_ClocksToNs(const PinStats* pStats, const u32 uClocks)
+{
+	return (u32)(((uint64_t)uClocks * 1000000000u) / pStats->m_uSysHz);
+}
+
+#endif /* __PinStats_h_included */
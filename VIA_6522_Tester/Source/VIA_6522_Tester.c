@@ -13,16 +13,17 @@
 #include "hardware/pio.h"
 #include "hardware/dma.h"
 
-#include "hsync.pio.h"
-#include "vsync.pio.h"
-#include "rgb.pio.h"
-
-#include "VicChars.h"
-
-#define VGA_RESOLUTION_X    	(640)
-#define VGA_RESOLUTION_Y  		(480)
-#define TERMINAL_CHARS_WIDE		(VGA_RESOLUTION_X >> 3)
-#define TERMINAL_CHARS_HIGH		(VGA_RESOLUTION_Y >> 3)
+#include "VgaDisplay.h"
+#include "ClockPlan.h"
+#include "PinMap.h"
+#include "PinMeasure.h"
+#include "IrqLatency.h"
+#include "LatencyStats.h"
+#include "BusMonitor.h"
+#include "LogicScope.h"
+
+#include "irq_latency.pio.h"
+#include "bus_monitor.pio.h"
 
 #define	VIA_REGISTER_DISPLAY_X	(20)
 #define VIA_REGISTER_DISPLAY_Y	(5)
@@ -30,40 +31,49 @@
 #define VIC_PAL_CLOCK       	(4433618)
 #define VIC_CPU_CLOCK			(VIC_PAL_CLOCK >> 2)
 
-enum device_pins {
-	PIN_RED = 0,
-	PIN_GREEN,
-	PIN_BLUE,
-	PIN_S02_READ,
-	PIN_HSYNC = 8,
-	PIN_VSYNC,
-
-	PIN_RESET,
-	PIN_ADDRESS_CS1,		/* ADDRESS BIT 4 OR 5 On VIC */
-	PIN_IO0,				/* CS2 ACTIVE LOW */
-	PIN_READ_WRITE,
-	PIN_IRQ,
-
-	PIN_DATA_BIT0,
-	PIN_DATA_BIT1,
-	PIN_DATA_BIT2,
-	PIN_DATA_BIT3,
-	PIN_DATA_BIT4,
-	PIN_DATA_BIT5,
-	PIN_DATA_BIT6,
-	PIN_DATA_BIT7,
-
-	PIN_CLK,				/* S02 - Data Transfer Occurs Only When Phase 2 Clock Is High */
-	PIN_ADDRESS_BIT0,
-	PIN_ADDRESS_BIT1,
-	PIN_ADDRESS_BIT2,
-	PIN_ADDRESS_BIT3,
-
-	PIN_PORT_A = 32,
-	PIN_PORT_B = 40
-};
-
-static_assert(23 == PIN_CLK, "Clock must be on PIN 23!");
+#define MEASURE_DISPLAY_X		(4)
+#define MEASURE_DISPLAY_Y		(25)
+#define MEASURE_DISPLAY_ROWS	(8)				/* Text Rows Per Instrument, Histogram Included */
+#define MEASURE_GATE_FRAMES		(30)			/* Half A Second Per Reading */
+#define MEASURE_BIN_PIXELS		(10)
+#define MEASURE_HISTOGRAM_H		(32)
+#define MEASURE_FIELD_CHARS		(64)
+
+// Timer 1 Free Running On PB7 - A Square Wave Of 2 x (N + 2) Cycles For The Instruments To Check.
+#define MEASURE_T1_LATCH		(0x0100)
+
+// Set By The IRQ_LATENCY_TEST CMake Option - Core1 Times Timer 1 And 2 Interrupts Instead Of Reading The Ports.
+#ifndef IRQ_LATENCY_TEST
+#define IRQ_LATENCY_TEST		(0)
+#endif
+
+#define LATENCY_LATCH			(0x0040)		/* Both Timers, One Shot - The Datasheet Has #IRQ At N + 1.5 Cycles */
+#define LATENCY_TIMEOUT_US		((((LATENCY_LATCH + 64) * 1000000) / VIC_CPU_CLOCK) + 100)
+#define LATENCY_DISPLAY_X		(4)
+#define LATENCY_DISPLAY_Y		(46)
+
+// Set By The BUS_MONITOR CMake Option - PIO2 Watches The Data Bus Either Side Of Every Phase 2 Fall.
+#ifndef BUS_MONITOR
+#define BUS_MONITOR				(0)
+#endif
+
+#define BUS_MONITOR_SETUP_NS	(50)			/* Data And R/W Still This Long Before Phase 2 Falls... */
+#define BUS_MONITOR_HOLD_NS		(30)			/* ...And This Long After */
+#define BUS_MONITOR_DISPLAY_X	(4)
+#define BUS_MONITOR_DISPLAY_Y	(51)
+#define BUS_MONITOR_RECENT		(5)				/* Newest Violations Listed */
+
+// The Ports As Core1 Reads Them Back, With #IRQ, Rolling To The Right Of The Registers.
+#define LOGIC_SCOPE				(1)
+#define LOGIC_SCOPE_DECIMATE	(512)			/* Port Reads Per Column - Each Is A Pair Of Bus Cycles */
+#define LOGIC_SCOPE_X			(392)
+#define LOGIC_SCOPE_Y			(40)
+
+static_assert(irq_latency_S02_PIN == PIN_S02_READ, "irq_latency.pio waits on the wrong pin!");
+static_assert((bus_setup_S02_PIN == PIN_S02_READ) && (bus_hold_S02_PIN == PIN_S02_READ), "bus_monitor.pio waits on the wrong pin!");
+static_assert((PIN_IRQ == PIN_READ_WRITE + 1) && (PIN_DATA_BIT0 == PIN_READ_WRITE + 2), "bus_monitor.pio reads R/W, #IRQ and D0-D7 as one sample!");
+static_assert((MEASURE_DISPLAY_X + 8 + MEASURE_FIELD_CHARS <= TERMINAL_CHARS_WIDE) && (BUS_MONITOR_DISPLAY_Y + 3 + BUS_MONITOR_RECENT <= TERMINAL_CHARS_HIGH),
+			  "The panels are laid out for 80 x 60 text - the tester has no line doubled build!");
 
 typedef struct
 {
@@ -123,14 +133,28 @@ typedef struct
 } RegisterBuffer;
 
 #define VIA_RING_BUFFER_SIZE	(64)			/* Must Be A Power Of 2! */
+// The Bus Loop Fills The Slot After s_uRegTail, The Display Loop Reads The Slot After s_uRegHead.
 static volatile RegisterBuffer s_aRegBuffer[VIA_RING_BUFFER_SIZE];
 static volatile u8 s_uRegHead = VIA_RING_BUFFER_SIZE - 1;
 static volatile u8 s_uRegTail = VIA_RING_BUFFER_SIZE - 1;
 
-enum rgbColours {RGB_BLACK, RGB_RED, RGB_GREEN, RGB_YELLOW, RGB_BLUE, RGB_MAGENTA, RGB_CYAN, RGB_WHITE};
+// Interrupt Latencies From Core1, Accumulated And Shown By Core0.
+typedef struct
+{
+	u32	m_uClocks;							/* 0 = Timed Out */
+	u32	m_uTimer;							/* 0 = Timer 1, 1 = Timer 2 */
+} LatencySample;
+
+#define LATENCY_RING_SIZE		(64)			/* Must Be A Power Of 2! */
+static volatile LatencySample s_aLatencyRing[LATENCY_RING_SIZE];
+static volatile u32 s_uLatencyHead = 0;
+static volatile u32 s_uLatencyTail = 0;
 
-u8 volatile aVGAScreenBuffer[(VGA_RESOLUTION_X * VGA_RESOLUTION_Y) >> 1];
-volatile u8* address_pointer = aVGAScreenBuffer;
+#if LOGIC_SCOPE
+// Core1 Adds A Sample Each Time It Has Read Both Ports, Core0 Draws Them.
+static LogicCapture s_logicCapture;
+static LogicScope s_logicScope;
+#endif
 
 //------------------------------------------------------------------------------------------------
 //----                                                                                        ----
@@ -190,211 +214,62 @@ enum via_irq_flags
 	VIA_IRQ_SET_CLR
 };
 
-//------------------------------------------------------------------------------------------------
-//----                                                                                        ----
-//------------------------------------------------------------------------------------------------
-void initVGA()
+// Pins Timed By The PIO Instruments - Up To PIN_MEASURE_MAX_CHANNELS, Any Port A Or Port B Pin.
+typedef struct
 {
-	// Choose which PIO instance to use (there are two instances, each with 4 state machines)
-	PIO pio = pio0;
-	const uint hsync_offset = pio_add_program(pio, &hsync_program);
-	const uint vsync_offset = pio_add_program(pio, &vsync_program);
-	const uint rgb_offset = pio_add_program(pio, &rgb_program);
-
-	// Manually select a few state machines from pio instance pio0.
-	uint hsync_sm = 0;
-	uint vsync_sm = 1;
-	uint rgb_sm = 2;
-	hsync_program_init(pio, hsync_sm, hsync_offset, PIN_HSYNC);
-	vsync_program_init(pio, vsync_sm, vsync_offset, PIN_VSYNC);
-	rgb_program_init(pio, rgb_sm, rgb_offset, PIN_RED);
-
-	/////////////////////////////////////////////////////////////////////////////////////////////////////
-	// ============================== PIO DMA Channels =================================================
-	/////////////////////////////////////////////////////////////////////////////////////////////////////
-
-	// DMA channels - 0 sends color data, 1 reconfigures and restarts 0
-	int rgb_chan_0 = 0;
-	int rgb_chan_1 = 1;
-
-	// Channel Zero (sends color data to PIO VGA machine)
-	dma_channel_config c0 = dma_channel_get_default_config(rgb_chan_0);  	// default configs
-	channel_config_set_transfer_data_size(&c0, DMA_SIZE_8);              	// 8-bit txfers
-	channel_config_set_read_increment(&c0, true);                        	// yes read incrementing
-	channel_config_set_write_increment(&c0, false);                      	// no write incrementing
-	channel_config_set_dreq(&c0, DREQ_PIO0_TX2) ;                        	// DREQ_PIO0_TX2 pacing (FIFO)
-	channel_config_set_chain_to(&c0, rgb_chan_1);                        	// chain to other channel
-
-	dma_channel_configure
-	(
-		rgb_chan_0,                                                        	// Channel to be configured
-		&c0,                                                               	// The configuration we just created
-		&pio->txf[rgb_sm],                                                 	// write address (RGB PIO TX FIFO)
-		&aVGAScreenBuffer,                                                 	// The initial read address (pixel color array)
-		(VGA_RESOLUTION_X * VGA_RESOLUTION_Y) >> 1,                        	// Number of transfers; in this case each is 1 byte.
-		false                                                              	// Don't start immediately.
-	);
-
-	// Channel One (reconfigures the first channel)
-	dma_channel_config c1 = dma_channel_get_default_config(rgb_chan_1);  	// default configs
-	channel_config_set_transfer_data_size(&c1, DMA_SIZE_32);             	// 32-bit txfers
-	channel_config_set_read_increment(&c1, false);                       	// no read incrementing
-	channel_config_set_write_increment(&c1, false);                      	// no write incrementing
-	channel_config_set_chain_to(&c1, rgb_chan_0);                        	// chain to other channel
-
-	dma_channel_configure
-	(
-		rgb_chan_1,                         	// Channel to be configured
-		&c1,                                	// The configuration we just created
-		&dma_hw->ch[rgb_chan_0].read_addr,  	// Write address (channel 0 read address)
-		&address_pointer,                   	// Read address (POINTER TO AN ADDRESS)
-		1,                                 	 	// Number of transfers, in this case each is 4 byte
-		false                               	// Don't start immediately.
-	);
-
-  /////////////////////////////////////////////////////////////////////////////////////////////////////
-  /////////////////////////////////////////////////////////////////////////////////////////////////////
-
-	// Initialize PIO state machine counters. This passes the information to the state machines
-	// that they retrieve in the first 'pull' instructions, before the .wrap_target directive
-	// in the assembly. Each uses these values to initialize some counting registers.
-	#define H_ACTIVE   655    // (active + frontporch - 1) - one cycle delay for mov
-	#define V_ACTIVE   479    // (active - 1)
-	#define RGB_ACTIVE 319    // (horizontal active)/2 - 1
-	// #define RGB_ACTIVE 639 // change to this if 1 pixel/byte
-	pio_sm_put_blocking(pio, hsync_sm, H_ACTIVE);
-	pio_sm_put_blocking(pio, vsync_sm, V_ACTIVE);
-	pio_sm_put_blocking(pio, rgb_sm, RGB_ACTIVE);
-
-	// Start the two pio machine IN SYNC
-	// Note that the RGB state machine is running at full speed,
-	// so synchronization doesn't matter for that one. But, we'll
-	// start them all simultaneously anyway.
-	pio_enable_sm_mask_in_sync(pio, ((1u << hsync_sm) | (1u << vsync_sm) | (1u << rgb_sm)));
-
-	// Start DMA channel 0. Once started, the contents of the pixel color array
-	// will be continously DMA's to the PIO machines that are driving the screen.
-	// To change the contents of the screen, we need only change the contents
-	// of that array.
-	dma_start_channel_mask((1u << rgb_chan_0)) ;
-}
+	u32			m_uPin;
+	const char*	m_pszName;
+} MeasurePin;
 
-//------------------------------------------------------------------------------------------------
-//----                                                                                        ----
-//------------------------------------------------------------------------------------------------
-void FilledRectangle(u32 uPositionX, u32 uPositionY, u32 uWidth, u32 uHeight, u32 uColour)
+static const MeasurePin s_aMeasurePins[] =
 {
-	if (uPositionX + uWidth >= VGA_RESOLUTION_X)
-		uWidth = VGA_RESOLUTION_X - uPositionX;
-
-	if (uPositionY + uHeight >= VGA_RESOLUTION_Y)
-		uHeight = VGA_RESOLUTION_Y - uPositionY;
-
-	if ((uWidth > 0) && (uHeight > 0))
-	{
-		u32 uPixelOffset = ((uPositionY * VGA_RESOLUTION_X) + uPositionX) >> 1;
-
-		if (uPositionX & 1)
-		{
-			u32 uOffset = uPixelOffset++;
-			--uWidth;
-
-			for(u32 y=0; y<uHeight; ++y)
-			{
-				aVGAScreenBuffer[uOffset] = (aVGAScreenBuffer[uOffset] & 0b11000111) | (uColour << 3);
-				uOffset += VGA_RESOLUTION_X >> 1;
-			}
-		}
-
-		while (uWidth > 1)
-		{
-		u32 uOffset = uPixelOffset++;
-		uWidth -= 2;
-
-		for(u32 y=0; y<uHeight; ++y)
-		{
-			aVGAScreenBuffer[uOffset] = (uColour << 3) | uColour;
-			uOffset += VGA_RESOLUTION_X >> 1;
-		}
-		}
-
-		if (1 == uWidth)
-		{
-			for(u32 y=0; y<uHeight; ++y)
-			{
-				aVGAScreenBuffer[uPixelOffset] = (aVGAScreenBuffer[uPixelOffset] & 0b11111000) | uColour;
-				uPixelOffset += VGA_RESOLUTION_X >> 1;
-			}
-		}
-	}
-}
+	{PIN_PORT_B + 7, "PB7 T1"},
+};
+#define MEASURE_PIN_COUNT		(sizeof(s_aMeasurePins) / sizeof(s_aMeasurePins[0]))
+static_assert(MEASURE_PIN_COUNT <= PIN_MEASURE_MAX_CHANNELS);
 
-//------------------------------------------------------------------------------------------------
-//----                                                                                        ----
-//------------------------------------------------------------------------------------------------
-void DrawPetsciiChar(const u32 uXPos, const u32 uYPos, const u8 uChar, const u8 uColour)
+// Register Writes Made By Core1 Before It Starts Reading The Ports.
+static const u8 s_aSetupWrites[][2] =
 {
-	for (u32 uLine=0; uLine<8; ++uLine)
-	{
-		u32 uPixelOffset = ((((uYPos + uLine) * VGA_RESOLUTION_X ) + uXPos) >> 1) + 3;
-		u32 uCharLine = VicChars901460_03[2048 + (uChar << 3) + uLine];
-
-		for (u32 x=0; x<4; ++x)
-		{
-			u8 uPixelPair = 0;
-
-			if (uCharLine & 2)
-				uPixelPair = uColour;
-
-			if (uCharLine & 1)
-				uPixelPair |= (uColour << 3);
+	{VIA_REG_AUXILIARY_CONTROL,	0xC0},				/* Timer 1 Free Running, Output On PB7 */
+	{VIA_REG_TIMER1_L,			MEASURE_T1_LATCH & 0xFF},
+	{VIA_REG_TIMER1_H,			MEASURE_T1_LATCH >> 8},
+};
 
-			aVGAScreenBuffer[uPixelOffset--] = uPixelPair;
-			uCharLine >>= 2;
-		}
-	}
-}
+// The Timers The Latency Test Takes Turns With - Writing The High Byte Starts Each One.
+static const u8 s_aLatencyLowRegister[2] = {VIA_REG_TIMER1_L, VIA_REG_TIMER2_L};
 
 //------------------------------------------------------------------------------------------------
 //----                                                                                        ----
 //------------------------------------------------------------------------------------------------
-void DrawString(u32 uCharX, u32 uCharY, const char* pszString, const u8 uColour)
+static u8 ReadVIARegister(const u8 uRegisterIndex)
 {
-	while (*pszString)
-	{
-		if (uCharX >= (TERMINAL_CHARS_WIDE-1))
-		{
-			uCharX = 1;
-			++uCharY;
-		}
+	u32 uLow32Pins = gpioc_lo_in_get();
 
-		if (uCharY >= (TERMINAL_CHARS_HIGH-1))
-			return;
+	// Wait for S02 To Assert Low
+	while (1 == ((uLow32Pins >> PIN_S02_READ) & 1) )
+		uLow32Pins = gpioc_lo_in_get();
 
-		u8 c = *pszString++;
+	// Put Register Address On BUS
+	gpio_put_masked(PIN_ADDRESS_MASK, uRegisterIndex << PIN_ADDRESS_BIT0);
 
-		if (c >= '`')
-			c -= '`';
+	// Enable VIA
+	gpio_put(PIN_ADDRESS_CS1, true);
 
-		DrawPetsciiChar(uCharX << 3, uCharY << 3, c, uColour);
-		++uCharX;
-	}
-}
+	// Wait for S02 To Assert High
+	while (0 == ((uLow32Pins >> PIN_S02_READ) & 1) )
+		uLow32Pins = gpioc_lo_in_get();
 
-//------------------------------------------------------------------------------------------------
-//----                                                                                        ----
-//------------------------------------------------------------------------------------------------
-static const u8 aHexTable[16] = {'0','1','2','3','4','5','6','7','8','9','A','B','C','D','E','F'};
+	// Disable VIA
+	gpio_put(PIN_ADDRESS_CS1, false);
 
-static inline u16 byteToHex(const u8 uByte)
-{
-	return (aHexTable[(uByte >> 4) & 15] << 8) | aHexTable[uByte & 15];
+	return PIN_BUS_DATA(PIN_BUS_WORD(uLow32Pins));
 }
 
 //------------------------------------------------------------------------------------------------
-//----                                                                                        ----
+//---- The VIA Takes The Data On The Falling Edge Of S02, So The Bus Is Held Until Then.      ----
 //------------------------------------------------------------------------------------------------
-static u8 ReadVIARegister(const u8 uRegisterIndex)
+static void WriteVIARegister(const u8 uRegisterIndex, const u8 uValue)
 {
 	u32 uLow32Pins = gpioc_lo_in_get();
 
@@ -402,20 +277,26 @@ static u8 ReadVIARegister(const u8 uRegisterIndex)
 	while (1 == ((uLow32Pins >> PIN_S02_READ) & 1) )
 		uLow32Pins = gpioc_lo_in_get();
 
-	// Put Register Address On BUS
-	gpio_put_masked(0xF << PIN_ADDRESS_BIT0, uRegisterIndex << PIN_ADDRESS_BIT0);
+	// Put Register Address And Data On BUS
+	gpio_put_masked(PIN_ADDRESS_MASK, uRegisterIndex << PIN_ADDRESS_BIT0);
+	gpio_put_masked(PIN_DATA_MASK, uValue << PIN_DATA_BIT0);
+	gpio_set_dir_out_masked(PIN_DATA_MASK);
+	gpio_put(PIN_READ_WRITE, false);
 
 	// Enable VIA
 	gpio_put(PIN_ADDRESS_CS1, true);
 
-	// Wait for S02 To Assert High
+	// Wait for S02 To Assert High, Then Low Again
 	while (0 == ((uLow32Pins >> PIN_S02_READ) & 1) )
 		uLow32Pins = gpioc_lo_in_get();
 
-	// Disable VIA
-	gpio_put(PIN_ADDRESS_CS1, false);
+	while (1 == ((uLow32Pins >> PIN_S02_READ) & 1) )
+		uLow32Pins = gpioc_lo_in_get();
 
-	return (uLow32Pins >> PIN_DATA_BIT0) & 0xFF;
+	// Disable VIA And Let Go Of The Data Bus
+	gpio_put(PIN_ADDRESS_CS1, false);
+	gpio_put(PIN_READ_WRITE, true);
+	gpio_set_dir_in_masked(PIN_DATA_MASK);
 }
 
 //------------------------------------------------------------------------------------------------
@@ -432,6 +313,52 @@ static void PushVIARegister(const u8 uRegisterIndex, const u8 uValue)
 	s_uRegTail = uRegTail;
 }
 
+#if IRQ_LATENCY_TEST
+//------------------------------------------------------------------------------------------------
+//---- Timer 1 Then Timer 2, One Shot, Forever: Low Byte, Arm The PIO, High Byte To Start It, ----
+//---- Wait For #IRQ, Then Read The Low Counter To Clear The Flag Ready For The Next Turn.    ----
+//---- The Same Bus Sequence Runs Against A Real 6522 Or The Emulated One On VIA_6522.        ----
+//------------------------------------------------------------------------------------------------
+static void __not_in_flash_func(RunLatencyTest)(void)
+{
+	WriteVIARegister(VIA_REG_INTERRUPT_ENABLE, 0x7F);
+	WriteVIARegister(VIA_REG_AUXILIARY_CONTROL, 0x00);		// Both One Shot, No PB7, Timer 2 Counts Phase 2
+	WriteVIARegister(VIA_REG_INTERRUPT_ENABLE, 0x80 | (1 << VIA_IRQ_TIMER1) | (1 << VIA_IRQ_TIMER2));
+
+	while(true)
+	{
+		for (u32 uTimer=0; uTimer<2; ++uTimer)
+		{
+			const u8 uLowRegister = s_aLatencyLowRegister[uTimer];
+			u32 uClocks = 0;
+
+			// #IRQ Has To Be Back High First, Or The PIO Would Time Nothing.
+			if (!gpio_get(PIN_IRQ))
+				ReadVIARegister(uLowRegister);
+
+			WriteVIARegister(uLowRegister, LATENCY_LATCH & 0xFF);
+			IrqLatency_Arm();
+			WriteVIARegister(uLowRegister + 1, LATENCY_LATCH >> 8);
+
+			if (!IrqLatency_Wait(&uClocks, LATENCY_TIMEOUT_US))
+				uClocks = 0;
+
+			ReadVIARegister(uLowRegister);
+
+			// Dropped Rather Than Waited On If Core0 Falls Behind.
+			const u32 uTail = s_uLatencyTail;
+			const u32 uNext = (uTail + 1) & (LATENCY_RING_SIZE - 1);
+			if (uNext != s_uLatencyHead)
+			{
+				s_aLatencyRing[uTail].m_uClocks = uClocks;
+				s_aLatencyRing[uTail].m_uTimer = uTimer;
+				s_uLatencyTail = uNext;
+			}
+		}
+	}
+}
+#endif
+
 //------------------------------------------------------------------------------------------------
 //----                                                                                        ----
 //------------------------------------------------------------------------------------------------
@@ -445,30 +372,196 @@ static void __not_in_flash_func(function_core1)(void)
 	while ( (0 == ((uLow32Pins >> PIN_IO0) & 1)) || (1 == ((uLow32Pins >> PIN_CLK) & 1)) )
 		uLow32Pins = gpioc_lo_in_get();
 
+#if IRQ_LATENCY_TEST
+	RunLatencyTest();
+#endif
+
+	for (u32 uWrite=0; uWrite<(sizeof(s_aSetupWrites) / sizeof(s_aSetupWrites[0])); ++uWrite)
+		WriteVIARegister(s_aSetupWrites[uWrite][0], s_aSetupWrites[uWrite][1]);
+
 	u8 uAddress = 0;
+	u8 uPortA = 0;
 
 	while(true)
  	{
 		if(uAddress)
 		{
-			const u8 uPortA = ReadVIARegister(VIA_REG_PORTA);
+			uPortA = ReadVIARegister(VIA_REG_PORTA);
 			PushVIARegister(VIA_REG_PORTA, uPortA);
 		}
 		else
 		{
 			const u8 uPortB = ReadVIARegister(VIA_REG_PORTB);
 			PushVIARegister(VIA_REG_PORTB, uPortB);
+#if LOGIC_SCOPE
+			LogicCapture_Add(&s_logicCapture, LOGIC_SCOPE_SAMPLE(uPortA | (uPortB << 8), gpio_get(PIN_IRQ)));
+#endif
 		}
 
 		uAddress = !uAddress;
 	}
 }
 
+//------------------------------------------------------------------------------------------------
+//---- Nanoseconds As ns, us Or ms With Three Decimal Places - No Floats On The Display Path. ----
+//------------------------------------------------------------------------------------------------
+static void FormatTime(char* pszString, const u32 uNs)
+{
+	if (uNs < 1000)
+		sprintf(pszString, "%u ns", uNs);
+	else if (uNs < 1000000)
+		sprintf(pszString, "%u.%03u us", uNs / 1000, uNs % 1000);
+	else
+		sprintf(pszString, "%u.%03u ms", uNs / 1000000, (uNs / 1000) % 1000);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Padded Out So A Shorter Reading Wipes The End Of The Last One.                         ----
+//------------------------------------------------------------------------------------------------
+static void DrawField(const u32 uCharX, const u32 uCharY, const char* pszString, const u8 uColour)
+{
+	char szField[MEASURE_FIELD_CHARS + 1];
+
+	snprintf(szField, sizeof(szField), "%-*s", MEASURE_FIELD_CHARS, pszString);
+	DrawString(uCharX, uCharY, szField, uColour);
+}
+
+//------------------------------------------------------------------------------------------------
+//---- One Instrument - Frequency, Period And Duty, The Extremes, Then A Histogram Of High    ----
+//---- (Green) And Low (Red) Pulse Widths Across The Range The Previous Gate Found.           ----
+//------------------------------------------------------------------------------------------------
+static void DrawMeasurement(const u32 uChannel, const PinResult* pResult)
+{
+	const u32 uCharX = MEASURE_DISPLAY_X + 8;
+	const u32 uCharY = MEASURE_DISPLAY_Y + 2 + (uChannel * MEASURE_DISPLAY_ROWS);
+	const u32 uBaseX = MEASURE_DISPLAY_X << 3;
+	const u32 uBaseY = (uCharY + 3) << 3;
+	const PinStats stats = {.m_uSysHz = clock_get_hz(clk_sys)};
+	char szLine[MEASURE_FIELD_CHARS + 1];
+	char szFrom[24];
+	char szTo[24];
+	char szLowFrom[24];
+	char szLowTo[24];
+
+	FilledRectangle(uBaseX, uBaseY, PIN_STATS_BINS * MEASURE_BIN_PIXELS, MEASURE_HISTOGRAM_H, RGB_BLACK);
+
+	if (0 == pResult->m_uPeriods)
+	{
+		snprintf(szLine, sizeof(szLine), "No Edges - Pin %s", PinMeasure_GetLevel(uChannel) ? "High" : "Low");
+		DrawField(uCharX, uCharY, szLine, RGB_RED);
+		DrawField(uCharX, uCharY + 1, "", RGB_BLACK);
+		DrawField(uCharX, uCharY + 2, "", RGB_BLACK);
+		return;
+	}
+
+	FormatTime(szTo, pResult->m_uPeriodNs);
+	sprintf(szFrom, "%u.%03u Hz", pResult->m_uFrequencyMilliHz / 1000, pResult->m_uFrequencyMilliHz % 1000);
+	snprintf(szLine, sizeof(szLine), "%-16s T %-13s Duty %u.%02u%%  Lost %u", szFrom, szTo, pResult->m_uDutyHundredths / 100, pResult->m_uDutyHundredths % 100, pResult->m_uLost);
+	DrawField(uCharX, uCharY, szLine, pResult->m_uLost ? RGB_RED : RGB_YELLOW);
+
+	FormatTime(szFrom, PinStats_ClocksToNs(&stats, pResult->m_uMinHighClocks));
+	FormatTime(szTo, PinStats_ClocksToNs(&stats, pResult->m_uMaxHighClocks));
+	FormatTime(szLowFrom, PinStats_ClocksToNs(&stats, pResult->m_uMinLowClocks));
+	FormatTime(szLowTo, PinStats_ClocksToNs(&stats, pResult->m_uMaxLowClocks));
+	snprintf(szLine, sizeof(szLine), "High %s - %s  Low %s - %s", szFrom, szTo, szLowFrom, szLowTo);
+	DrawField(uCharX, uCharY + 1, szLine, RGB_WHITE);
+
+	// The First Gate Only Finds The Range.
+	if (0 == pResult->m_uBinClocks)
+		return;
+
+	FormatTime(szFrom, PinStats_ClocksToNs(&stats, pResult->m_uBinBaseClocks));
+	FormatTime(szTo, PinStats_ClocksToNs(&stats, pResult->m_uBinBaseClocks + (pResult->m_uBinClocks * PIN_STATS_BINS)));
+	snprintf(szLine, sizeof(szLine), "Widths %s - %s", szFrom, szTo);
+	DrawField(uCharX, uCharY + 2, szLine, RGB_CYAN);
+
+	u32 uTallest = 1;
+	for (u32 uBin=0; uBin<PIN_STATS_BINS; ++uBin)
+	{
+		if (pResult->m_aHighHistogram[uBin] > uTallest)
+			uTallest = pResult->m_aHighHistogram[uBin];
+		if (pResult->m_aLowHistogram[uBin] > uTallest)
+			uTallest = pResult->m_aLowHistogram[uBin];
+	}
+
+	for (u32 uBin=0; uBin<PIN_STATS_BINS; ++uBin)
+	{
+		const u32 uHigh = ((pResult->m_aHighHistogram[uBin] * MEASURE_HISTOGRAM_H) + uTallest - 1) / uTallest;
+		const u32 uLow = ((pResult->m_aLowHistogram[uBin] * MEASURE_HISTOGRAM_H) + uTallest - 1) / uTallest;
+		const u32 uBinX = uBaseX + (uBin * MEASURE_BIN_PIXELS);
+
+		if (uHigh)
+			FilledRectangle(uBinX, uBaseY + MEASURE_HISTOGRAM_H - uHigh, 4, uHigh, RGB_GREEN);
+		if (uLow)
+			FilledRectangle(uBinX + 4, uBaseY + MEASURE_HISTOGRAM_H - uLow, 4, uLow, RGB_RED);
+	}
+}
+
+#if IRQ_LATENCY_TEST
+//------------------------------------------------------------------------------------------------
+//---- One Timer's Running Totals - Cycles Are Phase 2 At The Nominal Divider, Jitter In ns.  ----
+//------------------------------------------------------------------------------------------------
+static void DrawLatency(const u32 uTimer, const LatencyStats* pStats)
+{
+	const u32 uSysHz = clock_get_hz(clk_sys);
+	const u32 uCharY = LATENCY_DISPLAY_Y + 2 + uTimer;
+	char szLine[MEASURE_FIELD_CHARS + 1];
+
+	if (0 == pStats->m_uSamples)
+	{
+		snprintf(szLine, sizeof(szLine), "No #IRQ  Timeouts %u", pStats->m_uTimeouts);
+		DrawField(LATENCY_DISPLAY_X + 4, uCharY, szLine, RGB_RED);
+		return;
+	}
+
+	const u32 uMean = LatencyStats_ToCycles100(LatencyStats_GetMeanClocks100(pStats), uSysHz, VIC_CPU_CLOCK);
+	const u32 uMin = LatencyStats_ToCycles100(pStats->m_uMinClocks * 100, uSysHz, VIC_CPU_CLOCK);
+	const u32 uMax = LatencyStats_ToCycles100(pStats->m_uMaxClocks * 100, uSysHz, VIC_CPU_CLOCK);
+	const u32 uJitterNs = (u32)((((uint64_t)LatencyStats_GetJitterClocks100(pStats) * 10000000) + (uSysHz / 2)) / uSysHz);
+
+	snprintf(szLine, sizeof(szLine), "%-8u Mean %u.%02u Min %u.%02u Max %u.%02u Jitter %uns Timeouts %u", pStats->m_uSamples,
+		uMean / 100, uMean % 100, uMin / 100, uMin % 100, uMax / 100, uMax % 100, uJitterNs, pStats->m_uTimeouts);
+	DrawField(LATENCY_DISPLAY_X + 4, uCharY, szLine, pStats->m_uTimeouts ? RGB_RED : RGB_YELLOW);
+}
+#endif
+
+#if BUS_MONITOR
+//------------------------------------------------------------------------------------------------
+//---- Totals, Then The Newest Few - What Moved, From What To What, And When Core0 Saw It.    ----
+//------------------------------------------------------------------------------------------------
+static void DrawBusMonitor(const ViolationLog* pLog)
+{
+	char szLine[MEASURE_FIELD_CHARS + 1];
+
+	snprintf(szLine, sizeof(szLine), "Setup %u  Hold %u  #IRQ Only %u  Stalls %u", pLog->m_aCount[VIOLATION_SETUP], pLog->m_aCount[VIOLATION_HOLD], pLog->m_uIrqOnly, pLog->m_uStalls);
+	DrawField(BUS_MONITOR_DISPLAY_X, BUS_MONITOR_DISPLAY_Y + 2, szLine, pLog->m_uLogged ? RGB_RED : RGB_GREEN);
+
+	for (u32 uAge=0; uAge<BUS_MONITOR_RECENT; ++uAge)
+	{
+		const Violation* pViolation = ViolationLog_GetRecent(pLog, uAge);
+
+		if (NULL == pViolation)
+		{
+			DrawField(BUS_MONITOR_DISPLAY_X, BUS_MONITOR_DISPLAY_Y + 3 + uAge, "", RGB_BLACK);
+			continue;
+		}
+
+		const u32 uBefore = pViolation->m_uBefore;
+		const u32 uAfter = pViolation->m_uAfter;
+		snprintf(szLine, sizeof(szLine), "Seen At %10u us %-5s R/W %u>%u  Data $%02X>$%02X  Moved $%02X", pViolation->m_uSeenUs,
+			(VIOLATION_SETUP == pViolation->m_uKind) ? "Setup" : "Hold", uBefore & BUS_SAMPLE_RW, uAfter & BUS_SAMPLE_RW,
+			uBefore >> BUS_SAMPLE_DATA_SHIFT, uAfter >> BUS_SAMPLE_DATA_SHIFT, (uBefore ^ uAfter) >> BUS_SAMPLE_DATA_SHIFT);
+		DrawField(BUS_MONITOR_DISPLAY_X, BUS_MONITOR_DISPLAY_Y + 3 + uAge, szLine, RGB_YELLOW);
+	}
+}
+#endif
+
 //------------------------------------------------------------------------------------------------
 //----                                                                                        ----
 //------------------------------------------------------------------------------------------------
 int main()
 {
+	ClockPlan_Init();
 	stdio_init_all();
 
 	gpio_init(PIN_RESET);						// Put The VIA Into Reset
@@ -488,9 +581,10 @@ int main()
 	gpio_set_dir(PIN_READ_WRITE, GPIO_OUT);
 	gpio_put(PIN_READ_WRITE, true);				// Read Mode
 
-	// IRQ Active Low
+	// IRQ Active Low, Open Drain
 	gpio_init(PIN_IRQ);
 	gpio_set_dir(PIN_IRQ, GPIO_IN);
+	gpio_pull_up(PIN_IRQ);
 
 	// Set All Data Pins To Input
 	for(u32 uPin=PIN_DATA_BIT0; uPin<=PIN_DATA_BIT7; ++uPin)
@@ -518,14 +612,31 @@ int main()
 		gpio_put(PIN_PORT_B + uPinIndex, ~uPinIndex & 1);
 	}
 
+	// The Measured Pins Become Inputs Before Core1 Can Turn Any Of Them Into VIA Outputs.
+	PinMeasure_Init();
+	for (u32 uChannel=0; uChannel<MEASURE_PIN_COUNT; ++uChannel)
+		PinMeasure_Start(uChannel, s_aMeasurePins[uChannel].m_uPin);
+
+#if IRQ_LATENCY_TEST
+	IrqLatency_Init(PIN_IRQ, PIN_READ_WRITE);
+#endif
+
+#if BUS_MONITOR
+	BusMonitor_Init(PIN_READ_WRITE, PIN_S02_READ, VIC_CPU_CLOCK, BUS_MONITOR_SETUP_NS, BUS_MONITOR_HOLD_NS);
+#endif
+
+#if LOGIC_SCOPE
+	LogicCapture_Init(&s_logicCapture, LOGIC_SCOPE_DECIMATE);
+#endif
+
 	multicore_launch_core1(function_core1);
 
 	// Create The Phase 2 Clock
 	gpio_init(PIN_S02_READ);
 	gpio_set_dir(PIN_S02_READ, GPIO_IN);
-	clock_gpio_init(PIN_CLK, CLOCKS_CLK_GPOUT0_CTRL_AUXSRC_VALUE_CLK_SYS, ((float)SYS_CLK_HZ / (float)VIC_CPU_CLOCK));
+	clock_gpio_init(PIN_CLK, CLOCKS_CLK_GPOUT0_CTRL_AUXSRC_VALUE_CLK_SYS, ((float)CLOCK_PLAN_SYS_HZ / (float)VIC_CPU_CLOCK));
 
-	initVGA();
+	initVGA(PIN_RED, PIN_HSYNC, PIN_VSYNC);
 	FilledRectangle(0, 0, VGA_RESOLUTION_X, VGA_RESOLUTION_Y, RGB_GREEN);
 	FilledRectangle(1, 1, VGA_RESOLUTION_X-2, VGA_RESOLUTION_Y-2, RGB_BLACK);
 
@@ -544,15 +655,53 @@ int main()
 		DrawString(VIA_REGISTER_DISPLAY_X + 13, VIA_REGISTER_DISPLAY_Y + 2 + uRegisterIndex, s_aszRegisterNames[uRegisterIndex], RGB_CYAN);
 	}
 
+	// Free Running Timer 1 Toggles PB7 Every N + 2 Cycles.
+	const u32 uExpectMilliHz = (u32)(((uint64_t)VIC_CPU_CLOCK * 1000) / (2 * (MEASURE_T1_LATCH + 2)));
+	sprintf(szTempString, "Pin Measurement - T1 Latch $%04X, PB7 Should Be %u.%03u Hz", MEASURE_T1_LATCH, uExpectMilliHz / 1000, uExpectMilliHz % 1000);
+	DrawString(MEASURE_DISPLAY_X, MEASURE_DISPLAY_Y, szTempString, RGB_CYAN);
+
+	for (u32 uChannel=0; uChannel<MEASURE_PIN_COUNT; ++uChannel)
+		DrawString(MEASURE_DISPLAY_X, MEASURE_DISPLAY_Y + 2 + (uChannel * MEASURE_DISPLAY_ROWS), s_aMeasurePins[uChannel].m_pszName, RGB_GREEN);
+
+#if IRQ_LATENCY_TEST
+	LatencyStats aLatencyStats[2];
+	LatencyStats_Reset(&aLatencyStats[0]);
+	LatencyStats_Reset(&aLatencyStats[1]);
+
+	sprintf(szTempString, "IRQ Latency - Latch $%04X One Shot, Datasheet %u.50 Cycles", LATENCY_LATCH, LATENCY_LATCH + 1);
+	DrawString(LATENCY_DISPLAY_X, LATENCY_DISPLAY_Y, szTempString, RGB_CYAN);
+	DrawString(LATENCY_DISPLAY_X, LATENCY_DISPLAY_Y + 2, "T1", RGB_GREEN);
+	DrawString(LATENCY_DISPLAY_X, LATENCY_DISPLAY_Y + 3, "T2", RGB_GREEN);
+#endif
+
+#if BUS_MONITOR
+	ViolationLog violationLog;
+	ViolationLog_Reset(&violationLog);
+
+	const BusWindow* pWindow = BusMonitor_GetWindow();
+	const u32 uSysMHz = clock_get_hz(clk_sys) / 1000000;
+	sprintf(szTempString, "Bus Monitor - Setup %u ns, Hold %u ns (%u And %u Clocks At %u MHz)", BUS_MONITOR_SETUP_NS, BUS_MONITOR_HOLD_NS,
+		pWindow->m_uSetupClocks, pWindow->m_uHoldClocks, uSysMHz);
+	DrawString(BUS_MONITOR_DISPLAY_X, BUS_MONITOR_DISPLAY_Y, szTempString, RGB_CYAN);
+#endif
+
+#if LOGIC_SCOPE
+	LogicScope_Init(&s_logicScope, &s_logicCapture, LOGIC_SCOPE_X, LOGIC_SCOPE_Y, VGA_RESOLUTION_X);
+	u32 uScopeFrame = GetVGAFrameCount();
+#endif
+
+	u32 uGateFrame = GetVGAFrameCount();
+
 	while(true)
 	{
 		// Update The Register List From The Ring Buffer.
 		if (s_uRegHead != s_uRegTail)
 		{
-			const u8 uRegister = s_aRegBuffer[s_uRegHead].m_uOffset & (VIA_RING_BUFFER_SIZE - 1);
-			const u8 uData = s_aRegBuffer[s_uRegHead].m_uData;
+			const u8 uRegHead = (s_uRegHead + 1) & (VIA_RING_BUFFER_SIZE - 1);
+			const u8 uRegister = s_aRegBuffer[uRegHead].m_uOffset & 15;
+			const u8 uData = s_aRegBuffer[uRegHead].m_uData;
 			s_viaRegs.m_aReg[uRegister] = uData;
-			s_uRegHead = (s_uRegHead + 1) & (VIA_RING_BUFFER_SIZE - 1);
+			s_uRegHead = uRegHead;
 		}
 
 		for (u32 uRegisterIndex=0; uRegisterIndex<16; ++uRegisterIndex)
@@ -562,6 +711,60 @@ int main()
 			DrawPetsciiChar((VIA_REGISTER_DISPLAY_X + 9) << 3, ((VIA_REGISTER_DISPLAY_Y + 2) + uRegisterIndex) << 3, uHexPair >> 8, RGB_YELLOW);
 			DrawPetsciiChar((VIA_REGISTER_DISPLAY_X + 10) << 3, ((VIA_REGISTER_DISPLAY_Y + 2) + uRegisterIndex) << 3, uHexPair & 255, RGB_YELLOW);
 		}
+
+#if IRQ_LATENCY_TEST
+		while (s_uLatencyHead != s_uLatencyTail)
+		{
+			const u32 uHead = s_uLatencyHead;
+			LatencyStats* pStats = &aLatencyStats[s_aLatencyRing[uHead].m_uTimer & 1];
+
+			if (s_aLatencyRing[uHead].m_uClocks)
+				LatencyStats_Add(pStats, s_aLatencyRing[uHead].m_uClocks);
+			else
+				LatencyStats_Timeout(pStats);
+
+			s_uLatencyHead = (uHead + 1) & (LATENCY_RING_SIZE - 1);
+		}
+#endif
+
+#if BUS_MONITOR
+		BusMonitor_Poll(&violationLog);
+#endif
+
+#if LOGIC_SCOPE
+		// A New Batch Each Frame, Then One Lane A Pass Between The Other Instruments.
+		if (GetVGAFrameCount() != uScopeFrame)
+		{
+			uScopeFrame = GetVGAFrameCount();
+			LogicScope_Begin(&s_logicScope, &s_logicCapture);
+		}
+
+		LogicScope_Step(&s_logicScope);
+#endif
+
+		// Keep Up With The DMA Rings, And Show A Reading Every Gate.
+		PinMeasure_Poll();
+
+		if ((GetVGAFrameCount() - uGateFrame) >= MEASURE_GATE_FRAMES)
+		{
+			uGateFrame += MEASURE_GATE_FRAMES;
+
+			for (u32 uChannel=0; uChannel<MEASURE_PIN_COUNT; ++uChannel)
+			{
+				PinResult result;
+				PinMeasure_Gate(uChannel, &result);
+				DrawMeasurement(uChannel, &result);
+			}
+
+#if IRQ_LATENCY_TEST
+			DrawLatency(0, &aLatencyStats[0]);
+			DrawLatency(1, &aLatencyStats[1]);
+#endif
+
+#if BUS_MONITOR
+			DrawBusMonitor(&violationLog);
+#endif
+		}
 		// sleep_ms(16);
 	}
 }
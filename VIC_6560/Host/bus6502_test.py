@@ -0,0 +1,472 @@
+#!/usr/bin/env python3
+#------------------------------------------------------------------------------------------------
+#---- VIC 6560 Bus Decoder Test ... 2026 Dave Gaunt                                          ----
+#------------------------------------------------------------------------------------------------
+#---- Builds Common/Bus6502.c For The Host, Runs Known Programs On A Cycle By Cycle Model Of  ----
+#---- The 6502 Bus (Every Dummy Read Included), And Checks The Decoder Finds Every Opcode    ----
+#---- Fetch The Model Made - With Resets, IRQs, NMIs And BRKs Landing Anywhere.              ----
+#------------------------------------------------------------------------------------------------
+import argparse
+import ctypes
+import os
+import random
+import subprocess
+import sys
+import tempfile
+
+COMMON_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "Common")
+
+CYCLE_READ = 1 << 24            # BUS6502_CYCLE_READ
+CYCLE_RESET = 1 << 25           # BUS6502_CYCLE_RESET
+MAX_PER_CYCLE = 2               # BUS6502_MAX_PER_CYCLE
+MAX_TEXT = 32                   # BUS6502_MAX_TEXT
+
+EVENT_INSTRUCTION, EVENT_ILLEGAL, EVENT_NMI, EVENT_RESET, EVENT_IRQ, EVENT_LOST = range(6)
+
+
+class Instruction(ctypes.Structure):
+    _fields_ = [("address", ctypes.c_uint16), ("opcode", ctypes.c_uint8), ("operand", ctypes.c_uint8 * 2),
+                ("length", ctypes.c_uint8), ("event", ctypes.c_uint8)]
+
+
+def build_decoder(directory):
+    library = os.path.join(directory, "libbus6502.so")
+    subprocess.check_call([os.environ.get("CC", "cc"), "-std=gnu11", "-O2", "-Wall", "-shared", "-fPIC",
+                           "-I", COMMON_DIR, os.path.join(COMMON_DIR, "Bus6502.c"), "-o", library])
+    decoder = ctypes.CDLL(library)
+    decoder.Bus6502_Decode.restype = ctypes.c_uint32
+    decoder.Bus6502_Decode.argtypes = [ctypes.c_void_p, ctypes.c_uint32, ctypes.POINTER(Instruction)]
+    decoder.Bus6502_Format.restype = ctypes.c_uint32
+    return decoder
+
+
+class Decoder:
+    def __init__(self, library):
+        self.library = library
+        self.state = ctypes.create_string_buffer(256)       # Comfortably bigger than Bus6502Decoder
+        self.out = (Instruction * MAX_PER_CYCLE)()
+        library.Bus6502_Init(self.state)
+
+    def feed(self, cycles):
+        """Returns (event, address, bytes) for everything the decoder reported."""
+        found = []
+        for cycle in cycles:
+            for index in range(self.library.Bus6502_Decode(self.state, cycle, self.out)):
+                item = self.out[index]
+                data = bytes([item.opcode] + list(item.operand))[:item.length]
+                found.append((item.event, item.address, data))
+        return found
+
+    def format(self, event, address, data):
+        item = Instruction(address, data[0] if data else 0, (ctypes.c_uint8 * 2)(*(list(data[1:]) + [0, 0])[:2]), len(data), event)
+        text = ctypes.create_string_buffer(MAX_TEXT)
+        length = self.library.Bus6502_Format(ctypes.byref(item), text)
+        return text.value.decode()[:length]
+
+
+#------------------------------------------------------------------------------------------------
+#---- Just Enough 6502 To Run The Test Programs - Bus Cycles Follow The NMOS Data Sheets.    ----
+#------------------------------------------------------------------------------------------------
+READ, WRITE, MODIFY = range(3)
+
+OPCODES = {
+    # name, mode, kind
+    0xA9: ("LDA", "imm", READ), 0xA5: ("LDA", "zp", READ), 0xB5: ("LDA", "zpx", READ), 0xAD: ("LDA", "abs", READ),
+    0xBD: ("LDA", "abx", READ), 0xB9: ("LDA", "aby", READ), 0xA1: ("LDA", "inx", READ), 0xB1: ("LDA", "iny", READ),
+    0xA2: ("LDX", "imm", READ), 0xA6: ("LDX", "zp", READ), 0xB6: ("LDX", "zpy", READ), 0xAE: ("LDX", "abs", READ),
+    0xA0: ("LDY", "imm", READ), 0xBC: ("LDY", "abx", READ),
+    0x85: ("STA", "zp", WRITE), 0x95: ("STA", "zpx", WRITE), 0x8D: ("STA", "abs", WRITE), 0x9D: ("STA", "abx", WRITE),
+    0x99: ("STA", "aby", WRITE), 0x81: ("STA", "inx", WRITE), 0x91: ("STA", "iny", WRITE),
+    0x86: ("STX", "zp", WRITE), 0x8C: ("STY", "abs", WRITE),
+    0x69: ("ADC", "imm", READ), 0xE9: ("SBC", "imm", READ), 0x29: ("AND", "imm", READ), 0x59: ("EOR", "aby", READ),
+    0xC9: ("CMP", "imm", READ), 0xE0: ("CPX", "imm", READ), 0xC0: ("CPY", "imm", READ), 0x2C: ("BIT", "abs", READ),
+    0xE6: ("INC", "zp", MODIFY), 0xEE: ("INC", "abs", MODIFY), 0xDE: ("DEC", "abx", MODIFY), 0x16: ("ASL", "zpx", MODIFY),
+    0x0A: ("ASL", "acc", None), 0x6A: ("ROR", "acc", None),
+    0xE8: ("INX", "imp", None), 0xC8: ("INY", "imp", None), 0xCA: ("DEX", "imp", None), 0x88: ("DEY", "imp", None),
+    0xAA: ("TAX", "imp", None), 0x8A: ("TXA", "imp", None), 0x18: ("CLC", "imp", None), 0x38: ("SEC", "imp", None),
+    0x58: ("CLI", "imp", None), 0x78: ("SEI", "imp", None), 0xEA: ("NOP", "imp", None),
+    0x48: ("PHA", "imp", None), 0x68: ("PLA", "imp", None), 0x08: ("PHP", "imp", None), 0x28: ("PLP", "imp", None),
+    0x4C: ("JMP", "abs", None), 0x6C: ("JMP", "ind", None), 0x20: ("JSR", "abs", None), 0x60: ("RTS", "imp", None),
+    0x40: ("RTI", "imp", None), 0x00: ("BRK", "imp", None),
+    0x10: ("BPL", "rel", None), 0x30: ("BMI", "rel", None), 0x90: ("BCC", "rel", None), 0xB0: ("BCS", "rel", None),
+    0xD0: ("BNE", "rel", None), 0xF0: ("BEQ", "rel", None),
+}
+
+FLAG_C, FLAG_Z, FLAG_I, FLAG_B, FLAG_N = 0x01, 0x02, 0x04, 0x10, 0x80
+
+
+class Cpu:
+    def __init__(self, memory):
+        self.memory = memory
+        self.a = self.x = self.y = 0
+        self.s = 0xFD
+        self.p = FLAG_I | 0x20
+        self.pc = 0
+        self.cycles = []
+        self.trace = []                     # What the decoder should report
+        self.irq_delayed = False
+
+    def read(self, address):
+        address &= 0xFFFF
+        data = self.memory[address]
+        self.cycles.append(address | (data << 16) | CYCLE_READ)
+        return data
+
+    def write(self, address, data):
+        address &= 0xFFFF
+        self.memory[address] = data & 0xFF
+        self.cycles.append(address | ((data & 0xFF) << 16))
+
+    def push(self, data):
+        self.write(0x100 | self.s, data)
+        self.s = (self.s - 1) & 0xFF
+
+    def pull(self):
+        self.s = (self.s + 1) & 0xFF
+        return self.read(0x100 | self.s)
+
+    def nz(self, value):
+        value &= 0xFF
+        self.p = (self.p & ~(FLAG_N | FLAG_Z)) | (value & FLAG_N) | (FLAG_Z if value == 0 else 0)
+        return value
+
+    def reset(self, held):
+        for _ in range(held):
+            self.cycles.append(0xFFFF | (self.memory[0xFFFF] << 16) | CYCLE_READ | CYCLE_RESET)
+        self.read(self.pc)
+        self.read(self.pc)
+        for _ in range(3):
+            self.read(0x100 | self.s)
+            self.s = (self.s - 1) & 0xFF
+        self.pc = self.read(0xFFFC) | (self.read(0xFFFD) << 8)
+        self.p |= FLAG_I
+        self.trace.append((EVENT_RESET, self.pc, b""))
+
+    def interrupt(self, vector, event):
+        self.read(self.pc)
+        self.read(self.pc)
+        self.push(self.pc >> 8)
+        self.push(self.pc & 0xFF)
+        self.push(self.p & ~FLAG_B)
+        self.p |= FLAG_I
+        self.pc = self.read(vector) | (self.read(vector + 1) << 8)
+        self.trace.append((event, self.pc, b""))
+
+    def address(self, mode, kind):
+        """The addressing cycles - returns the effective address, the final access is the caller's."""
+        pc = self.pc
+        if mode in ("zp", "zpx", "zpy"):
+            zp = self.read(pc + 1)
+            self.pc += 2
+            if mode == "zp":
+                return zp
+            self.read(zp)
+            return (zp + (self.x if mode == "zpx" else self.y)) & 0xFF
+
+        if mode in ("abs", "abx", "aby"):
+            base = self.read(pc + 1) | (self.read(pc + 2) << 8)
+            self.pc += 3
+            if mode == "abs":
+                return base
+            index = self.x if mode == "abx" else self.y
+        elif mode == "inx":
+            zp = self.read(pc + 1)
+            self.pc += 2
+            self.read(zp)
+            pointer = (zp + self.x) & 0xFF
+            return self.read(pointer) | (self.read((pointer + 1) & 0xFF) << 8)
+        else:   # iny
+            zp = self.read(pc + 1)
+            self.pc += 2
+            base = self.read(zp) | (self.read((zp + 1) & 0xFF) << 8)
+            index = self.y
+
+        target = (base + index) & 0xFFFF
+        wrong = (base & 0xFF00) | (target & 0xFF)
+        if kind == READ and wrong == target:
+            return target
+        self.read(wrong)
+        return target
+
+    def step(self, irq=False, nmi=False):
+        if nmi and not self.irq_delayed:
+            self.interrupt(0xFFFA, EVENT_NMI)
+            return
+        if irq and not (self.p & FLAG_I) and not self.irq_delayed:
+            self.interrupt(0xFFFE, EVENT_IRQ)
+            return
+        self.irq_delayed = False
+
+        pc = self.pc
+        opcode = self.read(pc)
+        name, mode, kind = OPCODES[opcode]
+        length = {"imp": 1, "acc": 1, "imm": 2, "zp": 2, "zpx": 2, "zpy": 2, "rel": 2, "inx": 2, "iny": 2}.get(mode, 3)
+        self.trace.append((EVENT_INSTRUCTION, pc, bytes(self.memory[(pc + i) & 0xFFFF] for i in range(length))))
+
+        if mode == "imm":
+            value = self.read(pc + 1)
+            self.pc += 2
+        elif mode in ("imp", "acc") and name not in ("BRK",):
+            self.read(pc + 1)
+            self.pc += 1
+        elif mode not in ("rel", "imp") and name not in ("JMP", "JSR"):
+            ea = self.address(mode, kind)
+            if kind == READ:
+                value = self.read(ea)
+            elif kind == MODIFY:
+                value = self.read(ea)
+                self.write(ea, value)
+
+        if name == "LDA": self.a = self.nz(value)
+        elif name == "LDX": self.x = self.nz(value)
+        elif name == "LDY": self.y = self.nz(value)
+        elif name == "STA": self.write(ea, self.a)
+        elif name == "STX": self.write(ea, self.x)
+        elif name == "STY": self.write(ea, self.y)
+        elif name in ("ADC", "SBC"):
+            operand = value if name == "ADC" else value ^ 0xFF
+            total = self.a + operand + (self.p & FLAG_C)
+            self.p = (self.p & ~FLAG_C) | (FLAG_C if total > 0xFF else 0)
+            self.a = self.nz(total)
+        elif name == "AND": self.a = self.nz(self.a & value)
+        elif name == "EOR": self.a = self.nz(self.a ^ value)
+        elif name in ("CMP", "CPX", "CPY"):
+            register = {"CMP": self.a, "CPX": self.x, "CPY": self.y}[name]
+            self.p = (self.p & ~FLAG_C) | (FLAG_C if register >= value else 0)
+            self.nz(register - value)
+        elif name == "BIT": self.nz(self.a & value)
+        elif name in ("INC", "DEC"): self.write(ea, self.nz(value + (1 if name == "INC" else -1)))
+        elif name == "ASL" and mode != "acc":
+            self.p = (self.p & ~FLAG_C) | (value >> 7)
+            self.write(ea, self.nz(value << 1))
+        elif name == "ASL":
+            self.p = (self.p & ~FLAG_C) | (self.a >> 7)
+            self.a = self.nz(self.a << 1)
+        elif name == "ROR":
+            carry = self.p & FLAG_C
+            self.p = (self.p & ~FLAG_C) | (self.a & 1)
+            self.a = self.nz((self.a >> 1) | (carry << 7))
+        elif name == "INX": self.x = self.nz(self.x + 1)
+        elif name == "INY": self.y = self.nz(self.y + 1)
+        elif name == "DEX": self.x = self.nz(self.x - 1)
+        elif name == "DEY": self.y = self.nz(self.y - 1)
+        elif name == "TAX": self.x = self.nz(self.a)
+        elif name == "TXA": self.a = self.nz(self.x)
+        elif name == "CLC": self.p &= ~FLAG_C
+        elif name == "SEC": self.p |= FLAG_C
+        elif name == "CLI": self.p &= ~FLAG_I
+        elif name == "SEI": self.p |= FLAG_I
+        elif name in ("PHA", "PHP"):
+            self.push(self.a if name == "PHA" else self.p | FLAG_B)
+        elif name in ("PLA", "PLP"):
+            self.read(0x100 | self.s)
+            value = self.pull()
+            if name == "PLA":
+                self.a = self.nz(value)
+            else:
+                self.p = value | 0x20
+        elif name == "JMP":
+            target = self.read(pc + 1) | (self.read(pc + 2) << 8)
+            if mode == "ind":
+                target = self.read(target) | (self.read((target & 0xFF00) | ((target + 1) & 0xFF)) << 8)
+            self.pc = target
+        elif name == "JSR":
+            low = self.read(pc + 1)
+            self.read(0x100 | self.s)
+            self.push((pc + 2) >> 8)
+            self.push((pc + 2) & 0xFF)
+            self.pc = low | (self.read(pc + 2) << 8)
+        elif name == "RTS":
+            self.read(0x100 | self.s)
+            target = self.pull() | (self.pull() << 8)
+            self.read(target)
+            self.pc = (target + 1) & 0xFFFF
+        elif name == "RTI":
+            self.read(0x100 | self.s)
+            self.p = self.pull() | 0x20
+            self.pc = self.pull() | (self.pull() << 8)
+        elif name == "BRK":
+            self.read(pc + 1)
+            self.push((pc + 2) >> 8)
+            self.push((pc + 2) & 0xFF)
+            self.push(self.p | FLAG_B)
+            self.p |= FLAG_I
+            self.pc = self.read(0xFFFE) | (self.read(0xFFFF) << 8)
+        elif mode == "rel":
+            offset = self.read(pc + 1)
+            fall = (pc + 2) & 0xFFFF
+            flag, wanted = {"BPL": (FLAG_N, 0), "BMI": (FLAG_N, 1), "BCC": (FLAG_C, 0), "BCS": (FLAG_C, 1),
+                            "BNE": (FLAG_Z, 0), "BEQ": (FLAG_Z, 1)}[name]
+            self.pc = fall
+            if bool(self.p & flag) == bool(wanted):
+                target = (fall + offset - (0x100 if offset & 0x80 else 0)) & 0xFFFF
+                self.read(fall)
+                if (target ^ fall) & 0xFF00:
+                    self.read((fall & 0xFF00) | (target & 0xFF))
+                else:
+                    self.irq_delayed = True         # A taken branch that stays in its page holds off IRQs
+                self.pc = target
+
+
+#------------------------------------------------------------------------------------------------
+#---- The Test Programs.                                                                     ----
+#------------------------------------------------------------------------------------------------
+def load(memory, address, data):
+    memory[address:address + len(data)] = bytes(data)
+
+
+def build_memory():
+    memory = bytearray(0x10000)
+    for address in range(0x1E00, 0x2000):
+        memory[address] = address & 0xFF
+
+    # Main program - every addressing mode, page crossings and a branch over one instruction.
+    load(memory, 0x1000, [
+        0xA2, 0x00,             # 1000 LDX #$00
+        0xA9, 0x41,             # 1002 LDA #$41
+        0x9D, 0x00, 0x1E,       # 1004 STA $1E00,X
+        0xBD, 0xFF, 0x1E,       # 1007 LDA $1EFF,X      crosses a page once X > 0
+        0xE8,                   # 100A INX
+        0xE0, 0x04,             # 100B CPX #$04
+        0xD0, 0xF3,             # 100D BNE $1002
+        0x20, 0x20, 0x10,       # 100F JSR $1020
+        0x4C, 0x40, 0x10,       # 1012 JMP $1040
+    ])
+    load(memory, 0x1020, [
+        0x48,                   # 1020 PHA
+        0x68,                   # 1021 PLA
+        0xA0, 0xF0,             # 1022 LDY #$F0
+        0xB1, 0xFB,             # 1024 LDA ($FB),Y      crosses a page
+        0x91, 0xFB,             # 1026 STA ($FB),Y
+        0xA1, 0xFB,             # 1028 LDA ($FB,X)
+        0xE6, 0x02,             # 102A INC $02
+        0x0A,                   # 102C ASL A
+        0x90, 0x01,             # 102D BCC $1030        over one 2 cycle instruction
+        0xE8,                   # 102F INX
+        0x16, 0x10,             # 1030 ASL $10,X
+        0xDE, 0x00, 0x1F,       # 1032 DEC $1F00,X
+        0x60,                   # 1035 RTS
+    ])
+    load(memory, 0x1040, [
+        0x6C, 0x50, 0x10,       # 1040 JMP ($1050)
+    ])
+    load(memory, 0x1050, [0x60, 0x10])
+    load(memory, 0x1060, [
+        0xA0, 0x03,             # 1060 LDY #$03
+        0x58,                   # 1062 CLI
+        0x4C, 0xFC, 0x10,       # 1063 JMP $10FC
+    ])
+    load(memory, 0x10FC, [
+        0x88,                   # 10FC DEY
+        0xEA,                   # 10FD NOP
+        0x08,                   # 10FE PHP
+        0x28,                   # 10FF PLP
+        0xD0, 0xFA,             # 1100 BNE $10FC        back across the page
+        0xE6, 0x03,             # 1102 INC $03
+        0xA5, 0x03,             # 1104 LDA $03
+        0x29, 0x01,             # 1106 AND #$01
+        0xF0, 0x01,             # 1108 BEQ $110B
+        0x00,                   # 110A BRK              every other pass
+        0xEA, 0xEA,             # 110B NOP / BRK padding byte
+        0xB9, 0xF0, 0x1E,       # 110D LDA $1EF0,Y
+        0x59, 0x10, 0x1F,       # 1110 EOR $1F10,Y
+        0x2C, 0x00, 0x1E,       # 1113 BIT $1E00
+        0x38,                   # 1116 SEC
+        0x6A,                   # 1117 ROR A
+        0x10, 0x02,             # 1118 BPL $111C
+        0x30, 0x00,             # 111A BMI $111C        taken with a zero offset
+        0xA0, 0x03,             # 111C LDY #$03
+        0x4C, 0xFC, 0x10,       # 111E JMP $10FC
+    ])
+
+    # IRQ / NMI / BRK handler - counts, then returns.
+    load(memory, 0x1200, [
+        0x48,                   # 1200 PHA
+        0xEE, 0x00, 0x13,       # 1201 INC $1300
+        0x68,                   # 1204 PLA
+        0x40,                   # 1205 RTI
+    ])
+
+    memory[0xFB] = 0x80
+    memory[0xFC] = 0x1E
+    load(memory, 0xFFFA, [0x00, 0x12, 0x00, 0x10, 0x00, 0x12])
+    return memory
+
+
+LISTING = """\
+----  RESET -> $1000
+1000  A2 00     LDX #$00
+1002  A9 41     LDA #$41
+1004  9D 00 1E  STA $1E00,X
+1007  BD FF 1E  LDA $1EFF,X
+100A  E8        INX
+100B  E0 04     CPX #$04
+100D  D0 F3     BNE $1002"""
+
+
+def run(library, seed, instructions, irq_rate):
+    rng = random.Random(seed)
+    cpu = Cpu(build_memory())
+    cpu.reset(rng.randint(1, 20))
+
+    for _ in range(instructions):
+        if rng.random() < irq_rate * 0.01:
+            cpu.reset(rng.randint(1, 20))
+        else:
+            cpu.step(irq=rng.random() < irq_rate, nmi=rng.random() < irq_rate * 0.1)
+
+    decoder = Decoder(library)
+    found = decoder.feed(cpu.cycles)
+
+    # The last instruction is only reported once its last cycle has gone by.
+    expected = cpu.trace[:len(found)] if len(found) >= len(cpu.trace) - 1 else cpu.trace
+    return decoder, cpu, found, expected
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Check the 6502 bus decoder against known instruction streams")
+    parser.add_argument("--runs", type=int, default=200)
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--instructions", type=int, default=2000)
+    parser.add_argument("--list", action="store_true", help="print the decoded listing of the first run")
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as directory:
+        library = build_decoder(directory)
+        failures = 0
+
+        # The start of the listing, text and all.
+        decoder, cpu, found, _ = run(library, args.seed, 40, 0)
+        text = "\n".join(decoder.format(*item) for item in found[:len(LISTING.splitlines())])
+        if text != LISTING:
+            failures += 1
+            print("listing mismatch:\n%s\nexpected:\n%s" % (text, LISTING))
+
+        if args.list:
+            for item in found:
+                print(decoder.format(*item))
+
+        # Every run mixes resets and interrupts in at random - the decoder must report exactly what the model ran.
+        cycles = 0
+        for run_index in range(args.runs):
+            seed = args.seed + run_index
+            irq_rate = (run_index % 4) * 0.02
+            decoder, cpu, found, expected = run(library, seed, args.instructions, irq_rate)
+            cycles += len(cpu.cycles)
+
+            if found != expected:
+                failures += 1
+                if failures <= 5:
+                    index = next((i for i, (a, b) in enumerate(zip(found, expected)) if a != b), min(len(found), len(expected)))
+                    print("seed %d: first difference at %d" % (seed, index))
+                    for item in expected[max(0, index - 3):index + 3]:
+                        print("  expected  " + decoder.format(*item))
+                    for item in found[max(0, index - 3):index + 3]:
+                        print("  found     " + decoder.format(*item))
+
+        print("%d runs, %d bus cycles, %d wrong: %s" % (args.runs, cycles, failures, "PASS" if failures == 0 else "FAIL"))
+        return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
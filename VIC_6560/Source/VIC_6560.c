@@ -0,0 +1,363 @@
+//------------------------------------------------------------------------------------------------
+//---- VIC 6560 ... 2026 Dave Gaunt                                                           ----
+//------------------------------------------------------------------------------------------------
+//---- Version 0.1                                                                            ----
+//------------------------------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+#include "types.h"
+
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+
+#include "VgaDisplay.h"
+#include "ClockPlan.h"
+#include "VgaConsole.h"
+#include "VgaSprites.h"
+#include "VgaSnapshot.h"
+#include "Vic6560.h"
+#include "Bus6502.h"
+
+#define VIC_PAL						(1)				/* 1 = 6561 PAL, 0 = 6560 NTSC */
+#define VIC_RENDER_BENCHMARK		(1)				/* Time The Renderer At Power On */
+#define VIC_BENCHMARK_LINES			(VIC_CANVAS_HEIGHT * 16)
+#define VGA_LINE_RATE_HZ			(31469)
+
+// Squash The Picture Into The Top Half And Disassemble The Live Bus Into The Bottom Half.
+#define VIC_DISASSEMBLY				(1)
+#define VIC_BUS_RING_SIZE			(4096)			/* Bus Cycles, Must Be A Power Of 2! */
+#define VIC_CONSOLE_TOP				(TERMINAL_CHARS_HIGH / 2)
+#define VIC_CONSOLE_CHARS_PER_FRAME	(1024)
+#define VIC_CONSOLE_CURSOR_SPRITE	(0)				/* Or VGA_SPRITE_NONE For No Cursor */
+#define VIC_DECODE_BENCHMARK_PASSES	(16)
+
+// Full 16 Bit Address Bus On The RP2350b_40GPIO Board.
+enum device_pins {
+	PIN_RED = 0,
+	PIN_GREEN,
+	PIN_BLUE,
+	PIN_HSYNC = 8,
+	PIN_VSYNC,
+
+	PIN_RESET,
+	PIN_READ_WRITE = 13,
+
+	PIN_DATA_BIT0 = 15,
+	PIN_DATA_BIT1,
+	PIN_DATA_BIT2,
+	PIN_DATA_BIT3,
+	PIN_DATA_BIT4,
+	PIN_DATA_BIT5,
+	PIN_DATA_BIT6,
+	PIN_DATA_BIT7,
+
+	PIN_CLK,				/* S02 - Data Transfer Occurs Only When Phase 2 Clock Is High */
+	PIN_ADDRESS_BIT0,		/* A0 - A7 On Pins 24 - 31 */
+	PIN_ADDRESS_BIT8 = 32,	/* A8 - A15 On Pins 32 - 39 */
+	PIN_ADDRESS_BIT15 = 39
+};
+
+static_assert(23 == PIN_CLK, "Clock must be on PIN 23!");
+static_assert(32 == PIN_ADDRESS_BIT0 + 8, "Address Low Byte Must Fill The Top Of The Low 32 Pins!");
+
+static Vic6560State s_vicState;
+
+#if VIC_DISASSEMBLY
+// Core1 Only Ever Moves The Head, Core0 Only The Tail.
+static volatile u32 s_aBusCycles[VIC_BUS_RING_SIZE];
+static volatile u32 s_uBusHead = 0;
+static u32 s_uBusTail = 0;
+static u32 s_uBusOverruns = 0;
+static u32 s_uSkippedLines = 0;
+
+static Bus6502Decoder s_busDecoder;
+#endif
+
+//------------------------------------------------------------------------------------------------
+//---- Snoop Every CPU Write - The Real VIC Still Drives The Bus, We Only Watch.              ----
+//------------------------------------------------------------------------------------------------
+static void __not_in_flash_func(function_core1)(void)
+{
+	save_and_disable_interrupts();
+
+	u32 uLow32Pins = gpioc_lo_in_get();
+	u32 uHiPins = gpioc_hi_in_get();
+	u32 uBusHead = 0;
+
+	while(true)
+	{
+		// Wait For S02 To Go High
+		while (0 == ((uLow32Pins >> PIN_CLK) & 1))
+			uLow32Pins = gpioc_lo_in_get();
+
+		// Keep Sampling Until S02 Falls - The Last Sample Taken While High Holds The Settled Bus.
+		u32 uLastLow32Pins;
+		u32 uLastHiPins;
+
+		do
+		{
+			uLastLow32Pins = uLow32Pins;
+			uLastHiPins = uHiPins;
+			uHiPins = gpioc_hi_in_get();
+			uLow32Pins = gpioc_lo_in_get();
+		} while ((uLow32Pins >> PIN_CLK) & 1);
+
+		const u32 uAddress = ((uLastLow32Pins >> PIN_ADDRESS_BIT0) & 0xFF) | ((uLastHiPins & 0xFF) << 8);
+		const u32 uData = (uLastLow32Pins >> PIN_DATA_BIT0) & 0xFF;
+
+		if (0 == ((uLastLow32Pins >> PIN_READ_WRITE) & 1))
+			Vic6560_SnoopWrite(&s_vicState, uAddress, uData);
+
+#if VIC_DISASSEMBLY
+		// Every Cycle Goes To Core0 - It Spots Being Lapped Itself, So There Is No Full Check Here.
+		u32 uCycle = uAddress | (uData << BUS6502_DATA_SHIFT);
+
+		if ((uLastLow32Pins >> PIN_READ_WRITE) & 1)
+			uCycle |= BUS6502_CYCLE_READ;
+
+		if (0 == ((uLastLow32Pins >> PIN_RESET) & 1))
+			uCycle |= BUS6502_CYCLE_RESET;
+
+		s_aBusCycles[uBusHead & (VIC_BUS_RING_SIZE - 1)] = uCycle;
+		s_uBusHead = ++uBusHead;
+#endif
+	}
+}
+
+#if VIC_DISASSEMBLY
+//------------------------------------------------------------------------------------------------
+//---- Decode Everything Core1 Has Queued. Every Cycle Is Decoded To Stay In Step, But Lines  ----
+//---- Only Go To The Console While It Has Room - A Gap Is Marked With How Many Were Skipped. ----
+//------------------------------------------------------------------------------------------------
+static void ServiceDisassembly(void)
+{
+	const u32 uHead = s_uBusHead;
+
+	Bus6502Instruction aInstructions[BUS6502_MAX_PER_CYCLE];
+	char szLine[BUS6502_MAX_TEXT + 1];
+
+	// Lapped By Core1 - Start Again From Its Head And Wait For The Next Vector To Get Back In Step.
+	if ((uHead - s_uBusTail) > VIC_BUS_RING_SIZE)
+	{
+		s_uBusTail = uHead;
+		Bus6502_Init(&s_busDecoder);
+
+		const int iLength = sprintf(szLine, "----  OVERRUN %u\n", ++s_uBusOverruns);
+		VgaConsole_Write(szLine, iLength);
+		return;
+	}
+
+	while (s_uBusTail != uHead)
+	{
+		const u32 uCount = Bus6502_Decode(&s_busDecoder, s_aBusCycles[s_uBusTail & (VIC_BUS_RING_SIZE - 1)], aInstructions);
+		++s_uBusTail;
+
+		for (u32 uInstruction=0; uInstruction<uCount; ++uInstruction)
+		{
+			// Room For The Skip Marker As Well As The Line.
+			if (VgaConsole_GetSpace() <= (BUS6502_MAX_TEXT * 2))
+			{
+				++s_uSkippedLines;
+				continue;
+			}
+
+			if (s_uSkippedLines)
+			{
+				const int iLength = sprintf(szLine, "----  %u SKIPPED\n", s_uSkippedLines);
+				VgaConsole_Write(szLine, iLength);
+				s_uSkippedLines = 0;
+			}
+
+			const u32 uLength = Bus6502_Format(&aInstructions[uInstruction], szLine);
+			szLine[uLength] = '\n';
+			VgaConsole_Write(szLine, uLength + 1);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//---- Canvas Lines Are Sent Once Into The Top Half - The Console Owns The Bottom Half.       ----
+//------------------------------------------------------------------------------------------------
+static void __hot_path_func(RenderFrame)(void)
+{
+	for (u32 uLine=0; uLine<VIC_CANVAS_HEIGHT; ++uLine)
+	{
+		Vic6560_RenderLine(&s_vicState, uLine, (u8*)&aVGAScreenBuffer[uLine * VGA_BYTES_PER_LINE]);
+		ServiceDisassembly();
+	}
+
+	VgaConsole_Service(VIC_CONSOLE_CHARS_PER_FRAME);
+}
+#else
+//------------------------------------------------------------------------------------------------
+//---- Render Straight Into The Frame Buffer - Each Canvas Line Is Sent Twice.                ----
+//------------------------------------------------------------------------------------------------
+static void __hot_path_func(RenderFrame)(void)
+{
+	for (u32 uLine=0; uLine<VIC_CANVAS_HEIGHT; ++uLine)
+	{
+		u8* pLine = (u8*)&aVGAScreenBuffer[uLine * VIC_SCALE_Y * VGA_BYTES_PER_LINE];
+		Vic6560_RenderLine(&s_vicState, uLine, pLine);
+		memcpy(pLine + VGA_BYTES_PER_LINE, pLine, VGA_BYTES_PER_LINE);
+	}
+}
+#endif
+
+#if VIC_RENDER_BENCHMARK
+#if VIC_DISASSEMBLY
+//------------------------------------------------------------------------------------------------
+//---- Decode A Reset Followed By A Run Of NOPs - The Bus Ring Is Not In Use Yet.             ----
+//------------------------------------------------------------------------------------------------
+static u32 BenchmarkDecoder(void)
+{
+	u32* pCycles = (u32*)s_aBusCycles;
+
+	pCycles[0] = Bus6502_PackCycle(0xFFFC, 0x00, true);
+	pCycles[1] = Bus6502_PackCycle(0xFFFD, 0xA0, true);
+
+	for (u32 uCycle=2; uCycle<VIC_BUS_RING_SIZE; ++uCycle)
+		pCycles[uCycle] = Bus6502_PackCycle(0xA000 + ((uCycle - 2) >> 1) + (uCycle & 1), 0xEA, true);
+
+	Bus6502Instruction aInstructions[BUS6502_MAX_PER_CYCLE];
+	const u32 uStart = time_us_32();
+
+	for (u32 uPass=0; uPass<VIC_DECODE_BENCHMARK_PASSES; ++uPass)
+	{
+		Bus6502_Init(&s_busDecoder);
+
+		for (u32 uCycle=0; uCycle<VIC_BUS_RING_SIZE; ++uCycle)
+			Bus6502_Decode(&s_busDecoder, pCycles[uCycle], aInstructions);
+	}
+
+	const u32 uElapsed = time_us_32() - uStart;
+
+	Bus6502_Init(&s_busDecoder);
+	return (u32)(((uint64_t)VIC_BUS_RING_SIZE * VIC_DECODE_BENCHMARK_PASSES * 1000000) / uElapsed);
+}
+#endif
+
+//------------------------------------------------------------------------------------------------
+//---- Render A Busy Screen Off Screen And Compare Against The 31.5 KHz VGA Line Rate.        ----
+//------------------------------------------------------------------------------------------------
+static void RunRenderBenchmark(void)
+{
+	// Fill The Screen With Every Character And Every Colour, Half Of Them Multicolour.
+	for (u32 uCell=0; uCell<(22 * 23); ++uCell)
+	{
+		Vic6560_SnoopWrite(&s_vicState, 0x1E00 + uCell, (u8)uCell);
+		Vic6560_SnoopWrite(&s_vicState, VIC_CPU_COLOUR_RAM + 0x200 + uCell, (u8)uCell);
+	}
+
+	u8 aLine[VGA_BYTES_PER_LINE];
+	const u32 uStart = time_us_32();
+
+	for (u32 uLine=0; uLine<VIC_BENCHMARK_LINES; ++uLine)
+		Vic6560_RenderLine(&s_vicState, uLine % VIC_CANVAS_HEIGHT, aLine);
+
+	const u32 uElapsed = time_us_32() - uStart;
+
+	// Each Rendered Line Feeds Two VGA Lines.
+	const u32 uVgaLinesPerSecond = (u32)(((uint64_t)VIC_BENCHMARK_LINES * VIC_SCALE_Y * 1000000) / uElapsed);
+
+	// Then The Shared VGA Text Drawing, Plain C Against The Interpolators.
+	VGADrawBenchmark drawBenchmark;
+	BenchmarkVGADrawing(&drawBenchmark);
+
+#if VIC_DISASSEMBLY
+	const u32 uDecodeCyclesPerSecond = BenchmarkDecoder();
+#endif
+
+	// Hash One Whole Frame From A Clear Screen - Renderer Changes Must Leave The CRC Alone.
+	FilledRectangle(0, 0, VGA_RESOLUTION_X, VGA_RESOLUTION_Y, RGB_BLACK);
+
+	VgaSnapshot frameSnapshot;
+	VgaSnapshot_Init();
+	VgaSnapshot_BeginFrame();
+	RenderFrame();
+	VgaSnapshot_EndFrame(&frameSnapshot);
+
+	char szTempString[64];
+	FilledRectangle(0, 0, VGA_RESOLUTION_X, 56, RGB_BLACK);
+	sprintf(szTempString, "RENDER %u VGA LINES/S", uVgaLinesPerSecond);
+	DrawString(1, 1, szTempString, RGB_WHITE);
+	sprintf(szTempString, "BUDGET %u LINES/S  %u%% USED", VGA_LINE_RATE_HZ, (VGA_LINE_RATE_HZ * 100) / uVgaLinesPerSecond);
+	DrawString(1, 2, szTempString, (uVgaLinesPerSecond >= VGA_LINE_RATE_HZ) ? RGB_GREEN : RGB_RED);
+	sprintf(szTempString, "CHAR %u CYCLES C  %u INTERP", drawBenchmark.m_uCharCyclesC, drawBenchmark.m_uCharCyclesInterp);
+	DrawString(1, 3, szTempString, RGB_WHITE);
+	sprintf(szTempString, "FILL %u CYCLES C  %u INTERP", drawBenchmark.m_uRectCyclesC, drawBenchmark.m_uRectCyclesInterp);
+	DrawString(1, 4, szTempString, RGB_WHITE);
+#if VIC_DISASSEMBLY
+	sprintf(szTempString, "DECODE %u BUS CYCLES/S", uDecodeCyclesPerSecond);
+	DrawString(1, 5, szTempString, (uDecodeCyclesPerSecond >= 1000000) ? RGB_GREEN : RGB_RED);
+#endif
+	sprintf(szTempString, "FRAME %08X %u CYCLES", frameSnapshot.m_uCrc, frameSnapshot.m_uRenderCycles);
+	DrawString(1, 6, szTempString, RGB_WHITE);
+	sprintf(szTempString, "HASH %u CYCLES", frameSnapshot.m_uHashCycles);
+	DrawString(1, 7, szTempString, RGB_WHITE);
+
+	// The Same Pattern Drawn Both Ways Must Leave The Same Frame Buffer.
+	const bool bPathsMatch = (drawBenchmark.m_uHashC == drawBenchmark.m_uHashInterp);
+	sprintf(szTempString, "DRAW %08X C  %08X INTERP", drawBenchmark.m_uHashC, drawBenchmark.m_uHashInterp);
+	DrawString(1, 8, szTempString, bPathsMatch ? RGB_GREEN : RGB_RED);
+	DrawString(1, 9, bPathsMatch ? "INTERP MATCHES C" : "INTERP DRAWS WRONG PIXELS", bPathsMatch ? RGB_GREEN : RGB_RED);
+
+	sleep_ms(4000);
+
+#if VGA_USE_INTERP
+	// Everything On Screen Is Drawn Through The Interpolators - Stop Here, Showing Why, Rather Than Run With Them Wrong.
+	while (!bPathsMatch)
+		tight_loop_contents();
+#endif
+	Vic6560_Init(&s_vicState, VIC_PAL);
+}
+#endif
+
+//------------------------------------------------------------------------------------------------
+//----                                                                                        ----
+//------------------------------------------------------------------------------------------------
+int main()
+{
+	ClockPlan_Init();
+	stdio_init_all();
+
+	gpio_init(PIN_CLK);
+	gpio_set_dir(PIN_CLK, GPIO_IN);
+
+	gpio_init(PIN_READ_WRITE);
+	gpio_set_dir(PIN_READ_WRITE, GPIO_IN);
+
+	gpio_init(PIN_RESET);
+	gpio_set_dir(PIN_RESET, GPIO_IN);
+
+	// Set All Data Pins To Input
+	for(u32 uPin=PIN_DATA_BIT0; uPin<=PIN_DATA_BIT7; ++uPin)
+	{
+		gpio_init(uPin);
+		gpio_set_dir(uPin, GPIO_IN);
+	}
+
+	// Set All 16 Address Pins To Input
+	for(u32 uPin=PIN_ADDRESS_BIT0; uPin<=PIN_ADDRESS_BIT15; ++uPin)
+	{
+		gpio_init(uPin);
+		gpio_set_dir(uPin, GPIO_IN);
+	}
+
+	Vic6560_Init(&s_vicState, VIC_PAL);
+	initVGA(PIN_RED, PIN_HSYNC, PIN_VSYNC);
+
+#if VIC_RENDER_BENCHMARK
+	RunRenderBenchmark();
+#endif
+
+#if VIC_DISASSEMBLY
+	Bus6502_Init(&s_busDecoder);
+	VgaConsole_Init(0, VIC_CONSOLE_TOP, TERMINAL_CHARS_WIDE, TERMINAL_CHARS_HIGH - VIC_CONSOLE_TOP, RGB_GREEN);
+	VgaConsole_EnableCursor(VIC_CONSOLE_CURSOR_SPRITE);
+#endif
+
+	multicore_launch_core1(function_core1);
+
+	while(true)
+		RenderFrame();
+}